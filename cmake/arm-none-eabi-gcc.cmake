@@ -0,0 +1,12 @@
+set(CMAKE_SYSTEM_NAME               Generic)
+set(CMAKE_SYSTEM_PROCESSOR          arm)
+
+# Some default GCC settings
+set(CMAKE_C_COMPILER                arm-none-eabi-gcc)
+set(CMAKE_CXX_COMPILER              arm-none-eabi-g++)
+
+# Cortex-M4 with single precision FPU, change for other cores
+set(CMAKE_C_FLAGS_INIT              "-mcpu=cortex-m4 -mthumb -mfpu=fpv4-sp-d16 -mfloat-abi=hard")
+set(CMAKE_CXX_FLAGS_INIT            "-mcpu=cortex-m4 -mthumb -mfpu=fpv4-sp-d16 -mfloat-abi=hard")
+
+set(CMAKE_TRY_COMPILE_TARGET_TYPE STATIC_LIBRARY)
@@ -0,0 +1,408 @@
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "lwprintf/lwprintf.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif /* defined(_MSC_VER) */
+#define BENCH_HAS_CYCLES 1
+#elif defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+#define BENCH_CORTEX_M   1
+#define BENCH_HAS_CYCLES 1
+#endif /* defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86) */
+#ifndef BENCH_HAS_CYCLES
+#define BENCH_HAS_CYCLES 0
+#endif /* BENCH_HAS_CYCLES */
+
+#if !BENCH_CORTEX_M
+#if defined(_WIN32)
+#include "windows.h"
+#else
+#include <time.h>
+#endif /* defined(_WIN32) */
+#endif /* !BENCH_CORTEX_M */
+
+#if BENCH_NANOPRINTF
+#define NANOPRINTF_USE_FIELD_WIDTH_FORMAT_SPECIFIERS 1
+#define NANOPRINTF_USE_PRECISION_FORMAT_SPECIFIERS   1
+#define NANOPRINTF_USE_FLOAT_FORMAT_SPECIFIERS       1
+#define NANOPRINTF_USE_LARGE_FORMAT_SPECIFIERS       1
+#define NANOPRINTF_USE_BINARY_FORMAT_SPECIFIERS      0
+#define NANOPRINTF_USE_WRITEBACK_FORMAT_SPECIFIERS   0
+#define NANOPRINTF_IMPLEMENTATION
+#include "nanoprintf.h"
+#endif /* BENCH_NANOPRINTF */
+
+/*
+ * Throughput benchmark of specifier families.
+ *
+ * Every case formats the same text to the buffer with every library, with values that change on every call.
+ * Time per call and output bytes per second are measured with monotonic clock, cycles per call with
+ * time stamp counter on x86 and with DWT cycle counter on Cortex-M.
+ *
+ * LwPRINTF is compared to C library of the toolchain, such as glibc or newlib.
+ * nanoprintf and mpaland/printf are compared when their sources are set to the build,
+ * with LWPRINTF_BENCH_NANOPRINTF_DIR and LWPRINTF_BENCH_MPALAND_PRINTF_DIR CMake variables.
+ * Result of every library is checked against C library, text that differs is marked with `*`.
+ *
+ * On the host, main function runs the benchmark. On the target, \ref bench_format_run is called by the application,
+ * with BENCH_NO_MAIN and BENCH_PRINTF defined to its print function.
+ *
+ * With `--gate` argument, only LwPRINTF is measured and every case is printed as `GATE <id> <value>` line,
+ * with cycles per call, or time per call in nanoseconds without cycle counter.
+ * Lines are compared to the stored baseline by dev/gate_check.cmake script.
+ * Every case is measured BENCH_REPEATS times and the fastest run is reported, to reduce noise of the system
+ */
+
+#ifndef BENCH_ITERATIONS
+#if BENCH_CORTEX_M
+#define BENCH_ITERATIONS 2000
+#else
+#define BENCH_ITERATIONS 200000
+#endif /* BENCH_CORTEX_M */
+#endif /* BENCH_ITERATIONS */
+
+#ifndef BENCH_REPEATS
+#if BENCH_CORTEX_M
+#define BENCH_REPEATS 1
+#else
+#define BENCH_REPEATS 5
+#endif /* BENCH_CORTEX_M */
+#endif /* BENCH_REPEATS */
+
+#ifndef BENCH_PRINTF
+#define BENCH_PRINTF printf
+#endif /* BENCH_PRINTF */
+
+#if BENCH_CORTEX_M
+#define BENCH_DEMCR      (*(volatile uint32_t*)0xE000EDFCUL)
+#define BENCH_DWT_CTRL   (*(volatile uint32_t*)0xE0001000UL)
+#define BENCH_DWT_CYCCNT (*(volatile uint32_t*)0xE0001004UL)
+
+/* Core clock frequency of CMSIS device */
+extern uint32_t SystemCoreClock;
+
+/* Cycle counter has 32 bits, measured interval must be shorter than its period */
+typedef uint32_t bench_cycles_t;
+#else
+typedef uint64_t bench_cycles_t;
+#endif /* BENCH_CORTEX_M */
+
+/**
+ * \brief           Formatting function of the library, with `vsnprintf` interface
+ */
+typedef int (*bench_vsnprintf_fn)(char* s, size_t n, const char* format, va_list arg);
+
+/**
+ * \brief           Compared library
+ */
+typedef struct {
+    const char* name;      /*!< Library name */
+    bench_vsnprintf_fn fn; /*!< Formatting function */
+} bench_lib_t;
+
+/**
+ * \brief           Benchmark case
+ */
+typedef struct {
+    const char* name;      /*!< Case name */
+    const char* id;        /*!< Case identifier in performance gate */
+    uint8_t lwprintf_only; /*!< Set to `1` for specifiers of LwPRINTF only */
+} bench_case_t;
+
+/**
+ * \brief           Result of one case and library
+ */
+typedef struct {
+    bench_cycles_t cycles; /*!< Cycles of all iterations */
+    uint64_t time_ns;      /*!< Time of all iterations */
+    size_t bytes;          /*!< Formatted bytes of all iterations */
+} bench_result_t;
+
+#if BENCH_MPALAND_PRINTF
+/* Header of mpaland/printf replaces standard names, only its functions are declared */
+int vsnprintf_(char* buffer, size_t count, const char* format, va_list va);
+
+/**
+ * \brief           Character output of mpaland/printf, not used by the buffer functions
+ * \param[in]       character: Character to print
+ */
+void
+_putchar(char character) {
+    (void)character;
+}
+#endif /* BENCH_MPALAND_PRINTF */
+
+/**
+ * \brief           Format with LwPRINTF
+ */
+static int
+bench_lwprintf(char* s, size_t n, const char* format, va_list arg) {
+    return lwprintf_vsnprintf_ex(NULL, s, n, format, arg);
+}
+
+/**
+ * \brief           Format with C library of the toolchain
+ */
+static int
+bench_libc(char* s, size_t n, const char* format, va_list arg) {
+    return vsnprintf(s, n, format, arg);
+}
+
+#if BENCH_NANOPRINTF
+/**
+ * \brief           Format with nanoprintf
+ */
+static int
+bench_nanoprintf(char* s, size_t n, const char* format, va_list arg) {
+    return npf_vsnprintf(s, n, format, arg);
+}
+#endif /* BENCH_NANOPRINTF */
+
+#if BENCH_MPALAND_PRINTF
+/**
+ * \brief           Format with mpaland/printf
+ */
+static int
+bench_mpaland(char* s, size_t n, const char* format, va_list arg) {
+    return vsnprintf_(s, n, format, arg);
+}
+#endif /* BENCH_MPALAND_PRINTF */
+
+/**
+ * \brief           Compared libraries. LwPRINTF is the first and C library the second, as reference for text check
+ */
+static const bench_lib_t bench_libs[] = {
+    {"lwprintf", bench_lwprintf},
+    {"libc", bench_libc},
+#if BENCH_NANOPRINTF
+    {"nanoprintf", bench_nanoprintf},
+#endif /* BENCH_NANOPRINTF */
+#if BENCH_MPALAND_PRINTF
+    {"mpaland", bench_mpaland},
+#endif /* BENCH_MPALAND_PRINTF */
+};
+
+/**
+ * \brief           Benchmark cases, in the order of \ref bench_case_run
+ */
+static const bench_case_t bench_cases[] = {
+    {"literal", "literal", 0}, {"%d", "int_d", 0},   {"%x", "int_x", 0},   {"%s", "string", 0},
+    {"%f", "float_f", 0},      {"%e", "float_e", 0}, {"%g", "float_g", 0}, {"%k", "bytes_k", 1},
+    {"log line", "log_line", 0}, {"%.2f", "float_2f", 0},
+};
+
+/**
+ * \brief           Data of byte array case
+ */
+static const uint8_t bench_bytes[] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xAA, 0xBB};
+
+/**
+ * \brief           Sum of all lengths, so that no call is removed by the compiler
+ */
+static volatile size_t bench_sink;
+
+/**
+ * \brief           Call formatting function of the library with variable arguments
+ * \param[in]       fn: Formatting function
+ * \param[out]      s: Output buffer
+ * \param[in]       n: Size of output buffer
+ * \param[in]       format: Format string
+ * \param[in]       ...: Format arguments
+ * \return          Length of formatted text
+ */
+static int
+bench_call(bench_vsnprintf_fn fn, char* s, size_t n, const char* format, ...) {
+    va_list ap;
+    int len;
+
+    va_start(ap, format);
+    len = fn(s, n, format, ap);
+    va_end(ap);
+    return len;
+}
+
+/**
+ * \brief           Format text of the case
+ * \param[in]       case_idx: Index of the case in \ref bench_cases
+ * \param[in]       fn: Formatting function
+ * \param[out]      s: Output buffer
+ * \param[in]       n: Size of output buffer
+ * \param[in]       i: Call index, used to change values
+ * \return          Length of formatted text
+ */
+static int
+bench_case_run(size_t case_idx, bench_vsnprintf_fn fn, char* s, size_t n, uint32_t i) {
+    const uint32_t v = i * 2654435761UL;
+
+    switch (case_idx) {
+        case 0: return bench_call(fn, s, n, "Literal text without any specifier\r\n");
+        case 1: return bench_call(fn, s, n, "%d", (int)v);
+        case 2: return bench_call(fn, s, n, "%x", (unsigned)v);
+        case 3: return bench_call(fn, s, n, "%s", (i & 1) ? "Text string argument" : "Another string");
+        case 4: return bench_call(fn, s, n, "%f", (double)(v & 0xFFFFF) * 0.125);
+        case 5: return bench_call(fn, s, n, "%e", (double)(v & 0xFFFFF) * 1234.5678);
+        case 6: return bench_call(fn, s, n, "%g", (double)(v & 0xFFFFF) * 0.0625);
+        case 7: return bench_call(fn, s, n, "%*k", (int)(sizeof(bench_bytes) - (i & 3)), bench_bytes);
+        case 8:
+            return bench_call(fn, s, n, "[%8lu.%03u] %-6s ch=%2d v=%5.2f st=0x%04X\r\n", (unsigned long)(i / 1000),
+                              (unsigned)(i % 1000), (i & 1) ? "adc" : "uart", (int)(i & 15),
+                              (double)(v & 0xFFFF) * 0.01, (unsigned)(v >> 16));
+        case 9: return bench_call(fn, s, n, "%.2f", (double)(v & 0xFFFFF) * 0.001);
+        default: return 0;
+    }
+}
+
+/**
+ * \brief           Start cycle counter
+ */
+static void
+bench_cycles_init(void) {
+#if BENCH_CORTEX_M
+    BENCH_DEMCR |= 1UL << 24; /* Enable trace and debug blocks */
+    BENCH_DWT_CYCCNT = 0;
+    BENCH_DWT_CTRL |= 1UL; /* Enable cycle counter */
+#endif                     /* BENCH_CORTEX_M */
+}
+
+/**
+ * \brief           Get cycle counter
+ * \return          Number of cycles, `0` when counter is not available
+ */
+static bench_cycles_t
+bench_cycles(void) {
+#if BENCH_CORTEX_M
+    return BENCH_DWT_CYCCNT;
+#elif BENCH_HAS_CYCLES
+    return (bench_cycles_t)__rdtsc();
+#else
+    return 0;
+#endif /* BENCH_CORTEX_M */
+}
+
+/**
+ * \brief           Get monotonic time
+ * \param[in]       cycles: Cycle counter, that is used for time on Cortex-M
+ * \return          Time in units of nanoseconds
+ */
+static uint64_t
+bench_time_ns(bench_cycles_t cycles) {
+#if BENCH_CORTEX_M
+    return (uint64_t)cycles * 1000000000ULL / SystemCoreClock;
+#elif defined(_WIN32)
+    LARGE_INTEGER freq, cnt;
+
+    (void)cycles;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&cnt);
+    return (uint64_t)((double)cnt.QuadPart * 1e9 / (double)freq.QuadPart);
+#else
+    struct timespec ts;
+
+    (void)cycles;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#endif /* BENCH_CORTEX_M */
+}
+
+/**
+ * \brief           Measure one case of the library, fastest of \ref BENCH_REPEATS runs
+ * \param[in]       case_idx: Index of the case in \ref bench_cases
+ * \param[in]       fn: Formatting function
+ * \param[out]      buff: Output buffer, with at least `128` bytes
+ * \param[out]      res: Result of the fastest run
+ */
+static void
+bench_measure(size_t case_idx, bench_vsnprintf_fn fn, char* buff, bench_result_t* res) {
+    for (uint32_t r = 0; r < BENCH_REPEATS; ++r) {
+        bench_cycles_t c_start, c_end;
+        uint64_t t_start, t_end;
+        size_t bytes = 0;
+
+        c_start = bench_cycles();
+        t_start = bench_time_ns(c_start);
+        for (uint32_t i = 0; i < BENCH_ITERATIONS; ++i) {
+            bytes += (size_t)bench_case_run(case_idx, fn, buff, 128, i);
+        }
+        c_end = bench_cycles();
+        t_end = bench_time_ns(c_end);
+        bench_sink = bench_sink + bytes;
+        if (t_end == t_start) {
+            t_end = t_start + 1;
+        }
+        if (r == 0 || t_end - t_start < res->time_ns) {
+            res->cycles = (bench_cycles_t)(c_end - c_start);
+            res->time_ns = t_end - t_start;
+            res->bytes = bytes;
+        }
+    }
+}
+
+/**
+ * \brief           Run all cases for all libraries and print the results
+ */
+void
+bench_format_run(void) {
+    char buff[128], ref[128];
+
+    bench_cycles_init();
+    BENCH_PRINTF("Iterations: %u, cycles: %s\r\n", (unsigned)BENCH_ITERATIONS, BENCH_HAS_CYCLES ? "yes" : "no");
+    BENCH_PRINTF("%-10s %-10s %12s %12s %12s\r\n", "Case", "Library", "cycles/call", "ns/call", "MB/s");
+    for (size_t c = 0; c < sizeof(bench_cases) / sizeof(bench_cases[0]); ++c) {
+        for (size_t l = 0; l < sizeof(bench_libs) / sizeof(bench_libs[0]); ++l) {
+            bench_result_t res;
+            int match = 1;
+
+            if (bench_cases[c].lwprintf_only && l > 0) {
+                continue;
+            }
+
+            /* Text is checked with the first values, that also warms up the caches */
+            bench_case_run(c, bench_libs[l].fn, buff, sizeof(buff), 0);
+            if (!bench_cases[c].lwprintf_only) {
+                bench_case_run(c, bench_libc, ref, sizeof(ref), 0);
+                match = strcmp(buff, ref) == 0;
+            }
+
+            bench_measure(c, bench_libs[l].fn, buff, &res);
+            BENCH_PRINTF("%-10s %-9s%c %12.1f %12.1f %12.2f\r\n", bench_cases[c].name, bench_libs[l].name,
+                         match ? ' ' : '*', (double)res.cycles / BENCH_ITERATIONS,
+                         (double)res.time_ns / BENCH_ITERATIONS, (double)res.bytes * 1e3 / (double)res.time_ns);
+        }
+    }
+}
+
+/**
+ * \brief           Measure LwPRINTF only and print results of performance gate
+ */
+void
+bench_format_gate(void) {
+    char buff[128];
+
+    bench_cycles_init();
+    for (size_t c = 0; c < sizeof(bench_cases) / sizeof(bench_cases[0]); ++c) {
+        bench_result_t res;
+
+        bench_case_run(c, bench_lwprintf, buff, sizeof(buff), 0);
+        bench_measure(c, bench_lwprintf, buff, &res);
+        BENCH_PRINTF("GATE %s %.1f\r\n", bench_cases[c].id,
+                     (double)(BENCH_HAS_CYCLES ? (uint64_t)res.cycles : res.time_ns) / BENCH_ITERATIONS);
+    }
+}
+
+#ifndef BENCH_NO_MAIN
+int
+main(int argc, char* argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--gate") == 0) {
+        bench_format_gate();
+    } else {
+        bench_format_run();
+    }
+    return 0;
+}
+#endif /* BENCH_NO_MAIN */
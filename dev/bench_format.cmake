@@ -0,0 +1,24 @@
+#
+# Format throughput benchmark
+#
+# lwprintf_bench_format function adds benchmark to the target, that also builds LwPRINTF.
+# Other libraries are compared, when their sources are set with the following variables:
+#
+# LWPRINTF_BENCH_NANOPRINTF_DIR: Directory with nanoprintf.h of nanoprintf
+# LWPRINTF_BENCH_MPALAND_PRINTF_DIR: Directory with printf.c of mpaland/printf
+#
+
+set(LWPRINTF_BENCH_NANOPRINTF_DIR "" CACHE PATH "Directory with nanoprintf.h, compared by format benchmark")
+set(LWPRINTF_BENCH_MPALAND_PRINTF_DIR "" CACHE PATH "Directory with printf.c of mpaland/printf, compared by format benchmark")
+
+function(lwprintf_bench_format target)
+    target_sources(${target} PRIVATE ${CMAKE_CURRENT_FUNCTION_LIST_DIR}/bench_format.c)
+    if(LWPRINTF_BENCH_NANOPRINTF_DIR)
+        target_include_directories(${target} PRIVATE ${LWPRINTF_BENCH_NANOPRINTF_DIR})
+        target_compile_definitions(${target} PRIVATE BENCH_NANOPRINTF=1)
+    endif()
+    if(LWPRINTF_BENCH_MPALAND_PRINTF_DIR)
+        target_sources(${target} PRIVATE ${LWPRINTF_BENCH_MPALAND_PRINTF_DIR}/printf.c)
+        target_compile_definitions(${target} PRIVATE BENCH_MPALAND_PRINTF=1)
+    endif()
+endfunction()
@@ -0,0 +1,161 @@
+#include <stdint.h>
+#include <stdio.h>
+#include "lwprintf/lwprintf.h"
+#include "system/lwprintf_sys.h"
+
+#if defined(_WIN32)
+#include "windows.h"
+#else
+#include <pthread.h>
+#include <time.h>
+#endif /* defined(_WIN32) */
+
+/*
+ * Contention benchmark of system port mutex.
+ *
+ * Every thread prints short messages to the shared instance, with output that only counts characters.
+ * Time per print includes formatting and one mutex wait/release pair,
+ * measured for different number of threads. Run it for every port to compare them.
+ */
+
+#define BENCH_PRINTS_PER_THREAD 200000
+#define BENCH_MAX_THREADS       8
+
+/**
+ * \brief           Shared instance and number of printed characters
+ */
+static lwprintf_t lw_bench;
+static volatile size_t bench_chars;
+
+/**
+ * \brief           Output function, text is only counted
+ * \param[in]       ch: Character to print
+ * \param[in]       lw: LwPRINTF instance
+ * \return          `ch` value
+ */
+static int
+bench_output(int ch, lwprintf_t* lw) {
+    LWPRINTF_UNUSED(lw);
+    if (ch != '\0') {
+        bench_chars = bench_chars + 1;
+    }
+    return ch;
+}
+
+/**
+ * \brief           Get monotonic time
+ * \return          Time in units of nanoseconds
+ */
+static uint64_t
+bench_time_ns(void) {
+#if defined(_WIN32)
+    LARGE_INTEGER freq, cnt;
+
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&cnt);
+    return (uint64_t)((double)cnt.QuadPart * 1e9 / (double)freq.QuadPart);
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#endif /* defined(_WIN32) */
+}
+
+/**
+ * \brief           Print messages to the shared instance
+ * \param[in]       arg: Thread index
+ */
+static void
+bench_prints(uintptr_t arg) {
+    for (int i = 0; i < BENCH_PRINTS_PER_THREAD; ++i) {
+#if LWPRINTF_CFG_OS_MANUAL_PROTECT
+        lwprintf_protect_ex(&lw_bench);
+#endif /* LWPRINTF_CFG_OS_MANUAL_PROTECT */
+        lwprintf_printf_ex(&lw_bench, "T%u:%d\r\n", (unsigned)arg, i);
+#if LWPRINTF_CFG_OS_MANUAL_PROTECT
+        lwprintf_unprotect_ex(&lw_bench);
+#endif /* LWPRINTF_CFG_OS_MANUAL_PROTECT */
+    }
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI
+bench_thread(LPVOID arg) {
+    bench_prints((uintptr_t)arg);
+    return 0;
+}
+#else
+static void*
+bench_thread(void* arg) {
+    bench_prints((uintptr_t)arg);
+    return NULL;
+}
+#endif /* defined(_WIN32) */
+
+/**
+ * \brief           Run all threads and wait for them to finish
+ * \param[in]       threads_cnt: Number of threads
+ * \return          Elapsed time in units of nanoseconds
+ */
+static uint64_t
+bench_run(size_t threads_cnt) {
+    uint64_t start = bench_time_ns();
+#if defined(_WIN32)
+    HANDLE threads[BENCH_MAX_THREADS];
+
+    for (size_t i = 0; i < threads_cnt; ++i) {
+        threads[i] = CreateThread(NULL, 0, bench_thread, (LPVOID)i, 0, NULL);
+    }
+    WaitForMultipleObjects((DWORD)threads_cnt, threads, TRUE, INFINITE);
+    for (size_t i = 0; i < threads_cnt; ++i) {
+        CloseHandle(threads[i]);
+    }
+#else
+    pthread_t threads[BENCH_MAX_THREADS];
+
+    for (size_t i = 0; i < threads_cnt; ++i) {
+        pthread_create(&threads[i], NULL, bench_thread, (void*)i);
+    }
+    for (size_t i = 0; i < threads_cnt; ++i) {
+        pthread_join(threads[i], NULL);
+    }
+#endif /* defined(_WIN32) */
+    return bench_time_ns() - start;
+}
+
+int
+main(void) {
+    LWPRINTF_CFG_OS_MUTEX_HANDLE m = {0};
+    uint64_t t;
+
+    /* Uncontended wait/release pair, without formatting */
+    lwprintf_sys_mutex_create(&m);
+    t = bench_time_ns();
+    for (int i = 0; i < BENCH_PRINTS_PER_THREAD; ++i) {
+        lwprintf_sys_mutex_wait(&m);
+        lwprintf_sys_mutex_release(&m);
+    }
+    t = bench_time_ns() - t;
+    printf("Mutex wait/release: %.1f ns\r\n", (double)t / BENCH_PRINTS_PER_THREAD);
+
+    lwprintf_init_ex(&lw_bench, bench_output);
+    for (size_t threads_cnt = 1; threads_cnt <= BENCH_MAX_THREADS; threads_cnt *= 2) {
+        bench_chars = 0;
+#if LWPRINTF_CFG_OS_STATS
+        lwprintf_init_stats_ex(&lw_bench, NULL);
+#endif /* LWPRINTF_CFG_OS_STATS */
+        t = bench_run(threads_cnt);
+        printf("Threads: %u, print: %.1f ns, total: %.1f ms, chars: %u\r\n", (unsigned)threads_cnt,
+               (double)t / (double)(threads_cnt * BENCH_PRINTS_PER_THREAD), (double)t / 1e6, (unsigned)bench_chars);
+#if LWPRINTF_CFG_OS_STATS
+        {
+            lwprintf_stats_t stats;
+
+            lwprintf_get_stats_ex(&lw_bench, &stats);
+            printf("    acquisitions: %u, contended: %u\r\n", (unsigned)stats.acquisitions, (unsigned)stats.contended);
+        }
+#endif /* LWPRINTF_CFG_OS_STATS */
+    }
+    return 0;
+}
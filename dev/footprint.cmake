@@ -0,0 +1,105 @@
+#
+# Footprint matrix of library options
+#
+# Library is compiled for every configuration, with default options and listed changes only.
+# LwLibPROJECT_footprint target prints text, data, bss and worst-case stack of every configuration,
+# for the toolchain and build type of the selected preset.
+#
+# Every entry is "<name>:<option>=<value>,<option>=<value>"
+#
+
+set(footprint_configs
+    "default:"
+    "no_float:LWPRINTF_CFG_SUPPORT_TYPE_FLOAT=0,LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING=0"
+    "no_engineering:LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING=0"
+    "float_shortest:LWPRINTF_CFG_FLOAT_SHORTEST=1"
+    "float_single:LWPRINTF_CFG_SUPPORT_TYPE_FLOAT_SINGLE=1"
+    "float_exact:LWPRINTF_CFG_FLOAT_EXACT=1"
+    "no_float_fixed_fast:LWPRINTF_CFG_FLOAT_FIXED_FAST=0"
+    "no_byte_array:LWPRINTF_CFG_SUPPORT_TYPE_BYTE_ARRAY=0"
+    "no_fixed:LWPRINTF_CFG_SUPPORT_TYPE_FIXED=0"
+    "no_si:LWPRINTF_CFG_SUPPORT_TYPE_SI=0"
+    "no_float_hex:LWPRINTF_CFG_SUPPORT_TYPE_FLOAT_HEX=0"
+    "no_base64:LWPRINTF_CFG_SUPPORT_TYPE_BASE64=0"
+    "no_hexdump:LWPRINTF_CFG_SUPPORT_TYPE_HEXDUMP=0"
+    "no_array:LWPRINTF_CFG_SUPPORT_TYPE_ARRAY=0"
+    "no_string_escape:LWPRINTF_CFG_SUPPORT_TYPE_STRING_ESCAPE=0"
+    "no_long_long:LWPRINTF_CFG_SUPPORT_LONG_LONG=0"
+    "reduced_stack:LWPRINTF_CFG_REDUCED_STACK=1"
+    "block_output:LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT=1"
+    "fanout:LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT=1,LWPRINTF_CFG_ENABLE_FANOUT=1"
+    "buff_mode:LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT=1,LWPRINTF_CFG_ENABLE_BUFF_MODE=1"
+    "auto_flush:LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT=1,LWPRINTF_CFG_ENABLE_BUFF_MODE=1,LWPRINTF_CFG_ENABLE_AUTO_FLUSH=1"
+    "low_power:LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT=1,LWPRINTF_CFG_ENABLE_BUFF_MODE=1,LWPRINTF_CFG_ENABLE_LOW_POWER=1"
+    "coalesce:LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT=1,LWPRINTF_CFG_ENABLE_COALESCE=1"
+    "compiled_format:LWPRINTF_CFG_ENABLE_COMPILED_FORMAT=1"
+    "format_cache:LWPRINTF_CFG_ENABLE_COMPILED_FORMAT=1,LWPRINTF_CFG_FORMAT_CACHE_SIZE=8"
+    "deferred:LWPRINTF_CFG_ENABLE_DEFERRED=1"
+    "packed_args:LWPRINTF_CFG_ENABLE_PACKED_ARGS=1"
+    "token:LWPRINTF_CFG_ENABLE_TOKEN=1"
+    "cbor:LWPRINTF_CFG_ENABLE_CBOR=1"
+    "custom_spec:LWPRINTF_CFG_ENABLE_CUSTOM_SPEC=1"
+    "line_prefix:LWPRINTF_CFG_ENABLE_LINE_PREFIX=1"
+    "log_level:LWPRINTF_CFG_ENABLE_LOG_LEVEL=1,LWPRINTF_CFG_LOG_MODULE_COUNT=4"
+    "rate_limit:LWPRINTF_CFG_ENABLE_RATE_LIMIT=1"
+    "resumable:LWPRINTF_CFG_ENABLE_RESUMABLE=1"
+    "scanf:LWPRINTF_CFG_ENABLE_SCANF=1"
+    "deadline:LWPRINTF_CFG_ENABLE_DEADLINE=1"
+    "stats:LWPRINTF_CFG_STATS=1"
+    "stats_hist:LWPRINTF_CFG_STATS=1,LWPRINTF_CFG_STATS_OUT_HIST_BUCKETS=16"
+    "wcet:LWPRINTF_CFG_WCET=1"
+    "minimal:LWPRINTF_CFG_SUPPORT_TYPE_FLOAT=0,LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING=0,LWPRINTF_CFG_SUPPORT_TYPE_BYTE_ARRAY=0,LWPRINTF_CFG_SUPPORT_TYPE_FIXED=0,LWPRINTF_CFG_SUPPORT_TYPE_SI=0,LWPRINTF_CFG_SUPPORT_TYPE_POINTER=0,LWPRINTF_CFG_SUPPORT_LONG_LONG=0,LWPRINTF_CFG_SUPPORT_TYPE_FLOAT_HEX=0,LWPRINTF_CFG_SUPPORT_TYPE_BASE64=0,LWPRINTF_CFG_SUPPORT_TYPE_HEXDUMP=0,LWPRINTF_CFG_SUPPORT_TYPE_ARRAY=0,LWPRINTF_CFG_SUPPORT_TYPE_STRING_ESCAPE=0"
+)
+
+# Size tool must come from the same toolchain as compiler
+get_filename_component(footprint_compiler_dir ${CMAKE_C_COMPILER} DIRECTORY)
+get_filename_component(footprint_compiler_name ${CMAKE_C_COMPILER} NAME)
+string(REGEX REPLACE "(gcc|cc)(-[0-9.]+)?(\\.exe)?$" "" footprint_prefix ${footprint_compiler_name})
+find_program(LWPRINTF_SIZE_TOOL NAMES ${footprint_prefix}size size HINTS ${footprint_compiler_dir})
+
+if(LWPRINTF_SIZE_TOOL)
+    # Stack usage is reported with GCC only, call graph requires GCC 10 or later
+    set(footprint_options "")
+    if(CMAKE_C_COMPILER_ID STREQUAL "GNU")
+        list(APPEND footprint_options -fstack-usage)
+        if(CMAKE_C_COMPILER_VERSION VERSION_GREATER_EQUAL 10)
+            list(APPEND footprint_options -fcallgraph-info=su)
+        endif()
+    endif()
+
+    set(footprint_names "")
+    set(footprint_objects "")
+    foreach(config IN LISTS footprint_configs)
+        string(REGEX MATCH "^([^:]+):(.*)$" config "${config}")
+        set(name ${CMAKE_MATCH_1})
+        string(REPLACE "," ";" defs "${CMAKE_MATCH_2}")
+
+        add_library(${PROJECT_NAME}_footprint_${name} OBJECT EXCLUDE_FROM_ALL
+            ${CMAKE_CURRENT_LIST_DIR}/../lwprintf/src/lwprintf/lwprintf.c
+        )
+        target_include_directories(${PROJECT_NAME}_footprint_${name} PRIVATE
+            ${CMAKE_CURRENT_LIST_DIR}/../lwprintf/src/include
+        )
+        target_compile_definitions(${PROJECT_NAME}_footprint_${name} PRIVATE LWPRINTF_IGNORE_USER_OPTS ${defs})
+        target_compile_options(${PROJECT_NAME}_footprint_${name} PRIVATE ${footprint_options})
+
+        list(APPEND footprint_names ${name})
+        string(APPEND footprint_objects
+            "set(footprint_objects_${name} \"$<TARGET_OBJECTS:${PROJECT_NAME}_footprint_${name}>\")\n")
+    endforeach()
+
+    # Object paths are only known at generation time, they are passed to the report script with generated file
+    file(GENERATE OUTPUT ${CMAKE_CURRENT_BINARY_DIR}/footprint_objects.cmake CONTENT "${footprint_objects}")
+    add_custom_target(${PROJECT_NAME}_footprint
+        COMMAND ${CMAKE_COMMAND} "-DFOOTPRINT_CONFIGS=${footprint_names}"
+                -DFOOTPRINT_OBJECTS_FILE=${CMAKE_CURRENT_BINARY_DIR}/footprint_objects.cmake
+                -DSIZE_TOOL=${LWPRINTF_SIZE_TOOL}
+                -P ${CMAKE_CURRENT_LIST_DIR}/footprint_report.cmake
+        VERBATIM
+    )
+    foreach(name IN LISTS footprint_names)
+        add_dependencies(${PROJECT_NAME}_footprint ${PROJECT_NAME}_footprint_${name})
+    endforeach()
+else()
+    message(STATUS "Size tool not found, footprint target is not available")
+endif()
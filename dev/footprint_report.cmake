@@ -0,0 +1,70 @@
+#
+# Footprint table of library configurations
+#
+# Script is run by LwLibPROJECT_footprint target, with the following variables:
+#
+# FOOTPRINT_CONFIGS: List of configuration names
+# FOOTPRINT_OBJECTS_FILE: Generated file, setting footprint_objects_<name> variable with objects of every configuration
+# SIZE_TOOL: Path to "size" tool of the toolchain
+#
+# Text includes read-only data. Stack is worst-case stack of the public function that needs the most,
+# it is reported when objects have call graph files of GCC 10 or later.
+#
+
+include(${FOOTPRINT_OBJECTS_FILE})
+
+# Right-align value to the column width
+function(footprint_pad value width out)
+    string(LENGTH "${value}" len)
+    if(len LESS width)
+        math(EXPR pad_len "${width} - ${len}")
+        string(REPEAT " " ${pad_len} pad)
+        set(value "${pad}${value}")
+    endif()
+    set(${out} "${value}" PARENT_SCOPE)
+endfunction()
+
+message("Configuration          text     data      bss    stack  function")
+foreach(name IN LISTS FOOTPRINT_CONFIGS)
+    set(objects ${footprint_objects_${name}})
+
+    # Berkeley format with totals, last line holds sum of all objects
+    execute_process(
+        COMMAND ${SIZE_TOOL} -B -t ${objects}
+        OUTPUT_VARIABLE size_out
+        RESULT_VARIABLE size_res
+    )
+    if(NOT size_res EQUAL 0 OR NOT size_out MATCHES "([0-9]+)[ \t]+([0-9]+)[ \t]+([0-9]+)[ \t]+[0-9]+[ \t]+[0-9a-fA-F]+[ \t]+\\(TOTALS\\)")
+        message(FATAL_ERROR "Size of ${name} configuration cannot be read:\n${size_out}")
+    endif()
+    set(text ${CMAKE_MATCH_1})
+    set(data ${CMAKE_MATCH_2})
+    set(bss ${CMAKE_MATCH_3})
+
+    # Worst-case stack, when call graph is available
+    set(stack "-")
+    set(stack_fn "")
+    set(ci_files ${objects})
+    list(TRANSFORM ci_files REPLACE "\\.(o|obj)$" ".ci")
+    list(GET ci_files 0 ci_file)
+    if(EXISTS "${ci_file}")
+        execute_process(
+            COMMAND ${CMAKE_COMMAND} "-DSTACK_OBJECTS=${objects}" -DSTACK_SUMMARY=1
+                    -P ${CMAKE_CURRENT_LIST_DIR}/stack_report.cmake
+            ERROR_VARIABLE stack_out
+        )
+        if(stack_out MATCHES "^([0-9]+) ([^ \n]+)")
+            set(stack ${CMAKE_MATCH_1})
+            set(stack_fn ${CMAKE_MATCH_2})
+        endif()
+    endif()
+
+    string(LENGTH "${name}" len)
+    math(EXPR pad_len "18 - ${len}")
+    string(REPEAT " " ${pad_len} pad)
+    footprint_pad(${text} 9 text)
+    footprint_pad(${data} 9 data)
+    footprint_pad(${bss} 9 bss)
+    footprint_pad(${stack} 9 stack)
+    message("${name}${pad}${text}${data}${bss}${stack}  ${stack_fn}")
+endforeach()
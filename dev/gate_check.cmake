@@ -0,0 +1,122 @@
+#
+# Regression and performance gate
+#
+# Script is run with "cmake -DGATE_PROGRAM=<emulator;program;args> -DGATE_BASELINE=<file> -P gate_check.cmake".
+# Program prints its results as "GATE <name> <value>" lines, every value is compared to the baseline file,
+# with the same "<name> <value>" lines. Larger value is worse, such as number of failed tests or cycles per call.
+#
+# GATE_TOLERANCE: Allowed increase over the baseline, in units of percent. Defaults to 0
+# GATE_RUNS: Number of program runs, the smallest value of every name is used. Defaults to 1
+# GATE_UPDATE: When set, baseline file is written with results of this run, instead of the check
+#
+# Missing baseline file is reported with "Baseline not found" message, test is then skipped
+#
+
+if(NOT DEFINED GATE_TOLERANCE)
+    set(GATE_TOLERANCE 0)
+endif()
+if(NOT DEFINED GATE_RUNS)
+    set(GATE_RUNS 1)
+endif()
+if(NOT GATE_UPDATE AND NOT EXISTS "${GATE_BASELINE}")
+    message("Baseline not found: ${GATE_BASELINE}")
+    return()
+endif()
+
+# Smallest value of every name over all runs, values are compared as fixed-point with one decimal
+set(names "")
+foreach(run RANGE 1 ${GATE_RUNS})
+    execute_process(
+        COMMAND ${GATE_PROGRAM}
+        OUTPUT_VARIABLE out
+        RESULT_VARIABLE res
+    )
+    if(NOT res EQUAL 0)
+        message(FATAL_ERROR "Program ${GATE_PROGRAM} failed with ${res}")
+    endif()
+    string(REGEX MATCHALL "GATE [^ \r\n]+ [0-9]+(\\.[0-9])?" lines "${out}")
+    foreach(line IN LISTS lines)
+        string(REGEX MATCH "^GATE ([^ ]+) ([0-9]+)(\\.([0-9]))?" line "${line}")
+        set(name ${CMAKE_MATCH_1})
+        set(frac 0)
+        if(CMAKE_MATCH_4)
+            set(frac ${CMAKE_MATCH_4})
+        endif()
+        math(EXPR value "${CMAKE_MATCH_2} * 10 + ${frac}")
+        if(NOT DEFINED value_${name})
+            list(APPEND names ${name})
+            set(value_${name} ${value})
+        elseif(value LESS value_${name})
+            set(value_${name} ${value})
+        endif()
+    endforeach()
+endforeach()
+if(NOT names)
+    message(FATAL_ERROR "Program ${GATE_PROGRAM} did not print any GATE line")
+endif()
+
+# Fixed-point value with one decimal as text, right-aligned to the column width
+function(gate_text value out)
+    math(EXPR int "${value} / 10")
+    math(EXPR frac "${value} % 10")
+    set(text "${int}.${frac}")
+    string(LENGTH "${text}" len)
+    if(len LESS 13)
+        math(EXPR pad_len "13 - ${len}")
+        string(REPEAT " " ${pad_len} pad)
+        set(text "${pad}${text}")
+    endif()
+    set(${out} "${text}" PARENT_SCOPE)
+endfunction()
+
+if(GATE_UPDATE)
+    set(content "")
+    foreach(name IN LISTS names)
+        gate_text(${value_${name}} text)
+        string(STRIP "${text}" text)
+        string(APPEND content "${name} ${text}\n")
+    endforeach()
+    file(WRITE "${GATE_BASELINE}" "${content}")
+    message("Baseline written: ${GATE_BASELINE}")
+    return()
+endif()
+
+# Every result must be in the baseline, and not above its limit
+file(STRINGS "${GATE_BASELINE}" base_lines REGEX "^[^ #]+ [0-9]+(\\.[0-9])?$")
+foreach(line IN LISTS base_lines)
+    string(REGEX MATCH "^([^ ]+) ([0-9]+)(\\.([0-9]))?" line "${line}")
+    set(frac 0)
+    if(CMAKE_MATCH_4)
+        set(frac ${CMAKE_MATCH_4})
+    endif()
+    math(EXPR base_${CMAKE_MATCH_1} "${CMAKE_MATCH_2} * 10 + ${frac}")
+endforeach()
+
+set(failed 0)
+message("Name                   baseline       result        limit")
+foreach(name IN LISTS names)
+    if(NOT DEFINED base_${name})
+        message("${name}: not in baseline")
+        set(failed 1)
+        continue()
+    endif()
+    math(EXPR limit "${base_${name}} + ${base_${name}} * ${GATE_TOLERANCE} / 100")
+    gate_text(${base_${name}} base_text)
+    gate_text(${value_${name}} value_text)
+    gate_text(${limit} limit_text)
+    set(status "")
+    if(value_${name} GREATER limit)
+        set(status "  FAIL")
+        set(failed 1)
+    endif()
+    string(LENGTH "${name}" len)
+    math(EXPR pad_len "18 - ${len}")
+    if(pad_len LESS 1)
+        set(pad_len 1)
+    endif()
+    string(REPEAT " " ${pad_len} pad)
+    message("${name}${pad}${base_text}${value_text}${limit_text}${status}")
+endforeach()
+if(failed)
+    message(FATAL_ERROR "Results are above the baseline ${GATE_BASELINE}, by more than ${GATE_TOLERANCE}%")
+endif()
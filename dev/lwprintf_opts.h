@@ -36,16 +36,84 @@
 
 /* Rename this file to "lwprintf_opts.h" for your application */
 
+#if defined(_WIN32)
 #include "windows.h"
+#else
+#include "system/lwprintf_sys_posix.h"
+#endif /* defined(_WIN32) */
 
 /*
  * Open "include/lwprintf/lwprintf_opt.h" and
  * copy & replace here settings you want to change values
  */
 #define LWPRINTF_CFG_OS                1
+#if defined(_WIN32)
 #define LWPRINTF_CFG_OS_MUTEX_HANDLE   HANDLE
+#else
+#define LWPRINTF_CFG_OS_MUTEX_HANDLE   lwprintf_sys_posix_mutex_t
+#endif /* defined(_WIN32) */
 
 #define LWPRINTF_CFG_SUPPORT_LONG_LONG 1
+#define LWPRINTF_CFG_FLOAT_EXACT       1
+/* Tests are built again with automatic protection */
+#ifndef LWPRINTF_CFG_OS_MANUAL_PROTECT
 #define LWPRINTF_CFG_OS_MANUAL_PROTECT 1
+#endif /* LWPRINTF_CFG_OS_MANUAL_PROTECT */
+#define LWPRINTF_CFG_OS_STATS          1
+#define LWPRINTF_CFG_OS_THREAD_DEFAULT 1
+#define LWPRINTF_CFG_STATS             1
+#define LWPRINTF_CFG_STATS_OUT_HIST_BUCKETS 16
+
+#define LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT 1
+#define LWPRINTF_CFG_ENABLE_FANOUT 1
+#define LWPRINTF_CFG_ENABLE_BUFF_MODE 1
+#define LWPRINTF_CFG_ENABLE_AUTO_FLUSH 1
+#define LWPRINTF_CFG_ENABLE_LOW_POWER 1
+#define LWPRINTF_CFG_ENABLE_COALESCE 1
+#define LWPRINTF_CFG_ENABLE_COMPILED_FORMAT 1
+#define LWPRINTF_CFG_FORMAT_CACHE_SIZE 8
+#define LWPRINTF_CFG_ENABLE_DEFERRED 1
+#define LWPRINTF_CFG_ENABLE_PACKED_ARGS 1
+#define LWPRINTF_CFG_ENABLE_TOKEN 1
+#define LWPRINTF_CFG_ENABLE_CBOR 1
+#define LWPRINTF_CFG_ENABLE_ASYNC 1
+#define LWPRINTF_CFG_ASYNC_PRIO_COUNT 2
+#define LWPRINTF_CFG_ENABLE_SMP 1
+#define LWPRINTF_CFG_ENABLE_CRASHLOG 1
+#define LWPRINTF_CFG_ENABLE_COMPRESS 1
+#define LWPRINTF_CFG_ENABLE_PARALLEL 1
+#define LWPRINTF_CFG_ENABLE_TRY_PRINT 1
+#define LWPRINTF_CFG_ENABLE_RATE_LIMIT 1
+#define LWPRINTF_CFG_ENABLE_DEADLINE 1
+#define LWPRINTF_CFG_ENABLE_IOV 1
+#define LWPRINTF_CFG_ENABLE_STRBUF 1
+#define LWPRINTF_CFG_ENABLE_ASPRINTF 1
+#define LWPRINTF_CFG_ENABLE_CUSTOM_SPEC 1
+#define LWPRINTF_CFG_ENABLE_LINE_PREFIX 1
+#define LWPRINTF_CFG_ENABLE_LOG_LEVEL 1
+#define LWPRINTF_CFG_LOG_MODULE_COUNT 2
+/* C++ sink tests are built again without resumable formatting */
+#ifndef LWPRINTF_CFG_ENABLE_RESUMABLE
+#define LWPRINTF_CFG_ENABLE_RESUMABLE 1
+#endif /* LWPRINTF_CFG_ENABLE_RESUMABLE */
+#define LWPRINTF_CFG_ENABLE_SCANF 1
+#define LWPRINTF_CFG_WCET 1
+
+/* Trace hooks record events in test application, benchmarks are built without them */
+#if defined(LWPRINTF_DEV)
+#ifdef __cplusplus
+extern "C"
+#endif /* __cplusplus */
+void lwprintf_dev_trace(const void* lwobj, char evt, unsigned int val);
+#define LWPRINTF_CFG_TRACE_FORMAT_START(lwobj, format)        lwprintf_dev_trace((lwobj), 'F', 0)
+#define LWPRINTF_CFG_TRACE_FORMAT_END(lwobj, len)             lwprintf_dev_trace((lwobj), 'f', (unsigned int)(len))
+#define LWPRINTF_CFG_TRACE_MUTEX_WAIT(lwobj)                  lwprintf_dev_trace((lwobj), 'W', 0)
+#define LWPRINTF_CFG_TRACE_MUTEX_ACQUIRED(lwobj, is_acquired) lwprintf_dev_trace((lwobj), 'w', (is_acquired))
+#define LWPRINTF_CFG_TRACE_MUTEX_RELEASE(lwobj)               lwprintf_dev_trace((lwobj), 'R', 0)
+#define LWPRINTF_CFG_TRACE_CONV_START(lwobj, spec)            lwprintf_dev_trace((lwobj), 'C', (unsigned char)(spec))
+#define LWPRINTF_CFG_TRACE_CONV_END(lwobj, spec)              lwprintf_dev_trace((lwobj), 'c', (unsigned char)(spec))
+#define LWPRINTF_CFG_TRACE_SINK_START(lwobj, len)             lwprintf_dev_trace((lwobj), 'S', (unsigned int)(len))
+#define LWPRINTF_CFG_TRACE_SINK_END(lwobj, is_ok)             lwprintf_dev_trace((lwobj), 's', (is_ok))
+#endif /* defined(LWPRINTF_DEV) */
 
 #endif /* LWPRINTF_HDR_OPTS_H */
@@ -1,8 +1,18 @@
+#include <float.h>
+#include <math.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
 #include "lwprintf/lwprintf.h"
-#include "windows.h"
+#include "lwprintf/lwprintf_compress.h"
+#include "lwprintf/lwprintf_crashlog.h"
+#include "lwprintf/lwprintf_parallel.h"
+#include "lwprintf/lwprintf_smp.h"
+#include "system/lwprintf_sink_rtt.h"
+#if !defined(_WIN32)
+#include "system/lwprintf_sink_mmap.h"
+#endif /* !defined(_WIN32) */
 
 /**
  * \brief           Output function for lwprintf printf function
@@ -24,23 +34,1108 @@ lwprintf_output(int ch, lwprintf_t* lw) {
  */
 size_t tests_passed, tests_failed;
 
+/**
+ * \brief           Result of test group
+ */
+typedef struct {
+    const char* name; /*!< Group name */
+    size_t passed;    /*!< Number of passed tests */
+    size_t failed;    /*!< Number of failed tests */
+    double time_us;   /*!< Duration in units of microseconds */
+} test_group_t;
+
+static test_group_t test_groups[32];
+static size_t test_groups_cnt;
+static uint8_t test_group_is_open;
+static struct timespec test_group_ts;
+
+/**
+ * \brief           End current test group and start the next one
+ * \param[in]       name: Name of the next group, `NULL` to only end current group
+ */
+static void
+test_group(const char* name) {
+    struct timespec now;
+
+    timespec_get(&now, TIME_UTC);
+    if (test_group_is_open) {
+        test_group_t* g = &test_groups[test_groups_cnt - 1];
+
+        g->passed = tests_passed - g->passed;
+        g->failed = tests_failed - g->failed;
+        g->time_us = (double)(now.tv_sec - test_group_ts.tv_sec) * 1e6
+                     + (double)(now.tv_nsec - test_group_ts.tv_nsec) / 1e3;
+        test_group_is_open = 0;
+    }
+    if (name == NULL) {
+        return;
+    }
+
+    /* Group, that does not fit to the table, is reported as failure instead of being merged to other group */
+    if (test_groups_cnt >= sizeof(test_groups) / sizeof(test_groups[0])) {
+        printf("Test error on line: %d\r\n", __LINE__);
+        printf("Test group table is full, group \"%s\" is not reported\r\n", name);
+        tests_failed++;
+        return;
+    }
+    test_groups[test_groups_cnt++] = (test_group_t){name, tests_passed, tests_failed, 0};
+    test_group_is_open = 1;
+    timespec_get(&test_group_ts, TIME_UTC);
+}
+
+/**
+ * \brief           Print results and duration of every test group
+ */
+static void
+test_group_report(void) {
+    printf("--------\r\n");
+    printf("%-12s %8s %8s %12s\r\n", "Group", "passed", "failed", "time [us]");
+    for (size_t i = 0; i < test_groups_cnt; ++i) {
+        printf("%-12s %8u %8u %12.1f\r\n", test_groups[i].name, (unsigned)test_groups[i].passed,
+               (unsigned)test_groups[i].failed, test_groups[i].time_us);
+    }
+}
+
 #define do_test(buff_ptr, buff_size, exp_out, exp_out_len, fmt, ...)                                                   \
     do {                                                                                                               \
-        int len = lwprintf_snprintf((buff_ptr), (buff_size), (fmt), ##__VA_ARGS__);                                    \
-        if (len != (exp_out_len)) {                                                                                    \
+        int len = lwprintf_snprintf((buff_ptr), (buff_size), (fmt), ##__VA_ARGS__);                                    \
+        if (len != (exp_out_len)) {                                                                                    \
+            printf("Test error on line: %d\r\n", __LINE__);                                                            \
+            printf("Exp output len: %d, actual len: %d\r\n", (int)(exp_out_len), len);                                 \
+            tests_failed++;                                                                                            \
+        } else if ((buff_ptr) != NULL && strcmp(buff_ptr, exp_out) != 0) {                                             \
+            printf("Test error on line: %d\r\n", __LINE__);                                                            \
+            printf("Buffers do not match, expected: \"%s\", actual: \"%s\"\r\n", exp_out, buff_ptr);                   \
+            tests_failed++;                                                                                            \
+        } else {                                                                                                       \
+            tests_passed++;                                                                                            \
+        }                                                                                                              \
+                                                                                                                       \
+    } while (0)
+
+#define do_test_measure(fmt, ...)                                                                                      \
+    do {                                                                                                               \
+        char out[256];                                                                                                 \
+        int len = lwprintf_snprintf(out, sizeof(out), (fmt), ##__VA_ARGS__);                                          \
+        int m_len = lwprintf_measure((fmt), ##__VA_ARGS__);                                                            \
+        if (len != m_len || len != (int)strlen(out)) {                                                                 \
+            printf("Test error on line: %d\r\n", __LINE__);                                                            \
+            printf("Measured len: %d, actual len: %d\r\n", m_len, len);                                                \
+            tests_failed++;                                                                                            \
+        } else {                                                                                                       \
+            tests_passed++;                                                                                            \
+        }                                                                                                              \
+    } while (0)
+
+#if LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT
+
+/**
+ * \brief           Block output test instance and collected data
+ */
+static lwprintf_t lw_block;
+static char lw_block_staging[8], lw_block_out[1024];
+static size_t lw_block_out_len, lw_block_out_calls;
+
+/**
+ * \brief           Block output function for lwprintf test instance
+ * \param[in]       data: Data to print
+ * \param[in]       len: Number of characters to print
+ * \param[in]       lw: LwPRINTF instance
+ * \return          `len` value on success, `0` otherwise
+ */
+int
+lwprintf_output_block(const char* data, size_t len, lwprintf_t* lw) {
+    LWPRINTF_UNUSED(lw);
+    if (lw_block_out_len + len >= sizeof(lw_block_out)) {
+        return 0;
+    }
+    memcpy(&lw_block_out[lw_block_out_len], data, len);
+    lw_block_out_len += len;
+    lw_block_out[lw_block_out_len] = '\0';
+    ++lw_block_out_calls;
+    return (int)len;
+}
+
+#define do_test_block(exp_out, exp_calls, fmt, ...)                                                                    \
+    do {                                                                                                               \
+        int len;                                                                                                       \
+        lw_block_out_len = 0;                                                                                          \
+        lw_block_out_calls = 0;                                                                                        \
+        lw_block_out[0] = '\0';                                                                                        \
+        len = lwprintf_printf_ex(&lw_block, (fmt), ##__VA_ARGS__);                                                     \
+        if (len != (int)strlen(exp_out) || strcmp(lw_block_out, exp_out) != 0) {                                       \
+            printf("Test error on line: %d\r\n", __LINE__);                                                            \
+            printf("Block output do not match, expected: \"%s\", actual: \"%s\"\r\n", exp_out, lw_block_out);           \
+            tests_failed++;                                                                                            \
+        } else if (lw_block_out_calls != (size_t)(exp_calls)) {                                                        \
+            printf("Test error on line: %d\r\n", __LINE__);                                                            \
+            printf("Exp block calls: %d, actual calls: %d\r\n", (int)(exp_calls), (int)lw_block_out_calls);             \
+            tests_failed++;                                                                                            \
+        } else {                                                                                                       \
+            tests_passed++;                                                                                            \
+        }                                                                                                              \
+    } while (0)
+
+#endif /* LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT */
+
+#if LWPRINTF_CFG_ENABLE_COMPILED_FORMAT
+
+/**
+ * \brief           Storage for precompiled format segments
+ */
+static void* lw_compiled_storage[64];
+
+#define do_test_compiled(exp_out, fmt, ...)                                                                            \
+    do {                                                                                                               \
+        lwprintf_compiled_t cfmt;                                                                                      \
+        char cbuff[256];                                                                                               \
+        int len;                                                                                                       \
+                                                                                                                       \
+        if (!lwprintf_compile((fmt), &cfmt, lw_compiled_storage, sizeof(lw_compiled_storage))) {                       \
+            printf("Test error on line: %d\r\n", __LINE__);                                                            \
+            printf("Cannot compile format: \"%s\"\r\n", (fmt));                                                         \
+            tests_failed++;                                                                                            \
+            break;                                                                                                     \
+        }                                                                                                              \
+        len = lwprintf_snprintf_compiled(cbuff, sizeof(cbuff), &cfmt, ##__VA_ARGS__);                                  \
+        if (len != (int)strlen(exp_out) || strcmp(cbuff, exp_out) != 0) {                                             \
+            printf("Test error on line: %d\r\n", __LINE__);                                                            \
+            printf("Compiled output do not match, expected: \"%s\", actual: \"%s\"\r\n", exp_out, cbuff);              \
+            tests_failed++;                                                                                            \
+        } else {                                                                                                       \
+            tests_passed++;                                                                                            \
+        }                                                                                                              \
+    } while (0)
+
+#endif /* LWPRINTF_CFG_ENABLE_COMPILED_FORMAT */
+
+#if LWPRINTF_CFG_ENABLE_DEFERRED
+
+/**
+ * \brief           Deferred test instance, ring buffer and collected output
+ */
+static lwprintf_t lw_deferred;
+static void* lw_deferred_buff[16];
+static char lw_deferred_out[256];
+static size_t lw_deferred_out_len;
+
+/**
+ * \brief           Output function for deferred test instance
+ * \param[in]       ch: Character to print
+ * \param[in]       lw: LwPRINTF instance
+ * \return          `ch` value on success, `0` otherwise
+ */
+int
+lwprintf_output_deferred(int ch, lwprintf_t* lw) {
+    LWPRINTF_UNUSED(lw);
+    if (ch != '\0' && lw_deferred_out_len < sizeof(lw_deferred_out) - 1) {
+        lw_deferred_out[lw_deferred_out_len++] = (char)ch;
+        lw_deferred_out[lw_deferred_out_len] = '\0';
+    }
+    return ch;
+}
+
+#define do_test_deferred(exp_out, exp_cnt)                                                                             \
+    do {                                                                                                               \
+        size_t cnt;                                                                                                    \
+        lw_deferred_out_len = 0;                                                                                       \
+        lw_deferred_out[0] = '\0';                                                                                     \
+        cnt = lwprintf_process_deferred_ex(&lw_deferred);                                                              \
+        if (cnt != (size_t)(exp_cnt) || strcmp(lw_deferred_out, exp_out) != 0) {                                       \
+            printf("Test error on line: %d\r\n", __LINE__);                                                            \
+            printf("Deferred output do not match, expected: \"%s\" (%d), actual: \"%s\" (%d)\r\n", exp_out,           \
+                   (int)(exp_cnt), lw_deferred_out, (int)cnt);                                                         \
+            tests_failed++;                                                                                            \
+        } else {                                                                                                       \
+            tests_passed++;                                                                                            \
+        }                                                                                                              \
+    } while (0)
+
+#endif /* LWPRINTF_CFG_ENABLE_DEFERRED */
+
+#if LWPRINTF_CFG_ENABLE_PACKED_ARGS
+
+/**
+ * \brief           Run packed arguments test and compare output with expected
+ * \param[in]       exp_out: Expected output in buffer, possibly truncated
+ * \param[in]       exp_cnt: Expected return value
+ * \param[in]       n: Buffer size to use
+ * \param[in]       fmt: Format string
+ * \param[in]       args: Packed arguments
+ */
+#define do_test_packed(exp_out, exp_cnt, n, fmt, args)                                                                 \
+    do {                                                                                                               \
+        char pbuff[64];                                                                                                \
+        int len;                                                                                                       \
+                                                                                                                       \
+        len = lwprintf_snprintf_packed_ex(NULL, pbuff, (n), (fmt), (args));                                            \
+        if (len != (exp_cnt) || strcmp(pbuff, exp_out) != 0) {                                                         \
+            printf("Test error on line: %d\r\n", __LINE__);                                                            \
+            printf("Packed output do not match, expected: \"%s\" (%d), actual: \"%s\" (%d)\r\n", exp_out,            \
+                   (int)(exp_cnt), pbuff, len);                                                                        \
+            tests_failed++;                                                                                            \
+        } else {                                                                                                       \
+            tests_passed++;                                                                                            \
+        }                                                                                                              \
+    } while (0)
+
+#endif /* LWPRINTF_CFG_ENABLE_PACKED_ARGS */
+
+#if LWPRINTF_CFG_ENABLE_TOKEN
+
+/**
+ * \brief           Tokenized test instance and collected binary output
+ */
+static lwprintf_t lw_token;
+static unsigned char lw_token_out[64];
+static size_t lw_token_out_len;
+
+/**
+ * \brief           Output function for tokenized test instance, `NULL` character is part of binary output
+ * \param[in]       ch: Character to print
+ * \param[in]       lw: LwPRINTF instance
+ * \return          `1` for every character, including `NULL`
+ */
+static int
+lwprintf_output_token(int ch, lwprintf_t* lw) {
+    LWPRINTF_UNUSED(lw);
+    if (lw_token_out_len < sizeof(lw_token_out)) {
+        lw_token_out[lw_token_out_len++] = (unsigned char)ch;
+    }
+    return 1;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_TOKEN */
+
+#if LWPRINTF_CFG_ENABLE_CBOR
+
+/**
+ * \brief           CBOR test instance and collected binary output
+ */
+static lwprintf_t lw_cbor;
+static unsigned char lw_cbor_out[64];
+static size_t lw_cbor_out_len;
+
+/**
+ * \brief           Output function for CBOR test instance
+ * \param[in]       ch: Character to print
+ * \param[in]       lw: LwPRINTF instance
+ * \return          `1` for every character, including `NULL`
+ */
+static int
+lwprintf_output_cbor(int ch, lwprintf_t* lw) {
+    LWPRINTF_UNUSED(lw);
+    if (lw_cbor_out_len < sizeof(lw_cbor_out)) {
+        lw_cbor_out[lw_cbor_out_len++] = (unsigned char)ch;
+    }
+    return 1;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_CBOR */
+
+#if LWPRINTF_CFG_ENABLE_LINE_PREFIX
+
+/**
+ * \brief           Line prefix test instance, staging buffer, collected output and time
+ */
+static lwprintf_t lw_prefix;
+static char lw_prefix_staging[8];
+static char lw_prefix_out[256];
+static size_t lw_prefix_out_len;
+static uint32_t lw_prefix_sec, lw_prefix_ms;
+
+/**
+ * \brief           Output function for line prefix test instance
+ * \param[in]       ch: Character to print
+ * \param[in]       lw: LwPRINTF instance
+ * \return          `ch` value on success, `0` otherwise
+ */
+int
+lwprintf_output_prefix(int ch, lwprintf_t* lw) {
+    LWPRINTF_UNUSED(lw);
+    if (ch != '\0' && lw_prefix_out_len < sizeof(lw_prefix_out) - 1) {
+        lw_prefix_out[lw_prefix_out_len++] = (char)ch;
+        lw_prefix_out[lw_prefix_out_len] = '\0';
+    }
+    return ch;
+}
+
+/**
+ * \brief           Block output function for line prefix test instance
+ * \param[in]       data: Characters to print
+ * \param[in]       len: Number of characters
+ * \param[in]       lw: LwPRINTF instance
+ * \return          `len` on success
+ */
+int
+lwprintf_output_block_prefix(const char* data, size_t len, lwprintf_t* lw) {
+    for (size_t i = 0; i < len; ++i) {
+        lwprintf_output_prefix(data[i], lw);
+    }
+    return (int)len;
+}
+
+/**
+ * \brief           Time function for line prefix test instance
+ * \param[out]      sec: Seconds
+ * \param[out]      ms: Milliseconds
+ * \param[in]       lw: LwPRINTF instance
+ */
+void
+lwprintf_prefix_time(uint32_t* sec, uint32_t* ms, lwprintf_t* lw) {
+    LWPRINTF_UNUSED(lw);
+    *sec = lw_prefix_sec;
+    *ms = lw_prefix_ms;
+}
+
+#define do_test_prefix(exp_out, exp_len, fmt, ...)                                                                     \
+    do {                                                                                                               \
+        int len;                                                                                                       \
+        lw_prefix_out_len = 0;                                                                                         \
+        lw_prefix_out[0] = '\0';                                                                                       \
+        len = lwprintf_printf_ex(&lw_prefix, (fmt), ##__VA_ARGS__);                                                    \
+        if (len != (exp_len) || strcmp(lw_prefix_out, exp_out) != 0) {                                                 \
+            printf("Test error on line: %d\r\n", __LINE__);                                                            \
+            printf("Prefix output do not match, expected: \"%s\" (%d), actual: \"%s\" (%d)\r\n", exp_out,             \
+                   (int)(exp_len), lw_prefix_out, len);                                                                \
+            tests_failed++;                                                                                            \
+        } else {                                                                                                       \
+            tests_passed++;                                                                                            \
+        }                                                                                                              \
+    } while (0)
+
+#endif /* LWPRINTF_CFG_ENABLE_LINE_PREFIX */
+
+#if LWPRINTF_CFG_ENABLE_FANOUT
+
+/**
+ * \brief           Fan-out test instance, its staging buffer and output of the sinks
+ */
+static lwprintf_t lw_fanout;
+static char lw_fanout_staging[8];
+static char lw_fanout_out[3][64];
+static size_t lw_fanout_len[3], lw_fanout_usb_space;
+
+/**
+ * \brief           Append data to output of the sink
+ * \param[in]       idx: Sink index
+ * \param[in]       data: Characters to append
+ * \param[in]       len: Number of characters
+ */
+static void
+lw_fanout_append(size_t idx, const char* data, size_t len) {
+    for (size_t i = 0; i < len && lw_fanout_len[idx] < sizeof(lw_fanout_out[idx]) - 1; ++i) {
+        lw_fanout_out[idx][lw_fanout_len[idx]++] = data[i];
+    }
+    lw_fanout_out[idx][lw_fanout_len[idx]] = '\0';
+}
+
+/**
+ * \brief           UART sink of fan-out test instance
+ */
+static int
+lw_fanout_uart(const char* data, size_t len, lwprintf_t* lw) {
+    LWPRINTF_UNUSED(lw);
+    lw_fanout_append(0, data, len);
+    return (int)len;
+}
+
+/**
+ * \brief           Crash buffer sink of fan-out test instance
+ */
+static int
+lw_fanout_crash(const char* data, size_t len, lwprintf_t* lw) {
+    LWPRINTF_UNUSED(lw);
+    lw_fanout_append(1, data, len);
+    return (int)len;
+}
+
+/**
+ * \brief           USB sink of fan-out test instance, stalls when its space runs out
+ */
+static int
+lw_fanout_usb(const char* data, size_t len, lwprintf_t* lw) {
+    LWPRINTF_UNUSED(lw);
+    len = len < lw_fanout_usb_space ? len : lw_fanout_usb_space;
+    lw_fanout_usb_space -= len;
+    lw_fanout_append(2, data, len);
+    return (int)len;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_FANOUT */
+
+#if LWPRINTF_CFG_ENABLE_LOG_LEVEL
+
+/**
+ * \brief           Log level test instance, number of printed characters and evaluated arguments
+ */
+static lwprintf_t lw_level;
+static size_t lw_level_out_cnt, lw_level_arg_cnt;
+
+/**
+ * \brief           Output function for log level test instance
+ * \param[in]       ch: Character to print
+ * \param[in]       lw: LwPRINTF instance
+ * \return          `ch` value
+ */
+int
+lwprintf_output_level(int ch, lwprintf_t* lw) {
+    LWPRINTF_UNUSED(lw);
+    if (ch != '\0') {
+        ++lw_level_out_cnt;
+    }
+    return ch;
+}
+
+/**
+ * \brief           Argument for log level tests, counts its evaluations
+ * \return          Argument value
+ */
+static int
+lw_level_arg(void) {
+    return (int)++lw_level_arg_cnt;
+}
+
+#define do_test_level(exp_out_cnt, exp_arg_cnt, stmt)                                                                  \
+    do {                                                                                                               \
+        lw_level_out_cnt = 0;                                                                                          \
+        lw_level_arg_cnt = 0;                                                                                          \
+        stmt;                                                                                                          \
+        if (lw_level_out_cnt != (exp_out_cnt) || lw_level_arg_cnt != (exp_arg_cnt)) {                                 \
+            printf("Test error on line: %d\r\n", __LINE__);                                                            \
+            printf("Log level output: %d, arguments: %d\r\n", (int)lw_level_out_cnt, (int)lw_level_arg_cnt);          \
+            tests_failed++;                                                                                            \
+        } else {                                                                                                       \
+            tests_passed++;                                                                                            \
+        }                                                                                                              \
+    } while (0)
+
+#endif /* LWPRINTF_CFG_ENABLE_LOG_LEVEL */
+
+#if LWPRINTF_CFG_ENABLE_ASYNC
+
+/**
+ * \brief           Asynchronous test instance, output queue and collected output
+ */
+static lwprintf_t lw_async;
+static void* lw_async_buff[24];
+#if LWPRINTF_CFG_ASYNC_PRIO_COUNT > 1
+static void* lw_async_buff_high[16];
+#endif /* LWPRINTF_CFG_ASYNC_PRIO_COUNT > 1 */
+static char lw_async_out[256];
+static size_t lw_async_out_len;
+static int lw_async_done_cnt;
+
+/**
+ * \brief           Output function for asynchronous test instance
+ * \param[in]       ch: Character to print
+ * \param[in]       lw: LwPRINTF instance
+ * \return          `ch` value on success, `0` otherwise
+ */
+int
+lwprintf_output_async(int ch, lwprintf_t* lw) {
+    LWPRINTF_UNUSED(lw);
+    if (ch != '\0' && lw_async_out_len < sizeof(lw_async_out) - 1) {
+        lw_async_out[lw_async_out_len++] = (char)ch;
+        lw_async_out[lw_async_out_len] = '\0';
+    }
+    return ch;
+}
+
+/**
+ * \brief           Completion callback for asynchronous test messages
+ * \param[in]       lw: LwPRINTF instance
+ * \param[in]       arg: Value added to completion counter
+ */
+void
+lwprintf_async_done(lwprintf_t* lw, void* arg) {
+    LWPRINTF_UNUSED(lw);
+    lw_async_done_cnt += (int)(uintptr_t)arg;
+}
+
+#define do_test_async(exp_out, exp_cnt)                                                                                \
+    do {                                                                                                               \
+        size_t cnt;                                                                                                    \
+        lw_async_out_len = 0;                                                                                          \
+        lw_async_out[0] = '\0';                                                                                        \
+        cnt = lwprintf_process_async_ex(&lw_async);                                                                    \
+        if (cnt != (size_t)(exp_cnt) || strcmp(lw_async_out, exp_out) != 0) {                                          \
+            printf("Test error on line: %d\r\n", __LINE__);                                                            \
+            printf("Async output do not match, expected: \"%s\" (%d), actual: \"%s\" (%d)\r\n", exp_out,              \
+                   (int)(exp_cnt), lw_async_out, (int)cnt);                                                            \
+            tests_failed++;                                                                                            \
+        } else {                                                                                                       \
+            tests_passed++;                                                                                            \
+        }                                                                                                              \
+    } while (0)
+
+#endif /* LWPRINTF_CFG_ENABLE_ASYNC */
+
+#if LWPRINTF_CFG_ENABLE_SMP
+
+/**
+ * \brief           Merge object with per-core instances, final instance with collected output, and global time
+ */
+static lwprintf_smp_t lw_smp;
+static lwprintf_smp_channel_t lw_smp_channels[2];
+static uint32_t lw_smp_buff[2][16];
+static char lw_smp_staging[2][16];
+static lwprintf_t lw_smp_out;
+static char lw_smp_out_str[256];
+static size_t lw_smp_out_len;
+static uint32_t lw_smp_time;
+
+/**
+ * \brief           Output function for merged output
+ * \param[in]       ch: Character to print
+ * \param[in]       lw: LwPRINTF instance
+ * \return          `ch` value on success, `0` otherwise
+ */
+int
+lwprintf_output_smp(int ch, lwprintf_t* lw) {
+    LWPRINTF_UNUSED(lw);
+    if (ch != '\0' && lw_smp_out_len < sizeof(lw_smp_out_str) - 1) {
+        lw_smp_out_str[lw_smp_out_len++] = (char)ch;
+        lw_smp_out_str[lw_smp_out_len] = '\0';
+    }
+    return ch;
+}
+
+/**
+ * \brief           Global time for merge test
+ * \return          Current time
+ */
+uint32_t
+lwprintf_smp_time(void) {
+    return lw_smp_time;
+}
+
+#define do_test_smp(exp_out, exp_cnt)                                                                                  \
+    do {                                                                                                               \
+        size_t cnt;                                                                                                    \
+        lw_smp_out_len = 0;                                                                                            \
+        lw_smp_out_str[0] = '\0';                                                                                      \
+        cnt = lwprintf_smp_process(&lw_smp);                                                                           \
+        if (cnt != (size_t)(exp_cnt) || strcmp(lw_smp_out_str, exp_out) != 0) {                                       \
+            printf("Test error on line: %d\r\n", __LINE__);                                                            \
+            printf("Merged output do not match, expected: \"%s\" (%d), actual: \"%s\" (%d)\r\n", exp_out,             \
+                   (int)(exp_cnt), lw_smp_out_str, (int)cnt);                                                          \
+            tests_failed++;                                                                                            \
+        } else {                                                                                                       \
+            tests_passed++;                                                                                            \
+        }                                                                                                              \
+    } while (0)
+
+#endif /* LWPRINTF_CFG_ENABLE_SMP */
+
+#if LWPRINTF_CFG_ENABLE_CRASHLOG
+
+/**
+ * \brief           Crash log object, its no-init memory with `32` bytes of data, and spilled flash pages
+ */
+static lwprintf_crashlog_t lw_crash;
+static uint32_t lw_crash_mem[sizeof(lwprintf_crashlog_hdr_t) / sizeof(uint32_t) + 8];
+static char lw_crash_staging[8];
+static char lw_crash_pages[2][17];
+static uint32_t lw_crash_spill_cnt, lw_crash_spill_seq;
+
+/**
+ * \brief           Spill function of crash log test, storing pages to simulated flash
+ */
+static void
+lw_crash_spill(uint32_t page, uint32_t seq, const void* data, size_t len, void* arg) {
+    LWPRINTF_UNUSED(arg);
+    memcpy(lw_crash_pages[page], data, len);
+    lw_crash_pages[page][len] = '\0';
+    lw_crash_spill_seq = seq;
+    ++lw_crash_spill_cnt;
+}
+
+#define do_test_crashlog(exp_out, exp_restored)                                                                        \
+    do {                                                                                                               \
+        char out[64];                                                                                                  \
+        size_t len = lwprintf_crashlog_read(&lw_crash, 0, out, sizeof(out) - 1);                                       \
+        out[len] = '\0';                                                                                               \
+        if (strcmp(out, exp_out) != 0 || lwprintf_crashlog_get_restored(&lw_crash) != (size_t)(exp_restored)) {        \
+            printf("Test error on line: %d\r\n", __LINE__);                                                            \
+            printf("Crash log do not match, expected: \"%s\" (%d), actual: \"%s\" (%d)\r\n", exp_out,                 \
+                   (int)(exp_restored), out, (int)lwprintf_crashlog_get_restored(&lw_crash));                          \
+            tests_failed++;                                                                                            \
+        } else {                                                                                                       \
+            tests_passed++;                                                                                            \
+        }                                                                                                              \
+    } while (0)
+
+#endif /* LWPRINTF_CFG_ENABLE_CRASHLOG */
+
+#if LWPRINTF_CFG_ENABLE_COMPRESS
+
+/**
+ * \brief           Compression object, its history window and compressed output
+ */
+static lwprintf_compress_t lw_cmp;
+static unsigned char lw_cmp_window[256];
+static char lw_cmp_staging[64];
+static unsigned char lw_cmp_out[1024];
+static size_t lw_cmp_out_len, lw_cmp_out_max = sizeof(lw_cmp_out);
+
+/**
+ * \brief           Output function of compressed bytes
+ * \return          `ch` value on success, `0` when `lw_cmp_out_max` bytes were written
+ */
+static int
+lwprintf_output_compress(int ch, lwprintf_t* lw) {
+    LWPRINTF_UNUSED(lw);
+    if (lw_cmp_out_len >= lw_cmp_out_max) {
+        return 0;
+    }
+    lw_cmp_out[lw_cmp_out_len++] = (unsigned char)ch;
+    return ch;
+}
+
+/**
+ * \brief           Decode compressed output, the same way as host script does
+ * \param[out]      out: Output buffer for decoded text
+ * \param[in]       out_size: Size of output buffer
+ * \return          Length of decoded text
+ */
+static size_t
+lw_cmp_decode(char* out, size_t out_size) {
+    size_t len = 0, start = 0;
+
+    for (size_t i = 0; i < lw_cmp_out_len;) {
+        unsigned flags = lw_cmp_out[i++];
+
+        for (unsigned bit = 0; bit < 8 && i < lw_cmp_out_len; ++bit) {
+            if ((flags & (1U << bit)) == 0) {
+                out[len++] = (char)lw_cmp_out[i++];
+            } else {
+                unsigned val = ((unsigned)lw_cmp_out[i] << 8) | lw_cmp_out[i + 1];
+
+                i += 2;
+                if ((val >> 5) == 0) {
+                    start = (val & 0x1F) == 0x1F ? len : start; /* History reset */
+                    break;
+                }
+                for (unsigned n = 0; n < (val & 0x1F) + 3; ++n, ++len) {
+                    out[len] = len - start >= (val >> 5) ? out[len - (val >> 5)] : '?';
+                }
+            }
+            if (len + 40 > out_size) {
+                return len;
+            }
+        }
+    }
+    out[len] = '\0';
+    return len;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_COMPRESS */
+
+#if LWPRINTF_CFG_ENABLE_PARALLEL
+
+/**
+ * \brief           Number of posted worker calls
+ */
+static size_t lw_parallel_posted;
+
+/**
+ * \brief           Post function of parallel formatting, runs worker call immediately
+ * \param[in]       fb: Batch object
+ * \param[in]       arg: User argument
+ */
+static void
+lwprintf_parallel_post(lwprintf_format_batch_t* fb, void* arg) {
+    (void)arg;
+    ++lw_parallel_posted;
+    lwprintf_format_batch_work(fb);
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_PARALLEL */
+
+#if LWPRINTF_CFG_OS_STATS || LWPRINTF_CFG_STATS
+
+/**
+ * \brief           Statistics test instance and its time
+ */
+static lwprintf_t lw_stats;
+static uint32_t lw_stats_time;
+
+/**
+ * \brief           Timestamp function for statistics test, time advances by `1` on every call
+ * \return          Current time
+ */
+uint32_t
+lwprintf_stats_time(void) {
+    return ++lw_stats_time;
+}
+
+/**
+ * \brief           Output function of statistics test, that cancels print at `#` character
+ * and takes `8` more time units for `w` character
+ * \param[in]       ch: Character to print
+ * \param[in]       lw: LwPRINTF instance
+ * \return          `ch` value, `0` to cancel the print
+ */
+static int
+lwprintf_output_stats(int ch, lwprintf_t* lw) {
+    LWPRINTF_UNUSED(lw);
+    if (ch == 'w') {
+        lw_stats_time += 8;
+    }
+    return ch == '#' ? 0 : ch;
+}
+
+#endif /* LWPRINTF_CFG_OS_STATS || LWPRINTF_CFG_STATS */
+
+#if LWPRINTF_CFG_ENABLE_AUTO_FLUSH
+
+/**
+ * \brief           Time of auto flush test, set directly by the test
+ */
+static uint32_t lw_flush_time;
+
+/**
+ * \brief           Timestamp function for auto flush test
+ * \return          Current time
+ */
+static uint32_t
+lwprintf_flush_time(void) {
+    return lw_flush_time;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_AUTO_FLUSH */
+
+#if LWPRINTF_CFG_ENABLE_RATE_LIMIT
+
+/**
+ * \brief           Time of rate limit test, set directly by the test
+ */
+static uint32_t lw_limit_time;
+
+/**
+ * \brief           Timestamp function for rate limit test
+ * \return          Current time
+ */
+static uint32_t
+lwprintf_limit_time(void) {
+    return lw_limit_time;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_RATE_LIMIT */
+
+#if LWPRINTF_CFG_ENABLE_COALESCE
+
+/**
+ * \brief           Time of coalescing test, set directly by the test
+ */
+static uint32_t lw_coalesce_time;
+
+/**
+ * \brief           Timestamp function for coalescing test
+ * \return          Current time
+ */
+static uint32_t
+lwprintf_coalesce_time(void) {
+    return lw_coalesce_time;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_COALESCE */
+
+#if LWPRINTF_CFG_ENABLE_DEADLINE
+
+/**
+ * \brief           Deadline test instance, its time and collected output
+ */
+static lwprintf_t lw_deadline;
+static uint32_t lw_deadline_time;
+static char lw_deadline_out[64];
+static size_t lw_deadline_out_len;
+
+/**
+ * \brief           Timestamp function for deadline test, time advances by `1` on every call
+ * \return          Current time
+ */
+static uint32_t
+lwprintf_deadline_time(void) {
+    return ++lw_deadline_time;
+}
+
+/**
+ * \brief           Output function for deadline test instance
+ * \param[in]       ch: Character to print
+ * \param[in]       lw: LwPRINTF instance
+ * \return          `ch` value
+ */
+static int
+lwprintf_output_deadline(int ch, lwprintf_t* lw) {
+    LWPRINTF_UNUSED(lw);
+    if (ch != '\0' && lw_deadline_out_len + 1 < sizeof(lw_deadline_out)) {
+        lw_deadline_out[lw_deadline_out_len++] = (char)ch;
+        lw_deadline_out[lw_deadline_out_len] = '\0';
+    }
+    return ch;
+}
+
+#define do_test_deadline(exp_out, exp_len, budget, fmt, ...)                                                           \
+    do {                                                                                                               \
+        int len;                                                                                                       \
+        lw_deadline_out_len = 0;                                                                                       \
+        lw_deadline_out[0] = '\0';                                                                                     \
+        len = lwprintf_printf_deadline_ex(&lw_deadline, lwprintf_deadline_time, (budget), (fmt), ##__VA_ARGS__);       \
+        if (len != (exp_len) || strcmp(lw_deadline_out, exp_out) != 0) {                                              \
             printf("Test error on line: %d\r\n", __LINE__);                                                            \
-            printf("Exp output len: %d, actual len: %d\r\n", (int)(exp_out_len), len);                                 \
-            tests_failed++;                                                                                            \
-        } else if ((buff_ptr) != NULL && strcmp(buff_ptr, exp_out) != 0) {                                             \
-            printf("Test error on line: %d\r\n", __LINE__);                                                            \
-            printf("Buffers do not match, expected: \"%s\", actual: \"%s\"\r\n", exp_out, buff_ptr);                   \
+            printf("Deadline output do not match, expected: \"%s\", actual: \"%s\", len: %d\r\n", exp_out,           \
+                   lw_deadline_out, len);                                                                              \
             tests_failed++;                                                                                            \
         } else {                                                                                                       \
             tests_passed++;                                                                                            \
         }                                                                                                              \
-                                                                                                                       \
     } while (0)
 
+#endif /* LWPRINTF_CFG_ENABLE_DEADLINE */
+
+#if defined(LWPRINTF_DEV)
+
+/**
+ * \brief           Trace test instance and its recorded events
+ */
+static lwprintf_t lw_trace;
+static char lw_trace_log[32];
+static size_t lw_trace_len;
+static unsigned int lw_trace_format_len;
+
+/**
+ * \brief           Trace hook of test application, records events of trace test instance only
+ * \param[in]       lwobj: LwPRINTF instance
+ * \param[in]       evt: Event character, uppercase at start and lowercase at end
+ * \param[in]       val: Event value
+ */
+void
+lwprintf_dev_trace(const void* lwobj, char evt, unsigned int val) {
+    if (lwobj != &lw_trace || lw_trace_len + 1 >= sizeof(lw_trace_log)) {
+        return;
+    }
+    lw_trace_log[lw_trace_len++] = evt;
+    lw_trace_log[lw_trace_len] = '\0';
+    if (evt == 'f') {
+        lw_trace_format_len = val;
+    }
+}
+
+#endif /* defined(LWPRINTF_DEV) */
+
+#if defined(LWPRINTF_DEV) && LWPRINTF_CFG_OS && LWPRINTF_CFG_OS_MANUAL_PROTECT
+
+/**
+ * \brief           Output function of trace test, without printing
+ * \param[in]       ch: Character to print
+ * \param[in]       lw: LwPRINTF instance
+ * \return          `ch` value
+ */
+static int
+lwprintf_output_trace(int ch, lwprintf_t* lw) {
+    LWPRINTF_UNUSED(lw);
+    return ch;
+}
+
+#endif /* defined(LWPRINTF_DEV) && LWPRINTF_CFG_OS && LWPRINTF_CFG_OS_MANUAL_PROTECT */
+
+#if LWPRINTF_CFG_ENABLE_STRBUF
+
+/**
+ * \brief           Memory pool for string builder test, with blocks of fixed size
+ */
+static void* lw_strbuf_pool[4][8];
+static uint8_t lw_strbuf_pool_used[4];
+
+/**
+ * \brief           Take free block from the pool
+ * \param[in]       size: Requested size
+ * \param[in]       arg: User argument
+ * \return          Block, `NULL` if pool is empty
+ */
+static void*
+lw_strbuf_alloc(size_t size, void* arg) {
+    LWPRINTF_UNUSED(arg);
+    for (size_t i = 0; size <= sizeof(lw_strbuf_pool[0]) && i < LWPRINTF_ARRAYSIZE(lw_strbuf_pool); ++i) {
+        if (!lw_strbuf_pool_used[i]) {
+            lw_strbuf_pool_used[i] = 1;
+            return lw_strbuf_pool[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * \brief           Return block to the pool
+ * \param[in]       ptr: Block to release
+ * \param[in]       arg: User argument
+ */
+static void
+lw_strbuf_free(void* ptr, void* arg) {
+    LWPRINTF_UNUSED(arg);
+    lw_strbuf_pool_used[((void**)ptr - lw_strbuf_pool[0]) / LWPRINTF_ARRAYSIZE(lw_strbuf_pool[0])] = 0;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_STRBUF */
+
+#if LWPRINTF_CFG_ENABLE_ASPRINTF
+
+/**
+ * \brief           Arena for allocating print test. Only the last block can be resized or released
+ */
+static char lw_asprintf_arena[64];
+static size_t lw_asprintf_pos, lw_asprintf_last;
+
+/**
+ * \brief           Take block from the end of the arena
+ * \param[in]       size: Requested size
+ * \param[in]       arg: User argument
+ * \return          Block, `NULL` if arena is full
+ */
+static void*
+lw_asprintf_alloc(size_t size, void* arg) {
+    LWPRINTF_UNUSED(arg);
+    if (size > sizeof(lw_asprintf_arena) - lw_asprintf_pos) {
+        return NULL;
+    }
+    lw_asprintf_last = lw_asprintf_pos;
+    lw_asprintf_pos += size;
+    return &lw_asprintf_arena[lw_asprintf_last];
+}
+
+/**
+ * \brief           Resize the last block of the arena
+ * \param[in]       ptr: Block to resize
+ * \param[in]       size: New size
+ * \param[in]       arg: User argument
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+lw_asprintf_resize(void* ptr, size_t size, void* arg) {
+    size_t start = (size_t)((char*)ptr - lw_asprintf_arena);
+
+    LWPRINTF_UNUSED(arg);
+    if (start != lw_asprintf_last || size > sizeof(lw_asprintf_arena) - start) {
+        return 0;
+    }
+    lw_asprintf_pos = start + size;
+    return 1;
+}
+
+/**
+ * \brief           Release the last block of the arena
+ * \param[in]       ptr: Block to release
+ * \param[in]       arg: User argument
+ */
+static void
+lw_asprintf_free(void* ptr, void* arg) {
+    lw_asprintf_resize(ptr, 0, arg);
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_ASPRINTF */
+
+#if LWPRINTF_CFG_ENABLE_RESUMABLE
+
+/**
+ * \brief           Format text chunk by chunk with resumable formatting
+ * \param[out]      out: Buffer for text of all chunks
+ * \param[in]       chunk_size: Size of every chunk
+ * \param[in]       format: Format string
+ * \param[in]       ...: Format arguments
+ * \return          Number of chunks
+ */
+static size_t
+lw_resume_format(char* out, size_t chunk_size, const char* format, ...) {
+    lwprintf_resume_t ctx;
+    va_list ap;
+    size_t len, chunks = 0;
+
+    va_start(ap, format);
+    lwprintf_vformat_start(&ctx, format, ap);
+    while ((len = lwprintf_format_continue(&ctx, out, chunk_size)) > 0) {
+        out += len;
+        ++chunks;
+    }
+    *out = '\0';
+    va_end(ap);
+    return chunks;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_RESUMABLE */
+
+#if LWPRINTF_CFG_ENABLE_CUSTOM_SPEC
+
+/**
+ * \brief           Custom specifier instance
+ */
+static lwprintf_t lw_custom;
+
+/**
+ * \brief           IPv4 address from byte array, with nested format
+ * \param[in]       ctx: Output context
+ * \param[in]       spec: Specifier character
+ * \param[in,out]   arg: Pointer to variable argument list
+ */
+static void
+lw_custom_ipv4(lwprintf_spec_ctx_t* ctx, char spec, va_list* arg) {
+    const uint8_t* ip = va_arg(*arg, const uint8_t*);
+
+    LWPRINTF_UNUSED(spec);
+    lwprintf_spec_printf(ctx, "%u.%u.%u.%u", (unsigned)ip[0], (unsigned)ip[1], (unsigned)ip[2], (unsigned)ip[3]);
+}
+
+/**
+ * \brief           Boolean as text, written from temporary string
+ * \param[in]       ctx: Output context
+ * \param[in]       spec: Specifier character
+ * \param[in,out]   arg: Pointer to variable argument list
+ */
+static void
+lw_custom_bool(lwprintf_spec_ctx_t* ctx, char spec, va_list* arg) {
+    char str[8];
+    size_t len = 0;
+
+    LWPRINTF_UNUSED(spec);
+    for (const char* b = va_arg(*arg, int) ? "true" : "false"; *b != '\0'; ++b) {
+        str[len++] = *b;
+    }
+    lwprintf_spec_write(ctx, str, len);
+}
+
+/**
+ * \brief           Bytes as hex pairs, streamed in parts with own padding.
+ * Precision sets number of bytes, default is `3`
+ * \param[in]       ctx: Output context
+ * \param[in]       spec: Specifier character
+ * \param[in,out]   arg: Pointer to variable argument list
+ */
+static void
+lw_custom_hex(lwprintf_spec_ctx_t* ctx, char spec, va_list* arg) {
+    static const char hex[] = "0123456789abcdef";
+    const uint8_t* data = va_arg(*arg, const uint8_t*);
+    lwprintf_spec_info_t info;
+    size_t cnt, len;
+
+    LWPRINTF_UNUSED(spec);
+    lwprintf_spec_get_info(ctx, &info);
+    cnt = info.precision >= 0 ? (size_t)info.precision : 3;
+    len = cnt > 0 ? (cnt * 3 - 1) : 0;
+    for (size_t i = len; !info.left && info.width > 0 && i < (size_t)info.width; ++i) {
+        lwprintf_spec_write_raw(ctx, info.zero ? "0" : " ", 1);
+    }
+    for (size_t i = 0; i < cnt; ++i) {
+        char pair[3] = {hex[data[i] >> 4], hex[data[i] & 0x0F], ':'};
+        lwprintf_spec_write_raw(ctx, pair, i + 1 < cnt ? 3 : 2);
+    }
+    for (size_t i = len; info.left && info.width > 0 && i < (size_t)info.width; ++i) {
+        lwprintf_spec_write_raw(ctx, " ", 1);
+    }
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_CUSTOM_SPEC */
+
 int
 main(void) {
     double num = 2123213213142.032;
@@ -49,6 +1144,7 @@ main(void) {
 
     lwprintf_init(lwprintf_output);
 
+    test_group("float");
     /* Good tests */
     do_test(buffer, sizeof(buffer), "               4e+08", 20, "%20.*g", 0, 432432423.342321321);
     do_test(buffer, sizeof(buffer), "               4e+08", 20, "%20.*g", 1, 432432423.342321321);
@@ -107,6 +1203,170 @@ main(void) {
     do_test(buffer, sizeof(buffer), "-1.2346e-01", 11, "%.4e", -0.123456);
     do_test(buffer, sizeof(buffer), "1e+02", 5, "%.0e", 123.456);
     do_test(buffer, sizeof(buffer), "-1e+02", 6, "%.0e", -123.456);
+    do_test(buffer, sizeof(buffer), "1.500e-99", 9, "%.3e", 1.5e-99);
+    do_test(buffer, sizeof(buffer), "9.87654e+88", 11, "%g", 9.87654e88);
+    do_test(buffer, sizeof(buffer), "4.60500000000000e+02", 20, "%.14e", 460.5);
+    do_test(buffer, sizeof(buffer), "9.7E-14", 7, "%.15G", 9.7e-14);
+    do_test(buffer, sizeof(buffer), "1.000000e-18", 12, "%e", 1e-18);
+    do_test(buffer, sizeof(buffer), "1.000000e+100", 13, "%e", 1e100);
+    do_test(buffer, sizeof(buffer), "1.000000e-300", 13, "%e", 1e-300);
+
+    /* Rounding carries mantissa to the next power of 10 */
+    do_test(buffer, sizeof(buffer), "1.000e+01", 9, "%.3e", 9.9996);
+    do_test(buffer, sizeof(buffer), "1e+45", 5, "%.0e", 9.76e44);
+    do_test(buffer, sizeof(buffer), "1e+08", 5, "%.1g", 99056000.0);
+    do_test(buffer, sizeof(buffer), "0.0001", 6, "%g", 9.999999e-5);
+
+    /* Explicit precision of small value takes fast path, rounding carries to integer part */
+    do_test(buffer, sizeof(buffer), "0.01 0.000 10.0 -3.14", 21, "%.2f %.3f %.1f %.2f", 0.005, 0.0001, 9.96, -3.14159);
+    do_test(buffer, sizeof(buffer), "   12.50|12.5    |-0012.50", 26, "%8.2f|%-8.1f|%08.2f", 12.5, 12.5, -12.5);
+    do_test(buffer, sizeof(buffer), "999999999999999.000 1000000000000000.000", 40, "%.3f %.3f", 999999999999999.0,
+            1e15);
+    /* Negative zero keeps its sign */
+    do_test(buffer, sizeof(buffer), "-0.000000 -0.0 -0000.00 -0.000000e+00 -0", 40, "%f %+.1f %08.2f %e %g", -0.0, -0.0,
+            -0.0, -0.0, -0.0);
+
+#if LWPRINTF_CFG_FLOAT_SHORTEST
+    /* Shortest round-trip engine, exact ties round to even */
+    do_test(buffer, sizeof(buffer), "2", 1, "%.0f", 2.5);
+    do_test(buffer, sizeof(buffer), "0.12", 4, "%.2f", 0.125);
+    do_test(buffer, sizeof(buffer), "2.67", 4, "%.2f", 2.675);
+    do_test(buffer, sizeof(buffer), "-0.000000", 9, "%f", -0.0);
+    /* Digits beyond shortest representation are zeros, exact value is 93310397111457.984375 */
+    do_test(buffer, sizeof(buffer), "93310397111457.980 9.33103971114579800e+13", 43, "%.3f %.17e", 93310397111457.984375,
+            93310397111457.984375);
+    do_test(buffer, sizeof(buffer), "1.000000e+300", 13, "%e", 1e300);
+    do_test(buffer, sizeof(buffer), "2.225e-308", 10, "%.3e", 2.2250738585072014e-308);
+    do_test(buffer, sizeof(buffer), "5e-324", 6, "%g", 4.9406564584124654e-324);
+    do_test(buffer, sizeof(buffer), "1.7976931348623157e+308", 23, "%.17g", 1.7976931348623157e308);
+    do_test(buffer, sizeof(buffer), "0.1", 3, "%.17g", 0.1);
+    do_test(buffer, sizeof(buffer), "0.0001", 6, "%g", 0.000099999999);
+    do_test(buffer, sizeof(buffer), "1.00000", 7, "%#g", 1.0);
+    do_test(buffer, sizeof(buffer), "   inf", 6, "%06f", (double)INFINITY);
+    do_test(buffer, sizeof(buffer), "+inf -INF", 9, "%+f %F", (double)INFINITY, -(double)INFINITY);
+#endif /* LWPRINTF_CFG_FLOAT_SHORTEST */
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_FLOAT_SINGLE
+    /* Single precision engine, digits beyond 7 decimals are zeros and values above float range are infinite */
+    do_test(buffer, sizeof(buffer), "3.141593", 8, "%f", 3.14159265f);
+    do_test(buffer, sizeof(buffer), "0.1000000000", 12, "%.10f", 0.1f);
+    do_test(buffer, sizeof(buffer), "1.000000e-05", 12, "%e", 1e-5f);
+    do_test(buffer, sizeof(buffer), "3.4e+38", 7, "%.2g", 3.4e38f);
+    do_test(buffer, sizeof(buffer), "inf", 3, "%f", 1e39);
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FLOAT_SINGLE */
+#if LWPRINTF_CFG_FLOAT_EXACT
+    /* Exact digits beyond 18 decimals and above 1e18, exactly half is rounded to even digit */
+    do_test(buffer, sizeof(buffer), "0.100000000000000005551115123126", 32, "%.30f", 0.1);
+    do_test(buffer, sizeof(buffer), "100000000000000000000.000000", 28, "%f", 1e20);
+    do_test(buffer, sizeof(buffer), "0.00000047683715820312", 22, "%.20f", 4.76837158203125e-07);
+    do_test(buffer, sizeof(buffer), "0.6666666666666666297   |", 25, "%-24.19f|", 2.0 / 3);
+    do_test(buffer, sizeof(buffer), "-15000000000000000000.00000000000000000000", 42, "%+30.20f", -1.5e19);
+    do_test(buffer, sizeof(buffer), "0.0000000000000000000100000", 27, "%.25f", 1e-20);
+    do_test(buffer, sizeof(buffer), "12,345,678,901,234,567,168", 26, "%'.0f", 12345678901234567890.0);
+    do_test(NULL, 0, "", 316, "%f", DBL_MAX);
+    do_test(buffer, sizeof(buffer), "0.00000000000000000000000000000000", 34, "%.32f", 4.9406564584124654e-324);
+    do_test_measure("%.40f %e", 1e100, 1.0);
+    do_test(buffer, sizeof(buffer), "-0.0000000000000000000000000", 28, "%.25f", -0.0);
+#endif /* LWPRINTF_CFG_FLOAT_EXACT */
+#if LWPRINTF_CFG_SUPPORT_TYPE_FIXED
+    /* Fixed-point, number of fractional bits follows the type */
+    do_test(buffer, sizeof(buffer), "1.500", 5, "%.3q16", 0x18000);
+    do_test(buffer, sizeof(buffer), "3.250000", 8, "%q16", 0x34000);
+    do_test(buffer, sizeof(buffer), "-0.50", 5, "%.2q15", -16384);
+    do_test(buffer, sizeof(buffer), "1.0000", 6, "%.4q15", 32767);
+    do_test(buffer, sizeof(buffer), "-1.00", 5, "%.2q31", INT_MIN);
+    do_test(buffer, sizeof(buffer), "-0012.50", 8, "%08.2q16", -0xC8000);
+    do_test(buffer, sizeof(buffer), "3 2.", 4, "%.0q16 %#.0q16", 0x28000, 0x20000);
+    do_test(buffer, sizeof(buffer), "3.5     |+42.0", 14, "%-8.1q8|%+.1q0", 0x380, 42);
+    do_test(buffer, sizeof(buffer), "1.500x", 6, "%.3q16x", 0x18000);
+    do_test(buffer, sizeof(buffer), "1.5000000000000000000000000", 27, "%.25q16", 0x18000);
+    do_test(buffer, sizeof(buffer), "1.500000000", 11, "%.9llq32", 0x180000000LL);
+    do_test(buffer, sizeof(buffer), "-1.000000", 9, "%llq63", LLONG_MIN);
+    do_test(buffer, sizeof(buffer), "0.99999999999999999989", 22, "%.20llq63", LLONG_MAX);
+    do_test(buffer, sizeof(buffer), "0.2500000000", 12, "%.10llq61", 0x0800000000000000LL);
+    do_test(buffer, sizeof(buffer), "q|5", 3, "%llq64|%d", 1LL, 5);
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FIXED */
+#if LWPRINTF_CFG_SUPPORT_TYPE_SI
+    /* SI prefix, precision is number of significant digits and exponent is multiple of 3 */
+    do_test(buffer, sizeof(buffer), "4.7k -1.23457M 123.457M 0", 25, "%Y %Y %Y %Y", 4700, -1234567, 123456789, 0);
+    do_test(buffer, sizeof(buffer), "1k 1.00k 470 10", 15, "%.2Y %#.3Y %Y %.0Y", 999, 1000, 470, 12);
+    do_test(buffer, sizeof(buffer), "   +1.5k|12      |-0002.2k", 26, "%+8.3Y|%-8Y|%08.3Y", 1500, 12, -2200);
+#if LWPRINTF_CFG_SUPPORT_LONG_LONG
+    do_test(buffer, sizeof(buffer), "9.22337E -9.22337E", 18, "%llY %llY", LLONG_MAX, LLONG_MIN);
+#endif /* LWPRINTF_CFG_SUPPORT_LONG_LONG */
+#if LWPRINTF_CFG_SUPPORT_TYPE_FLOAT && LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING && !LWPRINTF_CFG_FLOAT_SHORTEST
+    do_test(buffer, sizeof(buffer), "4.7k 12.3\xC2\xB5 1.05G -4.7m", 23, "%y %.3y %.3y %.2y", 4700.0, 12.345e-6,
+            1.0499e9, -0.0047);
+    do_test(buffer, sizeof(buffer), "1k 0 1.00000 1k", 15, "%y %y %#y %.1y", 999.9999999, 0.0, 1.0, 1234.0);
+    do_test(buffer, sizeof(buffer), "0.001y 1000Y nan -inf", 21, "%y %y %y %y", 1e-27, 1e27, (double)NAN,
+            -(double)INFINITY);
+    /* Below the `y` prefix, fraction is rounded to precision */
+    do_test(buffer, sizeof(buffer), "0.000001y 0.000002y 0y 0.000001y", 32, "%y %y %y %y", 1e-30, 1.5e-30, 4e-31, 6e-31);
+    do_test(buffer, sizeof(buffer), "0y -0y 0.1y 0.0123y", 19, "%y %y %.2y %.4y", DBL_MIN, -4.9406564584124654e-324,
+            9.6e-26, 1.23e-26);
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FLOAT && LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING && !LWPRINTF_CFG_FLOAT_SHORTEST */
+    do_test_measure("%Y %08.3Y", -1234567, 2200);
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_SI */
+#if LWPRINTF_CFG_SUPPORT_TYPE_FLOAT_HEX
+    /* Hexadecimal float, exact digits without precision and rounding to nearest even with precision */
+    do_test(buffer, sizeof(buffer), "0x1p+0 -0X1P-1 0x0p+0 -0x0p+0", 29, "%a %A %a %a", 1.0, -0.5, 0.0, -0.0);
+    do_test(buffer, sizeof(buffer), "0x1.921f9f01b866ep+1 0x1.922p+1", 31, "%a %.3a", 3.14159, 3.14159);
+    do_test(buffer, sizeof(buffer), "0x2p+0 0x1p+1 0x2.0p+3", 22, "%.0a %.0a %.1a", 1.5, 2.5, 15.75);
+    do_test(buffer, sizeof(buffer), "0x1.fffffffffffffp+1023 0x1p-1022 0x0.0000000000001p-1022", 57, "%a %a %a", DBL_MAX,
+            DBL_MIN, 4.9406564584124654e-324);
+    do_test(buffer, sizeof(buffer), "0x00001p+0|0x1p+0    |+0x1p+0| 0x1p+0|0x1.p+0", 45, "%010a|%-10a|%+a|% a|%#.0a", 1.0,
+            1.0, 1.0, 1.0, 1.0);
+    do_test(buffer, sizeof(buffer), "     -0X1.FEP+7 0x1.0000000000000000p+0", 39, "%15.2A %.16a", -255.0, 1.0);
+    do_test(buffer, sizeof(buffer), "inf -INF      nan", 17, "%a %A %08a", (double)INFINITY, -(double)INFINITY,
+            (double)NAN);
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FLOAT_HEX */
+    test_group("thousands");
+#if LWPRINTF_CFG_SUPPORT_THOUSANDS
+    /* Thousands grouping, width includes separators and zero padding is not grouped */
+    do_test(buffer, sizeof(buffer), "1,234,567", 9, "%'d", 1234567);
+    do_test(buffer, sizeof(buffer), "-1,234 999", 10, "%'d %'d", -1234, 999);
+    do_test(buffer, sizeof(buffer), " 1,234,567|000001,234", 21, "%'10u|%'010d", 1234567u, 1234);
+    do_test(buffer, sizeof(buffer), "123456", 6, "%'x", 0x123456);
+#if LWPRINTF_CFG_SUPPORT_LONG_LONG
+    do_test(buffer, sizeof(buffer), "1,000,000,000,000", 17, "%'lld", 1000000000000LL);
+#endif /* LWPRINTF_CFG_SUPPORT_LONG_LONG */
+#if LWPRINTF_CFG_SUPPORT_TYPE_FLOAT
+    do_test(buffer, sizeof(buffer), "  1,234,567.5|0.50", 18, "%'13.1f|%'.2f", 1234567.5, 0.5);
+    do_test(buffer, sizeof(buffer), "1.2345e+04 123,456", 18, "%'.4e %'g", 12345.0, 123456.0);
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FLOAT */
+#if LWPRINTF_CFG_SUPPORT_TYPE_FIXED
+    do_test(buffer, sizeof(buffer), "-1,234.5", 8, "%'.1q16", -0x4D28000);
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FIXED */
+    lwprintf_set_thousands_sep('.');
+    do_test(buffer, sizeof(buffer), "12.345.678", 10, "%'u", 12345678u);
+    do_test_measure("%'d %'8u", -1234567, 1000u);
+    lwprintf_set_thousands_sep('\0');
+#endif /* LWPRINTF_CFG_SUPPORT_THOUSANDS */
+    test_group("array");
+#if LWPRINTF_CFG_SUPPORT_TYPE_ARRAY
+    {
+        /* Arrays with `v` flag, specifier is applied to every element */
+        static const int16_t arr_i16[] = {-5, 120, 7};
+        static const uint8_t arr_u8[] = {0x01, 0xAB, 0xFF};
+        static const unsigned long arr_ul[] = {1ul, 4000000000ul};
+
+        do_test(buffer, sizeof(buffer), "  -5,  120,    7", 16, "%v4hd", 3, arr_i16);
+        do_test(buffer, sizeof(buffer), "[01, AB, FF]", 12, "[%v02hhX]", 3, arr_u8);
+        do_test(buffer, sizeof(buffer), "1, 4000000000", 13, "%vlu", 2, arr_ul);
+        do_test(buffer, sizeof(buffer), "a=|", 3, "a=%vd|", 0, arr_i16);
+#if LWPRINTF_CFG_SUPPORT_TYPE_FLOAT
+        static const float arr_flt[] = {1.5f, -0.25f};
+        static const double arr_dbl[] = {3.14159, 100.0};
+
+        do_test(buffer, sizeof(buffer), "1.50, -0.25|  3.142, 100.000", 28, "%v.2f|%v*.*lf", 2, arr_flt, 7, 3, 2,
+                arr_dbl);
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FLOAT */
+        lwprintf_set_array_sep(" ");
+        do_test(buffer, sizeof(buffer), "0x1 0xab 0xff", 13, "%#vhhx", 3, arr_u8);
+        do_test_measure("%v-5hd|", 3, arr_i16);
+        lwprintf_set_array_sep(NULL);
+    }
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ARRAY */
     do_test(buffer, sizeof(buffer), "1e-01", 5, "%.0e", 0.123456);
     do_test(buffer, sizeof(buffer), "-1e-01", 6, "%.0e", -0.123456);
     do_test(buffer, sizeof(buffer), "            1.2346e+02", 22, "%22.4e", 123.456);
@@ -144,11 +1404,26 @@ main(void) {
     do_test(buffer, sizeof(buffer), "-000000123", 10, "%0*d", 10, -123);
     do_test(buffer, sizeof(buffer), "10", 2, "%zu", (size_t)10);
     do_test(buffer, sizeof(buffer), "10", 2, "%ju", (uintmax_t)10);
+    do_test(buffer, sizeof(buffer), "18446744073709551615", 20, "%llu", 18446744073709551615ULL);
+    do_test(buffer, sizeof(buffer), "-9223372036854775808", 20, "%lld", (-9223372036854775807LL - 1));
+    do_test(buffer, sizeof(buffer), "-2147483648", 11, "%d", (-2147483647 - 1));
+    do_test(buffer, sizeof(buffer), "1234567890", 10, "%u", 1234567890U);
+    do_test(buffer, sizeof(buffer), "ffffffffffffffff", 16, "%llx", 18446744073709551615ULL);
+    do_test(buffer, sizeof(buffer), "1777777777777777777777", 22, "%llo", 18446744073709551615ULL);
+    do_test(buffer, sizeof(buffer), "4294967295", 10, "%llu", 4294967295ULL);
+    do_test(buffer, sizeof(buffer), "4294967296", 10, "%llu", 4294967296ULL);
+    do_test(buffer, sizeof(buffer), "429496729600", 12, "%llu", 429496729600ULL);
+    do_test(buffer, sizeof(buffer), "-4294967296", 11, "%lld", -4294967296LL);
+    do_test(buffer, sizeof(buffer), "44 -56 4464 -1 44", 17, "%hhd %hhd %hd %hd %hhu", 300, 200, 70000, 65535, 300);
+    do_test(buffer, sizeof(buffer), "100000000", 9, "%llx", 4294967296ULL);
+    do_test(buffer, sizeof(buffer), "4294967295", 10, "%u", 4294967295U);
+    do_test(buffer, sizeof(buffer), "0XDEADBEEF", 10, "%#X", 0xDEADBEEFU);
     do_test(buffer, sizeof(buffer), " 1024", 5, "% d", 1024);
     do_test(buffer, sizeof(buffer), " 1024", 5, "% 4d", 1024);
     do_test(buffer, sizeof(buffer), " 1024", 5, "% 3d", 1024);
     do_test(buffer, sizeof(buffer), " 32.687000", 10, "% 3f", 32.687);
 
+    test_group("string");
     /* Strings */
     do_test(buffer, sizeof(buffer), "", 0, "%.*s", 0, "Text string 123");
     do_test(buffer, sizeof(buffer), "T", 1, "%.*s", 1, "Text string 123");
@@ -176,6 +1451,43 @@ main(void) {
     do_test(buffer, sizeof(buffer), "    Th", 6, "%6.10s", "Th");
     do_test(buffer, sizeof(buffer), "Th    ", 6, "%-6.10s", "Th");
     do_test(buffer, sizeof(buffer), "Th    ", 6, "%*.*s", -6, 10, "Th");
+    {
+        static const char str[] = "0123456789abcdefghijklmnopqrstuvwxyz0123456789";
+        uint8_t ok = 1;
+
+        /* String length with every alignment, termination and precision around word boundaries */
+        for (size_t off = 0; off < 8; ++off) {
+            for (size_t len = 0; len < sizeof(str); ++len) {
+                char in[sizeof(str) + 8];
+
+                memset(in, 'x', sizeof(in));
+                memcpy(&in[off], str, len);
+                in[off + len] = '\0';
+                ok &= lwprintf_snprintf(buffer, sizeof(buffer), "%s", &in[off]) == (int)len;
+                ok &= lwprintf_snprintf(buffer, sizeof(buffer), "%.*s", (int)(len / 2 + off), &in[off])
+                      == (int)(len / 2 + off < len ? len / 2 + off : len);
+            }
+        }
+        if (!ok) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+    }
+#if LWPRINTF_CFG_SUPPORT_TYPE_STRING_ESCAPE
+    /* Escaped strings, width applies to escaped length and precision to input length */
+    do_test(buffer, sizeof(buffer), "{\"k\":\"a\\\"b\\\\c\\n\"}", 17, "{\"k\":\"%J\"}", "a\"b\\c\n");
+    do_test(buffer, sizeof(buffer), "\\u0001\\u001f\\b\\t\x7F\xC3\xA9", 19, "%J", "\x01\x1F\b\t\x7F\xC3\xA9");
+    do_test(buffer, sizeof(buffer), "\\a\\v\\r\\001\\177\\303'", 19, "%C", "\a\v\r\x01\x7F\xC3'");
+    do_test(buffer, sizeof(buffer), "    a\\n|a\\n    ", 15, "%7J|%-7C", "a\n", "a\n");
+    do_test(buffer, sizeof(buffer), "ab\\\"", 4, "%.3J", "ab\"cd");
+    do_test(buffer, sizeof(buffer), "(null)", 6, "%J", NULL);
+    do_test(buffer, sizeof(buffer),
+            "\\t0123456789\\t0123456789\\t0123456789\\t0123456789\\t0123456789\\t0123456789", 72, "%J",
+            "\t0123456789\t0123456789\t0123456789\t0123456789\t0123456789\t0123456789");
+    do_test_measure("%10J|%C", "\"\n", "\x02");
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_STRING_ESCAPE */
     do_test(buffer, sizeof(buffer), "    Th", 6, "%*.*s", 6, 10, "Th");
     do_test(buffer, sizeof(buffer), "This", 4, "%.4s", "This is my string");
     do_test(buffer, sizeof(buffer), "1234", 4, "%.6s", "1234");
@@ -184,9 +1496,11 @@ main(void) {
     do_test(buffer, sizeof(buffer), "123", 3, "%.*s", 3, "123456");
     do_test(buffer, sizeof(buffer), "", 0, "%.3s", "");
 
+    test_group("integer");
     /* Hexadecimal */
     do_test(buffer, sizeof(buffer), "0X7B", 4, "%#2X", 123);
     do_test(buffer, sizeof(buffer), "0x7b", 4, "%#2x", 123);
+    do_test(buffer, sizeof(buffer), "  0x7b|0x007b", 13, "%#6x|%#06x", 123, 123);
     do_test(buffer, sizeof(buffer), "0173", 4, "%#2o", 123);
     do_test(buffer, sizeof(buffer), "0X1", 3, "%#2X", 1);
     do_test(buffer, sizeof(buffer), "0x1", 3, "%#2x", 1);
@@ -201,6 +1515,283 @@ main(void) {
     do_test(buffer, sizeof(buffer), "0X12345678", 10, "0X%p", my_pointer);
     do_test(buffer, sizeof(buffer), "0x12345678", 10, "0x%p", my_pointer);
 
+    test_group("buffer");
+    /* Length only, without character generation */
+    do_test_measure("");
+    do_test_measure("Hello %s, %5.2s|%-8s|", "World", "abc", "x");
+    do_test_measure("%d %+d % d %05d %-6d|%i", 0, 123, 45, -12, 7, -2147483647 - 1);
+    do_test_measure("%#x %#o %#b %X %10llu %lld", 255U, 8U, 5U, 0xDEADU, 18446744073709551615ULL, -42LL);
+    do_test_measure("%hhu %hu %zu %*d %-*d|", 300U, 70000U, (size_t)12345, 6, 1, 6, 2);
+    do_test_measure("%f %.3e %g %8.2f", 3.14159, 1234.5, 0.0001, -2.5);
+    do_test_measure("%c%c %% %5c", 'a', 'b', 'z');
+#if LWPRINTF_CFG_ENABLE_IOV
+    {
+        static const char iov_fmt[] = "Hello %s %d!";
+        static const char iov_str[] = "World";
+        lwprintf_iov_t iov[8];
+        char iov_arena[8], iov_out[32];
+        size_t iov_cnt = LWPRINTF_ARRAYSIZE(iov), iov_len = 0;
+        uint8_t res;
+
+        /* Literal text and string argument are referenced, only number is written to arena */
+        res = lwprintf_format_iov(iov, &iov_cnt, iov_arena, sizeof(iov_arena), iov_fmt, iov_str, 42);
+        for (size_t i = 0; res && i < iov_cnt; ++i) {
+            memcpy(&iov_out[iov_len], iov[i].ptr, iov[i].len);
+            iov_len += iov[i].len;
+        }
+        iov_out[iov_len] = '\0';
+        if (!res || iov_cnt != 5 || iov[0].ptr != iov_fmt || iov[1].ptr != iov_str || iov[3].ptr != iov_arena
+            || strcmp(iov_out, "Hello World 42!") != 0) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            printf("Segments do not match, result: %u, count: %u, actual: \"%s\"\r\n", (unsigned)res, (unsigned)iov_cnt,
+                   iov_out);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+
+        /* Too small arena or too few segments fail */
+        iov_cnt = LWPRINTF_ARRAYSIZE(iov);
+        res = lwprintf_format_iov(iov, &iov_cnt, iov_arena, 2, "%d", 12345);
+        iov_cnt = 3;
+        res |= lwprintf_format_iov(iov, &iov_cnt, iov_arena, sizeof(iov_arena), iov_fmt, iov_str, 42);
+        if (res) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+    }
+#endif /* LWPRINTF_CFG_ENABLE_IOV */
+#if LWPRINTF_CFG_ENABLE_STRBUF
+    {
+        static void* sb_arena[16];
+        lwprintf_strbuf_t sb;
+        const lwprintf_strbuf_chunk_t* it = NULL;
+        char sb_out[64];
+        size_t sb_chunks = 0, sb_len;
+        int res;
+
+        /* Text grows over multiple chunks from arena */
+        lwprintf_strbuf_init(&sb, sb_arena, sizeof(sb_arena), 8);
+        res = lwprintf_strbuf_append(&sb, "Hello %s", "World");
+        res += lwprintf_strbuf_append(&sb, ", %05d|%-4s|", 42, "x");
+        while (lwprintf_strbuf_iterate(&sb, &it, &sb_len) != NULL) {
+            ++sb_chunks;
+        }
+        if (res != 24 || sb_chunks != 3 || sb.is_full || lwprintf_strbuf_flatten(&sb, sb_out, sizeof(sb_out)) != 24
+            || strcmp(sb_out, "Hello World, 00042|x   |") != 0) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            printf("String builder does not match, result: %d, chunks: %u, actual: \"%s\"\r\n", res,
+                   (unsigned)sb_chunks, sb_out);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+
+        /* Pool runs out, stored text is truncated prefix and later appends are dropped */
+        lwprintf_strbuf_init_alloc(&sb, lw_strbuf_alloc, lw_strbuf_free, NULL, 8);
+        lwprintf_strbuf_append(&sb, "%s", "0123456789ABCDEFGHIJ");
+        lwprintf_strbuf_append(&sb, "%s", "KLMNOPQRSTUVWXYZ");
+        lwprintf_strbuf_append(&sb, "!");
+        lwprintf_strbuf_flatten(&sb, sb_out, sizeof(sb_out));
+        res = sb.is_full && strcmp(sb_out, "0123456789ABCDEFGHIJKLMNOPQRSTUV") == 0;
+        lwprintf_strbuf_reset(&sb);
+        if (!res || memchr(lw_strbuf_pool_used, 1, sizeof(lw_strbuf_pool_used)) != NULL) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            printf("String builder pool does not match, actual: \"%s\"\r\n", sb_out);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+    }
+#endif /* LWPRINTF_CFG_ENABLE_STRBUF */
+#if LWPRINTF_CFG_ENABLE_ASPRINTF
+    {
+        static const lwprintf_pool_t pool_resize = {lw_asprintf_alloc, lw_asprintf_resize, lw_asprintf_free, NULL};
+        static const lwprintf_pool_t pool_fixed = {lw_asprintf_alloc, NULL, NULL, NULL};
+        char *str1, *str2, *str3;
+        int len1, len2, len3;
+
+        /* Text is streamed to the block, that is shrunk to exact size */
+        lw_asprintf_pos = 0;
+        lwprintf_set_pool(&pool_resize);
+        len1 = lwprintf_asprintf(&str1, "Record %d: %s", 42, "temperature");
+        len2 = lwprintf_asprintf(&str2, "%s-%05d", "ab", 7);
+        if (len1 != 22 || len2 != 8 || lw_asprintf_pos != 32 || str1 != lw_asprintf_arena
+            || strcmp(str1, "Record 42: temperature") != 0 || strcmp(str2, "ab-00007") != 0) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+
+        /* Block grows over multiple chunks, then pool runs out */
+        lw_asprintf_pos = 0;
+        len1 = lwprintf_asprintf(&str1, "%50s", "x");
+        len2 = lwprintf_asprintf(&str2, "%d", 1);
+        if (len1 != 50 || lw_asprintf_pos != 51 || str1[49] != 'x' || str1[50] != '\0' || len2 != -1 || str2 != NULL) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+
+        /* Pool without resize gets measured length */
+        lw_asprintf_pos = 0;
+        lwprintf_set_pool(&pool_fixed);
+        len1 = lwprintf_asprintf(&str1, "%08x|%s", 0xBEEFU, "ok");
+        len2 = lwprintf_asprintf(&str2, "%60s", "");
+        lwprintf_set_pool(NULL);
+        len3 = lwprintf_asprintf(&str3, "%d", 1);
+        if (len1 != 11 || lw_asprintf_pos != 12 || strcmp(str1, "0000beef|ok") != 0 || len2 != -1 || str2 != NULL
+            || len3 != -1 || str3 != NULL) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+    }
+#endif /* LWPRINTF_CFG_ENABLE_ASPRINTF */
+#if LWPRINTF_CFG_ENABLE_RESUMABLE
+    {
+        static const char* resume_fmt = "Literal text, %5d|%-6s|%08.3f|%x %c %%%s end";
+        char resume_exp[96], resume_out[96];
+        size_t chunks;
+
+        /* Text of chunks of every size is the same as formatted at once */
+        lwprintf_snprintf(resume_exp, sizeof(resume_exp), resume_fmt, -42, "ab", 3.14159, 0xBEEFU, 'z',
+                          "0123456789ABCDEF");
+        for (size_t i = 1; i < 24; ++i) {
+            chunks = lw_resume_format(resume_out, i, resume_fmt, -42, "ab", 3.14159, 0xBEEFU, 'z', "0123456789ABCDEF");
+            if (strcmp(resume_out, resume_exp) != 0 || chunks != (strlen(resume_exp) + i - 1) / i) {
+                printf("Test error on line: %d\r\n", __LINE__);
+                printf("Resumable format does not match, chunk: %u, chunks: %u, actual: \"%s\"\r\n", (unsigned)i,
+                       (unsigned)chunks, resume_out);
+                tests_failed++;
+            } else {
+                tests_passed++;
+            }
+        }
+    }
+#endif /* LWPRINTF_CFG_ENABLE_RESUMABLE */
+#if LWPRINTF_CFG_ENABLE_SCANF
+    test_group("scanf");
+    {
+        char scan_word[16], scan_set[16], scan_chr[3] = {0};
+        int scan_d = 0, scan_n = 0, res;
+        unsigned int scan_x = 0;
+        short scan_h = 0;
+        double scan_f = 0, scan_e = 0;
+
+        /* Results are the same as of C library sscanf */
+        res = lwprintf_sscanf("  -123 0x1aF word,rest ab 3.14159 -2.5e3 x=-7", "%d %x %[a-z],%s %2c %lf %lf x=%hd%n",
+                              &scan_d, &scan_x, scan_set, scan_word, scan_chr, &scan_f, &scan_e, &scan_h, &scan_n);
+        if (res != 8 || scan_d != -123 || scan_x != 0x1AFU || strcmp(scan_set, "word") != 0
+            || strcmp(scan_word, "rest") != 0 || strcmp(scan_chr, "ab") != 0 || fabs(scan_f - 3.14159) > 1e-12
+            || scan_e != -2500.0 || scan_h != -7 || scan_n != 45) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            printf("Scan result does not match, res: %d, d: %d, x: %x, set: %s, word: %s, f: %f, n: %d\r\n", res,
+                   scan_d, scan_x, scan_set, scan_word, scan_f, scan_n);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+
+        /* Suppression, width, negated set, %i prefix, matching failure and end of input */
+        scan_d = scan_n = 0;
+        if (lwprintf_sscanf("12345 key: value;", "%*2d%3d %[^:]: %[^;]", &scan_d, scan_word, scan_set) != 3
+            || scan_d != 345 || strcmp(scan_word, "key") != 0 || strcmp(scan_set, "value") != 0
+            || lwprintf_sscanf("010 0x10 10", "%i %i %i", &scan_d, &scan_n, &res) != 3 || scan_d != 8 || scan_n != 16
+            || res != 10 || lwprintf_sscanf("5 abc", "%d %d", &scan_d, &scan_n) != 1 || scan_d != 5
+            || lwprintf_sscanf("  ", "%d", &scan_d) != -1 || lwprintf_sscanf("7", "%d %d", &scan_d, &scan_n) != 1
+            || lwprintf_sscanf("100%", "%d%%", &scan_d) != 1 || scan_d != 100) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            printf("Scan result does not match, d: %d, n: %d, word: %s, set: %s\r\n", scan_d, scan_n, scan_word,
+                   scan_set);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+
+#if LWPRINTF_CFG_SCANF_SUPPORT_TYPE_FLOAT && !LWPRINTF_CFG_SUPPORT_TYPE_FLOAT_SINGLE && LWPRINTF_CFG_SUPPORT_LONG_LONG
+        {
+            double res_f = 0;
+
+            /* Up to 15 significant digits and 15 digits of decimal point shift are rounded once, as by C library */
+            if (lwprintf_sscanf("0.1 123456789012345e-15 9.87654321e15", "%lf %lf %lf", &scan_f, &scan_e, &res_f) != 3
+                || scan_f != 0.1 || scan_e != 0.123456789012345 || res_f != 9.87654321e15) {
+                printf("Test error on line: %d\r\n", __LINE__);
+                printf("Scan result is not correctly rounded, f: %.17g, e: %.17g, res: %.17g\r\n", scan_f, scan_e,
+                       res_f);
+                tests_failed++;
+            } else {
+                tests_passed++;
+            }
+        }
+#endif /* LWPRINTF_CFG_SCANF_SUPPORT_TYPE_FLOAT && !LWPRINTF_CFG_SUPPORT_TYPE_FLOAT_SINGLE && ... */
+#if !LWPRINTF_CFG_SUPPORT_LONG_LONG
+        /* Arguments of `long long` size are not stored, conversion stops */
+        scan_d = 0;
+        if (lwprintf_sscanf("5 6", "%d %lld", &scan_d, &scan_e) != 1 || scan_d != 5
+            || lwprintf_sscanf("7", "%jd", &scan_e) != 0) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+#endif /* !LWPRINTF_CFG_SUPPORT_LONG_LONG */
+    }
+#endif /* LWPRINTF_CFG_ENABLE_SCANF */
+    test_group("custom");
+#if LWPRINTF_CFG_ENABLE_CUSTOM_SPEC
+    {
+        static const uint8_t ip[] = {192, 168, 1, 10};
+        char custom_out[64];
+        int res;
+
+        /* Handlers output directly, with width of the custom specifier */
+        lwprintf_init_ex(&lw_custom, NULL);
+        if (!lwprintf_register_specifier_ex(&lw_custom, 'I', lw_custom_ipv4)
+            || !lwprintf_register_specifier_ex(&lw_custom, 'Y', lw_custom_bool)
+            || lwprintf_register_specifier_ex(&lw_custom, 'l', lw_custom_bool)) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            tests_failed++;
+        }
+        res = lwprintf_snprintf_ex(&lw_custom, custom_out, sizeof(custom_out), "[%I] [%16I] [%-6Y] %d", ip, ip, 1, 5);
+        if (res != 44 || strcmp(custom_out, "[192.168.1.10] [    192.168.1.10] [true  ] 5") != 0) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            printf("Custom specifier does not match, result: %d, actual: \"%s\"\r\n", res, custom_out);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+
+        /* Handler writes in parts and applies width itself */
+        lwprintf_register_specifier_ex(&lw_custom, 'H', lw_custom_hex);
+        res = lwprintf_snprintf_ex(&lw_custom, custom_out, sizeof(custom_out), "[%H] [%10.2H] [%-.4H|]", ip, ip, ip);
+        if (res != 38 || strcmp(custom_out, "[c0:a8:01] [     c0:a8] [c0:a8:01:0a|]") != 0) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            printf("Custom specifier does not match, result: %d, actual: \"%s\"\r\n", res, custom_out);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+
+        /* Removed specifier is printed as character */
+        lwprintf_register_specifier_ex(&lw_custom, 'I', NULL);
+        lwprintf_snprintf_ex(&lw_custom, custom_out, sizeof(custom_out), "%I %Y", 0);
+        if (strcmp(custom_out, "I false") != 0) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            printf("Custom specifier does not match, actual: \"%s\"\r\n", custom_out);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+    }
+#endif /* LWPRINTF_CFG_ENABLE_CUSTOM_SPEC */
+
+    test_group("binary");
     /* Binary data */
     do_test(buffer, sizeof(buffer), "1111011 abc", 11, "%llb abc", 123);
     do_test(buffer, sizeof(buffer), "100", 3, "%b", 4);
@@ -212,6 +1803,8 @@ main(void) {
     do_test(buffer, sizeof(buffer), "0", 1, "%#b", 0);
     do_test(buffer, sizeof(buffer), "0B110", 5, "%#B", 6);
     do_test(buffer, sizeof(buffer), "0b110", 5, "%#b", 6);
+    do_test(buffer, sizeof(buffer), "1000000000000000000000000000000000000000000000000000000000000001", 64, "%jb",
+            (uintmax_t)0x8000000000000001ULL);
 
     /* Hex data */
     uint8_t my_arr[] = {0x01, 0x02, 0xB5, 0xC6, 0xD7};
@@ -222,10 +1815,1252 @@ main(void) {
     do_test(buffer, sizeof(buffer), "0102b5", 6, "%*k", 3, my_arr);
     do_test(buffer, sizeof(buffer), "01 02 b5", 8, "% *k", 3, my_arr);
 
+    /* Array longer than encoding chunk, output is written once per chunk */
+    uint8_t my_packet[60];
+    for (size_t i = 0; i < sizeof(my_packet); ++i) {
+        my_packet[i] = (uint8_t)(i * 0x11 + 0x0F);
+    }
+    do_test(buffer, sizeof(buffer),
+            "0f 20 31 42 53 64 75 86 97 a8 b9 ca db ec fd 0e 1f 30 41 52", 59, "% 20k", my_packet);
+    do_test(buffer, sizeof(buffer), "0F2031425364758697A8B9CADBECFD0E1F304152|", 41, "%20K|", my_packet);
+    do_test_measure("% 20k %5K", my_packet, my_arr);
+#if LWPRINTF_CFG_SUPPORT_TYPE_BASE64
+    /* Base64 data, with padding and URL-safe alphabet */
+    do_test(buffer, sizeof(buffer), "AQK1xtc= TQ== TWE=", 18, "%5r %*r %2r", my_arr, 1, "Ma", "Ma");
+    do_test(buffer, sizeof(buffer), "DyAxQlNkdYaXqLnK2+z9Dh8wQVI=|", 29, "%20r|", my_packet);
+    do_test(buffer, sizeof(buffer), "DyAxQlNkdYaXqLnK2+z9Dh8wQVJjdIWWp7jJ2uv8DR4vQFFic4SVprfI2er7DB0uP1BhcoOUpbbH2On6", 80,
+            "%60r", my_packet);
+    do_test(buffer, sizeof(buffer), "+/+/ -_-_", 9, "%3r %#3r", "\xFB\xFF\xBF", "\xFB\xFF\xBF");
+    do_test_measure("%20r %*r", my_packet, 2, my_arr);
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_BASE64 */
+#if LWPRINTF_CFG_SUPPORT_TYPE_HEXDUMP
+    /* Hexdump, last line is aligned to gutter */
+    do_test(buffer, sizeof(buffer), "00000000  48 69 21  |Hi!|\n", 26, "%3.3H", "Hi!");
+    do_test(buffer, sizeof(buffer), "00000000  41 42 43 44  |ABCD|\n00000004  01 7f        |..|\n", 58, "%*.4H", 6,
+            "ABCD\x01\x7F");
+    do_test(buffer, sizeof(buffer),
+            "00000000  0f 20 31 42 53 64 75 86 97 a8 b9 ca db ec fd 0e  |. 1BSdu.........|\n"
+            "00000010  1f 30 41 52                                      |.0AR|\n",
+            144, "%20H", my_packet);
+    do_test_measure("%20H%*.5H", my_packet, 7, my_packet);
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_HEXDUMP */
+
+    test_group("output");
     /* Length and data return */
     do_test(NULL, 0, "", 4, "test");
     do_test(buffer, sizeof(buffer), "Hello World!", 12, "Hello World!");
 
+    /* Truncated output */
+    do_test(buffer, 5, "Hell", 12, "Hello World!");
+    do_test(buffer, 5, "12 a", 6, "%d abc", 12);
+    do_test(buffer, 5, "  12", 8, "%4d abc", 12);
+    do_test(buffer, 5, "abcd", 6, "%s", "abcdef");
+    do_test(buffer, 1, "", 3, "abc");
+    do_test(buffer, 5, "    ", 10, "%10d", 1);
+
+#if LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT
+    /* Block output with staging buffer */
+    lwprintf_init_block_ex(&lw_block, lwprintf_output_block, lw_block_staging, sizeof(lw_block_staging));
+    do_test_block("", 0, "");
+    do_test_block("Hello", 1, "Hello");
+    do_test_block("Hello W!", 1, "Hello %c!", 'W');
+    do_test_block("Hello World!", 2, "Hello %s!", "World");
+    do_test_block("Value:   -123, 0x7b", 3, "Value: %6d, %#x", -123, 123);
+    do_test_block("ab        |", 2, "%-10s|", "ab");
+    do_test_block("000000000012", 2, "%012lu", 12UL);
+    lwprintf_init_block_ex(&lw_block, lwprintf_output_block, NULL, 0);
+    do_test_block("Hello", 1, "Hello");
+    do_test_block("Hello 12 World", 4, "Hello %d %s", 12, "World");
+    do_test_block("                    12", 3, "%22d", 12);
+    {
+        char batch_buff[64];
+
+        /* All prints of the batch are sent to the output in one call */
+        lwprintf_init_block_ex(&lw_block, lwprintf_output_block, lw_block_staging, sizeof(lw_block_staging));
+        lw_block_out_len = 0;
+        lw_block_out_calls = 0;
+        lw_block_out[0] = '\0';
+        lwprintf_batch_begin_ex(&lw_block, batch_buff, sizeof(batch_buff));
+        for (int i = 0; i < 3; ++i) {
+            lwprintf_printf_ex(&lw_block, "Line %d: %s\r\n", i, "status");
+        }
+        if (lw_block_out_calls != 0 || lwprintf_batch_begin_ex(&lw_block, NULL, 0) || !lwprintf_batch_end_ex(&lw_block)
+            || lw_block_out_calls != 1
+            || strcmp(lw_block_out, "Line 0: status\r\nLine 1: status\r\nLine 2: status\r\n") != 0) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            printf("Batch output do not match, calls: %d, actual: \"%s\"\r\n", (int)lw_block_out_calls, lw_block_out);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+
+        /* Staging buffer of the instance is used again after the batch */
+        do_test_block("Hello World!", 2, "Hello %s!", "World");
+    }
+#if LWPRINTF_CFG_ENABLE_BUFF_MODE
+    {
+        char mode_buff[32];
+        size_t calls[3];
+        uint8_t res;
+
+        /* Line mode sends text with new line, full mode keeps it until flush */
+        lwprintf_init_block_ex(&lw_block, lwprintf_output_block, mode_buff, sizeof(mode_buff));
+        lw_block_out_len = 0;
+        lw_block_out_calls = 0;
+        lw_block_out[0] = '\0';
+        res = lwprintf_set_buff_mode_ex(&lw_block, LWPRINTF_BUFF_MODE_LINE);
+        lwprintf_printf_ex(&lw_block, "ab");
+        calls[0] = lw_block_out_calls;
+        lwprintf_printf_ex(&lw_block, "c\nd");
+        lwprintf_printf_ex(&lw_block, "%s%c", "x", '\n');
+        lwprintf_printf_ex(&lw_block, "tail;");
+        calls[1] = lw_block_out_calls;
+        res = res && lwprintf_set_buff_mode_ex(&lw_block, LWPRINTF_BUFF_MODE_FULL);
+        lwprintf_printf_ex(&lw_block, "%d\n", 12);
+        calls[2] = lw_block_out_calls;
+        res = res && lwprintf_flush_ex(&lw_block) && lwprintf_flush_ex(&lw_block);
+        lwprintf_printf_ex(&lw_block, "end");
+        res = res && lwprintf_set_buff_mode_ex(&lw_block, LWPRINTF_BUFF_MODE_NONE);
+
+        /* Kept text is sent before batch replaces staging buffer */
+        res = res && lwprintf_set_buff_mode_ex(&lw_block, LWPRINTF_BUFF_MODE_FULL);
+        lwprintf_printf_ex(&lw_block, ";k");
+        res = res && lwprintf_batch_begin_ex(&lw_block, NULL, 0);
+        lwprintf_printf_ex(&lw_block, ";b");
+        res = res && lwprintf_batch_end_ex(&lw_block) && lwprintf_flush_ex(&lw_block);
+        if (!res || calls[0] != 0 || calls[1] != 2 || calls[2] != 2 || lw_block_out_calls != 6
+            || strcmp(lw_block_out, "abc\ndx\ntail;12\nend;k;b") != 0) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            printf("Buffer mode output do not match, calls: %d, actual: \"%s\"\r\n", (int)lw_block_out_calls,
+                   lw_block_out);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+#if LWPRINTF_CFG_ENABLE_AUTO_FLUSH
+        /* Staged text is sent by periodic call, when it gets older than maximum age */
+        lw_block_out_len = 0;
+        lw_block_out_calls = 0;
+        lw_block_out[0] = '\0';
+        lw_flush_time = 100;
+        res = lwprintf_set_auto_flush_ex(&lw_block, lwprintf_flush_time, 10) && !lwprintf_auto_flush_ex(&lw_block);
+        lwprintf_printf_ex(&lw_block, "a%d;", 1);
+        lw_flush_time = 105;
+        lwprintf_printf_ex(&lw_block, "b%d;", 2);
+        res = res && !lwprintf_auto_flush_ex(&lw_block);
+        calls[0] = lw_block_out_calls;
+        lw_flush_time = 110;
+        res = res && lwprintf_auto_flush_ex(&lw_block) && !lwprintf_auto_flush_ex(&lw_block);
+        calls[1] = lw_block_out_calls;
+        lwprintf_printf_ex(&lw_block, "c%d;", 3);
+        lw_flush_time = 119;
+        res = res && !lwprintf_auto_flush_ex(&lw_block);
+        lw_flush_time = 120;
+        res = res && lwprintf_auto_flush_ex(&lw_block) && lwprintf_set_auto_flush_ex(&lw_block, NULL, 0);
+        lwprintf_printf_ex(&lw_block, "d;");
+        res = res && !lwprintf_auto_flush_ex(&lw_block);
+        res = res && lwprintf_set_buff_mode_ex(&lw_block, LWPRINTF_BUFF_MODE_NONE);
+        if (!res || calls[0] != 0 || calls[1] != 1 || lw_block_out_calls != 3
+            || strcmp(lw_block_out, "a1;b2;c3;d;") != 0) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            printf("Auto flush output do not match, calls: %d, actual: \"%s\"\r\n", (int)lw_block_out_calls,
+                   lw_block_out);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+#endif /* LWPRINTF_CFG_ENABLE_AUTO_FLUSH */
+    }
+#endif /* LWPRINTF_CFG_ENABLE_BUFF_MODE */
+#if LWPRINTF_CFG_ENABLE_TRY_PRINT
+    {
+        char try_buff[64];
+        int res[4];
+
+        /* Messages rejected by full output are dropped and reported with next successful message */
+        lwprintf_init_block_ex(&lw_block, lwprintf_output_block, try_buff, sizeof(try_buff));
+        lw_block_out_len = 0;
+        lw_block_out[0] = '\0';
+        res[0] = lwprintf_try_printf_ex(&lw_block, "A%d;", 1);
+        lw_block_out_len = sizeof(lw_block_out) - 2;
+        res[1] = lwprintf_try_printf_ex(&lw_block, "B%d;", 2);
+        res[2] = lwprintf_try_printf_ex(&lw_block, "C%d;", 3);
+        lw_block_out_len = 3;
+        res[3] = lwprintf_try_printf_ex(&lw_block, "D%d;", 4);
+        if (res[0] != 3 || res[1] != LWPRINTF_TRY_BUSY || res[2] != LWPRINTF_TRY_BUSY || res[3] != 3
+            || strcmp(lw_block_out, "A1;[2 dropped] D4;") != 0) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            printf("Try output do not match, results: %d %d %d %d, actual: \"%s\"\r\n", res[0], res[1], res[2], res[3],
+                   lw_block_out);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+    }
+#endif /* LWPRINTF_CFG_ENABLE_TRY_PRINT */
+#if LWPRINTF_CFG_ENABLE_RATE_LIMIT
+    {
+        const uint32_t times[] = {0, 0, 0, 0, 5, 6};
+        int evals = 0;
+
+        /* Burst of 2 messages per 10 time units, suppressed messages are not formatted and reported later */
+        lwprintf_init_block_ex(&lw_block, lwprintf_output_block, lw_block_staging, sizeof(lw_block_staging));
+        lwprintf_set_limit_time_ex(&lw_block, lwprintf_limit_time);
+        lw_block_out_len = 0;
+        lw_block_out[0] = '\0';
+        for (size_t i = 0; i < sizeof(times) / sizeof(times[0]); ++i) {
+            lw_limit_time = times[i];
+            lwprintf_printf_limited_ex(&lw_block, 2, 10, "m%d;", ++evals);
+        }
+        if (evals != 3 || strcmp(lw_block_out, "m1;m2;[suppressed 2 messages] m3;") != 0) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            printf("Rate limit output do not match, evals: %d, actual: \"%s\"\r\n", evals, lw_block_out);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+    }
+#endif /* LWPRINTF_CFG_ENABLE_RATE_LIMIT */
+#if LWPRINTF_CFG_ENABLE_COALESCE
+    {
+        char co_buff[64];
+        uint8_t res;
+
+        /* Repeated records are counted, and reported before the next different record */
+        lwprintf_init_block_ex(&lw_block, lwprintf_output_block, co_buff, sizeof(co_buff));
+        res = lwprintf_set_coalesce_ex(&lw_block, 1, lwprintf_coalesce_time, 10);
+        lw_block_out_len = 0;
+        lw_block_out[0] = '\0';
+        lw_coalesce_time = 0;
+        for (int i = 0; i < 4; ++i) {
+            lwprintf_printf_ex(&lw_block, "retry %d\n", 7);
+        }
+        lwprintf_printf_ex(&lw_block, "ok\n");
+
+        /* Report of the last run is printed after timeout, or when coalescing is disabled */
+        for (int i = 0; i < 3; ++i) {
+            lwprintf_printf_ex(&lw_block, "ok\n");
+        }
+        res = res && !lwprintf_coalesce_process_ex(&lw_block);
+        lw_coalesce_time = 10;
+        res = res && lwprintf_coalesce_process_ex(&lw_block);
+        lwprintf_printf_ex(&lw_block, "ok\n");
+        res = res && lwprintf_set_coalesce_ex(&lw_block, 0, NULL, 0);
+        if (!res
+            || strcmp(lw_block_out, "retry 7\nlast message repeated 3 times\nok\nlast message repeated 3 times\n"
+                                    "last message repeated 1 times\n")
+                   != 0) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            printf("Coalesced output do not match, actual: \"%s\"\r\n", lw_block_out);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+
+        /* Record longer than staging buffer is partly sent before it ends, it is never coalesced */
+        lwprintf_init_block_ex(&lw_block, lwprintf_output_block, lw_block_staging, sizeof(lw_block_staging));
+        res = lwprintf_set_coalesce_ex(&lw_block, 1, NULL, 0);
+        lw_block_out_len = 0;
+        lw_block_out[0] = '\0';
+        lwprintf_printf_ex(&lw_block, "ab\n");
+        lwprintf_printf_ex(&lw_block, "ab\n");
+        lwprintf_printf_ex(&lw_block, "0123456789\n");
+        lwprintf_printf_ex(&lw_block, "0123456789\n");
+        if (!res || strcmp(lw_block_out, "ab\nlast message repeated 1 times\n0123456789\n0123456789\n") != 0) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            printf("Coalesced output do not match, actual: \"%s\"\r\n", lw_block_out);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+#if LWPRINTF_CFG_ENABLE_BUFF_MODE
+        /* In line mode, line is sent at the end of print call, after it has been compared */
+        lwprintf_init_block_ex(&lw_block, lwprintf_output_block, co_buff, sizeof(co_buff));
+        res = lwprintf_set_buff_mode_ex(&lw_block, LWPRINTF_BUFF_MODE_LINE)
+              && lwprintf_set_coalesce_ex(&lw_block, 1, NULL, 0);
+        lw_block_out_len = 0;
+        lw_block_out[0] = '\0';
+        lw_block_out_calls = 0;
+        for (int i = 0; i < 3; ++i) {
+            lwprintf_printf_ex(&lw_block, "a\n");
+        }
+        lwprintf_printf_ex(&lw_block, "b");
+        lwprintf_printf_ex(&lw_block, "\n");
+        if (!res || lw_block_out_calls != 2 || strcmp(lw_block_out, "a\nlast message repeated 2 times\nb\n") != 0) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            printf("Coalesced line output do not match, calls: %d, actual: \"%s\"\r\n", (int)lw_block_out_calls,
+                   lw_block_out);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+#endif /* LWPRINTF_CFG_ENABLE_BUFF_MODE */
+    }
+#endif /* LWPRINTF_CFG_ENABLE_COALESCE */
+#if LWPRINTF_CFG_ENABLE_LOW_POWER
+    {
+        char lp_buff[64];
+        uint8_t res;
+
+        /* Text is kept until it reaches threshold, message with priority level is printed, or system goes idle */
+        lwprintf_init_block_ex(&lw_block, lwprintf_output_block, lp_buff, sizeof(lp_buff));
+        res = lwprintf_set_low_power_ex(&lw_block, 16, LWPRINTF_LEVEL_ERROR);
+        lw_block_out_len = 0;
+        lw_block_out[0] = '\0';
+        lw_block_out_calls = 0;
+        lwprintf_printf_ex(&lw_block, "abc\n");
+        lwprintf_printf_ex(&lw_block, "defgh\n");
+        res = res && lw_block_out_calls == 0;
+        lwprintf_printf_ex(&lw_block, "defgh\n");
+        res = res && lw_block_out_calls == 1;
+        lwprintf_printf_level_ex(&lw_block, LWPRINTF_LEVEL_WARNING, "w\n");
+        res = res && lw_block_out_calls == 1;
+        lwprintf_printf_level_ex(&lw_block, LWPRINTF_LEVEL_ERROR, "e\n");
+        res = res && lw_block_out_calls == 2;
+        lwprintf_printf_ex(&lw_block, "i\n");
+        res = res && lwprintf_idle_flush_ex(&lw_block) && !lwprintf_idle_flush_ex(&lw_block);
+        res = res && lw_block_out_calls == 3;
+
+        /* Disabled policy sends text at the end of every print call */
+        res = res && lwprintf_set_low_power_ex(&lw_block, 0, 0);
+        lwprintf_printf_ex(&lw_block, "n\n");
+        res = res && lw_block_out_calls == 4;
+        if (!res || strcmp(lw_block_out, "abc\ndefgh\ndefgh\nw\ne\ni\nn\n") != 0) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            printf("Low power output do not match, calls: %d, actual: \"%s\"\r\n", (int)lw_block_out_calls,
+                   lw_block_out);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+    }
+#endif /* LWPRINTF_CFG_ENABLE_LOW_POWER */
+    {
+        char rtt_buff[8];
+        uint8_t res;
+
+        /* RTT ring sink, probe is simulated by moving read offset */
+        lwprintf_rtt_init();
+        res = strcmp(lwprintf_rtt.id, "SEGGER RTT") == 0
+              && lwprintf_rtt_config_up(0, "Terminal", rtt_buff, sizeof(rtt_buff), LWPRINTF_RTT_MODE_SKIP)
+              && !lwprintf_rtt_config_up(LWPRINTF_RTT_UP_CNT, NULL, rtt_buff, sizeof(rtt_buff), LWPRINTF_RTT_MODE_SKIP);
+        lwprintf_init_block_ex(&lw_block, lwprintf_rtt_block_fn, lw_block_staging, sizeof(lw_block_staging));
+        lwprintf_printf_ex(&lw_block, "abc");
+        res = res && lwprintf_rtt.up[0].wr == 3;
+        lwprintf_printf_ex(&lw_block, "defgh");
+        res = res && lwprintf_rtt.up[0].wr == 3;
+        lwprintf_rtt.up[0].rd = 3;
+        lwprintf_printf_ex(&lw_block, "defgh");
+        lwprintf_printf_ex(&lw_block, "ij");
+        res = res && lwprintf_rtt.up[0].wr == 2 && memcmp(rtt_buff, "ijcdefgh", 8) == 0;
+
+        /* Trimmed write keeps one byte free */
+        res = res && lwprintf_rtt_config_up(0, "Terminal", rtt_buff, sizeof(rtt_buff), LWPRINTF_RTT_MODE_TRIM)
+              && lwprintf_rtt_write(0, "0123456789", 10) == 7 && memcmp(rtt_buff, "0123456", 7) == 0;
+        if (!res) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            printf("RTT ring buffer do not match, wr: %u, rd: %u\r\n", lwprintf_rtt.up[0].wr, lwprintf_rtt.up[0].rd);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+    }
+#if !defined(_WIN32)
+    {
+        static const char* mmap_path = "lwprintf_mmap_test.log";
+        uint8_t res;
+        int mmap_fd;
+
+        /* File ring keeps the last 8 characters, reopened file continues after them */
+        remove(mmap_path);
+        res = lwprintf_mmap_open(&lwprintf_mmap, mmap_path, 8);
+        lwprintf_mmap_set_sync(&lwprintf_mmap, LWPRINTF_MMAP_SYNC_MSYNC, 4, 0);
+        lwprintf_init_block_ex(&lw_block, lwprintf_mmap_block_fn, lw_block_staging, sizeof(lw_block_staging));
+        lwprintf_printf_ex(&lw_block, "abc%d", 123);
+        res = res && lwprintf_mmap.hdr->wr == 6 && lwprintf_mmap.sync_wr == 6;
+        lwprintf_mmap_close(&lwprintf_mmap);
+        res = res && lwprintf_mmap_open(&lwprintf_mmap, mmap_path, 8);
+        lwprintf_printf_ex(&lw_block, "defgh");
+        res = res && lwprintf_mmap.hdr->wr == 11 && lwprintf_mmap.sync_wr == 6
+              && memcmp(lwprintf_mmap.data, "fgh123de", 8) == 0
+              && lwprintf_mmap_write(&lwprintf_mmap, "0123456789", 10) == 10 && lwprintf_mmap.hdr->wr == 21
+              && memcmp(lwprintf_mmap.data, "56789234", 8) == 0
+              && lwprintf_mmap_sync(&lwprintf_mmap);
+        lwprintf_mmap_close(&lwprintf_mmap);
+
+        /* Ring of other size starts empty, open sink is closed before it is opened again */
+        res = res && lwprintf_mmap_open(&lwprintf_mmap, mmap_path, 8);
+        mmap_fd = lwprintf_mmap.fd;
+        res = res && lwprintf_mmap_open(&lwprintf_mmap, mmap_path, 16) && lwprintf_mmap.hdr->wr == 0
+              && lwprintf_mmap.fd == mmap_fd;
+        lwprintf_mmap_close(&lwprintf_mmap);
+        remove(mmap_path);
+        if (!res || lwprintf_mmap_write(&lwprintf_mmap, "x", 1) != 0) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            printf("Memory-mapped file ring do not match\r\n");
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+    }
+#endif /* !defined(_WIN32) */
+#if LWPRINTF_CFG_ENABLE_DEADLINE
+    {
+        int len;
+
+        /* Staged text is sent with the mark, when budget runs out */
+        lwprintf_init_block_ex(&lw_block, lwprintf_output_block, lw_block_staging, sizeof(lw_block_staging));
+        lw_block_out_len = 0;
+        lw_block_out[0] = '\0';
+        lw_deadline_time = 0;
+        len = lwprintf_printf_deadline_ex(&lw_block, lwprintf_deadline_time, 3, "ab%dcd%s", 5, "ef");
+        if (len != 3 || strcmp(lw_block_out, "ab5" LWPRINTF_CFG_DEADLINE_MARK) != 0) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            printf("Deadline output do not match, actual: \"%s\", len: %d\r\n", lw_block_out, len);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+    }
+#endif /* LWPRINTF_CFG_ENABLE_DEADLINE */
+#if LWPRINTF_CFG_OS_THREAD_DEFAULT
+    {
+        lwprintf_t* def = lwprintf_get_default();
+
+        /* Calls with default instance go to the instance bound to the thread */
+        lwprintf_init_block_ex(&lw_block, lwprintf_output_block, lw_block_staging, sizeof(lw_block_staging));
+        lw_block_out_len = 0;
+        lw_block_out[0] = '\0';
+        lwprintf_set_thread_default(&lw_block);
+        lwprintf_printf("T%d;", 1);
+        lwprintf_set_thread_default(NULL);
+        if (strcmp(lw_block_out, "T1;") != 0 || lwprintf_get_default() != def || def == &lw_block) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            printf("Thread default output do not match, actual: \"%s\"\r\n", lw_block_out);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+    }
+#endif /* LWPRINTF_CFG_OS_THREAD_DEFAULT */
+#endif /* LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT */
+
+    test_group("compiled");
+#if LWPRINTF_CFG_ENABLE_COMPILED_FORMAT
+    /* Precompiled format strings */
+    do_test_compiled("", "");
+    do_test_compiled("Hello World", "Hello World");
+    do_test_compiled("Value: -123, 0x7b, 100%", "Value: %d, %#x, 100%%", -123, 123);
+    do_test_compiled("[   ab][3.14  ]", "[%*s][%-*.*f]", 5, "ab", 6, 2, 3.14159);
+    do_test_compiled("-00012|   34|", "%06ld|%5llu|", -12L, 34ULL);
+    {
+        lwprintf_compiled_t cfmt;
+        char cbuff[8];
+        int len;
+
+        /* Query storage size first, then run truncated output */
+        if (lwprintf_compile("Temp: %d.%02u C", &cfmt, NULL, 0) || cfmt.ops_cnt != 5 || cfmt.size == 0
+            || cfmt.size > sizeof(lw_compiled_storage)
+            || !lwprintf_compile("Temp: %d.%02u C", &cfmt, lw_compiled_storage, cfmt.size)) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            tests_failed++;
+        } else if ((len = lwprintf_snprintf_compiled(cbuff, sizeof(cbuff), &cfmt, 23, 5U)) != 13
+                   || strcmp(cbuff, "Temp: 2") != 0) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            printf("Compiled output do not match, expected: \"Temp: 2\", actual: \"%s\"\r\n", cbuff);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+    }
+#if LWPRINTF_CFG_FORMAT_CACHE_SIZE > 0
+    {
+        static const char* const fcache_long = "%d%d%d%d%d%d%d%d%d";
+        char fcache_fmt[8], cbuff[32];
+        lwprintf_t lw_fcache;
+        size_t cached;
+#if LWPRINTF_CFG_OS && !LWPRINTF_CFG_OS_MANUAL_PROTECT
+        const size_t cached_exp = 0; /* Without mutex, cache is not used for buffer output */
+#else
+        const size_t cached_exp = 1;
+#endif /* LWPRINTF_CFG_OS && !LWPRINTF_CFG_OS_MANUAL_PROTECT */
+
+        /* Second call with the same format takes parsed segments from the cache */
+        lwprintf_init_ex(&lw_fcache, NULL);
+        cached = 0;
+        for (int i = 0; i < 2; ++i) {
+            if (lwprintf_snprintf_ex(&lw_fcache, cbuff, sizeof(cbuff), "[%-4d|%.2s]", i, "xyz") != 9
+                || strcmp(cbuff, i == 0 ? "[0   |xy]" : "[1   |xy]") != 0) {
+                printf("Test error on line: %d\r\n", __LINE__);
+                tests_failed++;
+            } else {
+                tests_passed++;
+            }
+        }
+        for (size_t i = 0; i < LWPRINTF_CFG_FORMAT_CACHE_SIZE; ++i) {
+            cached += lw_fcache.fcache_fmt[i] != NULL && lw_fcache.fcache_cnt[i] == 5;
+        }
+
+        /* Format with more segments than entry can hold is still printed */
+        lwprintf_snprintf_ex(&lw_fcache, cbuff, sizeof(cbuff), fcache_long, 1, 2, 3, 4, 5, 6, 7, 8, 9);
+        lwprintf_snprintf_ex(&lw_fcache, cbuff, sizeof(cbuff), fcache_long, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+        if (cached != cached_exp || strcmp(cbuff, "987654321") != 0) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+
+        /* Format memory reused for another format after the cache is cleared */
+        strcpy(fcache_fmt, "<%d>");
+        lwprintf_snprintf_ex(&lw_fcache, cbuff, sizeof(cbuff), fcache_fmt, 5);
+        lwprintf_format_cache_clear_ex(&lw_fcache);
+        strcpy(fcache_fmt, "%x");
+        if (lwprintf_snprintf_ex(&lw_fcache, cbuff, sizeof(cbuff), fcache_fmt, 255) != 2 || strcmp(cbuff, "ff") != 0) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+    }
+#endif /* LWPRINTF_CFG_FORMAT_CACHE_SIZE > 0 */
+#endif /* LWPRINTF_CFG_ENABLE_COMPILED_FORMAT */
+
+    test_group("deferred");
+#if LWPRINTF_CFG_ENABLE_DEFERRED
+    /* Deferred messages, formatted only when processed */
+    lwprintf_init_ex(&lw_deferred, lwprintf_output_deferred);
+    lwprintf_init_deferred_ex(&lw_deferred, lw_deferred_buff, sizeof(lw_deferred_buff));
+    do_test_deferred("", 0);
+    lwprintf_printf_deferred_ex(&lw_deferred, "A:%d,%s;", -12, "ab");
+    lwprintf_printf_deferred_ex(&lw_deferred, "B:%*d|%-6.2f|%c;", 4, 7, 3.14159, 'x');
+    lwprintf_printf_deferred_ex(&lw_deferred, "C:%llu,%#x,100%%", 12345678901ULL, 255U);
+    do_test_deferred("A:-12,ab;B:   7|3.14  |x;C:12345678901,0xff,100%", 3);
+#if LWPRINTF_CFG_SUPPORT_TYPE_ARRAY
+    {
+        static const uint16_t arr[] = {1, 20, 300};
+
+        lwprintf_printf_deferred_ex(&lw_deferred, "D:%v3hu;%d", 3, arr, 5);
+        do_test_deferred("D:  1,  20, 300;5", 1);
+    }
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ARRAY */
+    {
+        size_t cnt = 0;
+
+        /* Fill the buffer, then check messages wrap around the buffer end */
+        while (lwprintf_printf_deferred_ex(&lw_deferred, "%d", 1)) {
+            ++cnt;
+        }
+        if (cnt == 0 || cnt >= sizeof(lw_deferred_buff)) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            tests_failed++;
+        }
+        lwprintf_process_deferred_ex(&lw_deferred);
+        for (int i = 0; i < 20; ++i) {
+            char exp[32];
+
+            sprintf(exp, "[%d:%.1f]", i, i * 0.5);
+            lwprintf_printf_deferred_ex(&lw_deferred, "[%d:%.1f]", i, i * 0.5);
+            do_test_deferred(exp, 1);
+        }
+    }
+#endif /* LWPRINTF_CFG_ENABLE_DEFERRED */
+
+    test_group("packed");
+#if LWPRINTF_CFG_ENABLE_PACKED_ARGS
+    /* Arguments from memory, each aligned to its size, float arguments not promoted */
+    {
+        struct {
+            int i;
+            lwprintf_packed_float_t f;
+            const char* s;
+            unsigned long long ull;
+        } pargs = {-12, (lwprintf_packed_float_t)2.5f, "ab", 12345678901ULL};
+
+        do_test_packed("-12|2.50|ab|12345678901", 23, 64, "%d|%.2f|%s|%llu", &pargs);
+        do_test_packed("-12|2.5", 23, 8, "%d|%.2f|%s|%llu", &pargs);
+    }
+    {
+        struct {
+            int width;
+            int v;
+        } pargs = {5, -12};
+
+        do_test_packed("[  -12]", 7, 64, "[%*d]", &pargs);
+    }
+#if LWPRINTF_CFG_ENABLE_COMPILED_FORMAT
+    {
+        struct {
+            lwprintf_packed_float_t f;
+            int i;
+        } pargs = {(lwprintf_packed_float_t)2.5f, 7};
+        lwprintf_compiled_t cfmt;
+        char cbuff[16];
+
+        if (!lwprintf_compile("%.1f-%d", &cfmt, lw_compiled_storage, sizeof(lw_compiled_storage))
+            || lwprintf_snprintf_compiled_packed_ex(NULL, cbuff, sizeof(cbuff), &cfmt, &pargs) != 5
+            || strcmp(cbuff, "2.5-7") != 0) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+    }
+#endif /* LWPRINTF_CFG_ENABLE_COMPILED_FORMAT */
+#endif /* LWPRINTF_CFG_ENABLE_PACKED_ARGS */
+
+    test_group("token");
+#if LWPRINTF_CFG_ENABLE_TOKEN
+    {
+        static const char fmt[] = "%d %u %s %c %.2f\n";
+        const lwprintf_packed_float_t f = (lwprintf_packed_float_t)1.5;
+        const uint32_t id = (uint32_t)(uintptr_t)fmt;
+        unsigned char exp[32];
+        size_t exp_len = 0;
+
+        /* Frame with length, format string address and encoded arguments, followed by empty frame */
+        exp[exp_len++] = (unsigned char)(4 + 1 + 2 + 3 + 1 + sizeof(f));
+        for (size_t i = 0; i < 4; ++i) {
+            exp[exp_len++] = (unsigned char)(id >> (8 * i));
+        }
+        exp[exp_len++] = 0x09; /* -5 in zigzag encoding */
+        exp[exp_len++] = 0xAC; /* 300 */
+        exp[exp_len++] = 0x02;
+        memcpy(&exp[exp_len], "ab", 3);
+        exp_len += 3;
+        exp[exp_len++] = 'x';
+        memcpy(&exp[exp_len], &f, sizeof(f));
+        exp_len += sizeof(f);
+        exp[exp_len++] = 0x00;
+
+        lwprintf_init_ex(&lw_token, lwprintf_output_token);
+        lwprintf_set_token_mode_ex(&lw_token, 1);
+        if (lwprintf_printf_ex(&lw_token, fmt, -5, 300U, "ab", 'x', 1.5) != (int)exp_len - 1
+            || lw_token_out_len != exp_len || memcmp(lw_token_out, exp, exp_len) != 0) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+
+        /* Frame exceeding the buffer is dropped, text is printed again with mode turned off */
+        lw_token_out_len = 0;
+        if (lwprintf_printf_ex(&lw_token, "%s", "0123456789012345678901234567890123456789012345678901234567890123") != 0
+            || lw_token_out_len != 0) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+        lwprintf_set_token_mode_ex(&lw_token, 0);
+        if (lwprintf_printf_ex(&lw_token, "%d", 42) != 2 || lw_token_out_len != 3
+            || memcmp(lw_token_out, "42", 3) != 0) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+    }
+#endif /* LWPRINTF_CFG_ENABLE_TOKEN */
+
+    test_group("cbor");
+#if LWPRINTF_CFG_ENABLE_CBOR
+    {
+        /* Map of 4 entries, keys from literal text, integer index for entry without name */
+        static const unsigned char exp1[] = {0xA4, 0x64, 't',  'e',  'm',  'p',  0x24, 0x63, 'h',
+                                             'u',  'm',  0xFA, 0x3F, 0xC0, 0x00, 0x00, 0x62, 'i',
+                                             'd',  0x62, 'a',  'b',  0x03, 0x19, 0x01, 0x2C};
+        /* Fixed-point number as big float, byte string, double and `null` */
+        static const unsigned char exp2[] = {0xA4, 0x61, 'v',  0xC5, 0x82, 0x2F, 0x1A, 0x00, 0x01, 0x80, 0x00, 0x63,
+                                             'r',  'a',  'w',  0x43, 0x01, 0x02, 0x03, 0x61, 'x',  0xFB, 0x3F, 0xB9,
+                                             0x99, 0x99, 0x99, 0x99, 0x99, 0x9A, 0x61, 's',  0xF6};
+        static const unsigned char arr[] = {0x01, 0x02, 0x03};
+        int len[4];
+
+        lwprintf_init_ex(&lw_cbor, lwprintf_output_cbor);
+        lwprintf_set_cbor_mode_ex(&lw_cbor, 1);
+        lw_cbor_out_len = 0;
+        len[0] = lwprintf_printf_ex(&lw_cbor, "temp=%d, hum=%.1f; id:%s %u\r\n", -5, 1.5, "ab", 300U);
+        if (len[0] != (int)sizeof(exp1) || lw_cbor_out_len != sizeof(exp1)
+            || memcmp(lw_cbor_out, exp1, sizeof(exp1)) != 0) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+        lw_cbor_out_len = 0;
+        len[1] = lwprintf_printf_ex(&lw_cbor, "v=%.3q16 raw=%3k x=%f s=%s%n", 0x18000, arr, 0.1, (const char*)NULL,
+                                    &len[3]);
+        if (len[1] != (int)sizeof(exp2) || lw_cbor_out_len != sizeof(exp2)
+            || memcmp(lw_cbor_out, exp2, sizeof(exp2)) != 0) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+
+        /* Map exceeding the buffer is dropped, text is printed again with mode turned off */
+        lw_cbor_out_len = 0;
+        len[2] = lwprintf_printf_ex(&lw_cbor, "%s%s", "01234567890123456789012345678901234567890123456789012345678",
+                                    "01234567890123456789012345678901234567890123456789012345678901234567");
+        lwprintf_set_cbor_mode_ex(&lw_cbor, 0);
+        if (len[2] != 0 || lw_cbor_out_len != 0 || lwprintf_printf_ex(&lw_cbor, "%d", 42) != 2 || lw_cbor_out_len != 3
+            || memcmp(lw_cbor_out, "42", 3) != 0) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+    }
+#endif /* LWPRINTF_CFG_ENABLE_CBOR */
+
+    test_group("prefix");
+#if LWPRINTF_CFG_ENABLE_LINE_PREFIX
+    /* Line prefix, printed before the first character of every line and not counted to the length */
+    lwprintf_init_ex(&lw_prefix, lwprintf_output_prefix);
+    lw_prefix_sec = 1234;
+    lw_prefix_ms = 5;
+    if (lwprintf_set_line_prefix_ex(&lw_prefix, lwprintf_prefix_time, "too_long_tag")
+        || !lwprintf_set_line_prefix_ex(&lw_prefix, lwprintf_prefix_time, "app")) {
+        printf("Test error on line: %d\r\n", __LINE__);
+        tests_failed++;
+    }
+    do_test_prefix("[      1234.005] [app] a\n[      1234.005] [app] b", 3, "a\n%c", 'b');
+    lw_prefix_ms = 120;
+    do_test_prefix(" c\n", 3, " %c\n", 'c');
+    lw_prefix_sec = 1299;
+    do_test_prefix("[      1299.120] [app] x\n[      1299.120] [app] y", 3, "%s", "x\ny");
+    lw_prefix_sec = 10;
+    lw_prefix_ms = 999;
+    do_test_prefix("\n[        10.999] [app]    42\n", 7, "\n%5d\n", 42);
+    lwprintf_init_block_ex(&lw_prefix, lwprintf_output_block_prefix, lw_prefix_staging, sizeof(lw_prefix_staging));
+    lwprintf_set_line_prefix_ex(&lw_prefix, lwprintf_prefix_time, NULL);
+    do_test_prefix("[        10.999] 1 long line\n[        10.999] 2", 13, "%d long line\n%d", 1, 2);
+    lwprintf_set_line_prefix_ex(&lw_prefix, NULL, NULL);
+    do_test_prefix("3\n4", 3, "%d\n%d", 3, 4);
+#endif /* LWPRINTF_CFG_ENABLE_LINE_PREFIX */
+
+    test_group("fanout");
+#if LWPRINTF_CFG_ENABLE_FANOUT
+    {
+        static const char* const exp[3] = {"dbg 1\nwrn 2\nall 3\n", "wrn 2\nall 3\n", "dbg 1\nwrn"};
+
+        /* Formatted once, sent to every sink by its level, stalled sink does not stop the others */
+        lw_fanout_usb_space = 9;
+        lwprintf_init_fanout_ex(&lw_fanout, lw_fanout_staging, sizeof(lw_fanout_staging));
+        if (!lwprintf_add_sink_ex(&lw_fanout, lw_fanout_uart, LWPRINTF_LEVEL_DEBUG)
+            || !lwprintf_add_sink_ex(&lw_fanout, lw_fanout_crash, LWPRINTF_LEVEL_WARNING)
+            || !lwprintf_add_sink_ex(&lw_fanout, lw_fanout_usb, LWPRINTF_LEVEL_DEBUG)
+            || lwprintf_add_sink_ex(&lw_prefix, lw_fanout_uart, LWPRINTF_LEVEL_DEBUG)) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            tests_failed++;
+        }
+        lwprintf_printf_level_ex(&lw_fanout, LWPRINTF_LEVEL_DEBUG, "dbg %d\n", 1);
+        lwprintf_printf_level_ex(&lw_fanout, LWPRINTF_LEVEL_WARNING, "wrn %d\n", 2);
+        if (lwprintf_printf_ex(&lw_fanout, "all %d\n", 3) != 6) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            tests_failed++;
+        }
+        for (size_t i = 0; i < 3; ++i) {
+            if (strcmp(lw_fanout_out[i], exp[i]) != 0) {
+                printf("Test error on line: %d\r\n", __LINE__);
+                printf("Fan-out sink %d does not match, actual: \"%s\"\r\n", (int)i, lw_fanout_out[i]);
+                tests_failed++;
+            } else {
+                tests_passed++;
+            }
+        }
+        if (lwprintf_get_sink_failures_ex(&lw_fanout, 2) != 2 || lwprintf_get_sink_failures_ex(&lw_fanout, 0) != 0) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            tests_failed++;
+        }
+    }
+#endif /* LWPRINTF_CFG_ENABLE_FANOUT */
+
+    test_group("level");
+#if LWPRINTF_CFG_ENABLE_LOG_LEVEL
+    /* Arguments of disabled messages are not evaluated */
+    lwprintf_init_ex(&lw_level, lwprintf_output_level);
+    do_test_level(4, 1, lwprintf_log_ex(&lw_level, LWPRINTF_LEVEL_DEBUG, "d=%d\n", lw_level_arg()));
+    lwprintf_set_level_ex(&lw_level, LWPRINTF_LEVEL_WARNING);
+    do_test_level(0, 0, lwprintf_log_ex(&lw_level, LWPRINTF_LEVEL_INFO, "i=%d\n", lw_level_arg()));
+    do_test_level(4, 1, lwprintf_log_ex(&lw_level, LWPRINTF_LEVEL_ERROR, "e=%d\n", lw_level_arg()));
+    lwprintf_set_level_ex(&lw_level, LWPRINTF_LEVEL_NONE);
+    do_test_level(0, 0, lwprintf_log_ex(&lw_level, LWPRINTF_LEVEL_ERROR, "e=%d\n", lw_level_arg()));
+#if LWPRINTF_CFG_LOG_MODULE_COUNT > 0
+    /* Module levels are independent of the instance level */
+    if (lwprintf_set_module_level_ex(&lw_level, LWPRINTF_CFG_LOG_MODULE_COUNT, LWPRINTF_LEVEL_INFO)
+        || !lwprintf_set_module_level_ex(&lw_level, 0, LWPRINTF_LEVEL_INFO)) {
+        printf("Test error on line: %d\r\n", __LINE__);
+        tests_failed++;
+    }
+    do_test_level(0, 0, lwprintf_log_module_ex(&lw_level, 0, LWPRINTF_LEVEL_DEBUG, "%d", lw_level_arg()));
+    do_test_level(1, 1, lwprintf_log_module_ex(&lw_level, 0, LWPRINTF_LEVEL_INFO, "%d", lw_level_arg()));
+    do_test_level(1, 1, lwprintf_log_module_ex(&lw_level, 1, LWPRINTF_LEVEL_DEBUG, "%d", lw_level_arg()));
+#endif /* LWPRINTF_CFG_LOG_MODULE_COUNT > 0 */
+#endif /* LWPRINTF_CFG_ENABLE_LOG_LEVEL */
+
+    test_group("async");
+#if LWPRINTF_CFG_ENABLE_ASYNC
+    /* Asynchronous messages, formatted at once and sent when processed */
+    lwprintf_init_ex(&lw_async, lwprintf_output_async);
+    lwprintf_init_async_ex(&lw_async, lw_async_buff, sizeof(lw_async_buff));
+    do_test_async("", 0);
+    {
+        char str[] = "ab";
+        uint8_t flag = 0;
+
+        lw_async_done_cnt = 0;
+        lwprintf_printf_async_ex(&lw_async, lwprintf_async_done, (void*)1, "A:%d,%s;", -12, str);
+        lwprintf_printf_async_ex(&lw_async, NULL, &flag, "%s", "");
+        lwprintf_printf_async_ex(&lw_async, lwprintf_async_done, (void*)10, "B:%-6.2f|", 3.14159);
+        str[0] = 'x'; /* Text is already formatted */
+        if (lw_async_done_cnt != 0 || flag != 0) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            tests_failed++;
+        }
+        do_test_async("A:-12,ab;B:3.14  |", 2);
+        if (lw_async_done_cnt != 11 || flag != 1) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            tests_failed++;
+        }
+    }
+    {
+        const char* data;
+        size_t cnt = 0;
+
+        /* Fill the queue, then check messages wrap around the queue end */
+        while (lwprintf_printf_async_ex(&lw_async, NULL, NULL, "%d", 1)) {
+            ++cnt;
+        }
+        if (cnt == 0 || cnt >= sizeof(lw_async_buff)) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            tests_failed++;
+        }
+        lwprintf_process_async_ex(&lw_async);
+        for (int i = 0; i < 20; ++i) {
+            char exp[32];
+
+            sprintf(exp, "[%d:%.1f]", i, i * 0.5);
+            lwprintf_printf_async_ex(&lw_async, NULL, NULL, "[%d:%.1f]", i, i * 0.5);
+            do_test_async(exp, 1);
+        }
+
+        /* Sink takes text and releases it, when it is sent */
+        lwprintf_printf_async_ex(&lw_async, NULL, NULL, "%s", "sink");
+        if (lwprintf_async_get_block_ex(&lw_async, &data) != 4 || strncmp(data, "sink", 4) != 0
+            || !lwprintf_async_release_block_ex(&lw_async) || lwprintf_async_get_block_ex(&lw_async, &data) != 0
+            || lwprintf_async_release_block_ex(&lw_async)) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+    }
+    {
+        char text[sizeof(lw_async_buff)];
+        size_t max_len;
+
+        /* Message of maximum length does not fit to the empty queue at its position, until sink passes wrap marker */
+        lwprintf_init_async_ex(&lw_async, lw_async_buff, sizeof(lw_async_buff));
+        max_len = lwprintf_async_max_len_ex(&lw_async);
+        memset(text, 'x', max_len + 1);
+        text[max_len + 1] = '\0';
+        lwprintf_printf_async_ex(&lw_async, NULL, NULL, "%d", 1);
+        do_test_async("1", 1);
+        if (max_len == 0 || max_len >= sizeof(lw_async_buff) - 8 || lwprintf_printf_async_ex(&lw_async, NULL, NULL, text)
+            || lwprintf_printf_async_ex(&lw_async, NULL, NULL, &text[1])) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+        do_test_async("", 0);
+        lwprintf_printf_async_ex(&lw_async, NULL, NULL, &text[1]);
+        do_test_async(&text[1], 1);
+    }
+#if LWPRINTF_CFG_ASYNC_PRIO_COUNT > 1
+    {
+        const char* data;
+
+        /* High priority message goes ahead of queued ones, but not in the middle of message handed to the sink */
+        lwprintf_init_async_prio_ex(&lw_async, 1, lw_async_buff_high, sizeof(lw_async_buff_high));
+        lwprintf_printf_async_ex(&lw_async, NULL, NULL, "L%d;", 1);
+        lwprintf_printf_async_ex(&lw_async, NULL, NULL, "L%d;", 2);
+        lwprintf_async_get_block_ex(&lw_async, &data);
+        lwprintf_printf_async_prio_ex(&lw_async, 1, NULL, NULL, "H%d;", 1);
+        if (lwprintf_async_get_block_ex(&lw_async, &data) != 3 || strncmp(data, "L1;", 3) != 0) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            tests_failed++;
+        }
+        lwprintf_async_release_block_ex(&lw_async);
+        do_test_async("H1;L2;", 2);
+
+        /* Full low priority lane does not drop high priority messages */
+        while (lwprintf_printf_async_ex(&lw_async, NULL, NULL, "%s", "bulk")) {}
+        if (!lwprintf_printf_async_prio_ex(&lw_async, 1, NULL, NULL, "%s", "err")
+            || lwprintf_async_get_block_ex(&lw_async, &data) != 3 || strncmp(data, "err", 3) != 0
+            || lwprintf_printf_async_prio_ex(&lw_async, 2, NULL, NULL, "%s", "x")) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+        lwprintf_process_async_ex(&lw_async);
+    }
+#endif /* LWPRINTF_CFG_ASYNC_PRIO_COUNT > 1 */
+#endif /* LWPRINTF_CFG_ENABLE_ASYNC */
+
+    test_group("smp");
+#if LWPRINTF_CFG_ENABLE_SMP
+    /* Records of both cores are merged in time order */
+    lwprintf_init_ex(&lw_smp_out, lwprintf_output_smp);
+    lwprintf_smp_init(&lw_smp, lw_smp_channels, 2, &lw_smp_out, lwprintf_smp_time, 10);
+    lwprintf_smp_channel_init(&lw_smp, 0, lw_smp_buff[0], sizeof(lw_smp_buff[0]), lw_smp_staging[0],
+                              sizeof(lw_smp_staging[0]));
+    lwprintf_smp_channel_init(&lw_smp, 1, lw_smp_buff[1], sizeof(lw_smp_buff[1]), lw_smp_staging[1],
+                              sizeof(lw_smp_staging[1]));
+    do_test_smp("", 0);
+    lw_smp_time = 100;
+    lwprintf_printf_ex(lwprintf_smp_get_instance(&lw_smp, 0), "A%d;", 1);
+    lw_smp_time = 101;
+    lwprintf_printf_ex(lwprintf_smp_get_instance(&lw_smp, 1), "B%d;", 1);
+    lw_smp_time = 102;
+    lwprintf_printf_ex(lwprintf_smp_get_instance(&lw_smp, 0), "A%d;", 2);
+    do_test_smp("A1;B1;", 2); /* Core 1 may still write older record than "A2" */
+    lw_smp_time = 112;
+    do_test_smp("A2;", 1);
+    for (int i = 0; i < 10; ++i) {
+        char exp[16];
+
+        /* Records wrap around ring buffer end */
+        sprintf(exp, "[%d]", i);
+        lw_smp_time += 20;
+        lwprintf_printf_ex(lwprintf_smp_get_instance(&lw_smp, (size_t)(i & 1)), "[%d]", i);
+        lw_smp_time += 20;
+        do_test_smp(exp, 1);
+    }
+#endif /* LWPRINTF_CFG_ENABLE_SMP */
+
+    test_group("crashlog");
+#if LWPRINTF_CFG_ENABLE_CRASHLOG
+    /* Content survives warm reset, simulated with second initialization */
+    lwprintf_crashlog_init(&lw_crash, lw_crash_mem, sizeof(lw_crash_mem), lw_crash_staging, sizeof(lw_crash_staging));
+    lwprintf_printf_ex(lwprintf_crashlog_get_instance(&lw_crash), "boot %d;", 1);
+    do_test_crashlog("boot 1;", 0);
+    lwprintf_crashlog_init(&lw_crash, lw_crash_mem, sizeof(lw_crash_mem), lw_crash_staging, sizeof(lw_crash_staging));
+    do_test_crashlog("boot 1;", 7);
+    lwprintf_printf_ex(lwprintf_crashlog_get_instance(&lw_crash), "fault %04X;", 0x82);
+    do_test_crashlog("boot 1;fault 0082;", 7);
+    if (lwprintf_crashlog_get_resets(&lw_crash) != 1) {
+        printf("Test error on line: %d\r\n", __LINE__);
+        tests_failed++;
+    }
+
+    /* Corrupted header starts empty log */
+    lw_crash_mem[2] ^= 0x01;
+    lwprintf_crashlog_init(&lw_crash, lw_crash_mem, sizeof(lw_crash_mem), NULL, 0);
+    do_test_crashlog("", 0);
+
+    /* Oldest data is overwritten */
+    for (int i = 0; i < 4; ++i) {
+        lwprintf_printf_ex(lwprintf_crashlog_get_instance(&lw_crash), "%d123456789", i);
+    }
+    do_test_crashlog("89" "1123456789" "2123456789" "3123456789", 0);
+
+    /* Full pages are spilled to flash pages in rotation */
+    lwprintf_crashlog_clear(&lw_crash);
+    if (lwprintf_crashlog_set_spill(&lw_crash, lw_crash_spill, NULL, 12, 2)
+        || !lwprintf_crashlog_set_spill(&lw_crash, lw_crash_spill, NULL, 16, 2)) {
+        printf("Test error on line: %d\r\n", __LINE__);
+        tests_failed++;
+    }
+    lwprintf_printf_ex(lwprintf_crashlog_get_instance(&lw_crash), "%s", "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmn");
+    if (lw_crash_spill_cnt != 2 || strcmp(lw_crash_pages[0], "ABCDEFGHIJKLMNOP") != 0
+        || strcmp(lw_crash_pages[1], "QRSTUVWXYZabcdef") != 0) {
+        printf("Test error on line: %d\r\n", __LINE__);
+        tests_failed++;
+    }
+    lwprintf_printf_ex(lwprintf_crashlog_get_instance(&lw_crash), "%s", "opqrstuvwx");
+    if (lw_crash_spill_cnt != 3 || lw_crash_spill_seq != 2 || strcmp(lw_crash_pages[0], "ghijklmnopqrstuv") != 0) {
+        printf("Test error on line: %d\r\n", __LINE__);
+        tests_failed++;
+    }
+    do_test_crashlog("STUVWXYZabcdefghijklmnopqrstuvwx", 0);
+#endif /* LWPRINTF_CFG_ENABLE_CRASHLOG */
+
+    test_group("compress");
+#if LWPRINTF_CFG_ENABLE_COMPRESS
+    {
+        char exp[1024], out[1024];
+        size_t exp_len = 0;
+
+        /* Repeated log lines are compressed, also across print calls, and decoded back */
+        lwprintf_compress_init(&lw_cmp, lwprintf_output_compress, lw_cmp_window, sizeof(lw_cmp_window), lw_cmp_staging,
+                               sizeof(lw_cmp_staging));
+        for (int i = 0; i < 12; ++i) {
+            exp_len += (size_t)sprintf(&exp[exp_len], "[%6d] sensor %d: temp=%d.%d C, status OK\r\n", 1000 + i * 10,
+                                       i & 1, 21 + (i & 3), i % 10);
+            lwprintf_printf_ex(lwprintf_compress_get_instance(&lw_cmp), "[%6d] sensor %d: temp=%d.%d C, status OK\r\n",
+                               1000 + i * 10, i & 1, 21 + (i & 3), i % 10);
+        }
+        if (lw_cmp_decode(out, sizeof(out)) != exp_len || strcmp(out, exp) != 0 || lw_cmp.in_cnt != exp_len
+            || lw_cmp.out_cnt != lw_cmp_out_len || lw_cmp_out_len * 3 > exp_len * 2) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            printf("Decompressed text does not match, length: %d, compressed: %d\r\n", (int)exp_len,
+                   (int)lw_cmp_out_len);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+
+        /* History reset, text after it is decoded without earlier history */
+        lw_cmp_out_len = 0;
+        lwprintf_compress_reset(&lw_cmp);
+        lwprintf_printf_ex(lwprintf_compress_get_instance(&lw_cmp), "%s", "abcabcabcabc");
+        if (lw_cmp_decode(out, sizeof(out)) != 12 || strcmp(out, "abcabcabcabc") != 0 || lw_cmp_out_len != 3 + 8) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+
+        /* Zero bytes of the stream, group end and zero text byte, are not output failures */
+        lw_cmp_out_len = 0;
+        lwprintf_compress_reset(&lw_cmp);
+        if (lwprintf_compress_write(&lw_cmp, "ab\0cd\0abcd", 10) != 10
+            || memchr(lw_cmp_out, 0, lw_cmp_out_len) == NULL || lw_cmp_decode(out, sizeof(out)) != 10
+            || memcmp(out, "ab\0cd\0abcd", 10) != 0) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            printf("Compressed stream with zero bytes does not match, compressed: %d\r\n", (int)lw_cmp_out_len);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+
+        /* Failed output is reported, the rest of the stream is not sent */
+        lw_cmp_out_len = 0;
+        lw_cmp_out_max = 4;
+        if (lwprintf_compress_write(&lw_cmp, "0123456789", 10) != 0 || lw_cmp_out_len != 4) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+        lw_cmp_out_max = sizeof(lw_cmp_out);
+    }
+#endif /* LWPRINTF_CFG_ENABLE_COMPRESS */
+
+    test_group("parallel");
+#if LWPRINTF_CFG_ENABLE_PARALLEL
+    {
+        struct {
+            int i;
+            const char* s;
+        } pargs1 = {-12, "ab"};
+        struct {
+            lwprintf_packed_float_t f;
+        } pargs2 = {(lwprintf_packed_float_t)2.5f};
+        const lwprintf_job_t jobs[] = {
+            {"%d:%s;", &pargs1},
+            {"%.1f;", &pargs2},
+            {"%5d;", &pargs1},
+        };
+        lwprintf_format_batch_t fb;
+        size_t offsets[4];
+        char arena[32];
+
+        /* Text of all jobs in order, first job is claimed by the worker, the rest by the caller */
+        memset(arena, '#', sizeof(arena));
+        lw_parallel_posted = 0;
+        if (!lwprintf_format_batch_init(&fb, NULL, jobs, 3, offsets, arena, sizeof(arena))
+            || !lwprintf_format_batch(&fb, lwprintf_parallel_post, NULL, 1) || lw_parallel_posted != 1
+            || strcmp(arena, "-12:ab;2.5;  -12;") != 0 || offsets[1] != 7 || offsets[2] != 11 || offsets[3] != 17) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            printf("Batch output do not match, actual: \"%s\"\r\n", arena);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+
+        /* Arena too small, nothing is written, offsets give required size */
+        memset(arena, '#', sizeof(arena));
+        if (!lwprintf_format_batch_init(&fb, NULL, jobs, 3, offsets, arena, 17)
+            || lwprintf_format_batch(&fb, NULL, NULL, 0) || offsets[3] != 17 || arena[0] != '#') {
+            printf("Test error on line: %d\r\n", __LINE__);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+    }
+#endif /* LWPRINTF_CFG_ENABLE_PARALLEL */
+
+    test_group("stats");
+#if LWPRINTF_CFG_OS_STATS && LWPRINTF_CFG_OS_MANUAL_PROTECT
+    {
+        lwprintf_stats_t stats;
+
+        /* Recursive acquisition is counted once, time between acquisition and release is hold time */
+        lwprintf_init_ex(&lw_stats, lwprintf_output);
+        lwprintf_init_stats_ex(&lw_stats, lwprintf_stats_time);
+        lwprintf_protect_ex(&lw_stats);
+        lwprintf_protect_ex(&lw_stats);
+        lwprintf_stats_time();
+        lwprintf_unprotect_ex(&lw_stats);
+        lwprintf_unprotect_ex(&lw_stats);
+        lwprintf_protect_ex(&lw_stats);
+        lwprintf_unprotect_ex(&lw_stats);
+        if (!lwprintf_get_stats_ex(&lw_stats, &stats) || stats.acquisitions != 2 || stats.contended != 0
+            || stats.wait_total != 2 || stats.wait_max != 1 || stats.hold_max != 3 || stats.hold_total != 4) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            printf("Stats do not match: %u, %u, %u, %u, %u, %u\r\n", (unsigned)stats.acquisitions,
+                   (unsigned)stats.contended, (unsigned)stats.wait_total, (unsigned)stats.wait_max,
+                   (unsigned)stats.hold_total, (unsigned)stats.hold_max);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+    }
+#endif /* LWPRINTF_CFG_OS_STATS && LWPRINTF_CFG_OS_MANUAL_PROTECT */
+
+#if LWPRINTF_CFG_STATS
+    {
+        lwprintf_stats_t stats;
+        char stats_buff[4];
+
+        /* Every call of output function takes `1` time unit, measurement is not counted */
+        lwprintf_init_ex(&lw_stats, lwprintf_output_stats);
+        lwprintf_init_stats_ex(&lw_stats, lwprintf_stats_time);
+        lwprintf_printf_ex(&lw_stats, "%d", 123);
+        lwprintf_printf_ex(&lw_stats, "ab#cd");
+        lwprintf_snprintf_ex(&lw_stats, stats_buff, sizeof(stats_buff), "%s", "truncated");
+        lwprintf_measure_ex(&lw_stats, "%d", 5);
+        if (!lwprintf_get_stats_ex(&lw_stats, &stats) || stats.calls != 3 || stats.bytes != 8 || stats.sink_calls != 7
+            || stats.cancelled != 1 || stats.truncated != 1 || stats.out_total != 7 || stats.out_max != 1) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            printf("Stats do not match: %u, %u, %u, %u, %u, %u, %u\r\n", (unsigned)stats.calls, (unsigned)stats.bytes,
+                   (unsigned)stats.sink_calls, (unsigned)stats.cancelled, (unsigned)stats.truncated,
+                   (unsigned)stats.out_total, (unsigned)stats.out_max);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+
+        /* Reset keeps timestamp function */
+        lwprintf_reset_stats_ex(&lw_stats);
+        lwprintf_printf_ex(&lw_stats, "x");
+        if (!lwprintf_get_stats_ex(&lw_stats, &stats) || stats.calls != 1 || stats.bytes != 1 || stats.sink_calls != 2
+            || stats.out_total != 2 || stats.cancelled != 0 || stats.truncated != 0) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+
+#if LWPRINTF_CFG_STATS_OUT_HIST_BUCKETS >= 5
+        /* Slow character takes `9` time units, counted in bucket of durations from `8` to `15` */
+        lwprintf_reset_stats_ex(&lw_stats);
+        lwprintf_printf_ex(&lw_stats, "xw");
+        if (!lwprintf_get_stats_ex(&lw_stats, &stats) || stats.out_hist[0] != 0 || stats.out_hist[1] != 2
+            || stats.out_hist[4] != 1 || stats.out_max != 9) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+#endif /* LWPRINTF_CFG_STATS_OUT_HIST_BUCKETS >= 5 */
+
+        /* Initialization clears statistics and timestamp function, set only by statistics initialization */
+        lwprintf_init_ex(&lw_stats, lwprintf_output_stats);
+        lwprintf_printf_ex(&lw_stats, "x");
+        if (!lwprintf_get_stats_ex(&lw_stats, &stats) || stats.calls != 1 || stats.bytes != 1 || stats.sink_calls != 2
+            || stats.out_total != 0 || stats.out_max != 0) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+    }
+#endif /* LWPRINTF_CFG_STATS */
+
+#if LWPRINTF_CFG_WCET
+    test_group("wcet");
+    {
+        char wcet_str[LWPRINTF_CFG_WCET_MAX_STRING_LEN + 16], wcet_exp[LWPRINTF_CFG_WCET_MAX_STRING_LEN + 16];
+        int wcet_arr[LWPRINTF_CFG_WCET_MAX_ARRAY_LEN + 4] = {0};
+
+        memset(wcet_str, 'a', sizeof(wcet_str) - 1);
+        wcet_str[sizeof(wcet_str) - 1] = '\0';
+
+        /* Width from argument is reduced to limit, also for negative width */
+        memset(wcet_exp, ' ', LWPRINTF_CFG_WCET_MAX_WIDTH);
+        wcet_exp[LWPRINTF_CFG_WCET_MAX_WIDTH - 1] = '1';
+        wcet_exp[LWPRINTF_CFG_WCET_MAX_WIDTH] = '\0';
+        do_test(buffer, sizeof(buffer), wcet_exp, LWPRINTF_CFG_WCET_MAX_WIDTH, "%*d", LWPRINTF_CFG_WCET_MAX_WIDTH + 100,
+                1);
+        wcet_exp[0] = '1';
+        wcet_exp[LWPRINTF_CFG_WCET_MAX_WIDTH - 1] = ' ';
+        do_test(buffer, sizeof(buffer), wcet_exp, LWPRINTF_CFG_WCET_MAX_WIDTH, "%*d",
+                -(LWPRINTF_CFG_WCET_MAX_WIDTH + 100), 1);
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_FLOAT
+        /* Padding zeros of float precision are limited, digits beyond double precision are not exact */
+        if (lwprintf_snprintf(buffer, sizeof(buffer), "%.*f", LWPRINTF_CFG_WCET_MAX_PRECISION + 10, 1.0)
+            != LWPRINTF_CFG_WCET_MAX_PRECISION + 2) {
+            printf("Test error on line: %d\r\n", __LINE__);
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FLOAT */
+
+        /* String is cut at limit, also without precision */
+        memcpy(wcet_exp, wcet_str, LWPRINTF_CFG_WCET_MAX_STRING_LEN);
+        wcet_exp[LWPRINTF_CFG_WCET_MAX_STRING_LEN] = '\0';
+        do_test(buffer, sizeof(buffer), wcet_exp, LWPRINTF_CFG_WCET_MAX_STRING_LEN, "%s", wcet_str);
+        do_test(buffer, sizeof(buffer), wcet_exp, LWPRINTF_CFG_WCET_MAX_STRING_LEN, "%.1000s", wcet_str);
+        do_test(buffer, sizeof(buffer), "aaa", 3, "%.3s", wcet_str);
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_ARRAY
+        /* Only limited number of elements is printed */
+        for (size_t i = 0; i < LWPRINTF_CFG_WCET_MAX_ARRAY_LEN; ++i) {
+            memcpy(&wcet_exp[i * 3], "0, ", 3);
+        }
+        wcet_exp[3 * LWPRINTF_CFG_WCET_MAX_ARRAY_LEN - 2] = '\0';
+        do_test(buffer, sizeof(buffer), wcet_exp, 3 * LWPRINTF_CFG_WCET_MAX_ARRAY_LEN - 2, "%vd",
+                LWPRINTF_CFG_WCET_MAX_ARRAY_LEN + 4, wcet_arr);
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ARRAY */
+        LWPRINTF_UNUSED(wcet_arr);
+    }
+#endif /* LWPRINTF_CFG_WCET */
+
+#if LWPRINTF_CFG_ENABLE_DEADLINE
+    test_group("deadline");
+    /* Time is read once at start and once before every character */
+    lwprintf_init_ex(&lw_deadline, lwprintf_output_deadline);
+    lw_deadline_time = 0;
+    do_test_deadline("abc", 3, 10, "a%c%s", 'b', "c");
+    do_test_deadline("abc" LWPRINTF_CFG_DEADLINE_MARK, 3, 4, "abcdef");
+    do_test_deadline(LWPRINTF_CFG_DEADLINE_MARK, 0, 1, "%d", 12345);
+    do_test_deadline("", 0, 0, "");
+#endif /* LWPRINTF_CFG_ENABLE_DEADLINE */
+
+#if defined(LWPRINTF_DEV) && LWPRINTF_CFG_OS && LWPRINTF_CFG_OS_MANUAL_PROTECT
+    /* Every output call and conversion is nested inside of formatting, protection waits for mutex */
+    lwprintf_init_ex(&lw_trace, lwprintf_output_trace);
+    lw_trace_len = 0;
+    lwprintf_printf_ex(&lw_trace, "a%d", 5);
+    lwprintf_protect_ex(&lw_trace);
+    lwprintf_unprotect_ex(&lw_trace);
+    if (strcmp(lw_trace_log, "FSsCSscSsfWwR") != 0 || lw_trace_format_len != 2) {
+        printf("Test error on line: %d\r\n", __LINE__);
+        printf("Trace does not match: %s, %u\r\n", lw_trace_log, lw_trace_format_len);
+        tests_failed++;
+    } else {
+        tests_passed++;
+    }
+#endif /* defined(LWPRINTF_DEV) && LWPRINTF_CFG_OS && LWPRINTF_CFG_OS_MANUAL_PROTECT */
+
 #if 0
     /* Problematic tests */
     do_test(buffer, sizeof(buffer), "0.000123456700005", 17, "%.*g", 17, 17, 0.0001234567);
@@ -241,9 +3076,16 @@ main(void) {
     do_test(buffer, sizeof(buffer), "yunknown", 8, "%yunknown", "");
 #endif
 
+    test_group(NULL);
+    test_group_report();
+
     printf("--------\r\n");
     printf("Tests passed: %u\r\n", (unsigned)(tests_passed));
     printf("Tests failed: %u\r\n", (unsigned)(tests_failed));
     printf("Tests total : %u\r\n", (unsigned)(tests_passed + tests_failed));
     printf("Coverage    : %f\r\n", (float)(tests_passed) / (float)(tests_passed + tests_failed));
+
+    /* Result of regression gate, compared to the baseline by dev/gate_check.cmake */
+    printf("GATE tests_failed %u\r\n", (unsigned)(tests_failed));
+    return 0;
 }
@@ -0,0 +1,338 @@
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "lwprintf/lwprintf.hpp"
+
+/**
+ * \brief           Tests numbers
+ */
+static size_t tests_passed, tests_failed;
+
+/**
+ * \brief           Test instance and text printed to its output
+ */
+static lwprintf_t lw_cpp;
+static std::string lw_cpp_out;
+
+/**
+ * \brief           Trace hook of development options, not used by C++ tests
+ */
+extern "C" void
+lwprintf_dev_trace(const void* lwobj, char evt, unsigned int val) {
+    LWPRINTF_UNUSED(lwobj);
+    LWPRINTF_UNUSED(evt);
+    LWPRINTF_UNUSED(val);
+}
+
+/**
+ * \brief           Output function of test instance, collects text to \ref lw_cpp_out
+ * \param[in]       ch: Character to print
+ * \param[in]       lw: LwPRINTF instance
+ * \return          `ch` value
+ */
+static int
+lwprintf_output_cpp(int ch, lwprintf_t* lw) {
+    LWPRINTF_UNUSED(lw);
+    if (ch != '\0') {
+        lw_cpp_out.push_back(static_cast<char>(ch));
+    }
+    return ch;
+}
+
+/**
+ * \brief           Compare text and length with expected values
+ * \param[in]       line: Line of the test
+ * \param[in]       exp: Expected text
+ * \param[in]       exp_len: Expected length
+ * \param[in]       actual: Actual text
+ * \param[in]       len: Actual length
+ */
+static void
+check_text(int line, const std::string& exp, int exp_len, const std::string& actual, int len) {
+    if (len != exp_len || actual != exp) {
+        std::printf("Test error on line: %d\r\n", line);
+        std::printf("Text does not match, expected: \"%s\" (%d), actual: \"%s\" (%d)\r\n", exp.c_str(), exp_len,
+                    actual.c_str(), len);
+        tests_failed++;
+    } else {
+        tests_passed++;
+    }
+}
+
+#define do_check(exp, exp_len, actual, len) check_text(__LINE__, (exp), (exp_len), (actual), (len))
+
+/**
+ * \brief           Format with C function, to get expected text of the wrapper
+ * \param[in]       fmt: Format string
+ * \return          Formatted text
+ */
+static std::string
+c_format(const char* fmt, ...) {
+    char buff[256];
+    va_list arg;
+
+    va_start(arg, fmt);
+    lwprintf_vsnprintf(buff, sizeof(buff), fmt, arg);
+    va_end(arg);
+    return buff;
+}
+
+/**
+ * \brief           User sink without contiguous memory, receives text in blocks
+ */
+struct BlockSink {
+    std::string text; /*!< Received text */
+
+    void
+    write(char ch) {
+        text.push_back(ch);
+    }
+
+    void
+    write(const char* data, size_t len) {
+        text.append(data, len);
+    }
+};
+
+#if LWPRINTF_CFG_ENABLE_CUSTOM_SPEC
+
+/**
+ * \brief           User type printed with formatter
+ */
+struct Point {
+    int x; /*!< X coordinate */
+    int y; /*!< Y coordinate */
+};
+
+template <>
+struct Lwprintf::formatter<Point> {
+    void
+    format(const Point& p, Lwprintf::FormatContext& ctx) {
+        Lwprintf::print_to<"(%d, %d)">(nullptr, ctx, p.x, p.y);
+    }
+};
+
+#endif /* LWPRINTF_CFG_ENABLE_CUSTOM_SPEC */
+
+#if LWPRINTF_CPP_COROUTINE
+
+/**
+ * \brief           Coroutine, that starts immediately and is not awaited
+ */
+struct Task {
+    struct promise_type {
+        Task
+        get_return_object() {
+            return {};
+        }
+
+        std::suspend_never
+        initial_suspend() noexcept {
+            return {};
+        }
+
+        std::suspend_never
+        final_suspend() noexcept {
+            return {};
+        }
+
+        void
+        return_void() {}
+
+        void
+        unhandled_exception() {}
+    };
+};
+
+/**
+ * \brief           Output queue of asynchronous test instance
+ */
+static void* lw_async_buff[16];
+
+/**
+ * \brief           Print messages to the queue and record result of every print
+ * \param[in]       printer: Asynchronous printer
+ * \param[in]       text: Text of messages
+ * \param[in]       cnt: Number of messages
+ * \param[out]      log: Log with `q` for queued and `e` for dropped message
+ */
+static Task
+async_task(Lwprintf::AsyncPrinter& printer, const char* text, int cnt, std::string& log) {
+    for (int i = 0; i < cnt; ++i) {
+        log.push_back(co_await Lwprintf::async_print<"%s %d\r\n">(printer, text, i) ? 'q' : 'e');
+    }
+}
+
+#endif /* LWPRINTF_CPP_COROUTINE */
+
+int
+main(void) {
+    char buff[256];
+    int len;
+
+    lwprintf_init(lwprintf_output_cpp);
+    lwprintf_init_ex(&lw_cpp, lwprintf_output_cpp);
+
+    /* Print and sized buffer, arguments are converted to exact types */
+    len = Lwprintf::print<"T=%d.%02u %s %5.1f|%c|%lld">(&lw_cpp, 21, 5U, "C", 2.26, 'x', -1234567890123LL);
+    do_check("T=21.05 C   2.3|x|-1234567890123", 32, lw_cpp_out, len);
+    len = Lwprintf::snprint<"%08.3f|%#x|%zu">(nullptr, buff, 8, -3.14159, 255U, sizeof(int));
+    do_check("-003.14", 15, buff, len);
+
+    /* Every specifier of the library takes the same arguments as C functions */
+    {
+        const unsigned char bytes[] = {0x4D, 0x61, 0x6E, 0x01};
+        const short arr_s[] = {-1, 2, 300};
+        const double arr_d[] = {0.5, 1.25};
+
+        len = Lwprintf::snprint<"%.3q16 %llq32 %Y %.3y %4r %4.4H">(nullptr, buff, sizeof(buff), 0x18000, 0x180000000LL,
+                                                                 4700, 12.345e-6, bytes, bytes);
+        do_check(c_format("%.3q16 %llq32 %Y %.3y %4r %4.4H", 0x18000, 0x180000000LL, 4700, 12.345e-6, bytes, bytes),
+                 len, buff, len);
+        len = Lwprintf::snprint<"%J|%C|%vhd|%v.1lf|%a|%zu">(nullptr, buff, sizeof(buff), "a\"b", "\t", 3, arr_s, 2,
+                                                             arr_d, 1.0, sizeof(short));
+        do_check("a\\\"b|\\t|-1, 2, 300|0.5, 1.3|0x1p+0|2", 36, buff, len);
+    }
+
+    /* Sinks, text is formatted in place to contiguous sinks and in blocks to other sinks */
+    {
+        Lwprintf::SpanSink span(buff);
+        Lwprintf::StaticSink<8> stat;
+        std::string str = "x=";
+        Lwprintf::StringSink str_sink(str);
+        char ring_mem[8];
+        Lwprintf::RingSink ring(ring_mem);
+
+        len = Lwprintf::print_to<"%s-%d">(nullptr, span, "span", 1);
+        do_check("span-1", 6, span.c_str(), len);
+        len = Lwprintf::print_to<"%s-%d">(nullptr, stat, "static", 22);
+        do_check("static-", 9, stat.c_str(), len);
+        len = Lwprintf::print_to<"%060d%060d%060d%060d|">(nullptr, str_sink, 1, 2, 3, 4);
+        do_check("x=" + std::string(59, '0') + "1" + std::string(59, '0') + "2" + std::string(59, '0') + "3"
+                     + std::string(59, '0') + "4|",
+                 241, str, len);
+        len = Lwprintf::print_to<"%s">(nullptr, ring, "ring text");
+        do_check("ring te", 9, std::string(ring.get_block().data(), ring.get_block().size()), len);
+        BlockSink block;
+        len = Lwprintf::print_to<"%s|%060d|%060u|%s">(nullptr, block, "block", -1, 2U, "end");
+        do_check("block|-" + std::string(58, '0') + "1|" + std::string(59, '0') + "2|end", 131, block.text, len);
+        if (ring.dropped() != 2) {
+            std::printf("Test error on line: %d\r\n", __LINE__);
+            std::printf("Ring sink dropped %u bytes\r\n", static_cast<unsigned>(ring.dropped()));
+            tests_failed++;
+        } else {
+            tests_passed++;
+        }
+    }
+
+    /* Output iterators */
+    {
+        std::vector<char> vec;
+        std::string str;
+        char arr[4];
+
+        Lwprintf::format_to<"{\"t\":%u}">(nullptr, std::back_inserter(vec), 25U);
+        do_check("{\"t\":25}", 8, std::string(vec.begin(), vec.end()), static_cast<int>(vec.size()));
+        const auto res = Lwprintf::format_to_n<"%d%d">(nullptr, arr, sizeof(arr), 123, 456);
+        do_check("1234", 6, std::string(arr, res.out), res.size);
+        Lwprintf::format_to<"%s/%x">(nullptr, std::back_inserter(str), "path", 0xAB);
+        do_check("path/ab", 7, str, static_cast<int>(str.size()));
+
+        /* Text longer than one block of the sink */
+        const std::string long_text = std::string(59, '0') + "1|" + std::string(59, '0') + "2";
+        vec.clear();
+        Lwprintf::format_to<"%060d|%060d">(nullptr, std::back_inserter(vec), 1, 2);
+        do_check(long_text, 121, std::string(vec.begin(), vec.end()), static_cast<int>(vec.size()));
+        const auto res_long = Lwprintf::format_to_n<"%060d|%060d">(nullptr, buff, 100, 1, 2);
+        do_check(long_text.substr(0, 100), 121, std::string(buff, res_long.out), res_long.size);
+        str.clear();
+        Lwprintf::fmt::format_to<"{:060}|{:060}">(nullptr, std::back_inserter(str), 1, 2);
+        do_check(long_text, 121, str, static_cast<int>(str.size()));
+    }
+
+    /* Format string with `{}` replacement fields */
+    {
+        std::string str;
+
+        len = Lwprintf::fmt::snprint<"{}.{:02} {:>4}|{:<4}|{:#x} {{}} {:.2f}">(nullptr, buff, sizeof(buff), 21, 5U, "ab",
+                                                                              "c", 255, 1.5);
+        do_check("21.05   ab|c   |0xff {} 1.50", 28, buff, len);
+        Lwprintf::fmt::format_to<"{}-{}">(nullptr, std::back_inserter(str), -1LL, true);
+        do_check("-1-1", 4, str, static_cast<int>(str.size()));
+    }
+
+#if LWPRINTF_CFG_ENABLE_CUSTOM_SPEC
+    /* User type with formatter, padded to width */
+    {
+        const Point p{3, -4};
+
+        Lwprintf::register_formatters(nullptr);
+        len = Lwprintf::snprint<"[%10T|%-9T]">(nullptr, buff, sizeof(buff), p, p);
+        do_check("[   (3, -4)|(3, -4)  ]", 22, buff, len);
+        len = Lwprintf::fmt::snprint<"p={}">(nullptr, buff, sizeof(buff), p);
+        do_check("p=(3, -4)", 9, buff, len);
+    }
+#endif /* LWPRINTF_CFG_ENABLE_CUSTOM_SPEC */
+
+    /* Compile-time formatter */
+    {
+        static constexpr auto banner = Lwprintf::format<"%s v%u.%u.%u|%-5d|%+.2f|%#06x", Lwprintf::FixedString("fw"), 1,
+                                                        0, 6, -3, 2.3456, 0x1F>();
+
+        static_assert(sizeof(banner) == 29, "Length of compile-time text does not match");
+        do_check("fw v1.0.6|-3   |+2.35|0x001f", 28, banner.data(), static_cast<int>(std::strlen(banner.data())));
+
+        /* Text is the same as formatted at runtime */
+        static constexpr auto nums = Lwprintf::format<"%f|%.2f|%.3F|%08.1f|%+.0f|%hhd %hhu %hd %hx|%d%u", 1e20, -3.4e25,
+                                                      1.5e300, -0.0, -0.0, 300, 300, 70000, -1, true, false>();
+        char text[sizeof(nums)];
+
+        len = Lwprintf::snprint<"%f|%.2f|%.3F|%08.1f|%+.0f|%hhd %hhu %hd %hx|%d%u">(
+            nullptr, text, sizeof(text), 1e20, -3.4e25, 1.5e300, -0.0, -0.0, 300, 300, 70000, -1, 1, 0U);
+        do_check(text, len, nums.data(), static_cast<int>(std::strlen(nums.data())));
+        static_assert(Lwprintf::ct::run<"%.3d", 7>(nullptr).error, "Precision of integer is not supported");
+    }
+
+#if LWPRINTF_CPP_COROUTINE
+    /* Coroutine waits for the queue, oversized message is dropped without waiting */
+    {
+        static lwprintf_t lw_async;
+        Lwprintf::AsyncPrinter printer(lw_async);
+        const std::string line(24, 'a');
+        std::string log;
+
+        lwprintf_init_ex(&lw_async, lwprintf_output_cpp);
+        lwprintf_init_async_ex(&lw_async, lw_async_buff, sizeof(lw_async_buff));
+        lw_cpp_out.clear();
+        async_task(printer, line.c_str(), 3, log);
+        do_check("q", 1, log, static_cast<int>(log.size()));
+        len = static_cast<int>(lwprintf_process_async_ex(&lw_async));
+        do_check("qqq", 3, log, len);
+        do_check(line + " 0\r\n" + line + " 1\r\n" + line + " 2\r\n", 3 * 28, lw_cpp_out,
+                 static_cast<int>(lw_cpp_out.size()));
+
+        const std::string long_line(lwprintf_async_max_len_ex(&lw_async), 'b');
+        async_task(printer, long_line.c_str(), 1, log);
+        do_check("qqqe", 0, log, static_cast<int>(printer.is_waiting())); /* Length is number of waiting prints */
+
+        /* Queue is drained without messages of the printer, waiting print is resumed by poll */
+        lw_cpp_out.clear();
+        lwprintf_init_async_ex(&lw_async, lw_async_buff, sizeof(lw_async_buff));
+        lwprintf_printf_async_ex(&lw_async, nullptr, nullptr, "%s", std::string(60, 'c').c_str());
+        async_task(printer, line.c_str(), 1, log);
+        lwprintf_process_async_ex(&lw_async);
+        do_check("qqqe", 1, log, static_cast<int>(printer.is_waiting()));
+        printer.poll();
+        lwprintf_process_async_ex(&lw_async);
+        do_check("qqqeq", 0, log, static_cast<int>(printer.is_waiting()));
+        do_check(std::string(60, 'c') + line + " 0\r\n", 88, lw_cpp_out, static_cast<int>(lw_cpp_out.size()));
+    }
+#endif /* LWPRINTF_CPP_COROUTINE */
+
+    std::printf("--------\r\n");
+    std::printf("Tests passed: %u\r\n", static_cast<unsigned>(tests_passed));
+    std::printf("Tests failed: %u\r\n", static_cast<unsigned>(tests_failed));
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,148 @@
+#
+# Worst-case stack report of public API functions
+#
+# Script is run with "cmake -DSTACK_OBJECTS=<obj1;obj2;...> -P stack_report.cmake",
+# for objects compiled by GCC with "-fstack-usage -fcallgraph-info=su" options.
+# When STACK_SUMMARY is set, only the function with the largest stack is printed, as "<bytes> <function>".
+# Call graph file (.ci) is expected next to every object, with the same name and ".ci" suffix instead of ".o".
+#
+# Worst-case stack of every function is its own frame plus the deepest chain of its callees.
+# Indirect calls are resolved to internal callbacks, depending on the context of the call chain:
+#  - Formatting loop may call converters and output functions
+#  - Converter, output helper or custom specifier API used by the handler, may call output functions
+#  - Output function, block flush and other indirect calls only call user callbacks, which are not included in the report
+#
+# Functions of the system port and the C library, that are not part of the objects, are not included either.
+#
+
+# Callback levels, and context level set by functions of each callback level, for following indirect calls
+set(callback_levels "^prv_conv_" "^prv_out_[a-z_]*fn_")
+set(context_entries "^prv_format" "^prv_conv_|^prv_out_|^lwprintf_spec_" "^prv_out_[a-z_]*fn_|^prv_out_block_")
+list(LENGTH callback_levels levels_cnt)
+
+# Parse all call graph files. Functions are identified by name, as static functions do not collide in the library
+set(funcs "")
+foreach(obj IN LISTS STACK_OBJECTS)
+    string(REGEX REPLACE "\\.(o|obj)$" ".ci" ci_file "${obj}")
+    if(NOT EXISTS "${ci_file}")
+        message(FATAL_ERROR "Call graph file ${ci_file} does not exist, compiler must support -fcallgraph-info")
+    endif()
+    file(STRINGS "${ci_file}" lines)
+    foreach(line IN LISTS lines)
+        if(line MATCHES "^node: { title: \"([^\"]*:)?([^\":]+)\" label: \"[^\"]*\\\\n([0-9]+) bytes \\(([a-z,]+)\\)")
+            set(fn "${CMAKE_MATCH_2}")
+            list(APPEND funcs "${fn}")
+            set(frame_${fn} "${CMAKE_MATCH_3}")
+            if(NOT CMAKE_MATCH_4 STREQUAL "static")
+                set(dynamic_${fn} 1)
+            endif()
+        elseif(line MATCHES "^edge: { sourcename: \"([^\"]*:)?([^\":]+)\" targetname: \"([^\"]*:)?([^\":]+)\"")
+            list(APPEND callees_${CMAKE_MATCH_2} "${CMAKE_MATCH_4}")
+        endif()
+    endforeach()
+endforeach()
+list(REMOVE_DUPLICATES funcs)
+
+# Callback level of every function, and context level it sets for its callees
+foreach(fn IN LISTS funcs)
+    set(level_${fn} -1)
+    set(level 0)
+    foreach(regex IN LISTS callback_levels)
+        if(fn MATCHES "${regex}")
+            set(level_${fn} ${level})
+            break()
+        endif()
+        math(EXPR level "${level} + 1")
+    endforeach()
+    set(level 0)
+    foreach(regex IN LISTS context_entries)
+        if(fn MATCHES "${regex}")
+            set(context_${fn} ${level})
+        endif()
+        math(EXPR level "${level} + 1")
+    endforeach()
+endforeach()
+
+# Calculate worst-case stack and call chain of the function in the context, results are stored to global properties
+function(worst_stack fn ctx)
+    if(DEFINED context_${fn})
+        set(ctx ${context_${fn}})
+    endif()
+    set(key ${fn}_${ctx})
+    get_property(done GLOBAL PROPERTY stack_worst_${key} SET)
+    if(done)
+        set_property(GLOBAL PROPERTY stack_key ${key})
+        return()
+    endif()
+
+    # Recursion cannot be bound statically, it is reported in the chain
+    set_property(GLOBAL PROPERTY stack_worst_${key} ${frame_${fn}})
+    set_property(GLOBAL PROPERTY stack_chain_${key} "${fn} (recursive)")
+
+    # Indirect calls are replaced with callbacks allowed in the context
+    set(targets "")
+    foreach(callee IN LISTS callees_${fn})
+        if(callee STREQUAL "__indirect_call")
+            foreach(cb IN LISTS funcs)
+                if(NOT level_${cb} LESS ctx)
+                    list(APPEND targets "${cb}")
+                endif()
+            endforeach()
+        elseif(DEFINED frame_${callee})
+            list(APPEND targets "${callee}")
+        endif()
+    endforeach()
+    list(REMOVE_DUPLICATES targets)
+
+    set(best 0)
+    set(chain "${fn} (${frame_${fn}})")
+    if(DEFINED dynamic_${fn})
+        set(chain "${fn} (${frame_${fn}}, dynamic)")
+    endif()
+    set(best_chain "")
+    foreach(callee IN LISTS targets)
+        worst_stack(${callee} ${ctx})
+        get_property(callee_key GLOBAL PROPERTY stack_key)
+        get_property(callee_worst GLOBAL PROPERTY stack_worst_${callee_key})
+        if(callee_worst GREATER best)
+            set(best ${callee_worst})
+            get_property(best_chain GLOBAL PROPERTY stack_chain_${callee_key})
+            set(best_chain " > ${best_chain}")
+        endif()
+    endforeach()
+    math(EXPR total "${frame_${fn}} + ${best}")
+    set_property(GLOBAL PROPERTY stack_worst_${key} ${total})
+    set_property(GLOBAL PROPERTY stack_chain_${key} "${chain}${best_chain}")
+    set_property(GLOBAL PROPERTY stack_key ${key})
+endfunction()
+
+# Report public functions, sorted by worst-case stack
+set(report "")
+foreach(fn IN LISTS funcs)
+    if(fn MATCHES "^lwprintf_")
+        worst_stack(${fn} ${levels_cnt})
+        get_property(key GLOBAL PROPERTY stack_key)
+        get_property(worst GLOBAL PROPERTY stack_worst_${key})
+        string(LENGTH "${worst}" digits)
+        math(EXPR pad_len "6 - ${digits}")
+        string(REPEAT " " ${pad_len} pad)
+        list(APPEND report "${pad}${worst} ${fn} ${key}")
+    endif()
+endforeach()
+list(SORT report ORDER DESCENDING)
+
+if(STACK_SUMMARY)
+    list(GET report 0 entry)
+    string(STRIP "${entry}" entry)
+    string(REGEX MATCH "^[0-9]+ [^ ]+" entry "${entry}")
+    message("${entry}")
+    return()
+endif()
+
+message("Worst-case stack of public functions, in units of bytes:")
+foreach(entry IN LISTS report)
+    string(STRIP "${entry}" entry)
+    string(REGEX MATCH "^([0-9]+ [^ ]+) ([^ ]+)$" entry "${entry}")
+    get_property(chain GLOBAL PROPERTY stack_chain_${CMAKE_MATCH_2})
+    message("${CMAKE_MATCH_1}: ${chain}")
+endforeach()
@@ -0,0 +1,40 @@
+#include "lwprintf/lwprintf.h"
+
+/* Output queue for asynchronous messages, aligned to pointer size */
+static void* async_buff[64];
+static UART_HandleTypeDef huart;
+static volatile uint8_t report_sent;
+
+/* Start transfer of next message, if there is one */
+static void
+uart_start_next(void) {
+    const char* data;
+    size_t len;
+
+    if ((len = lwprintf_async_get_block(&data)) > 0) {
+        HAL_UART_Transmit_DMA(&huart, (uint8_t*)data, (uint16_t)len);
+    }
+}
+
+/* Message is physically sent, release it and continue with the next one */
+void
+HAL_UART_TxCpltCallback(UART_HandleTypeDef* h) {
+    lwprintf_async_release_block();
+    uart_start_next();
+}
+
+int
+main(void) {
+    char report[32];
+
+    lwprintf_init_async(async_buff, sizeof(async_buff));
+
+    /* Text is formatted to the queue, function does not wait for the UART */
+    lwprintf_snprintf(report, sizeof(report), "Link up, %u ms", 125U);
+    lwprintf_printf_async(NULL, (void*)&report_sent, "Report: %s\r\n", report);
+    uart_start_next();
+
+    while (!report_sent) {
+        /* Do other work, flag is set when message is sent */
+    }
+}
@@ -0,0 +1,21 @@
+#include "lwprintf/lwprintf.h"
+
+/* Staging buffer, characters are collected here before they are sent out */
+static char staging_buff[64];
+
+/* Called for every chunk of data to be printed */
+int
+lwprintf_out_block(const char* data, size_t len, lwprintf_t* lwp) {
+    /* Send full chunk at once, (ex. HAL_UART_Transmit(&huart, data, len, 100)) */
+    fwrite(data, 1, len, stdout);
+    return (int)len;
+}
+
+int
+main(void) {
+    /* Initialize default lwprintf instance with block output function */
+    lwprintf_init_block(lwprintf_out_block, staging_buff, sizeof(staging_buff));
+
+    /* Print first text, output function is called once */
+    lwprintf_printf("Text: %d\r\n", 10);
+}
@@ -0,0 +1,22 @@
+#include "lwprintf/lwprintf.h"
+
+/* Storage for parsed segments of the format string */
+static void* storage[32];
+static lwprintf_compiled_t cfmt;
+
+int
+main(void) {
+    char buff[64];
+
+    /* Parse format string only once, at startup */
+    if (!lwprintf_compile("ts=%08lu temp=%d.%02u\r\n", &cfmt, storage, sizeof(storage))) {
+        /* Storage too small, required size is in cfmt.size */
+        return -1;
+    }
+
+    /* Use it many times, specifiers are not parsed again */
+    for (unsigned long ts = 0; ts < 10; ++ts) {
+        lwprintf_snprintf_compiled(buff, sizeof(buff), &cfmt, ts, 23, 5U);
+    }
+    return 0;
+}
@@ -0,0 +1,41 @@
+#include <cstdio>
+#include "lwprintf/lwprintf.hpp"
+
+static lwprintf_t lwobj;
+
+/* Formatted at compile time, placed in read-only memory */
+static constexpr auto version = Lwprintf::format<"v%u.%u.%u", 1, 0, 6>();
+
+/* Called for every character to be printed */
+int
+lwprintf_out(int ch, lwprintf_t* lwp) {
+    LWPRINTF_UNUSED(lwp);
+    if (ch != '\0') {
+        std::putchar(ch);
+    }
+    return ch;
+}
+
+int
+main(void) {
+    char buff[32];
+    uint8_t temp_int = 23;
+    uint16_t temp_dec = 5;
+
+    lwprintf_init_ex(&lwobj, lwprintf_out);
+
+    /* Format string is checked against argument types at compile time */
+    Lwprintf::print<"T=%d.%02u\r\n">(&lwobj, temp_int, temp_dec);
+    Lwprintf::snprint<"%s: %08lX">(&lwobj, buff, sizeof(buff), "ID", 0x1234UL);
+
+    /* Write directly to the sink, formatted in place for buffers */
+    Lwprintf::StaticSink<32> banner;
+    Lwprintf::print_to<"%s">(&lwobj, banner, version.data());
+
+    /* Brace format string, translated to "T=%d.%02u\r\n" at compile time */
+    Lwprintf::fmt::print<"T={}.{:02}\r\n">(&lwobj, temp_int, temp_dec);
+
+    /* Compilation error, "%d" cannot hold "long long" type */
+    /* Lwprintf::print<"%d">(&lwobj, 1LL); */
+    return 0;
+}
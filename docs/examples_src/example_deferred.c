@@ -0,0 +1,31 @@
+#include "lwprintf/lwprintf.h"
+
+/* Ring buffer for deferred messages, aligned to pointer size */
+static void* deferred_buff[64];
+
+/* Called for every character to be printed */
+int
+lwprintf_out(int ch, lwprintf_t* lwp) {
+    /* May use HAL_UART_Transmit function */
+    putchar(ch);
+    return ch;
+}
+
+/* Interrupt or time critical task only stores format pointer and arguments */
+void
+adc_irq_handler(void) {
+    static unsigned int cnt;
+    lwprintf_printf_deferred("ADC sample %u: %d mV\r\n", ++cnt, -125);
+}
+
+int
+main(void) {
+    /* Initialize default lwprintf instance with output function and set ring buffer */
+    lwprintf_init(lwprintf_out);
+    lwprintf_init_deferred(deferred_buff, sizeof(deferred_buff));
+
+    while (1) {
+        /* Idle loop or low priority task formats stored messages to the output */
+        lwprintf_process_deferred();
+    }
+}
@@ -0,0 +1,38 @@
+#include "lwprintf/lwprintf.h"
+#include "system/lwprintf_mpsc.h"
+
+/* Ring buffer memory, aligned to size_t */
+static size_t ring_mem[256];
+static lwprintf_mpsc_t ring;
+
+/* Any task or core prints without waiting for the mutex */
+void
+sensor_task(void* arg) {
+    while (1) {
+        lwprintf_printf("Sensor: %d\r\n", 25);
+    }
+}
+
+/* Single drain task sends finished lines to the hardware */
+void
+drain_task(void* arg) {
+    const char* data;
+    size_t len;
+
+    while (1) {
+        if ((len = lwprintf_mpsc_get_block(&ring, &data)) > 0) {
+            /* Send data, (ex. HAL_UART_Transmit(&huart, data, len, 100)) */
+            fwrite(data, 1, len, stdout);
+            lwprintf_mpsc_release_block(&ring);
+        }
+    }
+}
+
+int
+main(void) {
+    /* Initialize ring buffer and set it as output of default instance */
+    lwprintf_mpsc_init(&ring, ring_mem, sizeof(ring_mem));
+    lwprintf_mpsc_attach(NULL, &ring);
+
+    /* Start tasks here */
+}
@@ -2,6 +2,24 @@
 
 #include "lwprintf/lwprintf.h"
 
+#if LWPRINTF_CFG_ENABLE_CUSTOM_SPEC
+
+/**
+ * \brief           Custom specifier handler to print IPv4 address from array of 4 bytes
+ * \param[in]       ctx: Output context
+ * \param[in]       spec: Specifier character
+ * \param[in,out]   arg: Pointer to variable argument list
+ */
+static void
+ipv4_specifier(lwprintf_spec_ctx_t* ctx, char spec, va_list* arg) {
+    const unsigned char* ip = va_arg(*arg, const unsigned char*);
+
+    (void)spec;
+    lwprintf_spec_printf(ctx, "%u.%u.%u.%u", (unsigned)ip[0], (unsigned)ip[1], (unsigned)ip[2], (unsigned)ip[3]);
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_CUSTOM_SPEC */
+
 /**
  * \brief           List of additional specifiers to print
  */
@@ -32,4 +50,28 @@ additional_format_specifiers(void) {
     lwprintf_printf("% *K\r\n", (int)LWPRINTF_ARRAYSIZE(my_array), my_array);
     /* Variable length with uppercase letters and spaces, outputs "01 02 a4 b5 c6" */
     lwprintf_printf("% *k\r\n", (int)LWPRINTF_ARRAYSIZE(my_array), my_array);
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_BASE64
+    /* Variable length in base64 format, outputs "AQKktcY=" */
+    lwprintf_printf("%*r\r\n", (int)LWPRINTF_ARRAYSIZE(my_array), my_array);
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_BASE64 */
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_HEXDUMP
+    /* Hexdump with 4 bytes per line, outputs 2 lines with offset and gutter, first is "00000000  01 02 a4 b5  |....|" */
+    lwprintf_printf("%*.4H", (int)LWPRINTF_ARRAYSIZE(my_array), my_array);
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_HEXDUMP */
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_STRING_ESCAPE
+    /* Escaped strings, quotes are part of format, outputs {"msg":"say \"hi\"\n"} and "tab\there" */
+    lwprintf_printf("{\"msg\":\"%J\"}\r\n", "say \"hi\"\n");
+    lwprintf_printf("\"%C\"\r\n", "tab\there");
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_STRING_ESCAPE */
+
+#if LWPRINTF_CFG_ENABLE_CUSTOM_SPEC
+    /* Custom specifiers */
+
+    /* Register handler once, then prints right aligned address, so "     192.168.1.10" */
+    lwprintf_register_specifier('I', ipv4_specifier);
+    lwprintf_printf("%17I\r\n", (const unsigned char[]){192, 168, 1, 10});
+#endif /* LWPRINTF_CFG_ENABLE_CUSTOM_SPEC */
 }
\ No newline at end of file
@@ -34,4 +34,7 @@
 #ifndef LWPRINTF_HDR_OPTS_H
 #define LWPRINTF_HDR_OPTS_H
 
+/* Send data in blocks, used by UART DMA output */
+#define LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT 1
+
 #endif /* LWPRINTF_HDR_OPTS_H */
@@ -0,0 +1,76 @@
+/**
+ * \file            lwprintf_uart_dma.h
+ * \brief           Double buffered UART output with DMA for STM32 HAL
+ */
+
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwPRINTF - Lightweight stdio manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v1.0.6
+ */
+#ifndef LWPRINTF_UART_DMA_HDR_H
+#define LWPRINTF_UART_DMA_HDR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "lwprintf/lwprintf.h"
+#include "main.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \brief           Size of each of two buffers, in units of bytes
+ */
+#ifndef LWPRINTF_UART_DMA_BUFF_SIZE
+#define LWPRINTF_UART_DMA_BUFF_SIZE 128
+#endif /* LWPRINTF_UART_DMA_BUFF_SIZE */
+
+/**
+ * \brief           Double buffered UART output.
+ *
+ * Application formats to one buffer while the other one is sent over DMA
+ */
+typedef struct {
+    UART_HandleTypeDef* huart;                    /*!< UART handle, with DMA assigned to its TX */
+    uint8_t buff[2][LWPRINTF_UART_DMA_BUFF_SIZE]; /*!< Buffers, one is filled while the other one is sent */
+    volatile size_t len[2];                       /*!< Number of bytes in each buffer */
+    volatile uint8_t active;                      /*!< Index of buffer currently being filled */
+    volatile uint8_t busy;                        /*!< Set to `1` while DMA transfer is in progress */
+} lwprintf_uart_dma_t;
+
+uint8_t lwprintf_uart_dma_init(lwprintf_t* lwobj, lwprintf_uart_dma_t* sink, UART_HandleTypeDef* huart);
+int lwprintf_uart_dma_out_block(const char* data, size_t len, lwprintf_t* lwobj);
+void lwprintf_uart_dma_tx_complete(UART_HandleTypeDef* huart);
+void lwprintf_uart_dma_wait_idle(void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWPRINTF_UART_DMA_HDR_H */
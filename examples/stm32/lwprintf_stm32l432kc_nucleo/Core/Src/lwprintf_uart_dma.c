@@ -0,0 +1,149 @@
+/**
+ * \file            lwprintf_uart_dma.c
+ * \brief           Double buffered UART output with DMA for STM32 HAL
+ */
+
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwPRINTF - Lightweight stdio manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v1.0.6
+ */
+#include <string.h>
+#include "lwprintf_uart_dma.h"
+
+/* Sink used by transfer complete callback, that only provides UART handle */
+static lwprintf_uart_dma_t* uart_dma_sink;
+
+/**
+ * \brief           Start DMA transfer of active buffer, if DMA is idle and buffer has data.
+ *                  Filling continues in the other buffer
+ * \note            Called with interrupts disabled
+ * \param[in,out]   sink: UART DMA sink
+ */
+static void
+prv_start_transfer(lwprintf_uart_dma_t* sink) {
+    uint8_t idx = sink->active;
+
+    if (sink->busy || sink->len[idx] == 0) {
+        return;
+    }
+    sink->busy = 1;
+    sink->active = idx ^ 1;
+    sink->len[sink->active] = 0;
+    if (HAL_UART_Transmit_DMA(sink->huart, sink->buff[idx], (uint16_t)sink->len[idx]) != HAL_OK) {
+        sink->busy = 0;
+    }
+}
+
+/**
+ * \brief           Initialize UART DMA sink and set it as block output of LwPRINTF instance
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[out]      sink: UART DMA sink to initialize
+ * \param[in]       huart: UART handle, with DMA linked to its TX
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwprintf_uart_dma_init(lwprintf_t* lwobj, lwprintf_uart_dma_t* sink, UART_HandleTypeDef* huart) {
+    memset(sink, 0x00, sizeof(*sink));
+    sink->huart = huart;
+    uart_dma_sink = sink;
+
+    /* Sink has its own buffers, staging buffer of the instance is not needed */
+    return lwprintf_init_block_ex(lwobj, lwprintf_uart_dma_out_block, NULL, 0);
+}
+
+/**
+ * \brief           Block output function, copying data to the active buffer
+ *
+ * Transfer starts immediately when DMA is idle. While it is busy, data are collected
+ * to the other buffer, and function waits only when both buffers are full
+ *
+ * \note            Function must not be called with DMA interrupt masked,
+ *                  for example from interrupt of higher priority, as it may wait for it
+ *
+ * \param[in]       data: Data to print
+ * \param[in]       len: Number of bytes to print
+ * \param[in]       lwobj: LwPRINTF instance
+ * \return          `len` on success, `0` otherwise
+ */
+int
+lwprintf_uart_dma_out_block(const char* data, size_t len, lwprintf_t* lwobj) {
+    lwprintf_uart_dma_t* sink = uart_dma_sink;
+    size_t left = len;
+
+    LWPRINTF_UNUSED(lwobj);
+    if (sink == NULL) {
+        return 0;
+    }
+    while (left > 0) {
+        uint32_t primask;
+        size_t n;
+
+        /* Both buffers are full, wait for transfer complete interrupt to swap them */
+        while (sink->len[sink->active] >= LWPRINTF_UART_DMA_BUFF_SIZE) {}
+
+        primask = __get_PRIMASK();
+        __disable_irq();
+        n = LWPRINTF_UART_DMA_BUFF_SIZE - sink->len[sink->active];
+        if (n > left) {
+            n = left;
+        }
+        memcpy(&sink->buff[sink->active][sink->len[sink->active]], data, n);
+        sink->len[sink->active] += n;
+        prv_start_transfer(sink);
+        __set_PRIMASK(primask);
+
+        data += n;
+        left -= n;
+    }
+    return (int)len;
+}
+
+/**
+ * \brief           Notify sink about completed transfer.
+ *                  Call it from `HAL_UART_TxCpltCallback` function
+ * \param[in]       huart: UART handle that completed transfer
+ */
+void
+lwprintf_uart_dma_tx_complete(UART_HandleTypeDef* huart) {
+    lwprintf_uart_dma_t* sink = uart_dma_sink;
+
+    if (sink != NULL && sink->huart == huart) {
+        sink->busy = 0;
+        prv_start_transfer(sink); /* Send data collected during previous transfer */
+    }
+}
+
+/**
+ * \brief           Wait until all collected data are sent, for example before entering low-power mode
+ */
+void
+lwprintf_uart_dma_wait_idle(void) {
+    lwprintf_uart_dma_t* sink = uart_dma_sink;
+
+    while (sink != NULL && (sink->busy || sink->len[sink->active] > 0)) {}
+}
@@ -23,6 +23,7 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "lwprintf/lwprintf.h"
+#include "lwprintf_uart_dma.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -41,40 +42,28 @@
 
 /* Private variables ---------------------------------------------------------*/
 UART_HandleTypeDef huart2;
+DMA_HandleTypeDef hdma_usart2_tx;
 
 /* USER CODE BEGIN PV */
+static lwprintf_uart_dma_t uart_dma;
 
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
 static void MX_GPIO_Init(void);
+static void MX_DMA_Init(void);
 static void MX_USART2_UART_Init(void);
 /* USER CODE BEGIN PFP */
+#if LWPRINTF_BENCH
+void bench_format_run(void);
+#endif /* LWPRINTF_BENCH */
 
 /* USER CODE END PFP */
 
 /* Private user code ---------------------------------------------------------*/
 /* USER CODE BEGIN 0 */
 
-/**
- * \brief           Output function to handle all characters for print operation
- * \param[in]       ch: Character to output
- * \param[in]       p: \ref lwprintf_t handle
- * \return          ch on success, 0 on failure
- */
-static int
-lwprintf_my_out_func(int ch, lwprintf_t* p) {
-    uint8_t c = (uint8_t)ch;
-
-    /* Don't print zero */
-    if (c == '\0') {
-        return ch;
-    }
-    HAL_UART_Transmit(&huart2, &c, 1, 100);
-    return ch;
-}
-
 /* USER CODE END 0 */
 
 /**
@@ -105,16 +94,23 @@ main(void) {
 
     /* Initialize all configured peripherals */
     MX_GPIO_Init();
+    MX_DMA_Init();
     MX_USART2_UART_Init();
     /* USER CODE BEGIN 2 */
 
-    /* Initialize library */
-    lwprintf_init(lwprintf_my_out_func);
+    /* Initialize library with double buffered DMA output */
+    lwprintf_uart_dma_init(NULL, &uart_dma, &huart2);
 
     /* Print formatted data */
     lwprintf_printf("My first string: %s\r\n", "Hello world");
     lwprintf_printf("My first digits: %d\r\n", 10);
     lwprintf_printf("My first pointer: %p\r\n", &my_int);
+#if LWPRINTF_BENCH
+    bench_format_run();
+#endif /* LWPRINTF_BENCH */
+
+    /* Wait for all data to be sent before going further */
+    lwprintf_uart_dma_wait_idle();
     /* USER CODE END 2 */
 
     /* Infinite loop */
@@ -228,8 +224,33 @@ MX_GPIO_Init(void) {
 
 }
 
+/**
+  * Enable DMA controller clock
+  */
+static void
+MX_DMA_Init(void) {
+
+    /* DMA controller clock enable */
+    __HAL_RCC_DMA1_CLK_ENABLE();
+
+    /* DMA interrupt init */
+    /* DMA1_Channel7_IRQn interrupt configuration */
+    HAL_NVIC_SetPriority(DMA1_Channel7_IRQn, 0, 0);
+    HAL_NVIC_EnableIRQ(DMA1_Channel7_IRQn);
+
+}
+
 /* USER CODE BEGIN 4 */
 
+/**
+ * \brief           UART transmit complete callback from HAL
+ * \param[in]       huart: UART handle
+ */
+void
+HAL_UART_TxCpltCallback(UART_HandleTypeDef* huart) {
+    lwprintf_uart_dma_tx_complete(huart);
+}
+
 /* USER CODE END 4 */
 
 /**
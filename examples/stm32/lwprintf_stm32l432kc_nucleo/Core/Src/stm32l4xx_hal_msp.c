@@ -58,6 +58,8 @@
 /* USER CODE BEGIN 0 */
 
 /* USER CODE END 0 */
+extern DMA_HandleTypeDef hdma_usart2_tx;
+
 /**
   * Initializes the Global MSP.
   */
@@ -105,6 +107,26 @@ HAL_UART_MspInit(UART_HandleTypeDef* huart) {
         GPIO_InitStruct.Alternate = GPIO_AF7_USART2;
         HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
 
+        /* USART2 DMA Init */
+        /* USART2_TX Init */
+        hdma_usart2_tx.Instance = DMA1_Channel7;
+        hdma_usart2_tx.Init.Request = DMA_REQUEST_2;
+        hdma_usart2_tx.Init.Direction = DMA_MEMORY_TO_PERIPH;
+        hdma_usart2_tx.Init.PeriphInc = DMA_PINC_DISABLE;
+        hdma_usart2_tx.Init.MemInc = DMA_MINC_ENABLE;
+        hdma_usart2_tx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+        hdma_usart2_tx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+        hdma_usart2_tx.Init.Mode = DMA_NORMAL;
+        hdma_usart2_tx.Init.Priority = DMA_PRIORITY_LOW;
+        if (HAL_DMA_Init(&hdma_usart2_tx) != HAL_OK) {
+            Error_Handler();
+        }
+
+        __HAL_LINKDMA(huart, hdmatx, hdma_usart2_tx);
+
+        /* USART2 interrupt Init */
+        HAL_NVIC_SetPriority(USART2_IRQn, 0, 0);
+        HAL_NVIC_EnableIRQ(USART2_IRQn);
         /* USER CODE BEGIN USART2_MspInit 1 */
 
         /* USER CODE END USART2_MspInit 1 */
@@ -133,6 +155,11 @@ HAL_UART_MspDeInit(UART_HandleTypeDef* huart) {
         */
         HAL_GPIO_DeInit(GPIOA, GPIO_PIN_2 | GPIO_PIN_3);
 
+        /* USART2 DMA DeInit */
+        HAL_DMA_DeInit(huart->hdmatx);
+
+        /* USART2 interrupt DeInit */
+        HAL_NVIC_DisableIRQ(USART2_IRQn);
         /* USER CODE BEGIN USART2_MspDeInit 1 */
 
         /* USER CODE END USART2_MspDeInit 1 */
@@ -6,7 +6,9 @@
 #
 # Before this file is included to the root CMakeLists file (using include() function), user can set some variables:
 #
-# LWPRINTF_SYS_PORT: If defined, it will include port source file from the library.
+# LWPRINTF_SYS_PORT: If defined, it will include port source file from the library. One of: win32, posix, cmsis_os, threadx, mpsc
+# LWPRINTF_TRACE_PORT: If defined, it will include trace hooks binding source file from the library. One of: sysview
+# LWPRINTF_SINK_PORT: If defined, it will include ready-made block output sink source files from the library. List of: itm, rtt, mmap
 # LWPRINTF_OPTS_FILE: If defined, it is the path to the user options file. If not defined, one will be generated for you automatically
 # LWPRINTF_COMPILE_OPTIONS: If defined, it provide compiler options for generated library.
 # LWPRINTF_COMPILE_DEFINITIONS: If defined, it provides "-D" definitions to the library build
@@ -18,6 +20,10 @@ set(LWPRINTF_CUSTOM_INC_DIR ${CMAKE_CURRENT_BINARY_DIR}/lib_inc)
 # Library core sources
 set(lwprintf_core_SRCS
     ${CMAKE_CURRENT_LIST_DIR}/src/lwprintf/lwprintf.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwprintf/lwprintf_smp.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwprintf/lwprintf_crashlog.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwprintf/lwprintf_compress.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwprintf/lwprintf_parallel.c
 )
 
 # Add system port
@@ -28,6 +34,22 @@ if(DEFINED LWPRINTF_SYS_PORT)
     )
 endif()
 
+# Add trace hooks binding, its header is included from the options file
+if(DEFINED LWPRINTF_TRACE_PORT)
+    set(lwprintf_core_SRCS
+        ${lwprintf_core_SRCS}
+        ${CMAKE_CURRENT_LIST_DIR}/src/system/lwprintf_trace_${LWPRINTF_TRACE_PORT}.c
+    )
+endif()
+
+# Add block output sinks
+foreach(sink ${LWPRINTF_SINK_PORT})
+    set(lwprintf_core_SRCS
+        ${lwprintf_core_SRCS}
+        ${CMAKE_CURRENT_LIST_DIR}/src/system/lwprintf_sink_${sink}.c
+    )
+endforeach()
+
 # Setup include directories
 set(lwprintf_include_DIRS
     ${CMAKE_CURRENT_LIST_DIR}/src/include
@@ -41,6 +63,12 @@ target_include_directories(lwprintf PUBLIC ${lwprintf_include_DIRS})
 target_compile_options(lwprintf PRIVATE ${LWPRINTF_COMPILE_OPTIONS})
 target_compile_definitions(lwprintf PRIVATE ${LWPRINTF_COMPILE_DEFINITIONS})
 
+# POSIX port uses threads library
+if(LWPRINTF_SYS_PORT STREQUAL "posix")
+    find_package(Threads REQUIRED)
+    target_link_libraries(lwprintf PUBLIC Threads::Threads)
+endif()
+
 # Create config file if user didn't provide one info himself
 if(NOT LWPRINTF_OPTS_FILE)
     message(STATUS "Using default lwprintf_opts.h file")
@@ -63,6 +63,19 @@ extern "C" {
  */
 #define LWPRINTF_ARRAYSIZE(x) (sizeof(x) / sizeof((x)[0]))
 
+/**
+ * \brief           Log levels, in order of severity
+ * \{
+ */
+#define LWPRINTF_LEVEL_DEBUG   0 /*!< Debug messages */
+#define LWPRINTF_LEVEL_INFO    1 /*!< Informational messages */
+#define LWPRINTF_LEVEL_WARNING 2 /*!< Warnings */
+#define LWPRINTF_LEVEL_ERROR   3 /*!< Errors */
+#define LWPRINTF_LEVEL_NONE    4 /*!< Level to disable all messages */
+/**
+ * \}
+ */
+
 /**
  * \brief           Forward declaration for LwPRINTF instance
  */
@@ -76,24 +89,616 @@ struct lwprintf;
  */
 typedef int (*lwprintf_output_fn)(int ch, struct lwprintf* lwobj);
 
+/**
+ * \brief           Callback function for block (multiple characters at once) output
+ * \param[in]       data: Pointer to characters to print. It is not `NULL` terminated
+ * \param[in]       len: Number of characters to print
+ * \param[in]       lwobj: LwPRINTF instance
+ * \return          `len` on success, `0` to terminate further string processing
+ */
+typedef int (*lwprintf_output_block_fn)(const char* data, size_t len, struct lwprintf* lwobj);
+
+/**
+ * \brief           Callback function for completed asynchronous message
+ * \param[in]       lwobj: LwPRINTF instance
+ * \param[in]       arg: User argument, passed to asynchronous print function
+ */
+typedef void (*lwprintf_async_done_fn)(struct lwprintf* lwobj, void* arg);
+
+#if LWPRINTF_CFG_ENABLE_LINE_PREFIX || __DOXYGEN__
+/**
+ * \brief           Time function for line prefix
+ * \param[out]      sec: Seconds
+ * \param[out]      ms: Milliseconds, from `0` to `999`
+ * \param[in]       lwobj: LwPRINTF instance
+ */
+typedef void (*lwprintf_prefix_time_fn)(uint32_t* sec, uint32_t* ms, struct lwprintf* lwobj);
+
+/**
+ * \brief           Size of rendered line prefix, `[` with `10` digits of seconds, `.` with `3` digits of milliseconds,
+ *                  `] [`, tag and `] `
+ */
+#define LWPRINTF_LINE_PREFIX_SIZE (1 + 10 + 1 + 3 + 3 + LWPRINTF_CFG_LINE_PREFIX_TAG_LEN + 2)
+#endif /* LWPRINTF_CFG_ENABLE_LINE_PREFIX || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_STATS || LWPRINTF_CFG_OS_STATS || LWPRINTF_CFG_ENABLE_DEADLINE || LWPRINTF_CFG_ENABLE_AUTO_FLUSH      \
+    || LWPRINTF_CFG_ENABLE_RATE_LIMIT || LWPRINTF_CFG_ENABLE_COALESCE || __DOXYGEN__
+/**
+ * \brief           Timestamp function for statistics, time budget of print, age of staged text, rate limit
+ *                  and timeout of repeated records
+ * \return          Current time, in any unit with wrap-around at `32-bit` range
+ */
+typedef uint32_t (*lwprintf_timestamp_fn)(void);
+#endif /* LWPRINTF_CFG_STATS || LWPRINTF_CFG_OS_STATS || LWPRINTF_CFG_ENABLE_DEADLINE || ... */
+
+#if LWPRINTF_CFG_STATS || LWPRINTF_CFG_OS_STATS || __DOXYGEN__
+/**
+ * \brief           Statistics of LwPRINTF instance
+ *
+ * Times are in units of timestamp function. Recursive mutex acquisitions are not counted
+ */
+typedef struct {
+#if LWPRINTF_CFG_OS_STATS || __DOXYGEN__
+    uint32_t acquisitions; /*!< Number of mutex acquisitions */
+    uint32_t contended;    /*!< Number of acquisitions, when mutex was held by other thread */
+    uint64_t wait_total;   /*!< Total time spent waiting for the mutex */
+    uint32_t wait_max;     /*!< Maximum time spent waiting for the mutex */
+    uint64_t hold_total;   /*!< Total time mutex was held */
+    uint32_t hold_max;     /*!< Maximum time mutex was held */
+#endif                     /* LWPRINTF_CFG_OS_STATS || __DOXYGEN__ */
+#if LWPRINTF_CFG_STATS || __DOXYGEN__
+    uint32_t calls;      /*!< Number of formatting calls, without length measurement */
+    uint64_t bytes;      /*!< Number of characters written to the output or to the buffer */
+    uint32_t sink_calls; /*!< Number of output function calls */
+    uint32_t cancelled;  /*!< Number of prints, cancelled by output function */
+    uint32_t truncated;  /*!< Number of calls, where text did not fit to the buffer */
+    uint64_t out_total;  /*!< Total time spent in output function */
+    uint32_t out_max;    /*!< Maximum time of one output function call */
+#if LWPRINTF_CFG_STATS_OUT_HIST_BUCKETS > 0 || __DOXYGEN__
+    uint32_t out_hist[LWPRINTF_CFG_STATS_OUT_HIST_BUCKETS]; /*!< Output function calls in log2 buckets of duration */
+#endif /* LWPRINTF_CFG_STATS_OUT_HIST_BUCKETS > 0 || __DOXYGEN__ */
+#endif /* LWPRINTF_CFG_STATS || __DOXYGEN__ */
+} lwprintf_stats_t;
+#endif /* LWPRINTF_CFG_STATS || LWPRINTF_CFG_OS_STATS || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_PACKED_ARGS || LWPRINTF_CFG_ENABLE_DEFERRED || LWPRINTF_CFG_ENABLE_TOKEN || __DOXYGEN__
+/**
+ * \brief           Type of `%f`, `%e` and `%g` argument in packed arguments buffer.
+ *
+ * It is `float` with \ref LWPRINTF_CFG_SUPPORT_TYPE_FLOAT_SINGLE enabled, `double` otherwise.
+ * Other arguments are stored with the type after default argument promotion, and `%a` argument as `double`
+ */
+#if LWPRINTF_CFG_SUPPORT_TYPE_FLOAT_SINGLE
+typedef float lwprintf_packed_float_t;
+#else
+typedef double lwprintf_packed_float_t;
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FLOAT_SINGLE */
+#endif /* LWPRINTF_CFG_ENABLE_PACKED_ARGS || LWPRINTF_CFG_ENABLE_DEFERRED || LWPRINTF_CFG_ENABLE_TOKEN || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_TRY_PRINT || __DOXYGEN__
+/**
+ * \brief           Return value of non-blocking print functions, when message has been dropped
+ */
+#define LWPRINTF_TRY_BUSY (-1)
+#endif /* LWPRINTF_CFG_ENABLE_TRY_PRINT || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_RATE_LIMIT || __DOXYGEN__
+/**
+ * \brief           Rate limit state of single call site, zero initialized
+ */
+typedef struct {
+    uint32_t tat;        /*!< Theoretical arrival time of the next message */
+    uint32_t suppressed; /*!< Number of messages skipped since last printed one */
+    uint8_t is_started;  /*!< Set to `1` after first message */
+} lwprintf_limit_t;
+#endif /* LWPRINTF_CFG_ENABLE_RATE_LIMIT || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_BUFF_MODE || __DOXYGEN__
+/**
+ * \brief           Buffering mode of block output instance
+ */
+typedef enum {
+    LWPRINTF_BUFF_MODE_NONE = 0x00, /*!< Staging buffer is sent at the end of every print call. Default mode */
+    LWPRINTF_BUFF_MODE_LINE,        /*!< Staging buffer is sent when new line character is printed, or when full */
+    LWPRINTF_BUFF_MODE_FULL,        /*!< Staging buffer is sent only when full, or with \ref lwprintf_flush_ex */
+} lwprintf_buff_mode_t;
+#endif /* LWPRINTF_CFG_ENABLE_BUFF_MODE || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_IOV || __DOXYGEN__
+/**
+ * \brief           Output segment of scatter-gather formatting
+ *
+ * Members map one to one to `iov_base` and `iov_len` of POSIX `struct iovec`
+ */
+typedef struct {
+    const char* ptr; /*!< Segment data, not `NULL` terminated */
+    size_t len;      /*!< Segment length in units of bytes */
+} lwprintf_iov_t;
+#endif /* LWPRINTF_CFG_ENABLE_IOV || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_STRBUF || __DOXYGEN__
+
+/**
+ * \brief           Chunk of string builder. Data follow the header in the same memory block
+ */
+typedef struct lwprintf_strbuf_chunk {
+    struct lwprintf_strbuf_chunk* next; /*!< Next chunk, `NULL` for the last one */
+    char* data;                         /*!< Chunk data, not `NULL` terminated */
+    size_t len;                         /*!< Number of used bytes */
+    size_t size;                        /*!< Size of data in units of bytes */
+} lwprintf_strbuf_chunk_t;
+
+/**
+ * \brief           Chunk allocator of string builder
+ * \param[in]       size: Size of memory block in units of bytes, including chunk header
+ * \param[in]       arg: User argument
+ * \return          Memory block aligned to pointer size, `NULL` if there is no more memory
+ */
+typedef void* (*lwprintf_strbuf_alloc_fn)(size_t size, void* arg);
+
+/**
+ * \brief           Chunk release function of string builder
+ * \param[in]       ptr: Memory block, previously returned by allocator
+ * \param[in]       arg: User argument
+ */
+typedef void (*lwprintf_strbuf_free_fn)(void* ptr, void* arg);
+
+/**
+ * \brief           Growable string builder
+ */
+typedef struct {
+    lwprintf_strbuf_chunk_t* first;    /*!< First chunk */
+    lwprintf_strbuf_chunk_t* last;     /*!< Last chunk, where text is appended */
+    size_t len;                        /*!< Length of stored text */
+    size_t chunk_size;                 /*!< Data size of new chunks */
+    lwprintf_strbuf_alloc_fn alloc_fn; /*!< Chunk allocator. Set to `NULL` when chunks are taken from arena */
+    lwprintf_strbuf_free_fn free_fn;   /*!< Chunk release function */
+    void* arg;                         /*!< User argument for allocator */
+    char* arena;                       /*!< Arena memory */
+    size_t arena_size;                 /*!< Size of arena in units of bytes */
+    size_t arena_pos;                  /*!< Used part of arena */
+    uint8_t is_full;                   /*!< Set to `1` when memory ran out and text was truncated */
+} lwprintf_strbuf_t;
+
+#endif /* LWPRINTF_CFG_ENABLE_STRBUF || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_ASPRINTF || __DOXYGEN__
+
+/**
+ * \brief           Memory block allocator of allocating print functions
+ * \param[in]       size: Size of memory block in units of bytes
+ * \param[in]       arg: User argument
+ * \return          Memory block, `NULL` if there is no more memory
+ */
+typedef void* (*lwprintf_pool_alloc_fn)(size_t size, void* arg);
+
+/**
+ * \brief           Grow or shrink memory block in place, without moving its data
+ * \param[in]       ptr: Memory block, previously returned by allocator
+ * \param[in]       size: New size of memory block in units of bytes
+ * \param[in]       arg: User argument
+ * \return          `1` on success, `0` if block cannot be resized
+ */
+typedef uint8_t (*lwprintf_pool_resize_fn)(void* ptr, size_t size, void* arg);
+
+/**
+ * \brief           Memory block release function of allocating print functions
+ * \param[in]       ptr: Memory block, previously returned by allocator
+ * \param[in]       arg: User argument
+ */
+typedef void (*lwprintf_pool_free_fn)(void* ptr, void* arg);
+
+/**
+ * \brief           Memory pool of allocating print functions
+ */
+typedef struct {
+    lwprintf_pool_alloc_fn alloc_fn;   /*!< Allocator */
+    lwprintf_pool_resize_fn resize_fn; /*!< In place resize function. Set to `NULL` if pool cannot resize blocks */
+    lwprintf_pool_free_fn free_fn;     /*!< Release function. Can be `NULL` */
+    void* arg;                         /*!< User argument for pool functions */
+} lwprintf_pool_t;
+
+#endif /* LWPRINTF_CFG_ENABLE_ASPRINTF || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_RESUMABLE || __DOXYGEN__
+
+/**
+ * \brief           State of resumable formatting, kept between calls of \ref lwprintf_format_continue
+ */
+typedef struct {
+    struct lwprintf* lwobj; /*!< LwPRINTF instance */
+    const char* fmt;        /*!< Format string at start of part, that is not fully output yet */
+    va_list arg;            /*!< Arguments at start of the part */
+    size_t part_pos;        /*!< Position of the first character of the part in the text */
+    size_t pos;             /*!< Number of characters already output */
+    uint8_t is_done;        /*!< Set to `1` when whole text is output or formatting is ended */
+} lwprintf_resume_t;
+
+#endif /* LWPRINTF_CFG_ENABLE_RESUMABLE || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_CUSTOM_SPEC || __DOXYGEN__
+
+/**
+ * \brief           Output context of custom specifier handler, used with `lwprintf_spec_*` functions
+ */
+typedef struct lwprintf_spec_ctx lwprintf_spec_ctx_t;
+
+/**
+ * \brief           Custom specifier handler.
+ *
+ * Handler reads its arguments with `va_arg(*arg, type)` and writes output
+ * with \ref lwprintf_spec_write or \ref lwprintf_spec_printf
+ *
+ * \param[in]       ctx: Output context of running print call
+ * \param[in]       spec: Specifier character
+ * \param[in,out]   arg: Pointer to variable argument list
+ */
+typedef void (*lwprintf_spec_fn)(lwprintf_spec_ctx_t* ctx, char spec, va_list* arg);
+
+/**
+ * \brief           Width, precision and flags of running custom specifier
+ */
+typedef struct {
+    int width;         /*!< Minimal width, `0` when not set */
+    int precision;     /*!< Precision, `-1` when not set */
+    uint8_t left : 1;  /*!< `-` flag, align to the left */
+    uint8_t zero : 1;  /*!< `0` flag, pad with zeros */
+    uint8_t plus : 1;  /*!< `+` flag */
+    uint8_t space : 1; /*!< ` ` flag */
+    uint8_t alt : 1;   /*!< `#` flag */
+} lwprintf_spec_info_t;
+
+/**
+ * \brief           Registered custom specifier
+ */
+typedef struct {
+    lwprintf_spec_fn fn; /*!< Handler function */
+    char spec;           /*!< Specifier character */
+} lwprintf_spec_t;
+
+#endif /* LWPRINTF_CFG_ENABLE_CUSTOM_SPEC || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_FANOUT || __DOXYGEN__
+
+/**
+ * \brief           Sink of fan-out instance
+ */
+typedef struct {
+    lwprintf_output_block_fn fn; /*!< Block output function of the sink */
+    uint8_t level;               /*!< Minimum level of messages sent to the sink */
+    uint32_t failures;           /*!< Number of messages, that the sink failed to output */
+} lwprintf_sink_t;
+
+#endif /* LWPRINTF_CFG_ENABLE_FANOUT || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_COMPILED_FORMAT || __DOXYGEN__
+
+/**
+ * \brief           Precompiled format string
+ *
+ * Segments are placed in user storage and literal segments point to the original format string,
+ * therefore both must stay valid for as long as compiled format is used
+ */
+typedef struct {
+    const void* ops; /*!< Parsed segments, placed in user storage */
+    size_t ops_cnt;  /*!< Number of segments */
+    size_t size;     /*!< Storage size in units of bytes, required for all segments */
+} lwprintf_compiled_t;
+
+/**
+ * \brief           Calculate storage size for precompiled format with selected number of segments
+ *
+ * Each literal text between specifiers, and each specifier, is one segment.
+ * Result is rounded up to pointer size, that is minimum storage alignment
+ *
+ * \param[in]       n: Number of segments
+ * \return          Storage size in units of bytes
+ */
+#define LWPRINTF_COMPILED_STORAGE_SIZE(n) ((n) * (sizeof(const char*) + sizeof(size_t) + 6 * sizeof(int)))
+
+#endif /* LWPRINTF_CFG_ENABLE_COMPILED_FORMAT || __DOXYGEN__ */
+
 /**
  * \brief           LwPRINTF instance
  */
 typedef struct lwprintf {
     lwprintf_output_fn out_fn; /*!< Output function for direct print operations */
     void* arg;                 /*!< Custom user argument */
+#if LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT || __DOXYGEN__
+    lwprintf_output_block_fn out_block_fn; /*!< Block output function for direct print operations */
+    char* buff;                            /*!< Staging buffer for block output. Set to `NULL` if not used */
+    size_t buff_size;                      /*!< Size of staging buffer in units of bytes */
+    size_t buff_len;                       /*!< Number of characters currently waiting in staging buffer */
+    char* batch_prev_buff;                 /*!< Staging buffer of the instance, replaced during batch */
+    size_t batch_prev_buff_size;           /*!< Size of staging buffer of the instance, replaced during batch */
+    uint8_t batch;                         /*!< Set to `1` during batch, flushing at end of print call is skipped */
+#if LWPRINTF_CFG_ENABLE_BUFF_MODE || __DOXYGEN__
+    uint8_t buff_mode; /*!< Buffering mode of staging buffer, value of \ref lwprintf_buff_mode_t */
+#endif                 /* LWPRINTF_CFG_ENABLE_BUFF_MODE || __DOXYGEN__ */
+#if LWPRINTF_CFG_ENABLE_AUTO_FLUSH || __DOXYGEN__
+    lwprintf_timestamp_fn flush_time_fn; /*!< Timestamp function of auto flush. `NULL` when not used */
+    uint32_t flush_age;                  /*!< Maximum age of staged text, in units of timestamp function */
+    uint32_t flush_stamp;                /*!< Time, when staged text has been first seen */
+    uint8_t flush_stamped;               /*!< Set to `1` when `flush_stamp` is valid for staged text */
+#endif                                   /* LWPRINTF_CFG_ENABLE_AUTO_FLUSH || __DOXYGEN__ */
+#if LWPRINTF_CFG_ENABLE_LOW_POWER || __DOXYGEN__
+    size_t lp_threshold; /*!< Size of kept text, that is sent at the end of print call. `0` when policy is not used */
+    uint8_t lp_level;    /*!< Minimum level of message, that is sent at the end of its print call */
+#endif                   /* LWPRINTF_CFG_ENABLE_LOW_POWER || __DOXYGEN__ */
+#if LWPRINTF_CFG_ENABLE_COALESCE || __DOXYGEN__
+    uint8_t coalesce;                       /*!< Set to `1` when repeated records are coalesced */
+    lwprintf_timestamp_fn coalesce_time_fn; /*!< Timestamp function of report timeout. `NULL` when not used */
+    uint32_t coalesce_timeout;              /*!< Time after first repeat, when report is printed */
+    uint32_t coalesce_stamp;                /*!< Time of first repeat, not reported yet */
+    size_t rec_start;                       /*!< Position of current record in staging buffer */
+    uint8_t rec_split;                      /*!< Set to `1` when part of current record has been sent already */
+    size_t rec_len;                         /*!< Length of previous record, `0` if it cannot be compared */
+    uint32_t rec_hash;                      /*!< Hash of previous record */
+    uint32_t rec_repeat;                    /*!< Number of repeats of previous record, not reported yet */
+#endif                                      /* LWPRINTF_CFG_ENABLE_COALESCE || __DOXYGEN__ */
+#endif                                     /* LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT || __DOXYGEN__ */
+#if LWPRINTF_CFG_ENABLE_DEFERRED || __DOXYGEN__
+    unsigned char* dbuff;    /*!< Ring buffer for deferred messages. Set to `NULL` if not used */
+    size_t dbuff_size;       /*!< Size of ring buffer in units of bytes */
+    volatile size_t dbuff_r; /*!< Read position, modified only by processing function */
+    volatile size_t dbuff_w; /*!< Write position, modified only by deferred print functions */
+#endif                       /* LWPRINTF_CFG_ENABLE_DEFERRED || __DOXYGEN__ */
+#if LWPRINTF_CFG_ENABLE_TOKEN || __DOXYGEN__
+    uint8_t token_mode; /*!< Set to `1` when print functions send tokenized frames instead of text */
+#endif                  /* LWPRINTF_CFG_ENABLE_TOKEN || __DOXYGEN__ */
+#if LWPRINTF_CFG_ENABLE_CBOR || __DOXYGEN__
+    uint8_t cbor_mode; /*!< Set to `1` when print functions send CBOR maps instead of text */
+#endif                 /* LWPRINTF_CFG_ENABLE_CBOR || __DOXYGEN__ */
+#if LWPRINTF_CFG_ENABLE_ASYNC || __DOXYGEN__
+    unsigned char* abuff[LWPRINTF_CFG_ASYNC_PRIO_COUNT];    /*!< Output queue of every lane. `NULL` if not used */
+    size_t abuff_size[LWPRINTF_CFG_ASYNC_PRIO_COUNT];       /*!< Size of output queue in units of bytes */
+    volatile size_t abuff_r[LWPRINTF_CFG_ASYNC_PRIO_COUNT]; /*!< Read position, modified only by the sink */
+    volatile size_t abuff_w[LWPRINTF_CFG_ASYNC_PRIO_COUNT]; /*!< Write position, modified only by print functions */
+#if LWPRINTF_CFG_ASYNC_PRIO_COUNT > 1 || __DOXYGEN__
+    volatile uint8_t aprio_cur;                             /*!< Lane of message handed to the sink */
+    volatile uint8_t aprio_busy;                            /*!< Set to `1` until handed message is released */
+#endif                                                      /* LWPRINTF_CFG_ASYNC_PRIO_COUNT > 1 || __DOXYGEN__ */
+#endif                                                      /* LWPRINTF_CFG_ENABLE_ASYNC || __DOXYGEN__ */
+#if LWPRINTF_CFG_ENABLE_TRY_PRINT || __DOXYGEN__
+    volatile uint32_t dropped; /*!< Number of dropped messages, modified only by non-blocking print functions */
+    uint32_t dropped_reported; /*!< Number of dropped messages already reported, modified with mutex held */
+#endif                         /* LWPRINTF_CFG_ENABLE_TRY_PRINT || __DOXYGEN__ */
+#if LWPRINTF_CFG_ENABLE_RATE_LIMIT || __DOXYGEN__
+    lwprintf_timestamp_fn limit_time_fn; /*!< Timestamp function of rate limit. `NULL` when messages are not limited */
+#endif                                   /* LWPRINTF_CFG_ENABLE_RATE_LIMIT || __DOXYGEN__ */
+#if LWPRINTF_CFG_ENABLE_CUSTOM_SPEC || __DOXYGEN__
+    lwprintf_spec_t specs[LWPRINTF_CFG_CUSTOM_SPEC_COUNT]; /*!< Registered custom specifiers */
+    uint8_t specs_cnt;                                     /*!< Number of registered custom specifiers */
+#endif                                                     /* LWPRINTF_CFG_ENABLE_CUSTOM_SPEC || __DOXYGEN__ */
+#if LWPRINTF_CFG_SUPPORT_THOUSANDS || __DOXYGEN__
+    char thousands_sep; /*!< Separator for thousands grouping with `'` flag, `'\0'` for default `,` */
+#endif                  /* LWPRINTF_CFG_SUPPORT_THOUSANDS || __DOXYGEN__ */
+#if LWPRINTF_CFG_SUPPORT_TYPE_ARRAY || __DOXYGEN__
+    const char* array_sep; /*!< Separator between array elements with `v` flag, `NULL` for default `", "` */
+#endif                     /* LWPRINTF_CFG_SUPPORT_TYPE_ARRAY || __DOXYGEN__ */
+#if LWPRINTF_CFG_ENABLE_LINE_PREFIX || __DOXYGEN__
+    lwprintf_prefix_time_fn prefix_time_fn; /*!< Time function of line prefix. Set to `NULL` when prefix is not used */
+    char prefix[LWPRINTF_LINE_PREFIX_SIZE]; /*!< Last rendered prefix */
+    uint8_t prefix_len;                     /*!< Length of rendered prefix */
+    uint8_t prefix_valid;                   /*!< Set to `1` when digits of last rendered prefix are valid */
+    uint8_t line_start;                     /*!< Set to `1` when next character starts new line */
+    uint32_t prefix_sec;                    /*!< Seconds of last rendered prefix */
+    uint32_t prefix_ms;                     /*!< Milliseconds of last rendered prefix */
+#endif                                      /* LWPRINTF_CFG_ENABLE_LINE_PREFIX || __DOXYGEN__ */
+#if LWPRINTF_CFG_STATS || LWPRINTF_CFG_OS_STATS || __DOXYGEN__
+    lwprintf_timestamp_fn stats_time_fn; /*!< Timestamp function for statistics. Set to `NULL` to only count */
+    lwprintf_stats_t stats;              /*!< Statistics of the instance */
+#endif                                   /* LWPRINTF_CFG_STATS || LWPRINTF_CFG_OS_STATS || __DOXYGEN__ */
 #if LWPRINTF_CFG_OS || __DOXYGEN__
     LWPRINTF_CFG_OS_MUTEX_HANDLE mutex; /*!< OS mutex handle */
-#endif                                  /* LWPRINTF_CFG_OS || __DOXYGEN__ */
+#if LWPRINTF_CFG_ENABLE_ASYNC || __DOXYGEN__
+    LWPRINTF_CFG_OS_MUTEX_HANDLE amutex; /*!< OS mutex handle for asynchronous print functions */
+#endif                                   /* LWPRINTF_CFG_ENABLE_ASYNC || __DOXYGEN__ */
+#if LWPRINTF_CFG_OS_STATS || __DOXYGEN__
+    uint32_t stats_hold_start;           /*!< Timestamp when mutex was acquired */
+    volatile uint32_t stats_depth;       /*!< Recursion depth of mutex, modified only by its owner */
+#endif                                   /* LWPRINTF_CFG_OS_STATS || __DOXYGEN__ */
+#if LWPRINTF_CFG_OS_YIELD_CHUNK > 0 || __DOXYGEN__
+    uint8_t is_emitting;                 /*!< Set to `1` while direct print message is sent, modified with mutex held */
+    volatile uint8_t yield_busy;         /*!< Set to `1` while unfinished message has released the mutex */
+#endif                                   /* LWPRINTF_CFG_OS_YIELD_CHUNK > 0 || __DOXYGEN__ */
+#endif                                   /* LWPRINTF_CFG_OS || __DOXYGEN__ */
+#if LWPRINTF_CFG_ENABLE_FANOUT || __DOXYGEN__
+    lwprintf_sink_t sinks[LWPRINTF_CFG_FANOUT_SINK_COUNT]; /*!< Sinks of fan-out instance */
+    uint8_t sinks_cnt;                                     /*!< Number of added sinks */
+#endif                                                     /* LWPRINTF_CFG_ENABLE_FANOUT || __DOXYGEN__ */
+#if (LWPRINTF_CFG_ENABLE_COMPILED_FORMAT && LWPRINTF_CFG_FORMAT_CACHE_SIZE > 0) || __DOXYGEN__
+    const char* fcache_fmt[LWPRINTF_CFG_FORMAT_CACHE_SIZE]; /*!< Format strings of cache entries, `NULL` if empty */
+    size_t fcache_cnt[LWPRINTF_CFG_FORMAT_CACHE_SIZE];      /*!< Segments of cache entry, `0` if it did not fit */
+    void* fcache_ops[LWPRINTF_CFG_FORMAT_CACHE_SIZE]
+                    [LWPRINTF_COMPILED_STORAGE_SIZE(LWPRINTF_CFG_FORMAT_CACHE_SEGMENTS)
+                     / sizeof(void*)]; /*!< Parsed segments of cache entries */
+#endif /* (LWPRINTF_CFG_ENABLE_COMPILED_FORMAT && LWPRINTF_CFG_FORMAT_CACHE_SIZE > 0) || __DOXYGEN__ */
+#if LWPRINTF_CFG_ENABLE_ASPRINTF || __DOXYGEN__
+    const lwprintf_pool_t* pool; /*!< Memory pool of allocating print functions. Set to `NULL` if not used */
+#endif                           /* LWPRINTF_CFG_ENABLE_ASPRINTF || __DOXYGEN__ */
+#if LWPRINTF_CFG_ENABLE_LOG_LEVEL || __DOXYGEN__
+    uint8_t level; /*!< Minimum level of printed messages */
+#if LWPRINTF_CFG_LOG_MODULE_COUNT > 0 || __DOXYGEN__
+    uint8_t module_levels[LWPRINTF_CFG_LOG_MODULE_COUNT]; /*!< Minimum level of printed messages per module */
+#endif /* LWPRINTF_CFG_LOG_MODULE_COUNT > 0 || __DOXYGEN__ */
+#endif /* LWPRINTF_CFG_ENABLE_LOG_LEVEL || __DOXYGEN__ */
 } lwprintf_t;
 
 uint8_t lwprintf_init_ex(lwprintf_t* lwobj, lwprintf_output_fn out_fn);
+#if LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT || __DOXYGEN__
+uint8_t lwprintf_init_block_ex(lwprintf_t* lwobj, lwprintf_output_block_fn out_block_fn, char* buff, size_t buff_size);
+uint8_t lwprintf_batch_begin_ex(lwprintf_t* const lwobj, char* buff, size_t buff_size);
+uint8_t lwprintf_batch_end_ex(lwprintf_t* const lwobj);
+#if LWPRINTF_CFG_ENABLE_BUFF_MODE || __DOXYGEN__
+uint8_t lwprintf_set_buff_mode_ex(lwprintf_t* const lwobj, lwprintf_buff_mode_t mode);
+uint8_t lwprintf_flush_ex(lwprintf_t* const lwobj);
+#if LWPRINTF_CFG_ENABLE_AUTO_FLUSH || __DOXYGEN__
+uint8_t lwprintf_set_auto_flush_ex(lwprintf_t* const lwobj, lwprintf_timestamp_fn time_fn, uint32_t age);
+uint8_t lwprintf_auto_flush_ex(lwprintf_t* const lwobj);
+#endif /* LWPRINTF_CFG_ENABLE_AUTO_FLUSH || __DOXYGEN__ */
+#if LWPRINTF_CFG_ENABLE_LOW_POWER || __DOXYGEN__
+uint8_t lwprintf_set_low_power_ex(lwprintf_t* const lwobj, size_t threshold, uint8_t level);
+uint8_t lwprintf_idle_flush_ex(lwprintf_t* const lwobj);
+#endif /* LWPRINTF_CFG_ENABLE_LOW_POWER || __DOXYGEN__ */
+#endif /* LWPRINTF_CFG_ENABLE_BUFF_MODE || __DOXYGEN__ */
+#if LWPRINTF_CFG_ENABLE_COALESCE || __DOXYGEN__
+uint8_t lwprintf_set_coalesce_ex(lwprintf_t* const lwobj, uint8_t enable, lwprintf_timestamp_fn time_fn,
+                                 uint32_t timeout);
+uint8_t lwprintf_coalesce_process_ex(lwprintf_t* const lwobj);
+#endif /* LWPRINTF_CFG_ENABLE_COALESCE || __DOXYGEN__ */
+#if LWPRINTF_CFG_ENABLE_FANOUT || __DOXYGEN__
+uint8_t lwprintf_init_fanout_ex(lwprintf_t* lwobj, char* buff, size_t buff_size);
+uint8_t lwprintf_add_sink_ex(lwprintf_t* const lwobj, lwprintf_output_block_fn fn, uint8_t level);
+uint32_t lwprintf_get_sink_failures_ex(lwprintf_t* const lwobj, size_t index);
+#endif /* LWPRINTF_CFG_ENABLE_FANOUT || __DOXYGEN__ */
+#if LWPRINTF_CFG_ENABLE_FANOUT || LWPRINTF_CFG_ENABLE_LOW_POWER || __DOXYGEN__
+int lwprintf_vprintf_level_ex(lwprintf_t* const lwobj, uint8_t level, const char* format, va_list arg);
+int lwprintf_printf_level_ex(lwprintf_t* const lwobj, uint8_t level, const char* format, ...);
+#endif /* LWPRINTF_CFG_ENABLE_FANOUT || LWPRINTF_CFG_ENABLE_LOW_POWER || __DOXYGEN__ */
+#endif /* LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT || __DOXYGEN__ */
 int lwprintf_vprintf_ex(lwprintf_t* const lwobj, const char* format, va_list arg);
 int lwprintf_printf_ex(lwprintf_t* const lwobj, const char* format, ...);
 int lwprintf_vsnprintf_ex(lwprintf_t* const lwobj, char* s, size_t n, const char* format, va_list arg);
 int lwprintf_snprintf_ex(lwprintf_t* const lwobj, char* s, size_t n, const char* format, ...);
+int lwprintf_vmeasure_ex(lwprintf_t* const lwobj, const char* format, va_list arg);
+int lwprintf_measure_ex(lwprintf_t* const lwobj, const char* format, ...);
+#if LWPRINTF_CFG_ENABLE_SCANF || __DOXYGEN__
+int lwprintf_vsscanf_ex(lwprintf_t* const lwobj, const char* str, const char* format, va_list arg);
+int lwprintf_sscanf_ex(lwprintf_t* const lwobj, const char* str, const char* format, ...);
+#endif /* LWPRINTF_CFG_ENABLE_SCANF || __DOXYGEN__ */
+#if LWPRINTF_CFG_ENABLE_IOV || __DOXYGEN__
+uint8_t lwprintf_vformat_iov_ex(lwprintf_t* const lwobj, lwprintf_iov_t* iov, size_t* iov_cnt, char* arena,
+                                size_t arena_size, const char* format, va_list arg);
+uint8_t lwprintf_format_iov_ex(lwprintf_t* const lwobj, lwprintf_iov_t* iov, size_t* iov_cnt, char* arena,
+                               size_t arena_size, const char* format, ...);
+#endif /* LWPRINTF_CFG_ENABLE_IOV || __DOXYGEN__ */
+#if LWPRINTF_CFG_ENABLE_STRBUF || __DOXYGEN__
+void lwprintf_strbuf_init(lwprintf_strbuf_t* sb, void* arena, size_t arena_size, size_t chunk_size);
+void lwprintf_strbuf_init_alloc(lwprintf_strbuf_t* sb, lwprintf_strbuf_alloc_fn alloc_fn,
+                                lwprintf_strbuf_free_fn free_fn, void* arg, size_t chunk_size);
+void lwprintf_strbuf_reset(lwprintf_strbuf_t* sb);
+int lwprintf_strbuf_vappend_ex(lwprintf_t* const lwobj, lwprintf_strbuf_t* sb, const char* format, va_list arg);
+int lwprintf_strbuf_append_ex(lwprintf_t* const lwobj, lwprintf_strbuf_t* sb, const char* format, ...);
+size_t lwprintf_strbuf_flatten(const lwprintf_strbuf_t* sb, char* s_out, size_t n_maxlen);
+const char* lwprintf_strbuf_iterate(const lwprintf_strbuf_t* sb, const lwprintf_strbuf_chunk_t** it, size_t* len);
+#endif /* LWPRINTF_CFG_ENABLE_STRBUF || __DOXYGEN__ */
+#if LWPRINTF_CFG_ENABLE_ASPRINTF || __DOXYGEN__
+void lwprintf_set_pool_ex(lwprintf_t* const lwobj, const lwprintf_pool_t* pool);
+int lwprintf_vasprintf_ex(lwprintf_t* const lwobj, char** s_out, const char* format, va_list arg);
+int lwprintf_asprintf_ex(lwprintf_t* const lwobj, char** s_out, const char* format, ...);
+#endif /* LWPRINTF_CFG_ENABLE_ASPRINTF || __DOXYGEN__ */
+#if LWPRINTF_CFG_ENABLE_RESUMABLE || __DOXYGEN__
+uint8_t lwprintf_vformat_start_ex(lwprintf_t* const lwobj, lwprintf_resume_t* ctx, const char* format, va_list arg);
+size_t lwprintf_format_continue(lwprintf_resume_t* ctx, char* buff, size_t buff_size);
+void lwprintf_format_end(lwprintf_resume_t* ctx);
+#endif /* LWPRINTF_CFG_ENABLE_RESUMABLE || __DOXYGEN__ */
+#if LWPRINTF_CFG_ENABLE_CUSTOM_SPEC || __DOXYGEN__
+uint8_t lwprintf_register_specifier_ex(lwprintf_t* const lwobj, char spec, lwprintf_spec_fn fn);
+void lwprintf_spec_write(lwprintf_spec_ctx_t* ctx, const char* str, size_t len);
+void lwprintf_spec_write_raw(lwprintf_spec_ctx_t* ctx, const char* str, size_t len);
+void lwprintf_spec_get_info(const lwprintf_spec_ctx_t* ctx, lwprintf_spec_info_t* info);
+int lwprintf_spec_vprintf(lwprintf_spec_ctx_t* ctx, const char* format, va_list arg);
+int lwprintf_spec_printf(lwprintf_spec_ctx_t* ctx, const char* format, ...);
+#endif /* LWPRINTF_CFG_ENABLE_CUSTOM_SPEC || __DOXYGEN__ */
+#if LWPRINTF_CFG_SUPPORT_THOUSANDS || __DOXYGEN__
+void lwprintf_set_thousands_sep_ex(lwprintf_t* const lwobj, char sep);
+#endif /* LWPRINTF_CFG_SUPPORT_THOUSANDS || __DOXYGEN__ */
+#if LWPRINTF_CFG_SUPPORT_TYPE_ARRAY || __DOXYGEN__
+void lwprintf_set_array_sep_ex(lwprintf_t* const lwobj, const char* sep);
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ARRAY || __DOXYGEN__ */
+#if LWPRINTF_CFG_ENABLE_LINE_PREFIX || __DOXYGEN__
+uint8_t lwprintf_set_line_prefix_ex(lwprintf_t* const lwobj, lwprintf_prefix_time_fn time_fn, const char* tag);
+#endif /* LWPRINTF_CFG_ENABLE_LINE_PREFIX || __DOXYGEN__ */
+#if LWPRINTF_CFG_ENABLE_LOG_LEVEL || __DOXYGEN__
+void lwprintf_set_level_ex(lwprintf_t* const lwobj, uint8_t level);
+#if LWPRINTF_CFG_LOG_MODULE_COUNT > 0 || __DOXYGEN__
+uint8_t lwprintf_set_module_level_ex(lwprintf_t* const lwobj, size_t module, uint8_t level);
+#endif /* LWPRINTF_CFG_LOG_MODULE_COUNT > 0 || __DOXYGEN__ */
+
+/**
+ * \brief           Default LwPRINTF instance, accessed by level check macros
+ */
+extern lwprintf_t lwprintf_default;
+#endif /* LWPRINTF_CFG_ENABLE_LOG_LEVEL || __DOXYGEN__ */
+#if LWPRINTF_CFG_ENABLE_TRY_PRINT || __DOXYGEN__
+int lwprintf_try_vprintf_ex(lwprintf_t* const lwobj, const char* format, va_list arg);
+int lwprintf_try_printf_ex(lwprintf_t* const lwobj, const char* format, ...);
+#endif /* LWPRINTF_CFG_ENABLE_TRY_PRINT || __DOXYGEN__ */
+#if LWPRINTF_CFG_ENABLE_RATE_LIMIT || __DOXYGEN__
+void lwprintf_set_limit_time_ex(lwprintf_t* const lwobj, lwprintf_timestamp_fn time_fn);
+uint8_t lwprintf_limit_check_ex(lwprintf_t* const lwobj, lwprintf_limit_t* limit, uint32_t burst, uint32_t period);
+int lwprintf_limit_vprintf_ex(lwprintf_t* const lwobj, lwprintf_limit_t* limit, const char* format, va_list arg);
+int lwprintf_limit_printf_ex(lwprintf_t* const lwobj, lwprintf_limit_t* limit, const char* format, ...);
+#endif /* LWPRINTF_CFG_ENABLE_RATE_LIMIT || __DOXYGEN__ */
+#if LWPRINTF_CFG_ENABLE_DEADLINE || __DOXYGEN__
+int lwprintf_vprintf_deadline_ex(lwprintf_t* const lwobj, lwprintf_timestamp_fn time_fn, uint32_t budget,
+                                 const char* format, va_list arg);
+int lwprintf_printf_deadline_ex(lwprintf_t* const lwobj, lwprintf_timestamp_fn time_fn, uint32_t budget,
+                                const char* format, ...);
+#endif /* LWPRINTF_CFG_ENABLE_DEADLINE || __DOXYGEN__ */
 uint8_t lwprintf_protect_ex(lwprintf_t* const lwobj);
 uint8_t lwprintf_unprotect_ex(lwprintf_t* const lwobj);
+#if LWPRINTF_CFG_OS_THREAD_DEFAULT || __DOXYGEN__
+uint8_t lwprintf_set_thread_default(lwprintf_t* lwobj);
+lwprintf_t* lwprintf_get_default(void);
+#endif /* LWPRINTF_CFG_OS_THREAD_DEFAULT || __DOXYGEN__ */
+#if LWPRINTF_CFG_STATS || LWPRINTF_CFG_OS_STATS || __DOXYGEN__
+uint8_t lwprintf_init_stats_ex(lwprintf_t* lwobj, lwprintf_timestamp_fn time_fn);
+uint8_t lwprintf_reset_stats_ex(lwprintf_t* const lwobj);
+uint8_t lwprintf_get_stats_ex(lwprintf_t* const lwobj, lwprintf_stats_t* stats);
+#endif /* LWPRINTF_CFG_STATS || LWPRINTF_CFG_OS_STATS || __DOXYGEN__ */
+#if LWPRINTF_CFG_ENABLE_DEFERRED || __DOXYGEN__
+uint8_t lwprintf_init_deferred_ex(lwprintf_t* lwobj, void* buff, size_t buff_size);
+uint8_t lwprintf_vprintf_deferred_ex(lwprintf_t* const lwobj, const char* format, va_list arg);
+uint8_t lwprintf_printf_deferred_ex(lwprintf_t* const lwobj, const char* format, ...);
+size_t lwprintf_process_deferred_ex(lwprintf_t* const lwobj);
+#endif /* LWPRINTF_CFG_ENABLE_DEFERRED || __DOXYGEN__ */
+#if LWPRINTF_CFG_ENABLE_TOKEN || __DOXYGEN__
+void lwprintf_set_token_mode_ex(lwprintf_t* const lwobj, uint8_t enable);
+#endif /* LWPRINTF_CFG_ENABLE_TOKEN || __DOXYGEN__ */
+#if LWPRINTF_CFG_ENABLE_CBOR || __DOXYGEN__
+void lwprintf_set_cbor_mode_ex(lwprintf_t* const lwobj, uint8_t enable);
+#endif /* LWPRINTF_CFG_ENABLE_CBOR || __DOXYGEN__ */
+#if LWPRINTF_CFG_ENABLE_ASYNC || __DOXYGEN__
+uint8_t lwprintf_init_async_ex(lwprintf_t* lwobj, void* buff, size_t buff_size);
+size_t lwprintf_async_max_len_ex(const lwprintf_t* lwobj);
+uint8_t lwprintf_vprintf_async_ex(lwprintf_t* const lwobj, lwprintf_async_done_fn done_fn, void* done_arg,
+                                  const char* format, va_list arg);
+uint8_t lwprintf_printf_async_ex(lwprintf_t* const lwobj, lwprintf_async_done_fn done_fn, void* done_arg,
+                                 const char* format, ...);
+size_t lwprintf_async_get_block_ex(lwprintf_t* const lwobj, const char** data);
+uint8_t lwprintf_async_release_block_ex(lwprintf_t* const lwobj);
+size_t lwprintf_process_async_ex(lwprintf_t* const lwobj);
+#if LWPRINTF_CFG_ASYNC_PRIO_COUNT > 1 || __DOXYGEN__
+uint8_t lwprintf_init_async_prio_ex(lwprintf_t* lwobj, uint8_t prio, void* buff, size_t buff_size);
+uint8_t lwprintf_vprintf_async_prio_ex(lwprintf_t* const lwobj, uint8_t prio, lwprintf_async_done_fn done_fn,
+                                       void* done_arg, const char* format, va_list arg);
+uint8_t lwprintf_printf_async_prio_ex(lwprintf_t* const lwobj, uint8_t prio, lwprintf_async_done_fn done_fn,
+                                      void* done_arg, const char* format, ...);
+#endif /* LWPRINTF_CFG_ASYNC_PRIO_COUNT > 1 || __DOXYGEN__ */
+#endif /* LWPRINTF_CFG_ENABLE_ASYNC || __DOXYGEN__ */
+#if LWPRINTF_CFG_ENABLE_COMPILED_FORMAT || __DOXYGEN__
+uint8_t lwprintf_compile(const char* format, lwprintf_compiled_t* out, void* storage, size_t size);
+int lwprintf_vprintf_compiled_ex(lwprintf_t* const lwobj, const lwprintf_compiled_t* cformat, va_list arg);
+int lwprintf_printf_compiled_ex(lwprintf_t* const lwobj, const lwprintf_compiled_t* cformat, ...);
+int lwprintf_vsnprintf_compiled_ex(lwprintf_t* const lwobj, char* s, size_t n, const lwprintf_compiled_t* cformat,
+                                   va_list arg);
+int lwprintf_snprintf_compiled_ex(lwprintf_t* const lwobj, char* s, size_t n, const lwprintf_compiled_t* cformat, ...);
+#if LWPRINTF_CFG_FORMAT_CACHE_SIZE > 0 || __DOXYGEN__
+void lwprintf_format_cache_clear_ex(lwprintf_t* const lwobj);
+#endif /* LWPRINTF_CFG_FORMAT_CACHE_SIZE > 0 || __DOXYGEN__ */
+#endif /* LWPRINTF_CFG_ENABLE_COMPILED_FORMAT || __DOXYGEN__ */
+#if LWPRINTF_CFG_ENABLE_PACKED_ARGS || __DOXYGEN__
+int lwprintf_printf_packed_ex(lwprintf_t* const lwobj, const char* format, const void* args);
+int lwprintf_snprintf_packed_ex(lwprintf_t* const lwobj, char* s, size_t n, const char* format, const void* args);
+int lwprintf_write_packed_ex(lwprintf_t* const lwobj, char* s, size_t n, const char* format, const void* args);
+#if LWPRINTF_CFG_ENABLE_COMPILED_FORMAT || __DOXYGEN__
+int lwprintf_printf_compiled_packed_ex(lwprintf_t* const lwobj, const lwprintf_compiled_t* cformat, const void* args);
+int lwprintf_snprintf_compiled_packed_ex(lwprintf_t* const lwobj, char* s, size_t n,
+                                         const lwprintf_compiled_t* cformat, const void* args);
+#endif /* LWPRINTF_CFG_ENABLE_COMPILED_FORMAT || __DOXYGEN__ */
+#endif /* LWPRINTF_CFG_ENABLE_PACKED_ARGS || __DOXYGEN__ */
 
 /* Argument management */
 #define lwprintf_set_arg(lwobj, argval)            (lwobj)->arg = (argval)
@@ -119,6 +724,152 @@ uint8_t lwprintf_unprotect_ex(lwprintf_t* const lwobj);
  */
 #define lwprintf_init(out_fn)                      lwprintf_init_ex(NULL, (out_fn))
 
+/**
+ * \brief           Initialize default LwPRINTF instance with block output function
+ * \param[in]       out_block_fn: Block output function used for print operation
+ * \param[in]       buff: Staging buffer used to collect characters before they are sent to output.
+ *                      Set to `NULL` to disable staging
+ * \param[in]       buff_size: Size of staging buffer in units of bytes
+ * \return          `1` on success, `0` otherwise
+ * \sa              lwprintf_init_block_ex
+ */
+#define lwprintf_init_block(out_block_fn, buff, buff_size)                                                             \
+    lwprintf_init_block_ex(NULL, (out_block_fn), (buff), (buff_size))
+
+#if LWPRINTF_CFG_ENABLE_FANOUT || __DOXYGEN__
+
+/**
+ * \brief           Initialize default LwPRINTF instance as fan-out instance
+ * \param[in]       buff: Staging buffer, every full buffer is sent to all sinks
+ * \param[in]       buff_size: Size of staging buffer in units of bytes
+ * \return          `1` on success, `0` otherwise
+ * \sa              lwprintf_init_fanout_ex
+ */
+#define lwprintf_init_fanout(buff, buff_size) lwprintf_init_fanout_ex(NULL, (buff), (buff_size))
+
+/**
+ * \brief           Add sink to default LwPRINTF instance
+ * \param[in]       fn: Block output function of the sink
+ * \param[in]       level: Minimum level of messages sent to the sink
+ * \return          `1` on success, `0` otherwise
+ * \sa              lwprintf_add_sink_ex
+ */
+#define lwprintf_add_sink(fn, level)          lwprintf_add_sink_ex(NULL, (fn), (level))
+
+#endif /* LWPRINTF_CFG_ENABLE_FANOUT || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_FANOUT || LWPRINTF_CFG_ENABLE_LOW_POWER || __DOXYGEN__
+
+/**
+ * \brief           Print formatted data with level to the sinks of default LwPRINTF instance
+ * \param[in]       level: Level of the message
+ * \param[in]       format: C string that contains the text to be written to output
+ * \param[in]       ...: Optional arguments for format string
+ * \return          The number of characters that would have been written,
+ *                      not counting the terminating null character.
+ * \sa              lwprintf_printf_level_ex
+ */
+#define lwprintf_printf_level(level, format, ...)                                                                      \
+    lwprintf_printf_level_ex(NULL, (level), (format), ##__VA_ARGS__)
+
+#endif /* LWPRINTF_CFG_ENABLE_FANOUT || LWPRINTF_CFG_ENABLE_LOW_POWER || __DOXYGEN__ */
+
+/**
+ * \brief           Start batch of print calls with default LwPRINTF instance
+ * \param[in]       buff: Staging buffer for complete batch. Set to `NULL` to use staging buffer of the instance
+ * \param[in]       buff_size: Size of staging buffer in units of bytes
+ * \return          `1` on success, `0` otherwise
+ * \sa              lwprintf_batch_begin_ex
+ */
+#define lwprintf_batch_begin(buff, buff_size)      lwprintf_batch_begin_ex(NULL, (buff), (buff_size))
+
+/**
+ * \brief           Send collected text of the batch and end it, with default LwPRINTF instance
+ * \return          `1` on success, `0` otherwise
+ * \sa              lwprintf_batch_end_ex
+ */
+#define lwprintf_batch_end()                       lwprintf_batch_end_ex(NULL)
+
+#if LWPRINTF_CFG_ENABLE_BUFF_MODE || __DOXYGEN__
+
+/**
+ * \brief           Set buffering mode of default LwPRINTF instance
+ * \param[in]       mode: Buffering mode, value of \ref lwprintf_buff_mode_t
+ * \return          `1` on success, `0` otherwise
+ * \sa              lwprintf_set_buff_mode_ex
+ */
+#define lwprintf_set_buff_mode(mode)               lwprintf_set_buff_mode_ex(NULL, (mode))
+
+/**
+ * \brief           Send text waiting in staging buffer of default LwPRINTF instance to the output
+ * \return          `1` on success, `0` otherwise
+ * \sa              lwprintf_flush_ex
+ */
+#define lwprintf_flush()                           lwprintf_flush_ex(NULL)
+
+#if LWPRINTF_CFG_ENABLE_AUTO_FLUSH || __DOXYGEN__
+
+/**
+ * \brief           Set maximum age of staged text of default LwPRINTF instance
+ * \param[in]       time_fn: Timestamp function. Set to `NULL` to disable auto flush
+ * \param[in]       age: Maximum age of staged text, in units of timestamp function
+ * \return          `1` on success, `0` otherwise
+ * \sa              lwprintf_set_auto_flush_ex
+ */
+#define lwprintf_set_auto_flush(time_fn, age)      lwprintf_set_auto_flush_ex(NULL, (time_fn), (age))
+
+/**
+ * \brief           Send staged text of default LwPRINTF instance, when it is older than maximum age
+ * \return          `1` when text has been sent to the output, `0` otherwise
+ * \sa              lwprintf_auto_flush_ex
+ */
+#define lwprintf_auto_flush()                      lwprintf_auto_flush_ex(NULL)
+
+#endif /* LWPRINTF_CFG_ENABLE_AUTO_FLUSH || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_LOW_POWER || __DOXYGEN__
+
+/**
+ * \brief           Set low power flush policy of default LwPRINTF instance
+ * \param[in]       threshold: Size of kept text, that is sent at the end of print call. Set to `0` to disable policy
+ * \param[in]       level: Minimum level of message, that is sent at the end of its print call
+ * \return          `1` on success, `0` otherwise
+ * \sa              lwprintf_set_low_power_ex
+ */
+#define lwprintf_set_low_power(threshold, level)   lwprintf_set_low_power_ex(NULL, (threshold), (level))
+
+/**
+ * \brief           Send kept text of default LwPRINTF instance, before the system enters idle
+ * \return          `1` when text has been sent to the output, `0` otherwise
+ * \sa              lwprintf_idle_flush_ex
+ */
+#define lwprintf_idle_flush()                      lwprintf_idle_flush_ex(NULL)
+
+#endif /* LWPRINTF_CFG_ENABLE_LOW_POWER || __DOXYGEN__ */
+
+#endif /* LWPRINTF_CFG_ENABLE_BUFF_MODE || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_COALESCE || __DOXYGEN__
+
+/**
+ * \brief           Enable or disable coalescing of repeated records of default LwPRINTF instance
+ * \param[in]       enable: Set to `1` to coalesce repeated records, `0` to print all of them
+ * \param[in]       time_fn: Timestamp function of report timeout. Set to `NULL` to report only when run ends
+ * \param[in]       timeout: Time after first repeat, when report is printed, in units of timestamp function
+ * \return          `1` on success, `0` otherwise
+ * \sa              lwprintf_set_coalesce_ex
+ */
+#define lwprintf_set_coalesce(enable, time_fn, timeout) lwprintf_set_coalesce_ex(NULL, (enable), (time_fn), (timeout))
+
+/**
+ * \brief           Print report of repeated records of default LwPRINTF instance, when timeout expired
+ * \return          `1` when report has been printed, `0` otherwise
+ * \sa              lwprintf_coalesce_process_ex
+ */
+#define lwprintf_coalesce_process()                     lwprintf_coalesce_process_ex(NULL)
+
+#endif /* LWPRINTF_CFG_ENABLE_COALESCE || __DOXYGEN__ */
+
 /**
  * \brief           Print formatted data from variable argument list to the output with default LwPRINTF instance
  * \param[in]       format: C string that contains the text to be written to output
@@ -179,93 +930,749 @@ uint8_t lwprintf_unprotect_ex(lwprintf_t* const lwobj);
 #define lwprintf_sprintf(s, format, ...)           lwprintf_sprintf_ex(NULL, (s), (format), ##__VA_ARGS__)
 
 /**
- * \brief           Manually enable mutual exclusion
- * \return          `1` if protected, `0` otherwise
+ * \brief           Calculate length of formatted data from variable argument list with default LwPRINTF instance
+ * \param[in]       format: C string that contains a format string that follows the same specifications as format in printf
+ * \param[in]       arg: A value identifying a variable arguments list initialized with `va_start`.
+ *                      `va_list` is a special type defined in `<cstdarg>`.
+ * \return          The number of characters that would have been written, not counting the terminating null character.
  */
-#define lwprintf_protect()                         lwprintf_protect_ex(NULL)
+#define lwprintf_vmeasure(format, arg)             lwprintf_vmeasure_ex(NULL, (format), (arg))
 
 /**
- * \brief           Manually disable mutual exclusion
- * \return          `1` if protected, `0` otherwise
+ * \brief           Calculate length of formatted data with default LwPRINTF instance
+ * \param[in]       format: C string that contains a format string that follows the same specifications as format in printf
+ * \param[in]       ...: Optional arguments for format string
+ * \return          The number of characters that would have been written, not counting the terminating null character.
  */
-#define lwprintf_unprotect()                       lwprintf_unprotect_ex(NULL)
+#define lwprintf_measure(format, ...)              lwprintf_measure_ex(NULL, (format), ##__VA_ARGS__)
 
-#if LWPRINTF_CFG_ENABLE_SHORTNAMES || __DOXYGEN__
+#if LWPRINTF_CFG_ENABLE_SCANF || __DOXYGEN__
 
 /**
- * \copydoc         lwprintf_printf
- * \note            This function is equivalent to \ref lwprintf_printf
- *                      and available only if \ref LWPRINTF_CFG_ENABLE_SHORTNAMES is enabled
+ * \brief           Read formatted data from string, from variable argument list of pointers
+ * \param[in]       str: Input string
+ * \param[in]       format: C string that contains format string, that follows specifications of `sscanf`
+ * \param[in]       arg: A value identifying a variable arguments list initialized with `va_start`.
+ *                      `va_list` is a special type defined in `<cstdarg>`.
+ * \return          Number of assigned arguments, or `-1` when input ends before the first conversion
  */
-#define lwprintf    lwprintf_printf
+#define lwprintf_vsscanf(str, format, arg)         lwprintf_vsscanf_ex(NULL, (str), (format), (arg))
 
 /**
- * \copydoc         lwprintf_vprintf
- * \note            This function is equivalent to \ref lwprintf_vprintf
- *                      and available only if \ref LWPRINTF_CFG_ENABLE_SHORTNAMES is enabled
+ * \brief           Read formatted data from string
+ * \param[in]       str: Input string
+ * \param[in]       format: C string that contains format string, that follows specifications of `sscanf`
+ * \param[in]       ...: Pointers to arguments, that receive parsed values
+ * \return          Number of assigned arguments, or `-1` when input ends before the first conversion
  */
-#define lwvprintf   lwprintf_vprintf
+#define lwprintf_sscanf(str, format, ...)          lwprintf_sscanf_ex(NULL, (str), (format), ##__VA_ARGS__)
 
-/**
- * \copydoc         lwprintf_vsnprintf
- * \note            This function is equivalent to \ref lwprintf_vsnprintf
- *                      and available only if \ref LWPRINTF_CFG_ENABLE_SHORTNAMES is enabled
- */
-#define lwvsnprintf lwprintf_vsnprintf
+#endif /* LWPRINTF_CFG_ENABLE_SCANF || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_IOV || __DOXYGEN__
 
 /**
- * \copydoc         lwprintf_snprintf
- * \note            This function is equivalent to \ref lwprintf_snprintf
- *                      and available only if \ref LWPRINTF_CFG_ENABLE_SHORTNAMES is enabled
+ * \brief           Format data from variable argument list to segments with default LwPRINTF instance
+ * \param[out]      iov: Array of segments to fill
+ * \param[in,out]   iov_cnt: Input is number of segments in the array, output is number of used segments
+ * \param[in]       arena: Scratch buffer for converted numbers
+ * \param[in]       arena_size: Size of scratch buffer in units of bytes
+ * \param[in]       format: C string that contains a format string that follows the same specifications as format in printf
+ * \param[in]       arg: A value identifying a variable arguments list initialized with `va_start`.
+ * \return          `1` on success, `0` if segments or scratch buffer are too small
  */
-#define lwsnprintf  lwprintf_snprintf
+#define lwprintf_vformat_iov(iov, iov_cnt, arena, arena_size, format, arg)                                             \
+    lwprintf_vformat_iov_ex(NULL, (iov), (iov_cnt), (arena), (arena_size), (format), (arg))
 
 /**
- * \copydoc         lwprintf_sprintf
- * \note            This function is equivalent to \ref lwprintf_sprintf
- *                      and available only if \ref LWPRINTF_CFG_ENABLE_SHORTNAMES is enabled
+ * \brief           Format data to segments with default LwPRINTF instance
+ * \param[out]      iov: Array of segments to fill
+ * \param[in,out]   iov_cnt: Input is number of segments in the array, output is number of used segments
+ * \param[in]       arena: Scratch buffer for converted numbers
+ * \param[in]       arena_size: Size of scratch buffer in units of bytes
+ * \param[in]       format: C string that contains a format string that follows the same specifications as format in printf
+ * \param[in]       ...: Optional arguments for format string
+ * \return          `1` on success, `0` if segments or scratch buffer are too small
  */
-#define lwsprintf   lwprintf_sprintf
+#define lwprintf_format_iov(iov, iov_cnt, arena, arena_size, format, ...)                                              \
+    lwprintf_format_iov_ex(NULL, (iov), (iov_cnt), (arena), (arena_size), (format), ##__VA_ARGS__)
 
-#endif /* LWPRINTF_CFG_ENABLE_SHORTNAMES || __DOXYGEN__ */
+#endif /* LWPRINTF_CFG_ENABLE_IOV || __DOXYGEN__ */
 
-#if LWPRINTF_CFG_ENABLE_STD_NAMES || __DOXYGEN__
+#if LWPRINTF_CFG_ENABLE_STRBUF || __DOXYGEN__
 
 /**
- * \copydoc         lwprintf_printf
- * \note            This function is equivalent to \ref lwprintf_printf
- *                      and available only if \ref LWPRINTF_CFG_ENABLE_STD_NAMES is enabled
+ * \brief           Append formatted data from variable argument list to string builder with default LwPRINTF instance
+ * \param[in,out]   sb: String builder
+ * \param[in]       format: C string that contains a format string that follows the same specifications as format in printf
+ * \param[in]       arg: A value identifying a variable arguments list initialized with `va_start`.
+ * \return          The number of characters that would have been appended if memory had been sufficient
  */
-#define printf    lwprintf_printf
+#define lwprintf_strbuf_vappend(sb, format, arg) lwprintf_strbuf_vappend_ex(NULL, (sb), (format), (arg))
 
 /**
- * \copydoc         lwprintf_vprintf
- * \note            This function is equivalent to \ref lwprintf_vprintf
- *                      and available only if \ref LWPRINTF_CFG_ENABLE_STD_NAMES is enabled
+ * \brief           Append formatted data to string builder with default LwPRINTF instance
+ * \param[in,out]   sb: String builder
+ * \param[in]       format: C string that contains a format string that follows the same specifications as format in printf
+ * \param[in]       ...: Optional arguments for format string
+ * \return          The number of characters that would have been appended if memory had been sufficient
  */
-#define vprintf   lwprintf_vprintf
+#define lwprintf_strbuf_append(sb, format, ...)  lwprintf_strbuf_append_ex(NULL, (sb), (format), ##__VA_ARGS__)
+
+#endif /* LWPRINTF_CFG_ENABLE_STRBUF || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_ASPRINTF || __DOXYGEN__
 
 /**
- * \copydoc         lwprintf_vsnprintf
- * \note            This function is equivalent to \ref lwprintf_vsnprintf
- *                      and available only if \ref LWPRINTF_CFG_ENABLE_STD_NAMES is enabled
+ * \brief           Set memory pool of default LwPRINTF instance
+ * \param[in]       pool: Memory pool, that must stay valid while it is set. Set to `NULL` to remove it
  */
-#define vsnprintf lwprintf_vsnprintf
+#define lwprintf_set_pool(pool)                lwprintf_set_pool_ex(NULL, (pool))
 
 /**
- * \copydoc         lwprintf_snprintf
- * \note            This function is equivalent to \ref lwprintf_snprintf
- *                      and available only if \ref LWPRINTF_CFG_ENABLE_STD_NAMES is enabled
+ * \brief           Write formatted data from variable argument list to memory block of exact size,
+ *                  taken from memory pool of default LwPRINTF instance
+ * \param[out]      s_out: Pointer to store address of allocated C-string to. It is set to `NULL` on failure
+ * \param[in]       format: C string that contains a format string that follows the same specifications as format in printf
+ * \param[in]       arg: A value identifying a variable arguments list initialized with `va_start`.
+ *                      `va_list` is a special type defined in `<cstdarg>`.
+ * \return          Length of text, not counting the terminating null character, `-1` on failure
  */
-#define snprintf  lwprintf_snprintf
+#define lwprintf_vasprintf(s_out, format, arg) lwprintf_vasprintf_ex(NULL, (s_out), (format), (arg))
 
 /**
- * \copydoc         lwprintf_sprintf
- * \note            This function is equivalent to \ref lwprintf_sprintf
- *                      and available only if \ref LWPRINTF_CFG_ENABLE_STD_NAMES is enabled
+ * \brief           Write formatted data to memory block of exact size,
+ *                  taken from memory pool of default LwPRINTF instance
+ * \param[out]      s_out: Pointer to store address of allocated C-string to. It is set to `NULL` on failure
+ * \param[in]       format: C string that contains a format string that follows the same specifications as format in printf
+ * \param[in]       ...: Optional arguments for format string
+ * \return          Length of text, not counting the terminating null character, `-1` on failure
+ */
+#define lwprintf_asprintf(s_out, format, ...)  lwprintf_asprintf_ex(NULL, (s_out), (format), ##__VA_ARGS__)
+
+#endif /* LWPRINTF_CFG_ENABLE_ASPRINTF || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_RESUMABLE || __DOXYGEN__
+
+/**
+ * \brief           Start resumable formatting with default LwPRINTF instance
+ * \param[out]      ctx: Resumable formatting state
+ * \param[in]       format: C string that contains a format string that follows the same specifications as format in printf
+ * \param[in]       arg: A value identifying a variable arguments list initialized with `va_start`.
+ * \return          `1` on success, `0` otherwise
+ */
+#define lwprintf_vformat_start(ctx, format, arg) lwprintf_vformat_start_ex(NULL, (ctx), (format), (arg))
+
+#endif /* LWPRINTF_CFG_ENABLE_RESUMABLE || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_CUSTOM_SPEC || __DOXYGEN__
+
+/**
+ * \brief           Register custom specifier handler for default LwPRINTF instance
+ * \param[in]       spec: Specifier character
+ * \param[in]       fn: Handler function. Set to `NULL` to remove the specifier
+ * \return          `1` on success, `0` otherwise
+ */
+#define lwprintf_register_specifier(spec, fn) lwprintf_register_specifier_ex(NULL, (spec), (fn))
+
+#endif /* LWPRINTF_CFG_ENABLE_CUSTOM_SPEC || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_SUPPORT_THOUSANDS || __DOXYGEN__
+
+/**
+ * \brief           Set thousands separator character for default LwPRINTF instance
+ * \param[in]       sep: Separator character, inserted between groups of 3 digits with `'` flag
+ */
+#define lwprintf_set_thousands_sep(sep) lwprintf_set_thousands_sep_ex(NULL, (sep))
+
+#endif /* LWPRINTF_CFG_SUPPORT_THOUSANDS || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_ARRAY || __DOXYGEN__
+
+/**
+ * \brief           Set separator string between array elements for default LwPRINTF instance
+ * \param[in]       sep: Separator string, printed between elements with `v` flag
+ */
+#define lwprintf_set_array_sep(sep) lwprintf_set_array_sep_ex(NULL, (sep))
+
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ARRAY || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_LINE_PREFIX || __DOXYGEN__
+
+/**
+ * \brief           Set line prefix for default LwPRINTF instance
+ * \param[in]       time_fn: Time function. Set to `NULL` to disable prefix
+ * \param[in]       tag: Tag of every line. Set to `NULL` for prefix with timestamp only
+ * \return          `1` on success, `0` otherwise
+ */
+#define lwprintf_set_line_prefix(time_fn, tag) lwprintf_set_line_prefix_ex(NULL, (time_fn), (tag))
+
+#endif /* LWPRINTF_CFG_ENABLE_LINE_PREFIX || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_LOG_LEVEL || __DOXYGEN__
+
+/**
+ * \brief           Get instance for level check, `NULL` selects default instance
+ * \param[in]       lwobj: LwPRINTF instance
+ */
+#if LWPRINTF_CFG_OS_THREAD_DEFAULT
+#define LWPRINTF_LEVEL_LWOBJ(lwobj) ((lwobj) != NULL ? (lwobj) : lwprintf_get_default())
+#else
+#define LWPRINTF_LEVEL_LWOBJ(lwobj) ((lwobj) != NULL ? (lwobj) : &lwprintf_default)
+#endif /* LWPRINTF_CFG_OS_THREAD_DEFAULT */
+
+/**
+ * \brief           Print function of log macros, level is passed to the sinks of fan-out instance
+ *                      and to low power flush policy
+ */
+#if LWPRINTF_CFG_ENABLE_FANOUT || LWPRINTF_CFG_ENABLE_LOW_POWER
+#define LWPRINTF_LOG_PRINTF(lwobj, lvl, format, ...) lwprintf_printf_level_ex((lwobj), (lvl), (format), ##__VA_ARGS__)
+#else /* LWPRINTF_CFG_ENABLE_FANOUT || LWPRINTF_CFG_ENABLE_LOW_POWER */
+#define LWPRINTF_LOG_PRINTF(lwobj, lvl, format, ...) lwprintf_printf_ex((lwobj), (format), ##__VA_ARGS__)
+#endif /* !(LWPRINTF_CFG_ENABLE_FANOUT || LWPRINTF_CFG_ENABLE_LOW_POWER) */
+
+/**
+ * \brief           Check if message with selected level is printed by the instance.
+ * Constant level below \ref LWPRINTF_CFG_LOG_LEVEL_MIN is resolved at compile time
+ * \param[in]       lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       lvl: Level of the message
+ * \return          Non-zero if message is printed, `0` otherwise
+ */
+#define lwprintf_level_enabled_ex(lwobj, lvl)                                                                          \
+    ((lvl) >= LWPRINTF_CFG_LOG_LEVEL_MIN && (lvl) >= LWPRINTF_LEVEL_LWOBJ(lwobj)->level)
+
+/**
+ * \brief           Print formatted data to the output, when level of the message is enabled.
+ * Arguments are not evaluated for disabled level
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       lvl: Level of the message, one of `LWPRINTF_LEVEL_*` values
+ * \param[in]       format: C string that contains the text to be written to output
+ * \param[in]       ...: Optional arguments for format string
+ */
+#define lwprintf_log_ex(lwobj, lvl, format, ...)                                                                       \
+    do {                                                                                                               \
+        if (lwprintf_level_enabled_ex((lwobj), (lvl))) {                                                               \
+            (void)LWPRINTF_LOG_PRINTF((lwobj), (lvl), (format), ##__VA_ARGS__);                                        \
+        }                                                                                                              \
+    } while (0)
+
+/**
+ * \brief           Print formatted data to the output of default LwPRINTF instance, when level of the message is enabled
+ * \param[in]       lvl: Level of the message, one of `LWPRINTF_LEVEL_*` values
+ * \param[in]       format: C string that contains the text to be written to output
+ * \param[in]       ...: Optional arguments for format string
+ */
+#define lwprintf_log(lvl, format, ...) lwprintf_log_ex(NULL, (lvl), (format), ##__VA_ARGS__)
+
+/**
+ * \brief           Set minimum level of printed messages for default LwPRINTF instance
+ * \param[in]       level: Minimum level, use \ref LWPRINTF_LEVEL_NONE to disable all messages
+ */
+#define lwprintf_set_level(level) lwprintf_set_level_ex(NULL, (level))
+
+#if LWPRINTF_CFG_LOG_MODULE_COUNT > 0 || __DOXYGEN__
+
+/**
+ * \brief           Check if message with selected level is printed for the module of the instance
+ * \param[in]       lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       module: Module index, lower than \ref LWPRINTF_CFG_LOG_MODULE_COUNT
+ * \param[in]       lvl: Level of the message
+ * \return          Non-zero if message is printed, `0` otherwise
+ */
+#define lwprintf_module_enabled_ex(lwobj, module, lvl)                                                                 \
+    ((lvl) >= LWPRINTF_CFG_LOG_LEVEL_MIN && (lvl) >= LWPRINTF_LEVEL_LWOBJ(lwobj)->module_levels[(module)])
+
+/**
+ * \brief           Print formatted data to the output, when level of the message is enabled for the module.
+ * Only module level is checked, arguments are not evaluated for disabled level
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       module: Module index, lower than \ref LWPRINTF_CFG_LOG_MODULE_COUNT
+ * \param[in]       lvl: Level of the message, one of `LWPRINTF_LEVEL_*` values
+ * \param[in]       format: C string that contains the text to be written to output
+ * \param[in]       ...: Optional arguments for format string
+ */
+#define lwprintf_log_module_ex(lwobj, module, lvl, format, ...)                                                        \
+    do {                                                                                                               \
+        if (lwprintf_module_enabled_ex((lwobj), (module), (lvl))) {                                                    \
+            (void)LWPRINTF_LOG_PRINTF((lwobj), (lvl), (format), ##__VA_ARGS__);                                        \
+        }                                                                                                              \
+    } while (0)
+
+/**
+ * \brief           Print formatted data to the output of default LwPRINTF instance,
+ * when level of the message is enabled for the module
+ * \param[in]       module: Module index, lower than \ref LWPRINTF_CFG_LOG_MODULE_COUNT
+ * \param[in]       lvl: Level of the message, one of `LWPRINTF_LEVEL_*` values
+ * \param[in]       format: C string that contains the text to be written to output
+ * \param[in]       ...: Optional arguments for format string
+ */
+#define lwprintf_log_module(module, lvl, format, ...)                                                                  \
+    lwprintf_log_module_ex(NULL, (module), (lvl), (format), ##__VA_ARGS__)
+
+/**
+ * \brief           Set minimum level of printed messages for the module of default LwPRINTF instance
+ * \param[in]       module: Module index, lower than \ref LWPRINTF_CFG_LOG_MODULE_COUNT
+ * \param[in]       level: Minimum level, use \ref LWPRINTF_LEVEL_NONE to disable all messages
+ * \return          `1` on success, `0` otherwise
+ */
+#define lwprintf_set_module_level(module, level) lwprintf_set_module_level_ex(NULL, (module), (level))
+
+#endif /* LWPRINTF_CFG_LOG_MODULE_COUNT > 0 || __DOXYGEN__ */
+
+#endif /* LWPRINTF_CFG_ENABLE_LOG_LEVEL || __DOXYGEN__ */
+
+/**
+ * \brief           Manually enable mutual exclusion
+ * \return          `1` if protected, `0` otherwise
+ */
+#define lwprintf_protect()                         lwprintf_protect_ex(NULL)
+
+/**
+ * \brief           Manually disable mutual exclusion
+ * \return          `1` if protected, `0` otherwise
+ */
+#define lwprintf_unprotect()                       lwprintf_unprotect_ex(NULL)
+
+#if LWPRINTF_CFG_ENABLE_COMPILED_FORMAT || __DOXYGEN__
+
+/**
+ * \brief           Print formatted data from variable argument list with precompiled format and default instance
+ * \param[in]       cformat: Precompiled format, created with \ref lwprintf_compile
+ * \param[in]       arg: A value identifying a variable arguments list initialized with `va_start`.
+ *                      `va_list` is a special type defined in `<cstdarg>`.
+ * \return          The number of characters that would have been written,
+ *                      not counting the terminating null character.
+ */
+#define lwprintf_vprintf_compiled(cformat, arg)    lwprintf_vprintf_compiled_ex(NULL, (cformat), (arg))
+
+/**
+ * \brief           Print formatted data with precompiled format and default LwPRINTF instance
+ * \param[in]       cformat: Precompiled format, created with \ref lwprintf_compile
+ * \param[in]       ...: Optional arguments for format string
+ * \return          The number of characters that would have been written,
+ *                      not counting the terminating null character.
+ */
+#define lwprintf_printf_compiled(cformat, ...)     lwprintf_printf_compiled_ex(NULL, (cformat), ##__VA_ARGS__)
+
+/**
+ * \brief           Write formatted data from variable argument list to sized buffer with precompiled format
+ *                  and default LwPRINTF instance
+ * \param[in]       s: Pointer to a buffer where the resulting C-string is stored.
+ *                      The buffer should have a size of at least `n` characters
+ * \param[in]       n: Maximum number of bytes to be used in the buffer.
+ *                      The generated string has a length of at most `n - 1`,
+ *                      leaving space for the additional terminating null character
+ * \param[in]       cformat: Precompiled format, created with \ref lwprintf_compile
+ * \param[in]       arg: A value identifying a variable arguments list initialized with `va_start`.
+ *                      `va_list` is a special type defined in `<cstdarg>`.
+ * \return          The number of characters that would have been written if `n` had been sufficiently large,
+ *                      not counting the terminating null character.
+ */
+#define lwprintf_vsnprintf_compiled(s, n, cformat, arg)                                                                \
+    lwprintf_vsnprintf_compiled_ex(NULL, (s), (n), (cformat), (arg))
+
+/**
+ * \brief           Write formatted data to sized buffer with precompiled format and default LwPRINTF instance
+ * \param[in]       s: Pointer to a buffer where the resulting C-string is stored.
+ *                      The buffer should have a size of at least `n` characters
+ * \param[in]       n: Maximum number of bytes to be used in the buffer.
+ *                      The generated string has a length of at most `n - 1`,
+ *                      leaving space for the additional terminating null character
+ * \param[in]       cformat: Precompiled format, created with \ref lwprintf_compile
+ * \param[in]       ...: Optional arguments for format string
+ * \return          The number of characters that would have been written if `n` had been sufficiently large,
+ *                      not counting the terminating null character.
+ */
+#define lwprintf_snprintf_compiled(s, n, cformat, ...)                                                                 \
+    lwprintf_snprintf_compiled_ex(NULL, (s), (n), (cformat), ##__VA_ARGS__)
+
+#if LWPRINTF_CFG_FORMAT_CACHE_SIZE > 0 || __DOXYGEN__
+
+/**
+ * \brief           Remove all entries from parsed format cache of default LwPRINTF instance
+ * \sa              lwprintf_format_cache_clear_ex
+ */
+#define lwprintf_format_cache_clear()              lwprintf_format_cache_clear_ex(NULL)
+
+#endif /* LWPRINTF_CFG_FORMAT_CACHE_SIZE > 0 || __DOXYGEN__ */
+
+#endif /* LWPRINTF_CFG_ENABLE_COMPILED_FORMAT || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_DEFERRED || __DOXYGEN__
+
+/**
+ * \brief           Set ring buffer for deferred messages of default LwPRINTF instance
+ * \param[in]       buff: Ring buffer memory. Set to `NULL` to disable deferred mode
+ * \param[in]       buff_size: Size of ring buffer in units of bytes
+ * \return          `1` on success, `0` otherwise
+ * \sa              lwprintf_init_deferred_ex
+ */
+#define lwprintf_init_deferred(buff, buff_size)    lwprintf_init_deferred_ex(NULL, (buff), (buff_size))
+
+/**
+ * \brief           Store formatted message from variable argument list for later processing with default instance
+ * \param[in]       format: C string that contains the text to be written to output
+ * \param[in]       arg: A value identifying a variable arguments list initialized with `va_start`.
+ *                      `va_list` is a special type defined in `<cstdarg>`.
+ * \return          `1` if message is stored, `0` otherwise
+ */
+#define lwprintf_vprintf_deferred(format, arg)     lwprintf_vprintf_deferred_ex(NULL, (format), (arg))
+
+/**
+ * \brief           Store formatted message for later processing with default LwPRINTF instance
+ * \param[in]       format: C string that contains the text to be written to output
+ * \param[in]       ...: Optional arguments for format string
+ * \return          `1` if message is stored, `0` otherwise
+ */
+#define lwprintf_printf_deferred(format, ...)      lwprintf_printf_deferred_ex(NULL, (format), ##__VA_ARGS__)
+
+/**
+ * \brief           Format all stored deferred messages to the output of default LwPRINTF instance
+ * \return          Number of processed messages
+ */
+#define lwprintf_process_deferred()                lwprintf_process_deferred_ex(NULL)
+
+#endif /* LWPRINTF_CFG_ENABLE_DEFERRED || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_TOKEN || __DOXYGEN__
+
+/**
+ * \brief           Turn tokenized output mode of default LwPRINTF instance on or off
+ * \param[in]       enable: Set to `1` to send tokenized frames, `0` to send formatted text
+ * \sa              lwprintf_set_token_mode_ex
+ */
+#define lwprintf_set_token_mode(enable)            lwprintf_set_token_mode_ex(NULL, (enable))
+
+#endif /* LWPRINTF_CFG_ENABLE_TOKEN || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_CBOR || __DOXYGEN__
+
+/**
+ * \brief           Turn CBOR output mode of default LwPRINTF instance on or off
+ * \param[in]       enable: Set to `1` to send CBOR maps, `0` to send formatted text
+ * \sa              lwprintf_set_cbor_mode_ex
+ */
+#define lwprintf_set_cbor_mode(enable)             lwprintf_set_cbor_mode_ex(NULL, (enable))
+
+#endif /* LWPRINTF_CFG_ENABLE_CBOR || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_ASYNC || __DOXYGEN__
+
+/**
+ * \brief           Set output queue for asynchronous messages of default LwPRINTF instance
+ * \param[in]       buff: Queue memory. Set to `NULL` to disable asynchronous mode
+ * \param[in]       buff_size: Size of queue in units of bytes
+ * \return          `1` on success, `0` otherwise
+ * \sa              lwprintf_init_async_ex
+ */
+#define lwprintf_init_async(buff, buff_size) lwprintf_init_async_ex(NULL, (buff), (buff_size))
+
+/**
+ * \brief           Get maximum length of message text, that fits to the output queue of default LwPRINTF instance
+ * \return          Maximum text length, or `0` if queue is not set
+ * \sa              lwprintf_async_max_len_ex
+ */
+#define lwprintf_async_max_len()             lwprintf_async_max_len_ex(NULL)
+
+/**
+ * \brief           Format data from variable argument list to output queue of default LwPRINTF instance
+ * \param[in]       done_fn: Completion callback. Set to `NULL` if not used
+ * \param[in]       done_arg: Completion callback argument, or pointer to `uint8_t` flag when callback is `NULL`
+ * \param[in]       format: C string that contains the text to be written to output
+ * \param[in]       arg: A value identifying a variable arguments list initialized with `va_start`.
+ *                      `va_list` is a special type defined in `<cstdarg>`.
+ * \return          `1` if message is queued, `0` otherwise
+ */
+#define lwprintf_vprintf_async(done_fn, done_arg, format, arg)                                                         \
+    lwprintf_vprintf_async_ex(NULL, (done_fn), (done_arg), (format), (arg))
+
+/**
+ * \brief           Format data to output queue of default LwPRINTF instance
+ * \param[in]       done_fn: Completion callback. Set to `NULL` if not used
+ * \param[in]       done_arg: Completion callback argument, or pointer to `uint8_t` flag when callback is `NULL`
+ * \param[in]       format: C string that contains the text to be written to output
+ * \param[in]       ...: Optional arguments for format string
+ * \return          `1` if message is queued, `0` otherwise
+ */
+#define lwprintf_printf_async(done_fn, done_arg, format, ...)                                                          \
+    lwprintf_printf_async_ex(NULL, (done_fn), (done_arg), (format), ##__VA_ARGS__)
+
+/**
+ * \brief           Get text of oldest queued message of default LwPRINTF instance
+ * \param[out]      data: Pointer to output variable to save pointer to message text
+ * \return          Length of message text, or `0` if queue is empty
+ */
+#define lwprintf_async_get_block(data)       lwprintf_async_get_block_ex(NULL, (data))
+
+/**
+ * \brief           Release oldest queued message of default LwPRINTF instance and notify its completion
+ * \return          `1` if message is released, `0` otherwise
+ */
+#define lwprintf_async_release_block()       lwprintf_async_release_block_ex(NULL)
+
+/**
+ * \brief           Send all queued messages to the output of default LwPRINTF instance
+ * \return          Number of sent messages
+ */
+#define lwprintf_process_async()             lwprintf_process_async_ex(NULL)
+
+#if LWPRINTF_CFG_ASYNC_PRIO_COUNT > 1 || __DOXYGEN__
+
+/**
+ * \brief           Set output queue of asynchronous messages with selected priority of default LwPRINTF instance
+ * \param[in]       prio: Priority lane, from `0` to \ref LWPRINTF_CFG_ASYNC_PRIO_COUNT - `1`
+ * \param[in]       buff: Queue memory. Set to `NULL` to disable the lane
+ * \param[in]       buff_size: Size of queue in units of bytes
+ * \return          `1` on success, `0` otherwise
+ * \sa              lwprintf_init_async_prio_ex
+ */
+#define lwprintf_init_async_prio(prio, buff, buff_size) lwprintf_init_async_prio_ex(NULL, (prio), (buff), (buff_size))
+
+/**
+ * \brief           Format data from variable argument list to output queue with selected priority
+ *                  of default LwPRINTF instance
+ * \param[in]       prio: Priority lane, from `0` to \ref LWPRINTF_CFG_ASYNC_PRIO_COUNT - `1`
+ * \param[in]       done_fn: Completion callback. Set to `NULL` if not used
+ * \param[in]       done_arg: Completion callback argument, or pointer to `uint8_t` flag when callback is `NULL`
+ * \param[in]       format: C string that contains the text to be written to output
+ * \param[in]       arg: A value identifying a variable arguments list initialized with `va_start`.
+ *                      `va_list` is a special type defined in `<cstdarg>`.
+ * \return          `1` if message is queued, `0` otherwise
+ */
+#define lwprintf_vprintf_async_prio(prio, done_fn, done_arg, format, arg)                                              \
+    lwprintf_vprintf_async_prio_ex(NULL, (prio), (done_fn), (done_arg), (format), (arg))
+
+/**
+ * \brief           Format data to output queue with selected priority of default LwPRINTF instance
+ * \param[in]       prio: Priority lane, from `0` to \ref LWPRINTF_CFG_ASYNC_PRIO_COUNT - `1`
+ * \param[in]       done_fn: Completion callback. Set to `NULL` if not used
+ * \param[in]       done_arg: Completion callback argument, or pointer to `uint8_t` flag when callback is `NULL`
+ * \param[in]       format: C string that contains the text to be written to output
+ * \param[in]       ...: Optional arguments for format string
+ * \return          `1` if message is queued, `0` otherwise
+ */
+#define lwprintf_printf_async_prio(prio, done_fn, done_arg, format, ...)                                               \
+    lwprintf_printf_async_prio_ex(NULL, (prio), (done_fn), (done_arg), (format), ##__VA_ARGS__)
+
+#endif /* LWPRINTF_CFG_ASYNC_PRIO_COUNT > 1 || __DOXYGEN__ */
+
+#endif /* LWPRINTF_CFG_ENABLE_ASYNC || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_STATS || LWPRINTF_CFG_OS_STATS || __DOXYGEN__
+
+/**
+ * \brief           Reset statistics of default LwPRINTF instance and set timestamp function
+ * \param[in]       time_fn: Timestamp function. Set to `NULL` to only count events
+ * \return          `1` on success, `0` otherwise
+ */
+#define lwprintf_init_stats(time_fn) lwprintf_init_stats_ex(NULL, (time_fn))
+
+/**
+ * \brief           Reset statistics of default LwPRINTF instance, timestamp function is kept
+ * \return          `1` on success, `0` otherwise
+ */
+#define lwprintf_reset_stats()       lwprintf_reset_stats_ex(NULL)
+
+/**
+ * \brief           Get statistics of default LwPRINTF instance
+ * \param[out]      stats: Output variable to save statistics
+ * \return          `1` on success, `0` otherwise
+ */
+#define lwprintf_get_stats(stats)    lwprintf_get_stats_ex(NULL, (stats))
+
+#endif /* LWPRINTF_CFG_STATS || LWPRINTF_CFG_OS_STATS || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_TRY_PRINT || __DOXYGEN__
+
+/**
+ * \brief           Print formatted data from variable argument list to the output of default LwPRINTF instance,
+ *                  without waiting
+ * \param[in]       format: C string that contains the text to be written to output
+ * \param[in]       arg: A value identifying a variable arguments list initialized with `va_start`.
+ * \return          The number of characters written, or \ref LWPRINTF_TRY_BUSY if message has been dropped
+ */
+#define lwprintf_try_vprintf(format, arg) lwprintf_try_vprintf_ex(NULL, (format), (arg))
+
+/**
+ * \brief           Print formatted data to the output of default LwPRINTF instance, without waiting
+ * \param[in]       format: C string that contains the text to be written to output
+ * \param[in]       ...: Optional arguments for format string
+ * \return          The number of characters written, or \ref LWPRINTF_TRY_BUSY if message has been dropped
+ */
+#define lwprintf_try_printf(format, ...)  lwprintf_try_printf_ex(NULL, (format), ##__VA_ARGS__)
+
+#endif /* LWPRINTF_CFG_ENABLE_TRY_PRINT || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_RATE_LIMIT || __DOXYGEN__
+
+/**
+ * \brief           Print formatted data to the output, at most `burst` messages per `period` from this call site.
+ * Messages over the limit are counted only, arguments are not evaluated
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       burst: Number of messages printed at once, after quiet time
+ * \param[in]       period: Time of `burst` messages, in units of timestamp function
+ * \param[in]       format: C string that contains the text to be written to output
+ * \param[in]       ...: Optional arguments for format string
+ */
+#define lwprintf_printf_limited_ex(lwobj, burst, period, format, ...)                                                  \
+    do {                                                                                                               \
+        static lwprintf_limit_t lwprintf_limit_site;                                                                   \
+        if (lwprintf_limit_check_ex((lwobj), &lwprintf_limit_site, (burst), (period))) {                               \
+            (void)lwprintf_limit_printf_ex((lwobj), &lwprintf_limit_site, (format), ##__VA_ARGS__);                    \
+        }                                                                                                              \
+    } while (0)
+
+/**
+ * \brief           Print formatted data to the output of default LwPRINTF instance,
+ *                  at most `burst` messages per `period` from this call site
+ * \param[in]       burst: Number of messages printed at once, after quiet time
+ * \param[in]       period: Time of `burst` messages, in units of timestamp function
+ * \param[in]       format: C string that contains the text to be written to output
+ * \param[in]       ...: Optional arguments for format string
+ */
+#define lwprintf_printf_limited(burst, period, format, ...)                                                            \
+    lwprintf_printf_limited_ex(NULL, (burst), (period), (format), ##__VA_ARGS__)
+
+/**
+ * \brief           Set timestamp function of rate limit for default LwPRINTF instance
+ * \param[in]       time_fn: Timestamp function. Set to `NULL` to print all messages
+ */
+#define lwprintf_set_limit_time(time_fn) lwprintf_set_limit_time_ex(NULL, (time_fn))
+
+#endif /* LWPRINTF_CFG_ENABLE_RATE_LIMIT || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_DEADLINE || __DOXYGEN__
+
+/**
+ * \brief           Print formatted data from variable argument list to the output of default LwPRINTF instance,
+ *                  within time budget
+ * \param[in]       time_fn: Timestamp function
+ * \param[in]       budget: Time budget in units of timestamp function
+ * \param[in]       format: C string that contains the text to be written to output
+ * \param[in]       arg: A value identifying a variable arguments list initialized with `va_start`.
+ * \return          The number of characters written, not counting the mark and the terminating null character
+ */
+#define lwprintf_vprintf_deadline(time_fn, budget, format, arg)                                                        \
+    lwprintf_vprintf_deadline_ex(NULL, (time_fn), (budget), (format), (arg))
+
+/**
+ * \brief           Print formatted data to the output of default LwPRINTF instance, within time budget
+ * \param[in]       time_fn: Timestamp function
+ * \param[in]       budget: Time budget in units of timestamp function
+ * \param[in]       format: C string that contains the text to be written to output
+ * \param[in]       ...: Optional arguments for format string
+ * \return          The number of characters written, not counting the mark and the terminating null character
+ */
+#define lwprintf_printf_deadline(time_fn, budget, format, ...)                                                         \
+    lwprintf_printf_deadline_ex(NULL, (time_fn), (budget), (format), ##__VA_ARGS__)
+
+#endif /* LWPRINTF_CFG_ENABLE_DEADLINE || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_SHORTNAMES || __DOXYGEN__
+
+/**
+ * \copydoc         lwprintf_printf
+ * \note            This function is equivalent to \ref lwprintf_printf
+ *                      and available only if \ref LWPRINTF_CFG_ENABLE_SHORTNAMES is enabled
+ */
+#define lwprintf    lwprintf_printf
+
+/**
+ * \copydoc         lwprintf_vprintf
+ * \note            This function is equivalent to \ref lwprintf_vprintf
+ *                      and available only if \ref LWPRINTF_CFG_ENABLE_SHORTNAMES is enabled
+ */
+#define lwvprintf   lwprintf_vprintf
+
+/**
+ * \copydoc         lwprintf_vsnprintf
+ * \note            This function is equivalent to \ref lwprintf_vsnprintf
+ *                      and available only if \ref LWPRINTF_CFG_ENABLE_SHORTNAMES is enabled
+ */
+#define lwvsnprintf lwprintf_vsnprintf
+
+/**
+ * \copydoc         lwprintf_snprintf
+ * \note            This function is equivalent to \ref lwprintf_snprintf
+ *                      and available only if \ref LWPRINTF_CFG_ENABLE_SHORTNAMES is enabled
+ */
+#define lwsnprintf  lwprintf_snprintf
+
+/**
+ * \copydoc         lwprintf_sprintf
+ * \note            This function is equivalent to \ref lwprintf_sprintf
+ *                      and available only if \ref LWPRINTF_CFG_ENABLE_SHORTNAMES is enabled
+ */
+#define lwsprintf   lwprintf_sprintf
+
+#if LWPRINTF_CFG_ENABLE_SCANF || __DOXYGEN__
+
+/**
+ * \copydoc         lwprintf_sscanf
+ * \note            This function is equivalent to \ref lwprintf_sscanf
+ *                      and available only if \ref LWPRINTF_CFG_ENABLE_SHORTNAMES is enabled
+ */
+#define lwsscanf    lwprintf_sscanf
+
+#endif /* LWPRINTF_CFG_ENABLE_SCANF || __DOXYGEN__ */
+
+#endif /* LWPRINTF_CFG_ENABLE_SHORTNAMES || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_STD_NAMES || __DOXYGEN__
+
+/**
+ * \copydoc         lwprintf_printf
+ * \note            This function is equivalent to \ref lwprintf_printf
+ *                      and available only if \ref LWPRINTF_CFG_ENABLE_STD_NAMES is enabled
+ */
+#define printf    lwprintf_printf
+
+/**
+ * \copydoc         lwprintf_vprintf
+ * \note            This function is equivalent to \ref lwprintf_vprintf
+ *                      and available only if \ref LWPRINTF_CFG_ENABLE_STD_NAMES is enabled
+ */
+#define vprintf   lwprintf_vprintf
+
+/**
+ * \copydoc         lwprintf_vsnprintf
+ * \note            This function is equivalent to \ref lwprintf_vsnprintf
+ *                      and available only if \ref LWPRINTF_CFG_ENABLE_STD_NAMES is enabled
+ */
+#define vsnprintf lwprintf_vsnprintf
+
+/**
+ * \copydoc         lwprintf_snprintf
+ * \note            This function is equivalent to \ref lwprintf_snprintf
+ *                      and available only if \ref LWPRINTF_CFG_ENABLE_STD_NAMES is enabled
+ */
+#define snprintf  lwprintf_snprintf
+
+/**
+ * \copydoc         lwprintf_sprintf
+ * \note            This function is equivalent to \ref lwprintf_sprintf
+ *                      and available only if \ref LWPRINTF_CFG_ENABLE_STD_NAMES is enabled
  */
 #define sprintf   lwprintf_sprintf
 
+#if LWPRINTF_CFG_ENABLE_SCANF || __DOXYGEN__
+
+/**
+ * \copydoc         lwprintf_vsscanf
+ * \note            This function is equivalent to \ref lwprintf_vsscanf
+ *                      and available only if \ref LWPRINTF_CFG_ENABLE_STD_NAMES is enabled
+ */
+#define vsscanf   lwprintf_vsscanf
+
+/**
+ * \copydoc         lwprintf_sscanf
+ * \note            This function is equivalent to \ref lwprintf_sscanf
+ *                      and available only if \ref LWPRINTF_CFG_ENABLE_STD_NAMES is enabled
+ */
+#define sscanf    lwprintf_sscanf
+
+#endif /* LWPRINTF_CFG_ENABLE_SCANF || __DOXYGEN__ */
+
 #endif /* LWPRINTF_CFG_ENABLE_STD_NAMES || __DOXYGEN__ */
 
 /* Debug module */
@@ -276,12 +1683,17 @@ uint8_t lwprintf_unprotect_ex(lwprintf_t* const lwobj);
  *                  Its purpose is to have a debug printout to the defined output,
  *                  which will get disabled for the release build (when NDEBUG is defined).
  * 
- * \note            It calls \ref lwprintf_printf to execute the print
+ * \note            It calls \ref lwprintf_printf to execute the print,
+ *                  with \ref LWPRINTF_LEVEL_DEBUG level when \ref LWPRINTF_CFG_ENABLE_LOG_LEVEL is enabled
  * \note            Defined as empty when \ref NDEBUG is enabled
  * \param[in]       fmt: Format text
  * \param[in]       ...: Optional formatting parameters
  */
+#if LWPRINTF_CFG_ENABLE_LOG_LEVEL
+#define lwprintf_debug(fmt, ...) lwprintf_log(LWPRINTF_LEVEL_DEBUG, (fmt), ##__VA_ARGS__)
+#else /* LWPRINTF_CFG_ENABLE_LOG_LEVEL */
 #define lwprintf_debug(fmt, ...) lwprintf_printf((fmt), ##__VA_ARGS__)
+#endif /* !LWPRINTF_CFG_ENABLE_LOG_LEVEL */
 /**
  * \brief           Conditional debug output
  * 
@@ -299,7 +1711,7 @@ uint8_t lwprintf_unprotect_ex(lwprintf_t* const lwobj);
 #define lwprintf_debug_cond(cond, fmt, ...)                                                                            \
     do {                                                                                                               \
         if ((cond)) {                                                                                                  \
-            lwprintf_debug((fmt), ##__VA_ARGS__)                                                                       \
+            lwprintf_debug((fmt), ##__VA_ARGS__);                                                                      \
         }                                                                                                              \
     } while (0)
 #else
@@ -0,0 +1,2169 @@
+/**
+ * \file            lwprintf.hpp
+ * \brief           Lightweight stdio manager - C++ wrapper
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwPRINTF - Lightweight stdio manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v1.0.6
+ */
+#ifndef LWPRINTF_HDR_HPP
+#define LWPRINTF_HDR_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <tuple>
+#include <utility>
+#include "lwprintf/lwprintf.h"
+#if LWPRINTF_CFG_ENABLE_ASYNC && __has_include(<coroutine>)
+#include <coroutine>
+#define LWPRINTF_CPP_COROUTINE 1
+#endif /* LWPRINTF_CFG_ENABLE_ASYNC && __has_include(<coroutine>) */
+
+#if __cplusplus < 202002L
+#error "LwPRINTF C++ wrapper requires C++20 compiler, to use format string as template parameter"
+#endif /* __cplusplus < 202002L */
+
+namespace Lwprintf {
+
+/**
+ * \brief           Format string, used as template parameter
+ * \tparam          N: Length of string, including `NULL` termination
+ */
+template <size_t N>
+struct FixedString {
+    char str[N]{}; /*!< Format string */
+
+    /**
+     * \brief       Construct format string from string literal
+     * \param[in]   s: String literal
+     */
+    constexpr FixedString(const char (&s)[N]) {
+        for (size_t i = 0; i < N; ++i) {
+            str[i] = s[i];
+        }
+    }
+};
+
+/**
+ * \brief           Output target, that receives formatted text with direct member function calls.
+ *
+ * Text is passed in blocks with `write(data, len)`, `write(ch)` is available for single characters
+ */
+template <typename S>
+concept Sink = requires(S& sink, char ch, const char* data, size_t len) {
+    sink.write(ch);
+    sink.write(data, len);
+};
+
+/**
+ * \brief           Sink with contiguous memory, where text is formatted in place.
+ *
+ * `prepare(len)` returns memory for at least `len` characters and terminating null character,
+ * or all remaining memory if sink cannot grow. `commit(len)` accepts `len` characters written to that memory
+ */
+template <typename S>
+concept ContiguousSink = Sink<S> && requires(S& sink, size_t len) {
+    { sink.prepare(len) } -> std::same_as<std::span<char>>;
+    sink.commit(len);
+};
+
+/**
+ * \brief           Sink writing to user buffer, text is always `NULL` terminated and truncated when buffer is full
+ */
+class SpanSink {
+  public:
+    /**
+     * \brief       Construct sink with empty text
+     * \param[in]   buff: Buffer for text, including terminating null character
+     */
+    explicit SpanSink(std::span<char> buff) : buff_(buff) {
+        if (!buff_.empty()) {
+            buff_[0] = '\0';
+        }
+    }
+
+    void
+    write(char ch) {
+        write(&ch, 1);
+    }
+
+    void
+    write(const char* data, size_t len) {
+        const std::span<char> dst = prepare(len);
+
+        len = std::min(len, dst.empty() ? 0 : dst.size() - 1);
+        std::memcpy(dst.data(), data, len);
+        commit(len);
+    }
+
+    std::span<char>
+    prepare(size_t) {
+        return buff_.subspan(len_);
+    }
+
+    void
+    commit(size_t len) {
+        len_ += len;
+        if (len_ < buff_.size()) {
+            buff_[len_] = '\0';
+        }
+    }
+
+    /**
+     * \brief       Get text written to the buffer
+     * \return      `NULL` terminated text
+     */
+    const char*
+    c_str() const {
+        return buff_.data();
+    }
+
+    /**
+     * \brief       Get length of text written to the buffer
+     * \return      Number of characters, not counting the terminating null character
+     */
+    size_t
+    size() const {
+        return len_;
+    }
+
+  private:
+    std::span<char> buff_; /*!< User buffer */
+    size_t len_{};         /*!< Length of text in the buffer */
+};
+
+namespace detail {
+
+/**
+ * \brief           Storage of \ref StaticSink, constructed before the sink that uses it
+ * \tparam          N: Size of buffer
+ */
+template <size_t N>
+struct StaticStorage {
+    char storage[N]{}; /*!< Buffer for text */
+};
+
+} // namespace detail
+
+/**
+ * \brief           Sink writing to its own statically sized buffer
+ * \tparam          N: Size of buffer, including terminating null character
+ */
+template <size_t N>
+class StaticSink : private detail::StaticStorage<N>, public SpanSink {
+  public:
+    StaticSink() : SpanSink(this->storage) {}
+
+    StaticSink(const StaticSink&) = delete;
+    StaticSink& operator=(const StaticSink&) = delete;
+};
+
+/**
+ * \brief           Sink appending text to `std::string`, that grows as needed
+ */
+class StringSink {
+  public:
+    /**
+     * \brief       Construct sink, text is appended to the existing content
+     * \param[in]   str: String to append text to
+     */
+    explicit StringSink(std::string& str) : str_(str) {}
+
+    void
+    write(char ch) {
+        str_.push_back(ch);
+    }
+
+    void
+    write(const char* data, size_t len) {
+        str_.append(data, len);
+    }
+
+    std::span<char>
+    prepare(size_t len) {
+        if (base_ == std::string::npos) {
+            base_ = str_.size(); /* Memory of not committed prepare call is reused */
+        }
+        str_.resize(base_ + std::max(len, str_.capacity() - base_));
+        return {str_.data() + base_, str_.size() - base_ + 1}; /* Null character is written at the end */
+    }
+
+    void
+    commit(size_t len) {
+        str_.resize(base_ + len);
+        base_ = std::string::npos;
+    }
+
+  private:
+    std::string& str_;               /*!< Target string */
+    size_t base_{std::string::npos}; /*!< Length of string before \ref prepare call, `npos` when not prepared */
+};
+
+/**
+ * \brief           Sink writing to single-producer single-consumer ring buffer,
+ *                  that is drained by the transmitter, such as UART interrupt or DMA.
+ *
+ * Text that does not fit to the free space is dropped and counted
+ */
+class RingSink {
+  public:
+    /**
+     * \brief       Construct sink with empty ring buffer
+     * \param[in]   buff: Ring buffer memory. One byte is always kept free
+     */
+    explicit RingSink(std::span<char> buff) : buff_(buff) {}
+
+    void
+    write(char ch) {
+        write(&ch, 1);
+    }
+
+    void
+    write(const char* data, size_t len) {
+        const size_t w = w_.load(std::memory_order_relaxed);
+        const size_t r = r_.load(std::memory_order_acquire);
+        const size_t free = (r + buff_.size() - w - 1) % buff_.size();
+        const size_t first = std::min(len, buff_.size() - w);
+
+        if (len > free) {
+            dropped_ += len - free;
+            len = free;
+        }
+        if (len == 0) {
+            return;
+        }
+        std::memcpy(&buff_[w], data, std::min(len, first));
+        if (len > first) {
+            std::memcpy(&buff_[0], data + first, len - first);
+        }
+        w_.store((w + len) % buff_.size(), std::memory_order_release);
+    }
+
+    /**
+     * \brief       Get linear block of data waiting for the transmitter
+     * \return      Block of data, empty when there is nothing to send
+     */
+    std::span<const char>
+    get_block() const {
+        const size_t r = r_.load(std::memory_order_relaxed);
+        const size_t w = w_.load(std::memory_order_acquire);
+
+        return {&buff_[r], (w >= r ? w : buff_.size()) - r};
+    }
+
+    /**
+     * \brief       Release data sent by the transmitter
+     * \param[in]   len: Number of bytes from the block returned by \ref get_block
+     */
+    void
+    release(size_t len) {
+        r_.store((r_.load(std::memory_order_relaxed) + len) % buff_.size(), std::memory_order_release);
+    }
+
+    /**
+     * \brief       Get number of bytes dropped, because ring buffer was full
+     * \return      Number of dropped bytes
+     */
+    size_t
+    dropped() const {
+        return dropped_;
+    }
+
+  private:
+    std::span<char> buff_;    /*!< Ring buffer memory */
+    std::atomic<size_t> w_{}; /*!< Write position, modified only by the producer */
+    std::atomic<size_t> r_{}; /*!< Read position, modified only by the transmitter */
+    size_t dropped_{};        /*!< Number of dropped bytes */
+};
+
+/**
+ * \brief           Sink writing to output iterator, such as `std::back_inserter` of container or pointer to buffer.
+ *
+ * Characters after the limit are counted, but not written
+ *
+ * \tparam          It: Output iterator type
+ */
+template <std::output_iterator<char> It>
+class IteratorSink {
+  public:
+    /**
+     * \brief       Construct sink
+     * \param[in]   out: Iterator to write first character to
+     * \param[in]   limit: Maximum number of characters to write
+     */
+    explicit IteratorSink(It out, size_t limit = SIZE_MAX) : out_(std::move(out)), limit_(limit) {}
+
+    void
+    write(char ch) {
+        write(&ch, 1);
+    }
+
+    void
+    write(const char* data, size_t len) {
+        const size_t cnt = std::min(len, limit_ - written_);
+
+        out_ = std::copy_n(data, cnt, std::move(out_));
+        written_ += cnt;
+    }
+
+    /**
+     * \brief       Get iterator past the last written character
+     * \return      Output iterator
+     */
+    It
+    out() const {
+        return out_;
+    }
+
+  private:
+    It out_;           /*!< Output iterator */
+    size_t limit_;     /*!< Maximum number of characters to write */
+    size_t written_{}; /*!< Number of written characters */
+};
+
+/**
+ * \brief           Result of \ref format_to_n
+ * \tparam          It: Output iterator type
+ */
+template <typename It>
+struct FormatToNResult {
+    It out;   /*!< Iterator past the last written character */
+    int size; /*!< The number of characters that would have been written, if `n` had been sufficiently large */
+};
+
+#if LWPRINTF_CFG_ENABLE_CUSTOM_SPEC || __DOXYGEN__
+
+/**
+ * \brief           Output of \ref formatter, that writes text directly to the output of running print call.
+ *
+ * Context is \ref Sink, and nested \ref print_to calls can write to it.
+ * It only counts characters, when text is measured for width of the specifier
+ */
+class FormatContext {
+  public:
+    /**
+     * \brief       Construct context
+     * \param[in]   ctx: Output context of custom specifier. Set to `nullptr` to only count characters
+     * \param[in]   spec: Width, precision and flags of the specifier
+     */
+    FormatContext(lwprintf_spec_ctx_t* ctx, const lwprintf_spec_info_t& spec) : ctx_{ctx}, spec_{spec} {}
+
+    /**
+     * \brief       Write single character
+     * \param[in]   ch: Character to write
+     */
+    void
+    write(char ch) {
+        write(&ch, 1);
+    }
+
+    /**
+     * \brief       Write block of characters
+     * \param[in]   data: Characters to write
+     * \param[in]   len: Number of characters
+     */
+    void
+    write(const char* data, size_t len) {
+        if (ctx_ != nullptr) {
+            lwprintf_spec_write_raw(ctx_, data, len);
+        }
+        size_ += len;
+    }
+
+    /**
+     * \brief       Get width, precision and flags of the specifier.
+     * Width is applied by the wrapper, precision and flags can be used by the formatter
+     * \return      Specifier info
+     */
+    const lwprintf_spec_info_t&
+    spec() const {
+        return spec_;
+    }
+
+    /**
+     * \brief       Get number of characters written by the formatter
+     * \return      Number of characters
+     */
+    size_t
+    size() const {
+        return size_;
+    }
+
+  private:
+    lwprintf_spec_ctx_t* ctx_;         /*!< Output context, `nullptr` when measuring */
+    const lwprintf_spec_info_t& spec_; /*!< Specifier info */
+    size_t size_{};                    /*!< Number of written characters */
+};
+
+/**
+ * \brief           Customization point to print user types.
+ *
+ * Specialization provides `void format(const T& value, FormatContext& ctx)` member function,
+ * that writes text of the value to the context. Text is streamed to the output of running print call,
+ * without temporary buffer, and it is padded to the width of the specifier.
+ *
+ * \tparam          T: User type
+ */
+template <typename T>
+struct formatter;
+
+/**
+ * \brief           Type that can be printed with \ref formatter specialization
+ */
+template <typename T>
+concept Formattable = requires(const std::remove_cvref_t<T>& value, FormatContext& ctx) {
+    formatter<std::remove_cvref_t<T>>{}.format(value, ctx);
+};
+
+#endif /* LWPRINTF_CFG_ENABLE_CUSTOM_SPEC || __DOXYGEN__ */
+
+namespace detail {
+
+#if LWPRINTF_CFG_ENABLE_CUSTOM_SPEC
+
+/**
+ * \brief           Argument for \ref LWPRINTF_CFG_CPP_FORMATTER_SPEC specifier, passed in variable argument list
+ */
+struct FormatterArg {
+    void (*fn)(lwprintf_spec_ctx_t* ctx, const void* obj); /*!< Function to print the object */
+    const void* obj;                                      /*!< Object to print */
+};
+
+/**
+ * \brief           Print object with its \ref formatter, padded to the width of the specifier
+ * \tparam          T: Object type
+ * \param[in]       ctx: Output context of custom specifier
+ * \param[in]       obj: Pointer to object to print
+ */
+template <typename T>
+void
+format_thunk(lwprintf_spec_ctx_t* ctx, const void* obj) {
+    const T& value = *static_cast<const T*>(obj);
+    lwprintf_spec_info_t info;
+    size_t len = 0, width;
+    char fill;
+
+    lwprintf_spec_get_info(ctx, &info);
+    width = info.width > 0 ? static_cast<size_t>(info.width) : 0;
+    fill = info.zero && !info.left ? '0' : ' ';
+    if (width > 0) {
+        /* Measure text first, formatter is called twice only when width is set */
+        FormatContext measure(nullptr, info);
+        formatter<T>{}.format(value, measure);
+        len = measure.size();
+    }
+    for (; !info.left && len < width; ++len) {
+        lwprintf_spec_write_raw(ctx, &fill, 1);
+    }
+
+    FormatContext out(ctx, info);
+    formatter<T>{}.format(value, out);
+    for (; info.left && len < width; ++len) {
+        lwprintf_spec_write_raw(ctx, &fill, 1);
+    }
+}
+
+/**
+ * \brief           Handler of \ref LWPRINTF_CFG_CPP_FORMATTER_SPEC specifier
+ * \param[in]       ctx: Output context
+ * \param[in]       spec: Specifier character
+ * \param[in,out]   arg: Pointer to variable argument list
+ */
+inline void
+formatter_spec(lwprintf_spec_ctx_t* ctx, char spec, va_list* arg) {
+    const FormatterArg farg = va_arg(*arg, FormatterArg);
+
+    static_cast<void>(spec);
+    farg.fn(ctx, farg.obj);
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_CUSTOM_SPEC */
+
+/**
+ * \brief           Type of argument, as it is read by the library
+ */
+enum class ArgType : uint8_t {
+    Int,       /*!< `int`, also used for `*` width and precision */
+    Long,      /*!< `long int` */
+    LongLong,  /*!< `long long int` */
+    UInt,      /*!< `unsigned int` */
+    ULong,     /*!< `unsigned long int` */
+    ULongLong, /*!< `unsigned long long int` */
+    SizeT,     /*!< `size_t` */
+    UIntMax,   /*!< `uintmax_t` */
+    Double,    /*!< `double` */
+    Float,     /*!< `%f`, `%e` and `%g` argument, `double` or \ref lwprintf_packed_float_t in packed buffer */
+    String,    /*!< `const char*` */
+    Pointer,   /*!< Any pointer, read as `uintptr_t` */
+    ByteArray, /*!< `unsigned char*` */
+    Array,     /*!< Pointer to first element of array for `v` flag, read as `const void*` */
+    IntPtr,    /*!< `int*` for number of written characters */
+#if LWPRINTF_CFG_ENABLE_CUSTOM_SPEC
+    Formatter, /*!< Any type with \ref formatter specialization, passed as \ref FormatterArg */
+#endif         /* LWPRINTF_CFG_ENABLE_CUSTOM_SPEC */
+};
+
+/**
+ * \brief           List of arguments expected by the format string
+ * \tparam          N: Maximum number of arguments
+ */
+template <size_t N>
+struct ArgList {
+    ArgType types[N]{};      /*!< Argument types */
+    size_t cnt{};            /*!< Number of arguments */
+    size_t segments_cnt{};   /*!< Number of segments for precompiled format */
+    size_t formatters_cnt{}; /*!< Number of arguments printed with \ref formatter */
+};
+
+/**
+ * \brief           Parse format string at compile time, the same way as library does at runtime
+ * \tparam          Fmt: Format string
+ * \return          List of expected arguments
+ */
+template <FixedString Fmt>
+constexpr auto
+parse() {
+    ArgList<sizeof(Fmt.str)> list{};
+    const char* fmt = Fmt.str;
+
+    while (*fmt != '\0') {
+        if (*fmt != '%' || fmt[1] == '%') {
+            /* Literal text, or escaped percent character */
+            if (*fmt == '%') {
+                fmt += 2;
+            } else {
+                for (; *fmt != '\0' && *fmt != '%'; ++fmt) {}
+            }
+            ++list.segments_cnt;
+            continue;
+        }
+
+        [[maybe_unused]] uint8_t longlong = 0, sz_t = 0, umax_t = 0, array = 0;
+
+        /* Check [flags], [width] and [.precision] */
+        for (++fmt;; ++fmt) {
+#if LWPRINTF_CFG_SUPPORT_TYPE_ARRAY
+            if (*fmt == 'v') {
+                array = 1;
+                continue;
+            }
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ARRAY */
+            if (*fmt != '-' && *fmt != '+' && *fmt != ' ' && *fmt != '0' && *fmt != '\'' && *fmt != '#') {
+                break;
+            }
+        }
+        if (*fmt == '*') {
+            list.types[list.cnt++] = ArgType::Int;
+            ++fmt;
+        } else {
+            for (; *fmt >= '0' && *fmt <= '9'; ++fmt) {}
+        }
+        if (*fmt == '.') {
+            if (*++fmt == '*') {
+                list.types[list.cnt++] = ArgType::Int;
+                ++fmt;
+            } else {
+                for (; *fmt >= '0' && *fmt <= '9'; ++fmt) {}
+            }
+        }
+
+        /* Check [length] */
+        switch (*fmt) {
+            case 'h': fmt += fmt[1] == 'h' ? 2 : 1; break;
+            case 'l':
+                longlong = fmt[1] == 'l' ? 2 : 1;
+                fmt += longlong;
+                break;
+            case 'z':
+                sz_t = 1;
+                ++fmt;
+                break;
+            case 'j':
+                umax_t = 1;
+                ++fmt;
+                break;
+            default: break;
+        }
+
+        /* Check type, array flag takes number of elements and pointer for every type */
+        if (*fmt == '\0') {
+            return list; /* Format string ended inside of specifier */
+        } else if (array) {
+            list.types[list.cnt++] = ArgType::Int;
+            list.types[list.cnt++] = ArgType::Array;
+            ++fmt;
+            ++list.segments_cnt;
+            continue;
+        }
+        switch (*fmt) {
+#if LWPRINTF_CFG_SUPPORT_TYPE_FLOAT_HEX
+            case 'a':
+            case 'A': list.types[list.cnt++] = ArgType::Double; break;
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FLOAT_HEX */
+            case 'c': list.types[list.cnt++] = ArgType::Int; break;
+#if LWPRINTF_CFG_SUPPORT_TYPE_INT
+            case 'd':
+            case 'i':
+                list.types[list.cnt++] = longlong == 2 ? ArgType::LongLong : (longlong ? ArgType::Long : ArgType::Int);
+                break;
+            case 'b':
+            case 'B':
+            case 'o':
+            case 'u':
+            case 'x':
+            case 'X':
+                if (sz_t) {
+                    list.types[list.cnt++] = ArgType::SizeT;
+                } else if (umax_t) {
+                    list.types[list.cnt++] = ArgType::UIntMax;
+                } else if (longlong == 0 || *fmt == 'b' || *fmt == 'B') {
+                    list.types[list.cnt++] = ArgType::UInt; /* Binary is always read as unsigned int */
+                } else {
+                    list.types[list.cnt++] = longlong == 1 ? ArgType::ULong : ArgType::ULongLong;
+                }
+                break;
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_INT */
+#if LWPRINTF_CFG_SUPPORT_TYPE_STRING
+            case 's': list.types[list.cnt++] = ArgType::String; break;
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_STRING */
+#if LWPRINTF_CFG_SUPPORT_TYPE_STRING_ESCAPE
+            case 'J':
+            case 'C': list.types[list.cnt++] = ArgType::String; break;
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_STRING_ESCAPE */
+#if LWPRINTF_CFG_SUPPORT_TYPE_POINTER
+            case 'p': list.types[list.cnt++] = ArgType::Pointer; break;
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_POINTER */
+#if LWPRINTF_CFG_SUPPORT_TYPE_FLOAT
+            case 'f':
+            case 'F':
+#if LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING */
+                list.types[list.cnt++] = ArgType::Float;
+                break;
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FLOAT */
+            case 'n': list.types[list.cnt++] = ArgType::IntPtr; break;
+#if LWPRINTF_CFG_SUPPORT_TYPE_BYTE_ARRAY
+            case 'k':
+            case 'K': list.types[list.cnt++] = ArgType::ByteArray; break;
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_BYTE_ARRAY */
+#if LWPRINTF_CFG_SUPPORT_TYPE_BASE64
+            case 'r': list.types[list.cnt++] = ArgType::ByteArray; break;
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_BASE64 */
+#if LWPRINTF_CFG_SUPPORT_TYPE_HEXDUMP
+            case 'H': list.types[list.cnt++] = ArgType::ByteArray; break;
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_HEXDUMP */
+#if LWPRINTF_CFG_SUPPORT_TYPE_FIXED
+            case 'q':
+                /* Number of fractional bits is part of the specifier */
+                list.types[list.cnt++] = longlong == 2 ? ArgType::LongLong : (longlong ? ArgType::Long : ArgType::Int);
+                for (; fmt[1] >= '0' && fmt[1] <= '9'; ++fmt) {}
+                break;
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FIXED */
+#if LWPRINTF_CFG_SUPPORT_TYPE_SI
+#if LWPRINTF_CFG_SUPPORT_TYPE_FLOAT && LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING && !LWPRINTF_CFG_FLOAT_SHORTEST
+            case 'y': list.types[list.cnt++] = ArgType::Float; break;
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FLOAT && LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING && !LWPRINTF_CFG_FLOAT_SHORTEST */
+            case 'Y':
+                list.types[list.cnt++] = longlong == 2 ? ArgType::LongLong : (longlong ? ArgType::Long : ArgType::Int);
+                break;
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_SI */
+#if LWPRINTF_CFG_ENABLE_CUSTOM_SPEC
+            case LWPRINTF_CFG_CPP_FORMATTER_SPEC:
+                list.types[list.cnt++] = ArgType::Formatter;
+                ++list.formatters_cnt;
+                break;
+#endif /* LWPRINTF_CFG_ENABLE_CUSTOM_SPEC */
+            default: break;
+        }
+        ++fmt;
+        ++list.segments_cnt;
+    }
+    return list;
+}
+
+/**
+ * \brief           Check if argument type can be used for expected type without loss of data
+ * \tparam          Type: Expected type
+ * \tparam          T: Argument type
+ * \return          `true` if argument is valid, `false` otherwise
+ */
+template <ArgType Type, typename T>
+constexpr bool
+is_valid_arg() {
+    using U = std::remove_cvref_t<T>;
+    using D = std::decay_t<T>;
+
+    switch (Type) {
+        case ArgType::Int: return (std::is_integral_v<U> || std::is_enum_v<U>) && sizeof(U) <= sizeof(int);
+        case ArgType::Long: return std::is_integral_v<U> && sizeof(U) <= sizeof(long int);
+        case ArgType::LongLong: return std::is_integral_v<U> && sizeof(U) <= sizeof(long long int);
+        case ArgType::UInt: return std::is_integral_v<U> && sizeof(U) <= sizeof(unsigned int);
+        case ArgType::ULong: return std::is_integral_v<U> && sizeof(U) <= sizeof(unsigned long int);
+        case ArgType::ULongLong: return std::is_integral_v<U> && sizeof(U) <= sizeof(unsigned long long int);
+        case ArgType::SizeT: return std::is_integral_v<U> && sizeof(U) <= sizeof(size_t);
+        case ArgType::UIntMax: return std::is_integral_v<U> && sizeof(U) <= sizeof(uintmax_t);
+        case ArgType::Double: return std::is_floating_point_v<U>;
+        case ArgType::Float: return std::is_floating_point_v<U>;
+        case ArgType::String: return std::is_convertible_v<T, const char*>;
+        case ArgType::Pointer: return std::is_pointer_v<D> || std::is_null_pointer_v<U>;
+        case ArgType::ByteArray: return std::is_convertible_v<T, const unsigned char*>;
+        case ArgType::Array: return std::is_pointer_v<D> && std::is_arithmetic_v<std::remove_pointer_t<D>>;
+        case ArgType::IntPtr: return std::is_convertible_v<T, int*>;
+#if LWPRINTF_CFG_ENABLE_CUSTOM_SPEC
+        case ArgType::Formatter: return Formattable<T>;
+#endif /* LWPRINTF_CFG_ENABLE_CUSTOM_SPEC */
+    }
+    return false;
+}
+
+/**
+ * \brief           Convert argument to exact type, which library reads from variable argument list
+ * \tparam          Type: Expected type
+ * \param[in]       arg: Argument to convert
+ * \return          Converted argument
+ */
+template <ArgType Type, typename T>
+constexpr auto
+convert_arg(T&& arg) {
+    if constexpr (Type == ArgType::Int) {
+        return static_cast<int>(arg);
+    } else if constexpr (Type == ArgType::Long) {
+        return static_cast<long int>(arg);
+    } else if constexpr (Type == ArgType::LongLong) {
+        return static_cast<long long int>(arg);
+    } else if constexpr (Type == ArgType::UInt) {
+        return static_cast<unsigned int>(arg);
+    } else if constexpr (Type == ArgType::ULong) {
+        return static_cast<unsigned long int>(arg);
+    } else if constexpr (Type == ArgType::ULongLong) {
+        return static_cast<unsigned long long int>(arg);
+    } else if constexpr (Type == ArgType::SizeT) {
+        return static_cast<size_t>(arg);
+    } else if constexpr (Type == ArgType::UIntMax) {
+        return static_cast<uintmax_t>(arg);
+    } else if constexpr (Type == ArgType::Double) {
+        return static_cast<double>(arg);
+    } else if constexpr (Type == ArgType::Float) {
+#if LWPRINTF_CFG_ENABLE_PACKED_ARGS
+        return static_cast<lwprintf_packed_float_t>(arg);
+#else  /* LWPRINTF_CFG_ENABLE_PACKED_ARGS */
+        return static_cast<double>(arg);
+#endif /* !LWPRINTF_CFG_ENABLE_PACKED_ARGS */
+    } else if constexpr (Type == ArgType::String) {
+        return static_cast<const char*>(arg);
+    } else if constexpr (Type == ArgType::Pointer) {
+        return reinterpret_cast<uintptr_t>(static_cast<const void*>(arg));
+    } else if constexpr (Type == ArgType::ByteArray) {
+        return static_cast<const unsigned char*>(arg);
+    } else if constexpr (Type == ArgType::Array) {
+        return static_cast<const void*>(arg);
+#if LWPRINTF_CFG_ENABLE_CUSTOM_SPEC
+    } else if constexpr (Type == ArgType::Formatter) {
+        return FormatterArg{&format_thunk<std::remove_cvref_t<T>>, static_cast<const void*>(std::addressof(arg))};
+#endif /* LWPRINTF_CFG_ENABLE_CUSTOM_SPEC */
+    } else {
+        return static_cast<int*>(arg);
+    }
+}
+
+#if LWPRINTF_CFG_ENABLE_COMPILED_FORMAT
+
+/**
+ * \brief           Get format string, compiled only once at first use
+ * \tparam          Fmt: Format string
+ * \return          Pointer to compiled format
+ */
+template <FixedString Fmt>
+const lwprintf_compiled_t*
+compiled() {
+    static constexpr size_t segments_cnt = parse<Fmt>().segments_cnt;
+    static void* storage[(LWPRINTF_COMPILED_STORAGE_SIZE(segments_cnt > 0 ? segments_cnt : 1) + sizeof(void*) - 1)
+                         / sizeof(void*)];
+    static const lwprintf_compiled_t cfmt = [] {
+        lwprintf_compiled_t c{};
+        lwprintf_compile(Fmt.str, &c, storage, sizeof(storage));
+        return c;
+    }();
+    return &cfmt;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_COMPILED_FORMAT */
+
+#if LWPRINTF_CFG_ENABLE_PACKED_ARGS
+
+/**
+ * \brief           Layout of packed arguments buffer
+ * \tparam          N: Maximum number of arguments
+ */
+template <size_t N>
+struct PackedLayout {
+    size_t offsets[N]{}; /*!< Offset of each argument in the buffer */
+    size_t size{};       /*!< Total size of the buffer */
+};
+
+/**
+ * \brief           Get size of argument in packed buffer, the same as size of type returned by \ref convert_arg
+ * \param[in]       type: Argument type
+ * \return          Size of argument in bytes
+ */
+constexpr size_t
+packed_size(ArgType type) {
+    switch (type) {
+        case ArgType::Int: return sizeof(int);
+        case ArgType::Long: return sizeof(long int);
+        case ArgType::LongLong: return sizeof(long long int);
+        case ArgType::UInt: return sizeof(unsigned int);
+        case ArgType::ULong: return sizeof(unsigned long int);
+        case ArgType::ULongLong: return sizeof(unsigned long long int);
+        case ArgType::SizeT: return sizeof(size_t);
+        case ArgType::UIntMax: return sizeof(uintmax_t);
+        case ArgType::Double: return sizeof(double);
+        case ArgType::Float: return sizeof(lwprintf_packed_float_t);
+        case ArgType::String: return sizeof(const char*);
+        case ArgType::Pointer: return sizeof(uintptr_t);
+        case ArgType::ByteArray: return sizeof(const unsigned char*);
+        case ArgType::Array: return sizeof(const void*);
+        case ArgType::IntPtr: return sizeof(int*);
+#if LWPRINTF_CFG_ENABLE_CUSTOM_SPEC
+        case ArgType::Formatter: return 0; /* Never packed, read by the handler from variable argument list */
+#endif                                     /* LWPRINTF_CFG_ENABLE_CUSTOM_SPEC */
+    }
+    return 0;
+}
+
+/**
+ * \brief           Calculate offset of every argument, each aligned to its size, as library reads them
+ * \tparam          Fmt: Format string
+ * \return          Layout of packed arguments buffer
+ */
+template <FixedString Fmt>
+constexpr auto
+packed_layout() {
+    constexpr auto list = parse<Fmt>();
+    PackedLayout<sizeof(Fmt.str)> layout{};
+
+    for (size_t i = 0; i < list.cnt; ++i) {
+        const size_t size = packed_size(list.types[i]);
+
+        layout.size = (layout.size + size - 1) & ~(size - 1);
+        layout.offsets[i] = layout.size;
+        layout.size += size;
+    }
+    return layout;
+}
+
+/**
+ * \brief           Packed arguments buffer, with arguments converted to exact types
+ * \tparam          Fmt: Format string
+ */
+template <FixedString Fmt>
+struct PackedArgs {
+    static constexpr auto layout = packed_layout<Fmt>();                  /*!< Buffer layout */
+    alignas(std::max_align_t) unsigned char data[layout.size > 0 ? layout.size : 1]; /*!< Arguments */
+
+    /**
+     * \brief       Pack arguments to the buffer
+     * \param[in]   args: Arguments for format string
+     */
+    template <size_t... I, typename... Args>
+    PackedArgs(std::index_sequence<I...>, Args&&... args) {
+        [[maybe_unused]] constexpr auto list = parse<Fmt>();
+        (pack<list.types[I]>(layout.offsets[I], std::forward<Args>(args)), ...);
+    }
+
+    /**
+     * \brief       Convert single argument and copy it to its offset
+     * \param[in]   offset: Offset in the buffer
+     * \param[in]   arg: Argument to pack
+     */
+    template <ArgType Type, typename T>
+    void
+    pack(size_t offset, T&& arg) {
+        const auto v = convert_arg<Type>(std::forward<T>(arg));
+        static_assert(sizeof(v) == packed_size(Type), "Packed argument size mismatch");
+        std::memcpy(&data[offset], &v, sizeof(v));
+    }
+};
+
+#endif /* LWPRINTF_CFG_ENABLE_PACKED_ARGS */
+
+/**
+ * \brief           Check arguments against the format string at compile time
+ * \tparam          Fmt: Format string
+ * \tparam          I: Sequence of argument indexes
+ * \tparam          Args: Argument types
+ */
+template <FixedString Fmt, typename... Args, size_t... I>
+constexpr void
+check_args(std::index_sequence<I...>) {
+    constexpr auto list = parse<Fmt>();
+    static_assert(list.cnt == sizeof...(Args), "Number of arguments does not match the format string");
+    if constexpr (list.cnt == sizeof...(Args)) {
+        static_assert((is_valid_arg<list.types[I], Args>() && ...),
+                      "Argument type does not match specifier in the format string");
+    }
+}
+
+/**
+ * \brief           Print formatted data to the output, with arguments converted to exact types
+ * \tparam          Fmt: Format string
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `nullptr` to use default instance
+ * \param[in]       args: Arguments for format string
+ * \return          The number of characters that would have been written,
+ *                      not counting the terminating null character.
+ */
+template <FixedString Fmt, size_t... I, typename... Args>
+int
+print_impl(lwprintf_t* lwobj, std::index_sequence<I...>, Args&&... args) {
+    [[maybe_unused]] constexpr auto list = parse<Fmt>();
+#if LWPRINTF_CFG_ENABLE_PACKED_ARGS
+    if constexpr (list.formatters_cnt == 0) {
+        const PackedArgs<Fmt> pargs(std::index_sequence<I...>{}, std::forward<Args>(args)...);
+#if LWPRINTF_CFG_ENABLE_COMPILED_FORMAT
+        return lwprintf_printf_compiled_packed_ex(lwobj, compiled<Fmt>(), pargs.data);
+#else  /* LWPRINTF_CFG_ENABLE_COMPILED_FORMAT */
+        return lwprintf_printf_packed_ex(lwobj, Fmt.str, pargs.data);
+#endif /* !LWPRINTF_CFG_ENABLE_COMPILED_FORMAT */
+    }
+    /* Formatter handler reads its argument from variable argument list */
+#endif /* LWPRINTF_CFG_ENABLE_PACKED_ARGS */
+#if LWPRINTF_CFG_ENABLE_COMPILED_FORMAT
+    return lwprintf_printf_compiled_ex(lwobj, compiled<Fmt>(),
+                                       convert_arg<list.types[I]>(std::forward<Args>(args))...);
+#else  /* LWPRINTF_CFG_ENABLE_COMPILED_FORMAT */
+    return lwprintf_printf_ex(lwobj, Fmt.str, convert_arg<list.types[I]>(std::forward<Args>(args))...);
+#endif /* !LWPRINTF_CFG_ENABLE_COMPILED_FORMAT */
+}
+
+/**
+ * \brief           Write formatted data to sized buffer, with arguments converted to exact types
+ * \tparam          Fmt: Format string
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `nullptr` to use default instance
+ * \param[in]       s: Pointer to a buffer where the resulting C-string is stored
+ * \param[in]       n: Maximum number of bytes to be used in the buffer
+ * \param[in]       args: Arguments for format string
+ * \return          The number of characters that would have been written if `n` had been sufficiently large,
+ *                      not counting the terminating null character.
+ */
+template <FixedString Fmt, size_t... I, typename... Args>
+int
+snprint_impl(lwprintf_t* lwobj, char* s, size_t n, std::index_sequence<I...>, Args&&... args) {
+    [[maybe_unused]] constexpr auto list = parse<Fmt>();
+#if LWPRINTF_CFG_ENABLE_PACKED_ARGS
+    if constexpr (list.formatters_cnt == 0) {
+        const PackedArgs<Fmt> pargs(std::index_sequence<I...>{}, std::forward<Args>(args)...);
+#if LWPRINTF_CFG_ENABLE_COMPILED_FORMAT
+        return lwprintf_snprintf_compiled_packed_ex(lwobj, s, n, compiled<Fmt>(), pargs.data);
+#else  /* LWPRINTF_CFG_ENABLE_COMPILED_FORMAT */
+        return lwprintf_snprintf_packed_ex(lwobj, s, n, Fmt.str, pargs.data);
+#endif /* !LWPRINTF_CFG_ENABLE_COMPILED_FORMAT */
+    }
+    /* Formatter handler reads its argument from variable argument list */
+#endif /* LWPRINTF_CFG_ENABLE_PACKED_ARGS */
+#if LWPRINTF_CFG_ENABLE_COMPILED_FORMAT
+    return lwprintf_snprintf_compiled_ex(lwobj, s, n, compiled<Fmt>(),
+                                         convert_arg<list.types[I]>(std::forward<Args>(args))...);
+#else  /* LWPRINTF_CFG_ENABLE_COMPILED_FORMAT */
+    return lwprintf_snprintf_ex(lwobj, s, n, Fmt.str, convert_arg<list.types[I]>(std::forward<Args>(args))...);
+#endif /* !LWPRINTF_CFG_ENABLE_COMPILED_FORMAT */
+}
+
+#if LWPRINTF_CFG_ENABLE_RESUMABLE
+
+/**
+ * \brief           Output formatted text to the sink, in parts of \ref LWPRINTF_CFG_CPP_SINK_CHUNK_SIZE size
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `nullptr` to use default instance
+ * \param[in,out]   sink: Sink to write text to
+ * \param[in]       format: Format string
+ * \param[in]       ...: Arguments, converted to exact types
+ * \return          The number of characters written to the sink
+ */
+template <typename S>
+int
+sink_vprint(lwprintf_t* lwobj, S* sink, const char* format, ...) {
+    lwprintf_resume_t ctx;
+    char chunk[LWPRINTF_CFG_CPP_SINK_CHUNK_SIZE];
+    size_t len, total = 0;
+    va_list arg;
+
+    va_start(arg, format);
+    if (lwprintf_vformat_start_ex(lwobj, &ctx, format, arg)) {
+        while ((len = lwprintf_format_continue(&ctx, chunk, sizeof(chunk))) > 0) {
+            sink->write(chunk, len);
+            total += len;
+        }
+    }
+    va_end(arg);
+    return static_cast<int>(total);
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_RESUMABLE */
+
+/**
+ * \brief           Write formatted data to the sink
+ * \tparam          Fmt: Format string
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `nullptr` to use default instance
+ * \param[in,out]   sink: Sink to write text to
+ * \param[in]       args: Arguments for format string
+ * \return          The number of characters that would have been written, if sink had been sufficiently large
+ */
+template <FixedString Fmt, typename S, size_t... I, typename... Args>
+int
+print_to_impl(lwprintf_t* lwobj, S& sink, std::index_sequence<I...> seq, Args&&... args) {
+    if constexpr (ContiguousSink<S>) {
+        /* Format in place, try again only once, when sink can grow to the required size */
+        std::span<char> buff = sink.prepare(0);
+        int len = snprint_impl<Fmt>(lwobj, buff.data(), buff.size(), seq, args...);
+
+        if (len > 0 && static_cast<size_t>(len) >= buff.size()) {
+            const std::span<char> grown = sink.prepare(static_cast<size_t>(len));
+
+            if (grown.size() > buff.size()) {
+                buff = grown;
+                len = snprint_impl<Fmt>(lwobj, buff.data(), buff.size(), seq, args...);
+            }
+        }
+        sink.commit(std::min(static_cast<size_t>(len > 0 ? len : 0), buff.empty() ? 0 : buff.size() - 1));
+        return len;
+    } else {
+#if LWPRINTF_CFG_ENABLE_RESUMABLE
+        constexpr auto list = parse<Fmt>();
+        return sink_vprint(lwobj, &sink, Fmt.str, convert_arg<list.types[I]>(std::forward<Args>(args))...);
+#else  /* LWPRINTF_CFG_ENABLE_RESUMABLE */
+        /* Short text is formatted on stack, longer text again to the buffer of measured size */
+        char chunk[LWPRINTF_CFG_CPP_SINK_CHUNK_SIZE];
+        const int len = snprint_impl<Fmt>(lwobj, chunk, sizeof(chunk), seq, args...);
+
+        if (len > 0 && static_cast<size_t>(len) >= sizeof(chunk)) {
+            const std::unique_ptr<char[]> buff(new char[static_cast<size_t>(len) + 1]);
+
+            snprint_impl<Fmt>(lwobj, buff.get(), static_cast<size_t>(len) + 1, seq, args...);
+            sink.write(buff.get(), static_cast<size_t>(len));
+        } else if (len > 0) {
+            sink.write(chunk, static_cast<size_t>(len));
+        }
+        return len;
+#endif /* !LWPRINTF_CFG_ENABLE_RESUMABLE */
+    }
+}
+
+} // namespace detail
+
+/**
+ * \brief           Print formatted data to the output of the instance
+ *
+ * Format string is parsed and checked against the arguments at compile time.
+ * At runtime, format is compiled only once with \ref lwprintf_compile
+ * when \ref LWPRINTF_CFG_ENABLE_COMPILED_FORMAT is enabled.
+ *
+ * \code{.cpp}
+ * Lwprintf::print<"T=%d.%02u\r\n">(&lwobj, temp_int, temp_dec);
+ * \endcode
+ *
+ * \tparam          Fmt: Format string
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `nullptr` to use default instance
+ * \param[in]       args: Arguments for format string
+ * \return          The number of characters that would have been written,
+ *                      not counting the terminating null character.
+ */
+template <FixedString Fmt, typename... Args>
+int
+print(lwprintf_t* lwobj, Args&&... args) {
+    detail::check_args<Fmt, Args...>(std::index_sequence_for<Args...>{});
+    return detail::print_impl<Fmt>(lwobj, std::index_sequence_for<Args...>{}, std::forward<Args>(args)...);
+}
+
+/**
+ * \brief           Write formatted data to sized buffer
+ *
+ * Format string is parsed and checked against the arguments at compile time
+ *
+ * \tparam          Fmt: Format string
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `nullptr` to use default instance
+ * \param[in]       s: Pointer to a buffer where the resulting C-string is stored.
+ *                      The buffer should have a size of at least `n` characters
+ * \param[in]       n: Maximum number of bytes to be used in the buffer.
+ *                      The generated string has a length of at most `n - 1`,
+ *                      leaving space for the additional terminating null character
+ * \param[in]       args: Arguments for format string
+ * \return          The number of characters that would have been written if `n` had been sufficiently large,
+ *                      not counting the terminating null character.
+ */
+template <FixedString Fmt, typename... Args>
+int
+snprint(lwprintf_t* lwobj, char* s, size_t n, Args&&... args) {
+    detail::check_args<Fmt, Args...>(std::index_sequence_for<Args...>{});
+    return detail::snprint_impl<Fmt>(lwobj, s, n, std::index_sequence_for<Args...>{}, std::forward<Args>(args)...);
+}
+
+/**
+ * \brief           Write formatted data directly to the sink, without output function of the instance
+ *
+ * Text is formatted in place for \ref ContiguousSink, such as \ref SpanSink, \ref StaticSink or \ref StringSink.
+ * Other sinks receive text in blocks of \ref LWPRINTF_CFG_CPP_SINK_CHUNK_SIZE size.
+ * When \ref LWPRINTF_CFG_ENABLE_RESUMABLE is disabled, text longer than one block
+ * is formatted again to heap buffer of measured size and written at once.
+ *
+ * \code{.cpp}
+ * Lwprintf::StaticSink<32> banner;
+ * Lwprintf::print_to<"v%u.%u.%u">(nullptr, banner, major, minor, patch);
+ * \endcode
+ *
+ * \tparam          Fmt: Format string
+ * \param[in,out]   lwobj: LwPRINTF instance, used for its settings. Set to `nullptr` to use default instance
+ * \param[in,out]   sink: Sink to write text to
+ * \param[in]       args: Arguments for format string
+ * \return          The number of characters that would have been written, if sink had been sufficiently large
+ */
+template <FixedString Fmt, Sink S, typename... Args>
+int
+print_to(lwprintf_t* lwobj, S& sink, Args&&... args) {
+    detail::check_args<Fmt, Args...>(std::index_sequence_for<Args...>{});
+    return detail::print_to_impl<Fmt>(lwobj, sink, std::index_sequence_for<Args...>{}, std::forward<Args>(args)...);
+}
+
+/**
+ * \brief           Write formatted data to output iterator
+ *
+ * \code{.cpp}
+ * std::vector<char> frame;
+ * Lwprintf::format_to<"{\"t\":%u}">(nullptr, std::back_inserter(frame), temp);
+ * \endcode
+ *
+ * \tparam          Fmt: Format string
+ * \param[in,out]   lwobj: LwPRINTF instance, used for its settings. Set to `nullptr` to use default instance
+ * \param[in]       out: Iterator to write first character to
+ * \param[in]       args: Arguments for format string
+ * \return          Iterator past the last written character
+ */
+template <FixedString Fmt, std::output_iterator<char> It, typename... Args>
+It
+format_to(lwprintf_t* lwobj, It out, Args&&... args) {
+    IteratorSink<It> sink(std::move(out));
+
+    print_to<Fmt>(lwobj, sink, std::forward<Args>(args)...);
+    return sink.out();
+}
+
+/**
+ * \brief           Write formatted data to output iterator, with at most `n` characters.
+ * Terminating null character is not written
+ *
+ * \tparam          Fmt: Format string
+ * \param[in,out]   lwobj: LwPRINTF instance, used for its settings. Set to `nullptr` to use default instance
+ * \param[in]       out: Iterator to write first character to
+ * \param[in]       n: Maximum number of characters to write
+ * \param[in]       args: Arguments for format string
+ * \return          Iterator past the last written character,
+ *                      and the number of characters that would have been written if `n` had been sufficiently large
+ */
+template <FixedString Fmt, std::output_iterator<char> It, typename... Args>
+FormatToNResult<It>
+format_to_n(lwprintf_t* lwobj, It out, size_t n, Args&&... args) {
+    IteratorSink<It> sink(std::move(out), n);
+    const int size = print_to<Fmt>(lwobj, sink, std::forward<Args>(args)...);
+
+    return {sink.out(), size};
+}
+
+#if LWPRINTF_CFG_ENABLE_CUSTOM_SPEC || __DOXYGEN__
+
+/**
+ * \brief           Register \ref LWPRINTF_CFG_CPP_FORMATTER_SPEC specifier to the instance,
+ * to print arguments with \ref formatter specialization
+ *
+ * \code{.cpp}
+ * Lwprintf::register_formatters(&lwobj);
+ * Lwprintf::print<"addr=%-42T|\r\n">(&lwobj, ipv6_addr);
+ * \endcode
+ *
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `nullptr` to use default instance
+ * \return          `true` on success, `false` otherwise
+ */
+inline bool
+register_formatters(lwprintf_t* lwobj) {
+    return lwprintf_register_specifier_ex(lwobj, LWPRINTF_CFG_CPP_FORMATTER_SPEC, detail::formatter_spec) != 0;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_CUSTOM_SPEC || __DOXYGEN__ */
+
+#if LWPRINTF_CPP_COROUTINE || __DOXYGEN__
+
+/**
+ * \brief           Asynchronous print to output queue of LwPRINTF instance, for C++20 coroutines.
+ *
+ * Coroutine is suspended only when message does not fit to the queue,
+ * and resumed in order of suspension, once the sink releases enough queued messages.
+ * Message longer than \ref lwprintf_async_max_len_ex is never queued and its print is not suspended.
+ *
+ * \note            Waiting coroutines are resumed from the context that releases the message of the printer
+ *                  with \ref lwprintf_async_release_block_ex. Printer and the sink must run in the same thread,
+ *                  such as single event loop. When the queue is drained without messages of the printer,
+ *                  for example it has only messages of C functions, waiting coroutines are resumed with \ref poll
+ */
+class AsyncPrinter {
+  public:
+    /**
+     * \brief       Base of suspended print, kept in waiting list
+     */
+    struct Waiter {
+        Waiter* next{};                 /*!< Next waiting print */
+        std::coroutine_handle<> handle; /*!< Coroutine to resume */
+
+        virtual ~Waiter() = default;
+
+        /**
+         * \brief   Try to put message to the queue
+         * \return  `true` if message is queued, `false` otherwise
+         */
+        virtual bool try_print() = 0;
+
+        /**
+         * \brief   Check if message is not longer than the queue allows
+         * \return  `true` if message fits to the queue, once there is enough free space
+         */
+        virtual bool can_fit() = 0;
+    };
+
+    /**
+     * \brief       Construct printer for the instance
+     * \param[in]   lwobj: LwPRINTF instance, with output queue set by \ref lwprintf_init_async_ex
+     */
+    explicit AsyncPrinter(lwprintf_t& lwobj) : lwobj_(&lwobj) {}
+
+    AsyncPrinter(const AsyncPrinter&) = delete;
+    AsyncPrinter& operator=(const AsyncPrinter&) = delete;
+
+    /**
+     * \brief       Get LwPRINTF instance of the printer
+     * \return      LwPRINTF instance
+     */
+    lwprintf_t*
+    instance() const {
+        return lwobj_;
+    }
+
+    /**
+     * \brief       Completion callback of every queued message, resumes waiting prints while they fit to the queue
+     * \param[in]   lwobj: LwPRINTF instance
+     * \param[in]   arg: Printer
+     */
+    static void
+    done(lwprintf_t* lwobj, void* arg) {
+        LWPRINTF_UNUSED(lwobj);
+        static_cast<AsyncPrinter*>(arg)->poll();
+    }
+
+    /**
+     * \brief       Resume waiting prints while they fit to the queue.
+     * It is called on completion of every message of the printer,
+     * and shall be called by the application, when the sink releases other messages
+     */
+    void
+    poll() {
+        /* Message longer than the queue is resumed with error */
+        while (head_ != nullptr && (head_->try_print() || !head_->can_fit())) {
+            Waiter* w = head_;
+
+            head_ = w->next;
+            if (head_ == nullptr) {
+                tail_ = nullptr;
+            }
+            w->handle.resume();
+        }
+    }
+
+    /**
+     * \brief       Add print to the end of waiting list
+     * \param[in]   w: Suspended print
+     */
+    void
+    push(Waiter* w) {
+        w->next = nullptr;
+        if (tail_ != nullptr) {
+            tail_->next = w;
+        } else {
+            head_ = w;
+        }
+        tail_ = w;
+    }
+
+    /**
+     * \brief       Check if any print is waiting for the queue
+     * \return      `true` if there are waiting prints
+     */
+    bool
+    is_waiting() const {
+        return head_ != nullptr;
+    }
+
+  private:
+    lwprintf_t* lwobj_; /*!< LwPRINTF instance */
+    Waiter* head_{};    /*!< First waiting print, resumed first */
+    Waiter* tail_{};    /*!< Last waiting print */
+};
+
+namespace detail {
+
+/**
+ * \brief           Awaitable asynchronous print, with arguments converted to exact types
+ * \tparam          Fmt: Format string
+ * \tparam          Args: Converted argument types
+ */
+template <FixedString Fmt, typename... Args>
+class AsyncPrint : public AsyncPrinter::Waiter {
+  public:
+    AsyncPrint(AsyncPrinter& printer, Args... args) : printer_(printer), args_(args...) {}
+
+    bool
+    try_print() override {
+        queued_ = std::apply(
+            [this](auto... a) {
+                return lwprintf_printf_async_ex(printer_.instance(), AsyncPrinter::done, &printer_, Fmt.str, a...)
+                       != 0;
+            },
+            args_);
+        return queued_;
+    }
+
+    bool
+    can_fit() override {
+        const int len = std::apply(
+            [this](auto... a) { return lwprintf_snprintf_ex(printer_.instance(), nullptr, 0, Fmt.str, a...); },
+            args_);
+        return len >= 0 && static_cast<size_t>(len) <= lwprintf_async_max_len_ex(printer_.instance());
+    }
+
+    bool
+    await_ready() {
+        /* Keep order with already waiting prints */
+        return !printer_.is_waiting() && (try_print() || !can_fit());
+    }
+
+    bool
+    await_suspend(std::coroutine_handle<> h) {
+        handle = h;
+        printer_.push(this);
+        return true;
+    }
+
+    /**
+     * \brief       Get result of the print
+     * \return      `true` if message is queued, `false` if it is longer than the queue allows
+     */
+    bool
+    await_resume() const {
+        return queued_;
+    }
+
+  private:
+    AsyncPrinter& printer_;    /*!< Printer */
+    std::tuple<Args...> args_; /*!< Converted arguments */
+    bool queued_{};            /*!< Set to `true` when message is queued */
+};
+
+/**
+ * \brief           Create awaitable asynchronous print, with arguments converted to exact types
+ * \tparam          Fmt: Format string
+ * \param[in]       printer: Asynchronous printer
+ * \param[in]       args: Arguments for format string
+ * \return          Awaitable print
+ */
+template <FixedString Fmt, size_t... I, typename... Args>
+auto
+async_print_impl(AsyncPrinter& printer, std::index_sequence<I...>, Args&&... args) {
+    constexpr auto list = parse<Fmt>();
+    return AsyncPrint<Fmt, decltype(convert_arg<list.types[I]>(std::forward<Args>(args)))...>(
+        printer, convert_arg<list.types[I]>(std::forward<Args>(args))...);
+}
+
+} // namespace detail
+
+/**
+ * \brief           Print formatted data to output queue, suspending coroutine while the queue is full
+ *
+ * Text is formatted to the queue, set with \ref lwprintf_init_async_ex, as soon as it fits.
+ * Result of `co_await` is `true` when message is queued,
+ * or `false` when message is longer than \ref lwprintf_async_max_len_ex.
+ *
+ * \code{.cpp}
+ * co_await Lwprintf::async_print<"conn %u: %s\r\n">(printer, id, state);
+ * \endcode
+ *
+ * \tparam          Fmt: Format string
+ * \param[in]       printer: Asynchronous printer
+ * \param[in]       args: Arguments for format string. Strings must stay valid until print is resumed
+ * \return          Awaitable print
+ */
+template <FixedString Fmt, typename... Args>
+auto
+async_print(AsyncPrinter& printer, Args&&... args) {
+    detail::check_args<Fmt, Args...>(std::index_sequence_for<Args...>{});
+    return detail::async_print_impl<Fmt>(printer, std::index_sequence_for<Args...>{}, std::forward<Args>(args)...);
+}
+
+#endif /* LWPRINTF_CPP_COROUTINE || __DOXYGEN__ */
+
+namespace ct {
+
+/**
+ * \brief           Output of constant expression formatting, only counts characters when buffer is not set
+ */
+struct Writer {
+    char* buff{}; /*!< Output buffer, `nullptr` to only count characters */
+    size_t len{}; /*!< Number of characters */
+
+    constexpr void
+    put(char ch) {
+        if (buff != nullptr) {
+            buff[len] = ch;
+        }
+        ++len;
+    }
+
+    constexpr void
+    put(char ch, size_t cnt) {
+        for (; cnt > 0; --cnt) {
+            put(ch);
+        }
+    }
+};
+
+/**
+ * \brief           Parsed format specifier
+ */
+struct Spec {
+    bool left{};    /*!< `-` flag, align to the left */
+    bool plus{};    /*!< `+` flag, print sign for positive numbers */
+    bool space{};   /*!< ` ` flag, print space for positive numbers */
+    bool zero{};    /*!< `0` flag, pad numbers with zeros */
+    bool alt{};     /*!< `#` flag, print prefix of base */
+    size_t width{};       /*!< Minimal width */
+    int prec{-1};         /*!< Precision, `-1` when not set */
+    uint8_t char_short{}; /*!< `1` for `h` and `2` for `hh` length modifier, other modifiers follow value type */
+    char type{};          /*!< Conversion type */
+};
+
+/**
+ * \brief           Output prefix and text, padded to the width of the specifier
+ * \param[in,out]   w: Writer
+ * \param[in]       spec: Format specifier
+ * \param[in]       prefix: Sign and base prefix, placed before zero padding
+ * \param[in]       text: Text to output
+ * \param[in]       len: Length of text
+ */
+constexpr void
+put_padded(Writer& w, const Spec& spec, const char* prefix, const char* text, size_t len) {
+    size_t prefix_len = 0, pad;
+
+    for (; prefix[prefix_len] != '\0'; ++prefix_len) {}
+    pad = spec.width > prefix_len + len ? spec.width - prefix_len - len : 0;
+    if (!spec.left && !spec.zero) {
+        w.put(' ', pad);
+    }
+    for (size_t i = 0; i < prefix_len; ++i) {
+        w.put(prefix[i]);
+    }
+    if (!spec.left && spec.zero) {
+        w.put('0', pad);
+    }
+    for (size_t i = 0; i < len; ++i) {
+        w.put(text[i]);
+    }
+    if (spec.left) {
+        w.put(' ', pad);
+    }
+}
+
+/**
+ * \brief           Get sign prefix for the number
+ * \param[in]       spec: Format specifier
+ * \param[in]       neg: Set to `true` for negative number
+ * \return          Sign prefix
+ */
+constexpr const char*
+sign_prefix(const Spec& spec, bool neg) {
+    return neg ? "-" : (spec.plus ? "+" : (spec.space ? " " : ""));
+}
+
+/**
+ * \brief           Convert integer number, in the same way as the library does it at runtime
+ * \param[in,out]   w: Writer
+ * \param[in]       spec: Format specifier, with type `d`, `i`, `u`, `x`, `X`, `o`, `b` or `B`
+ * \param[in]       num: Absolute value of the number
+ * \param[in]       neg: Set to `true` for negative number
+ */
+constexpr void
+format_int(Writer& w, const Spec& spec, unsigned long long num, bool neg) {
+    const char* digits = spec.type == 'X' || spec.type == 'B' ? "0123456789ABCDEF" : "0123456789abcdef";
+    const unsigned base = spec.type == 'x' || spec.type == 'X' ? 16
+                          : spec.type == 'o'                   ? 8
+                          : spec.type == 'b' || spec.type == 'B' ? 2
+                                                                 : 10;
+    const char* prefix = sign_prefix(spec, neg);
+    char buff[sizeof(num) * 8]{};
+    size_t pos = sizeof(buff);
+
+    do {
+        buff[--pos] = digits[num % base];
+        num /= base;
+    } while (num > 0);
+    if (spec.alt && base != 10 && !(pos == sizeof(buff) - 1 && buff[pos] == '0')) {
+        prefix = base == 16 ? (spec.type == 'X' ? "0X" : "0x") : (base == 8 ? "0" : (spec.type == 'B' ? "0B" : "0b"));
+    }
+    put_padded(w, spec, prefix, &buff[pos], sizeof(buff) - pos);
+}
+
+/**
+ * \brief           Convert integer part of floating point number, that does not fit to `unsigned long long` type
+ * \param[out]      buff: Output buffer, digits are written backwards
+ * \param[in]       pos: Position after the last digit
+ * \param[in]       num: Integer number, not less than `2^64`
+ * \return          Position of the first digit
+ */
+constexpr size_t
+format_big_int(char* buff, size_t pos, double num) {
+    uint32_t limbs[36]{}; /* Base `10^9`, least significant first, for `309` digits of the largest number */
+    size_t cnt = 2;
+    int exp = 0;
+
+    /* Number is exact integer mantissa below `2^53`, multiplied by power of two */
+    for (; num >= 9007199254740992.0; num /= 2) {
+        ++exp;
+    }
+    limbs[0] = static_cast<uint32_t>(static_cast<unsigned long long>(num) % 1000000000);
+    limbs[1] = static_cast<uint32_t>(static_cast<unsigned long long>(num) / 1000000000);
+    for (; exp > 0; --exp) {
+        uint32_t carry = 0;
+
+        for (size_t i = 0; i < cnt; ++i) {
+            const uint64_t v = static_cast<uint64_t>(limbs[i]) * 2 + carry;
+
+            limbs[i] = static_cast<uint32_t>(v % 1000000000);
+            carry = static_cast<uint32_t>(v / 1000000000);
+        }
+        if (carry > 0) {
+            limbs[cnt++] = carry;
+        }
+    }
+    for (size_t i = 0; i < cnt; ++i) {
+        uint32_t v = limbs[i];
+
+        /* Lower limbs have all 9 digits, the top one has no leading zeros */
+        for (int d = 0; d < 9 && (v > 0 || i + 1 < cnt); ++d) {
+            buff[--pos] = static_cast<char>('0' + v % 10);
+            v /= 10;
+        }
+    }
+    return pos;
+}
+
+/**
+ * \brief           Convert floating point number with fixed number of decimal digits
+ *
+ * Precision is limited to `18` digits
+ *
+ * \param[in,out]   w: Writer
+ * \param[in]       spec: Format specifier, with type `f` or `F`
+ * \param[in]       num: Number to convert
+ */
+constexpr void
+format_fixed(Writer& w, const Spec& spec, double num) {
+    const bool neg = (std::bit_cast<uint64_t>(num) >> 63) != 0; /* Sign is kept also for negative zero */
+    const int prec = spec.prec < 0 ? 6 : (spec.prec > 18 ? 18 : spec.prec);
+    unsigned long long pow10 = 1, ipart, dpart;
+    char buff[309 + 1 + 18]{};
+    size_t pos = sizeof(buff);
+    Spec nspec = spec;
+
+    if (num != num || num > std::numeric_limits<double>::max() || num < -std::numeric_limits<double>::max()) {
+        const bool nan = num != num;
+        const bool upper = spec.type == 'F';
+
+        nspec.zero = false;
+        put_padded(w, nspec, nan ? "" : sign_prefix(spec, neg), nan ? (upper ? "NAN" : "nan") : (upper ? "INF" : "inf"),
+                   3);
+        return;
+    }
+    num = neg ? -num : num;
+    if (num >= 18446744073709551616.0) {
+        /* Number above `2^53` has no fraction */
+        for (int i = 0; i < prec; ++i) {
+            buff[--pos] = '0';
+        }
+        if (prec > 0 || spec.alt) {
+            buff[--pos] = '.';
+        }
+        pos = format_big_int(buff, pos, num);
+        put_padded(w, spec, sign_prefix(spec, neg), &buff[pos], sizeof(buff) - pos);
+        return;
+    }
+    for (int i = 0; i < prec; ++i) {
+        pow10 *= 10;
+    }
+    ipart = static_cast<unsigned long long>(num);
+    dpart = static_cast<unsigned long long>((num - static_cast<double>(ipart)) * static_cast<double>(pow10) + 0.5);
+    if (dpart >= pow10) {
+        dpart -= pow10;
+        ++ipart;
+    }
+    for (int i = 0; i < prec; ++i) {
+        buff[--pos] = static_cast<char>('0' + dpart % 10);
+        dpart /= 10;
+    }
+    if (prec > 0 || spec.alt) {
+        buff[--pos] = '.';
+    }
+    do {
+        buff[--pos] = static_cast<char>('0' + ipart % 10);
+        ipart /= 10;
+    } while (ipart > 0);
+    put_padded(w, spec, sign_prefix(spec, neg), &buff[pos], sizeof(buff) - pos);
+}
+
+/**
+ * \brief           Format single value for the specifier
+ * \param[in,out]   w: Writer
+ * \param[in]       spec: Format specifier
+ * \param[in]       value: Value to format
+ * \return          `true` on success, `false` if value type does not match the specifier
+ */
+template <typename T>
+constexpr bool
+format_value(Writer& w, const Spec& spec, const T& value) {
+    if constexpr (std::is_same_v<T, bool>) {
+        return format_value(w, spec, static_cast<int>(value)); /* Promoted the same as in variable argument list */
+    } else if constexpr (std::is_integral_v<T>) {
+        if (spec.prec >= 0) {
+            return false; /* Library has no precision for integers */
+        } else if (spec.char_short > 0) {
+            Spec nspec = spec;
+
+            /* Value is truncated to `char` or `short` type, with signedness of the specifier */
+            nspec.char_short = 0;
+            if (spec.type == 'd' || spec.type == 'i') {
+                return format_value(w, nspec,
+                                    static_cast<long long>(spec.char_short == 2 ? static_cast<signed char>(value)
+                                                                                : static_cast<short>(value)));
+            }
+            return format_value(w, nspec,
+                                static_cast<unsigned long long>(spec.char_short == 2 ? static_cast<unsigned char>(value)
+                                                                                     : static_cast<unsigned short>(value)));
+        } else if (spec.type == 'c') {
+            const char ch = static_cast<char>(value);
+            put_padded(w, Spec{spec.left, false, false, false, false, spec.width}, "", &ch, 1);
+        } else if (spec.type == 'd' || spec.type == 'i') {
+            const bool neg = value < 0;
+            format_int(w, spec, neg ? 0ULL - static_cast<unsigned long long>(value) : static_cast<unsigned long long>(value),
+                       neg);
+        } else if (spec.type == 'u' || spec.type == 'x' || spec.type == 'X' || spec.type == 'o' || spec.type == 'b'
+                   || spec.type == 'B') {
+            format_int(w, spec, static_cast<unsigned long long>(static_cast<std::make_unsigned_t<T>>(value)), false);
+        } else {
+            return false;
+        }
+    } else if constexpr (std::is_floating_point_v<T>) {
+        if (spec.type != 'f' && spec.type != 'F') {
+            return false;
+        }
+        format_fixed(w, spec, static_cast<double>(value));
+    } else if constexpr (requires { value.str; }) {
+        size_t len = 0;
+
+        if (spec.type != 's') {
+            return false;
+        }
+        for (; value.str[len] != '\0' && (spec.prec < 0 || len < static_cast<size_t>(spec.prec)); ++len) {}
+        put_padded(w, Spec{spec.left, false, false, false, false, spec.width}, "", value.str, len);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * \brief           Result of constant expression formatting
+ */
+struct Result {
+    size_t len{}; /*!< Length of text, not counting terminating null character */
+    bool error{}; /*!< Set to `true` when format string does not match the values */
+};
+
+/**
+ * \brief           Format values with format string, in constant expression
+ * \tparam          Fmt: Format string
+ * \tparam          Values: Values for the format string
+ * \param[out]      buff: Output buffer, `nullptr` to only calculate length
+ * \return          Length of text and error status
+ */
+template <FixedString Fmt, auto... Values>
+constexpr Result
+run(char* buff) {
+    Writer w{buff};
+    const char* fmt = Fmt.str;
+    size_t arg = 0;
+
+    while (*fmt != '\0') {
+        if (*fmt != '%' || fmt[1] == '%') {
+            w.put(*fmt);
+            fmt += *fmt == '%' ? 2 : 1;
+            continue;
+        }
+
+        Spec spec{};
+        bool ok = false;
+        size_t idx = 0;
+
+        for (++fmt;; ++fmt) {
+            if (*fmt == '-') {
+                spec.left = true;
+            } else if (*fmt == '+') {
+                spec.plus = true;
+            } else if (*fmt == ' ') {
+                spec.space = true;
+            } else if (*fmt == '0') {
+                spec.zero = true;
+            } else if (*fmt == '#') {
+                spec.alt = true;
+            } else {
+                break;
+            }
+        }
+        for (; *fmt >= '0' && *fmt <= '9'; ++fmt) {
+            spec.width = spec.width * 10 + static_cast<size_t>(*fmt - '0');
+        }
+        if (*fmt == '.') {
+            for (spec.prec = 0, ++fmt; *fmt >= '0' && *fmt <= '9'; ++fmt) {
+                spec.prec = spec.prec * 10 + (*fmt - '0');
+            }
+        }
+        for (; *fmt == 'h' || *fmt == 'l' || *fmt == 'z' || *fmt == 'j'; ++fmt) {
+            spec.char_short += *fmt == 'h' ? 1 : 0; /* Other value types are known */
+        }
+        if (*fmt == '\0' || arg >= sizeof...(Values)) {
+            return {w.len, true};
+        }
+        spec.type = *fmt++;
+        ((idx++ == arg ? (ok = format_value(w, spec, Values)) : false), ...);
+        if (!ok) {
+            return {w.len, true};
+        }
+        ++arg;
+    }
+    if (buff != nullptr) {
+        buff[w.len] = '\0';
+    }
+    return {w.len, arg != sizeof...(Values)};
+}
+
+} // namespace ct
+
+/**
+ * \brief           Format values to array at compile time, with size deduced from the output.
+ *
+ * Supported are integer conversions `d`, `i`, `u`, `x`, `X`, `o`, `b`, `B` and `c`,
+ * fixed precision float `f` and `F`, and strings `s`, given as \ref FixedString, with flags and width.
+ * Precision applies to `f`, `F` and `s`, and it is rejected for integers, the same as the library ignores it.
+ * Length modifiers `hh` and `h` truncate integers, other modifiers follow the value type.
+ *
+ * \code{.cpp}
+ * static constexpr auto banner = Lwprintf::format<"%s v%u.%u.%u", Lwprintf::FixedString("fw"), 1, 0, 6>();
+ * \endcode
+ *
+ * \tparam          Fmt: Format string
+ * \tparam          Values: Values for format string
+ * \return          `std::array` with `NULL` terminated text
+ */
+template <FixedString Fmt, auto... Values>
+constexpr auto
+format() {
+    constexpr ct::Result res = ct::run<Fmt, Values...>(nullptr);
+    static_assert(!res.error, "Values do not match the format string");
+    std::array<char, res.len + 1> out{};
+
+    ct::run<Fmt, Values...>(out.data());
+    return out;
+}
+
+namespace fmt {
+
+namespace detail {
+
+/**
+ * \brief           Kind of argument for `{}` format, to select default type and length modifier
+ */
+enum class Kind : uint8_t {
+    Invalid,  /*!< Type cannot be formatted */
+    Signed,   /*!< Signed integer or enumeration */
+    Unsigned, /*!< Unsigned integer or `bool` */
+    Char,     /*!< `char` character */
+    Float,    /*!< Floating point number */
+    String,   /*!< `NULL` terminated string */
+    Pointer,  /*!< Pointer */
+    Custom,   /*!< User type with \ref Lwprintf::formatter specialization */
+};
+
+/**
+ * \brief           Error found during translation of `{}` format string
+ */
+enum class Error : uint8_t {
+    None,     /*!< Format string is valid */
+    Brace,    /*!< Unmatched `{` or `}` character */
+    ArgCount, /*!< Number of arguments does not match replacement fields */
+    Spec,     /*!< Format specification is not supported */
+    Type,     /*!< Presentation type is not valid for the argument */
+};
+
+/**
+ * \brief           Get kind of argument
+ * \tparam          T: Argument type
+ * \return          Argument kind
+ */
+template <typename T>
+constexpr Kind
+kind() {
+    using U = std::remove_cvref_t<T>;
+
+#if LWPRINTF_CFG_ENABLE_CUSTOM_SPEC
+    if constexpr (Formattable<T>) {
+        return Kind::Custom; /* Formatter takes precedence over built-in types */
+    } else
+#endif /* LWPRINTF_CFG_ENABLE_CUSTOM_SPEC */
+    if constexpr (std::is_same_v<U, char>) {
+        return Kind::Char;
+    } else if constexpr (std::is_convertible_v<T, const char*>) {
+        return Kind::String;
+    } else if constexpr (std::is_enum_v<U>) {
+        return std::is_signed_v<std::underlying_type_t<U>> ? Kind::Signed : Kind::Unsigned;
+    } else if constexpr (std::is_integral_v<U>) {
+        return std::is_signed_v<U> ? Kind::Signed : Kind::Unsigned;
+    } else if constexpr (std::is_floating_point_v<U>) {
+        return Kind::Float;
+    } else if constexpr (std::is_pointer_v<std::decay_t<T>> || std::is_null_pointer_v<U>) {
+        return Kind::Pointer;
+    } else {
+        return Kind::Invalid;
+    }
+}
+
+/**
+ * \brief           Format string translated from `{}` to `printf` syntax
+ * \tparam          N: Maximum length of translated string
+ */
+template <size_t N>
+struct Translated {
+    char str[N]{};            /*!< Format string in `printf` syntax */
+    Error error{Error::None}; /*!< Translation error */
+};
+
+/**
+ * \brief           Translate `{}` format string to `printf` format string, for converters of the library
+ *
+ * Replacement field is `{[:[[fill]align][sign][#][0][width][.precision][type]]}`.
+ * Fill must be space, center alignment, argument indexes and nested width are not supported
+ *
+ * \tparam          Fmt: Format string in `{}` syntax
+ * \tparam          Args: Argument types
+ * \return          Translated format string, or error
+ */
+template <FixedString Fmt, typename... Args>
+constexpr auto
+translate() {
+    constexpr Kind kinds[] = {kind<Args>()..., Kind::Invalid};
+    constexpr size_t sizes[] = {sizeof(std::remove_cvref_t<Args>)..., 0};
+    Translated<2 * sizeof(Fmt.str) + 1> out{};
+    const char* f = Fmt.str;
+    size_t pos = 0, arg = 0;
+
+    while (*f != '\0') {
+        if (*f == '}') {
+            if (f[1] != '}') {
+                out.error = Error::Brace;
+                return out;
+            }
+            out.str[pos++] = '}';
+            f += 2;
+            continue;
+        } else if (*f != '{' || f[1] == '{') {
+            if (*f == '%') {
+                out.str[pos++] = '%'; /* Percent is literal character */
+            }
+            out.str[pos++] = *f;
+            f += *f == '{' ? 2 : 1;
+            continue;
+        }
+        if (arg >= sizeof...(Args)) {
+            out.error = Error::ArgCount;
+            return out;
+        }
+
+        const Kind k = kinds[arg];
+        char align = '\0', type = '\0';
+
+        if (k == Kind::Invalid) {
+            out.error = Error::Type;
+            return out;
+        }
+        out.str[pos++] = '%';
+        if (*++f == ':') {
+            ++f;
+            if (f[0] != '\0' && (f[1] == '<' || f[1] == '>' || f[1] == '^')) {
+                if (f[0] != ' ') {
+                    out.error = Error::Spec;
+                    return out;
+                }
+                ++f;
+            }
+            if (*f == '<' || *f == '>' || *f == '^') {
+                align = *f++;
+            }
+            if (align == '^') {
+                out.error = Error::Spec;
+                return out;
+            }
+            if (align == '<' || (align == '\0' && (k == Kind::String || k == Kind::Custom))) {
+                out.str[pos++] = '-'; /* Strings and user types are left aligned by default */
+            }
+            if (*f == '+' || *f == ' ') {
+                out.str[pos++] = *f++;
+            } else if (*f == '-') {
+                ++f;
+            }
+            if (*f == '#') {
+                out.str[pos++] = *f++;
+            }
+            if (*f == '0') {
+                out.str[pos++] = *f++;
+            }
+            for (; *f >= '0' && *f <= '9'; ++f) {
+                out.str[pos++] = *f;
+            }
+            if (*f == '.') {
+                for (out.str[pos++] = *f++; *f >= '0' && *f <= '9'; ++f) {
+                    out.str[pos++] = *f;
+                }
+            }
+            if (*f != '}') {
+                type = *f++;
+            }
+        }
+        if (*f != '}') {
+            out.error = *f == '\0' ? Error::Brace : Error::Spec;
+            return out;
+        }
+        ++f;
+
+        /* Default and allowed presentation types per argument kind */
+        switch (k) {
+            case Kind::Signed:
+            case Kind::Unsigned:
+            case Kind::Char:
+                if (type == '\0') {
+                    type = k == Kind::Char ? 'c' : (k == Kind::Signed ? 'd' : 'u');
+                } else if (type == 'd') {
+                    type = k == Kind::Unsigned ? 'u' : 'd';
+                } else if (type != 'x' && type != 'X' && type != 'o' && type != 'b' && type != 'B' && type != 'c') {
+                    out.error = Error::Type;
+                    return out;
+                }
+                if (type != 'c' && sizes[arg] > sizeof(int)) {
+                    if (type == 'b' || type == 'B') {
+                        out.error = Error::Type; /* Binary is always read as unsigned int */
+                        return out;
+                    }
+                    if (sizes[arg] > sizeof(long int)) {
+                        out.str[pos++] = 'l';
+                    }
+                    out.str[pos++] = 'l';
+                }
+                break;
+            case Kind::Float:
+                if (type == '\0') {
+                    type = 'g';
+                } else if (type != 'f' && type != 'F' && type != 'e' && type != 'E' && type != 'g' && type != 'G'
+                           && type != 'a' && type != 'A') {
+                    out.error = Error::Type;
+                    return out;
+                }
+                break;
+            case Kind::String:
+                if (type != '\0' && type != 's') {
+                    out.error = Error::Type;
+                    return out;
+                }
+                type = 's';
+                break;
+            case Kind::Pointer:
+                if (type != '\0' && type != 'p') {
+                    out.error = Error::Type;
+                    return out;
+                }
+                type = 'p';
+                break;
+            case Kind::Custom:
+                if (type != '\0') {
+                    out.error = Error::Type;
+                    return out;
+                }
+                type = LWPRINTF_CFG_CPP_FORMATTER_SPEC;
+                break;
+            default: break;
+        }
+        out.str[pos++] = type;
+        ++arg;
+    }
+    if (arg != sizeof...(Args)) {
+        out.error = Error::ArgCount;
+    }
+    return out;
+}
+
+/**
+ * \brief           Get format string in `printf` syntax, translated at compile time
+ * \tparam          Fmt: Format string in `{}` syntax
+ * \tparam          Args: Argument types
+ * \return          Translated format string
+ */
+template <FixedString Fmt, typename... Args>
+constexpr auto
+format_string() {
+    constexpr auto out = translate<Fmt, Args...>();
+    static_assert(out.error != Error::Brace, "Unmatched brace in the format string");
+    static_assert(out.error != Error::ArgCount, "Number of arguments does not match the format string");
+    static_assert(out.error != Error::Spec, "Format specification is not supported");
+    static_assert(out.error != Error::Type, "Argument type does not match presentation type");
+    return FixedString<sizeof(out.str)>(out.str);
+}
+
+} // namespace detail
+
+/**
+ * \brief           Print formatted data with `{}` format string to the output of the instance
+ *
+ * Format string is translated to `printf` syntax at compile time, and printed with \ref Lwprintf::print
+ *
+ * \code{.cpp}
+ * Lwprintf::fmt::print<"T={}.{:02} C, id={:#010x}\r\n">(&lwobj, temp_int, temp_dec, id);
+ * \endcode
+ *
+ * \tparam          Fmt: Format string in `{}` syntax
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `nullptr` to use default instance
+ * \param[in]       args: Arguments for format string
+ * \return          The number of characters that would have been written,
+ *                      not counting the terminating null character.
+ */
+template <FixedString Fmt, typename... Args>
+int
+print(lwprintf_t* lwobj, Args&&... args) {
+    return Lwprintf::print<detail::format_string<Fmt, Args...>()>(lwobj, std::forward<Args>(args)...);
+}
+
+/**
+ * \brief           Write formatted data with `{}` format string to sized buffer
+ * \tparam          Fmt: Format string in `{}` syntax
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `nullptr` to use default instance
+ * \param[in]       s: Pointer to a buffer where the resulting C-string is stored
+ * \param[in]       n: Maximum number of bytes to be used in the buffer
+ * \param[in]       args: Arguments for format string
+ * \return          The number of characters that would have been written if `n` had been sufficiently large,
+ *                      not counting the terminating null character.
+ */
+template <FixedString Fmt, typename... Args>
+int
+snprint(lwprintf_t* lwobj, char* s, size_t n, Args&&... args) {
+    return Lwprintf::snprint<detail::format_string<Fmt, Args...>()>(lwobj, s, n, std::forward<Args>(args)...);
+}
+
+/**
+ * \brief           Write formatted data with `{}` format string to the sink
+ * \tparam          Fmt: Format string in `{}` syntax
+ * \param[in,out]   lwobj: LwPRINTF instance, used for its settings. Set to `nullptr` to use default instance
+ * \param[in,out]   sink: Sink to write text to
+ * \param[in]       args: Arguments for format string
+ * \return          The number of characters that would have been written, if sink had been sufficiently large
+ */
+template <FixedString Fmt, Sink S, typename... Args>
+int
+print_to(lwprintf_t* lwobj, S& sink, Args&&... args) {
+    return Lwprintf::print_to<detail::format_string<Fmt, Args...>()>(lwobj, sink, std::forward<Args>(args)...);
+}
+
+/**
+ * \brief           Write formatted data with `{}` format string to output iterator
+ * \tparam          Fmt: Format string in `{}` syntax
+ * \param[in,out]   lwobj: LwPRINTF instance, used for its settings. Set to `nullptr` to use default instance
+ * \param[in]       out: Iterator to write first character to
+ * \param[in]       args: Arguments for format string
+ * \return          Iterator past the last written character
+ */
+template <FixedString Fmt, std::output_iterator<char> It, typename... Args>
+It
+format_to(lwprintf_t* lwobj, It out, Args&&... args) {
+    return Lwprintf::format_to<detail::format_string<Fmt, Args...>()>(lwobj, std::move(out),
+                                                                       std::forward<Args>(args)...);
+}
+
+/**
+ * \brief           Write formatted data with `{}` format string to output iterator, with at most `n` characters
+ * \tparam          Fmt: Format string in `{}` syntax
+ * \param[in,out]   lwobj: LwPRINTF instance, used for its settings. Set to `nullptr` to use default instance
+ * \param[in]       out: Iterator to write first character to
+ * \param[in]       n: Maximum number of characters to write
+ * \param[in]       args: Arguments for format string
+ * \return          Iterator past the last written character,
+ *                      and the number of characters that would have been written if `n` had been sufficiently large
+ */
+template <FixedString Fmt, std::output_iterator<char> It, typename... Args>
+FormatToNResult<It>
+format_to_n(lwprintf_t* lwobj, It out, size_t n, Args&&... args) {
+    return Lwprintf::format_to_n<detail::format_string<Fmt, Args...>()>(lwobj, std::move(out), n,
+                                                                         std::forward<Args>(args)...);
+}
+
+} // namespace fmt
+
+} // namespace Lwprintf
+
+#endif /* LWPRINTF_HDR_HPP */
@@ -0,0 +1,87 @@
+/**
+ * \file            lwprintf_compress.h
+ * \brief           Streaming LZSS compression of the output
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwPRINTF - Lightweight stdio manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v1.0.6
+ */
+#ifndef LWPRINTF_COMPRESS_HDR_H
+#define LWPRINTF_COMPRESS_HDR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "lwprintf/lwprintf.h"
+
+#if LWPRINTF_CFG_ENABLE_COMPRESS || __DOXYGEN__
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \defgroup        LWPRINTF_COMPRESS Output compression
+ * \brief           Streaming LZSS compression in front of the output function
+ * \{
+ */
+
+/**
+ * \brief           Compression object, that owns the instance with compressed output
+ */
+typedef struct {
+    lwprintf_t lw;                                  /*!< Instance, that prints compressed text */
+    lwprintf_output_fn out_fn;                      /*!< Output function for compressed bytes */
+    unsigned char* window;                          /*!< History window, size is power of `2` */
+    uint32_t window_size;                           /*!< Size of history window in units of bytes */
+    uint32_t pos;                                   /*!< Number of bytes in the history since reset */
+    uint16_t head[LWPRINTF_CFG_COMPRESS_HASH_SIZE]; /*!< Last position of every hashed `3` byte sequence */
+    unsigned char group[1 + 8 * 2];                 /*!< Flags byte and items of current group */
+    uint8_t group_len;                              /*!< Length of current group in units of bytes */
+    uint8_t group_items;                            /*!< Number of items in current group */
+    uint8_t failed;                                 /*!< Set to `1` when output function failed */
+    uint32_t in_cnt;                                /*!< Number of text bytes, entered compression */
+    uint32_t out_cnt;                               /*!< Number of compressed bytes, sent to output */
+} lwprintf_compress_t;
+
+uint8_t lwprintf_compress_init(lwprintf_compress_t* cmp, lwprintf_output_fn out_fn, void* window, size_t window_size,
+                               char* staging, size_t staging_size);
+lwprintf_t* lwprintf_compress_get_instance(lwprintf_compress_t* cmp);
+size_t lwprintf_compress_write(lwprintf_compress_t* cmp, const char* data, size_t len);
+void lwprintf_compress_reset(lwprintf_compress_t* cmp);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWPRINTF_CFG_ENABLE_COMPRESS || __DOXYGEN__ */
+
+#endif /* LWPRINTF_COMPRESS_HDR_H */
@@ -0,0 +1,124 @@
+/**
+ * \file            lwprintf_crashlog.h
+ * \brief           Persistent crash log in no-init RAM
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwPRINTF - Lightweight stdio manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v1.0.6
+ */
+#ifndef LWPRINTF_CRASHLOG_HDR_H
+#define LWPRINTF_CRASHLOG_HDR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "lwprintf/lwprintf.h"
+
+#if LWPRINTF_CFG_ENABLE_CRASHLOG || __DOXYGEN__
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \defgroup        LWPRINTF_CRASHLOG Persistent crash log
+ * \brief           Ring buffer in no-init RAM, that survives warm reset
+ * \{
+ */
+
+/**
+ * \brief           Spill function, that stores one full page of the log to flash
+ * \param[in]       page: Page index, rotated over all pages for wear-leveling
+ * \param[in]       seq: Sequence number of the page, incremented for every spilled page
+ * \param[in]       data: Page data
+ * \param[in]       len: Page size in units of bytes
+ * \param[in]       arg: User argument
+ */
+typedef void (*lwprintf_crashlog_spill_fn)(uint32_t page, uint32_t seq, const void* data, size_t len, void* arg);
+
+/**
+ * \brief           Header of the log at the beginning of no-init memory, protected with CRC-32
+ */
+typedef struct {
+    uint32_t magic;     /*!< Magic value, set by the library */
+    uint32_t size;      /*!< Size of data area in units of bytes */
+    uint32_t pos;       /*!< Write position in data area */
+    uint32_t len;       /*!< Number of valid bytes in data area */
+    uint32_t resets;    /*!< Number of resets, that the log survived */
+    uint32_t spill_seq; /*!< Sequence number of the next spilled page */
+    uint32_t crc;       /*!< CRC-32 of all previous fields */
+} lwprintf_crashlog_hdr_t;
+
+/**
+ * \brief           Crash log object, kept in regular RAM
+ */
+typedef struct {
+    lwprintf_t lw;                       /*!< Instance, that prints to the log */
+    lwprintf_crashlog_hdr_t* hdr;        /*!< Header in no-init memory */
+    char* data;                          /*!< Data area in no-init memory, after the header */
+    uint32_t restored;                   /*!< Number of bytes, restored from before the reset */
+    lwprintf_crashlog_spill_fn spill_fn; /*!< Optional spill function */
+    void* spill_arg;                     /*!< User argument of spill function */
+    uint32_t page_size;                  /*!< Size of one spilled page */
+    uint32_t page_cnt;                   /*!< Number of flash pages for wear-leveling */
+} lwprintf_crashlog_t;
+
+uint8_t lwprintf_crashlog_init(lwprintf_crashlog_t* log, void* mem, size_t mem_size, char* staging,
+                               size_t staging_size);
+lwprintf_t* lwprintf_crashlog_get_instance(lwprintf_crashlog_t* log);
+size_t lwprintf_crashlog_write(lwprintf_crashlog_t* log, const char* data, size_t len);
+size_t lwprintf_crashlog_read(const lwprintf_crashlog_t* log, size_t offset, char* buff, size_t buff_size);
+size_t lwprintf_crashlog_get_len(const lwprintf_crashlog_t* log);
+void lwprintf_crashlog_clear(lwprintf_crashlog_t* log);
+uint8_t lwprintf_crashlog_set_spill(lwprintf_crashlog_t* log, lwprintf_crashlog_spill_fn fn, void* arg,
+                                    size_t page_size, size_t page_cnt);
+
+/**
+ * \brief           Get number of bytes in the log, that were written before the reset
+ * \param[in]       log: Crash log object
+ * \return          Number of restored bytes, `0` after cold reset or corrupted header
+ */
+#define lwprintf_crashlog_get_restored(log) ((size_t)(log)->restored)
+
+/**
+ * \brief           Get number of resets, that the log survived
+ * \param[in]       log: Crash log object
+ * \return          Number of warm resets since the log was last created
+ */
+#define lwprintf_crashlog_get_resets(log)   ((log)->hdr->resets)
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWPRINTF_CFG_ENABLE_CRASHLOG || __DOXYGEN__ */
+
+#endif /* LWPRINTF_CRASHLOG_HDR_H */
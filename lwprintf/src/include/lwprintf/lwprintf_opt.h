@@ -89,6 +89,212 @@ extern "C" {
 #define LWPRINTF_CFG_OS_MANUAL_PROTECT 0
 #endif
 
+/**
+ * \brief           Size of per-call staging buffer for direct print operations with OS support, in units of bytes.
+ *                  Set to `0` to disable it
+ *
+ * When enabled, together with \ref LWPRINTF_CFG_OS and without \ref LWPRINTF_CFG_OS_MANUAL_PROTECT,
+ * text is formatted to the staging buffer on the stack of the caller, without mutex.
+ * Mutex is then held only while finished text is sent to the output.
+ *
+ * Text longer than the staging buffer is formatted again with mutex held for complete operation,
+ * so output from multiple threads is never mixed.
+ *
+ * \note            Every direct print call uses this amount of stack
+ */
+#ifndef LWPRINTF_CFG_OS_STAGING_SIZE
+#define LWPRINTF_CFG_OS_STAGING_SIZE 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` non-blocking print path from interrupt context.
+ *
+ * When enabled, direct print functions check for interrupt context with \ref lwprintf_sys_is_isr.
+ * From interrupt, message is stored to the deferred ring buffer of the instance instead of waiting for the mutex,
+ * and it is formatted to the output with the next direct print call at task level,
+ * or with explicit call to \ref lwprintf_process_deferred_ex.
+ *
+ * \note            \ref LWPRINTF_CFG_OS and \ref LWPRINTF_CFG_ENABLE_DEFERRED must be enabled to use this feature.
+ *                  Ring buffer must be set with \ref lwprintf_init_deferred_ex,
+ *                  otherwise messages from interrupts are dropped
+ */
+#ifndef LWPRINTF_CFG_OS_ISR_DEFERRED
+#define LWPRINTF_CFG_OS_ISR_DEFERRED 0
+#endif
+
+/**
+ * \brief           Number of characters, after which direct print releases the mutex and yields
+ *
+ * Set to `0` to disable the feature
+ *
+ * Long message, such as dump of large buffer, holds the mutex for the whole time of its output.
+ * When enabled, message is sent in chunks of this size, and \ref lwprintf_sys_yield is called between them,
+ * with the mutex released. Task, that gets the mutex while message of other task is not finished yet,
+ * does not output its text, but stores it to the deferred ring buffer of the instance.
+ * Stored messages are output after the long message ends, so every message stays in one piece,
+ * and other tasks wait for the mutex at most the time of single chunk.
+ *
+ * \note            \ref LWPRINTF_CFG_OS and \ref LWPRINTF_CFG_ENABLE_DEFERRED must be enabled to use this feature,
+ *                  without \ref LWPRINTF_CFG_OS_MANUAL_PROTECT and \ref LWPRINTF_CFG_OS_ISR_DEFERRED.
+ *                  Ring buffer must be set with \ref lwprintf_init_deferred_ex,
+ *                  otherwise messages of other tasks are dropped while long message is sent
+ */
+#ifndef LWPRINTF_CFG_OS_YIELD_CHUNK
+#define LWPRINTF_CFG_OS_YIELD_CHUNK 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` default instance per thread
+ *
+ * All threads share single default instance, and its mutex, when functions are called with `NULL` instance.
+ * When enabled, thread can bind own instance with \ref lwprintf_set_thread_default,
+ * that is used instead of the global one by all functions of the thread, called with `NULL` instance.
+ * Threads without bound instance keep using the global default instance.
+ *
+ * Instance pointer is kept by system port, with \ref lwprintf_sys_thread_default_get
+ * and \ref lwprintf_sys_thread_default_set functions.
+ *
+ * \note            \ref LWPRINTF_CFG_OS must be enabled to use this feature
+ */
+#ifndef LWPRINTF_CFG_OS_THREAD_DEFAULT
+#define LWPRINTF_CFG_OS_THREAD_DEFAULT 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` mutex statistics of every instance.
+ *
+ * When enabled, instance counts mutex acquisitions and contended acquisitions,
+ * and measures wait and hold time with timestamp function, set by \ref lwprintf_init_stats_ex.
+ * Statistics are read with \ref lwprintf_get_stats_ex.
+ *
+ * \note            \ref LWPRINTF_CFG_OS must be enabled to use this feature
+ */
+#ifndef LWPRINTF_CFG_OS_STATS
+#define LWPRINTF_CFG_OS_STATS 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` output statistics of every instance.
+ *
+ * When enabled, instance counts formatting calls, formatted characters, output function calls,
+ * prints cancelled by output function and truncated buffer outputs, and measures time spent in output function
+ * with timestamp function, set by \ref lwprintf_init_stats_ex.
+ * Statistics are read with \ref lwprintf_get_stats_ex and cleared with \ref lwprintf_reset_stats_ex.
+ */
+#ifndef LWPRINTF_CFG_STATS
+#define LWPRINTF_CFG_STATS 0
+#endif /* LWPRINTF_CFG_STATS */
+
+/**
+ * \brief           Number of buckets of output function latency histogram, `0` to disable it.
+ *
+ * Every output function call is counted in the bucket of its duration, in units of timestamp function.
+ * Bucket `0` counts calls of `0` duration, bucket `i` calls with duration from `2^(i-1)` to `2^i - 1`,
+ * and last bucket all longer calls.
+ *
+ * \note            \ref LWPRINTF_CFG_STATS must be enabled to use this feature
+ */
+#ifndef LWPRINTF_CFG_STATS_OUT_HIST_BUCKETS
+#define LWPRINTF_CFG_STATS_OUT_HIST_BUCKETS 0
+#endif /* LWPRINTF_CFG_STATS_OUT_HIST_BUCKETS */
+
+/**
+ * \defgroup        LWPRINTF_OPT_TRACE Trace hooks
+ * \ingroup         LWPRINTF_OPT
+ * \brief           Hooks for trace recorders, such as SEGGER SystemView or Percepio Tracealyzer
+ *
+ * Hooks are called at start and end of formatting, mutex wait and release, every conversion
+ * and every call of output function. By default hooks are empty and have no cost.
+ * User may define any of them in `lwprintf_opts.h`, or include \ref LWPRINTF_TRACE_SYSVIEW binding.
+ *
+ * \note            Hooks are called in context of the print, also with mutex held.
+ *                  They shall not call functions of the same LwPRINTF instance
+ * \{
+ */
+
+/**
+ * \brief           Start of formatting, called at entry of every print or buffer function
+ * \param[in]       lwobj: LwPRINTF instance
+ * \param[in]       format: Format string, `NULL` for compiled format
+ */
+#ifndef LWPRINTF_CFG_TRACE_FORMAT_START
+#define LWPRINTF_CFG_TRACE_FORMAT_START(lwobj, format)
+#endif
+
+/**
+ * \brief           End of formatting
+ * \param[in]       lwobj: LwPRINTF instance
+ * \param[in]       len: Number of formatted characters
+ */
+#ifndef LWPRINTF_CFG_TRACE_FORMAT_END
+#define LWPRINTF_CFG_TRACE_FORMAT_END(lwobj, len)
+#endif
+
+/**
+ * \brief           Start of wait for mutex of the instance
+ * \param[in]       lwobj: LwPRINTF instance
+ */
+#ifndef LWPRINTF_CFG_TRACE_MUTEX_WAIT
+#define LWPRINTF_CFG_TRACE_MUTEX_WAIT(lwobj)
+#endif
+
+/**
+ * \brief           End of wait for mutex of the instance
+ * \param[in]       lwobj: LwPRINTF instance
+ * \param[in]       is_acquired: `1` when mutex has been acquired, `0` otherwise
+ */
+#ifndef LWPRINTF_CFG_TRACE_MUTEX_ACQUIRED
+#define LWPRINTF_CFG_TRACE_MUTEX_ACQUIRED(lwobj, is_acquired)
+#endif
+
+/**
+ * \brief           Mutex of the instance is about to be released
+ * \param[in]       lwobj: LwPRINTF instance
+ */
+#ifndef LWPRINTF_CFG_TRACE_MUTEX_RELEASE
+#define LWPRINTF_CFG_TRACE_MUTEX_RELEASE(lwobj)
+#endif
+
+/**
+ * \brief           Start of conversion of one specifier, built-in or custom
+ * \param[in]       lwobj: LwPRINTF instance
+ * \param[in]       spec: Specifier character
+ */
+#ifndef LWPRINTF_CFG_TRACE_CONV_START
+#define LWPRINTF_CFG_TRACE_CONV_START(lwobj, spec)
+#endif
+
+/**
+ * \brief           End of conversion of one specifier
+ * \param[in]       lwobj: LwPRINTF instance
+ * \param[in]       spec: Specifier character
+ */
+#ifndef LWPRINTF_CFG_TRACE_CONV_END
+#define LWPRINTF_CFG_TRACE_CONV_END(lwobj, spec)
+#endif
+
+/**
+ * \brief           Start of output function call
+ * \param[in]       lwobj: LwPRINTF instance
+ * \param[in]       len: Number of characters passed to the output, `1` for character output
+ */
+#ifndef LWPRINTF_CFG_TRACE_SINK_START
+#define LWPRINTF_CFG_TRACE_SINK_START(lwobj, len)
+#endif
+
+/**
+ * \brief           End of output function call
+ * \param[in]       lwobj: LwPRINTF instance
+ * \param[in]       is_ok: `1` when output accepted the characters, `0` when it cancelled the print
+ */
+#ifndef LWPRINTF_CFG_TRACE_SINK_END
+#define LWPRINTF_CFG_TRACE_SINK_END(lwobj, is_ok)
+#endif
+
+/**
+ * \}
+ */
+
 /**
  * \brief           Enables `1` or disables `0` support for `long long int` type, signed or unsigned.
  *
@@ -97,6 +303,16 @@ extern "C" {
 #define LWPRINTF_CFG_SUPPORT_LONG_LONG 1
 #endif
 
+/**
+ * \brief           Enables `1` or disables `0` thousands grouping with `'` flag,
+ *                  for decimal integer, floating-point and fixed-point specifiers.
+ *
+ * Separator character is set per instance with \ref lwprintf_set_thousands_sep_ex, default is `,`
+ */
+#ifndef LWPRINTF_CFG_SUPPORT_THOUSANDS
+#define LWPRINTF_CFG_SUPPORT_THOUSANDS 1
+#endif
+
 /**
  * \brief           Enables `1` or disables `0` support for any specifier accepting any kind of integer types.
  *                  This is enabling `%d, %b, %u, %o, %i, %x` specifiers
@@ -133,6 +349,80 @@ extern "C" {
 #define LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING 1
 #endif
 
+/**
+ * \brief           Enables `1` or disables `0` integer-only shortest round-trip engine for float types
+ *
+ * When enabled, `%f, %e, %g` specifiers are generated from the shortest digits
+ * that uniquely identify the `double` number (Grisu2 algorithm),
+ * instead of using double arithmetic with maximum of `18` digits.
+ *
+ * - It supports full range of `double` numbers, shortest digits are rounded correctly to precision
+ * - It runs with bounded execution time, regardless of number magnitude
+ * - Digits beyond shortest representation are printed as `0` and are not digits of exact binary value,
+ *      `%.3f` of `93310397111457.984375` prints `93310397111457.980`, as shortest digits are `9331039711145798`.
+ *      With \ref LWPRINTF_CFG_FLOAT_EXACT enabled, such `%f` output is printed with exact digits instead.
+ *      `%e` and `%g` always use zeros beyond shortest digits, this is accepted deviation from C library
+ *
+ * \note            \ref LWPRINTF_CFG_SUPPORT_TYPE_FLOAT has to be enabled to use this feature.
+ *                  It requires IEEE-754 `double` type and `uint64_t` support from the compiler
+ */
+#ifndef LWPRINTF_CFG_FLOAT_SHORTEST
+#define LWPRINTF_CFG_FLOAT_SHORTEST 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` single precision float engine
+ *
+ * When enabled, `double` argument is converted to `float` once,
+ * and all further calculations use `float` and 32-bit integer types.
+ * It is intended for cores with single precision floating point unit only,
+ * where every `double` operation is a software library call.
+ *
+ * - Maximum of `7` decimal digits is calculated, more digits are printed as `0`
+ * - Numbers out of `float` range are printed as `inf`, or as `0` when too small
+ *
+ * \note            \ref LWPRINTF_CFG_SUPPORT_TYPE_FLOAT has to be enabled to use this feature.
+ *                  It cannot be used together with \ref LWPRINTF_CFG_FLOAT_SHORTEST
+ */
+#ifndef LWPRINTF_CFG_SUPPORT_TYPE_FLOAT_SINGLE
+#define LWPRINTF_CFG_SUPPORT_TYPE_FLOAT_SINGLE 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` exact decimal output of `%f` beyond limits of default float engine
+ *
+ * When enabled, `%f` and `%F` with precision above `18` decimals or with value above `1e18`
+ * are printed with all digits exact, from binary representation of the number.
+ * Digits are generated with fixed-size big number on the stack, with integer operations only.
+ *
+ * - Output is the same as with C library `printf`, with rounding to nearest even
+ * - Stack usage is bounded, about `300` bytes regardless of precision and magnitude
+ * - Other numbers and types use default engine, with the same speed as without this option
+ *
+ * With \ref LWPRINTF_CFG_FLOAT_SHORTEST enabled, `%f` is printed with exact digits,
+ * when precision asks for more digits than shortest representation has, and these are not its exact value.
+ *
+ * \note            \ref LWPRINTF_CFG_SUPPORT_TYPE_FLOAT has to be enabled to use this feature.
+ *                  It requires IEEE-754 `double` type
+ */
+#ifndef LWPRINTF_CFG_FLOAT_EXACT
+#define LWPRINTF_CFG_FLOAT_EXACT 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` fast path of `%f` with explicit precision and small value
+ *
+ * Integer part and rounded decimal part are joined to single integer, that is printed with decimal point,
+ * skipping digit counting and per-digit `64-bit` divisions of default engine. Output is the same as without fast path.
+ * It is used when both parts fit to `18` digits, or `9` digits without `long long` type,
+ * such as `%.2f` of values below `1e16`.
+ *
+ * \note            It has no effect with \ref LWPRINTF_CFG_FLOAT_SHORTEST enabled
+ */
+#ifndef LWPRINTF_CFG_FLOAT_FIXED_FAST
+#define LWPRINTF_CFG_FLOAT_FIXED_FAST 1
+#endif
+
 /**
  * \brief           Enables `1` or disables `0` support for `%s` for string output
  *
@@ -141,6 +431,32 @@ extern "C" {
 #define LWPRINTF_CFG_SUPPORT_TYPE_STRING 1
 #endif
 
+/**
+ * \brief           Enables `1` or disables `0` support for `%J` and `%C` escaped string output
+ *
+ * `%J` escapes string for JSON and `%C` escapes string with C escape sequences, while it is written to the output.
+ * Quotes around the string are not added.
+ * *Precision* field limits number of input characters, *width* field applies to escaped string
+ */
+#ifndef LWPRINTF_CFG_SUPPORT_TYPE_STRING_ESCAPE
+#define LWPRINTF_CFG_SUPPORT_TYPE_STRING_ESCAPE 1
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` word-at-a-time length scan of strings
+ *
+ * Length of `%s` string is calculated with aligned reads of `size_t` words, instead of one byte at a time.
+ * Aligned read never crosses page or memory protection region boundary, but it may read up to `sizeof(size_t) - 1`
+ * bytes after string termination. It assumes, that memory protection has granularity of at least `sizeof(size_t)`
+ * bytes, which is true for MMU pages and MPU regions.
+ *
+ * Scan function is excluded from address sanitizer with GCC, Clang and MSVC.
+ * Disable it for other memory checkers, such as Valgrind, that report such reads
+ */
+#ifndef LWPRINTF_CFG_STRING_WORD_SCAN
+#define LWPRINTF_CFG_STRING_WORD_SCAN 1
+#endif
+
 /**
  * \brief           Enables `1` or disables `0` support for `%k` for hex byte array output
  *
@@ -149,6 +465,105 @@ extern "C" {
 #define LWPRINTF_CFG_SUPPORT_TYPE_BYTE_ARRAY 1
 #endif
 
+/**
+ * \brief           Enables `1` or disables `0` support for `%r` for base64 byte array output
+ *
+ * Arguments are the same as for `%k`, *width* field specifies length of input array.
+ * Alternate mode `%#r` selects URL-safe alphabet
+ */
+#ifndef LWPRINTF_CFG_SUPPORT_TYPE_BASE64
+#define LWPRINTF_CFG_SUPPORT_TYPE_BASE64 1
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` support for `%H` for multi-line hexdump of byte array
+ *
+ * *Width* field specifies length of input array, *precision* field specifies number of bytes per line.
+ * Every line is prepared on stack and written to the output at once
+ */
+#ifndef LWPRINTF_CFG_SUPPORT_TYPE_HEXDUMP
+#define LWPRINTF_CFG_SUPPORT_TYPE_HEXDUMP 1
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` support for `v` flag, to print array of numbers
+ *
+ * Arguments are number of elements as `int` and pointer to the first element, `%v3d` prints `int` array
+ * with width of `3` for every element. Length modifiers select element type, `%vhhu` prints `unsigned char` array,
+ * `%v.2f` prints `float` array and `%v.2lf` prints `double` array.
+ * Elements are separated with string, set by \ref lwprintf_set_array_sep_ex function
+ */
+#ifndef LWPRINTF_CFG_SUPPORT_TYPE_ARRAY
+#define LWPRINTF_CFG_SUPPORT_TYPE_ARRAY 1
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` support for `%q` fixed-point output type
+ *
+ * Number of fractional bits follows the specifier, `%.3q16` prints Q16.16 value from `int` with `3` decimals.
+ * Length modifiers `l` and `ll` select `long` and `long long` argument.
+ * Conversion uses integer operations only, it does not need \ref LWPRINTF_CFG_SUPPORT_TYPE_FLOAT
+ *
+ * - Number of fractional bits is limited to width of the longest integer type minus `1`, `63` with `long long`.
+ *     Specifier with more bits is printed as `q`, and its argument is skipped
+ * - Maximum of `20` decimal digits is calculated, more digits are printed as `0`
+ */
+#ifndef LWPRINTF_CFG_SUPPORT_TYPE_FIXED
+#define LWPRINTF_CFG_SUPPORT_TYPE_FIXED 1
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` support for `%y` and `%Y` SI prefix output types
+ *
+ * Exponent is selected in multiples of `3` and printed as SI prefix after the value, `%y` prints `4700.0` as `4.7k`.
+ * `%y` takes `double` argument and needs \ref LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING,
+ * `%Y` takes `int` argument, `l` and `ll` length modifiers select `long` and `long long` argument.
+ * Integer conversion uses integer operations only, it does not need \ref LWPRINTF_CFG_SUPPORT_TYPE_FLOAT
+ *
+ * - Precision is number of significant digits, `6` by default, trailing zeros are removed unless `#` flag is used
+ * - Prefixes from `y` (`1e-24`) to `Y` (`1e24`) are used, values out of this range are printed with the nearest
+ */
+#ifndef LWPRINTF_CFG_SUPPORT_TYPE_SI
+#define LWPRINTF_CFG_SUPPORT_TYPE_SI 1
+#endif
+
+/**
+ * \brief           String of micro prefix for `%y` and `%Y` SI prefix output types
+ *
+ * UTF-8 encoded `µ` is used by default. Set to `"u"` for terminals without UTF-8 support.
+ * Field width counts bytes of the string
+ */
+#ifndef LWPRINTF_CFG_SI_MICRO
+#define LWPRINTF_CFG_SI_MICRO "\xC2\xB5"
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` support for `%a` hexadecimal floating-point output type
+ *
+ * Output is exact, it is created from binary representation of `double` with integer operations only.
+ * It does not need \ref LWPRINTF_CFG_SUPPORT_TYPE_FLOAT
+ *
+ * \note            It requires IEEE-754 `double` type and `uint64_t` support from the compiler
+ */
+#ifndef LWPRINTF_CFG_SUPPORT_TYPE_FLOAT_HEX
+#define LWPRINTF_CFG_SUPPORT_TYPE_FLOAT_HEX 1
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` reduced stack usage of number conversions
+ *
+ * When enabled, conversions do not keep full digit buffers on the stack:
+ *
+ * - Floating point digits are output from the most significant one, without intermediate buffer
+ * - Binary digits of integer types are output in chunks, buffer only holds octal representation
+ *
+ * It is intended for tasks with small stacks, at the cost of few more divisions and output calls.
+ * Use `LwLibPROJECT_stack_report` target of development build to see worst-case stack of every function
+ */
+#ifndef LWPRINTF_CFG_REDUCED_STACK
+#define LWPRINTF_CFG_REDUCED_STACK 0
+#endif /* LWPRINTF_CFG_REDUCED_STACK */
+
 /**
  * \brief           Specifies default number of precision for floating number
  *
@@ -160,6 +575,627 @@ extern "C" {
 #define LWPRINTF_CFG_FLOAT_DEFAULT_PRECISION 6
 #endif
 
+/**
+ * \brief           Enables `1` or disables `0` bounded worst-case execution time of formatting
+ *
+ * When enabled, width, precision, string length and number of array elements are limited for every conversion,
+ * so that every conversion outputs limited number of characters, with limited number of loop iterations.
+ * Larger values from the format string or from `*` arguments are reduced to the limits,
+ * and text is then shorter than requested.
+ *
+ * Time of formatting is bounded by the format string length and the sum of bounds of its conversions.
+ * Custom specifiers, output function and lock of the operating system are not included in the bound
+ */
+#ifndef LWPRINTF_CFG_WCET
+#define LWPRINTF_CFG_WCET 0
+#endif
+
+/**
+ * \brief           Maximum width of one conversion, with \ref LWPRINTF_CFG_WCET enabled.
+ *
+ * It also limits number of input bytes of `%k`, `%r` and `%H` conversions, that are set with width
+ */
+#ifndef LWPRINTF_CFG_WCET_MAX_WIDTH
+#define LWPRINTF_CFG_WCET_MAX_WIDTH 64
+#endif
+
+/**
+ * \brief           Maximum precision of number conversions, with \ref LWPRINTF_CFG_WCET enabled
+ */
+#ifndef LWPRINTF_CFG_WCET_MAX_PRECISION
+#define LWPRINTF_CFG_WCET_MAX_PRECISION 32
+#endif
+
+/**
+ * \brief           Maximum number of characters read from string argument, with \ref LWPRINTF_CFG_WCET enabled.
+ *
+ * Longer strings are cut, string does not need to be terminated within the limit
+ */
+#ifndef LWPRINTF_CFG_WCET_MAX_STRING_LEN
+#define LWPRINTF_CFG_WCET_MAX_STRING_LEN 128
+#endif
+
+/**
+ * \brief           Maximum number of elements of `v` array conversion, with \ref LWPRINTF_CFG_WCET enabled
+ */
+#ifndef LWPRINTF_CFG_WCET_MAX_ARRAY_LEN
+#define LWPRINTF_CFG_WCET_MAX_ARRAY_LEN 16
+#endif
+
+/**
+ * \brief           Maximum iterations of exponent normalization, with \ref LWPRINTF_CFG_WCET enabled.
+ *
+ * Normalization loops only on platforms, where floating point type is not IEEE 754 binary format.
+ * Exponent is read from binary representation otherwise, with constant number of operations
+ */
+#ifndef LWPRINTF_CFG_WCET_MAX_EXP_ITER
+#define LWPRINTF_CFG_WCET_MAX_EXP_ITER 330
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` block output function support for direct print operations.
+ *
+ * When enabled, instance can be initialized with \ref lwprintf_init_block_ex,
+ * where formatted characters are collected to the user staging buffer
+ * and sent to the output in chunks, rather than one by one.
+ *
+ * \note            Staging buffer is part of the instance. It is protected by the instance mutex
+ *                  when \ref LWPRINTF_CFG_OS is enabled
+ */
+#ifndef LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT
+#define LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT 0
+#endif /* LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT */
+
+/**
+ * \brief           Enables `1` or disables `0` fan-out instances, that format text once and send it to multiple sinks.
+ *
+ * When enabled, instance initialized with \ref lwprintf_init_fanout_ex sends every block of staging buffer
+ * to all sinks added with \ref lwprintf_add_sink_ex. Every sink has own level filter,
+ * and sink that fails does not receive rest of the message, while other sinks continue.
+ *
+ * \note            \ref LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT must be enabled to use this feature
+ * \sa              LWPRINTF_CFG_FANOUT_SINK_COUNT
+ */
+#ifndef LWPRINTF_CFG_ENABLE_FANOUT
+#define LWPRINTF_CFG_ENABLE_FANOUT 0
+#endif /* LWPRINTF_CFG_ENABLE_FANOUT */
+
+/**
+ * \brief           Maximum number of sinks per fan-out instance, up to `32`
+ *
+ * \note            It has effect only when \ref LWPRINTF_CFG_ENABLE_FANOUT is enabled
+ */
+#ifndef LWPRINTF_CFG_FANOUT_SINK_COUNT
+#define LWPRINTF_CFG_FANOUT_SINK_COUNT 4
+#endif /* LWPRINTF_CFG_FANOUT_SINK_COUNT */
+
+/**
+ * \brief           Enables `1` or disables `0` buffering mode of block output instances.
+ *
+ * When enabled, \ref lwprintf_set_buff_mode_ex selects, when staging buffer is sent to the output:
+ * at the end of every print call (default), on new line character, or only when it is full.
+ * Text kept in staging buffer is sent on demand with \ref lwprintf_flush_ex
+ *
+ * \note            \ref LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT must be enabled to use this feature
+ */
+#ifndef LWPRINTF_CFG_ENABLE_BUFF_MODE
+#define LWPRINTF_CFG_ENABLE_BUFF_MODE 0
+#endif /* LWPRINTF_CFG_ENABLE_BUFF_MODE */
+
+/**
+ * \brief           Enables `1` or disables `0` age based flush of staging buffer.
+ *
+ * When enabled, \ref lwprintf_auto_flush_ex, called periodically from timer or idle task,
+ * sends text that waits in staging buffer longer than age set with \ref lwprintf_set_auto_flush_ex
+ *
+ * \note            \ref LWPRINTF_CFG_ENABLE_BUFF_MODE must be enabled to use this feature.
+ *                  With \ref LWPRINTF_CFG_OS enabled, system layer must implement `lwprintf_sys_mutex_trywait`
+ */
+#ifndef LWPRINTF_CFG_ENABLE_AUTO_FLUSH
+#define LWPRINTF_CFG_ENABLE_AUTO_FLUSH 0
+#endif /* LWPRINTF_CFG_ENABLE_AUTO_FLUSH */
+
+/**
+ * \brief           Enables `1` or disables `0` low power flush policy of staging buffer.
+ *
+ * When enabled with \ref lwprintf_set_low_power_ex, text is kept in staging buffer until it reaches size threshold,
+ * message with priority level is printed with \ref lwprintf_printf_level_ex,
+ * or \ref lwprintf_idle_flush_ex is called before the system enters tickless idle.
+ * Output peripheral is woken up once per burst of text, instead of once per print call
+ *
+ * \note            \ref LWPRINTF_CFG_ENABLE_BUFF_MODE must be enabled to use this feature.
+ *                  With \ref LWPRINTF_CFG_OS enabled, system layer must implement `lwprintf_sys_mutex_trywait`
+ */
+#ifndef LWPRINTF_CFG_ENABLE_LOW_POWER
+#define LWPRINTF_CFG_ENABLE_LOW_POWER 0
+#endif /* LWPRINTF_CFG_ENABLE_LOW_POWER */
+
+/**
+ * \brief           Enables `1` or disables `0` coalescing of repeated records of block output instance.
+ *
+ * When enabled with \ref lwprintf_set_coalesce_ex, text of every print call is hashed at the end of the call
+ * and compared with the previous one. Repeated text is removed from staging buffer and only counted,
+ * and \ref LWPRINTF_CFG_COALESCE_REPORT is printed when different text comes or timeout expires
+ *
+ * \note            \ref LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT must be enabled to use this feature
+ */
+#ifndef LWPRINTF_CFG_ENABLE_COALESCE
+#define LWPRINTF_CFG_ENABLE_COALESCE 0
+#endif /* LWPRINTF_CFG_ENABLE_COALESCE */
+
+/**
+ * \brief           Format of report of repeated records, with number of repeats as `unsigned long` argument
+ */
+#ifndef LWPRINTF_CFG_COALESCE_REPORT
+#define LWPRINTF_CFG_COALESCE_REPORT "last message repeated %lu times\n"
+#endif /* LWPRINTF_CFG_COALESCE_REPORT */
+
+/**
+ * \brief           Enables `1` or disables `0` precompiled format strings support.
+ *
+ * When enabled, format string can be parsed once with \ref lwprintf_compile
+ * and later used many times with `*_compiled_ex` functions, without parsing it again.
+ */
+#ifndef LWPRINTF_CFG_ENABLE_COMPILED_FORMAT
+#define LWPRINTF_CFG_ENABLE_COMPILED_FORMAT 0
+#endif /* LWPRINTF_CFG_ENABLE_COMPILED_FORMAT */
+
+/**
+ * \brief           Number of entries in per-instance parsed format cache. Set to `0` to disable the cache
+ *
+ * Cache is direct-mapped table, keyed by the address of format string.
+ * When the same format string is printed again, its parsed segments are taken from the cache,
+ * and flags, width, precision and length are not parsed again.
+ *
+ * \note            Format strings must be constant, as the cache only compares their addresses.
+ *                  Call \ref lwprintf_format_cache_clear_ex before memory of format string is reused
+ * \note            \ref LWPRINTF_CFG_ENABLE_COMPILED_FORMAT must be enabled to use this feature
+ * \sa              LWPRINTF_CFG_FORMAT_CACHE_SEGMENTS
+ */
+#ifndef LWPRINTF_CFG_FORMAT_CACHE_SIZE
+#define LWPRINTF_CFG_FORMAT_CACHE_SIZE 0
+#endif /* LWPRINTF_CFG_FORMAT_CACHE_SIZE */
+
+/**
+ * \brief           Maximum number of segments of format string in single cache entry
+ *
+ * Each literal text between specifiers, and each specifier, is one segment.
+ * Longer format strings are not cached and are parsed on every call.
+ *
+ * \note            It has effect only when \ref LWPRINTF_CFG_FORMAT_CACHE_SIZE is greater than `0`
+ */
+#ifndef LWPRINTF_CFG_FORMAT_CACHE_SEGMENTS
+#define LWPRINTF_CFG_FORMAT_CACHE_SEGMENTS 8
+#endif /* LWPRINTF_CFG_FORMAT_CACHE_SEGMENTS */
+
+/**
+ * \brief           Enables `1` or disables `0` formatting with packed arguments.
+ *
+ * When enabled, `*_packed_ex` functions read arguments from memory buffer, prepared by the caller,
+ * instead of variable argument list. C++ wrapper uses them to pass arguments by their types,
+ * floating point numbers are passed as \ref lwprintf_packed_float_t, without promotion to `double`
+ */
+#ifndef LWPRINTF_CFG_ENABLE_PACKED_ARGS
+#define LWPRINTF_CFG_ENABLE_PACKED_ARGS 0
+#endif /* LWPRINTF_CFG_ENABLE_PACKED_ARGS */
+
+/**
+ * \brief           Enables `1` or disables `0` tokenized output mode
+ *
+ * When enabled and turned on with \ref lwprintf_set_token_mode_ex, print functions of the instance
+ * send binary frame with address of format string and encoded arguments, instead of formatted text.
+ * Text is reconstructed on the host from the firmware ELF file, with `tools/lwprintf_detokenize.py` script
+ *
+ * \note            Token is the lower `32` bits of format string address. On 64-bit targets format strings
+ *                      must be placed below `4 GB`, otherwise different strings may get the same token
+ */
+#ifndef LWPRINTF_CFG_ENABLE_TOKEN
+#define LWPRINTF_CFG_ENABLE_TOKEN 0
+#endif /* LWPRINTF_CFG_ENABLE_TOKEN */
+
+/**
+ * \brief           Maximum size of single tokenized frame, in units of bytes
+ *
+ * Frame is built on the stack of the caller. Message with arguments exceeding this size is dropped
+ *
+ * \note            Used only when \ref LWPRINTF_CFG_ENABLE_TOKEN is enabled
+ */
+#ifndef LWPRINTF_CFG_TOKEN_FRAME_SIZE
+#define LWPRINTF_CFG_TOKEN_FRAME_SIZE 64
+#endif /* LWPRINTF_CFG_TOKEN_FRAME_SIZE */
+
+/**
+ * \brief           Enables `1` or disables `0` structured binary output in CBOR format.
+ *
+ * When instance is switched to CBOR mode with \ref lwprintf_set_cbor_mode_ex,
+ * print functions send one CBOR map per call instead of formatted text.
+ * Literal text before every specifier is the key, and the argument is the value
+ */
+#ifndef LWPRINTF_CFG_ENABLE_CBOR
+#define LWPRINTF_CFG_ENABLE_CBOR 0
+#endif /* LWPRINTF_CFG_ENABLE_CBOR */
+
+/**
+ * \brief           Maximum size of single CBOR map, in units of bytes
+ *
+ * Map is built on the stack of the caller. Message exceeding this size is dropped
+ *
+ * \note            Used only when \ref LWPRINTF_CFG_ENABLE_CBOR is enabled
+ */
+#ifndef LWPRINTF_CFG_CBOR_FRAME_SIZE
+#define LWPRINTF_CFG_CBOR_FRAME_SIZE 128
+#endif /* LWPRINTF_CFG_CBOR_FRAME_SIZE */
+
+/**
+ * \brief           Size of stack buffer, used by C++ wrapper to output text to sink without contiguous memory.
+ *
+ * Text is formatted to the buffer and sent to the sink with single call per buffer.
+ * Longer text is output in multiple parts when \ref LWPRINTF_CFG_ENABLE_RESUMABLE is enabled,
+ * otherwise it is formatted again to heap buffer of measured size
+ */
+#ifndef LWPRINTF_CFG_CPP_SINK_CHUNK_SIZE
+#define LWPRINTF_CFG_CPP_SINK_CHUNK_SIZE 64
+#endif /* LWPRINTF_CFG_CPP_SINK_CHUNK_SIZE */
+
+/**
+ * \brief           Specifier character, used by C++ wrapper for arguments with `Lwprintf::formatter` specialization.
+ *
+ * Specifier is registered to the instance with `Lwprintf::register_formatters`.
+ * It must not be used by any other specifier of the instance
+ *
+ * \note            It has effect only when \ref LWPRINTF_CFG_ENABLE_CUSTOM_SPEC is enabled
+ */
+#ifndef LWPRINTF_CFG_CPP_FORMATTER_SPEC
+#define LWPRINTF_CFG_CPP_FORMATTER_SPEC 'T'
+#endif /* LWPRINTF_CFG_CPP_FORMATTER_SPEC */
+
+/**
+ * \brief           Enables `1` or disables `0` deferred print mode.
+ *
+ * When enabled, instance can get ring buffer with \ref lwprintf_init_deferred_ex.
+ * Deferred print functions only store format pointer and raw arguments to the buffer,
+ * and formatting to the output is done later with \ref lwprintf_process_deferred_ex.
+ *
+ * \note            Strings and other pointer arguments are not copied,
+ *                  they must stay valid until message is processed
+ */
+#ifndef LWPRINTF_CFG_ENABLE_DEFERRED
+#define LWPRINTF_CFG_ENABLE_DEFERRED 0
+#endif /* LWPRINTF_CFG_ENABLE_DEFERRED */
+
+/**
+ * \brief           Maximum size of all arguments of single deferred message, in units of bytes
+ *
+ * Arguments are collected to the stack of the caller, before they are written to the ring buffer.
+ * Message with arguments exceeding this size is dropped
+ *
+ * \note            Used only when \ref LWPRINTF_CFG_ENABLE_DEFERRED is enabled
+ */
+#ifndef LWPRINTF_CFG_DEFERRED_ARGS_SIZE
+#define LWPRINTF_CFG_DEFERRED_ARGS_SIZE 64
+#endif /* LWPRINTF_CFG_DEFERRED_ARGS_SIZE */
+
+/**
+ * \brief           Enables `1` or disables `0` asynchronous print functions
+ *
+ * When enabled, instance can get output queue with \ref lwprintf_init_async_ex.
+ * Asynchronous print functions format text directly to the queue and return without waiting for the output.
+ * Queue is drained by the sink with \ref lwprintf_async_get_block_ex and \ref lwprintf_async_release_block_ex,
+ * or with \ref lwprintf_process_async_ex to the output function of the instance
+ */
+#ifndef LWPRINTF_CFG_ENABLE_ASYNC
+#define LWPRINTF_CFG_ENABLE_ASYNC 0
+#endif /* LWPRINTF_CFG_ENABLE_ASYNC */
+
+/**
+ * \brief           Number of priority lanes of asynchronous output queue
+ *
+ * Every lane has own memory, set with \ref lwprintf_init_async_prio_ex, and lane with higher index has higher priority.
+ * Sink always takes oldest message of the highest non-empty lane, hence high priority messages
+ * are sent ahead of already queued low priority messages, at message boundaries.
+ * Messages are dropped when their own lane is full, so low priority messages never take memory of high priority ones.
+ *
+ * Functions without priority parameter use lane `0`.
+ *
+ * \note            Used only when \ref LWPRINTF_CFG_ENABLE_ASYNC is enabled
+ */
+#ifndef LWPRINTF_CFG_ASYNC_PRIO_COUNT
+#define LWPRINTF_CFG_ASYNC_PRIO_COUNT 1
+#endif /* LWPRINTF_CFG_ASYNC_PRIO_COUNT */
+
+/**
+ * \brief           Enables `1` or disables `0` per-core instances with timestamp ordered merge
+ *
+ * When enabled, `lwprintf_smp.c` module provides one instance per core, each with own lock-free ring buffer.
+ * Every record gets global timestamp, and merge task sends records of all cores in time order to the final instance.
+ *
+ * \note            \ref LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT must be enabled to use this feature,
+ *                  and compiler must support C11 atomic operations
+ */
+#ifndef LWPRINTF_CFG_ENABLE_SMP
+#define LWPRINTF_CFG_ENABLE_SMP 0
+#endif /* LWPRINTF_CFG_ENABLE_SMP */
+
+/**
+ * \brief           Enables `1` or disables `0` persistent crash log in no-init RAM
+ *
+ * When enabled, `lwprintf_crashlog.c` module provides instance, that writes to the ring buffer in memory,
+ * not cleared by startup code. Header of the log is protected with CRC-32,
+ * and content is available for post-mortem read after warm reset. Full pages can optionally be spilled to flash.
+ *
+ * \note            \ref LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT must be enabled to use this feature
+ */
+#ifndef LWPRINTF_CFG_ENABLE_CRASHLOG
+#define LWPRINTF_CFG_ENABLE_CRASHLOG 0
+#endif /* LWPRINTF_CFG_ENABLE_CRASHLOG */
+
+/**
+ * \brief           Enables `1` or disables `0` streaming compression of the output
+ *
+ * When enabled, `lwprintf_compress.c` module provides instance, that compresses text with LZSS algorithm
+ * in small history window, before it is sent to the output function.
+ * Compressed stream is decoded on the host with `tools/lwprintf_decompress.py` script.
+ *
+ * \note            \ref LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT must be enabled to use this feature
+ */
+#ifndef LWPRINTF_CFG_ENABLE_COMPRESS
+#define LWPRINTF_CFG_ENABLE_COMPRESS 0
+#endif /* LWPRINTF_CFG_ENABLE_COMPRESS */
+
+/**
+ * \brief           Number of entries in hash table of compression object, to find repeated text
+ *
+ * Every entry takes `2` bytes of RAM in compression object. Value must be power of `2`.
+ */
+#ifndef LWPRINTF_CFG_COMPRESS_HASH_SIZE
+#define LWPRINTF_CFG_COMPRESS_HASH_SIZE 256
+#endif /* LWPRINTF_CFG_COMPRESS_HASH_SIZE */
+
+/**
+ * \brief           Enables `1` or disables `0` parallel formatting of many print jobs
+ *
+ * When enabled, `lwprintf_parallel.c` module formats array of jobs with packed arguments
+ * on multiple threads of application worker pool. Lengths of all jobs are measured first,
+ * and text of every job is then written to its own place in the shared output buffer, in order of jobs.
+ *
+ * \note            \ref LWPRINTF_CFG_ENABLE_PACKED_ARGS must be enabled to use this feature,
+ *                  and compiler must support C11 atomic operations
+ */
+#ifndef LWPRINTF_CFG_ENABLE_PARALLEL
+#define LWPRINTF_CFG_ENABLE_PARALLEL 0
+#endif /* LWPRINTF_CFG_ENABLE_PARALLEL */
+
+/**
+ * \brief           Enables `1` or disables `0` non-blocking print functions
+ *
+ * When enabled, \ref lwprintf_try_printf_ex returns \ref LWPRINTF_TRY_BUSY at once,
+ * when instance mutex is held by other thread or output function does not accept the text.
+ * Such messages are counted and reported as `[N dropped]` before the text of the next successful call.
+ *
+ * \note            With \ref LWPRINTF_CFG_OS enabled, system layer must implement `lwprintf_sys_mutex_trywait`
+ */
+#ifndef LWPRINTF_CFG_ENABLE_TRY_PRINT
+#define LWPRINTF_CFG_ENABLE_TRY_PRINT 0
+#endif /* LWPRINTF_CFG_ENABLE_TRY_PRINT */
+
+/**
+ * \brief           Enables `1` or disables `0` rate limited print macros
+ *
+ * When enabled, \ref lwprintf_printf_limited_ex keeps small state per call site and prints
+ * at most burst of messages per period. Messages over the limit are not formatted,
+ * and their number is printed as `[suppressed N messages]` before the text of the next printed message
+ */
+#ifndef LWPRINTF_CFG_ENABLE_RATE_LIMIT
+#define LWPRINTF_CFG_ENABLE_RATE_LIMIT 0
+#endif /* LWPRINTF_CFG_ENABLE_RATE_LIMIT */
+
+/**
+ * \brief           Enables `1` or disables `0` print functions with time budget
+ *
+ * When enabled, \ref lwprintf_vprintf_deadline_ex stops output when time budget runs out,
+ * before the next character or string is passed to the output, and ends the line with \ref LWPRINTF_CFG_DEADLINE_MARK.
+ * Rest of the text is lost
+ */
+#ifndef LWPRINTF_CFG_ENABLE_DEADLINE
+#define LWPRINTF_CFG_ENABLE_DEADLINE 0
+#endif /* LWPRINTF_CFG_ENABLE_DEADLINE */
+
+/**
+ * \brief           Text printed after the output stopped at deadline, to mark truncated line.
+ *
+ * It is printed after the budget ran out and its time is not limited. Set to `""` to stop without mark
+ */
+#ifndef LWPRINTF_CFG_DEADLINE_MARK
+#define LWPRINTF_CFG_DEADLINE_MARK "~\n"
+#endif /* LWPRINTF_CFG_DEADLINE_MARK */
+
+/**
+ * \brief           Enables `1` or disables `0` scatter-gather formatting to segments
+ *
+ * When enabled, \ref lwprintf_vformat_iov_ex outputs array of segments instead of single string.
+ * Literal text points to the format string, `%s` points to the string argument,
+ * and only converted numbers are written to the scratch buffer of the caller.
+ * Segments can be passed to `writev` or scatter DMA without copy
+ */
+#ifndef LWPRINTF_CFG_ENABLE_IOV
+#define LWPRINTF_CFG_ENABLE_IOV 0
+#endif /* LWPRINTF_CFG_ENABLE_IOV */
+
+/**
+ * \brief           Enables `1` or disables `0` growable string builder
+ *
+ * When enabled, \ref lwprintf_strbuf_append_ex appends formatted text to \ref lwprintf_strbuf_t,
+ * that grows by chunks taken from user arena or user pool allocator, without use of `malloc`
+ */
+#ifndef LWPRINTF_CFG_ENABLE_STRBUF
+#define LWPRINTF_CFG_ENABLE_STRBUF 0
+#endif /* LWPRINTF_CFG_ENABLE_STRBUF */
+
+/**
+ * \brief           Enables `1` or disables `0` allocating print functions
+ *
+ * When enabled, \ref lwprintf_asprintf_ex formats text to memory block of exact size,
+ * taken from the pool set with \ref lwprintf_set_pool_ex
+ *
+ * \sa              LWPRINTF_CFG_ASPRINTF_CHUNK_SIZE
+ */
+#ifndef LWPRINTF_CFG_ENABLE_ASPRINTF
+#define LWPRINTF_CFG_ENABLE_ASPRINTF 0
+#endif /* LWPRINTF_CFG_ENABLE_ASPRINTF */
+
+/**
+ * \brief           Size of first block and of every growth step, when pool can resize memory block in place
+ *
+ * \note            It has effect only when \ref LWPRINTF_CFG_ENABLE_ASPRINTF is enabled
+ */
+#ifndef LWPRINTF_CFG_ASPRINTF_CHUNK_SIZE
+#define LWPRINTF_CFG_ASPRINTF_CHUNK_SIZE 32
+#endif /* LWPRINTF_CFG_ASPRINTF_CHUNK_SIZE */
+
+/**
+ * \brief           Enables `1` or disables `0` runtime registration of custom specifiers
+ *
+ * When enabled, \ref lwprintf_register_specifier_ex sets handler for specifier character of the instance.
+ * Handler writes its output directly to the output of the running print call
+ *
+ * \sa              LWPRINTF_CFG_CUSTOM_SPEC_COUNT
+ */
+#ifndef LWPRINTF_CFG_ENABLE_CUSTOM_SPEC
+#define LWPRINTF_CFG_ENABLE_CUSTOM_SPEC 0
+#endif /* LWPRINTF_CFG_ENABLE_CUSTOM_SPEC */
+
+/**
+ * \brief           Maximum number of custom specifiers per instance
+ *
+ * \note            It has effect only when \ref LWPRINTF_CFG_ENABLE_CUSTOM_SPEC is enabled
+ */
+#ifndef LWPRINTF_CFG_CUSTOM_SPEC_COUNT
+#define LWPRINTF_CFG_CUSTOM_SPEC_COUNT 4
+#endif /* LWPRINTF_CFG_CUSTOM_SPEC_COUNT */
+
+/**
+ * \brief           Enables `1` or disables `0` timestamp and tag prefix at the start of every output line
+ *
+ * When enabled, \ref lwprintf_set_line_prefix_ex sets time function and tag of the instance.
+ * Prefix `[      1234.567] [tag] ` is written before the first character of every line of direct print output.
+ * Last rendered prefix is kept in the instance, and only digits that changed since previous line are rendered
+ *
+ * \sa              LWPRINTF_CFG_LINE_PREFIX_TAG_LEN
+ */
+#ifndef LWPRINTF_CFG_ENABLE_LINE_PREFIX
+#define LWPRINTF_CFG_ENABLE_LINE_PREFIX 0
+#endif /* LWPRINTF_CFG_ENABLE_LINE_PREFIX */
+
+/**
+ * \brief           Maximum length of line prefix tag, excluding brackets
+ *
+ * \note            It has effect only when \ref LWPRINTF_CFG_ENABLE_LINE_PREFIX is enabled
+ */
+#ifndef LWPRINTF_CFG_LINE_PREFIX_TAG_LEN
+#define LWPRINTF_CFG_LINE_PREFIX_TAG_LEN 8
+#endif /* LWPRINTF_CFG_LINE_PREFIX_TAG_LEN */
+
+/**
+ * \brief           Enables `1` or disables `0` log levels, filtered per instance before arguments are evaluated
+ *
+ * When enabled, \ref lwprintf_log_ex prints message only when its level is at least
+ * the level of the instance, set with \ref lwprintf_set_level_ex.
+ * Check is done by the macro, with one load and one compare, before arguments are evaluated
+ *
+ * \sa              LWPRINTF_CFG_LOG_LEVEL_MIN, LWPRINTF_CFG_LOG_MODULE_COUNT
+ */
+#ifndef LWPRINTF_CFG_ENABLE_LOG_LEVEL
+#define LWPRINTF_CFG_ENABLE_LOG_LEVEL 0
+#endif /* LWPRINTF_CFG_ENABLE_LOG_LEVEL */
+
+/**
+ * \brief           Minimum log level at compile time, also initial level of every instance and module.
+ *
+ * Calls with constant level below the minimum are removed by the compiler
+ *
+ * \note            It has effect only when \ref LWPRINTF_CFG_ENABLE_LOG_LEVEL is enabled
+ */
+#ifndef LWPRINTF_CFG_LOG_LEVEL_MIN
+#define LWPRINTF_CFG_LOG_LEVEL_MIN LWPRINTF_LEVEL_DEBUG
+#endif /* LWPRINTF_CFG_LOG_LEVEL_MIN */
+
+/**
+ * \brief           Number of modules with own log level per instance, used by \ref lwprintf_log_module_ex.
+ * Set to `0` to disable module levels
+ *
+ * \note            It has effect only when \ref LWPRINTF_CFG_ENABLE_LOG_LEVEL is enabled
+ */
+#ifndef LWPRINTF_CFG_LOG_MODULE_COUNT
+#define LWPRINTF_CFG_LOG_MODULE_COUNT 0
+#endif /* LWPRINTF_CFG_LOG_MODULE_COUNT */
+
+/**
+ * \brief           Enables `1` or disables `0` resumable formatting to small buffers
+ *
+ * When enabled, \ref lwprintf_format_continue outputs text chunk by chunk, to buffer of any size,
+ * such as transmit FIFO or USB endpoint. Every call continues where the previous one stopped,
+ * without formatting of previous text again
+ */
+#ifndef LWPRINTF_CFG_ENABLE_RESUMABLE
+#define LWPRINTF_CFG_ENABLE_RESUMABLE 0
+#endif /* LWPRINTF_CFG_ENABLE_RESUMABLE */
+
+/**
+ * \brief           Enables `1` or disables `0` string parsing with \ref lwprintf_sscanf_ex
+ *
+ * Parser supports subset of C `sscanf`, specifiers are selected with `LWPRINTF_CFG_SCANF_SUPPORT_TYPE_*` options.
+ * Floating-point parser shares power of 10 tables with the formatter
+ */
+#ifndef LWPRINTF_CFG_ENABLE_SCANF
+#define LWPRINTF_CFG_ENABLE_SCANF 0
+#endif /* LWPRINTF_CFG_ENABLE_SCANF */
+
+/**
+ * \brief           Enables `1` or disables `0` parsing of integer types.
+ *                  This is enabling `%d, %i, %u, %o, %x, %n` specifiers
+ *
+ * \note            \ref LWPRINTF_CFG_ENABLE_SCANF must be enabled to use this feature
+ */
+#ifndef LWPRINTF_CFG_SCANF_SUPPORT_TYPE_INT
+#define LWPRINTF_CFG_SCANF_SUPPORT_TYPE_INT 1
+#endif /* LWPRINTF_CFG_SCANF_SUPPORT_TYPE_INT */
+
+/**
+ * \brief           Enables `1` or disables `0` parsing of floating-point types.
+ *                  This is enabling `%f, %e, %g` specifiers, in decimal notation
+ *
+ * With \ref LWPRINTF_CFG_SUPPORT_LONG_LONG enabled, result is correctly rounded for up to `15` significant digits
+ * with decimal exponent of `-15` to `15`, relative to the last digit.
+ * Longer numbers may differ from C library by `1` or `2` units in the last place.
+ * Without `long long` type, mantissa keeps only `9` significant digits, the rest only changes the exponent.
+ *
+ * \note            \ref LWPRINTF_CFG_ENABLE_SCANF must be enabled to use this feature.
+ *                  It requires \ref LWPRINTF_CFG_SUPPORT_TYPE_FLOAT and disabled \ref LWPRINTF_CFG_FLOAT_SHORTEST
+ */
+#ifndef LWPRINTF_CFG_SCANF_SUPPORT_TYPE_FLOAT
+#define LWPRINTF_CFG_SCANF_SUPPORT_TYPE_FLOAT (LWPRINTF_CFG_SUPPORT_TYPE_FLOAT && !LWPRINTF_CFG_FLOAT_SHORTEST)
+#endif /* LWPRINTF_CFG_SCANF_SUPPORT_TYPE_FLOAT */
+
+/**
+ * \brief           Enables `1` or disables `0` parsing of strings and characters.
+ *                  This is enabling `%s, %c` specifiers
+ *
+ * \note            \ref LWPRINTF_CFG_ENABLE_SCANF must be enabled to use this feature
+ */
+#ifndef LWPRINTF_CFG_SCANF_SUPPORT_TYPE_STRING
+#define LWPRINTF_CFG_SCANF_SUPPORT_TYPE_STRING 1
+#endif /* LWPRINTF_CFG_SCANF_SUPPORT_TYPE_STRING */
+
+/**
+ * \brief           Enables `1` or disables `0` parsing of characters from the set.
+ *                  This is enabling `%[` specifier, with `^` negation and `a-z` ranges
+ *
+ * \note            \ref LWPRINTF_CFG_ENABLE_SCANF must be enabled to use this feature
+ */
+#ifndef LWPRINTF_CFG_SCANF_SUPPORT_TYPE_SCANSET
+#define LWPRINTF_CFG_SCANF_SUPPORT_TYPE_SCANSET 1
+#endif /* LWPRINTF_CFG_SCANF_SUPPORT_TYPE_SCANSET */
+
 /**
  * \brief           Enables `1` or disables `0` optional short names for LwPRINTF API functions.
  *
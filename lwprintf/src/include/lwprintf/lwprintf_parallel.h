@@ -0,0 +1,106 @@
+/**
+ * \file            lwprintf_parallel.h
+ * \brief           Parallel formatting of many print jobs
+ */
+
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwPRINTF - Lightweight stdio manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v1.0.6
+ */
+#ifndef LWPRINTF_PARALLEL_HDR_H
+#define LWPRINTF_PARALLEL_HDR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "lwprintf/lwprintf.h"
+
+#if LWPRINTF_CFG_ENABLE_PARALLEL || __DOXYGEN__
+
+#include <stdatomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \defgroup        LWPRINTF_PARALLEL Parallel formatting
+ * \brief           Parallel formatting of many print jobs
+ * \{
+ */
+
+/**
+ * \brief           Single print job
+ */
+typedef struct {
+    const char* format; /*!< Format string */
+    const void* args;   /*!< Packed arguments buffer, as described in \ref lwprintf_printf_packed_ex */
+} lwprintf_job_t;
+
+struct lwprintf_format_batch;
+
+/**
+ * \brief           Function to post single call of \ref lwprintf_format_batch_work to worker pool
+ * \param[in]       fb: Batch object, to pass to \ref lwprintf_format_batch_work
+ * \param[in]       arg: User argument
+ */
+typedef void (*lwprintf_format_batch_post_fn)(struct lwprintf_format_batch* fb, void* arg);
+
+/**
+ * \brief           Batch object, shared by all threads that format the jobs
+ */
+typedef struct lwprintf_format_batch {
+    lwprintf_t* lwobj;          /*!< Instance used for formatting */
+    const lwprintf_job_t* jobs; /*!< Array of jobs */
+    size_t jobs_cnt;            /*!< Number of jobs */
+    size_t* offsets;            /*!< Offsets of jobs in the arena, with `jobs_cnt + 1` entries */
+    char* arena;                /*!< Output buffer for text of all jobs */
+    size_t arena_size;          /*!< Size of output buffer in units of bytes */
+    atomic_size_t measure_next; /*!< Index of next job to measure */
+    atomic_size_t measure_done; /*!< Number of measured jobs */
+    atomic_size_t format_next;  /*!< Index of next job to format */
+    atomic_size_t active;       /*!< Number of posted worker calls, that did not return yet */
+    atomic_uint state;          /*!< Phase of the batch */
+} lwprintf_format_batch_t;
+
+uint8_t lwprintf_format_batch_init(lwprintf_format_batch_t* fb, lwprintf_t* lwobj, const lwprintf_job_t* jobs,
+                                   size_t jobs_cnt, size_t* offsets, char* arena, size_t arena_size);
+void lwprintf_format_batch_work(lwprintf_format_batch_t* fb);
+uint8_t lwprintf_format_batch(lwprintf_format_batch_t* fb, lwprintf_format_batch_post_fn post_fn, void* arg,
+                              size_t workers);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWPRINTF_CFG_ENABLE_PARALLEL || __DOXYGEN__ */
+
+#endif /* LWPRINTF_PARALLEL_HDR_H */
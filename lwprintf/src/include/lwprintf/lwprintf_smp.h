@@ -0,0 +1,108 @@
+/**
+ * \file            lwprintf_smp.h
+ * \brief           Per-core instances with timestamp ordered merge
+ */
+
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwPRINTF - Lightweight stdio manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v1.0.6
+ */
+#ifndef LWPRINTF_SMP_HDR_H
+#define LWPRINTF_SMP_HDR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "lwprintf/lwprintf.h"
+
+#if LWPRINTF_CFG_ENABLE_SMP || __DOXYGEN__
+
+#include <stdatomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \defgroup        LWPRINTF_SMP Per-core instances
+ * \brief           Per-core instances with timestamp ordered merge
+ * \{
+ */
+
+/**
+ * \brief           Global timestamp function, shared by all cores
+ * \return          Current time, in any unit with wrap-around at `32-bit` range
+ */
+typedef uint32_t (*lwprintf_smp_time_fn)(void);
+
+struct lwprintf_smp;
+
+/**
+ * \brief           Instance of single core, with ring buffer of timestamped records
+ *
+ * Ring buffer has single producer, that is the instance itself.
+ * Prints of the same core are serialized by instance mutex, or by printing from single task only
+ */
+typedef struct {
+    lwprintf_t lw;            /*!< Instance used to print from the core */
+    unsigned char* buff;      /*!< Ring buffer memory, aligned to `uint32_t` */
+    size_t size;              /*!< Size of ring buffer in units of bytes */
+    atomic_size_t r;          /*!< Read position, modified only by merge task */
+    atomic_size_t w;          /*!< Write position, modified only by the core */
+    uint32_t dropped;         /*!< Number of records dropped, when ring buffer was full */
+    struct lwprintf_smp* smp; /*!< Merge object */
+} lwprintf_smp_channel_t;
+
+/**
+ * \brief           Merge object for all cores
+ */
+typedef struct lwprintf_smp {
+    lwprintf_smp_channel_t* channels; /*!< Array of per-core instances */
+    size_t channels_cnt;              /*!< Number of per-core instances */
+    lwprintf_t* out;                  /*!< Final instance, that gets merged output */
+    lwprintf_smp_time_fn time_fn;     /*!< Global timestamp function */
+    uint32_t window;                  /*!< Time to wait for records of other cores, before record is sent */
+} lwprintf_smp_t;
+
+uint8_t lwprintf_smp_init(lwprintf_smp_t* smp, lwprintf_smp_channel_t* channels, size_t channels_cnt, lwprintf_t* out,
+                          lwprintf_smp_time_fn time_fn, uint32_t window);
+uint8_t lwprintf_smp_channel_init(lwprintf_smp_t* smp, size_t idx, void* buff, size_t buff_size, char* staging,
+                                  size_t staging_size);
+lwprintf_t* lwprintf_smp_get_instance(lwprintf_smp_t* smp, size_t idx);
+size_t lwprintf_smp_process(lwprintf_smp_t* smp);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWPRINTF_CFG_ENABLE_SMP || __DOXYGEN__ */
+
+#endif /* LWPRINTF_SMP_HDR_H */
@@ -0,0 +1,81 @@
+/**
+ * \file            lwprintf_mpsc.h
+ * \brief           Lock-free multi-producer, single-consumer ring buffer output
+ */
+
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwPRINTF - Lightweight stdio manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v1.0.6
+ */
+#ifndef LWPRINTF_MPSC_HDR_H
+#define LWPRINTF_MPSC_HDR_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "lwprintf/lwprintf.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \defgroup        LWPRINTF_MPSC Lock-free ring buffer output
+ * \brief           Multi-producer, single-consumer ring buffer output, used instead of OS mutex
+ * \{
+ */
+
+/**
+ * \brief           Lock-free ring buffer
+ *
+ * Every direct print call is one record in the buffer. Space is reserved with atomic compare-and-swap,
+ * hence any thread or core can print without waiting for the mutex. Single drain task sends records to the hardware
+ */
+typedef struct {
+    unsigned char* buff; /*!< Ring buffer memory, aligned to `size_t` */
+    size_t size;         /*!< Size of ring buffer in units of bytes, power of `2` */
+    atomic_size_t head;  /*!< Reserve position, incremented by producers */
+    atomic_size_t tail;  /*!< Release position, incremented by drain task */
+    size_t block_len;    /*!< Size of record currently taken by drain task, incl. header */
+} lwprintf_mpsc_t;
+
+uint8_t lwprintf_mpsc_init(lwprintf_mpsc_t* rb, void* buff, size_t size);
+uint8_t lwprintf_mpsc_attach(lwprintf_t* lwobj, lwprintf_mpsc_t* rb);
+int lwprintf_mpsc_out_block(const char* data, size_t len, lwprintf_t* lwobj);
+size_t lwprintf_mpsc_get_block(lwprintf_mpsc_t* rb, const char** data);
+void lwprintf_mpsc_release_block(lwprintf_mpsc_t* rb);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWPRINTF_MPSC_HDR_H */
@@ -0,0 +1,84 @@
+/**
+ * \file            lwprintf_sink_itm.h
+ * \brief           Block output sink for Cortex-M ITM stimulus port
+ */
+
+
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwPRINTF - Lightweight stdio manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v1.0.6
+ */
+#ifndef LWPRINTF_SINK_ITM_HDR_H
+#define LWPRINTF_SINK_ITM_HDR_H
+
+#include <stdint.h>
+#include "lwprintf/lwprintf.h"
+
+/*
+ * Add "system/lwprintf_sink_itm.c" to the build (LWPRINTF_SINK_PORT=itm with CMake),
+ * and use lwprintf_itm_block_fn as block output function:
+ *
+ * lwprintf_init_block(lwprintf_itm_block_fn, staging, sizeof(staging));
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \defgroup        LWPRINTF_SINK_ITM ITM sink
+ * \brief           Sends text to SWO trace output through ITM stimulus port, 4 characters per write
+ * \{
+ */
+
+/**
+ * \brief           Stimulus port used for text output, `0` to `31`
+ */
+#ifndef LWPRINTF_ITM_PORT
+#define LWPRINTF_ITM_PORT 0
+#endif /* LWPRINTF_ITM_PORT */
+
+/**
+ * \brief           Base address of ITM peripheral
+ */
+#ifndef LWPRINTF_ITM_BASE
+#define LWPRINTF_ITM_BASE 0xE0000000UL
+#endif /* LWPRINTF_ITM_BASE */
+
+uint8_t lwprintf_itm_is_enabled(void);
+int lwprintf_itm_block_fn(const char* data, size_t len, lwprintf_t* lwobj);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWPRINTF_SINK_ITM_HDR_H */
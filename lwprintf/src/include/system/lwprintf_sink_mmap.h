@@ -0,0 +1,118 @@
+/**
+ * \file            lwprintf_sink_mmap.h
+ * \brief           Block output sink for memory-mapped log file, used as ring buffer on Linux hosts
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwPRINTF - Lightweight stdio manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v1.0.6
+ */
+#ifndef LWPRINTF_SINK_MMAP_HDR_H
+#define LWPRINTF_SINK_MMAP_HDR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "lwprintf/lwprintf.h"
+
+/*
+ * Add "system/lwprintf_sink_mmap.c" to the build (LWPRINTF_SINK_PORT=mmap with CMake),
+ * open the log file and use lwprintf_mmap_block_fn as block output function:
+ *
+ * lwprintf_mmap_open(&lwprintf_mmap, "app.log", 16 * 1024 * 1024);
+ * lwprintf_mmap_set_sync(&lwprintf_mmap, LWPRINTF_MMAP_SYNC_MSYNC, 1024 * 1024, 1000);
+ * lwprintf_init_block(lwprintf_mmap_block_fn, staging, sizeof(staging));
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \defgroup        LWPRINTF_SINK_MMAP Memory-mapped file sink
+ * \brief           Writes text to memory-mapped log file, used as ring buffer, without system call per write
+ * \{
+ */
+
+/**
+ * \brief           Version of file header layout
+ */
+#define LWPRINTF_MMAP_VERSION 1
+
+/**
+ * \brief           Synchronization of written text to the storage
+ */
+typedef enum {
+    LWPRINTF_MMAP_SYNC_NONE = 0x00,      /*!< Kernel writes pages back in the background. Text survives process crash */
+    LWPRINTF_MMAP_SYNC_MSYNC = 0x01,     /*!< `msync` of pages, written since previous synchronization */
+    LWPRINTF_MMAP_SYNC_FDATASYNC = 0x02, /*!< `fdatasync` of the file */
+} lwprintf_mmap_sync_t;
+
+/**
+ * \brief           Header at the start of the file. Ring data starts at `data_offset`
+ */
+typedef struct {
+    char magic[8];        /*!< ID string `LWPRLOG`, written last when file is created */
+    uint32_t version;     /*!< Version of the layout, \ref LWPRINTF_MMAP_VERSION */
+    uint32_t data_offset; /*!< Offset of ring data from the start of the file, one page */
+    uint64_t data_size;   /*!< Size of ring data in units of bytes */
+    volatile uint64_t wr; /*!< Total number of written bytes. Next byte, or the oldest one of full ring,
+                                is at `wr % data_size` */
+} lwprintf_mmap_hdr_t;
+
+/**
+ * \brief           Memory-mapped file sink
+ */
+typedef struct {
+    lwprintf_mmap_hdr_t* hdr;       /*!< File header, start of the mapping. `NULL` when file is not open */
+    char* data;                     /*!< Ring data in the mapping */
+    size_t map_size;                /*!< Size of the mapping and the file in units of bytes */
+    int fd;                         /*!< File descriptor */
+    lwprintf_mmap_sync_t sync_mode; /*!< Synchronization type */
+    size_t sync_bytes;              /*!< Synchronize when this many bytes are written. Set to `0` to disable */
+    uint32_t sync_interval_ms;      /*!< Synchronize on write, this long after previous one. Set to `0` to disable */
+    uint64_t sync_wr;               /*!< Write offset at previous synchronization */
+    uint64_t sync_time;             /*!< Time of previous synchronization in units of milliseconds */
+} lwprintf_mmap_t;
+
+extern lwprintf_mmap_t lwprintf_mmap;
+
+uint8_t lwprintf_mmap_open(lwprintf_mmap_t* mm, const char* path, size_t size);
+void lwprintf_mmap_set_sync(lwprintf_mmap_t* mm, lwprintf_mmap_sync_t mode, size_t bytes, uint32_t interval_ms);
+size_t lwprintf_mmap_write(lwprintf_mmap_t* mm, const char* data, size_t len);
+uint8_t lwprintf_mmap_sync(lwprintf_mmap_t* mm);
+void lwprintf_mmap_close(lwprintf_mmap_t* mm);
+int lwprintf_mmap_block_fn(const char* data, size_t len, lwprintf_t* lwobj);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWPRINTF_SINK_MMAP_HDR_H */
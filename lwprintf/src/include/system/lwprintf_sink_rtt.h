@@ -0,0 +1,132 @@
+/**
+ * \file            lwprintf_sink_rtt.h
+ * \brief           Block output sink for ring buffer in RAM, read by debug probe with SEGGER RTT layout
+ */
+
+
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwPRINTF - Lightweight stdio manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v1.0.6
+ */
+#ifndef LWPRINTF_SINK_RTT_HDR_H
+#define LWPRINTF_SINK_RTT_HDR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "lwprintf/lwprintf.h"
+
+/*
+ * Add "system/lwprintf_sink_rtt.c" to the build (LWPRINTF_SINK_PORT=rtt with CMake),
+ * configure up buffer and use lwprintf_rtt_block_fn as block output function:
+ *
+ * lwprintf_rtt_init();
+ * lwprintf_rtt_config_up(0, "Terminal", rtt_buff, sizeof(rtt_buff), LWPRINTF_RTT_MODE_SKIP);
+ * lwprintf_init_block(lwprintf_rtt_block_fn, staging, sizeof(staging));
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \defgroup        LWPRINTF_SINK_RTT RTT sink
+ * \brief           Writes text to ring buffer in RAM, that debug probe reads in the background
+ * \{
+ */
+
+/**
+ * \brief           Number of up buffers (target to host) of control block
+ */
+#ifndef LWPRINTF_RTT_UP_CNT
+#define LWPRINTF_RTT_UP_CNT 1
+#endif /* LWPRINTF_RTT_UP_CNT */
+
+/**
+ * \brief           Number of down buffers (host to target) of control block.
+ * Down buffers are not used by the library, they are only reserved for the probe
+ */
+#ifndef LWPRINTF_RTT_DOWN_CNT
+#define LWPRINTF_RTT_DOWN_CNT 1
+#endif /* LWPRINTF_RTT_DOWN_CNT */
+
+/**
+ * \brief           Memory barrier between write of the data and write of its offset, read by the probe
+ */
+#ifndef LWPRINTF_RTT_BARRIER
+#define LWPRINTF_RTT_BARRIER() atomic_thread_fence(memory_order_release)
+#endif /* LWPRINTF_RTT_BARRIER */
+
+/**
+ * \brief           Operating mode of up buffer, when it has no space for complete text
+ */
+typedef enum {
+    LWPRINTF_RTT_MODE_SKIP = 0x00,  /*!< Text is not written. Default mode */
+    LWPRINTF_RTT_MODE_TRIM = 0x01,  /*!< Only part of the text, that fits to the buffer, is written */
+    LWPRINTF_RTT_MODE_BLOCK = 0x02, /*!< Write waits for the probe to read the buffer */
+} lwprintf_rtt_mode_t;
+
+/**
+ * \brief           Ring buffer descriptor, same layout as SEGGER RTT buffer
+ */
+typedef struct {
+    const char* name;     /*!< Name of the buffer, shown by the probe software */
+    char* buff;           /*!< Ring buffer memory */
+    unsigned size;        /*!< Size of ring buffer in units of bytes */
+    volatile unsigned wr; /*!< Write offset, modified only by the target */
+    volatile unsigned rd; /*!< Read offset, modified only by the probe */
+    unsigned flags;       /*!< Operating mode, value of \ref lwprintf_rtt_mode_t */
+} lwprintf_rtt_buffer_t;
+
+/**
+ * \brief           Control block, same layout as SEGGER RTT control block.
+ * Probe finds it by its ID string in RAM
+ */
+typedef struct {
+    char id[16];                                       /*!< ID string `SEGGER RTT` */
+    int max_up;                                        /*!< Number of up buffers */
+    int max_down;                                      /*!< Number of down buffers */
+    lwprintf_rtt_buffer_t up[LWPRINTF_RTT_UP_CNT];     /*!< Up buffers, target to host */
+    lwprintf_rtt_buffer_t down[LWPRINTF_RTT_DOWN_CNT]; /*!< Down buffers, host to target */
+} lwprintf_rtt_cb_t;
+
+extern lwprintf_rtt_cb_t lwprintf_rtt;
+
+void lwprintf_rtt_init(void);
+uint8_t lwprintf_rtt_config_up(size_t index, const char* name, char* buff, size_t size, lwprintf_rtt_mode_t mode);
+size_t lwprintf_rtt_write(size_t index, const char* data, size_t len);
+int lwprintf_rtt_block_fn(const char* data, size_t len, lwprintf_t* lwobj);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWPRINTF_SINK_RTT_HDR_H */
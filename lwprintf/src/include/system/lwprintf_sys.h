@@ -78,6 +78,60 @@ uint8_t lwprintf_sys_mutex_wait(LWPRINTF_CFG_OS_MUTEX_HANDLE* m);
  */
 uint8_t lwprintf_sys_mutex_release(LWPRINTF_CFG_OS_MUTEX_HANDLE* m);
 
+#if LWPRINTF_CFG_ENABLE_TRY_PRINT || LWPRINTF_CFG_ENABLE_AUTO_FLUSH || LWPRINTF_CFG_ENABLE_LOW_POWER || __DOXYGEN__
+
+/**
+ * \brief           Try to take a mutex, without waiting when it is held by other thread
+ * \note            Function is required only when \ref LWPRINTF_CFG_ENABLE_TRY_PRINT,
+ *                  \ref LWPRINTF_CFG_ENABLE_AUTO_FLUSH or \ref LWPRINTF_CFG_ENABLE_LOW_POWER is enabled
+ * \param[in]       m: Mutex handle to take
+ * \return          `1` when mutex has been taken, `0` otherwise
+ */
+uint8_t lwprintf_sys_mutex_trywait(LWPRINTF_CFG_OS_MUTEX_HANDLE* m);
+
+#endif /* LWPRINTF_CFG_ENABLE_TRY_PRINT || LWPRINTF_CFG_ENABLE_AUTO_FLUSH || LWPRINTF_CFG_ENABLE_LOW_POWER \
+          || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_OS_ISR_DEFERRED || __DOXYGEN__
+
+/**
+ * \brief           Check if function is called from interrupt context
+ * \note            Function is required only when \ref LWPRINTF_CFG_OS_ISR_DEFERRED is enabled
+ * \return          `1` when called from interrupt, `0` otherwise
+ */
+uint8_t lwprintf_sys_is_isr(void);
+
+#endif /* LWPRINTF_CFG_OS_ISR_DEFERRED || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_OS_YIELD_CHUNK > 0 || __DOXYGEN__
+
+/**
+ * \brief           Give processor to other ready threads, called between output chunks while mutex is released
+ * \note            Function is required only when \ref LWPRINTF_CFG_OS_YIELD_CHUNK is greater than `0`
+ */
+void lwprintf_sys_yield(void);
+
+#endif /* LWPRINTF_CFG_OS_YIELD_CHUNK > 0 || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_OS_THREAD_DEFAULT || __DOXYGEN__
+
+/**
+ * \brief           Get default instance, bound to the calling thread
+ * \note            Function is required only when \ref LWPRINTF_CFG_OS_THREAD_DEFAULT is enabled
+ * \return          Instance of the thread, or `NULL` if none is bound
+ */
+lwprintf_t* lwprintf_sys_thread_default_get(void);
+
+/**
+ * \brief           Bind default instance to the calling thread
+ * \note            Function is required only when \ref LWPRINTF_CFG_OS_THREAD_DEFAULT is enabled
+ * \param[in]       lwobj: Instance of the thread. Set to `NULL` to remove binding
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t lwprintf_sys_thread_default_set(lwprintf_t* lwobj);
+
+#endif /* LWPRINTF_CFG_OS_THREAD_DEFAULT || __DOXYGEN__ */
+
 /**
  * \}
  */
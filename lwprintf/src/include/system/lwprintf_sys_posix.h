@@ -0,0 +1,96 @@
+/**
+ * \file            lwprintf_sys_posix.h
+ * \brief           System mutex type for POSIX
+ */
+
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwPRINTF - Lightweight stdio manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v1.0.6
+ */
+#ifndef LWPRINTF_SYS_POSIX_HDR_H
+#define LWPRINTF_SYS_POSIX_HDR_H
+
+#include <stdint.h>
+
+/*
+ * Header is included from "lwprintf_opts.h" file, to provide the mutex type:
+ *
+ * #define LWPRINTF_SYS_POSIX_FUTEX         1
+ * #include "system/lwprintf_sys_posix.h"
+ * #define LWPRINTF_CFG_OS_MUTEX_HANDLE     lwprintf_sys_posix_mutex_t
+ */
+
+/**
+ * \brief           Enables `1` or disables `0` spin-then-futex mutex, instead of `pthread` mutex.
+ *
+ * Print critical sections are short. Lock is first retried in user space
+ * for \ref LWPRINTF_SYS_POSIX_SPIN_COUNT times, and only then thread sleeps in the kernel.
+ *
+ * \note            Available on Linux only
+ */
+#ifndef LWPRINTF_SYS_POSIX_FUTEX
+#define LWPRINTF_SYS_POSIX_FUTEX 0
+#endif /* LWPRINTF_SYS_POSIX_FUTEX */
+
+/**
+ * \brief           Number of lock attempts before thread waits in the kernel
+ * \note            Used only when \ref LWPRINTF_SYS_POSIX_FUTEX is enabled
+ */
+#ifndef LWPRINTF_SYS_POSIX_SPIN_COUNT
+#define LWPRINTF_SYS_POSIX_SPIN_COUNT 100
+#endif /* LWPRINTF_SYS_POSIX_SPIN_COUNT */
+
+#if LWPRINTF_SYS_POSIX_FUTEX
+#include <stdatomic.h>
+#else
+#include <pthread.h>
+#endif /* LWPRINTF_SYS_POSIX_FUTEX */
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \brief           Recursive mutex for POSIX system port
+ */
+typedef struct {
+#if LWPRINTF_SYS_POSIX_FUTEX
+    atomic_int state;   /*!< Lock state: `0` unlocked, `1` locked, `2` locked with waiting threads */
+    atomic_long owner;  /*!< Kernel thread ID of the owner, `0` when unlocked */
+    unsigned int depth; /*!< Recursion depth, modified only by the owner */
+#else
+    pthread_mutex_t mutex; /*!< Recursive `pthread` mutex */
+#endif                     /* LWPRINTF_SYS_POSIX_FUTEX */
+    uint8_t valid;         /*!< Set to `1` when mutex is created */
+} lwprintf_sys_posix_mutex_t;
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWPRINTF_SYS_POSIX_HDR_H */
@@ -0,0 +1,126 @@
+/**
+ * \file            lwprintf_trace_sysview.h
+ * \brief           Trace hooks binding for SEGGER SystemView
+ */
+
+
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwPRINTF - Lightweight stdio manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v1.0.6
+ */
+#ifndef LWPRINTF_TRACE_SYSVIEW_HDR_H
+#define LWPRINTF_TRACE_SYSVIEW_HDR_H
+
+#include <stdint.h>
+#include "SEGGER_SYSVIEW.h"
+
+/*
+ * Header is included from "lwprintf_opts.h" file, to define trace hooks:
+ *
+ * #include "system/lwprintf_trace_sysview.h"
+ *
+ * Add "system/lwprintf_trace_sysview.c" to the build (LWPRINTF_TRACE_PORT=sysview with CMake),
+ * and call lwprintf_sysview_init() once SystemView is initialized
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \defgroup        LWPRINTF_TRACE_SYSVIEW SystemView trace binding
+ * \brief           Records formatting, mutex, conversion and output events as SystemView module
+ * \{
+ */
+
+/**
+ * \brief           Enables `1` or disables `0` event of every output function call.
+ *
+ * Character output calls output function for every character, that may overload the recorder
+ */
+#ifndef LWPRINTF_SYSVIEW_TRACE_SINK
+#define LWPRINTF_SYSVIEW_TRACE_SINK 1
+#endif /* LWPRINTF_SYSVIEW_TRACE_SINK */
+
+#define LWPRINTF_SYSVIEW_EVT_FORMAT        0 /*!< Formatting call, ends with number of characters */
+#define LWPRINTF_SYSVIEW_EVT_MUTEX_WAIT    1 /*!< Wait for mutex, ends with acquisition result */
+#define LWPRINTF_SYSVIEW_EVT_MUTEX_RELEASE 2 /*!< Release of mutex */
+#define LWPRINTF_SYSVIEW_EVT_CONV          3 /*!< Conversion of one specifier */
+#define LWPRINTF_SYSVIEW_EVT_SINK          4 /*!< Output function call, ends with result */
+#define LWPRINTF_SYSVIEW_EVT_CNT           5 /*!< Number of events of the module */
+
+extern SEGGER_SYSVIEW_MODULE lwprintf_sysview_module;
+
+void lwprintf_sysview_init(void);
+
+/**
+ * \brief           Get SystemView event ID of the module
+ * \param[in]       evt: Event, one of `LWPRINTF_SYSVIEW_EVT_*` values
+ */
+#define LWPRINTF_SYSVIEW_ID(evt)            (lwprintf_sysview_module.EventOffset + (evt))
+
+/**
+ * \brief           Get short SystemView ID of the instance
+ * \param[in]       lwobj: LwPRINTF instance
+ */
+#define LWPRINTF_SYSVIEW_OBJ(lwobj)         SEGGER_SYSVIEW_ShrinkId((U32)(uintptr_t)(lwobj))
+
+#if !__DOXYGEN__
+
+#define LWPRINTF_CFG_TRACE_FORMAT_START(lwobj, format)                                                                 \
+    SEGGER_SYSVIEW_RecordU32(LWPRINTF_SYSVIEW_ID(LWPRINTF_SYSVIEW_EVT_FORMAT), LWPRINTF_SYSVIEW_OBJ(lwobj))
+#define LWPRINTF_CFG_TRACE_FORMAT_END(lwobj, len)                                                                      \
+    SEGGER_SYSVIEW_RecordEndCallU32(LWPRINTF_SYSVIEW_ID(LWPRINTF_SYSVIEW_EVT_FORMAT), (U32)(len))
+#define LWPRINTF_CFG_TRACE_MUTEX_WAIT(lwobj)                                                                           \
+    SEGGER_SYSVIEW_RecordU32(LWPRINTF_SYSVIEW_ID(LWPRINTF_SYSVIEW_EVT_MUTEX_WAIT), LWPRINTF_SYSVIEW_OBJ(lwobj))
+#define LWPRINTF_CFG_TRACE_MUTEX_ACQUIRED(lwobj, is_acquired)                                                          \
+    SEGGER_SYSVIEW_RecordEndCallU32(LWPRINTF_SYSVIEW_ID(LWPRINTF_SYSVIEW_EVT_MUTEX_WAIT), (U32)(is_acquired))
+#define LWPRINTF_CFG_TRACE_MUTEX_RELEASE(lwobj)                                                                        \
+    SEGGER_SYSVIEW_RecordU32(LWPRINTF_SYSVIEW_ID(LWPRINTF_SYSVIEW_EVT_MUTEX_RELEASE), LWPRINTF_SYSVIEW_OBJ(lwobj))
+#define LWPRINTF_CFG_TRACE_CONV_START(lwobj, spec)                                                                     \
+    SEGGER_SYSVIEW_RecordU32(LWPRINTF_SYSVIEW_ID(LWPRINTF_SYSVIEW_EVT_CONV), (U32)(unsigned char)(spec))
+#define LWPRINTF_CFG_TRACE_CONV_END(lwobj, spec)                                                                       \
+    SEGGER_SYSVIEW_RecordEndCall(LWPRINTF_SYSVIEW_ID(LWPRINTF_SYSVIEW_EVT_CONV))
+#if LWPRINTF_SYSVIEW_TRACE_SINK
+#define LWPRINTF_CFG_TRACE_SINK_START(lwobj, len)                                                                      \
+    SEGGER_SYSVIEW_RecordU32(LWPRINTF_SYSVIEW_ID(LWPRINTF_SYSVIEW_EVT_SINK), (U32)(len))
+#define LWPRINTF_CFG_TRACE_SINK_END(lwobj, is_ok)                                                                      \
+    SEGGER_SYSVIEW_RecordEndCallU32(LWPRINTF_SYSVIEW_ID(LWPRINTF_SYSVIEW_EVT_SINK), (U32)(is_ok))
+#endif /* LWPRINTF_SYSVIEW_TRACE_SINK */
+
+#endif /* !__DOXYGEN__ */
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWPRINTF_TRACE_SYSVIEW_HDR_H */
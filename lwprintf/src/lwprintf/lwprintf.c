@@ -34,6 +34,7 @@
 #include "lwprintf/lwprintf.h"
 #include <float.h>
 #include <limits.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #if LWPRINTF_CFG_OS
@@ -44,52 +45,235 @@
 #if LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING && !LWPRINTF_CFG_SUPPORT_TYPE_FLOAT
 #error "Cannot use engineering type without float!"
 #endif /* LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING && !LWPRINTF_CFG_SUPPORT_TYPE_FLOAT */
+#if LWPRINTF_CFG_FLOAT_SHORTEST && !LWPRINTF_CFG_SUPPORT_TYPE_FLOAT
+#error "Cannot use shortest float engine without float!"
+#endif /* LWPRINTF_CFG_FLOAT_SHORTEST && !LWPRINTF_CFG_SUPPORT_TYPE_FLOAT */
+#if LWPRINTF_CFG_FLOAT_SHORTEST && DBL_MANT_DIG != 53
+#error "Shortest float engine requires IEEE-754 64-bit double type!"
+#endif /* LWPRINTF_CFG_FLOAT_SHORTEST && DBL_MANT_DIG != 53 */
+#if LWPRINTF_CFG_SUPPORT_TYPE_FLOAT_SINGLE && (!LWPRINTF_CFG_SUPPORT_TYPE_FLOAT || LWPRINTF_CFG_FLOAT_SHORTEST)
+#error "Single precision float engine requires float type, and cannot be used with shortest float engine!"
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FLOAT_SINGLE && (!LWPRINTF_CFG_SUPPORT_TYPE_FLOAT || LWPRINTF_CFG_FLOAT_SHORTEST) */
+#if LWPRINTF_CFG_FLOAT_EXACT && (!LWPRINTF_CFG_SUPPORT_TYPE_FLOAT || DBL_MANT_DIG != 53)
+#error "Exact float output requires float type and IEEE-754 64-bit double!"
+#endif /* LWPRINTF_CFG_FLOAT_EXACT && (!LWPRINTF_CFG_SUPPORT_TYPE_FLOAT || DBL_MANT_DIG != 53) */
 #if !LWPRINTF_CFG_OS && LWPRINTF_CFG_OS_MANUAL_PROTECT
 #error "LWPRINTF_CFG_OS_MANUAL_PROTECT can only be used if LWPRINTF_CFG_OS is enabled"
 #endif /* !LWPRINTF_CFG_OS && LWPRINTF_CFG_OS_MANUAL_PROTECT */
+#if LWPRINTF_CFG_OS_ISR_DEFERRED && (!LWPRINTF_CFG_OS || !LWPRINTF_CFG_ENABLE_DEFERRED)
+#error "LWPRINTF_CFG_OS_ISR_DEFERRED can only be used if LWPRINTF_CFG_OS and LWPRINTF_CFG_ENABLE_DEFERRED are enabled"
+#endif /* LWPRINTF_CFG_OS_ISR_DEFERRED && (!LWPRINTF_CFG_OS || !LWPRINTF_CFG_ENABLE_DEFERRED) */
+
+#if LWPRINTF_CFG_OS_YIELD_CHUNK > 0                                                                                  \
+    && (!LWPRINTF_CFG_OS || LWPRINTF_CFG_OS_MANUAL_PROTECT || LWPRINTF_CFG_OS_ISR_DEFERRED)
+#error "LWPRINTF_CFG_OS_YIELD_CHUNK requires LWPRINTF_CFG_OS, without manual protection and interrupt deferred path"
+#endif /* LWPRINTF_CFG_OS_YIELD_CHUNK > 0 && (!LWPRINTF_CFG_OS || ...) */
+
+#if LWPRINTF_CFG_OS_THREAD_DEFAULT && !LWPRINTF_CFG_OS
+#error "LWPRINTF_CFG_OS_THREAD_DEFAULT can only be used if LWPRINTF_CFG_OS is enabled"
+#endif /* LWPRINTF_CFG_OS_THREAD_DEFAULT && !LWPRINTF_CFG_OS */
+
+#if LWPRINTF_CFG_OS_YIELD_CHUNK > 0 && !LWPRINTF_CFG_ENABLE_DEFERRED
+#error "LWPRINTF_CFG_OS_YIELD_CHUNK can only be used if LWPRINTF_CFG_ENABLE_DEFERRED is enabled"
+#endif /* LWPRINTF_CFG_OS_YIELD_CHUNK > 0 && !LWPRINTF_CFG_ENABLE_DEFERRED */
+
+#if LWPRINTF_CFG_OS_STATS && !LWPRINTF_CFG_OS
+#error "LWPRINTF_CFG_OS_STATS can only be used if LWPRINTF_CFG_OS is enabled"
+#endif /* LWPRINTF_CFG_OS_STATS && !LWPRINTF_CFG_OS */
+
+#if LWPRINTF_CFG_STATS_OUT_HIST_BUCKETS > 0 && !LWPRINTF_CFG_STATS
+#error "LWPRINTF_CFG_STATS_OUT_HIST_BUCKETS can only be used if LWPRINTF_CFG_STATS is enabled"
+#endif /* LWPRINTF_CFG_STATS_OUT_HIST_BUCKETS > 0 && !LWPRINTF_CFG_STATS */
+
+#if LWPRINTF_CFG_ENABLE_FANOUT && (!LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT || LWPRINTF_CFG_FANOUT_SINK_COUNT > 32)
+#error "LWPRINTF_CFG_ENABLE_FANOUT requires LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT, with up to 32 sinks"
+#endif /* LWPRINTF_CFG_ENABLE_FANOUT && (!LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT || LWPRINTF_CFG_FANOUT_SINK_COUNT > 32) */
+
+#if LWPRINTF_CFG_ENABLE_BUFF_MODE && !LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT
+#error "LWPRINTF_CFG_ENABLE_BUFF_MODE can only be used if LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT is enabled"
+#endif /* LWPRINTF_CFG_ENABLE_BUFF_MODE && !LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT */
+
+#if LWPRINTF_CFG_ENABLE_AUTO_FLUSH && !LWPRINTF_CFG_ENABLE_BUFF_MODE
+#error "LWPRINTF_CFG_ENABLE_AUTO_FLUSH can only be used if LWPRINTF_CFG_ENABLE_BUFF_MODE is enabled"
+#endif /* LWPRINTF_CFG_ENABLE_AUTO_FLUSH && !LWPRINTF_CFG_ENABLE_BUFF_MODE */
+
+#if LWPRINTF_CFG_ENABLE_LOW_POWER && !LWPRINTF_CFG_ENABLE_BUFF_MODE
+#error "LWPRINTF_CFG_ENABLE_LOW_POWER can only be used if LWPRINTF_CFG_ENABLE_BUFF_MODE is enabled"
+#endif /* LWPRINTF_CFG_ENABLE_LOW_POWER && !LWPRINTF_CFG_ENABLE_BUFF_MODE */
+
+#if LWPRINTF_CFG_ENABLE_COALESCE && !LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT
+#error "LWPRINTF_CFG_ENABLE_COALESCE can only be used if LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT is enabled"
+#endif /* LWPRINTF_CFG_ENABLE_COALESCE && !LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT */
+
+#if LWPRINTF_CFG_ASYNC_PRIO_COUNT < 1 || LWPRINTF_CFG_ASYNC_PRIO_COUNT > 255
+#error "LWPRINTF_CFG_ASYNC_PRIO_COUNT must be between 1 and 255"
+#endif /* LWPRINTF_CFG_ASYNC_PRIO_COUNT < 1 || LWPRINTF_CFG_ASYNC_PRIO_COUNT > 255 */
+
+#if LWPRINTF_CFG_FORMAT_CACHE_SIZE > 0 && !LWPRINTF_CFG_ENABLE_COMPILED_FORMAT
+#error "LWPRINTF_CFG_FORMAT_CACHE_SIZE can only be used if LWPRINTF_CFG_ENABLE_COMPILED_FORMAT is enabled"
+#endif /* LWPRINTF_CFG_FORMAT_CACHE_SIZE > 0 && !LWPRINTF_CFG_ENABLE_COMPILED_FORMAT */
+
+#if LWPRINTF_CFG_ENABLE_SCANF && LWPRINTF_CFG_SCANF_SUPPORT_TYPE_FLOAT                                                 \
+    && (!LWPRINTF_CFG_SUPPORT_TYPE_FLOAT || LWPRINTF_CFG_FLOAT_SHORTEST)
+#error "LWPRINTF_CFG_SCANF_SUPPORT_TYPE_FLOAT requires float support without LWPRINTF_CFG_FLOAT_SHORTEST"
+#endif /* LWPRINTF_CFG_ENABLE_SCANF && LWPRINTF_CFG_SCANF_SUPPORT_TYPE_FLOAT                                           \
+          && (!LWPRINTF_CFG_SUPPORT_TYPE_FLOAT || LWPRINTF_CFG_FLOAT_SHORTEST) */
 
 #define CHARISNUM(x)     ((x) >= '0' && (x) <= '9')
 #define CHARTONUM(x)     ((x) - '0')
 #define IS_PRINT_MODE(p) ((p)->out_fn == prv_out_fn_print)
+#define IS_MEASURE_MODE(p) ((p)->out_fn == prv_out_fn_measure)
+
+/**
+ * \brief           Check if instance has any output function set for direct print operations
+ * \param[in]       obj: LwPRINTF instance
+ */
+#if LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT
+#define IS_OUTPUT_SET(obj) ((obj)->out_fn != NULL || (obj)->out_block_fn != NULL)
+#else
+#define IS_OUTPUT_SET(obj) ((obj)->out_fn != NULL)
+#endif /* LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT */
+
+/**
+ * \brief           Check if staging buffer of block output keeps text after the end of print call,
+ *                  and if new line character sends it to the output
+ * \param[in]       obj: LwPRINTF instance
+ */
+#if LWPRINTF_CFG_ENABLE_BUFF_MODE
+#define IS_BLOCK_KEPT(obj)      ((obj)->batch || (obj)->buff_mode != LWPRINTF_BUFF_MODE_NONE)
+#define IS_BLOCK_LINE_MODE(obj) (!(obj)->batch && (obj)->buff_mode == LWPRINTF_BUFF_MODE_LINE)
+#else
+#define IS_BLOCK_KEPT(obj)      ((obj)->batch)
+#define IS_BLOCK_LINE_MODE(obj) 0
+#endif /* LWPRINTF_CFG_ENABLE_BUFF_MODE */
+
+/**
+ * \brief           Check if new line character sends staging buffer to the output at once.
+ * With coalescing, line is sent at the end of print call, after it is compared with the previous one
+ * \param[in]       obj: LwPRINTF instance
+ */
+#if LWPRINTF_CFG_ENABLE_COALESCE
+#define IS_BLOCK_LINE_FLUSH(obj) (IS_BLOCK_LINE_MODE(obj) && !(obj)->coalesce)
+#else
+#define IS_BLOCK_LINE_FLUSH(obj) IS_BLOCK_LINE_MODE(obj)
+#endif /* LWPRINTF_CFG_ENABLE_COALESCE */
 
 /* Define custom types */
 #if LWPRINTF_CFG_SUPPORT_LONG_LONG
-typedef long long int float_long_t;
 typedef unsigned long long int uint_maxtype_t;
 typedef long long int int_maxtype_t;
+#define UINT_MAXTYPE_MAX ULLONG_MAX
 #else
-typedef long int float_long_t;
 typedef unsigned long int uint_maxtype_t;
 typedef long int int_maxtype_t;
+#define UINT_MAXTYPE_MAX ULONG_MAX
 #endif /* LWPRINTF_CFG_SUPPORT_LONG_LONG */
 
+/* Arguments are read from memory buffer, with deferred messages and packed arguments functions */
+#define PACKED_ARGS (LWPRINTF_CFG_ENABLE_DEFERRED || LWPRINTF_CFG_ENABLE_PACKED_ARGS)
+
+/* Single precision engine avoids 64-bit conversions, these are software library calls too */
+#define FLOAT_LONG_LONG (LWPRINTF_CFG_SUPPORT_LONG_LONG && !LWPRINTF_CFG_SUPPORT_TYPE_FLOAT_SINGLE)
+#if FLOAT_LONG_LONG
+typedef long long int float_long_t;
+#else
+typedef long int float_long_t;
+#endif /* FLOAT_LONG_LONG */
+#if LWPRINTF_CFG_SUPPORT_TYPE_FLOAT_SINGLE
+typedef float float_type_t;
+#define FLOAT_TYPE_MAX FLT_MAX
+#define FLOAT_TYPE_MIN FLT_MIN
+#else
+typedef double float_type_t;
+#define FLOAT_TYPE_MAX DBL_MAX
+#define FLOAT_TYPE_MIN DBL_MIN
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FLOAT_SINGLE */
+
 /**
  * \brief           Float number splitted by parts
  */
 typedef struct {
     float_long_t integer_part; /*!< Integer type of double number */
-    double decimal_part_dbl;   /*!< Decimal part of double number multiplied by 10^precision */
     float_long_t decimal_part; /*!< Decimal part of double number in integer format */
-    double diff;               /*!< Difference between decimal parts (double - int) */
 
     short digits_cnt_integer_part;        /*!< Number of digits for integer part */
     short digits_cnt_decimal_part;        /*!< Number of digits for decimal part */
     short digits_cnt_decimal_part_useful; /*!< Number of useful digits to print */
 } float_num_t;
 
-#if LWPRINTF_CFG_SUPPORT_TYPE_FLOAT
+#if LWPRINTF_CFG_SUPPORT_TYPE_FLOAT && !LWPRINTF_CFG_FLOAT_SHORTEST
 /* Powers of 10 from beginning up to precision level */
 static const float_long_t powers_of_10[] = {
     (float_long_t)1E00, (float_long_t)1E01, (float_long_t)1E02, (float_long_t)1E03, (float_long_t)1E04,
     (float_long_t)1E05, (float_long_t)1E06, (float_long_t)1E07, (float_long_t)1E08, (float_long_t)1E09,
-#if LWPRINTF_CFG_SUPPORT_LONG_LONG
+#if FLOAT_LONG_LONG
     (float_long_t)1E10, (float_long_t)1E11, (float_long_t)1E12, (float_long_t)1E13, (float_long_t)1E14,
     (float_long_t)1E15, (float_long_t)1E16, (float_long_t)1E17, (float_long_t)1E18,
-#endif /* LWPRINTF_CFG_SUPPORT_LONG_LONG */
+#endif /* FLOAT_LONG_LONG */
 };
-#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FLOAT */
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_FLOAT_SINGLE
+#define FLOAT_MAX_PRECISION 7 /*!< Decimal part multiplied by 10^7 stays exact within 24-bit mantissa */
+#else
+#define FLOAT_MAX_PRECISION ((int)LWPRINTF_ARRAYSIZE(powers_of_10) - 1)
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FLOAT_SINGLE */
+
+/* Rounding offset of `5e-15` is added up to this precision, where it stays below 1% of the last digit */
+#define FLOAT_ROUND_OFFSET_PRECISION 12
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING && LWPRINTF_CFG_SUPPORT_TYPE_FLOAT_SINGLE && FLT_MANT_DIG == 24            \
+    && FLT_MAX_EXP == 128
+#define FLOAT_IEEE754 1 /*!< Exponent can be read directly from binary representation */
+typedef uint32_t float_bits_t;
+#define FLOAT_MANT_BITS 23
+#define FLOAT_EXP_MASK  0xFF
+#define FLOAT_EXP_BIAS  127
+
+/* Powers of 10 to normalize number with 2 multiplications, 10^x = pwr10_hi[x / 16] * pwr10_lo[x % 16] */
+static const float pwr10_lo[] = {
+    1E00F, 1E01F, 1E02F, 1E03F, 1E04F, 1E05F, 1E06F, 1E07F, 1E08F, 1E09F, 1E10F, 1E11F, 1E12F, 1E13F, 1E14F, 1E15F,
+};
+static const float pwr10_hi[] = {
+    1E00F,
+    1E16F,
+    1E32F,
+};
+#elif LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING && !LWPRINTF_CFG_SUPPORT_TYPE_FLOAT_SINGLE && DBL_MANT_DIG == 53           \
+    && DBL_MAX_EXP == 1024
+#define FLOAT_IEEE754 1 /*!< Exponent can be read directly from binary representation */
+typedef uint64_t float_bits_t;
+#define FLOAT_MANT_BITS 52
+#define FLOAT_EXP_MASK  0x7FF
+#define FLOAT_EXP_BIAS  1023
+
+/* Powers of 10 to normalize number with 2 multiplications, 10^x = pwr10_hi[x / 16] * pwr10_lo[x % 16] */
+static const double pwr10_lo[] = {
+    1E00, 1E01, 1E02, 1E03, 1E04, 1E05, 1E06, 1E07, 1E08, 1E09, 1E10, 1E11, 1E12, 1E13, 1E14, 1E15,
+};
+static const double pwr10_hi[] = {
+    1E00,  1E16,  1E32,  1E48,  1E64,  1E80,  1E96,  1E112, 1E128, 1E144,
+    1E160, 1E176, 1E192, 1E208, 1E224, 1E240, 1E256, 1E272, 1E288, 1E304,
+};
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING && ... */
+
+/* Iterations of exponent normalization loop, used when exponent is not read from binary representation */
+#if LWPRINTF_CFG_WCET
+#define FLOAT_EXP_ITER_MAX LWPRINTF_CFG_WCET_MAX_EXP_ITER
+#else
+#define FLOAT_EXP_ITER_MAX INT_MAX
+#endif /* LWPRINTF_CFG_WCET */
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FLOAT && !LWPRINTF_CFG_FLOAT_SHORTEST */
 #define FLOAT_MAX_B_ENG (powers_of_10[LWPRINTF_ARRAYSIZE(powers_of_10) - 1])
 
+/* SI prefix type with `double` argument uses decimal exponent of engineering type */
+#define SI_FLOAT                                                                                                       \
+    (LWPRINTF_CFG_SUPPORT_TYPE_SI && LWPRINTF_CFG_SUPPORT_TYPE_FLOAT && LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING          \
+     && !LWPRINTF_CFG_FLOAT_SHORTEST)
+
+/* Fast path of `%f` is part of default float engine */
+#define FLOAT_FIXED_FAST                                                                                               \
+    (LWPRINTF_CFG_FLOAT_FIXED_FAST && LWPRINTF_CFG_SUPPORT_TYPE_FLOAT && !LWPRINTF_CFG_FLOAT_SHORTEST)
+
 /**
  * \brief           Check for negative input number before outputting signed integers
  * \param[in]       pp: Parsing object
@@ -115,836 +299,9085 @@ struct lwprintf_int;
  */
 typedef int (*prv_output_fn)(struct lwprintf_int* lwi, const char chr);
 
+/**
+ * \brief           Private output function declaration for string of characters
+ * \param[in]       lwi: Internal working structure
+ * \param[in]       str: String to print. It does not contain `NULL` character
+ * \param[in]       len: Number of characters to print
+ */
+typedef int (*prv_output_str_fn)(struct lwprintf_int* lwi, const char* str, size_t len);
+
+/**
+ * \brief           Private output function declaration to repeat the same character
+ * \param[in]       lwi: Internal working structure
+ * \param[in]       chr: Character to print. It must not be `NULL` character
+ * \param[in]       cnt: Number of times to print the character
+ */
+typedef int (*prv_output_fill_fn)(struct lwprintf_int* lwi, const char chr, size_t cnt);
+
+/**
+ * \brief           Parsed format specifier, reset every time new `%` is detected
+ */
+typedef struct {
+    struct {
+        uint8_t left_align : 1; /*!< Minus for left alignment */
+        uint8_t plus       : 1; /*!< Prepend + for positive numbers on the output */
+        uint8_t space      : 1; /*!< Prepend spaces. Not used with plus modifier */
+        uint8_t zero : 1; /*!< Zero pad flag detection, add zeros if number length is less than width modifier */
+        uint8_t thousands   : 1; /*!< Thousands has grouping applied */
+        uint8_t alt         : 1; /*!< Alternate form with hash */
+        uint8_t precision   : 1; /*!< Precision flag has been used */
+        uint8_t array       : 1; /*!< Array of elements with `v` flag */
+
+        /* Length modified flags */
+        uint8_t longlong    : 2; /*!< Flag indicatin long-long number, used with 'l' (1) or 'll' (2) mode */
+        uint8_t char_short  : 2; /*!< Used for 'h' (1 = short) or 'hh' (2 = char) length modifier */
+        uint8_t sz_t        : 1; /*!< Status for size_t length integer type */
+        uint8_t umax_t      : 1; /*!< Status for uintmax_z length integer type */
+
+        uint8_t uc          : 1; /*!< Uppercase flag */
+        uint8_t is_negative : 1; /*!< Status if number is negative */
+        uint8_t is_num_zero : 1; /*!< Status if input number is zero */
+    } flags;                     /*!< List of flags */
+
+    int precision; /*!< Selected precision */
+    int width;     /*!< Text width indicator */
+    uint8_t base;  /*!< Base for number format output */
+    uint8_t qbits; /*!< Number of fractional bits of fixed-point type */
+    char type;     /*!< Format type */
+} format_spec_t;
+
+#define SPEC_STAR_WIDTH     0x01 /*!< Width is taken from argument list */
+#define SPEC_STAR_PRECISION 0x02 /*!< Precision is taken from argument list */
+
+#if LWPRINTF_CFG_ENABLE_COMPILED_FORMAT
+
+/**
+ * \brief           Segment of precompiled format string
+ */
+typedef struct {
+    const char* str; /*!< Literal text, or type character of the specifier in original format */
+    size_t len;      /*!< Length of literal text. Set to `0` for specifier */
+    uint8_t star;    /*!< Width and precision arguments, combination of `SPEC_STAR_*` values */
+    format_spec_t m; /*!< Parsed specifier */
+} compiled_op_t;
+
+/* Public storage size macro must cover single segment */
+typedef char compiled_op_size_check_t[sizeof(compiled_op_t) <= LWPRINTF_COMPILED_STORAGE_SIZE(1) ? 1 : -1];
+
+#endif /* LWPRINTF_CFG_ENABLE_COMPILED_FORMAT */
+
+#if LWPRINTF_CFG_ENABLE_DEFERRED
+
+/**
+ * \brief           Largest argument type, used for alignment of deferred messages
+ */
+typedef union {
+    uint_maxtype_t u; /*!< Longest integer */
+    uintmax_t umax;   /*!< Maximum width integer */
+    double d;         /*!< Double number */
+    const void* ptr;  /*!< Any pointer */
+    size_t sz;        /*!< Size type */
+} deferred_align_t;
+
+/**
+ * \brief           Header of deferred message in the ring buffer, followed by arguments
+ */
+typedef struct {
+    size_t len;      /*!< Full message length, including header and padding. `0` means wrap to buffer beginning */
+    const char* fmt; /*!< Format string */
+} deferred_hdr_t;
+
+/**
+ * \brief           Round up length to the alignment of deferred messages
+ * \param[in]       x: Length or position to round up
+ * \param[in]       a: Alignment, must be power of `2`
+ */
+#define DEFERRED_ALIGN_UP(x, a) (((x) + (a) - 1) & ~((size_t)(a) - 1))
+#define DEFERRED_HDR_SIZE       DEFERRED_ALIGN_UP(sizeof(deferred_hdr_t), sizeof(deferred_align_t))
+#define DEFERRED_ARGS_CNT                                                                                              \
+    ((LWPRINTF_CFG_DEFERRED_ARGS_SIZE + sizeof(deferred_align_t) - 1) / sizeof(deferred_align_t))
+
+#endif /* LWPRINTF_CFG_ENABLE_DEFERRED */
+
+#if LWPRINTF_CFG_ENABLE_ASYNC
+
+/**
+ * \brief           Alignment unit of asynchronous messages in the output queue
+ */
+typedef union {
+    size_t sz;                 /*!< Size type */
+    void* ptr;                 /*!< Any pointer */
+    lwprintf_async_done_fn fn; /*!< Function pointer */
+} async_align_t;
+
+/**
+ * \brief           Header of asynchronous message in the output queue, followed by formatted text
+ */
+typedef struct {
+    size_t len;                     /*!< Full message length, including header and padding. `0` means wrap */
+    size_t text_len;                /*!< Length of formatted text */
+    lwprintf_async_done_fn done_fn; /*!< Completion callback */
+    void* done_arg;                 /*!< Completion callback argument */
+} async_hdr_t;
+
+/**
+ * \brief           Round up length to the alignment of asynchronous messages
+ * \param[in]       x: Length or position to round up
+ */
+#define ASYNC_ALIGN_UP(x) (((x) + sizeof(async_align_t) - 1) & ~(sizeof(async_align_t) - 1))
+#define ASYNC_HDR_SIZE    ASYNC_ALIGN_UP(sizeof(async_hdr_t))
+
+#endif /* LWPRINTF_CFG_ENABLE_ASYNC */
+
+#if LWPRINTF_CFG_ENABLE_IOV
+
+/**
+ * \brief           State of scatter-gather formatting
+ */
+typedef struct {
+    lwprintf_iov_t* iov; /*!< Array of segments */
+    size_t iov_max;      /*!< Number of segments in the array */
+    size_t iov_cnt;      /*!< Number of used segments */
+    char* arena;         /*!< Scratch buffer for converted text */
+    size_t arena_size;   /*!< Size of scratch buffer in units of bytes */
+    size_t arena_len;    /*!< Used part of scratch buffer */
+} iov_state_t;
+
+#endif /* LWPRINTF_CFG_ENABLE_IOV */
+
+#if LWPRINTF_CFG_ENABLE_STRBUF
+
+/**
+ * \brief           Alignment of string builder chunks in the arena
+ */
+typedef union {
+    void* ptr;
+    size_t size;
+} strbuf_align_t;
+
+/**
+ * \brief           Round up arena position to the alignment of string builder chunks
+ */
+#define STRBUF_ALIGN_UP(x) (((x) + sizeof(strbuf_align_t) - 1) & ~(sizeof(strbuf_align_t) - 1))
+
+#endif /* LWPRINTF_CFG_ENABLE_STRBUF */
+
+#if LWPRINTF_CFG_ENABLE_ASPRINTF
+
+/**
+ * \brief           Memory block of allocating print functions, written while it grows in place
+ */
+typedef struct {
+    const lwprintf_pool_t* pool; /*!< Memory pool */
+    char* buff;                  /*!< Memory block */
+    size_t size;                 /*!< Size of memory block in units of bytes */
+    uint8_t is_full;             /*!< Set to `1` when block could not grow, only length is counted */
+} asprintf_state_t;
+
+#endif /* LWPRINTF_CFG_ENABLE_ASPRINTF */
+
 /**
  * \brief           Internal structure
  */
 typedef struct lwprintf_int {
-    lwprintf_t* lwobj;          /*!< Instance handle */
-    const char* fmt;            /*!< Format string */
-    char* const buff;           /*!< Pointer to buffer when not using print option */
-    const size_t buff_size;     /*!< Buffer size of input buffer (when used) */
-    size_t n_len;               /*!< Full length of formatted text */
-    prv_output_fn out_fn;       /*!< Output internal function */
-    uint8_t is_print_cancelled; /*!< Status if print should be cancelled */
-
-    /* This must all be reset every time new % is detected */
-    struct {
-        struct {
-            uint8_t left_align : 1; /*!< Minus for left alignment */
-            uint8_t plus       : 1; /*!< Prepend + for positive numbers on the output */
-            uint8_t space      : 1; /*!< Prepend spaces. Not used with plus modifier */
-            uint8_t zero : 1; /*!< Zero pad flag detection, add zeros if number length is less than width modifier */
-            uint8_t thousands   : 1; /*!< Thousands has grouping applied */
-            uint8_t alt         : 1; /*!< Alternate form with hash */
-            uint8_t precision   : 1; /*!< Precision flag has been used */
-
-            /* Length modified flags */
-            uint8_t longlong    : 2; /*!< Flag indicatin long-long number, used with 'l' (1) or 'll' (2) mode */
-            uint8_t char_short  : 2; /*!< Used for 'h' (1 = short) or 'hh' (2 = char) length modifier */
-            uint8_t sz_t        : 1; /*!< Status for size_t length integer type */
-            uint8_t umax_t      : 1; /*!< Status for uintmax_z length integer type */
-
-            uint8_t uc          : 1; /*!< Uppercase flag */
-            uint8_t is_negative : 1; /*!< Status if number is negative */
-            uint8_t is_num_zero : 1; /*!< Status if input number is zero */
-        } flags;                     /*!< List of flags */
-
-        int precision; /*!< Selected precision */
-        int width;     /*!< Text width indicator */
-        uint8_t base;  /*!< Base for number format output */
-        char type;     /*!< Format type */
-    } m;               /*!< Block that is reset on every start of format */
+    lwprintf_t* lwobj;              /*!< Instance handle */
+    const char* fmt;                /*!< Format string */
+    char* const buff;               /*!< Pointer to buffer when not using print option */
+    const size_t buff_max_len;      /*!< Maximum number of characters to write to buffer, excl. `NULL` character */
+    size_t n_len;                   /*!< Full length of formatted text */
+    prv_output_fn out_fn;           /*!< Output internal function */
+    prv_output_str_fn out_str_fn;   /*!< Output internal function for string of characters */
+    prv_output_fill_fn out_fill_fn; /*!< Output internal function for repeated character */
+    uint8_t is_print_cancelled;     /*!< Status if print should be cancelled */
+#if LWPRINTF_CFG_ENABLE_COMPILED_FORMAT
+    const compiled_op_t* ops; /*!< Precompiled format segments. Set to `NULL` to use format string */
+    size_t ops_cnt;           /*!< Number of precompiled segments */
+#endif                        /* LWPRINTF_CFG_ENABLE_COMPILED_FORMAT */
+#if PACKED_ARGS
+    const unsigned char* dargs; /*!< Captured or packed arguments. Set to `NULL` to use `va_list` */
+    size_t dargs_pos;           /*!< Read position in captured arguments */
+#endif                          /* PACKED_ARGS */
+#if LWPRINTF_CFG_ENABLE_IOV
+    iov_state_t* iov; /*!< Scatter-gather state. Set to `NULL` when not used */
+#endif                /* LWPRINTF_CFG_ENABLE_IOV */
+#if LWPRINTF_CFG_ENABLE_STRBUF
+    lwprintf_strbuf_t* sb; /*!< String builder for append operation */
+#endif                     /* LWPRINTF_CFG_ENABLE_STRBUF */
+#if LWPRINTF_CFG_ENABLE_ASPRINTF
+    asprintf_state_t* as; /*!< Memory block for allocating print operation */
+#endif                    /* LWPRINTF_CFG_ENABLE_ASPRINTF */
+#if LWPRINTF_CFG_ENABLE_RESUMABLE
+    lwprintf_resume_t* rs; /*!< Resumable formatting state, updated at start of every part. `NULL` when not used */
+#endif                     /* LWPRINTF_CFG_ENABLE_RESUMABLE */
+#if LWPRINTF_CFG_STATS
+    uint8_t is_stats_off; /*!< Set to `1` for internal formatting, that is not counted to statistics */
+#endif                    /* LWPRINTF_CFG_STATS */
+#if LWPRINTF_CFG_ENABLE_PACKED_ARGS
+    uint8_t is_shared; /*!< Set to `1` when instance is used by many threads, cache and statistics are not used */
+#endif                 /* LWPRINTF_CFG_ENABLE_PACKED_ARGS */
+#if LWPRINTF_CFG_ENABLE_DEADLINE
+    lwprintf_timestamp_fn deadline_time_fn; /*!< Timestamp function of time budget. `NULL` when not used */
+    uint32_t deadline_start;                /*!< Time at start of the print */
+    uint32_t deadline_budget;               /*!< Time budget of the print */
+#endif                                      /* LWPRINTF_CFG_ENABLE_DEADLINE */
+#if LWPRINTF_CFG_ENABLE_FANOUT
+    uint32_t sinks_skip; /*!< Bit mask of sinks, that do not receive the message, filtered by level or failed */
+#endif                   /* LWPRINTF_CFG_ENABLE_FANOUT */
+#if LWPRINTF_CFG_ENABLE_LOW_POWER
+    uint8_t is_priority; /*!< Set to `1` when message level requires kept text to be sent at the end of print call */
+#endif                   /* LWPRINTF_CFG_ENABLE_LOW_POWER */
+#if LWPRINTF_CFG_OS_YIELD_CHUNK > 0
+    uint8_t is_yield_on; /*!< Set to `1` when output yields after every chunk, mutex is held by this print */
+    size_t yield_cnt;    /*!< Number of characters sent since the last yield */
+#endif                   /* LWPRINTF_CFG_OS_YIELD_CHUNK > 0 */
+    format_spec_t m;  /*!< Block that is reset on every start of format */
 } lwprintf_int_t;
 
+#if PACKED_ARGS
+
+/**
+ * \brief           Get next argument from captured deferred message or packed arguments
+ * \param[in,out]   lwi: Internal working structure
+ * \param[in]       size: Size of argument type. Arguments are aligned to their size
+ * \return          Pointer to argument value
+ */
+static const void*
+prv_deferred_arg(struct lwprintf_int* lwi, size_t size) {
+    const unsigned char* ptr;
+
+    lwi->dargs_pos = (lwi->dargs_pos + size - 1) & ~(size - 1);
+    ptr = &lwi->dargs[lwi->dargs_pos];
+    lwi->dargs_pos += size;
+    return ptr;
+}
+
+/**
+ * \brief           Get next argument of selected type, from variable argument list or from deferred message
+ * \param[in]       lwi: Internal working structure
+ * \param[in]       arg: Variable argument list
+ * \param[in]       type: Argument type, after default argument promotion
+ */
+#define PRV_VA_ARG(lwi, arg, type)                                                                                     \
+    ((lwi)->dargs != NULL ? *(const type*)prv_deferred_arg((lwi), sizeof(type)) : va_arg((arg), type))
+
+/**
+ * \brief           Get next floating point argument, stored without promotion to `double` in memory buffer
+ * \param[in]       lwi: Internal working structure
+ * \param[in]       arg: Variable argument list
+ */
+#define PRV_VA_ARG_FLOAT(lwi, arg)                                                                                     \
+    ((lwi)->dargs != NULL                                                                                              \
+         ? (float_type_t) * (const lwprintf_packed_float_t*)prv_deferred_arg((lwi), sizeof(lwprintf_packed_float_t))   \
+         : (float_type_t)va_arg((arg), double))
+#else
+#define PRV_VA_ARG(lwi, arg, type) va_arg((arg), type)
+#define PRV_VA_ARG_FLOAT(lwi, arg) ((float_type_t)va_arg((arg), double))
+#endif /* PACKED_ARGS */
+
 /**
  * \brief           Get LwPRINTF instance based on user input
  * \param[in]       lwi: LwPRINTF instance.
  *                      Set to `NULL` for default instance
  */
+#if LWPRINTF_CFG_OS_THREAD_DEFAULT
+#define LWPRINTF_GET_LWOBJ(ptr) ((ptr) != NULL ? (ptr) : lwprintf_get_default())
+#else
 #define LWPRINTF_GET_LWOBJ(ptr) ((ptr) != NULL ? (ptr) : (&lwprintf_default))
+#endif /* LWPRINTF_CFG_OS_THREAD_DEFAULT */
 
 /**
- * \brief           LwPRINTF default structure used by application
+ * \brief           LwPRINTF default structure used by application.
+ * Level check macros read its level directly, when log levels are enabled
  */
+#if LWPRINTF_CFG_ENABLE_LOG_LEVEL
+lwprintf_t lwprintf_default;
+#else  /* LWPRINTF_CFG_ENABLE_LOG_LEVEL */
 static lwprintf_t lwprintf_default;
+#endif /* !LWPRINTF_CFG_ENABLE_LOG_LEVEL */
+
+#if LWPRINTF_CFG_STATS
 
 /**
- * \brief           Output function to print data
- * \param[in]       ptr: LwPRINTF internal instance
- * \param[in]       chr: Character to print
- * \return          `1` on success, `0` otherwise
+ * \brief           Get start time of output function call, for statistics
+ * \param[in]       obj: LwPRINTF instance
+ * \return          Timestamp, `0` without timestamp function
  */
-static int
-prv_out_fn_print(lwprintf_int_t* lwi, const char chr) {
-    if (lwi->is_print_cancelled) {
-        return 0;
-    }
+static uint32_t
+prv_stats_sink_start(lwprintf_t* obj) {
+    return obj->stats_time_fn != NULL ? obj->stats_time_fn() : 0;
+}
 
-    /* Send character to output */
-    if (!lwi->lwobj->out_fn(chr, lwi->lwobj)) {
-        lwi->is_print_cancelled = 1;
+/**
+ * \brief           Count output function call and its time
+ * \param[in,out]   obj: LwPRINTF instance
+ * \param[in]       start: Timestamp before the call
+ */
+static void
+prv_stats_sink_end(lwprintf_t* obj, uint32_t start) {
+    ++obj->stats.sink_calls;
+    if (obj->stats_time_fn != NULL) {
+        uint32_t time = obj->stats_time_fn() - start;
+
+        obj->stats.out_total += time;
+        if (time > obj->stats.out_max) {
+            obj->stats.out_max = time;
+        }
+#if LWPRINTF_CFG_STATS_OUT_HIST_BUCKETS > 0
+        {
+            /* Bucket is number of significant bits of the duration */
+            size_t bucket = 0;
+
+            for (; time > 0 && bucket < LWPRINTF_CFG_STATS_OUT_HIST_BUCKETS - 1; time >>= 1, ++bucket) {}
+            ++obj->stats.out_hist[bucket];
+        }
+#endif /* LWPRINTF_CFG_STATS_OUT_HIST_BUCKETS > 0 */
     }
-    if (chr != '\0' && !lwi->is_print_cancelled) {
-        ++lwi->n_len;
+}
+
+#endif /* LWPRINTF_CFG_STATS */
+
+#if LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT
+
+#if LWPRINTF_CFG_ENABLE_FANOUT
+
+/**
+ * \brief           Block output function of fan-out instance.
+ * It only marks the instance, sinks are called by \ref prv_fanout_send with state of the message
+ * \param[in]       data: Data to send
+ * \param[in]       len: Number of characters to send
+ * \param[in]       lwobj: LwPRINTF instance
+ * \return          `len` value
+ */
+static int
+prv_fanout_block_fn(const char* data, size_t len, lwprintf_t* lwobj) {
+    LWPRINTF_UNUSED(data);
+    LWPRINTF_UNUSED(lwobj);
+    return (int)len;
+}
+
+/**
+ * \brief           Send data to all sinks of fan-out instance, that receive current message.
+ * Sink that fails is skipped for the rest of the message, other sinks continue
+ * \param[in]       lwi: LwPRINTF internal instance
+ * \param[in]       data: Data to send
+ * \param[in]       len: Number of characters to send
+ * \return          `1`, fan-out output never cancels the print
+ */
+static int
+prv_fanout_send(lwprintf_int_t* lwi, const char* data, size_t len) {
+    lwprintf_t* obj = lwi->lwobj;
+
+    for (size_t i = 0; i < obj->sinks_cnt; ++i) {
+        if ((lwi->sinks_skip & (1UL << i)) == 0 && obj->sinks[i].fn(data, len, obj) != (int)len) {
+            lwi->sinks_skip |= 1UL << i;
+            ++obj->sinks[i].failures;
+        }
     }
     return 1;
 }
 
+#endif /* LWPRINTF_CFG_ENABLE_FANOUT */
+
 /**
- * \brief           Output function to generate buffer data
+ * \brief           Send data to the block output function
  * \param[in]       lwi: LwPRINTF internal instance
- * \param[in]       chr: Character to write
+ * \param[in]       data: Data to send
+ * \param[in]       len: Number of characters to send
  * \return          `1` on success, `0` otherwise
  */
 static int
-prv_out_fn_write_buff(lwprintf_int_t* lwi, const char chr) {
-    if (lwi->buff_size > 0 && lwi->n_len < (lwi->buff_size - 1) && lwi->buff != NULL) {
-        lwi->buff[lwi->n_len] = chr;
-        if (chr != '\0') {
-            lwi->buff[lwi->n_len + 1] = '\0';
-        }
+prv_out_block_send(lwprintf_int_t* lwi, const char* data, size_t len) {
+    int res;
+#if LWPRINTF_CFG_STATS
+    uint32_t start;
+#endif /* LWPRINTF_CFG_STATS */
+
+    if (len == 0) {
+        return 1;
     }
-    if (chr != '\0') {
-        ++lwi->n_len;
+    LWPRINTF_CFG_TRACE_SINK_START(lwi->lwobj, len);
+#if LWPRINTF_CFG_STATS
+    start = prv_stats_sink_start(lwi->lwobj);
+#endif /* LWPRINTF_CFG_STATS */
+#if LWPRINTF_CFG_ENABLE_FANOUT
+    if (lwi->lwobj->out_block_fn == prv_fanout_block_fn) {
+        res = prv_fanout_send(lwi, data, len);
+    } else
+#endif /* LWPRINTF_CFG_ENABLE_FANOUT */
+    {
+        res = lwi->lwobj->out_block_fn(data, len, lwi->lwobj) == (int)len;
     }
-    return 1;
+#if LWPRINTF_CFG_STATS
+    prv_stats_sink_end(lwi->lwobj, start);
+#endif /* LWPRINTF_CFG_STATS */
+    LWPRINTF_CFG_TRACE_SINK_END(lwi->lwobj, res);
+    if (!res) {
+        lwi->is_print_cancelled = 1;
+    }
+    return res;
 }
 
+#if LWPRINTF_CFG_ENABLE_COALESCE
+
 /**
- * \brief           Parse number from input string
- * \param[in,out]   format: Input text to process
- * \return          Parsed number
+ * \brief           Put report of repeated records to staging buffer, before the text at selected position.
+ * When report does not fit, text before the position and the report are sent to the output at once
+ * \param[in]       lwi: LwPRINTF internal instance
+ * \param[in]       pos: Position of the report in staging buffer
+ * \return          `1` on success, `0` otherwise
  */
 static int
-prv_parse_num(const char** format) {
-    int num = 0;
+prv_coalesce_report(lwprintf_int_t* lwi, size_t pos) {
+    lwprintf_t* obj = lwi->lwobj;
+    const size_t tail = obj->buff_len - pos;
+    char report[48];
+    size_t len;
+    int res = 1;
 
-    for (; CHARISNUM(**format); ++(*format)) {
-        num = (int)10 * num + CHARTONUM(**format);
+    len = (size_t)lwprintf_snprintf_ex(obj, report, sizeof(report), LWPRINTF_CFG_COALESCE_REPORT,
+                                       (unsigned long)obj->rec_repeat);
+    len = len < sizeof(report) ? len : sizeof(report) - 1;
+    obj->rec_repeat = 0;
+    if (obj->buff_len + len <= obj->buff_size) {
+        memmove(&obj->buff[pos + len], &obj->buff[pos], tail);
+        memcpy(&obj->buff[pos], report, len);
+    } else {
+        res = prv_out_block_send(lwi, obj->buff, pos) && prv_out_block_send(lwi, report, len);
+        memmove(obj->buff, &obj->buff[pos], tail);
+        obj->buff_len = tail;
+        len = 0;
     }
-    return num;
+    obj->buff_len += len;
+    return res;
 }
 
 /**
- * \brief           Format data that are printed before actual value
- * \param[in,out]   lwi: LwPRINTF internal instance
- * \param[in]       buff_size: Expected buffer size of output string
+ * \brief           Mark current record as partly sent, it is not compared with the previous one.
+ * Pending report of repeated records is put before it
+ * \param[in]       lwi: LwPRINTF internal instance
  * \return          `1` on success, `0` otherwise
  */
 static int
-prv_out_str_before(lwprintf_int_t* lwi, size_t buff_size) {
-    /* Check for width */
-    if (lwi->m.width > 0
-        /* If number is negative, add negative sign or if positive and has plus sign forced */
-        && (lwi->m.flags.is_negative || lwi->m.flags.plus)) {
-        --lwi->m.width;
-    }
+prv_coalesce_split(lwprintf_int_t* lwi) {
+    lwprintf_t* obj = lwi->lwobj;
 
-    /* Check for alternate mode */
-    if (lwi->m.flags.alt && !lwi->m.flags.is_num_zero) {
-        if (lwi->m.base == 8) {
-            if (lwi->m.width > 0) {
-                --lwi->m.width;
-            }
-        } else if (lwi->m.base == 16 || lwi->m.base == 2) {
-            if (lwi->m.width >= 2) {
-                lwi->m.width -= 2;
-            } else {
-                lwi->m.width = 0;
-            }
-        }
-    }
+    obj->rec_split = 1;
+    return obj->rec_repeat > 0 ? prv_coalesce_report(lwi, obj->rec_start) : 1;
+}
 
-    /* Add negative sign (or positive in case of + flag or space in case of space flag) before when zeros are used to fill width */
-    if (lwi->m.flags.zero) {
-        if (lwi->m.flags.is_negative) {
-            lwi->out_fn(lwi, '-');
-        } else if (lwi->m.flags.plus) {
-            lwi->out_fn(lwi, '+');
-        } else if (lwi->m.flags.space) {
-            lwi->out_fn(lwi, ' ');
-        }
-    }
+/**
+ * \brief           Compare record, finished by the end of print call, with the previous one.
+ * Repeated record is removed from staging buffer, different record ends the run of repeats
+ * \param[in]       lwi: LwPRINTF internal instance
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_coalesce_end(lwprintf_int_t* lwi) {
+    lwprintf_t* obj = lwi->lwobj;
+    const size_t len = obj->buff_len - obj->rec_start;
+    uint32_t hash = 0x811C9DC5UL;
+    int res = 1;
 
-    /* Check for flags output */
-    if (lwi->m.flags.alt && !lwi->m.flags.is_num_zero) {
-        if (lwi->m.base == 8) {
-            lwi->out_fn(lwi, '0');
-        } else if (lwi->m.base == 16) {
-            lwi->out_fn(lwi, '0');
-            lwi->out_fn(lwi, lwi->m.flags.uc ? 'X' : 'x');
-        } else if (lwi->m.base == 2) {
-            lwi->out_fn(lwi, '0');
-            lwi->out_fn(lwi, lwi->m.flags.uc ? 'B' : 'b');
-        }
+    if (obj->rec_split) {
+        obj->rec_split = 0;
+        obj->rec_len = 0;
+        return 1;
+    }
+    if (len == 0) {
+        return 1;
     }
 
-    /* Right alignment, spaces or zeros */
-    if (!lwi->m.flags.left_align && lwi->m.width > 0) {
-        for (size_t idx = buff_size; !lwi->m.flags.left_align && idx < (size_t)lwi->m.width; ++idx) {
-            lwi->out_fn(lwi, lwi->m.flags.zero ? '0' : ' ');
+    /* FNV-1a hash, together with the length, identifies the record */
+    for (size_t i = 0; i < len; ++i) {
+        hash = (hash ^ (unsigned char)obj->buff[obj->rec_start + i]) * 0x01000193UL;
+    }
+    if (len == obj->rec_len && hash == obj->rec_hash) {
+        obj->buff_len = obj->rec_start;
+        if (obj->rec_repeat++ == 0 && obj->coalesce_time_fn != NULL) {
+            obj->coalesce_stamp = obj->coalesce_time_fn();
+        }
+        if (obj->coalesce_time_fn != NULL
+            && (uint32_t)(obj->coalesce_time_fn() - obj->coalesce_stamp) >= obj->coalesce_timeout) {
+            res = prv_coalesce_report(lwi, obj->buff_len);
         }
+        return res;
     }
-
-    /* Add negative sign here when spaces are used for width */
-    if (!lwi->m.flags.zero) {
-        if (lwi->m.flags.is_negative) {
-            lwi->out_fn(lwi, '-');
-        } else if (lwi->m.flags.plus) {
-            lwi->out_fn(lwi, '+');
-        } else if (lwi->m.flags.space && buff_size >= (size_t)lwi->m.width) {
-            lwi->out_fn(lwi, ' ');
-        }
+    if (obj->rec_repeat > 0) {
+        res = prv_coalesce_report(lwi, obj->rec_start);
     }
-
-    return 1;
+    obj->rec_len = len;
+    obj->rec_hash = hash;
+    return res;
 }
 
+#endif /* LWPRINTF_CFG_ENABLE_COALESCE */
+
 /**
- * \brief           Format data that are printed after actual value
- * \param[in,out]   lwi: LwPRINTF internal instance
- * \param[in]       buff_size: Expected buffer size of output string
+ * \brief           Send all characters waiting in staging buffer to the block output function
+ * \param[in]       lwi: LwPRINTF internal instance
  * \return          `1` on success, `0` otherwise
  */
 static int
-prv_out_str_after(lwprintf_int_t* lwi, size_t buff_size) {
-    /* Left alignment, but only with spaces */
-    if (lwi->m.flags.left_align) {
-        for (size_t idx = buff_size; idx < (size_t)lwi->m.width; ++idx) {
-            lwi->out_fn(lwi, ' ');
-        }
+prv_out_block_flush(lwprintf_int_t* lwi) {
+    lwprintf_t* obj = lwi->lwobj;
+    int res = 1;
+
+#if LWPRINTF_CFG_ENABLE_COALESCE
+    /* Record is sent before its print call ends, when staging buffer is full or time budget runs out */
+    if (obj->coalesce && obj->buff_len > obj->rec_start && !obj->rec_split) {
+        res = prv_coalesce_split(lwi);
     }
-    return 1;
+    obj->rec_start = 0;
+#endif /* LWPRINTF_CFG_ENABLE_COALESCE */
+    if (obj->buff_len > 0) {
+        res = prv_out_block_send(lwi, obj->buff, obj->buff_len) && res;
+        obj->buff_len = 0;
+#if LWPRINTF_CFG_ENABLE_AUTO_FLUSH
+        obj->flush_stamped = 0;
+#endif /* LWPRINTF_CFG_ENABLE_AUTO_FLUSH */
+    }
+    return res;
 }
 
 /**
- * \brief           Output raw string without any formatting
- * \param[in,out]   lwi: LwPRINTF internal instance
- * \param[in]       buff: Buffer string
- * \param[in]       buff_size: Length of buffer to output
+ * \brief           Put character to the staging buffer of block output.
+ *
+ * Buffer is flushed when full or when `NULL` character is received,
+ * which marks end of current formatting.
+ *
+ * \param[in]       lwi: LwPRINTF internal instance
+ * \param[in]       chr: Character to put
  * \return          `1` on success, `0` otherwise
  */
 static int
-prv_out_str_raw(lwprintf_int_t* lwi, const char* buff, size_t buff_size) {
-    for (size_t idx = 0; idx < buff_size; ++idx) {
-        lwi->out_fn(lwi, buff[idx]);
+prv_out_block_put(lwprintf_int_t* lwi, const char chr) {
+    lwprintf_t* obj = lwi->lwobj;
+
+    if (chr == '\0') {
+#if LWPRINTF_CFG_ENABLE_COALESCE
+        if (obj->coalesce) {
+            /* New line of the record is sent now, that it has been compared */
+            const uint8_t is_line = IS_BLOCK_LINE_MODE(obj)
+                                    && memchr(&obj->buff[obj->rec_start], '\n', obj->buff_len - obj->rec_start) != NULL;
+
+            prv_coalesce_end(lwi);
+            obj->rec_start = obj->buff_len;
+            if (is_line) {
+                return prv_out_block_flush(lwi);
+            }
+        }
+#endif /* LWPRINTF_CFG_ENABLE_COALESCE */
+#if LWPRINTF_CFG_ENABLE_LOW_POWER
+        /* Burst is sent, when kept text reaches threshold or message has priority level */
+        if (obj->lp_threshold > 0 && !obj->batch && (obj->buff_len >= obj->lp_threshold || lwi->is_priority)) {
+            return prv_out_block_flush(lwi);
+        }
+#endif /* LWPRINTF_CFG_ENABLE_LOW_POWER */
+#if LWPRINTF_CFG_ENABLE_AUTO_FLUSH
+        /* Age of kept text starts at the end of print call, that left it in staging buffer */
+        if (obj->flush_time_fn != NULL && obj->buff_len > 0 && !obj->flush_stamped && IS_BLOCK_KEPT(obj)) {
+            obj->flush_stamp = obj->flush_time_fn();
+            obj->flush_stamped = 1;
+        }
+#endif /* LWPRINTF_CFG_ENABLE_AUTO_FLUSH */
+        return IS_BLOCK_KEPT(obj) ? 1 : prv_out_block_flush(lwi); /* Batch is flushed only when it ends */
+    }
+    ++lwi->n_len;
+
+    /* Without staging buffer, character goes directly to the output */
+    if (obj->buff == NULL || obj->buff_size == 0) {
+        return prv_out_block_send(lwi, &chr, 1);
     }
+    obj->buff[obj->buff_len++] = chr;
+    if (obj->buff_len >= obj->buff_size) {
+        return prv_out_block_flush(lwi);
+    }
+#if LWPRINTF_CFG_ENABLE_BUFF_MODE
+    if (chr == '\n' && IS_BLOCK_LINE_FLUSH(obj)) {
+        return prv_out_block_flush(lwi);
+    }
+#endif /* LWPRINTF_CFG_ENABLE_BUFF_MODE */
     return 1;
 }
 
+#endif /* LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT */
+
+#if LWPRINTF_CFG_ENABLE_DEADLINE
+
+static int prv_out_str_fn_send(lwprintf_int_t* lwi, const char* str, size_t len);
+
 /**
- * \brief           Output generated string from numbers/digits
- * Paddings before and after are applied at this stage
+ * \brief           Check time budget of the print, before text is passed to the output.
+ *
+ * When budget has run out, truncated line is ended with the mark and print is cancelled
  *
  * \param[in,out]   lwi: LwPRINTF internal instance
- * \param[in]       buff: Buffer string
- * \param[in]       buff_size: Length of buffer to output
- * \return          `1` on success, `0` otherwise
+ * \return          `1` if text can be sent, `0` otherwise
  */
-static int
-prv_out_str(lwprintf_int_t* lwi, const char* buff, size_t buff_size) {
-    prv_out_str_before(lwi, buff_size);    /* Implement pre-format */
-    prv_out_str_raw(lwi, buff, buff_size); /* Print actual string */
-    prv_out_str_after(lwi, buff_size);     /* Implement post-format */
+static uint8_t
+prv_deadline_check(lwprintf_int_t* lwi) {
+    const size_t n_len = lwi->n_len;
+
+    if (lwi->deadline_time_fn == NULL
+        || (uint32_t)(lwi->deadline_time_fn() - lwi->deadline_start) < lwi->deadline_budget) {
+        return 1;
+    }
+    lwi->deadline_time_fn = NULL; /* Mark is sent without the check */
+    prv_out_str_fn_send(lwi, LWPRINTF_CFG_DEADLINE_MARK, sizeof(LWPRINTF_CFG_DEADLINE_MARK) - 1);
+    lwi->n_len = n_len; /* Mark is not part of the formatted length */
+#if LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT
+    /* Final `NULL` character does not flush cancelled print, staged text is sent now */
+    if (lwi->lwobj->out_block_fn != NULL && !IS_BLOCK_KEPT(lwi->lwobj)) {
+        prv_out_block_flush(lwi);
+    }
+#endif /* LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT */
+    lwi->is_print_cancelled = 1;
+    return 0;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_DEADLINE */
+
+#if LWPRINTF_CFG_OS_YIELD_CHUNK > 0
+
+static uint8_t prv_mutex_wait(lwprintf_t* obj);
+static uint8_t prv_mutex_release(lwprintf_t* obj);
+
+/**
+ * \brief           Count characters sent to the output, and let other tasks run after every chunk.
+ *
+ * Mutex is released for the time of the yield. Direct print of other task, that gets it meanwhile,
+ * sees unfinished message and stores its text to deferred ring buffer
+ *
+ * \param[in,out]   lwi: LwPRINTF internal instance, with mutex held
+ * \param[in]       len: Number of sent characters
+ */
+static void
+prv_yield_count(lwprintf_int_t* lwi, size_t len) {
+    lwprintf_t* obj = lwi->lwobj;
+
+    lwi->yield_cnt += len;
+    if (lwi->yield_cnt < LWPRINTF_CFG_OS_YIELD_CHUNK || lwi->is_print_cancelled) {
+        return;
+    }
+    lwi->yield_cnt = 0;
+    obj->yield_busy = 1;
+    prv_mutex_release(obj);
+    lwprintf_sys_yield();
+    if (!prv_mutex_wait(obj)) {
+        lwi->is_print_cancelled = 1;
+    }
+    obj->yield_busy = 0;
+}
+
+/**
+ * \brief           Store print to deferred ring buffer, when record of other task is paused in the yield
+ *
+ * Only text print is stored, compiled formats and records from the ring buffer are dropped
+ *
+ * \param[in]       lwi: LwPRINTF internal instance, with mutex held
+ * \param[in]       arg: Variable parameters list
+ * \return          `1` if print must not continue, `0` otherwise
+ */
+static uint8_t
+prv_yield_defer(lwprintf_int_t* lwi, va_list arg) {
+    va_list ap;
 
+    if (!lwi->lwobj->yield_busy) {
+        return 0;
+    }
+    if (lwi->fmt != NULL && lwi->dargs == NULL) {
+        va_copy(ap, arg);
+        lwprintf_vprintf_deferred_ex(lwi->lwobj, lwi->fmt, ap);
+        va_end(ap);
+    }
     return 1;
 }
 
+#endif /* LWPRINTF_CFG_OS_YIELD_CHUNK > 0 */
+
 /**
- * \brief           Convert `unsigned int` to string
- * \param[in,out]   lwi: LwPRINTF internal instance
- * \param[in]       num: Number to convert to string
+ * \brief           Send character to the output of the instance
+ * \param[in]       ptr: LwPRINTF internal instance
+ * \param[in]       chr: Character to print
  * \return          `1` on success, `0` otherwise
  */
 static int
-prv_longest_unsigned_int_to_str(lwprintf_int_t* lwi, uint_maxtype_t num) {
-    /* Start with digits length, support binary with int, that is 32-bits maximum width */
-    char num_buf[33], *num_buf_ptr = &num_buf[sizeof(num_buf)];
-    char adder_ch = (lwi->m.flags.uc ? 'A' : 'a') - 10;
-    size_t len = 0;
+prv_out_fn_send(lwprintf_int_t* lwi, const char chr) {
+    if (lwi->is_print_cancelled) {
+        return 0;
+    }
+#if LWPRINTF_CFG_ENABLE_DEADLINE
+    if (chr != '\0' && !prv_deadline_check(lwi)) {
+        return 0;
+    }
+#endif /* LWPRINTF_CFG_ENABLE_DEADLINE */
 
-    /* Check if number is zero */
-    lwi->m.flags.is_num_zero = num == 0;
+#if LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT
+    if (lwi->lwobj->out_block_fn != NULL) {
+        return prv_out_block_put(lwi, chr);
+    }
+#endif /* LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT */
 
-    /* Fill the buffer backward */
-    *--num_buf_ptr = '\0';
-    do {
-        int digit = num % lwi->m.base;
-        num /= lwi->m.base;
-        *--num_buf_ptr = (char)digit + (char)(digit >= 10 ? adder_ch : '0');
-    } while (num > 0);
+    /* Send character to output */
+    LWPRINTF_CFG_TRACE_SINK_START(lwi->lwobj, 1);
+#if LWPRINTF_CFG_STATS
+    {
+        const uint32_t start = prv_stats_sink_start(lwi->lwobj);
 
-    /* Calculate and generate the output */
-    len = sizeof(num_buf) - (size_t)((uintptr_t)num_buf_ptr - (uintptr_t)num_buf) - 1;
-    prv_out_str_before(lwi, len);
-    for (; *num_buf_ptr;) {
-        lwi->out_fn(lwi, *num_buf_ptr++);
+        if (!lwi->lwobj->out_fn(chr, lwi->lwobj)) {
+            lwi->is_print_cancelled = 1;
+        }
+        prv_stats_sink_end(lwi->lwobj, start);
+    }
+#else
+    if (!lwi->lwobj->out_fn(chr, lwi->lwobj)) {
+        lwi->is_print_cancelled = 1;
+    }
+#endif /* LWPRINTF_CFG_STATS */
+    LWPRINTF_CFG_TRACE_SINK_END(lwi->lwobj, !lwi->is_print_cancelled);
+    if (chr != '\0' && !lwi->is_print_cancelled) {
+        ++lwi->n_len;
+#if LWPRINTF_CFG_OS_YIELD_CHUNK > 0
+        if (lwi->is_yield_on) {
+            prv_yield_count(lwi, 1);
+        }
+#endif /* LWPRINTF_CFG_OS_YIELD_CHUNK > 0 */
     }
-    prv_out_str_after(lwi, len);
     return 1;
 }
 
 /**
- * \brief           Convert signed long int to string
- * \param[in,out]   lwi: LwPRINTF instance
- * \param[in]       num: Number to convert to string
+ * \brief           Send string of characters to the output of the instance
+ * \param[in]       lwi: LwPRINTF internal instance
+ * \param[in]       str: String to print
+ * \param[in]       len: Number of characters to print
  * \return          `1` on success, `0` otherwise
  */
 static int
-prv_longest_signed_int_to_str(lwprintf_int_t* lwi, int_maxtype_t num) {
-    SIGNED_CHECK_NEGATIVE(lwi, num);
-    return prv_longest_unsigned_int_to_str(lwi, (uint_maxtype_t)num);
+prv_out_str_fn_send(lwprintf_int_t* lwi, const char* str, size_t len) {
+    if (lwi->is_print_cancelled) {
+        return 0;
+    }
+#if LWPRINTF_CFG_OS_YIELD_CHUNK > 0
+    /* Long string is sent in parts, that end at chunk boundary */
+    if (lwi->is_yield_on) {
+        lwi->is_yield_on = 0; /* Characters of the part are not counted again */
+        while (len > 0 && !lwi->is_print_cancelled) {
+            size_t part = LWPRINTF_CFG_OS_YIELD_CHUNK - lwi->yield_cnt;
+
+            part = part < len ? part : len;
+            prv_out_str_fn_send(lwi, str, part);
+            prv_yield_count(lwi, part);
+            str += part;
+            len -= part;
+        }
+        lwi->is_yield_on = 1;
+        return !lwi->is_print_cancelled;
+    }
+#endif /* LWPRINTF_CFG_OS_YIELD_CHUNK > 0 */
+
+#if LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT
+    if (lwi->lwobj->out_block_fn != NULL) {
+        lwprintf_t* obj = lwi->lwobj;
+
+#if LWPRINTF_CFG_ENABLE_DEADLINE
+        if (!prv_deadline_check(lwi)) {
+            return 0;
+        }
+#endif /* LWPRINTF_CFG_ENABLE_DEADLINE */
+
+        /* Flush pending data first, if string cannot fit to the staging buffer */
+        if (obj->buff_len + len > obj->buff_size && !prv_out_block_flush(lwi)) {
+            return 0;
+        }
+
+        /* Long strings bypass staging buffer, shorter are collected */
+        if (len >= obj->buff_size) {
+#if LWPRINTF_CFG_ENABLE_COALESCE
+            if (obj->coalesce && !obj->rec_split && (!prv_coalesce_split(lwi) || !prv_out_block_flush(lwi))) {
+                return 0;
+            }
+#endif /* LWPRINTF_CFG_ENABLE_COALESCE */
+            if (!prv_out_block_send(lwi, str, len)) {
+                return 0;
+            }
+        } else {
+            memcpy(&obj->buff[obj->buff_len], str, len);
+            obj->buff_len += len;
+#if LWPRINTF_CFG_ENABLE_BUFF_MODE
+            if (IS_BLOCK_LINE_FLUSH(obj) && memchr(str, '\n', len) != NULL && !prv_out_block_flush(lwi)) {
+                return 0;
+            }
+#endif /* LWPRINTF_CFG_ENABLE_BUFF_MODE */
+        }
+        lwi->n_len += len;
+        return 1;
+    }
+#endif /* LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT */
+
+    for (size_t idx = 0; idx < len && !lwi->is_print_cancelled; ++idx) {
+        prv_out_fn_send(lwi, str[idx]);
+    }
+    return 1;
 }
 
+#if LWPRINTF_CFG_ENABLE_LINE_PREFIX
+
 /**
- * \brief           Calculate string length, limited to the maximum value.
- * 
- * \note            Use custom implementation to support potential `< C11` versions
- * 
- * \param           str: String to calculate
- * \param           max_n: Max number of bytes at which length is cut
- * \return          String length in bytes
+ * \brief           Render decimal number right-aligned to its field of the prefix.
+ *
+ * Digits are rendered from the least significant one, until remaining digits are the same as digits
+ * of the previous number, that are already in the field
+ *
+ * \param[out]      end: Pointer after the last character of the field
+ * \param[in]       num: Number to render
+ * \param[in]       prev: Previous number in the field
+ * \param[in]       width: Width of the field
+ * \param[in]       pad: Character used instead of leading zeros
+ * \param[in]       all: Set to `1` to render complete field
  */
-size_t
-prv_strnlen(const char* str, size_t max_n) {
-    size_t length = 0;
-
-    for (; *str != '\0' && length < max_n; ++length, ++str) {}
-    return length;
+static void
+prv_prefix_digits(char* end, uint32_t num, uint32_t prev, size_t width, char pad, uint8_t all) {
+    for (size_t i = 0; i < width && (all || num != prev); ++i, num /= 10, prev /= 10) {
+        *--end = (num > 0 || i == 0) ? (char)('0' + (num % 10)) : pad;
+    }
 }
 
-#if LWPRINTF_CFG_SUPPORT_TYPE_FLOAT
-
 /**
- * \brief           Calculate necessary parameters for input number
+ * \brief           Send line prefix to the output, before the first character of the line
  * \param[in,out]   lwi: LwPRINTF internal instance
- * \param[in]       n: Float number instance
- * \param[in]       num: Input number
- * \param[in]       type: Format type
  */
 static void
-prv_calculate_dbl_num_data(lwprintf_int_t* lwi, float_num_t* n, double num, const char type) {
-    memset(n, 0x00, sizeof(*n));
+prv_prefix_out(lwprintf_int_t* lwi) {
+    lwprintf_t* obj = lwi->lwobj;
+    const size_t n_len = lwi->n_len;
+    uint32_t sec = 0, ms = 0;
 
-    if (lwi->m.precision >= (int)LWPRINTF_ARRAYSIZE(powers_of_10)) {
-        lwi->m.precision = (int)LWPRINTF_ARRAYSIZE(powers_of_10) - 1;
-    }
+    obj->line_start = 0;
+    obj->prefix_time_fn(&sec, &ms, obj);
+    prv_prefix_digits(&obj->prefix[11], sec, obj->prefix_sec, 10, ' ', !obj->prefix_valid);
+    prv_prefix_digits(&obj->prefix[15], ms, obj->prefix_ms, 3, '0', !obj->prefix_valid);
+    obj->prefix_sec = sec;
+    obj->prefix_ms = ms;
+    obj->prefix_valid = 1;
+    prv_out_str_fn_send(lwi, obj->prefix, obj->prefix_len);
+    lwi->n_len = n_len; /* Prefix is not part of the formatted length */
+}
 
-    /*
-     * Get integer and decimal parts, both in integer formats
-     *
-     * As an example, with input number of 12.345678 and precision digits set as 4, then result is the following:
-     *
-     * integer_part = 12            -> Actual integer part of the double number
-     * decimal_part_dbl = 3456.78   -> Decimal part multiplied by 10^precision, keeping it in double format
-     * decimal_part = 3456          -> Integer part of decimal number
-     * diff = 0.78                  -> Difference between actual decimal and integer part of decimal
-     *                                  This is used for rounding of last digit (if necessary)
-     */
-    num += 0.000000000000005;
-    n->integer_part = (float_long_t)num;
-    n->decimal_part_dbl = (num - (double)n->integer_part) * (double)powers_of_10[lwi->m.precision];
-    n->decimal_part = (float_long_t)n->decimal_part_dbl;
-    n->diff = n->decimal_part_dbl - (double)((float_long_t)n->decimal_part);
+#endif /* LWPRINTF_CFG_ENABLE_LINE_PREFIX */
 
-    /* Rounding check of last digit */
-    if (n->diff > 0.5) {
-        ++n->decimal_part;
-        if (n->decimal_part >= powers_of_10[lwi->m.precision]) {
-            n->decimal_part = 0;
-            ++n->integer_part;
+/**
+ * \brief           Output function to print data
+ * \param[in]       ptr: LwPRINTF internal instance
+ * \param[in]       chr: Character to print
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_out_fn_print(lwprintf_int_t* lwi, const char chr) {
+#if LWPRINTF_CFG_ENABLE_LINE_PREFIX
+    lwprintf_t* obj = lwi->lwobj;
+
+    if (obj->prefix_time_fn != NULL && chr != '\0') {
+        if (obj->line_start) {
+            prv_prefix_out(lwi);
         }
-    } else if (n->diff < 0.5) {
-        /* Used in separate if, since comparing float to == will certainly result to false */
-    } else {
-        /* Difference is exactly 0.5 */
-        if (n->decimal_part == 0) {
-            ++n->integer_part;
-        } else {
-            ++n->decimal_part;
+        obj->line_start = chr == '\n';
+    }
+#endif /* LWPRINTF_CFG_ENABLE_LINE_PREFIX */
+    return prv_out_fn_send(lwi, chr);
+}
+
+/**
+ * \brief           Output function to print string of characters
+ * \param[in]       lwi: LwPRINTF internal instance
+ * \param[in]       str: String to print
+ * \param[in]       len: Number of characters to print
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_out_str_fn_print(lwprintf_int_t* lwi, const char* str, size_t len) {
+#if LWPRINTF_CFG_ENABLE_LINE_PREFIX
+    lwprintf_t* obj = lwi->lwobj;
+
+    /* Every line of the string is sent at once, with prefix before it */
+    while (obj->prefix_time_fn != NULL && len > 0 && !lwi->is_print_cancelled) {
+        const char* nl = memchr(str, '\n', len);
+        const size_t part = nl != NULL ? (size_t)(nl - str) + 1 : len;
+
+        if (obj->line_start) {
+            prv_prefix_out(lwi);
         }
+        prv_out_str_fn_send(lwi, str, part);
+        obj->line_start = nl != NULL;
+        str += part;
+        len -= part;
     }
+#endif /* LWPRINTF_CFG_ENABLE_LINE_PREFIX */
+    return prv_out_str_fn_send(lwi, str, len);
+}
 
-    /* Calculate number of digits for integer and decimal parts */
-    if (n->integer_part == 0) {
-        n->digits_cnt_integer_part = 1;
-    } else {
-        float_long_t tmp;
-        for (n->digits_cnt_integer_part = 0, tmp = n->integer_part; tmp > 0; ++n->digits_cnt_integer_part, tmp /= 10) {}
+/**
+ * \brief           Output function to print the same character multiple times
+ * \param[in]       lwi: LwPRINTF internal instance
+ * \param[in]       chr: Character to print
+ * \param[in]       cnt: Number of times to print the character
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_out_fill_fn_print(lwprintf_int_t* lwi, const char chr, size_t cnt) {
+#if LWPRINTF_CFG_ENABLE_LINE_PREFIX
+    /* Padding characters are never new line, only the first one may need the prefix */
+    if (lwi->lwobj->prefix_time_fn != NULL && lwi->lwobj->line_start && cnt > 0) {
+        prv_prefix_out(lwi);
     }
-    n->digits_cnt_decimal_part = (short)lwi->m.precision;
+#endif /* LWPRINTF_CFG_ENABLE_LINE_PREFIX */
+#if LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT
+    if (lwi->lwobj->out_block_fn != NULL) {
+        lwprintf_t* obj = lwi->lwobj;
 
-#if LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING
-    /* Calculate minimum useful digits for decimal (excl last useless zeros) */
-    if (type == 'g') {
-        float_long_t tmp = n->decimal_part;
-        short adder, i;
+#if LWPRINTF_CFG_ENABLE_DEADLINE
+        if (!prv_deadline_check(lwi)) {
+            return 0;
+        }
+#endif /* LWPRINTF_CFG_ENABLE_DEADLINE */
 
-        for (adder = 0, i = 0; tmp > 0 || i < (short)lwi->m.precision;
-             tmp /= 10, n->digits_cnt_decimal_part_useful += adder, ++i) {
-            if (adder == 0 && (tmp % 10) > 0) {
-                adder = 1;
+        /* Fill staging buffer directly, or send fixed chunks of padding characters */
+        if (obj->buff_size > 0) {
+            while (cnt > 0 && !lwi->is_print_cancelled) {
+                size_t len = obj->buff_size - obj->buff_len;
+
+                if (len > cnt) {
+                    len = cnt;
+                }
+                memset(&obj->buff[obj->buff_len], chr, len);
+                obj->buff_len += len;
+                lwi->n_len += len;
+                cnt -= len;
+                if (obj->buff_len >= obj->buff_size) {
+                    prv_out_block_flush(lwi);
+                }
+#if LWPRINTF_CFG_OS_YIELD_CHUNK > 0
+                if (lwi->is_yield_on) {
+                    prv_yield_count(lwi, len);
+                }
+#endif /* LWPRINTF_CFG_OS_YIELD_CHUNK > 0 */
+            }
+            return !lwi->is_print_cancelled;
+        } else if (chr == ' ' || chr == '0') {
+            static const char fill_spaces[] = "                ";
+            static const char fill_zeros[] = "0000000000000000";
+
+            while (cnt > 0) {
+                size_t len = cnt > (sizeof(fill_spaces) - 1) ? (sizeof(fill_spaces) - 1) : cnt;
+
+                if (!prv_out_str_fn_print(lwi, chr == ' ' ? fill_spaces : fill_zeros, len)) {
+                    return 0;
+                }
+                cnt -= len;
             }
+            return 1;
         }
-    } else
-#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING */
-    {
-        n->digits_cnt_decimal_part_useful = (short)lwi->m.precision;
     }
+#endif /* LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT */
+
+    for (; cnt > 0 && !lwi->is_print_cancelled; --cnt) {
+        prv_out_fn_print(lwi, chr);
+    }
+    return !lwi->is_print_cancelled;
 }
 
 /**
- * \brief           Convert double number to string
- * \param[in,out]   lwi: LwPRINTF internal instance
- * \param[in]       num: Number to convert to string
+ * \brief           Output function to generate buffer data
+ * \param[in]       lwi: LwPRINTF internal instance
+ * \param[in]       chr: Character to write
  * \return          `1` on success, `0` otherwise
  */
 static int
-prv_double_to_str(lwprintf_int_t* lwi, double in_num) {
-    float_num_t dblnum;
-    double orig_num = in_num;
-    int digits_cnt, chosen_precision, i;
-#if LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING
-    int exp_cnt = 0;
-#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING */
-    char def_type = lwi->m.type;
-    char str[LWPRINTF_CFG_SUPPORT_LONG_LONG ? 22 : 11];
-
-    /*
-     * Check for corner cases
-     *
-     * - Print "nan" if number is not valid
-     * - Print negative infinity if number is less than absolute minimum
-     * - Print negative infinity if number is less than -FLOAT_MAX_B_ENG and engineering mode is disabled
-     * - Print positive infinity if number is greater than absolute minimum
-     * - Print positive infinity if number is greater than FLOAT_MAX_B_ENG and engineering mode is disabled
-     * - Go to engineering mode if it is enabled and `in_num < -FLOAT_MAX_B_ENG` or `in_num > FLOAT_MAX_B_ENG`
-     */
-    if (in_num != in_num) {
-        return prv_out_str(lwi, lwi->m.flags.uc ? "NAN" : "nan", 3);
-    } else if (in_num < -DBL_MAX
-#if !LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING
-               || in_num < -FLOAT_MAX_B_ENG
-#endif /* !LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING */
-    ) {
-        return prv_out_str(lwi, lwi->m.flags.uc ? "-INF" : "-inf", 4);
-    } else if (in_num > DBL_MAX
-#if !LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING
-               || in_num > FLOAT_MAX_B_ENG
-#endif /* !LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING */
-    ) {
-        char str[5], *s_ptr = str;
-        if (lwi->m.flags.plus) {
-            *s_ptr++ = '+';
+prv_out_fn_write_buff(lwprintf_int_t* lwi, const char chr) {
+    if (chr != '\0') {
+        if (lwi->n_len < lwi->buff_max_len) {
+            lwi->buff[lwi->n_len] = chr;
         }
-        strcpy(s_ptr, lwi->m.flags.uc ? "INF" : "inf");
-        return prv_out_str(lwi, str, lwi->m.flags.plus ? 4 : 3);
-#if LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING
-    } else if ((in_num < -FLOAT_MAX_B_ENG || in_num > FLOAT_MAX_B_ENG) && def_type != 'g') {
-        lwi->m.type = def_type = 'e'; /* Go to engineering mode */
-#endif                                /* LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING */
+        ++lwi->n_len;
     }
+    return 1;
+}
 
-    /* Check sign of the number */
-    SIGNED_CHECK_NEGATIVE(lwi, in_num);
-    orig_num = in_num;
+/**
+ * \brief           Output function to write string of characters to buffer
+ * \param[in]       lwi: LwPRINTF internal instance
+ * \param[in]       str: String to write
+ * \param[in]       len: Number of characters to write
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_out_str_fn_write_buff(lwprintf_int_t* lwi, const char* str, size_t len) {
+    if (lwi->n_len < lwi->buff_max_len) {
+        size_t avail = lwi->buff_max_len - lwi->n_len;
 
-#if LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING
-    /* Engineering mode check for number of exponents */
-    if (def_type == 'e' || def_type == 'g'
-        || in_num > (double)(powers_of_10[LWPRINTF_ARRAYSIZE(powers_of_10) - 1])) { /* More vs what float can hold */
-        if (lwi->m.type != 'g') {
-            lwi->m.type = 'e';
-        }
+        memcpy(&lwi->buff[lwi->n_len], str, avail > len ? len : avail);
+    }
+    lwi->n_len += len;
+    return 1;
+}
 
-        /* Normalize number to be between 0 and 1 and count decimals for exponent */
-        if (in_num < 1) {
-            for (exp_cnt = 0; in_num < 1 && in_num > 0; in_num *= 10, --exp_cnt) {}
-        } else {
-            for (exp_cnt = 0; in_num >= 10; in_num /= 10, ++exp_cnt) {}
-        }
+/**
+ * \brief           Output function to write the same character multiple times to buffer
+ * \param[in]       lwi: LwPRINTF internal instance
+ * \param[in]       chr: Character to write
+ * \param[in]       cnt: Number of times to write the character
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_out_fill_fn_write_buff(lwprintf_int_t* lwi, const char chr, size_t cnt) {
+    if (lwi->n_len < lwi->buff_max_len) {
+        size_t avail = lwi->buff_max_len - lwi->n_len;
+
+        memset(&lwi->buff[lwi->n_len], chr, avail > cnt ? cnt : avail);
     }
-#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING */
+    lwi->n_len += cnt;
+    return 1;
+}
 
-    /* Check precision data */
-    chosen_precision = lwi->m.precision; /* This is default value coming from app */
-    if (lwi->m.precision >= (int)LWPRINTF_ARRAYSIZE(powers_of_10)) {
-        lwi->m.precision = (int)LWPRINTF_ARRAYSIZE(powers_of_10) - 1; /* Limit to maximum precision */
-        /*
-         * Precision is lower than the one selected by app (or user).
-         * It means that we have to append ending zeros for precision when printing data
-         */
-    } else if (!lwi->m.flags.precision) {
-        lwi->m.precision = LWPRINTF_CFG_FLOAT_DEFAULT_PRECISION; /* Default precision when not used */
-        chosen_precision = lwi->m.precision;                     /* There was no precision, update chosen precision */
-    } else if (lwi->m.flags.precision && lwi->m.precision == 0) {
-#if LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING
-        /* Precision must be set to 1 if set to 0 by default */
-        if (def_type == 'g') {
-            lwi->m.precision = 1;
-        }
-#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING */
+/**
+ * \brief           Output function to only count characters
+ * \param[in]       lwi: LwPRINTF internal instance
+ * \param[in]       chr: Character to count
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_out_fn_measure(lwprintf_int_t* lwi, const char chr) {
+    if (chr != '\0') {
+        ++lwi->n_len;
     }
+    return 1;
+}
 
-    /* Check if type is g and decide if final output should be 'f' or 'e' */
-    /*
-     * For 'g/G' specifier
-     *
-     * A double argument representing a floating-point number is converted
-     * in style 'f' or 'e' (or in style 'F' or 'E' in the case of a 'G' conversion specifier),
-     * depending on the value converted and the precision.
-     * Let 'P' equal the precision if nonzero, '6' if the precision is omitted, or '1' if the precision is zero.
-     * Then, if a conversion with style 'E' would have an exponent of 'X':
-     *
-     * if 'P > X >= -4', the conversion is with style 'f' (or 'F') and precision 'P - (X + 1)'.
-     * otherwise, the conversion is with style 'e' (or 'E') and precision 'P - 1'.
-     *
-     * Finally, unless the '#' flag is used,
-     * any trailing zeros are removed from the fractional portion of the result
-     * and the decimal-point character is removed if there is no fractional portion remaining.
-     *
-     * A double argument representing an infinity or 'NaN' is converted in the style of an 'f' or 'F' conversion specifier.
-     */
+/**
+ * \brief           Output function to only count string of characters
+ * \param[in]       lwi: LwPRINTF internal instance
+ * \param[in]       str: String to count, not accessed
+ * \param[in]       len: Number of characters to count
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_out_str_fn_measure(lwprintf_int_t* lwi, const char* str, size_t len) {
+    LWPRINTF_UNUSED(str);
+    lwi->n_len += len;
+    return 1;
+}
 
-    /* Calculate data for number */
-    prv_calculate_dbl_num_data(lwi, &dblnum, def_type == 'e' ? in_num : orig_num, def_type);
+/**
+ * \brief           Output function to only count the same character multiple times
+ * \param[in]       lwi: LwPRINTF internal instance
+ * \param[in]       chr: Character to count
+ * \param[in]       cnt: Number of times to count the character
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_out_fill_fn_measure(lwprintf_int_t* lwi, const char chr, size_t cnt) {
+    LWPRINTF_UNUSED(chr);
+    lwi->n_len += cnt;
+    return 1;
+}
 
-#if LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING
-    /* Set type G */
-    if (def_type == 'g') {
-        /* As per standard to decide level of precision */
-        if (exp_cnt >= -4 && exp_cnt < lwi->m.precision) {
-            lwi->m.precision -= exp_cnt + 1;
-            chosen_precision -= exp_cnt + 1;
-            lwi->m.type = 'f';
-            in_num = orig_num;
-        } else {
-            lwi->m.type = 'e';
-            if (lwi->m.precision > 0) {
-                --lwi->m.precision;
-                --chosen_precision;
-            }
+#if LWPRINTF_CFG_ENABLE_RESUMABLE
+
+/**
+ * \brief           Write characters to chunk buffer of resumable formatting.
+ *
+ * Characters before the chunk were output by previous calls and are skipped.
+ * Formatting is cancelled at the first character after the chunk
+ *
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in]       str: String to write. Set to `NULL` to write `chr` character instead
+ * \param[in]       chr: Character to write, when `str` is `NULL`
+ * \param[in]       len: Number of characters to write
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_out_resume(lwprintf_int_t* lwi, const char* str, const char chr, size_t len) {
+    size_t skip = 0, avail;
+    int res = 1;
+
+    if (lwi->n_len < lwi->rs->pos) {
+        skip = lwi->rs->pos - lwi->n_len;
+        if (skip >= len) {
+            lwi->n_len += len;
+            return 1;
         }
-        prv_calculate_dbl_num_data(lwi, &dblnum, in_num, def_type);
     }
-#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING */
+    avail = lwi->rs->pos + lwi->buff_max_len - (lwi->n_len + skip);
+    if (len - skip > avail) {
+        len = skip + avail;
+        lwi->is_print_cancelled = 1;
+        res = 0;
+    }
+    if (str != NULL) {
+        memcpy(&lwi->buff[lwi->n_len + skip - lwi->rs->pos], &str[skip], len - skip);
+    } else {
+        memset(&lwi->buff[lwi->n_len + skip - lwi->rs->pos], chr, len - skip);
+    }
+    lwi->n_len += len;
+    return res;
+}
 
-    /* Set number of digits to display */
-    digits_cnt = dblnum.digits_cnt_integer_part;
-    if (0) {
-#if LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING
-    } else if (def_type == 'g' && lwi->m.precision > 0) {
-        digits_cnt += dblnum.digits_cnt_decimal_part_useful;
-        if (dblnum.digits_cnt_decimal_part_useful > 0) {
-            ++digits_cnt;
-        }
-#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING */
+/**
+ * \brief           Output function of resumable formatting
+ * \param[in]       lwi: LwPRINTF internal instance
+ * \param[in]       chr: Character to write
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_out_fn_resume(lwprintf_int_t* lwi, const char chr) {
+    return chr == '\0' || prv_out_resume(lwi, NULL, chr, 1);
+}
+
+/**
+ * \brief           Output function of resumable formatting, for string of characters
+ * \param[in]       lwi: LwPRINTF internal instance
+ * \param[in]       str: String to write
+ * \param[in]       len: Number of characters to write
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_out_str_fn_resume(lwprintf_int_t* lwi, const char* str, size_t len) {
+    return prv_out_resume(lwi, str, '\0', len);
+}
+
+/**
+ * \brief           Output function of resumable formatting, for the same character multiple times
+ * \param[in]       lwi: LwPRINTF internal instance
+ * \param[in]       chr: Character to write
+ * \param[in]       cnt: Number of times to write the character
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_out_fill_fn_resume(lwprintf_int_t* lwi, const char chr, size_t cnt) {
+    return prv_out_resume(lwi, NULL, chr, cnt);
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_RESUMABLE */
+
+#if LWPRINTF_CFG_ENABLE_IOV
+
+/**
+ * \brief           Add data to the segments. Last segment is extended, when data continue it
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in]       ptr: Data to add, must stay valid until segments are sent
+ * \param[in]       len: Data length in units of bytes
+ * \return          `1` on success, `0` if there is no free segment
+ */
+static int
+prv_iov_add(lwprintf_int_t* lwi, const char* ptr, size_t len) {
+    iov_state_t* st = lwi->iov;
+    lwprintf_iov_t* last = st->iov_cnt > 0 ? &st->iov[st->iov_cnt - 1] : NULL;
+
+    if (last != NULL && last->ptr + last->len == ptr) {
+        last->len += len;
+    } else if (st->iov_cnt < st->iov_max) {
+        st->iov[st->iov_cnt].ptr = ptr;
+        st->iov[st->iov_cnt].len = len;
+        ++st->iov_cnt;
     } else {
-        if (chosen_precision > 0 && lwi->m.flags.precision) {
-            /* Add precision digits + dot separator */
-            digits_cnt += chosen_precision + 1;
-        }
+        lwi->is_print_cancelled = 1;
+        return 0;
     }
+    lwi->n_len += len;
+    return 1;
+}
 
-#if LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING
-    /* Increase number of digits to display */
-    if (lwi->m.type == 'e') {
-        /* Format is +Exxx, so add 4 or 5 characters (max is 307, min is 00 for exponent) */
-        digits_cnt += 4 + (exp_cnt >= 100 || exp_cnt <= -100);
+/**
+ * \brief           Reserve space in scratch buffer and add it to the segments
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in]       len: Number of bytes to reserve
+ * \return          Pointer to reserved space, `NULL` if there is not enough space
+ */
+static char*
+prv_iov_reserve(lwprintf_int_t* lwi, size_t len) {
+    iov_state_t* st = lwi->iov;
+    char* ptr = &st->arena[st->arena_len];
+
+    if (len > st->arena_size - st->arena_len) {
+        lwi->is_print_cancelled = 1;
+        return NULL;
     }
-#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING */
+    if (!prv_iov_add(lwi, ptr, len)) {
+        return NULL;
+    }
+    st->arena_len += len;
+    return ptr;
+}
 
-    /* Output strings */
-    prv_out_str_before(lwi, digits_cnt);
+/**
+ * \brief           Output function to write character to scratch buffer of segments
+ * \param[in]       lwi: LwPRINTF internal instance
+ * \param[in]       chr: Character to write
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_out_fn_iov(lwprintf_int_t* lwi, const char chr) {
+    char* ptr;
 
-    /* Output integer part of number */
-    if (dblnum.integer_part == 0) {
-        lwi->out_fn(lwi, '0');
-    } else {
-        for (i = 0; dblnum.integer_part > 0; dblnum.integer_part /= 10, ++i) {
-            str[i] = (char)'0' + (char)(dblnum.integer_part % 10);
-        }
-        for (; i > 0; --i) {
-            lwi->out_fn(lwi, str[i - 1]);
+    if (chr != '\0') {
+        if ((ptr = prv_iov_reserve(lwi, 1)) == NULL) {
+            return 0;
         }
+        *ptr = chr;
     }
+    return 1;
+}
 
-    /* Output decimal part */
-    if (lwi->m.precision > 0) {
-        int x;
-        if (dblnum.digits_cnt_decimal_part_useful > 0) {
-            lwi->out_fn(lwi, '.');
-        }
-        for (i = 0; dblnum.decimal_part > 0; dblnum.decimal_part /= 10, ++i) {
-            str[i] = (char)'0' + (char)(dblnum.decimal_part % 10);
-        }
+/**
+ * \brief           Output function to copy string of characters to scratch buffer of segments
+ * \param[in]       lwi: LwPRINTF internal instance
+ * \param[in]       str: String to write
+ * \param[in]       len: Number of characters to write
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_out_str_fn_iov(lwprintf_int_t* lwi, const char* str, size_t len) {
+    char* ptr;
+
+    if ((ptr = prv_iov_reserve(lwi, len)) == NULL) {
+        return 0;
+    }
+    memcpy(ptr, str, len);
+    return 1;
+}
+
+/**
+ * \brief           Output function to write the same character multiple times to scratch buffer of segments
+ * \param[in]       lwi: LwPRINTF internal instance
+ * \param[in]       chr: Character to write
+ * \param[in]       cnt: Number of times to write the character
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_out_fill_fn_iov(lwprintf_int_t* lwi, const char chr, size_t cnt) {
+    char* ptr;
+
+    if ((ptr = prv_iov_reserve(lwi, cnt)) == NULL) {
+        return 0;
+    }
+    memset(ptr, chr, cnt);
+    return 1;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_IOV */
+
+#if LWPRINTF_CFG_ENABLE_STRBUF
+
+/**
+ * \brief           Get new chunk for string builder and link it to the end of the list
+ * \param[in,out]   sb: String builder
+ * \return          New chunk, `NULL` if there is no more memory
+ */
+static lwprintf_strbuf_chunk_t*
+prv_strbuf_new_chunk(lwprintf_strbuf_t* sb) {
+    lwprintf_strbuf_chunk_t* chunk;
+    size_t size = sb->chunk_size;
+
+    if (sb->alloc_fn != NULL) {
+        chunk = sb->alloc_fn(sizeof(*chunk) + size, sb->arg);
+    } else {
+        size_t pos = STRBUF_ALIGN_UP(sb->arena_pos);
+
+        if (pos >= sb->arena_size || sb->arena_size - pos <= sizeof(*chunk)) {
+            return NULL;
+        }
+        /* Last chunk takes what remains in the arena */
+        if (size > sb->arena_size - pos - sizeof(*chunk)) {
+            size = sb->arena_size - pos - sizeof(*chunk);
+        }
+        chunk = (void*)&sb->arena[pos];
+        sb->arena_pos = pos + sizeof(*chunk) + size;
+    }
+    if (chunk == NULL || size == 0) {
+        return NULL;
+    }
+    chunk->next = NULL;
+    chunk->data = (char*)chunk + sizeof(*chunk);
+    chunk->len = 0;
+    chunk->size = size;
+    if (sb->last != NULL) {
+        sb->last->next = chunk;
+    } else {
+        sb->first = chunk;
+    }
+    sb->last = chunk;
+    return chunk;
+}
+
+/**
+ * \brief           Append characters to string builder, new chunks are taken when last one is full.
+ * Once memory runs out, all further characters are dropped, so that stored text is always complete prefix
+ *
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in]       str: String to append. Set to `NULL` to append `chr` character `len` times
+ * \param[in]       chr: Character to append when `str` is `NULL`
+ * \param[in]       len: Number of characters to append
+ */
+static void
+prv_strbuf_write(lwprintf_int_t* lwi, const char* str, char chr, size_t len) {
+    lwprintf_strbuf_t* sb = lwi->sb;
+
+    lwi->n_len += len;
+    while (len > 0 && !sb->is_full) {
+        lwprintf_strbuf_chunk_t* chunk = sb->last;
+        size_t cnt;
+
+        if ((chunk == NULL || chunk->len == chunk->size) && (chunk = prv_strbuf_new_chunk(sb)) == NULL) {
+            sb->is_full = 1;
+            break;
+        }
+        cnt = chunk->size - chunk->len;
+        if (cnt > len) {
+            cnt = len;
+        }
+        if (str != NULL) {
+            memcpy(&chunk->data[chunk->len], str, cnt);
+            str += cnt;
+        } else {
+            memset(&chunk->data[chunk->len], chr, cnt);
+        }
+        chunk->len += cnt;
+        sb->len += cnt;
+        len -= cnt;
+    }
+}
+
+/**
+ * \brief           Output function to append character to string builder
+ * \param[in]       lwi: LwPRINTF internal instance
+ * \param[in]       chr: Character to write
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_out_fn_strbuf(lwprintf_int_t* lwi, const char chr) {
+    if (chr != '\0') {
+        prv_strbuf_write(lwi, NULL, chr, 1);
+    }
+    return 1;
+}
+
+/**
+ * \brief           Output function to append string of characters to string builder
+ * \param[in]       lwi: LwPRINTF internal instance
+ * \param[in]       str: String to write
+ * \param[in]       len: Number of characters to write
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_out_str_fn_strbuf(lwprintf_int_t* lwi, const char* str, size_t len) {
+    prv_strbuf_write(lwi, str, '\0', len);
+    return 1;
+}
+
+/**
+ * \brief           Output function to append the same character multiple times to string builder
+ * \param[in]       lwi: LwPRINTF internal instance
+ * \param[in]       chr: Character to write
+ * \param[in]       cnt: Number of times to write the character
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_out_fill_fn_strbuf(lwprintf_int_t* lwi, const char chr, size_t cnt) {
+    prv_strbuf_write(lwi, NULL, chr, cnt);
+    return 1;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_STRBUF */
+
+#if LWPRINTF_CFG_ENABLE_ASPRINTF
+
+/**
+ * \brief           Write characters to memory block of allocating print, block is resized in place when it is full.
+ * Once it cannot grow anymore, characters are only counted
+ *
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in]       str: String to write. Set to `NULL` to write `chr` character `len` times
+ * \param[in]       chr: Character to write when `str` is `NULL`
+ * \param[in]       len: Number of characters to write
+ */
+static void
+prv_asprintf_write(lwprintf_int_t* lwi, const char* str, char chr, size_t len) {
+    asprintf_state_t* as = lwi->as;
+    size_t pos = lwi->n_len;
+
+    lwi->n_len += len;
+    if (as->is_full) {
+        return;
+    }
+
+    /* Space for terminating null character is always kept */
+    if (lwi->n_len >= as->size) {
+        size_t size = as->size + LWPRINTF_CFG_ASPRINTF_CHUNK_SIZE;
+
+        if (size <= lwi->n_len) {
+            size = lwi->n_len + LWPRINTF_CFG_ASPRINTF_CHUNK_SIZE;
+        }
+        if (!as->pool->resize_fn(as->buff, size, as->pool->arg)) {
+            as->is_full = 1;
+            return;
+        }
+        as->size = size;
+    }
+    if (str != NULL) {
+        memcpy(&as->buff[pos], str, len);
+    } else {
+        memset(&as->buff[pos], chr, len);
+    }
+}
+
+/**
+ * \brief           Output function to write character to memory block of allocating print
+ * \param[in]       lwi: LwPRINTF internal instance
+ * \param[in]       chr: Character to write
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_out_fn_asprintf(lwprintf_int_t* lwi, const char chr) {
+    if (chr != '\0') {
+        prv_asprintf_write(lwi, NULL, chr, 1);
+    }
+    return 1;
+}
+
+/**
+ * \brief           Output function to write string of characters to memory block of allocating print
+ * \param[in]       lwi: LwPRINTF internal instance
+ * \param[in]       str: String to write
+ * \param[in]       len: Number of characters to write
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_out_str_fn_asprintf(lwprintf_int_t* lwi, const char* str, size_t len) {
+    prv_asprintf_write(lwi, str, '\0', len);
+    return 1;
+}
+
+/**
+ * \brief           Output function to write the same character multiple times to memory block of allocating print
+ * \param[in]       lwi: LwPRINTF internal instance
+ * \param[in]       chr: Character to write
+ * \param[in]       cnt: Number of times to write the character
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_out_fill_fn_asprintf(lwprintf_int_t* lwi, const char chr, size_t cnt) {
+    prv_asprintf_write(lwi, NULL, chr, cnt);
+    return 1;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_ASPRINTF */
+
+/**
+ * \brief           Set output functions of internal instance to only calculate output length
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ */
+static void
+prv_set_measure_mode(lwprintf_int_t* lwi) {
+    lwi->out_fn = prv_out_fn_measure;
+    lwi->out_str_fn = prv_out_str_fn_measure;
+    lwi->out_fill_fn = prv_out_fill_fn_measure;
+}
+
+/**
+ * \brief           Parse number from input string
+ * \param[in,out]   format: Input text to process
+ * \return          Parsed number
+ */
+static int
+prv_parse_num(const char** format) {
+    int num = 0;
+
+    for (; CHARISNUM(**format); ++(*format)) {
+        num = (int)10 * num + CHARTONUM(**format);
+    }
+    return num;
+}
+
+/**
+ * \brief           Output the same character multiple times
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in]       chr: Character to output
+ * \param[in]       cnt: Number of times to output the character
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_out_fill(lwprintf_int_t* lwi, const char chr, size_t cnt) {
+    if (cnt > 0) {
+        return lwi->out_fill_fn(lwi, chr, cnt);
+    }
+    return 1;
+}
+
+/**
+ * \brief           Output prefix of alternate mode, `0` for octal, `0x` for hexadecimal and `0b` for binary number
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ */
+static void
+prv_out_alt_prefix(lwprintf_int_t* lwi) {
+    if (lwi->m.flags.alt && !lwi->m.flags.is_num_zero) {
+        if (lwi->m.base == 8) {
+            lwi->out_fn(lwi, '0');
+        } else if (lwi->m.base == 16) {
+            lwi->out_fn(lwi, '0');
+            lwi->out_fn(lwi, lwi->m.flags.uc ? 'X' : 'x');
+        } else if (lwi->m.base == 2) {
+            lwi->out_fn(lwi, '0');
+            lwi->out_fn(lwi, lwi->m.flags.uc ? 'B' : 'b');
+        }
+    }
+}
+
+/**
+ * \brief           Format data that are printed before actual value
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in]       buff_size: Expected buffer size of output string
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_out_str_before(lwprintf_int_t* lwi, size_t buff_size) {
+    /* Check for width */
+    if (lwi->m.width > 0
+        /* If number is negative, add negative sign or if positive and has plus sign forced */
+        && (lwi->m.flags.is_negative || lwi->m.flags.plus)) {
+        --lwi->m.width;
+    }
+
+    /* Check for alternate mode */
+    if (lwi->m.flags.alt && !lwi->m.flags.is_num_zero) {
+        if (lwi->m.base == 8) {
+            if (lwi->m.width > 0) {
+                --lwi->m.width;
+            }
+        } else if (lwi->m.base == 16 || lwi->m.base == 2) {
+            if (lwi->m.width >= 2) {
+                lwi->m.width -= 2;
+            } else {
+                lwi->m.width = 0;
+            }
+        }
+    }
+
+    /* Add negative sign (or positive in case of + flag or space in case of space flag) before when zeros are used to fill width */
+    if (lwi->m.flags.zero) {
+        if (lwi->m.flags.is_negative) {
+            lwi->out_fn(lwi, '-');
+        } else if (lwi->m.flags.plus) {
+            lwi->out_fn(lwi, '+');
+        } else if (lwi->m.flags.space) {
+            lwi->out_fn(lwi, ' ');
+        }
+        prv_out_alt_prefix(lwi); /* Prefix goes between sign and zeros */
+    }
+
+    /* Right alignment, spaces or zeros */
+    if (!lwi->m.flags.left_align && lwi->m.width > 0 && buff_size < (size_t)lwi->m.width) {
+        prv_out_fill(lwi, lwi->m.flags.zero ? '0' : ' ', (size_t)lwi->m.width - buff_size);
+    }
+
+    /* Add negative sign here when spaces are used for width */
+    if (!lwi->m.flags.zero) {
+        if (lwi->m.flags.is_negative) {
+            lwi->out_fn(lwi, '-');
+        } else if (lwi->m.flags.plus) {
+            lwi->out_fn(lwi, '+');
+        } else if (lwi->m.flags.space && buff_size >= (size_t)lwi->m.width) {
+            lwi->out_fn(lwi, ' ');
+        }
+        prv_out_alt_prefix(lwi);
+    }
+
+    return 1;
+}
+
+/**
+ * \brief           Format data that are printed after actual value
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in]       buff_size: Expected buffer size of output string
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_out_str_after(lwprintf_int_t* lwi, size_t buff_size) {
+    /* Left alignment, but only with spaces */
+    if (lwi->m.flags.left_align && lwi->m.width > 0 && buff_size < (size_t)lwi->m.width) {
+        prv_out_fill(lwi, ' ', (size_t)lwi->m.width - buff_size);
+    }
+    return 1;
+}
+
+/**
+ * \brief           Output raw string without any formatting
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in]       buff: Buffer string
+ * \param[in]       buff_size: Length of buffer to output
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_out_str_raw(lwprintf_int_t* lwi, const char* buff, size_t buff_size) {
+    if (buff_size > 0) {
+        return lwi->out_str_fn(lwi, buff, buff_size);
+    }
+    return 1;
+}
+
+/**
+ * \brief           Output string that stays valid after formatting ends, such as part of format string.
+ *
+ * Scatter-gather formatting refers to such string, instead of copying it
+ *
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in]       buff: Buffer string
+ * \param[in]       buff_size: Length of buffer to output
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_out_str_ref(lwprintf_int_t* lwi, const char* buff, size_t buff_size) {
+#if LWPRINTF_CFG_ENABLE_IOV
+    if (lwi->iov != NULL) {
+        return buff_size == 0 || prv_iov_add(lwi, buff, buff_size);
+    }
+#endif /* LWPRINTF_CFG_ENABLE_IOV */
+    return prv_out_str_raw(lwi, buff, buff_size);
+}
+
+/**
+ * \brief           Output string argument or constant text, such as `nan`.
+ * Paddings before and after are applied at this stage
+ *
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in]       buff: Buffer string, must stay valid after formatting ends
+ * \param[in]       buff_size: Length of buffer to output
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_out_str(lwprintf_int_t* lwi, const char* buff, size_t buff_size) {
+    prv_out_str_before(lwi, buff_size);    /* Implement pre-format */
+    prv_out_str_ref(lwi, buff, buff_size); /* Print actual string */
+    prv_out_str_after(lwi, buff_size);     /* Implement post-format */
+
+    return 1;
+}
+
+#if LWPRINTF_CFG_SUPPORT_THOUSANDS
+
+/* Number of thousands separators for integer part with `len` digits */
+#define THOUSANDS_SEP_CNT(len) ((len) > 0 ? ((len) - 1) / 3 : 0)
+
+/* Separator of the instance, `,` is used when it is not set */
+#define THOUSANDS_SEP(lwi)     ((lwi)->lwobj->thousands_sep != '\0' ? (lwi)->lwobj->thousands_sep : ',')
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_INT || LWPRINTF_CFG_SUPPORT_TYPE_POINTER || LWPRINTF_CFG_SUPPORT_TYPE_BYTE_ARRAY             \
+    || LWPRINTF_CFG_SUPPORT_TYPE_FIXED
+
+/**
+ * \brief           Output integer digits, grouped to thousands with separator of the instance
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in]       digits: Digits to output, the most significant first
+ * \param[in]       len: Number of digits
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_out_digits_grouped(lwprintf_int_t* lwi, const char* digits, size_t len) {
+    size_t cnt = len % 3 == 0 ? 3 : len % 3;
+
+    /* First group may be shorter, all others have 3 digits */
+    prv_out_str_raw(lwi, digits, cnt);
+    for (; cnt < len; cnt += 3) {
+        lwi->out_fn(lwi, THOUSANDS_SEP(lwi));
+        prv_out_str_raw(lwi, &digits[cnt], 3);
+    }
+    return 1;
+}
+
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_INT || LWPRINTF_CFG_SUPPORT_TYPE_POINTER || LWPRINTF_CFG_SUPPORT_TYPE_BYTE_ARRAY \
+          || LWPRINTF_CFG_SUPPORT_TYPE_FIXED */
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_FLOAT
+
+/**
+ * \brief           Output thousands separator after integer digit, when it completes a group
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in]       left: Number of integer digits still to be output after current one
+ */
+static void
+prv_out_thousands_sep(lwprintf_int_t* lwi, size_t left) {
+    if (lwi->m.flags.thousands && left > 0 && left % 3 == 0) {
+        lwi->out_fn(lwi, THOUSANDS_SEP(lwi));
+    }
+}
+
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FLOAT */
+
+#endif /* LWPRINTF_CFG_SUPPORT_THOUSANDS */
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_INT || LWPRINTF_CFG_SUPPORT_TYPE_POINTER || LWPRINTF_CFG_SUPPORT_TYPE_BYTE_ARRAY             \
+    || LWPRINTF_CFG_SUPPORT_TYPE_FIXED || LWPRINTF_CFG_SUPPORT_TYPE_SI || FLOAT_FIXED_FAST
+
+/* Lookup table of all decimal numbers with 2 digits, 00 to 99 */
+static const char digits_dec_2x[] = "00010203040506070809"
+                                    "10111213141516171819"
+                                    "20212223242526272829"
+                                    "30313233343536373839"
+                                    "40414243444546474849"
+                                    "50515253545556575859"
+                                    "60616263646566676869"
+                                    "70717273747576777879"
+                                    "80818283848586878889"
+                                    "90919293949596979899";
+
+/* Lookup tables of hexadecimal digits */
+static const char digits_hex_lc[] = "0123456789abcdef";
+static const char digits_hex_uc[] = "0123456789ABCDEF";
+
+/**
+ * \brief           Calculate number of digits of `unsigned int` number in selected base, with native integer width
+ * \param[in]       num: Number to check
+ * \param[in]       base: Number base. Must be one of `2`, `8`, `10` or `16`
+ * \return          Number of digits
+ */
+static size_t
+prv_uint_digits_cnt(unsigned int num, uint8_t base) {
+    size_t len = 1;
+
+    if (base == 10) {
+        /* Count digits with comparisons only */
+        for (unsigned int pwr = 10; num >= pwr; pwr *= 10) {
+            ++len;
+            if (pwr > UINT_MAX / 10) {
+                break;
+            }
+        }
+    } else {
+        const uint8_t shift = base == 16 ? 4 : (base == 8 ? 3 : 1);
+
+        for (num >>= shift; num > 0; num >>= shift, ++len) {}
+    }
+    return len;
+}
+
+/**
+ * \brief           Calculate number of digits of unsigned number of the longest type in selected base
+ * \param[in]       num: Number to check
+ * \param[in]       base: Number base. Must be one of `2`, `8`, `10` or `16`
+ * \return          Number of digits
+ */
+static size_t
+prv_unsigned_int_digits_cnt(uint_maxtype_t num, uint8_t base) {
+#if UINT_MAXTYPE_MAX > UINT_MAX
+    size_t len = 1;
+
+    if (num <= UINT_MAX) {
+        return prv_uint_digits_cnt((unsigned int)num, base);
+    }
+    if (base == 10) {
+        /* Count digits with comparisons only */
+        for (uint_maxtype_t pwr = 10; num >= pwr; pwr *= 10) {
+            ++len;
+            if (pwr > UINT_MAXTYPE_MAX / 10) {
+                break;
+            }
+        }
+    } else {
+        const uint8_t shift = base == 16 ? 4 : (base == 8 ? 3 : 1);
+
+        for (num >>= shift; num > 0; num >>= shift, ++len) {}
+    }
+    return len;
+#else
+    return prv_uint_digits_cnt((unsigned int)num, base);
+#endif /* UINT_MAXTYPE_MAX > UINT_MAX */
+}
+
+/**
+ * \brief           Convert `unsigned int` number to digits in selected base, with native integer width
+ *
+ * Number of digits is calculated first, digits are then written in place,
+ * from the least significant digit, without need to reverse the string.
+ * Base `10` is processed with `2` digits per division,
+ * bases `2`, `8` and `16` use shift and mask operations only.
+ *
+ * \param[out]      buff: Output buffer, not `NULL` terminated.
+ *                      It must hold all digits, that is `sizeof(unsigned int) * CHAR_BIT` bytes for binary base
+ * \param[in]       num: Number to convert
+ * \param[in]       base: Number base. Must be one of `2`, `8`, `10` or `16`
+ * \param[in]       uc: Set to `1` to use uppercase hexadecimal letters
+ * \return          Number of digits written to the buffer
+ */
+static size_t
+prv_uint_to_digits(char* buff, unsigned int num, uint8_t base, uint8_t uc) {
+    size_t len = prv_uint_digits_cnt(num, base);
+    char* ptr = &buff[len];
+
+    if (base == 10) {
+        for (; num >= 100; num /= 100) {
+            const size_t idx = (size_t)(num % 100) * 2;
+            *--ptr = digits_dec_2x[idx + 1];
+            *--ptr = digits_dec_2x[idx];
+        }
+        if (num >= 10) {
+            *--ptr = digits_dec_2x[(size_t)num * 2 + 1];
+            *--ptr = digits_dec_2x[(size_t)num * 2];
+        } else {
+            *--ptr = (char)('0' + (char)num);
+        }
+    } else {
+        const uint8_t shift = base == 16 ? 4 : (base == 8 ? 3 : 1);
+        const uint8_t mask = (uint8_t)(base - 1);
+        const char* digits = uc ? digits_hex_uc : digits_hex_lc;
+
+        do {
+            *--ptr = digits[(size_t)(num & mask)];
+            num >>= shift;
+        } while (num > 0);
+    }
+    return len;
+}
+
+/**
+ * \brief           Convert unsigned number of the longest type to digits in selected base
+ *
+ * Number that fits to `unsigned int` is converted with native integer width,
+ * only larger numbers pay for wide arithmetic, that may be a library call on 32-bit targets.
+ *
+ * \param[out]      buff: Output buffer, not `NULL` terminated.
+ *                      It must hold all digits, that is `sizeof(uint_maxtype_t) * CHAR_BIT` bytes for binary base
+ * \param[in]       num: Number to convert
+ * \param[in]       base: Number base. Must be one of `2`, `8`, `10` or `16`
+ * \param[in]       uc: Set to `1` to use uppercase hexadecimal letters
+ * \return          Number of digits written to the buffer
+ */
+static size_t
+prv_unsigned_int_to_digits(char* buff, uint_maxtype_t num, uint8_t base, uint8_t uc) {
+#if UINT_MAXTYPE_MAX > UINT_MAX
+    size_t len;
+    char* ptr;
+
+    if (num <= UINT_MAX) {
+        return prv_uint_to_digits(buff, (unsigned int)num, base, uc);
+    }
+    len = prv_unsigned_int_digits_cnt(num, base);
+    ptr = &buff[len];
+    if (base == 10) {
+        /* Wide divisions only until remaining part fits to native type */
+        for (; num > UINT_MAX; num /= 100) {
+            const size_t idx = (size_t)(num % 100) * 2;
+            *--ptr = digits_dec_2x[idx + 1];
+            *--ptr = digits_dec_2x[idx];
+        }
+        prv_uint_to_digits(buff, (unsigned int)num, 10, uc);
+    } else {
+        const uint8_t shift = base == 16 ? 4 : (base == 8 ? 3 : 1);
+        const uint8_t mask = (uint8_t)(base - 1);
+        const char* digits = uc ? digits_hex_uc : digits_hex_lc;
+
+        do {
+            *--ptr = digits[(size_t)(num & mask)];
+            num >>= shift;
+        } while (num > 0);
+    }
+    return len;
+#else
+    return prv_uint_to_digits(buff, (unsigned int)num, base, uc);
+#endif /* UINT_MAXTYPE_MAX > UINT_MAX */
+}
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_INT || LWPRINTF_CFG_SUPPORT_TYPE_POINTER
+
+/**
+ * \brief           Output digits of converted number
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in]       num_buf: Digits of the number
+ * \param[in]       len: Number of digits
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_out_int_digits(lwprintf_int_t* lwi, const char* num_buf, size_t len) {
+#if LWPRINTF_CFG_SUPPORT_THOUSANDS
+    if (lwi->m.flags.thousands && lwi->m.base == 10) {
+        const size_t full_len = len + THOUSANDS_SEP_CNT(len);
+
+        prv_out_str_before(lwi, full_len);
+        prv_out_digits_grouped(lwi, num_buf, len);
+        prv_out_str_after(lwi, full_len);
+        return 1;
+    }
+#endif /* LWPRINTF_CFG_SUPPORT_THOUSANDS */
+    prv_out_str_before(lwi, len);
+    prv_out_str_raw(lwi, num_buf, len);
+    prv_out_str_after(lwi, len);
+    return 1;
+}
+
+#if LWPRINTF_CFG_REDUCED_STACK
+
+/* Octal representation requires the most digits, binary is output without buffer */
+#define INT_BUFF_SIZE(type) ((sizeof(type) * CHAR_BIT + 2) / 3)
+
+#else /* LWPRINTF_CFG_REDUCED_STACK */
+
+/* Binary representation requires the most digits */
+#define INT_BUFF_SIZE(type) (sizeof(type) * CHAR_BIT)
+
+#endif /* !LWPRINTF_CFG_REDUCED_STACK */
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_INT || UINTPTR_MAX == UINT_MAX
+
+/**
+ * \brief           Convert `unsigned int` to string, with native integer width
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in]       num: Number to convert to string
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_unsigned_int_to_str(lwprintf_int_t* lwi, unsigned int num) {
+    char num_buf[INT_BUFF_SIZE(unsigned int)];
+
+    /* Check if number is zero */
+    lwi->m.flags.is_num_zero = num == 0;
+    if (IS_MEASURE_MODE(lwi)) {
+        /* Digits are not generated, only counted */
+        return prv_out_int_digits(lwi, digits_dec_2x, prv_uint_digits_cnt(num, lwi->m.base));
+    }
+#if LWPRINTF_CFG_REDUCED_STACK
+    if (lwi->m.base == 2) {
+        /* Digits are output from the most significant one, in the same stack frame */
+        const size_t len = prv_uint_digits_cnt(num, 2);
+
+        prv_out_str_before(lwi, len);
+        for (size_t pos = len; pos > 0; --pos) {
+            lwi->out_fn(lwi, (char)('0' + (char)((num >> (pos - 1)) & 1)));
+        }
+        prv_out_str_after(lwi, len);
+        return 1;
+    }
+#endif /* LWPRINTF_CFG_REDUCED_STACK */
+    return prv_out_int_digits(lwi, num_buf, prv_uint_to_digits(num_buf, num, lwi->m.base, lwi->m.flags.uc));
+}
+
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_INT || UINTPTR_MAX == UINT_MAX */
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_INT || UINTPTR_MAX != UINT_MAX
+
+/**
+ * \brief           Convert unsigned number of the longest type to string
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in]       num: Number to convert to string
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_longest_unsigned_int_to_str(lwprintf_int_t* lwi, uint_maxtype_t num) {
+    char num_buf[INT_BUFF_SIZE(uint_maxtype_t)];
+
+    /* Check if number is zero */
+    lwi->m.flags.is_num_zero = num == 0;
+    if (IS_MEASURE_MODE(lwi)) {
+        /* Digits are not generated, only counted */
+        return prv_out_int_digits(lwi, digits_dec_2x, prv_unsigned_int_digits_cnt(num, lwi->m.base));
+    }
+#if LWPRINTF_CFG_REDUCED_STACK
+    if (lwi->m.base == 2) {
+        /* Digits are output from the most significant one, in the same stack frame */
+        const size_t len = prv_unsigned_int_digits_cnt(num, 2);
+
+        prv_out_str_before(lwi, len);
+        for (size_t pos = len; pos > 0; --pos) {
+            lwi->out_fn(lwi, (char)('0' + (char)((num >> (pos - 1)) & 1)));
+        }
+        prv_out_str_after(lwi, len);
+        return 1;
+    }
+#endif /* LWPRINTF_CFG_REDUCED_STACK */
+    return prv_out_int_digits(lwi, num_buf, prv_unsigned_int_to_digits(num_buf, num, lwi->m.base, lwi->m.flags.uc));
+}
+
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_INT || UINTPTR_MAX != UINT_MAX */
+
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_INT || LWPRINTF_CFG_SUPPORT_TYPE_POINTER */
+
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_INT || LWPRINTF_CFG_SUPPORT_TYPE_POINTER || LWPRINTF_CFG_SUPPORT_TYPE_BYTE_ARRAY \
+            || LWPRINTF_CFG_SUPPORT_TYPE_FIXED || LWPRINTF_CFG_SUPPORT_TYPE_SI || FLOAT_FIXED_FAST */
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_INT
+
+/**
+ * \brief           Convert `signed int` to string, with native integer width
+ * \param[in,out]   lwi: LwPRINTF instance
+ * \param[in]       num: Number to convert to string
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_signed_int_to_str(lwprintf_int_t* lwi, signed int num) {
+    /* Negate in unsigned domain, to properly handle the most negative number */
+    if (num < 0) {
+        lwi->m.flags.is_negative = 1;
+        return prv_unsigned_int_to_str(lwi, 0U - (unsigned int)num);
+    }
+    return prv_unsigned_int_to_str(lwi, (unsigned int)num);
+}
+
+/**
+ * \brief           Convert signed number of the longest type to string
+ * \param[in,out]   lwi: LwPRINTF instance
+ * \param[in]       num: Number to convert to string
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_longest_signed_int_to_str(lwprintf_int_t* lwi, int_maxtype_t num) {
+    /* Negate in unsigned domain, to properly handle the most negative number */
+    if (num < 0) {
+        lwi->m.flags.is_negative = 1;
+        return prv_longest_unsigned_int_to_str(lwi, (uint_maxtype_t)0 - (uint_maxtype_t)num);
+    }
+    return prv_longest_unsigned_int_to_str(lwi, (uint_maxtype_t)num);
+}
+
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_INT */
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_FIXED
+
+/* Fractional bits, where multiplication of fraction by 10 does not overflow */
+#define FIXED_MAX_BITS      (sizeof(uint_maxtype_t) * CHAR_BIT - 4)
+#define FIXED_NATIVE_BITS   (sizeof(unsigned int) * CHAR_BIT - 4)
+#define FIXED_HALF_BITS     (sizeof(uint_maxtype_t) * CHAR_BIT / 2)
+#define FIXED_LIMIT_BITS    (sizeof(uint_maxtype_t) * CHAR_BIT - 1) /*!< Fractional bits of the longest signed type */
+#define FIXED_MAX_PRECISION 20 /*!< Maximum number of calculated decimals, more are printed as `0` */
+
+/**
+ * \brief           Generate decimal digits of binary fraction, rounded half up
+ * \param[out]      buff: Output buffer for `cnt` digits
+ * \param[in]       frac: Fraction, lower than `2^bits`
+ * \param[in]       bits: Number of fractional bits, up to \ref FIXED_LIMIT_BITS
+ * \param[in]       cnt: Number of digits to generate
+ * \return          `1` if rounding carries to integer part, `0` otherwise
+ */
+static uint8_t
+prv_fixed_frac_digits(char* buff, uint_maxtype_t frac, uint8_t bits, size_t cnt) {
+    uint8_t round_up;
+
+#if UINT_MAXTYPE_MAX > UINT_MAX
+    if (bits <= FIXED_NATIVE_BITS) {
+        /* Fraction fits to native type, such as Q15 and Q16 on 32-bit cores */
+        unsigned int f = (unsigned int)frac;
+        const unsigned int mask = (1U << bits) - 1U;
+
+        for (size_t i = 0; i < cnt; ++i) {
+            f *= 10U;
+            buff[i] = (char)('0' + (char)(f >> bits));
+            f &= mask;
+        }
+        round_up = bits > 0 && f >= (1U << (bits - 1));
+    } else
+#endif /* UINT_MAXTYPE_MAX > UINT_MAX */
+    if (bits > FIXED_MAX_BITS) {
+        /* Fraction multiplied by 10 does not fit, it is multiplied in two halves, with carry to the upper one */
+        const uint_maxtype_t lo_mask = ((uint_maxtype_t)1 << FIXED_HALF_BITS) - 1;
+        const uint8_t hi_bits = (uint8_t)(bits - FIXED_HALF_BITS);
+        const uint_maxtype_t hi_mask = ((uint_maxtype_t)1 << hi_bits) - 1;
+        uint_maxtype_t hi = frac >> FIXED_HALF_BITS, lo = frac & lo_mask;
+
+        for (size_t i = 0; i < cnt; ++i) {
+            lo *= 10;
+            hi = hi * 10 + (lo >> FIXED_HALF_BITS);
+            lo &= lo_mask;
+            buff[i] = (char)('0' + (char)(hi >> hi_bits));
+            hi &= hi_mask;
+        }
+        round_up = hi >= ((uint_maxtype_t)1 << (hi_bits - 1));
+    } else {
+        const uint_maxtype_t mask = ((uint_maxtype_t)1 << bits) - 1;
+
+        for (size_t i = 0; i < cnt; ++i) {
+            frac *= 10;
+            buff[i] = (char)('0' + (char)(frac >> bits));
+            frac &= mask;
+        }
+        round_up = bits > 0 && frac >= ((uint_maxtype_t)1 << (bits - 1));
+    }
+
+    /* Propagate rounding through generated digits */
+    for (size_t i = cnt; round_up && i > 0; --i) {
+        if (buff[i - 1] == '9') {
+            buff[i - 1] = '0';
+        } else {
+            ++buff[i - 1];
+            round_up = 0;
+        }
+    }
+    return round_up;
+}
+
+/**
+ * \brief           Convert fixed-point number to string, with integer operations only
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in]       num: Raw fixed-point value, with `lwi->m.qbits` fractional bits
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_fixed_to_str(lwprintf_int_t* lwi, int_maxtype_t num) {
+    /* Decimals are calculated first to the end of the buffer, as rounding may carry to integer part */
+    char buff[sizeof(uint_maxtype_t) * CHAR_BIT / 3 + 1 + FIXED_MAX_PRECISION];
+    char* const frac_buff = &buff[sizeof(buff) - FIXED_MAX_PRECISION];
+    const uint8_t bits = lwi->m.qbits;
+    uint_maxtype_t mag, int_part;
+    size_t prec, calc_prec, len, int_len, full_len;
+
+    /* Value can not be scaled by more bits than the longest type has, specifier is printed as unknown type */
+    if (bits > FIXED_LIMIT_BITS) {
+        lwi->out_fn(lwi, 'q');
+        return 0;
+    }
+    /* Negate in unsigned domain, to properly handle the most negative number */
+    mag = num < 0 ? (uint_maxtype_t)0 - (uint_maxtype_t)num : (uint_maxtype_t)num;
+    lwi->m.flags.is_negative = num < 0;
+    lwi->m.base = 10;
+    int_part = bits > 0 ? mag >> bits : mag;
+
+    prec = lwi->m.flags.precision ? (size_t)lwi->m.precision : LWPRINTF_CFG_FLOAT_DEFAULT_PRECISION;
+    calc_prec = prec > FIXED_MAX_PRECISION ? FIXED_MAX_PRECISION : prec;
+    if (prv_fixed_frac_digits(frac_buff, bits > 0 ? mag & (((uint_maxtype_t)1 << bits) - 1) : 0, bits, calc_prec)) {
+        ++int_part;
+    }
+
+    /* Integer part, decimal point and calculated decimals */
+    len = int_len = prv_unsigned_int_to_digits(buff, int_part, 10, 0);
+    if (prec > 0 || lwi->m.flags.alt) {
+        buff[len++] = '.';
+    }
+    memmove(&buff[len], frac_buff, calc_prec);
+    len += calc_prec;
+    full_len = len + (prec - calc_prec);
+
+#if LWPRINTF_CFG_SUPPORT_THOUSANDS
+    if (lwi->m.flags.thousands) {
+        full_len += THOUSANDS_SEP_CNT(int_len);
+        prv_out_str_before(lwi, full_len);
+        prv_out_digits_grouped(lwi, buff, int_len);
+    } else
+#endif /* LWPRINTF_CFG_SUPPORT_THOUSANDS */
+    {
+        prv_out_str_before(lwi, full_len);
+        prv_out_str_raw(lwi, buff, int_len);
+    }
+    prv_out_str_raw(lwi, &buff[int_len], len - int_len);
+    prv_out_fill(lwi, '0', prec - calc_prec);
+    prv_out_str_after(lwi, full_len);
+    return 1;
+}
+
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FIXED */
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_SI
+
+#define SI_MAX_DIGITS  (sizeof(uint_maxtype_t) * CHAR_BIT / 3 + 1) /*!< Maximum number of significant digits */
+#define SI_MAX_EXP     24                                           /*!< Exponent of the largest prefix, `Y` */
+#define SI_MICRO_INDEX 6                                            /*!< Index of micro prefix in the table */
+
+/* Prefixes from `1e-24` to `1e24`, micro is replaced by configured string and no prefix is used for `1e0` */
+static const char si_prefixes[] = "yzafpnum kMGTPEZY";
+
+/**
+ * \brief           Get number of significant digits for SI prefix type
+ * \param[in]       lwi: LwPRINTF internal instance
+ * \param[in]       max: Maximum number of digits
+ * \return          Number of digits, at least `1`
+ */
+static size_t
+prv_si_precision(const lwprintf_int_t* lwi, size_t max) {
+    size_t prec = lwi->m.flags.precision ? (size_t)lwi->m.precision : LWPRINTF_CFG_FLOAT_DEFAULT_PRECISION;
+
+    prec = prec > 0 ? prec : 1;
+    return prec > max ? max : prec;
+}
+
+/**
+ * \brief           Output significant digits with decimal point and SI prefix
+ *
+ * Exponent is rounded down to multiple of `3`, that leaves `1` to `3` digits before decimal point.
+ * Values out of prefix range get more integer digits or leading zeros instead.
+ * Below the `y` prefix, fraction is rounded to number of digits, that keeps the output short down to `0y`.
+ *
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in,out]   digits: Significant digits, the most significant first, modified by rounding
+ * \param[in]       cnt: Number of digits
+ * \param[in]       exp: Decimal exponent of the first digit
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_si_out(lwprintf_int_t* lwi, char* digits, size_t cnt, int exp) {
+    int exp3 = exp >= 0 ? exp / 3 * 3 : -((2 - exp) / 3 * 3);
+    int int_len;
+    const char* prefix;
+    size_t prefix_len, int_cnt, int_zeros, frac_zeros, frac_cnt, full_len;
+    uint8_t has_dot;
+
+    exp3 = exp3 > SI_MAX_EXP ? SI_MAX_EXP : (exp3 < -SI_MAX_EXP ? -SI_MAX_EXP : exp3);
+    int_len = exp - exp3 + 1;
+    prefix = &si_prefixes[exp3 / 3 + SI_MAX_EXP / 3];
+    prefix_len = exp3 != 0;
+    if (exp3 / 3 + SI_MAX_EXP / 3 == SI_MICRO_INDEX) {
+        prefix = LWPRINTF_CFG_SI_MICRO;
+        prefix_len = sizeof(LWPRINTF_CFG_SI_MICRO) - 1;
+    }
+
+    /* Leading zeros of fraction take place of the last digits, with round half up and carry to the leading zero */
+    if (int_len < 0) {
+        size_t zeros = (size_t)-int_len, keep = zeros < cnt ? cnt - zeros : 0;
+        uint8_t round_up = zeros <= cnt && digits[keep] >= '5';
+
+        for (size_t i = keep; round_up && i > 0; --i) {
+            if (digits[i - 1] == '9') {
+                digits[i - 1] = '0';
+            } else {
+                ++digits[i - 1];
+                round_up = 0;
+            }
+        }
+        if (round_up) {
+            digits[keep] = '0';
+            digits[0] = '1';
+            cnt = keep + 1;
+            ++int_len;
+        } else if (keep == 0) {
+            digits[0] = '0';
+            cnt = 1;
+            int_len = 1;
+        } else {
+            cnt = keep;
+        }
+    }
+
+    /* Trailing zeros are removed, unless alternate form is used */
+    if (!lwi->m.flags.alt) {
+        for (; cnt > 1 && digits[cnt - 1] == '0'; --cnt) {}
+    }
+
+    /* Integer part is taken from digits, padded with zeros, or it is single `0` before leading zeros of fraction */
+    if (int_len > 0) {
+        int_cnt = (size_t)int_len < cnt ? (size_t)int_len : cnt;
+        int_zeros = (size_t)int_len - int_cnt;
+        frac_zeros = 0;
+    } else {
+        int_cnt = 0;
+        int_zeros = 1;
+        frac_zeros = (size_t)-int_len;
+    }
+    frac_cnt = cnt - int_cnt;
+    has_dot = frac_cnt > 0 || lwi->m.flags.alt;
+    full_len = int_cnt + int_zeros + has_dot + frac_zeros + frac_cnt + prefix_len;
+
+    prv_out_str_before(lwi, full_len);
+    prv_out_str_raw(lwi, digits, int_cnt);
+    prv_out_fill(lwi, '0', int_zeros);
+    if (has_dot) {
+        lwi->out_fn(lwi, '.');
+    }
+    prv_out_fill(lwi, '0', frac_zeros);
+    prv_out_str_raw(lwi, &digits[int_cnt], frac_cnt);
+    prv_out_str_raw(lwi, prefix, prefix_len);
+    prv_out_str_after(lwi, full_len);
+    return 1;
+}
+
+/**
+ * \brief           Convert integer to SI prefix notation, with integer operations only
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in]       num: Number to convert to string
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_si_int_to_str(lwprintf_int_t* lwi, int_maxtype_t num) {
+    char buff[SI_MAX_DIGITS];
+    uint_maxtype_t mag;
+    size_t prec, len;
+    int exp;
+
+    /* Negate in unsigned domain, to properly handle the most negative number */
+    mag = num < 0 ? (uint_maxtype_t)0 - (uint_maxtype_t)num : (uint_maxtype_t)num;
+    lwi->m.flags.is_negative = num < 0;
+    lwi->m.base = 10;
+    prec = prv_si_precision(lwi, SI_MAX_DIGITS);
+    len = prv_unsigned_int_to_digits(buff, mag, 10, 0);
+    exp = (int)len - 1;
+    if (len > prec) {
+        /* Round half up, carry out of the first digit leaves `1` followed by zeros */
+        uint8_t round_up = buff[prec] >= '5';
+
+        for (size_t i = prec; round_up && i > 0; --i) {
+            if (buff[i - 1] == '9') {
+                buff[i - 1] = '0';
+            } else {
+                ++buff[i - 1];
+                round_up = 0;
+            }
+        }
+        if (round_up) {
+            buff[0] = '1';
+            ++exp;
+        }
+    } else {
+        memset(&buff[len], '0', prec - len);
+    }
+    return prv_si_out(lwi, buff, prec, exp);
+}
+
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_SI */
+
+#if LWPRINTF_CFG_STRING_WORD_SCAN
+/*
+ * Word scan reads whole aligned words, also bytes after string termination in the same word.
+ * Such read stays in the same memory page, but it is out of bounds of the string object,
+ * hence the word type may alias any object and address sanitizer does not check the scan function
+ */
+#if defined(__GNUC__)
+typedef size_t __attribute__((__may_alias__)) str_word_t;
+#define STR_WORD_READ(w, s) ((w) = *(const str_word_t*)(const void*)(s))
+#define STR_WORD_NO_SANITIZE __attribute__((__no_sanitize_address__))
+#else
+#define STR_WORD_READ(w, s) memcpy(&(w), (s), sizeof(w))
+#if defined(_MSC_VER)
+#define STR_WORD_NO_SANITIZE __declspec(no_sanitize_address)
+#else
+#define STR_WORD_NO_SANITIZE
+#endif /* defined(_MSC_VER) */
+#endif /* defined(__GNUC__) */
+#endif /* LWPRINTF_CFG_STRING_WORD_SCAN */
+
+/**
+ * \brief           Calculate string length, limited to the maximum value.
+ * 
+ * \note            Use custom implementation to support potential `< C11` versions
+ * 
+ * \param           str: String to calculate
+ * \param           max_n: Max number of bytes at which length is cut
+ * \return          String length in bytes
+ */
+#if LWPRINTF_CFG_STRING_WORD_SCAN
+STR_WORD_NO_SANITIZE
+#endif /* LWPRINTF_CFG_STRING_WORD_SCAN */
+size_t
+prv_strnlen(const char* str, size_t max_n) {
+#if LWPRINTF_CFG_STRING_WORD_SCAN
+    /* Bit-masks with lowest and highest bit set in every byte of the word */
+    const size_t ones = (size_t)-1 / 0xFF, highs = ones * 0x80;
+    const char* s = str;
+
+    /* Bytes up to the word alignment */
+    for (; ((uintptr_t)s & (sizeof(size_t) - 1)) != 0; ++s) {
+        if ((size_t)(s - str) >= max_n || *s == '\0') {
+            return (size_t)(s - str);
+        }
+    }
+
+    /* Word has zero byte, when subtraction borrows to the highest bit of any byte, that was not set before */
+    for (; max_n - (size_t)(s - str) >= sizeof(size_t); s += sizeof(size_t)) {
+        size_t w;
+
+        STR_WORD_READ(w, s);
+        if (((w - ones) & ~w & highs) != 0) {
+            break;
+        }
+    }
+    for (; (size_t)(s - str) < max_n && *s != '\0'; ++s) {}
+    return (size_t)(s - str);
+#else
+    size_t length = 0;
+
+    for (; *str != '\0' && length < max_n; ++length, ++str) {}
+    return length;
+#endif /* LWPRINTF_CFG_STRING_WORD_SCAN */
+}
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_FLOAT && !LWPRINTF_CFG_FLOAT_SHORTEST
+
+/**
+ * \brief           Calculate necessary parameters for input number
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in]       n: Float number instance
+ * \param[in]       num: Input number
+ * \param[in]       type: Format type
+ */
+static void
+prv_calculate_dbl_num_data(lwprintf_int_t* lwi, float_num_t* n, float_type_t num, const char type) {
+    float_type_t decimal_part_dbl, diff;
+
+    memset(n, 0x00, sizeof(*n));
+
+    if (lwi->m.precision > FLOAT_MAX_PRECISION) {
+        lwi->m.precision = FLOAT_MAX_PRECISION;
+    }
+
+    /*
+     * Get integer and decimal parts, both in integer formats
+     *
+     * As an example, with input number of 12.345678 and precision digits set as 4, then result is the following:
+     *
+     * integer_part = 12            -> Actual integer part of the double number
+     * decimal_part_dbl = 3456.78   -> Decimal part multiplied by 10^precision, keeping it in double format
+     * decimal_part = 3456          -> Integer part of decimal number
+     * diff = 0.78                  -> Difference between actual decimal and integer part of decimal
+     *                                  This is used for rounding of last digit (if necessary)
+     *
+     * Double temporaries are local, they are not kept alive while number is printed
+     */
+    if (lwi->m.precision <= FLOAT_ROUND_OFFSET_PRECISION) {
+        num += (float_type_t)0.000000000000005;
+    }
+    n->integer_part = (float_long_t)num;
+    decimal_part_dbl = (num - (float_type_t)n->integer_part) * (float_type_t)powers_of_10[lwi->m.precision];
+    n->decimal_part = (float_long_t)decimal_part_dbl;
+    diff = decimal_part_dbl - (float_type_t)((float_long_t)n->decimal_part);
+
+    /* Rounding check of last digit */
+    if (diff > (float_type_t)0.5) {
+        ++n->decimal_part;
+        if (n->decimal_part >= powers_of_10[lwi->m.precision]) {
+            n->decimal_part = 0;
+            ++n->integer_part;
+        }
+    } else if (diff < (float_type_t)0.5) {
+        /* Used in separate if, since comparing float to == will certainly result to false */
+    } else {
+        /* Difference is exactly 0.5 */
+        if (n->decimal_part == 0) {
+            ++n->integer_part;
+        } else {
+            ++n->decimal_part;
+        }
+    }
+
+    /* Calculate number of digits for integer and decimal parts */
+    if (n->integer_part == 0) {
+        n->digits_cnt_integer_part = 1;
+    } else {
+        float_long_t tmp;
+        for (n->digits_cnt_integer_part = 0, tmp = n->integer_part; tmp > 0; ++n->digits_cnt_integer_part, tmp /= 10) {}
+    }
+    n->digits_cnt_decimal_part = (short)lwi->m.precision;
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING
+    /* Calculate minimum useful digits for decimal (excl last useless zeros) */
+    if (type == 'g') {
+        float_long_t tmp = n->decimal_part;
+        short adder, i;
+
+        for (adder = 0, i = 0; tmp > 0 || i < (short)lwi->m.precision;
+             tmp /= 10, n->digits_cnt_decimal_part_useful += adder, ++i) {
+            if (adder == 0 && (tmp % 10) > 0) {
+                adder = 1;
+            }
+        }
+    } else
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING */
+    {
+        n->digits_cnt_decimal_part_useful = (short)lwi->m.precision;
+    }
+}
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING
+
+/**
+ * \brief           Normalize positive number to range `[1, 10)` and calculate its decimal exponent
+ *
+ * With IEEE-754 type, exponent is estimated from binary exponent as `floor(e2 * log10(2))`,
+ * and number is scaled with maximum of `4` multiplications or divisions, regardless of its magnitude.
+ * Both powers of 10 are applied one after another, as their product is not exact
+ *
+ * \param[in,out]   num: Pointer to positive number to normalize. Number `0` is left as is
+ * \return          Decimal exponent of the number
+ */
+static int
+prv_double_normalize(float_type_t* num) {
+    int exp_cnt = 0;
+
+    if (*num == 0) {
+        return 0;
+    }
+#if FLOAT_IEEE754
+    {
+        float_bits_t bits;
+        int e2, k;
+
+        /* Subnormal number is scaled up first, to keep all powers of 10 in range */
+        if (*num < FLOAT_TYPE_MIN) {
+            *num *= pwr10_lo[15] * 10;
+            exp_cnt = -16;
+        }
+        memcpy(&bits, num, sizeof(bits));
+        e2 = (int)((bits >> FLOAT_MANT_BITS) & FLOAT_EXP_MASK) - FLOAT_EXP_BIAS;
+
+        /* Estimate is exact or 1 less than actual exponent, 78913 / 2^18 approximates log10(2) */
+        k = e2 >= 0 ? ((e2 * 78913) >> 18) : -((-e2 * 78913 + (1 << 18) - 1) >> 18);
+        if (k > 0) {
+            *num /= pwr10_hi[k / 16];
+            *num /= pwr10_lo[k % 16];
+        } else if (k < 0) {
+            *num *= pwr10_lo[-k % 16];
+            *num *= pwr10_hi[-k / 16];
+        }
+        exp_cnt += k;
+
+        /* Single correction step */
+        if (*num >= 10) {
+            *num /= 10;
+            ++exp_cnt;
+        } else if (*num < 1) {
+            *num *= 10;
+            --exp_cnt;
+        }
+    }
+#else  /* FLOAT_IEEE754 */
+    if (*num < 1) {
+        for (int i = 0; *num < 1 && i < FLOAT_EXP_ITER_MAX; *num *= 10, --exp_cnt, ++i) {}
+    } else {
+        for (int i = 0; *num >= 10 && i < FLOAT_EXP_ITER_MAX; *num /= 10, ++exp_cnt, ++i) {}
+    }
+#endif /* !FLOAT_IEEE754 */
+    return exp_cnt;
+}
+
+#if SI_FLOAT
+
+/**
+ * \brief           Convert double number to SI prefix notation
+ *
+ * Number is normalized to get decimal exponent, significant digits are then calculated as one integer
+ *
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in]       num: Number to convert to string
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_si_double_to_str(lwprintf_int_t* lwi, float_type_t num) {
+    char buff[SI_MAX_DIGITS];
+    float_long_t sig;
+    size_t prec, len;
+    int exp;
+
+    if (num != num) {
+        return prv_out_str(lwi, "nan", 3);
+    } else if (num < -FLOAT_TYPE_MAX) {
+        return prv_out_str(lwi, "-inf", 4);
+    } else if (num > FLOAT_TYPE_MAX) {
+        return prv_out_str(lwi, &"+inf"[lwi->m.flags.plus ? 0 : 1], lwi->m.flags.plus ? 4 : 3);
+    }
+    SIGNED_CHECK_NEGATIVE(lwi, num);
+    prec = prv_si_precision(lwi, (size_t)FLOAT_MAX_PRECISION);
+
+    /* Rounding may carry to the next power of 10 */
+    exp = prv_double_normalize(&num);
+    sig = (float_long_t)(num * (float_type_t)powers_of_10[prec - 1] + (float_type_t)0.5);
+    if (sig >= powers_of_10[prec]) {
+        sig /= 10;
+        ++exp;
+    }
+    len = prv_unsigned_int_to_digits(buff, (uint_maxtype_t)sig, 10, 0);
+    memset(&buff[len], '0', prec - len);
+    return prv_si_out(lwi, buff, prec, exp);
+}
+
+#endif /* SI_FLOAT */
+
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING */
+
+#if FLOAT_FIXED_FAST
+
+/* Maximum number of digits of integer and decimal part together, they are printed as one integer */
+#define FIXED_FAST_DIGITS ((int)LWPRINTF_ARRAYSIZE(powers_of_10) - 1)
+
+/**
+ * \brief           Convert positive double number to string in `%f` notation with explicit precision, fast path
+ *
+ * Integer part and rounded decimal part are calculated the same way as in default engine,
+ * and are joined to single integer. Digits are then printed at once, with decimal point inserted.
+ *
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in]       num: Positive number, lower than `10^(FIXED_FAST_DIGITS - precision)`
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_double_to_str_fixed_fast(lwprintf_int_t* lwi, float_type_t num) {
+    char buff[FIXED_FAST_DIGITS + 1];
+    const size_t prec = (size_t)lwi->m.precision;
+    const float_long_t pwr = powers_of_10[prec];
+    float_long_t int_part, dec_part;
+    float_type_t dec_dbl;
+    size_t len, int_len, full_len;
+
+    /* Rounding offset and half up rounding of the last digit are the same as in default engine */
+    if (prec <= FLOAT_ROUND_OFFSET_PRECISION) {
+        num += (float_type_t)0.000000000000005;
+    }
+    int_part = (float_long_t)num;
+    dec_dbl = (num - (float_type_t)int_part) * (float_type_t)pwr;
+    dec_part = (float_long_t)dec_dbl;
+    if (dec_dbl - (float_type_t)dec_part >= (float_type_t)0.5 && ++dec_part >= pwr) {
+        dec_part = 0;
+        ++int_part;
+    }
+    len = prv_unsigned_int_to_digits(buff, (uint_maxtype_t)int_part * (uint_maxtype_t)pwr + (uint_maxtype_t)dec_part,
+                                     10, 0);
+
+    /* Integer part is `0` when all digits belong to decimals */
+    int_len = len > prec ? len - prec : 1;
+    full_len = int_len + (prec > 0 ? prec + 1 : 0);
+    prv_out_str_before(lwi, full_len);
+    if (len > prec) {
+        prv_out_str_raw(lwi, buff, int_len);
+    } else {
+        lwi->out_fn(lwi, '0');
+    }
+    if (prec > 0) {
+        lwi->out_fn(lwi, '.');
+        prv_out_fill(lwi, '0', len < prec ? prec - len : 0);
+        prv_out_str_raw(lwi, len > prec ? &buff[int_len] : buff, len < prec ? len : prec);
+    }
+    prv_out_str_after(lwi, full_len);
+    return 1;
+}
+
+#endif /* FLOAT_FIXED_FAST */
+
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FLOAT && !LWPRINTF_CFG_FLOAT_SHORTEST */
+
+#if LWPRINTF_CFG_FLOAT_EXACT
+
+#define EXACT_MANT_BITS  52         /*!< Stored mantissa bits of `double` */
+#define EXACT_EXP_BIAS   1075       /*!< Number is `mant * 2^(exp - EXACT_EXP_BIAS)` */
+#define EXACT_WORDS      34         /*!< Words of fraction of the smallest subnormal number, `1074` bits */
+#define EXACT_CHUNKS     35         /*!< Chunks of `9` digits of integer part of the largest number, `309` digits */
+#define EXACT_CHUNK_BASE 1000000000U
+
+/**
+ * \brief           Set words of big number to `num << shift`, other words are set to `0`
+ * \param[out]      words: Words of big number, the least significant first
+ * \param[in]       cnt: Number of words
+ * \param[in]       num: Number of up to `53` bits
+ * \param[in]       shift: Number of bits to shift, from `0` to `EXACT_WORDS * 32 - 53`
+ */
+static void
+prv_exact_set(uint32_t* words, size_t cnt, uint64_t num, size_t shift) {
+    const size_t idx = shift / 32;
+    const uint32_t sh = (uint32_t)(shift % 32);
+    const uint64_t lo = num << sh;
+    const uint32_t hi = sh > 0 ? (uint32_t)(num >> (64 - sh)) : 0;
+
+    memset(words, 0x00, cnt * sizeof(*words));
+    words[idx] = (uint32_t)lo;
+    if (idx + 1 < cnt) {
+        words[idx + 1] = (uint32_t)(lo >> 32);
+    }
+    if (idx + 2 < cnt) {
+        words[idx + 2] = hi;
+    }
+}
+
+/**
+ * \brief           Multiply fraction by `10` and get next decimal digit
+ * \param[in,out]   words: Words of fraction, the least significant first. Binary point is above the top word
+ * \param[in]       cnt: Number of words
+ * \return          Decimal digit, carried out of the top word
+ */
+static uint32_t
+prv_exact_frac_digit(uint32_t* words, size_t cnt) {
+    uint32_t carry = 0;
+
+    for (size_t i = 0; i < cnt; ++i) {
+        const uint64_t v = (uint64_t)words[i] * 10U + carry;
+
+        words[i] = (uint32_t)v;
+        carry = (uint32_t)(v >> 32);
+    }
+    return carry;
+}
+
+/**
+ * \brief           Convert double number to string in `%f` notation, with all digits exact
+ *
+ * Number is split to integer part and binary fraction of up to `1074` bits.
+ * Big integer part is divided to chunks of `9` digits. Fraction digits are generated
+ * by multiplication with `10` twice, first pass finds rounding and second one outputs digits.
+ * Digits beyond length of binary fraction are always `0`.
+ *
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in]       num: Number to convert to string
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_double_to_str_exact(lwprintf_int_t* lwi, double num) {
+    uint32_t words[EXACT_WORDS], chunks[EXACT_CHUNKS];
+    uint64_t bits, mant, int_part = 0, frac = 0;
+    size_t prec, calc_prec = 0, frac_bits = 0, frac_words = 0, chunks_cnt = 0, int_len, full_len, carry_pos = 0;
+    uint32_t digit = 0;
+    int exp2;
+    uint8_t round_up = 0;
+
+    prec = lwi->m.flags.precision ? (size_t)lwi->m.precision : LWPRINTF_CFG_FLOAT_DEFAULT_PRECISION;
+    memcpy(&bits, &num, sizeof(bits));
+    lwi->m.flags.is_negative = (uint8_t)(bits >> 63); /* Sign bit, also for negative zero */
+    mant = bits & (((uint64_t)1 << EXACT_MANT_BITS) - 1);
+    exp2 = (int)((bits >> EXACT_MANT_BITS) & 0x7FF);
+    if (exp2 > 0) {
+        mant |= (uint64_t)1 << EXACT_MANT_BITS;
+        exp2 -= EXACT_EXP_BIAS;
+    } else {
+        exp2 = 1 - EXACT_EXP_BIAS; /* Subnormal number */
+    }
+
+    /* Trailing zero bits do not produce digits, fraction gets as short as possible */
+    if (mant == 0) {
+        exp2 = 0;
+    }
+    for (; exp2 < 0 && (mant & 0x01) == 0; mant >>= 1, ++exp2) {}
+
+    if (exp2 >= 0) {
+        /* Integer number, divided to chunks from the least significant one */
+        size_t cnt = (size_t)exp2 / 32 + 3;
+
+        prv_exact_set(words, cnt, mant, (size_t)exp2);
+        while (cnt > 0) {
+            uint64_t rem = 0;
+
+            for (size_t i = cnt; i > 0; --i) {
+                rem = (rem << 32) | words[i - 1];
+                words[i - 1] = (uint32_t)(rem / EXACT_CHUNK_BASE);
+                rem %= EXACT_CHUNK_BASE;
+            }
+            chunks[chunks_cnt++] = (uint32_t)rem;
+            for (; cnt > 0 && words[cnt - 1] == 0; --cnt) {}
+        }
+    } else {
+        frac_bits = (size_t)-exp2;
+        int_part = frac_bits < 64 ? mant >> frac_bits : 0;
+        frac = frac_bits < 64 ? mant & (((uint64_t)1 << frac_bits) - 1) : mant;
+        frac_words = (frac_bits + 31) / 32;
+        calc_prec = prec < frac_bits ? prec : frac_bits;
+
+        /* Find rounding and position of the last digit, that is not `9`, where rounding carry stops */
+        prv_exact_set(words, frac_words, frac, frac_words * 32 - frac_bits);
+        for (size_t i = 0; i < calc_prec; ++i) {
+            digit = prv_exact_frac_digit(words, frac_words);
+            if (digit != 9) {
+                carry_pos = i + 1;
+            }
+        }
+        if (calc_prec < frac_bits && words[frac_words - 1] >= 0x80000000UL) {
+            /* Exactly half is rounded to even digit */
+            round_up = words[frac_words - 1] > 0x80000000UL
+                       || ((calc_prec > 0 ? digit : (uint32_t)int_part) & 0x01) != 0;
+            for (size_t i = 0; !round_up && i + 1 < frac_words; ++i) {
+                round_up = words[i] != 0;
+            }
+        }
+        if (round_up && carry_pos == 0) {
+            ++int_part;
+        }
+    }
+    if (chunks_cnt == 0) {
+        do {
+            chunks[chunks_cnt++] = (uint32_t)(int_part % EXACT_CHUNK_BASE);
+            int_part /= EXACT_CHUNK_BASE;
+        } while (int_part > 0);
+    }
+
+    /* Integer digits, decimal point and decimals */
+    int_len = 9 * (chunks_cnt - 1) + 1;
+    for (uint32_t v = chunks[chunks_cnt - 1]; v >= 10; v /= 10, ++int_len) {}
+    full_len = int_len + (prec > 0 || lwi->m.flags.alt) + prec;
+#if LWPRINTF_CFG_SUPPORT_THOUSANDS
+    if (lwi->m.flags.thousands) {
+        full_len += THOUSANDS_SEP_CNT(int_len);
+    }
+#endif /* LWPRINTF_CFG_SUPPORT_THOUSANDS */
+    prv_out_str_before(lwi, full_len);
+    for (size_t c = chunks_cnt, left = int_len; c > 0; --c) {
+        char str[9];
+        uint32_t v = chunks[c - 1];
+
+        for (size_t i = sizeof(str); i > 0; --i, v /= 10) {
+            str[i - 1] = (char)('0' + (char)(v % 10));
+        }
+        for (size_t i = c == chunks_cnt ? sizeof(str) - (left - 9 * (c - 1)) : 0; i < sizeof(str); ++i) {
+            lwi->out_fn(lwi, str[i]);
+            --left;
+#if LWPRINTF_CFG_SUPPORT_THOUSANDS
+            prv_out_thousands_sep(lwi, left);
+#endif /* LWPRINTF_CFG_SUPPORT_THOUSANDS */
+        }
+    }
+    if (prec > 0 || lwi->m.flags.alt) {
+        lwi->out_fn(lwi, '.');
+    }
+    if (calc_prec > 0) {
+        /* Second pass with rounding applied, carry turns trailing `9` digits to `0` */
+        prv_exact_set(words, frac_words, frac, frac_words * 32 - frac_bits);
+        for (size_t i = 0; i < calc_prec; ++i) {
+            digit = prv_exact_frac_digit(words, frac_words);
+            if (round_up && i + 1 >= carry_pos) {
+                digit = i + 1 == carry_pos ? digit + 1 : 0;
+            }
+            lwi->out_fn(lwi, (char)('0' + (char)digit));
+        }
+    }
+    prv_out_fill(lwi, '0', prec - calc_prec);
+    prv_out_str_after(lwi, full_len);
+    return 1;
+}
+
+#endif /* LWPRINTF_CFG_FLOAT_EXACT */
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_FLOAT && !LWPRINTF_CFG_FLOAT_SHORTEST
+
+/**
+ * \brief           Convert double number to string
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in]       num: Number to convert to string
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_double_to_str(lwprintf_int_t* lwi, float_type_t in_num) {
+    float_num_t dblnum;
+    float_type_t orig_num = in_num;
+    int digits_cnt, chosen_precision, i;
+#if LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING
+    int exp_cnt = 0;
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING */
+    char def_type = lwi->m.type;
+#if !LWPRINTF_CFG_REDUCED_STACK
+    char str[FLOAT_LONG_LONG ? 22 : 11];
+#endif /* !LWPRINTF_CFG_REDUCED_STACK */
+
+    /*
+     * Check for corner cases
+     *
+     * - Print "nan" if number is not valid
+     * - Print negative infinity if number is less than absolute minimum
+     * - Print negative infinity if number is less than -FLOAT_MAX_B_ENG and engineering mode is disabled
+     * - Print positive infinity if number is greater than absolute minimum
+     * - Print positive infinity if number is greater than FLOAT_MAX_B_ENG and engineering mode is disabled
+     * - Go to engineering mode if it is enabled and `in_num < -FLOAT_MAX_B_ENG` or `in_num > FLOAT_MAX_B_ENG`
+     */
+    if (in_num != in_num) {
+        return prv_out_str(lwi, lwi->m.flags.uc ? "NAN" : "nan", 3);
+#if LWPRINTF_CFG_FLOAT_EXACT
+    } else if (def_type == 'f' && in_num >= -FLOAT_TYPE_MAX && in_num <= FLOAT_TYPE_MAX
+               && ((lwi->m.flags.precision && lwi->m.precision > FLOAT_MAX_PRECISION)
+                   || in_num < -(float_type_t)FLOAT_MAX_B_ENG || in_num > (float_type_t)FLOAT_MAX_B_ENG)) {
+        return prv_double_to_str_exact(lwi, (double)in_num); /* Beyond limits of integer arithmetic */
+#endif /* LWPRINTF_CFG_FLOAT_EXACT */
+    } else if (in_num < -FLOAT_TYPE_MAX
+#if !LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING
+               || in_num < -(float_type_t)FLOAT_MAX_B_ENG
+#endif /* !LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING */
+    ) {
+        return prv_out_str(lwi, lwi->m.flags.uc ? "-INF" : "-inf", 4);
+    } else if (in_num > FLOAT_TYPE_MAX
+#if !LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING
+               || in_num > (float_type_t)FLOAT_MAX_B_ENG
+#endif /* !LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING */
+    ) {
+        /* Plus sign is skipped with offset, no copy of the text is needed */
+        return prv_out_str(lwi, &(lwi->m.flags.uc ? "+INF" : "+inf")[lwi->m.flags.plus ? 0 : 1],
+                           lwi->m.flags.plus ? 4 : 3);
+#if LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING
+    } else if ((in_num < -(float_type_t)FLOAT_MAX_B_ENG || in_num > (float_type_t)FLOAT_MAX_B_ENG)
+               && def_type != 'g') {
+        lwi->m.type = def_type = 'e'; /* Go to engineering mode */
+#endif                                /* LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING */
+    }
+
+    /* Check sign of the number, negative zero keeps its sign as with C library */
+    if (in_num < 0 || (in_num == 0 && (float_type_t)1 / in_num < 0)) {
+        lwi->m.flags.is_negative = 1;
+        in_num = -in_num;
+    }
+    orig_num = in_num;
+
+#if FLOAT_FIXED_FAST
+    /* Common `%.2f` of small value is printed as single scaled integer */
+    if (def_type == 'f' && lwi->m.flags.precision && lwi->m.precision <= FLOAT_MAX_PRECISION
+#if LWPRINTF_CFG_SUPPORT_THOUSANDS
+        && !lwi->m.flags.thousands
+#endif /* LWPRINTF_CFG_SUPPORT_THOUSANDS */
+        && in_num < (float_type_t)powers_of_10[FIXED_FAST_DIGITS - lwi->m.precision]) {
+        return prv_double_to_str_fixed_fast(lwi, in_num);
+    }
+#endif /* FLOAT_FIXED_FAST */
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING
+    /* Engineering mode check for number of exponents */
+    if (def_type == 'e' || def_type == 'g'
+        || in_num > (float_type_t)FLOAT_MAX_B_ENG) { /* More vs what float can hold */
+        if (lwi->m.type != 'g') {
+            lwi->m.type = 'e';
+        }
+
+        /* Normalize number to be between 1 and 10 and get decimal exponent */
+        exp_cnt = prv_double_normalize(&in_num);
+    }
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING */
+
+    /* Check precision data */
+    chosen_precision = lwi->m.precision; /* This is default value coming from app */
+    if (lwi->m.precision > FLOAT_MAX_PRECISION) {
+        lwi->m.precision = FLOAT_MAX_PRECISION; /* Limit to maximum precision */
+        /*
+         * Precision is lower than the one selected by app (or user).
+         * It means that we have to append ending zeros for precision when printing data
+         */
+    } else if (!lwi->m.flags.precision) {
+        lwi->m.precision = LWPRINTF_CFG_FLOAT_DEFAULT_PRECISION; /* Default precision when not used */
+        chosen_precision = lwi->m.precision;                     /* There was no precision, update chosen precision */
+    } else if (lwi->m.flags.precision && lwi->m.precision == 0) {
+#if LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING
+        /* Precision must be set to 1 if set to 0 by default */
+        if (def_type == 'g') {
+            lwi->m.precision = 1;
+        }
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING */
+    }
+
+    /* Check if type is g and decide if final output should be 'f' or 'e' */
+    /*
+     * For 'g/G' specifier
+     *
+     * A double argument representing a floating-point number is converted
+     * in style 'f' or 'e' (or in style 'F' or 'E' in the case of a 'G' conversion specifier),
+     * depending on the value converted and the precision.
+     * Let 'P' equal the precision if nonzero, '6' if the precision is omitted, or '1' if the precision is zero.
+     * Then, if a conversion with style 'E' would have an exponent of 'X':
+     *
+     * if 'P > X >= -4', the conversion is with style 'f' (or 'F') and precision 'P - (X + 1)'.
+     * otherwise, the conversion is with style 'e' (or 'E') and precision 'P - 1'.
+     *
+     * Finally, unless the '#' flag is used,
+     * any trailing zeros are removed from the fractional portion of the result
+     * and the decimal-point character is removed if there is no fractional portion remaining.
+     *
+     * A double argument representing an infinity or 'NaN' is converted in the style of an 'f' or 'F' conversion specifier.
+     */
+
+    /* Calculate data for number */
+    prv_calculate_dbl_num_data(lwi, &dblnum, def_type == 'e' ? in_num : orig_num, def_type);
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING
+    /* Rounding may carry to the next power of 10, such as `9.9996` to `10.000`, number is normalized again */
+    if (def_type == 'e' && dblnum.integer_part >= 10) {
+        in_num = 1;
+        ++exp_cnt;
+        prv_calculate_dbl_num_data(lwi, &dblnum, in_num, def_type);
+    }
+
+    /* Set type G */
+    if (def_type == 'g') {
+        /* Exponent of style 'e' is the one after rounding to 'P' significant digits */
+        --lwi->m.precision;
+        prv_calculate_dbl_num_data(lwi, &dblnum, in_num, def_type);
+        ++lwi->m.precision;
+        if (dblnum.integer_part >= 10) {
+            in_num = 1;
+            ++exp_cnt;
+        }
+
+        /* As per standard to decide level of precision */
+        if (exp_cnt >= -4 && exp_cnt < lwi->m.precision) {
+            lwi->m.precision -= exp_cnt + 1;
+            chosen_precision -= exp_cnt + 1;
+            lwi->m.type = 'f';
+            in_num = orig_num;
+        } else {
+            lwi->m.type = 'e';
+            if (lwi->m.precision > 0) {
+                --lwi->m.precision;
+                --chosen_precision;
+            }
+        }
+        prv_calculate_dbl_num_data(lwi, &dblnum, in_num, def_type);
+    }
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING */
+
+    /* Set number of digits to display */
+    digits_cnt = dblnum.digits_cnt_integer_part;
+    if (0) {
+#if LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING
+    } else if (def_type == 'g' && lwi->m.precision > 0) {
+        digits_cnt += dblnum.digits_cnt_decimal_part_useful;
+        if (dblnum.digits_cnt_decimal_part_useful > 0) {
+            ++digits_cnt;
+        }
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING */
+    } else {
+        if (chosen_precision > 0 && lwi->m.flags.precision) {
+            /* Add precision digits + dot separator */
+            digits_cnt += chosen_precision + 1;
+        }
+    }
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING
+    /* Increase number of digits to display */
+    if (lwi->m.type == 'e') {
+        /* Format is +Exxx, so add 4 or 5 characters (max is 307, min is 00 for exponent) */
+        digits_cnt += 4 + (exp_cnt >= 100 || exp_cnt <= -100);
+    }
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING */
+#if LWPRINTF_CFG_SUPPORT_THOUSANDS
+    if (lwi->m.flags.thousands) {
+        digits_cnt += THOUSANDS_SEP_CNT(dblnum.digits_cnt_integer_part);
+    }
+#endif /* LWPRINTF_CFG_SUPPORT_THOUSANDS */
+
+    /* Output strings */
+    prv_out_str_before(lwi, digits_cnt);
+
+    /* Output integer part of number */
+    if (dblnum.integer_part == 0) {
+        lwi->out_fn(lwi, '0');
+    } else {
+#if LWPRINTF_CFG_REDUCED_STACK
+        /* Digits are calculated with powers of 10 from the most significant one, no buffer is needed */
+        for (i = dblnum.digits_cnt_integer_part; i > 0; --i) {
+            lwi->out_fn(lwi, (char)'0' + (char)(dblnum.integer_part / powers_of_10[i - 1]));
+            dblnum.integer_part %= powers_of_10[i - 1];
+#if LWPRINTF_CFG_SUPPORT_THOUSANDS
+            prv_out_thousands_sep(lwi, (size_t)(i - 1));
+#endif /* LWPRINTF_CFG_SUPPORT_THOUSANDS */
+        }
+#else  /* LWPRINTF_CFG_REDUCED_STACK */
+        for (i = 0; dblnum.integer_part > 0; dblnum.integer_part /= 10, ++i) {
+            str[i] = (char)'0' + (char)(dblnum.integer_part % 10);
+        }
+        for (; i > 0; --i) {
+            lwi->out_fn(lwi, str[i - 1]);
+#if LWPRINTF_CFG_SUPPORT_THOUSANDS
+            prv_out_thousands_sep(lwi, (size_t)(i - 1));
+#endif /* LWPRINTF_CFG_SUPPORT_THOUSANDS */
+        }
+#endif /* !LWPRINTF_CFG_REDUCED_STACK */
+    }
+
+    /* Output decimal part */
+    if (lwi->m.precision > 0) {
+        int x;
+        if (dblnum.digits_cnt_decimal_part_useful > 0) {
+            lwi->out_fn(lwi, '.');
+        }
+#if LWPRINTF_CFG_REDUCED_STACK
+        {
+            float_long_t tmp;
+            for (i = 0, tmp = dblnum.decimal_part; tmp > 0; tmp /= 10, ++i) {}
+        }
+#else  /* LWPRINTF_CFG_REDUCED_STACK */
+        for (i = 0; dblnum.decimal_part > 0; dblnum.decimal_part /= 10, ++i) {
+            str[i] = (char)'0' + (char)(dblnum.decimal_part % 10);
+        }
+#endif /* !LWPRINTF_CFG_REDUCED_STACK */
+
+        /* Output relevant zeros first, string to print is opposite way */
+#if LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING
+        if (def_type == 'g') {
+            /* TODO: This is to be checked */
+            for (x = 0; x < (lwi->m.precision - i) && dblnum.digits_cnt_decimal_part_useful > 0;
+                 ++x, --dblnum.digits_cnt_decimal_part_useful) {
+                lwi->out_fn(lwi, '0');
+            }
+        } else
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING */
+        {
+            x = i;
+            if (x < lwi->m.precision) {
+                prv_out_fill(lwi, '0', (size_t)(lwi->m.precision - x));
+                x = lwi->m.precision;
+            }
+        }
+
+        /* Now print string itself */
+#if LWPRINTF_CFG_REDUCED_STACK
+        for (; i > 0; --i) {
+            lwi->out_fn(lwi, (char)'0' + (char)(dblnum.decimal_part / powers_of_10[i - 1]));
+            dblnum.decimal_part %= powers_of_10[i - 1];
+#if LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING
+            if (def_type == 'g' && --dblnum.digits_cnt_decimal_part_useful == 0) {
+                break;
+            }
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING */
+        }
+#else  /* LWPRINTF_CFG_REDUCED_STACK */
+        for (; i > 0; --i) {
+            lwi->out_fn(lwi, str[i - 1]);
+#if LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING
+            if (def_type == 'g' && --dblnum.digits_cnt_decimal_part_useful == 0) {
+                break;
+            }
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING */
+        }
+#endif /* !LWPRINTF_CFG_REDUCED_STACK */
+
+        /* Print ending zeros if selected precision is bigger than maximum supported */
+        if (def_type != 'g' && x < chosen_precision) {
+            prv_out_fill(lwi, '0', (size_t)(chosen_precision - x));
+        }
+    }
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING
+    /* Engineering mode output, add exponent part */
+    if (lwi->m.type == 'e') {
+        lwi->out_fn(lwi, lwi->m.flags.uc ? 'E' : 'e');
+        lwi->out_fn(lwi, exp_cnt >= 0 ? '+' : '-');
+        if (exp_cnt < 0) {
+            exp_cnt = -exp_cnt;
+        }
+        if (exp_cnt >= 100) {
+            lwi->out_fn(lwi, (char)'0' + (char)(exp_cnt / 100));
+            exp_cnt %= 100;
+        }
+        lwi->out_fn(lwi, (char)'0' + (char)(exp_cnt / 10));
+        lwi->out_fn(lwi, (char)'0' + (char)(exp_cnt % 10));
+    }
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING */
+    prv_out_str_after(lwi, digits_cnt);
+
+    return 1;
+}
+
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FLOAT && !LWPRINTF_CFG_FLOAT_SHORTEST */
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_FLOAT && LWPRINTF_CFG_FLOAT_SHORTEST
+
+/**
+ * \brief           Floating point number with 64-bit significand, value is `f * 2^e`
+ */
+typedef struct {
+    uint64_t f; /*!< Significand */
+    int e;      /*!< Binary exponent */
+} diy_fp_t;
+
+/**
+ * \brief           Cached power of 10, value is `f * 2^e` and approximates `10^k`
+ */
+typedef struct {
+    uint64_t f; /*!< Normalized significand */
+    int16_t e;  /*!< Binary exponent */
+    int16_t k;  /*!< Decimal exponent */
+} cached_pwr_t;
+
+/**
+ * \brief           Decimal representation of floating point number
+ *
+ * Value is `0.digits * 10^exp`, hence `exp` is position of the decimal point relative to first digit
+ */
+typedef struct {
+    char digits[20]; /*!< Significant digits, without leading and trailing zeros */
+    int len;         /*!< Number of significant digits. `0` when number is zero */
+    int exp;         /*!< Position of decimal point */
+    uint64_t m;      /*!< Binary significand of the original number */
+    int e2;          /*!< Binary exponent of the original number, original number is `m * 2^e2` */
+    int8_t dir;      /*!< Original number compared to digits: `1` if bigger, `-1` if smaller, `0` if too close */
+} float_dec_t;
+
+#define CACHED_PWR_MIN_DEC_EXP (-300) /*!< Decimal exponent of the first cached power */
+#define CACHED_PWR_DEC_STEP    8      /*!< Decimal exponent step between cached powers */
+#define DIY_FP_ALPHA           (-60)  /*!< Minimum binary exponent of number scaled with cached power */
+
+/* Normalized powers of 10, from 10^-300 to 10^324 with step of 8 */
+static const cached_pwr_t cached_pwrs[] = {
+    {0xAB70FE17C79AC6CAULL, -1060, -300},
+    {0xFF77B1FCBEBCDC4FULL, -1034, -292},
+    {0xBE5691EF416BD60CULL, -1007, -284},
+    {0x8DD01FAD907FFC3CULL,  -980, -276},
+    {0xD3515C2831559A83ULL,  -954, -268},
+    {0x9D71AC8FADA6C9B5ULL,  -927, -260},
+    {0xEA9C227723EE8BCBULL,  -901, -252},
+    {0xAECC49914078536DULL,  -874, -244},
+    {0x823C12795DB6CE57ULL,  -847, -236},
+    {0xC21094364DFB5637ULL,  -821, -228},
+    {0x9096EA6F3848984FULL,  -794, -220},
+    {0xD77485CB25823AC7ULL,  -768, -212},
+    {0xA086CFCD97BF97F4ULL,  -741, -204},
+    {0xEF340A98172AACE5ULL,  -715, -196},
+    {0xB23867FB2A35B28EULL,  -688, -188},
+    {0x84C8D4DFD2C63F3BULL,  -661, -180},
+    {0xC5DD44271AD3CDBAULL,  -635, -172},
+    {0x936B9FCEBB25C996ULL,  -608, -164},
+    {0xDBAC6C247D62A584ULL,  -582, -156},
+    {0xA3AB66580D5FDAF6ULL,  -555, -148},
+    {0xF3E2F893DEC3F126ULL,  -529, -140},
+    {0xB5B5ADA8AAFF80B8ULL,  -502, -132},
+    {0x87625F056C7C4A8BULL,  -475, -124},
+    {0xC9BCFF6034C13053ULL,  -449, -116},
+    {0x964E858C91BA2655ULL,  -422, -108},
+    {0xDFF9772470297EBDULL,  -396, -100},
+    {0xA6DFBD9FB8E5B88FULL,  -369,  -92},
+    {0xF8A95FCF88747D94ULL,  -343,  -84},
+    {0xB94470938FA89BCFULL,  -316,  -76},
+    {0x8A08F0F8BF0F156BULL,  -289,  -68},
+    {0xCDB02555653131B6ULL,  -263,  -60},
+    {0x993FE2C6D07B7FACULL,  -236,  -52},
+    {0xE45C10C42A2B3B06ULL,  -210,  -44},
+    {0xAA242499697392D3ULL,  -183,  -36},
+    {0xFD87B5F28300CA0EULL,  -157,  -28},
+    {0xBCE5086492111AEBULL,  -130,  -20},
+    {0x8CBCCC096F5088CCULL,  -103,  -12},
+    {0xD1B71758E219652CULL,   -77,   -4},
+    {0x9C40000000000000ULL,   -50,    4},
+    {0xE8D4A51000000000ULL,   -24,   12},
+    {0xAD78EBC5AC620000ULL,     3,   20},
+    {0x813F3978F8940984ULL,    30,   28},
+    {0xC097CE7BC90715B3ULL,    56,   36},
+    {0x8F7E32CE7BEA5C70ULL,    83,   44},
+    {0xD5D238A4ABE98068ULL,   109,   52},
+    {0x9F4F2726179A2245ULL,   136,   60},
+    {0xED63A231D4C4FB27ULL,   162,   68},
+    {0xB0DE65388CC8ADA8ULL,   189,   76},
+    {0x83C7088E1AAB65DBULL,   216,   84},
+    {0xC45D1DF942711D9AULL,   242,   92},
+    {0x924D692CA61BE758ULL,   269,  100},
+    {0xDA01EE641A708DEAULL,   295,  108},
+    {0xA26DA3999AEF774AULL,   322,  116},
+    {0xF209787BB47D6B85ULL,   348,  124},
+    {0xB454E4A179DD1877ULL,   375,  132},
+    {0x865B86925B9BC5C2ULL,   402,  140},
+    {0xC83553C5C8965D3DULL,   428,  148},
+    {0x952AB45CFA97A0B3ULL,   455,  156},
+    {0xDE469FBD99A05FE3ULL,   481,  164},
+    {0xA59BC234DB398C25ULL,   508,  172},
+    {0xF6C69A72A3989F5CULL,   534,  180},
+    {0xB7DCBF5354E9BECEULL,   561,  188},
+    {0x88FCF317F22241E2ULL,   588,  196},
+    {0xCC20CE9BD35C78A5ULL,   614,  204},
+    {0x98165AF37B2153DFULL,   641,  212},
+    {0xE2A0B5DC971F303AULL,   667,  220},
+    {0xA8D9D1535CE3B396ULL,   694,  228},
+    {0xFB9B7CD9A4A7443CULL,   720,  236},
+    {0xBB764C4CA7A44410ULL,   747,  244},
+    {0x8BAB8EEFB6409C1AULL,   774,  252},
+    {0xD01FEF10A657842CULL,   800,  260},
+    {0x9B10A4E5E9913129ULL,   827,  268},
+    {0xE7109BFBA19C0C9DULL,   853,  276},
+    {0xAC2820D9623BF429ULL,   880,  284},
+    {0x80444B5E7AA7CF85ULL,   907,  292},
+    {0xBF21E44003ACDD2DULL,   933,  300},
+    {0x8E679C2F5E44FF8FULL,   960,  308},
+    {0xD433179D9C8CB841ULL,   986,  316},
+    {0x9E19DB92B4E31BA9ULL,  1013,  324},
+};
+
+/**
+ * \brief           Multiply two numbers and round result to 64-bit significand
+ * \param[in]       x: First number
+ * \param[in]       y: Second number
+ * \return          Rounded product of numbers
+ */
+static diy_fp_t
+prv_diy_fp_mul(diy_fp_t x, diy_fp_t y) {
+    const uint64_t x_lo = x.f & 0xFFFFFFFFU, x_hi = x.f >> 32;
+    const uint64_t y_lo = y.f & 0xFFFFFFFFU, y_hi = y.f >> 32;
+    const uint64_t p0 = x_lo * y_lo, p1 = x_lo * y_hi, p2 = x_hi * y_lo, p3 = x_hi * y_hi;
+    const uint64_t mid = (p0 >> 32) + (p1 & 0xFFFFFFFFU) + (p2 & 0xFFFFFFFFU) + (1ULL << 31);
+    diy_fp_t r;
+
+    r.f = p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+    r.e = x.e + y.e + 64;
+    return r;
+}
+
+/**
+ * \brief           Normalize number so that the most significant bit of significand is set
+ * \param[in]       x: Number to normalize. Significand must not be `0`
+ * \return          Normalized number
+ */
+static diy_fp_t
+prv_diy_fp_normalize(diy_fp_t x) {
+    for (; (x.f >> 63) == 0; x.f <<= 1, --x.e) {}
+    return x;
+}
+
+/**
+ * \brief           Round last generated digit towards the original number (Grisu2)
+ * \param[in,out]   buff: Digits buffer
+ * \param[in]       len: Number of digits
+ * \param[in]       dist: Distance between upper boundary and the number
+ * \param[in]       delta: Distance between upper and lower boundary
+ * \param[in,out]   rest: Distance between upper boundary and generated digits
+ * \param[in]       ten_k: Value of last digit, scaled to the same exponent
+ */
+static void
+prv_shortest_round(char* buff, int len, uint64_t dist, uint64_t delta, uint64_t* rest, uint64_t ten_k) {
+    while (*rest < dist && delta - *rest >= ten_k
+           && (*rest + ten_k < dist || dist - *rest > *rest + ten_k - dist)) {
+        --buff[len - 1];
+        *rest += ten_k;
+    }
+}
+
+/**
+ * \brief           Calculate shortest decimal digits which round-trip to the original number.
+ *
+ * It implements Grisu2 algorithm with integer operations only.
+ * Result may not always be the shortest possible, but it is always the closest one to the original number.
+ *
+ * \param[out]      dec: Output decimal representation
+ * \param[in]       f: Binary significand of the number, must not be `0`
+ * \param[in]       e: Binary exponent of the number, value is `f * 2^e`
+ * \param[in]       lower_closer: Set to `1` if lower boundary is closer, when `f` is exact power of `2`
+ */
+static void
+prv_shortest_digits(float_dec_t* dec, uint64_t f, int e, uint8_t lower_closer) {
+    diy_fp_t w, w_plus, w_minus, c;
+    uint64_t delta, dist, rest, p2, one_f, tol = 2;
+    uint32_t p1, pwr10;
+    int k, idx, n, one_e, exp10;
+
+    dec->m = f;
+    dec->e2 = e;
+    dec->len = 0;
+
+    /* Boundaries are half way between the number and its neighbours */
+    w_plus.f = 2 * f + 1;
+    w_plus.e = e - 1;
+    w_plus = prv_diy_fp_normalize(w_plus);
+    w_minus.f = lower_closer ? (4 * f - 1) : (2 * f - 1);
+    w_minus.e = lower_closer ? (e - 2) : (e - 1);
+    w_minus.f <<= w_minus.e - w_plus.e;
+    w_minus.e = w_plus.e;
+    w.f = f;
+    w.e = e;
+    w = prv_diy_fp_normalize(w);
+
+    /* Find cached power, which moves binary exponent of the product to range [-60, -32] */
+    k = DIY_FP_ALPHA - w_plus.e - 1;
+    k = (k * 78913) / (1 << 18) + (k > 0);
+    idx = (-CACHED_PWR_MIN_DEC_EXP + k + (CACHED_PWR_DEC_STEP - 1)) / CACHED_PWR_DEC_STEP;
+    c.f = cached_pwrs[idx].f;
+    c.e = cached_pwrs[idx].e;
+    exp10 = -cached_pwrs[idx].k;
+
+    w = prv_diy_fp_mul(w, c);
+    w_plus = prv_diy_fp_mul(w_plus, c);
+    w_minus = prv_diy_fp_mul(w_minus, c);
+    ++w_minus.f; /* Make boundaries safe against multiplication error */
+    --w_plus.f;
+
+    delta = w_plus.f - w_minus.f;
+    dist = w_plus.f - w.f;
+    one_e = -w_plus.e;
+    one_f = 1ULL << one_e;
+    p1 = (uint32_t)(w_plus.f >> one_e);
+    p2 = w_plus.f & (one_f - 1);
+
+    /* Generate digits of the integer part */
+    for (n = 1, pwr10 = 1; n < 10 && p1 / pwr10 >= 10; ++n, pwr10 *= 10) {}
+    for (; n > 0; pwr10 /= 10) {
+        dec->digits[dec->len++] = (char)('0' + p1 / pwr10);
+        p1 %= pwr10;
+        --n;
+        rest = ((uint64_t)p1 << one_e) + p2;
+        if (rest <= delta) {
+            exp10 += n;
+            prv_shortest_round(dec->digits, dec->len, dist, delta, &rest, (uint64_t)pwr10 << one_e);
+            break;
+        }
+    }
+
+    /* Generate digits of the fractional part */
+    if (n == 0 && rest > delta) {
+        do {
+            p2 *= 10;
+            dec->digits[dec->len++] = (char)('0' + (p2 >> one_e));
+            p2 &= one_f - 1;
+            --exp10;
+            delta *= 10;
+            dist *= 10;
+            tol = tol > (UINT64_MAX / 10) ? UINT64_MAX : (tol * 10);
+        } while (p2 > delta);
+        rest = p2;
+        prv_shortest_round(dec->digits, dec->len, dist, delta, &rest, one_f);
+    }
+
+    /* Original number is "w = digits + rest - dist", sign is known only outside of calculation error */
+    if (rest > dist) {
+        dec->dir = (rest - dist) > tol ? 1 : 0;
+    } else {
+        dec->dir = (dist - rest) > tol ? -1 : 0;
+    }
+
+    /* Remove trailing zeros */
+    for (; dec->len > 1 && dec->digits[dec->len - 1] == '0'; --dec->len, ++exp10) {}
+    dec->exp = dec->len + exp10;
+}
+
+/**
+ * \brief           Check if decimal digits represent exactly the original binary number
+ * \param[in]       dec: Decimal representation
+ * \return          `1` if equal, `0` otherwise
+ */
+static uint8_t
+prv_shortest_is_exact(const float_dec_t* dec) {
+    uint64_t d = 0, m = dec->m;
+    int k = dec->exp - dec->len, e2 = dec->e2, d_tz = 0;
+
+    for (int i = 0; i < dec->len; ++i) {
+        d = d * 10 + (uint64_t)(dec->digits[i] - '0');
+    }
+
+    /* Compare odd parts and powers of 2 of "m * 2^e2" and "d * 10^k" */
+    for (; (m & 1) == 0; m >>= 1, ++e2) {}
+    for (; (d & 1) == 0; d >>= 1, ++d_tz) {}
+    if (k >= 0) {
+        for (int i = 0; i < k; ++i) {
+            if (d > UINT64_MAX / 5) {
+                return 0;
+            }
+            d *= 5;
+        }
+        return m == d && e2 == k + d_tz;
+    }
+    for (int i = 0; i < -k; ++i) {
+        if (m > UINT64_MAX / 5) {
+            return 0;
+        }
+        m *= 5;
+    }
+    return m == d && e2 - k == d_tz;
+}
+
+/**
+ * \brief           Round decimal representation to selected number of significant digits
+ *
+ * Exact ties are rounded to even digit, as the standard library does in default rounding mode
+ *
+ * \param[in,out]   dec: Decimal representation
+ * \param[in]       n: Number of significant digits to keep. Can be negative
+ */
+static void
+prv_shortest_round_digits(float_dec_t* dec, int n) {
+    uint8_t up;
+
+    if (n >= dec->len) {
+        return;
+    } else if (n < 0) {
+        dec->len = 0; /* Number is lower than half of the least significant digit */
+        return;
+    }
+
+    if (dec->digits[n] != '5') {
+        up = dec->digits[n] > '5';
+    } else if (n + 1 < dec->len || dec->dir > 0) {
+        up = 1; /* Number is above half of the least significant digit */
+    } else if (dec->dir < 0) {
+        up = 0;
+    } else if (prv_shortest_is_exact(dec)) {
+        up = n > 0 && ((dec->digits[n - 1] - '0') & 0x01); /* Exact tie, round to even */
+    } else {
+        up = 1;
+    }
+
+    dec->len = n;
+    if (up) {
+        for (; n > 0 && dec->digits[n - 1] == '9'; --n) {}
+        if (n == 0) {
+            dec->digits[0] = '1';
+            dec->len = 1;
+            ++dec->exp;
+        } else {
+            ++dec->digits[n - 1];
+            dec->len = n;
+        }
+    } else {
+        for (; dec->len > 0 && dec->digits[dec->len - 1] == '0'; --dec->len) {}
+    }
+}
+
+/**
+ * \brief           Output decimal representation of floating point number
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in]       dec: Decimal representation, already rounded to required precision
+ * \param[in]       style: Output style, `f` for fixed-point or `e` for exponential notation
+ * \param[in]       precision: Number of digits after decimal point
+ * \param[in]       strip_zeros: Set to `1` to remove trailing zeros after decimal point
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_shortest_out(lwprintf_int_t* lwi, const float_dec_t* dec, char style, int precision, uint8_t strip_zeros) {
+    int int_len, frac_len, frac_pos, lead_cnt, digits_cnt, full_len, exp_val = 0;
+    size_t exp_len = 0;
+    char exp_str[8];
+
+    if (style == 'e') {
+        exp_val = dec->len > 0 ? (dec->exp - 1) : 0;
+        int_len = 1;
+        frac_pos = 1;
+    } else {
+        int_len = (dec->len > 0 && dec->exp > 0) ? dec->exp : 1;
+        frac_pos = dec->exp;
+    }
+
+    /* Count fractional digits, optionally without trailing zeros */
+    frac_len = precision;
+    if (strip_zeros) {
+        frac_len = dec->len - frac_pos;
+        frac_len = frac_len < 0 ? 0 : (frac_len > precision ? precision : frac_len);
+    }
+
+    /* Prepare exponent part */
+    if (style == 'e') {
+        exp_str[exp_len++] = lwi->m.flags.uc ? 'E' : 'e';
+        exp_str[exp_len++] = exp_val < 0 ? '-' : '+';
+        exp_val = exp_val < 0 ? -exp_val : exp_val;
+        if (exp_val >= 100) {
+            exp_str[exp_len++] = (char)('0' + exp_val / 100);
+        }
+        exp_str[exp_len++] = (char)('0' + (exp_val / 10) % 10);
+        exp_str[exp_len++] = (char)('0' + exp_val % 10);
+    }
+    full_len = int_len + frac_len + (int)exp_len + ((frac_len > 0 || lwi->m.flags.alt) ? 1 : 0);
+#if LWPRINTF_CFG_SUPPORT_THOUSANDS
+    if (lwi->m.flags.thousands) {
+        full_len += THOUSANDS_SEP_CNT(int_len);
+    }
+#endif /* LWPRINTF_CFG_SUPPORT_THOUSANDS */
+
+    prv_out_str_before(lwi, (size_t)full_len);
+
+    /* Integer part */
+    if (dec->len == 0 || (style == 'f' && dec->exp <= 0)) {
+        lwi->out_fn(lwi, '0');
+    } else {
+        digits_cnt = style == 'e' ? 1 : (dec->len < dec->exp ? dec->len : dec->exp);
+#if LWPRINTF_CFG_SUPPORT_THOUSANDS
+        if (lwi->m.flags.thousands) {
+            /* Significant digits are followed by zeros, separator is placed by position in integer part */
+            for (int i = 0; i < int_len; ++i) {
+                lwi->out_fn(lwi, i < digits_cnt ? dec->digits[i] : '0');
+                prv_out_thousands_sep(lwi, (size_t)(int_len - i - 1));
+            }
+        } else
+#endif /* LWPRINTF_CFG_SUPPORT_THOUSANDS */
+        {
+            prv_out_str_raw(lwi, dec->digits, (size_t)digits_cnt);
+            prv_out_fill(lwi, '0', (size_t)(int_len - digits_cnt));
+        }
+    }
+
+    /* Fractional part, zeros before first digit, digits and zeros after last digit */
+    if (frac_len > 0 || lwi->m.flags.alt) {
+        lwi->out_fn(lwi, '.');
+    }
+    lead_cnt = frac_pos < 0 ? (-frac_pos < frac_len ? -frac_pos : frac_len) : 0;
+    prv_out_fill(lwi, '0', (size_t)lead_cnt);
+    digits_cnt = dec->len - (frac_pos > 0 ? frac_pos : 0);
+    digits_cnt = digits_cnt < 0 ? 0 : (digits_cnt > frac_len - lead_cnt ? frac_len - lead_cnt : digits_cnt);
+    prv_out_str_raw(lwi, &dec->digits[frac_pos > 0 ? frac_pos : 0], (size_t)digits_cnt);
+    prv_out_fill(lwi, '0', (size_t)(frac_len - lead_cnt - digits_cnt));
+
+    prv_out_str_raw(lwi, exp_str, exp_len);
+    prv_out_str_after(lwi, (size_t)full_len);
+    return 1;
+}
+
+/**
+ * \brief           Convert double number to string with shortest round-trip digits.
+ *
+ * Function uses integer operations only and runs in bounded time for any input number
+ *
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in]       in_num: Number to convert to string
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_double_to_str_shortest(lwprintf_int_t* lwi, double in_num) {
+    float_dec_t dec;
+    uint64_t bits, f;
+    int exp_biased, precision;
+    char style = lwi->m.type;
+
+    memcpy(&bits, &in_num, sizeof(bits));
+    lwi->m.flags.is_negative = (uint8_t)(bits >> 63);
+    exp_biased = (int)((bits >> 52) & 0x7FF);
+    f = bits & ((1ULL << 52) - 1);
+
+    /* Infinity and not-a-number are never padded with zeros */
+    if (exp_biased == 0x7FF) {
+        lwi->m.flags.zero = 0;
+        if (f != 0) {
+            return prv_out_str(lwi, lwi->m.flags.uc ? "NAN" : "nan", 3);
+        }
+        return prv_out_str(lwi, lwi->m.flags.uc ? "INF" : "inf", 3);
+    }
+
+    if (exp_biased == 0 && f == 0) {
+        dec.len = 0;
+        dec.exp = 1;
+    } else if (exp_biased == 0) {
+        prv_shortest_digits(&dec, f, 1 - 1075, 0); /* Subnormal number */
+    } else {
+        prv_shortest_digits(&dec, f | (1ULL << 52), exp_biased - 1075, f == 0 && exp_biased > 1);
+    }
+
+    precision = lwi->m.flags.precision ? lwi->m.precision : LWPRINTF_CFG_FLOAT_DEFAULT_PRECISION;
+#if LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING
+    if (style == 'g') {
+        int x;
+
+        /* Decide between 'f' and 'e' style, based on exponent after rounding */
+        precision = precision == 0 ? 1 : precision;
+        prv_shortest_round_digits(&dec, precision);
+        x = dec.len > 0 ? (dec.exp - 1) : 0;
+        if (precision > x && x >= -4) {
+            return prv_shortest_out(lwi, &dec, 'f', precision - 1 - x, !lwi->m.flags.alt);
+        }
+        return prv_shortest_out(lwi, &dec, 'e', precision - 1, !lwi->m.flags.alt);
+    } else if (style == 'e') {
+        prv_shortest_round_digits(&dec, precision + 1);
+        return prv_shortest_out(lwi, &dec, 'e', precision, 0);
+    }
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING */
+    LWPRINTF_UNUSED(style);
+#if LWPRINTF_CFG_FLOAT_EXACT
+    /* Shortest digits are not the exact value, more digits than their length are taken from binary value */
+    if (dec.len > 0 && dec.exp + precision > dec.len && !prv_shortest_is_exact(&dec)) {
+        return prv_double_to_str_exact(lwi, in_num);
+    }
+#endif /* LWPRINTF_CFG_FLOAT_EXACT */
+    if (dec.len > 0) {
+        prv_shortest_round_digits(&dec, dec.exp + precision);
+    }
+    return prv_shortest_out(lwi, &dec, 'f', precision, 0);
+}
+
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FLOAT && LWPRINTF_CFG_FLOAT_SHORTEST */
+
+/**
+ * \brief           Parse single format specifier, without reading any arguments
+ *
+ * Specifier has the form of `%[flags][width][.precision][length]type`
+ *
+ * \param[out]      m: Specifier structure to fill
+ * \param[in]       fmt: Format string, pointing to the first character after `%`
+ * \param[out]      star: Combination of `SPEC_STAR_*` values for width and precision taken from argument list
+ * \return          Pointer to the type character of the specifier
+ */
+static const char*
+prv_parse_spec(format_spec_t* m, const char* fmt, uint8_t* star) {
+    uint8_t detected = 0;
+
+    memset(m, 0x00, sizeof(*m)); /* Reset structure */
+    *star = 0;
+
+    /* Parse format */
+    /* %[flags][width][.precision][length]type */
+    /* Go to https://docs.majerle.eu for more info about supported features */
+
+    /* Check [flags] */
+    /* It can have multiple flags in any order */
+    detected = 1;
+    do {
+        switch (*fmt) {
+            case '-': m->flags.left_align = 1; break;
+            case '+': m->flags.plus = 1; break;
+            case ' ': m->flags.space = 1; break;
+            case '0': m->flags.zero = 1; break;
+            case '\'': m->flags.thousands = 1; break;
+            case '#': m->flags.alt = 1; break;
+#if LWPRINTF_CFG_SUPPORT_TYPE_ARRAY
+            case 'v': m->flags.array = 1; break;
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ARRAY */
+            default: detected = 0; break;
+        }
+        if (detected) {
+            ++fmt;
+        }
+    } while (detected);
+
+    /* Check [width] */
+    m->width = 0;
+    if (CHARISNUM(*fmt)) { /* Fixed width check */
+        /* If number is negative, it has been captured from previous step (left align) */
+        m->width = prv_parse_num(&fmt); /* Number from string directly */
+    } else if (*fmt == '*') {           /* Or variable check */
+        *star |= SPEC_STAR_WIDTH;       /* Read from argument list before the value */
+        ++fmt;
+    }
+
+    /* Check [.precision] */
+    m->precision = 0;
+    if (*fmt == '.') { /* Precision flag is detected */
+        m->flags.precision = 1;
+        if (*++fmt == '*') { /* Variable check */
+            *star |= SPEC_STAR_PRECISION;
+            ++fmt;
+        } else if (CHARISNUM(*fmt)) { /* Directly in the string */
+            m->precision = prv_parse_num(&fmt);
+        }
+    }
+
+    /* Check [length] */
+    detected = 1;
+    switch (*fmt) {
+        case 'h':
+            m->flags.char_short = 1; /* Single h detected */
+            if (*++fmt == 'h') {     /* Does it follow by another h? */
+                m->flags.char_short = 2; /* Second h detected */
+                ++fmt;
+            }
+            break;
+        case 'l':
+            m->flags.longlong = 1; /* Single l detected */
+            if (*++fmt == 'l') {   /* Does it follow by another l? */
+                m->flags.longlong = 2; /* Second l detected */
+                ++fmt;
+            }
+            break;
+        case 'L': break;
+        case 'z':
+            m->flags.sz_t = 1; /* Size T flag */
+            ++fmt;
+            break;
+        case 'j':
+            m->flags.umax_t = 1; /* uintmax_t flag */
+            ++fmt;
+            break;
+        case 't': break;
+        default: detected = 0;
+    }
+
+    /* Check type */
+    m->type = *fmt + (char)((*fmt >= 'A' && *fmt <= 'Z') ? 0x20 : 0x00);
+    if (*fmt >= 'A' && *fmt <= 'Z') {
+        m->flags.uc = 1;
+    }
+#if LWPRINTF_CFG_SUPPORT_TYPE_FIXED
+    /* Number of fractional bits follows fixed-point type */
+    if (*fmt == 'q') {
+        const char* bits = fmt + 1;
+        const int num = prv_parse_num(&bits);
+
+        m->qbits = (uint8_t)(num > 255 ? 255 : num);
+    }
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FIXED */
+    return fmt;
+}
+
+/**
+ * \brief           Get next character after the type character of specifier
+ * \param[in]       fmt: Pointer to the type character of the specifier
+ * \return          Pointer to the next character
+ */
+static const char*
+prv_spec_next(const char* fmt) {
+#if LWPRINTF_CFG_SUPPORT_TYPE_FIXED
+    if (*fmt == 'q') {
+        for (++fmt; CHARISNUM(*fmt); ++fmt) {}
+        return fmt;
+    }
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FIXED */
+    return fmt + 1;
+}
+
+#if LWPRINTF_CFG_OS
+
+/**
+ * \brief           Acquire mutex of the instance, and update statistics when enabled
+ * \param[in,out]   obj: LwPRINTF instance
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+prv_mutex_wait(lwprintf_t* obj) {
+#if LWPRINTF_CFG_OS_STATS
+    uint32_t start, now;
+    uint8_t busy;
+
+    if (!lwprintf_sys_mutex_isvalid(&obj->mutex)) {
+        return 0;
+    }
+    busy = obj->stats_depth > 0; /* Held by other thread, or recursive acquisition */
+    start = obj->stats_time_fn != NULL ? obj->stats_time_fn() : 0;
+    LWPRINTF_CFG_TRACE_MUTEX_WAIT(obj);
+    if (!lwprintf_sys_mutex_wait(&obj->mutex)) {
+        LWPRINTF_CFG_TRACE_MUTEX_ACQUIRED(obj, 0);
+        return 0;
+    }
+    LWPRINTF_CFG_TRACE_MUTEX_ACQUIRED(obj, 1);
+    if (obj->stats_depth++ == 0) {
+        now = obj->stats_time_fn != NULL ? obj->stats_time_fn() : 0;
+        ++obj->stats.acquisitions;
+        if (busy) {
+            ++obj->stats.contended;
+        }
+        obj->stats.wait_total += now - start;
+        if (now - start > obj->stats.wait_max) {
+            obj->stats.wait_max = now - start;
+        }
+        obj->stats_hold_start = now;
+    }
+    return 1;
+#else
+    uint8_t res;
+
+    if (!lwprintf_sys_mutex_isvalid(&obj->mutex)) {
+        return 0;
+    }
+    LWPRINTF_CFG_TRACE_MUTEX_WAIT(obj);
+    res = lwprintf_sys_mutex_wait(&obj->mutex);
+    LWPRINTF_CFG_TRACE_MUTEX_ACQUIRED(obj, res);
+    return res;
+#endif /* LWPRINTF_CFG_OS_STATS */
+}
+
+/**
+ * \brief           Release mutex of the instance, and update statistics when enabled
+ * \param[in,out]   obj: LwPRINTF instance
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+prv_mutex_release(lwprintf_t* obj) {
+#if LWPRINTF_CFG_OS_STATS
+    if (obj->stats_depth > 0 && --obj->stats_depth == 0) {
+        uint32_t hold = (obj->stats_time_fn != NULL ? obj->stats_time_fn() : 0) - obj->stats_hold_start;
+
+        obj->stats.hold_total += hold;
+        if (hold > obj->stats.hold_max) {
+            obj->stats.hold_max = hold;
+        }
+    }
+#endif /* LWPRINTF_CFG_OS_STATS */
+    LWPRINTF_CFG_TRACE_MUTEX_RELEASE(obj);
+    return lwprintf_sys_mutex_release(&obj->mutex);
+}
+
+#if LWPRINTF_CFG_ENABLE_TRY_PRINT || LWPRINTF_CFG_ENABLE_AUTO_FLUSH || LWPRINTF_CFG_ENABLE_LOW_POWER
+
+/**
+ * \brief           Try to acquire mutex of the instance without waiting, and update statistics when enabled
+ * \param[in,out]   obj: LwPRINTF instance
+ * \return          `1` when mutex has been acquired, `0` otherwise
+ */
+static uint8_t
+prv_mutex_trywait(lwprintf_t* obj) {
+    uint8_t res;
+
+    if (!lwprintf_sys_mutex_isvalid(&obj->mutex)) {
+        return 0;
+    }
+    LWPRINTF_CFG_TRACE_MUTEX_WAIT(obj);
+    res = lwprintf_sys_mutex_trywait(&obj->mutex);
+    LWPRINTF_CFG_TRACE_MUTEX_ACQUIRED(obj, res);
+    if (!res) {
+        return 0;
+    }
+#if LWPRINTF_CFG_OS_STATS
+    if (obj->stats_depth++ == 0) {
+        ++obj->stats.acquisitions;
+        obj->stats_hold_start = obj->stats_time_fn != NULL ? obj->stats_time_fn() : 0;
+    }
+#endif /* LWPRINTF_CFG_OS_STATS */
+    return 1;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_TRY_PRINT || LWPRINTF_CFG_ENABLE_AUTO_FLUSH || LWPRINTF_CFG_ENABLE_LOW_POWER */
+
+#endif /* LWPRINTF_CFG_OS */
+
+/**
+ * \brief           Converter of single specifier type, reads its argument and outputs it
+ * \param[in,out]   lwi: LwPRINTF internal instance, with parsed specifier
+ * \param[in,out]   arg: Pointer to variable parameters list
+ * \param[in]       spec: Specifier character
+ */
+typedef void (*prv_conv_fn)(lwprintf_int_t* lwi, va_list* arg, char spec);
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_FLOAT_HEX
+
+/* Number of hexadecimal digits of `double` mantissa, after the leading digit */
+#define FLOAT_HEX_DIGITS 13
+
+/**
+ * \brief           Convert double in hexadecimal notation, `%a` and `%A`.
+ *
+ * Output is `[-]0xh.hhhp[+-]d`, created from binary representation with integer operations only.
+ * Leading digit is `1` for normal numbers and `0` for subnormal numbers and zero.
+ * Without precision, all digits are printed, except trailing zeros.
+ * With lower precision, number is rounded to nearest, ties to even
+ *
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in,out]   arg: Pointer to variable parameters list
+ * \param[in]       spec: Specifier character
+ */
+static void
+prv_conv_hex_double(lwprintf_int_t* lwi, va_list* arg, char spec) {
+    const double num = PRV_VA_ARG(lwi, *arg, double);
+    const char* digits = lwi->m.flags.uc ? "0123456789ABCDEF" : "0123456789abcdef";
+    uint64_t bits, mant;
+    int exp, prec, kept, full_len;
+    char exp_str[6];
+    size_t exp_len = 0;
+    uint8_t point;
+
+    LWPRINTF_UNUSED(spec);
+    memcpy(&bits, &num, sizeof(bits));
+    lwi->m.flags.is_negative = (bits >> 63) != 0;
+    exp = (int)((bits >> 52) & 0x7FF);
+    mant = bits & (((uint64_t)1 << 52) - 1);
+
+    /* Infinity and NaN are never padded with zeros */
+    if (exp == 0x7FF) {
+        lwi->m.flags.zero = 0;
+        if (mant != 0) {
+            lwi->m.flags.is_negative = 0;
+            prv_out_str(lwi, lwi->m.flags.uc ? "NAN" : "nan", 3);
+        } else {
+            prv_out_str(lwi, lwi->m.flags.uc ? "INF" : "inf", 3);
+        }
+        return;
+    }
+
+    /* Leading digit is part of the mantissa from here, to carry rounding to it */
+    if (exp == 0) {
+        exp = mant != 0 ? -1022 : 0;
+    } else {
+        mant |= (uint64_t)1 << 52;
+        exp -= 1023;
+    }
+
+    /* Default precision is the shortest exact one */
+    if (lwi->m.flags.precision) {
+        prec = lwi->m.precision;
+    } else {
+        for (prec = FLOAT_HEX_DIGITS; prec > 0 && ((mant >> ((FLOAT_HEX_DIGITS - prec) * 4)) & 0x0F) == 0; --prec) {}
+    }
+    kept = prec < FLOAT_HEX_DIGITS ? prec : FLOAT_HEX_DIGITS;
+    if (kept < FLOAT_HEX_DIGITS) {
+        const unsigned shift = (unsigned)(FLOAT_HEX_DIGITS - kept) * 4;
+        const uint64_t rem = mant & (((uint64_t)1 << shift) - 1);
+        const uint64_t half = (uint64_t)1 << (shift - 1);
+
+        mant >>= shift;
+        if (rem > half || (rem == half && (mant & 0x01))) {
+            ++mant; /* Carry may increase leading digit to `2` */
+        }
+    }
+
+    /* Exponent is decimal number of power of 2 */
+    exp_str[exp_len++] = lwi->m.flags.uc ? 'P' : 'p';
+    exp_str[exp_len++] = exp < 0 ? '-' : '+';
+    exp = exp < 0 ? -exp : exp;
+    for (int div = 1000; div > 1; div /= 10) {
+        if (exp >= div || exp_len > 2) {
+            exp_str[exp_len++] = (char)('0' + (exp / div) % 10);
+        }
+    }
+    exp_str[exp_len++] = (char)('0' + exp % 10);
+
+    /* Prefix is placed between sign and zeros with alternate hexadecimal mode */
+    point = prec > 0 || lwi->m.flags.alt;
+    full_len = 1 + (int)point + prec + (int)exp_len;
+    lwi->m.base = 16;
+    lwi->m.flags.alt = 1;
+    lwi->m.flags.is_num_zero = 0;
+    prv_out_str_before(lwi, (size_t)full_len);
+    lwi->out_fn(lwi, digits[(size_t)(mant >> (kept * 4))]);
+    if (point) {
+        lwi->out_fn(lwi, '.');
+    }
+    for (int i = kept - 1; i >= 0; --i) {
+        lwi->out_fn(lwi, digits[(size_t)((mant >> (i * 4)) & 0x0F)]);
+    }
+    prv_out_fill(lwi, '0', (size_t)(prec - kept));
+    prv_out_str_raw(lwi, exp_str, exp_len);
+    prv_out_str_after(lwi, (size_t)full_len);
+}
+
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FLOAT_HEX */
+
+/**
+ * \brief           Convert character, `%c`
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in,out]   arg: Pointer to variable parameters list
+ * \param[in]       spec: Specifier character
+ */
+static void
+prv_conv_char(lwprintf_int_t* lwi, va_list* arg, char spec) {
+    LWPRINTF_UNUSED(spec);
+    lwi->out_fn(lwi, (char)PRV_VA_ARG(lwi, *arg, int));
+}
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_INT
+
+/**
+ * \brief           Convert signed integer, `%d` and `%i`
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in,out]   arg: Pointer to variable parameters list
+ * \param[in]       spec: Specifier character
+ */
+static void
+prv_conv_signed(lwprintf_int_t* lwi, va_list* arg, char spec) {
+    LWPRINTF_UNUSED(spec);
+
+    /* Check for different length parameters */
+    lwi->m.base = 10;
+    if (lwi->m.flags.longlong == 0) {
+        signed int v = PRV_VA_ARG(lwi, *arg, signed int);
+        switch (lwi->m.flags.char_short) {
+            case 2: v = (signed int)((signed char)v); break;
+            case 1: v = (signed int)((short int)v); break;
+            default: break;
+        }
+        prv_signed_int_to_str(lwi, v);
+    } else if (lwi->m.flags.longlong == 1) {
+#if LONG_MAX == INT_MAX
+        prv_signed_int_to_str(lwi, (signed int)PRV_VA_ARG(lwi, *arg, signed long int));
+#else
+        prv_longest_signed_int_to_str(lwi, (int_maxtype_t)PRV_VA_ARG(lwi, *arg, signed long int));
+#endif /* LONG_MAX == INT_MAX */
+#if LWPRINTF_CFG_SUPPORT_LONG_LONG
+    } else if (lwi->m.flags.longlong == 2) {
+        prv_longest_signed_int_to_str(lwi, (int_maxtype_t)PRV_VA_ARG(lwi, *arg, signed long long int));
+#endif /* LWPRINTF_CFG_SUPPORT_LONG_LONG */
+    }
+}
+
+/**
+ * \brief           Set number base for unsigned integer specifier
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in]       spec: Specifier character
+ */
+static void
+prv_unsigned_base_set(lwprintf_int_t* lwi, char spec) {
+    if (spec == 'b' || spec == 'B') {
+        lwi->m.base = 2;
+    } else if (spec == 'o') {
+        lwi->m.base = 8;
+    } else if (spec == 'u') {
+        lwi->m.base = 10;
+    } else {
+        lwi->m.base = 16;
+    }
+    lwi->m.flags.space = 0; /* Space flag has no meaning here */
+}
+
+/**
+ * \brief           Convert unsigned integer, `%b`, `%B`, `%o`, `%u`, `%x` and `%X`
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in,out]   arg: Pointer to variable parameters list
+ * \param[in]       spec: Specifier character
+ */
+static void
+prv_conv_unsigned(lwprintf_int_t* lwi, va_list* arg, char spec) {
+    prv_unsigned_base_set(lwi, spec);
+
+    /* Check for different length parameters */
+    if (lwi->m.flags.sz_t) {
+#if SIZE_MAX == UINT_MAX
+        prv_unsigned_int_to_str(lwi, (unsigned int)PRV_VA_ARG(lwi, *arg, size_t));
+#else
+        prv_longest_unsigned_int_to_str(lwi, (uint_maxtype_t)PRV_VA_ARG(lwi, *arg, size_t));
+#endif /* SIZE_MAX == UINT_MAX */
+    } else if (lwi->m.flags.umax_t) {
+        prv_longest_unsigned_int_to_str(lwi, (uint_maxtype_t)PRV_VA_ARG(lwi, *arg, uintmax_t));
+    } else if (lwi->m.flags.longlong == 0 || lwi->m.base == 2) {
+        unsigned int v = PRV_VA_ARG(lwi, *arg, unsigned int);
+        switch (lwi->m.flags.char_short) {
+            case 2: v = (unsigned int)((unsigned char)v); break;
+            case 1: v = (unsigned int)((unsigned short int)v); break;
+            default: break;
+        }
+        prv_unsigned_int_to_str(lwi, v);
+    } else if (lwi->m.flags.longlong == 1) {
+#if ULONG_MAX == UINT_MAX
+        prv_unsigned_int_to_str(lwi, (unsigned int)PRV_VA_ARG(lwi, *arg, unsigned long int));
+#else
+        prv_longest_unsigned_int_to_str(lwi, (uint_maxtype_t)PRV_VA_ARG(lwi, *arg, unsigned long int));
+#endif /* ULONG_MAX == UINT_MAX */
+#if LWPRINTF_CFG_SUPPORT_LONG_LONG
+    } else if (lwi->m.flags.longlong == 2) {
+        prv_longest_unsigned_int_to_str(lwi, (uint_maxtype_t)PRV_VA_ARG(lwi, *arg, unsigned long long int));
+#endif /* LWPRINTF_CFG_SUPPORT_LONG_LONG */
+    }
+}
+
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_INT */
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_STRING
+
+/**
+ * \brief           Convert string, `%s`
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in,out]   arg: Pointer to variable parameters list
+ * \param[in]       spec: Specifier character
+ */
+static void
+prv_conv_string(lwprintf_int_t* lwi, va_list* arg, char spec) {
+    const char* b = PRV_VA_ARG(lwi, *arg, const char*);
+
+    LWPRINTF_UNUSED(spec);
+    if (b == NULL) {
+        b = "(null)";
+    }
+
+    /* Output string up to maximum buffer. If user provides lower buffer size, write will not write to it
+        but it will still calculate "would be" length */
+    prv_out_str(lwi, b, prv_strnlen(b, lwi->m.flags.precision ? (size_t)lwi->m.precision : (SIZE_MAX)));
+}
+
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_STRING */
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_STRING_ESCAPE
+
+/* Length of escaped string chunk, prepared on stack before it is written to the output */
+#if LWPRINTF_CFG_REDUCED_STACK
+#define STRING_ESCAPE_CHUNK_LEN 16
+#else
+#define STRING_ESCAPE_CHUNK_LEN 64
+#endif /* LWPRINTF_CFG_REDUCED_STACK */
+
+/* Longest escape sequence of single character, `\u001F` in JSON */
+#define STRING_ESCAPE_MAX_LEN 6
+
+/**
+ * \brief           Escape single character for JSON or C string
+ * \param[out]      out: Output buffer, with at least \ref STRING_ESCAPE_MAX_LEN characters
+ * \param[in]       c: Character to escape
+ * \param[in]       is_json: Set to `1` for JSON escape, `0` for C escape
+ * \return          Number of characters written to the buffer
+ */
+static size_t
+prv_escape_char(char* out, unsigned char c, uint8_t is_json) {
+    if (c == '"' || c == '\\') {
+        out[0] = '\\';
+        out[1] = (char)c;
+        return 2;
+    }
+    /* Short sequences of control characters from `\a` to `\r`, JSON does not have `\a` and `\v` */
+    if (c >= 0x07 && c <= 0x0D && (!is_json || (c != 0x07 && c != 0x0B))) {
+        out[0] = '\\';
+        out[1] = "abtnvfr"[c - 0x07];
+        return 2;
+    }
+    if (c < 0x20 || (!is_json && c >= 0x7F)) {
+        out[0] = '\\';
+        if (is_json) {
+            out[1] = 'u';
+            out[2] = '0';
+            out[3] = '0';
+            out[4] = "0123456789abcdef"[c >> 4];
+            out[5] = "0123456789abcdef"[c & 0x0F];
+            return 6;
+        }
+
+        /* Octal sequence has fixed length, it cannot absorb digits that follow, as `\x` does */
+        out[1] = (char)('0' + (c >> 6));
+        out[2] = (char)('0' + ((c >> 3) & 0x07));
+        out[3] = (char)('0' + (c & 0x07));
+        return 4;
+    }
+    out[0] = (char)c;
+    return 1;
+}
+
+/**
+ * \brief           Convert string with escaped characters, `%J` for JSON and `%C` for C string
+ *
+ * Characters are escaped to the chunk on stack, that is written to the output at once.
+ * *Precision* field limits number of input characters, while *width* field applies to the escaped length
+ *
+ * char str[] = "a\"b\n";
+ * "%J" would produce a\"b\n
+ *
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in,out]   arg: Pointer to variable parameters list
+ * \param[in]       spec: Specifier character
+ */
+static void
+prv_conv_string_escape(lwprintf_int_t* lwi, va_list* arg, char spec) {
+    const char* b = PRV_VA_ARG(lwi, *arg, const char*);
+    const uint8_t is_json = spec == 'J';
+    size_t in_len, out_len = 0;
+    char chunk[STRING_ESCAPE_CHUNK_LEN];
+
+    if (b == NULL) {
+        b = "(null)";
+    }
+    in_len = prv_strnlen(b, lwi->m.flags.precision ? (size_t)lwi->m.precision : (SIZE_MAX));
+
+    /* Escaped length is only needed for width, or to be counted in measure mode */
+    if (lwi->m.width > 0 || IS_MEASURE_MODE(lwi)) {
+        for (size_t i = 0; i < in_len; ++i) {
+            out_len += prv_escape_char(chunk, (unsigned char)b[i], is_json);
+        }
+    }
+    prv_out_str_before(lwi, out_len);
+    if (IS_MEASURE_MODE(lwi)) {
+        prv_out_fill(lwi, ' ', out_len); /* Characters are not generated, only counted */
+    } else {
+        size_t chunk_len = 0;
+
+        for (size_t i = 0; i < in_len; ++i) {
+            if (chunk_len > sizeof(chunk) - STRING_ESCAPE_MAX_LEN) {
+                prv_out_str_raw(lwi, chunk, chunk_len);
+                chunk_len = 0;
+            }
+            chunk_len += prv_escape_char(&chunk[chunk_len], (unsigned char)b[i], is_json);
+        }
+        prv_out_str_raw(lwi, chunk, chunk_len);
+    }
+    prv_out_str_after(lwi, out_len);
+}
+
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_STRING_ESCAPE */
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_POINTER
+
+/**
+ * \brief           Convert pointer, `%p`
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in,out]   arg: Pointer to variable parameters list
+ * \param[in]       spec: Specifier character
+ */
+static void
+prv_conv_pointer(lwprintf_int_t* lwi, va_list* arg, char spec) {
+    LWPRINTF_UNUSED(spec);
+    lwi->m.base = 16;                     /* Go to hex format */
+    lwi->m.flags.uc = 0;                  /* Uppercase characters */
+    lwi->m.flags.zero = 1;                /* Zero padding */
+    lwi->m.width = sizeof(uintptr_t) * 2; /* Number is in hex format and byte is represented with 2 letters */
+
+#if UINTPTR_MAX == UINT_MAX
+    prv_unsigned_int_to_str(lwi, (unsigned int)PRV_VA_ARG(lwi, *arg, uintptr_t));
+#else
+    prv_longest_unsigned_int_to_str(lwi, (uint_maxtype_t)PRV_VA_ARG(lwi, *arg, uintptr_t));
+#endif /* UINTPTR_MAX == UINT_MAX */
+}
+
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_POINTER */
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_FLOAT
+
+/**
+ * \brief           Convert double number, `%f`, `%F` and engineering `%e`, `%E`, `%g`, `%G`.
+ * Final output depends on type of format
+ *
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in,out]   arg: Pointer to variable parameters list
+ * \param[in]       spec: Specifier character
+ */
+static void
+prv_conv_double(lwprintf_int_t* lwi, va_list* arg, char spec) {
+    LWPRINTF_UNUSED(spec);
+#if LWPRINTF_CFG_FLOAT_SHORTEST
+    prv_double_to_str_shortest(lwi, PRV_VA_ARG_FLOAT(lwi, *arg));
+#else
+    prv_double_to_str(lwi, PRV_VA_ARG_FLOAT(lwi, *arg)); /* Converted only once */
+#endif /* LWPRINTF_CFG_FLOAT_SHORTEST */
+}
+
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FLOAT */
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_ARRAY
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_INT
+
+/**
+ * \brief           Convert integer element of an array, type is selected by length modifier
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in]       ptr: Pointer to the first element
+ * \param[in]       idx: Element index
+ * \param[in]       spec: Specifier character
+ */
+static void
+prv_array_int_elem(lwprintf_int_t* lwi, const void* ptr, size_t idx, char spec) {
+    if (spec == 'd' || spec == 'i') {
+        int_maxtype_t v;
+
+        lwi->m.base = 10;
+        if (lwi->m.flags.sz_t) {
+            v = (int_maxtype_t)((const ptrdiff_t*)ptr)[idx];
+        } else if (lwi->m.flags.umax_t) {
+            v = (int_maxtype_t)((const intmax_t*)ptr)[idx];
+        } else if (lwi->m.flags.char_short == 2) {
+            v = ((const signed char*)ptr)[idx];
+        } else if (lwi->m.flags.char_short == 1) {
+            v = ((const short int*)ptr)[idx];
+        } else if (lwi->m.flags.longlong == 1) {
+            v = ((const long int*)ptr)[idx];
+#if LWPRINTF_CFG_SUPPORT_LONG_LONG
+        } else if (lwi->m.flags.longlong == 2) {
+            v = (int_maxtype_t)((const long long int*)ptr)[idx];
+#endif /* LWPRINTF_CFG_SUPPORT_LONG_LONG */
+        } else {
+            v = ((const int*)ptr)[idx];
+        }
+        prv_longest_signed_int_to_str(lwi, v);
+    } else {
+        uint_maxtype_t v;
+
+        prv_unsigned_base_set(lwi, spec);
+        if (lwi->m.flags.sz_t) {
+            v = ((const size_t*)ptr)[idx];
+        } else if (lwi->m.flags.umax_t) {
+            v = (uint_maxtype_t)((const uintmax_t*)ptr)[idx];
+        } else if (lwi->m.flags.char_short == 2) {
+            v = ((const unsigned char*)ptr)[idx];
+        } else if (lwi->m.flags.char_short == 1) {
+            v = ((const unsigned short int*)ptr)[idx];
+        } else if (lwi->m.flags.longlong == 1) {
+            v = ((const unsigned long int*)ptr)[idx];
+#if LWPRINTF_CFG_SUPPORT_LONG_LONG
+        } else if (lwi->m.flags.longlong == 2) {
+            v = (uint_maxtype_t)((const unsigned long long int*)ptr)[idx];
+#endif /* LWPRINTF_CFG_SUPPORT_LONG_LONG */
+        } else {
+            v = ((const unsigned int*)ptr)[idx];
+        }
+        prv_longest_unsigned_int_to_str(lwi, v);
+    }
+}
+
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_INT */
+
+/**
+ * \brief           Convert array of numbers with `v` flag, such as `%vd` or `%v.2f`.
+ *
+ * Arguments are number of elements as `int` and pointer to the first element.
+ * Element type is selected by length modifier, `%vhd` prints `short` array and `%vf` prints `float` array,
+ * while `%vlf` prints `double` array. Width, precision and flags are applied to every element,
+ * and elements are separated with separator of the instance.
+ * Other types only skip the arguments and print specifier character
+ *
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in,out]   arg: Pointer to variable parameters list
+ * \param[in]       spec: Specifier character
+ */
+static void
+prv_conv_array(lwprintf_int_t* lwi, va_list* arg, char spec) {
+    int cnt = PRV_VA_ARG(lwi, *arg, int);
+    const void* ptr = PRV_VA_ARG(lwi, *arg, const void*);
+    const char* sep = lwi->lwobj->array_sep != NULL ? lwi->lwobj->array_sep : ", ";
+    const size_t sep_len = strlen(sep);
+    const format_spec_t m = lwi->m;
+
+    switch (spec) {
+#if LWPRINTF_CFG_SUPPORT_TYPE_INT
+        case 'd':
+        case 'i':
+        case 'b':
+        case 'B':
+        case 'o':
+        case 'u':
+        case 'x':
+        case 'X':
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_INT */
+#if LWPRINTF_CFG_SUPPORT_TYPE_FLOAT
+        case 'f':
+        case 'F':
+#if LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING */
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FLOAT */
+            break;
+        default: lwi->out_fn(lwi, spec); return;
+    }
+    if (ptr == NULL) {
+        return;
+    }
+#if LWPRINTF_CFG_WCET
+    if (cnt > LWPRINTF_CFG_WCET_MAX_ARRAY_LEN) {
+        cnt = LWPRINTF_CFG_WCET_MAX_ARRAY_LEN;
+    }
+#endif /* LWPRINTF_CFG_WCET */
+
+    /* Every element starts with the same parsed specifier */
+    for (int i = 0; i < cnt; ++i) {
+        if (i > 0) {
+            prv_out_str_raw(lwi, sep, sep_len);
+        }
+        lwi->m = m;
+#if LWPRINTF_CFG_SUPPORT_TYPE_FLOAT
+        if (m.type == 'f' || m.type == 'e' || m.type == 'g') {
+#if LWPRINTF_CFG_FLOAT_SHORTEST
+            prv_double_to_str_shortest(lwi, m.flags.longlong ? ((const double*)ptr)[i]
+                                                             : (double)((const float*)ptr)[i]);
+#else
+            prv_double_to_str(lwi, m.flags.longlong ? (float_type_t)((const double*)ptr)[i]
+                                                    : (float_type_t)((const float*)ptr)[i]);
+#endif /* LWPRINTF_CFG_FLOAT_SHORTEST */
+            continue;
+        }
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FLOAT */
+#if LWPRINTF_CFG_SUPPORT_TYPE_INT
+        prv_array_int_elem(lwi, ptr, (size_t)i, spec);
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_INT */
+    }
+}
+
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ARRAY */
+
+/**
+ * \brief           Write number of characters output so far, `%n`
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in,out]   arg: Pointer to variable parameters list
+ * \param[in]       spec: Specifier character
+ */
+static void
+prv_conv_length(lwprintf_int_t* lwi, va_list* arg, char spec) {
+    int* ptr = (void*)PRV_VA_ARG(lwi, *arg, int*);
+
+    LWPRINTF_UNUSED(spec);
+    *ptr = (int)lwi->n_len; /* Write current length */
+}
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_BYTE_ARRAY
+
+/* Number of bytes encoded on stack, before they are written to the output */
+#if LWPRINTF_CFG_REDUCED_STACK
+#define BYTE_ARRAY_CHUNK_BYTES 4
+#else
+#define BYTE_ARRAY_CHUNK_BYTES 16
+#endif /* LWPRINTF_CFG_REDUCED_STACK */
+
+/**
+ * \brief           Convert unsigned-char formatted pointer to hex string, `%k` and `%K`
+ *
+ * char arr[] = {0, 1, 2, 3, 255};
+ * "%5K" would produce 00010203FF
+ *
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in,out]   arg: Pointer to variable parameters list
+ * \param[in]       spec: Specifier character
+ */
+static void
+prv_conv_byte_array(lwprintf_int_t* lwi, va_list* arg, char spec) {
+    unsigned char* ptr =
+        (void*)PRV_VA_ARG(lwi, *arg, unsigned char*); /* Get input parameter as unsigned char pointer */
+    int len = lwi->m.width, full_width;
+    uint8_t is_space = lwi->m.flags.space == 1;
+
+    LWPRINTF_UNUSED(spec);
+    if (ptr == NULL || len == 0) {
+        return;
+    }
+
+    lwi->m.flags.zero = 1;  /* Prepend with zeros if necessary */
+    lwi->m.width = 0;       /* No width parameter */
+    lwi->m.base = 16;       /* Hex format */
+    lwi->m.flags.space = 0; /* Delete any flag for space */
+
+    /* Full width of digits to print */
+    full_width = len * (2 + (int)is_space);
+    if (is_space && full_width > 0) {
+        --full_width; /* Remove space after last number */
+    }
+
+    /* Output w/o hex prefix */
+    prv_out_str_before(lwi, full_width);
+    if (IS_MEASURE_MODE(lwi)) {
+        prv_out_fill(lwi, '0', (size_t)full_width); /* Characters are not generated, only counted */
+    } else {
+        const char* digits = lwi->m.flags.uc ? digits_hex_uc : digits_hex_lc;
+        char chunk[BYTE_ARRAY_CHUNK_BYTES * 3];
+        size_t chunk_len = 0;
+
+        /* Bytes are encoded with lookup table to the chunk, that is written to the output at once */
+        for (int i = 0; i < len; ++i, ++ptr) {
+            if (chunk_len > sizeof(chunk) - 3) {
+                prv_out_str_raw(lwi, chunk, chunk_len);
+                chunk_len = 0;
+            }
+            chunk[chunk_len++] = digits[*ptr >> 0x04];
+            chunk[chunk_len++] = digits[*ptr & 0x0F];
+            if (is_space && i < (len - 1)) {
+                chunk[chunk_len++] = ' '; /* Generate space between numbers */
+            }
+        }
+        prv_out_str_raw(lwi, chunk, chunk_len);
+    }
+    prv_out_str_after(lwi, full_width);
+}
+
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_BYTE_ARRAY */
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_BASE64
+
+/* Number of characters encoded on stack, before they are written to the output. Must be multiple of `4` */
+#if LWPRINTF_CFG_REDUCED_STACK
+#define BASE64_CHUNK_LEN 16
+#else
+#define BASE64_CHUNK_LEN 64
+#endif /* LWPRINTF_CFG_REDUCED_STACK */
+
+/* Base64 alphabet, without last 2 characters that differ between standard and URL-safe alphabet */
+static const char base64_table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+
+/**
+ * \brief           Convert unsigned-char formatted pointer to base64 string, `%r`
+ *
+ * Every `3` bytes are encoded to `4` characters and output is padded with `=` to multiple of `4` characters.
+ * Alternate mode `#` selects URL-safe alphabet.
+ *
+ * char arr[] = {0x4D, 0x61};
+ * "%2r" would produce TWE=
+ *
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in,out]   arg: Pointer to variable parameters list
+ * \param[in]       spec: Specifier character
+ */
+static void
+prv_conv_base64(lwprintf_int_t* lwi, va_list* arg, char spec) {
+    const unsigned char* ptr = (void*)PRV_VA_ARG(lwi, *arg, unsigned char*);
+    size_t len = (size_t)lwi->m.width, full_len;
+
+    LWPRINTF_UNUSED(spec);
+    if (ptr == NULL || len == 0) {
+        return;
+    }
+    full_len = (len + 2) / 3 * 4;
+    if (IS_MEASURE_MODE(lwi)) {
+        prv_out_fill(lwi, '=', full_len); /* Characters are not generated, only counted */
+    } else {
+        char chunk[BASE64_CHUNK_LEN];
+        size_t chunk_len = 0;
+        const char* table_end = lwi->m.flags.alt ? "-_" : "+/";
+
+        /* Groups of 3 bytes are encoded with lookup table to the chunk, that is written to the output at once */
+        for (; len > 0; ptr += 3, len = len > 3 ? len - 3 : 0) {
+            const uint32_t group = ((uint32_t)ptr[0] << 16) | (len > 1 ? (uint32_t)ptr[1] << 8 : 0)
+                                   | (len > 2 ? (uint32_t)ptr[2] : 0);
+            const uint8_t idx[4] = {(uint8_t)(group >> 18), (uint8_t)((group >> 12) & 0x3F),
+                                    (uint8_t)((group >> 6) & 0x3F), (uint8_t)(group & 0x3F)};
+
+            if (chunk_len == sizeof(chunk)) {
+                prv_out_str_raw(lwi, chunk, chunk_len);
+                chunk_len = 0;
+            }
+            for (size_t i = 0; i < 4; ++i) {
+                chunk[chunk_len++] = i > len ? '=' : (idx[i] < 62 ? base64_table[idx[i]] : table_end[idx[i] - 62]);
+            }
+        }
+        prv_out_str_raw(lwi, chunk, chunk_len);
+    }
+}
+
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_BASE64 */
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_HEXDUMP
+
+/* Maximum number of bytes per line, line is prepared on stack */
+#if LWPRINTF_CFG_REDUCED_STACK
+#define HEXDUMP_MAX_PER_LINE 16
+#else
+#define HEXDUMP_MAX_PER_LINE 32
+#endif /* LWPRINTF_CFG_REDUCED_STACK */
+
+/* Length of full line with `n` bytes: offset, 2 spaces, bytes with space, space and gutter in `|` with newline */
+#define HEXDUMP_LINE_LEN(n) (8 + 2 + 3 * (n) + 2 + (n) + 2)
+
+/**
+ * \brief           Convert unsigned-char formatted pointer to multi-line hexdump, `%H`
+ *
+ * Every line has offset from the beginning, hex bytes and printable characters in the gutter.
+ * *Width* field specifies length of input array and *precision* field number of bytes per line, default is `16`
+ *
+ * char arr[] = "Hi!";
+ * "%3.3H" would produce "00000000  48 69 21  |Hi!|\n"
+ *
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in,out]   arg: Pointer to variable parameters list
+ * \param[in]       spec: Specifier character
+ */
+static void
+prv_conv_hexdump(lwprintf_int_t* lwi, va_list* arg, char spec) {
+    const unsigned char* ptr = (void*)PRV_VA_ARG(lwi, *arg, unsigned char*);
+    const char* digits = "0123456789abcdef";
+    size_t len = (size_t)lwi->m.width, per_line;
+
+    LWPRINTF_UNUSED(spec);
+    if (ptr == NULL || len == 0) {
+        return;
+    }
+    per_line = lwi->m.flags.precision && lwi->m.precision > 0 ? (size_t)lwi->m.precision : 16;
+    per_line = per_line > HEXDUMP_MAX_PER_LINE ? HEXDUMP_MAX_PER_LINE : per_line;
+    if (IS_MEASURE_MODE(lwi)) {
+        /* Characters are not generated, only counted. Gutter of the last line may be shorter */
+        prv_out_fill(lwi, ' ', (len + per_line - 1) / per_line * (HEXDUMP_LINE_LEN(per_line) - per_line) + len);
+        return;
+    }
+
+    /* Every line is written to the output at once */
+    for (size_t offset = 0; offset < len; offset += per_line, ptr += per_line) {
+        char line[HEXDUMP_LINE_LEN(HEXDUMP_MAX_PER_LINE)];
+        const size_t cnt = len - offset < per_line ? len - offset : per_line;
+        size_t pos = 0;
+
+        for (int shift = 28; shift >= 0; shift -= 4) {
+            line[pos++] = digits[((uint32_t)offset >> shift) & 0x0F];
+        }
+        line[pos++] = ' ';
+        line[pos++] = ' ';
+        for (size_t i = 0; i < per_line; ++i) {
+            line[pos++] = i < cnt ? digits[ptr[i] >> 0x04] : ' ';
+            line[pos++] = i < cnt ? digits[ptr[i] & 0x0F] : ' ';
+            line[pos++] = ' ';
+        }
+        line[pos++] = ' ';
+        line[pos++] = '|';
+        for (size_t i = 0; i < cnt; ++i) {
+            line[pos++] = ptr[i] >= 0x20 && ptr[i] < 0x7F ? (char)ptr[i] : '.';
+        }
+        line[pos++] = '|';
+        line[pos++] = '\n';
+        prv_out_str_raw(lwi, line, pos);
+    }
+}
+
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_HEXDUMP */
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_FIXED
+
+/**
+ * \brief           Convert fixed-point number, `%q`
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in,out]   arg: Pointer to variable parameters list
+ * \param[in]       spec: Specifier character
+ */
+static void
+prv_conv_fixed(lwprintf_int_t* lwi, va_list* arg, char spec) {
+    LWPRINTF_UNUSED(spec);
+    if (lwi->m.flags.longlong == 0) {
+        prv_fixed_to_str(lwi, (int_maxtype_t)PRV_VA_ARG(lwi, *arg, signed int));
+    } else if (lwi->m.flags.longlong == 1) {
+        prv_fixed_to_str(lwi, (int_maxtype_t)PRV_VA_ARG(lwi, *arg, signed long int));
+#if LWPRINTF_CFG_SUPPORT_LONG_LONG
+    } else if (lwi->m.flags.longlong == 2) {
+        prv_fixed_to_str(lwi, (int_maxtype_t)PRV_VA_ARG(lwi, *arg, signed long long int));
+#endif /* LWPRINTF_CFG_SUPPORT_LONG_LONG */
+    }
+}
+
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FIXED */
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_SI
+
+/**
+ * \brief           Convert number to SI prefix notation, `%y` for `double` and `%Y` for integer
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in,out]   arg: Pointer to variable parameters list
+ * \param[in]       spec: Specifier character
+ */
+static void
+prv_conv_si(lwprintf_int_t* lwi, va_list* arg, char spec) {
+#if SI_FLOAT
+    if (spec == 'y') {
+        prv_si_double_to_str(lwi, PRV_VA_ARG_FLOAT(lwi, *arg));
+        return;
+    }
+#endif /* SI_FLOAT */
+    LWPRINTF_UNUSED(spec);
+    if (lwi->m.flags.longlong == 0) {
+        prv_si_int_to_str(lwi, (int_maxtype_t)PRV_VA_ARG(lwi, *arg, signed int));
+    } else if (lwi->m.flags.longlong == 1) {
+        prv_si_int_to_str(lwi, (int_maxtype_t)PRV_VA_ARG(lwi, *arg, signed long int));
+#if LWPRINTF_CFG_SUPPORT_LONG_LONG
+    } else if (lwi->m.flags.longlong == 2) {
+        prv_si_int_to_str(lwi, (int_maxtype_t)PRV_VA_ARG(lwi, *arg, signed long long int));
+#endif /* LWPRINTF_CFG_SUPPORT_LONG_LONG */
+    }
+}
+
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_SI */
+
+/* Range of specifier characters in converter table */
+#define CONV_FIRST 'A'
+#define CONV_LAST  'z'
+
+/**
+ * \brief           Converters indexed by specifier character.
+ * Disabled types have no entry, their converters are not linked and characters are printed as they are
+ */
+static const prv_conv_fn conv_table[CONV_LAST - CONV_FIRST + 1] = {
+#if LWPRINTF_CFG_SUPPORT_TYPE_FLOAT_HEX
+    ['a' - CONV_FIRST] = prv_conv_hex_double,
+    ['A' - CONV_FIRST] = prv_conv_hex_double,
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FLOAT_HEX */
+    ['c' - CONV_FIRST] = prv_conv_char,
+#if LWPRINTF_CFG_SUPPORT_TYPE_INT
+    ['d' - CONV_FIRST] = prv_conv_signed,
+    ['i' - CONV_FIRST] = prv_conv_signed,
+    ['b' - CONV_FIRST] = prv_conv_unsigned,
+    ['B' - CONV_FIRST] = prv_conv_unsigned,
+    ['o' - CONV_FIRST] = prv_conv_unsigned,
+    ['u' - CONV_FIRST] = prv_conv_unsigned,
+    ['x' - CONV_FIRST] = prv_conv_unsigned,
+    ['X' - CONV_FIRST] = prv_conv_unsigned,
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_INT */
+#if LWPRINTF_CFG_SUPPORT_TYPE_STRING
+    ['s' - CONV_FIRST] = prv_conv_string,
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_STRING */
+#if LWPRINTF_CFG_SUPPORT_TYPE_STRING_ESCAPE
+    ['J' - CONV_FIRST] = prv_conv_string_escape,
+    ['C' - CONV_FIRST] = prv_conv_string_escape,
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_STRING_ESCAPE */
+#if LWPRINTF_CFG_SUPPORT_TYPE_POINTER
+    ['p' - CONV_FIRST] = prv_conv_pointer,
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_POINTER */
+#if LWPRINTF_CFG_SUPPORT_TYPE_FLOAT
+    ['f' - CONV_FIRST] = prv_conv_double,
+    ['F' - CONV_FIRST] = prv_conv_double,
+#if LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING
+    ['e' - CONV_FIRST] = prv_conv_double,
+    ['E' - CONV_FIRST] = prv_conv_double,
+    ['g' - CONV_FIRST] = prv_conv_double,
+    ['G' - CONV_FIRST] = prv_conv_double,
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING */
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FLOAT */
+    ['n' - CONV_FIRST] = prv_conv_length,
+#if LWPRINTF_CFG_SUPPORT_TYPE_BYTE_ARRAY
+    ['k' - CONV_FIRST] = prv_conv_byte_array,
+    ['K' - CONV_FIRST] = prv_conv_byte_array,
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_BYTE_ARRAY */
+#if LWPRINTF_CFG_SUPPORT_TYPE_BASE64
+    ['r' - CONV_FIRST] = prv_conv_base64,
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_BASE64 */
+#if LWPRINTF_CFG_SUPPORT_TYPE_HEXDUMP
+    ['H' - CONV_FIRST] = prv_conv_hexdump,
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_HEXDUMP */
+#if LWPRINTF_CFG_SUPPORT_TYPE_FIXED
+    ['q' - CONV_FIRST] = prv_conv_fixed,
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FIXED */
+#if SI_FLOAT
+    ['y' - CONV_FIRST] = prv_conv_si,
+#endif /* SI_FLOAT */
+#if LWPRINTF_CFG_SUPPORT_TYPE_SI
+    ['Y' - CONV_FIRST] = prv_conv_si,
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_SI */
+};
+
+#if LWPRINTF_CFG_ENABLE_CUSTOM_SPEC
+
+/**
+ * \brief           Get handler of registered custom specifier
+ * \param[in]       lwi: LwPRINTF internal instance
+ * \param[in]       spec: Specifier character
+ * \return          Handler function, `NULL` if specifier is not registered
+ */
+static lwprintf_spec_fn
+prv_custom_spec_get(lwprintf_int_t* lwi, char spec) {
+#if PACKED_ARGS
+    if (lwi->dargs != NULL) {
+        return NULL; /* Arguments of custom specifiers are not captured to deferred messages */
+    }
+#endif /* PACKED_ARGS */
+    for (size_t i = 0; i < lwi->lwobj->specs_cnt; ++i) {
+        if (lwi->lwobj->specs[i].spec == spec) {
+            return lwi->lwobj->specs[i].fn;
+        }
+    }
+    return NULL;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_CUSTOM_SPEC */
+
+#if LWPRINTF_CFG_ENABLE_RESUMABLE
+
+/**
+ * \brief           Save resumable formatting state at start of format part
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in]       fmt: Start of the part in format string
+ * \param[in]       ap: Pointer to variable parameters list, before arguments of the part
+ */
+static void
+prv_resume_mark(lwprintf_int_t* lwi, const char* fmt, va_list* ap) {
+    lwprintf_resume_t* rs = lwi->rs;
+
+    rs->fmt = fmt;
+    rs->part_pos = lwi->n_len;
+    va_end(rs->arg);
+    va_copy(rs->arg, *ap);
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_RESUMABLE */
+
+#if LWPRINTF_CFG_WCET
+
+/**
+ * \brief           Limit width, precision and string length of the conversion to bounded execution time
+ * \param[in,out]   m: Format specification of the conversion
+ * \param[in]       spec: Specifier character
+ */
+static void
+prv_wcet_limit(format_spec_t* m, char spec) {
+    if (m->width > LWPRINTF_CFG_WCET_MAX_WIDTH) {
+        m->width = LWPRINTF_CFG_WCET_MAX_WIDTH;
+    }
+    if (spec == 's' || spec == 'J' || spec == 'C') {
+        /* Precision is maximum string length, string is limited also when precision is not set */
+        if (!m->flags.precision || m->precision > LWPRINTF_CFG_WCET_MAX_STRING_LEN) {
+            m->flags.precision = 1;
+            m->precision = LWPRINTF_CFG_WCET_MAX_STRING_LEN;
+        }
+    } else if (m->precision > LWPRINTF_CFG_WCET_MAX_PRECISION) {
+        m->precision = LWPRINTF_CFG_WCET_MAX_PRECISION;
+    }
+}
+
+#endif /* LWPRINTF_CFG_WCET */
+
+/**
+ * \brief           Process format string of internal instance, without protection and final `NULL` character.
+ * It is also used for nested formatting of custom specifiers
+ *
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in,out]   ap: Pointer to variable parameters list
+ */
+static void
+prv_format_run(lwprintf_int_t* lwi, va_list* ap) {
+    const char* fmt = lwi->fmt;
+    uint8_t star;
+#if LWPRINTF_CFG_ENABLE_COMPILED_FORMAT
+    size_t op_idx = 0;
+#endif /* LWPRINTF_CFG_ENABLE_COMPILED_FORMAT */
+#if LWPRINTF_CFG_ENABLE_CUSTOM_SPEC
+    lwprintf_spec_fn custom_fn;
+#endif /* LWPRINTF_CFG_ENABLE_CUSTOM_SPEC */
+    prv_conv_fn conv_fn;
+
+    while (!lwi->is_print_cancelled) {
+#if LWPRINTF_CFG_ENABLE_COMPILED_FORMAT
+        if (lwi->ops != NULL) {
+            const compiled_op_t* op;
+
+            /* Literal segments are output at once, specifiers are already parsed */
+            if (op_idx >= lwi->ops_cnt) {
+                break;
+            }
+            op = &lwi->ops[op_idx++];
+            if (op->len > 0) {
+                prv_out_str_ref(lwi, op->str, op->len);
+                continue;
+            }
+            lwi->m = op->m;
+            star = op->star;
+            fmt = op->str;
+        } else
+#endif /* LWPRINTF_CFG_ENABLE_COMPILED_FORMAT */
+        {
+            if (fmt == NULL || *fmt == '\0') {
+                break;
+            }
+#if LWPRINTF_CFG_ENABLE_RESUMABLE
+            /* Part may be cut at the end of the chunk, next call formats it again from this state */
+            if (lwi->rs != NULL) {
+                prv_resume_mark(lwi, fmt, ap);
+            }
+#endif /* LWPRINTF_CFG_ENABLE_RESUMABLE */
+
+            /* Detect beginning and output all characters up to next specifier at once */
+            if (*fmt != '%') {
+                const char* fmt_start = fmt;
+
+                for (; *fmt != '\0' && *fmt != '%'; ++fmt) {}
+                prv_out_str_ref(lwi, fmt_start, (size_t)(fmt - fmt_start));
+                continue;
+            }
+            fmt = prv_parse_spec(&lwi->m, fmt + 1, &star);
+        }
+
+        /* Width and precision arguments come before the value */
+        if (star & SPEC_STAR_WIDTH) {
+            const int w = (int)PRV_VA_ARG(lwi, *ap, int);
+            if (w < 0) {
+                lwi->m.flags.left_align = 1; /* Negative width means left aligned */
+                lwi->m.width = -w;
+            } else {
+                lwi->m.width = w;
+            }
+        }
+        if (star & SPEC_STAR_PRECISION) {
+            const int pr = (int)PRV_VA_ARG(lwi, *ap, int);
+            lwi->m.precision = pr > 0 ? pr : 0;
+        }
+        if (*fmt == '\0') {
+            break; /* Format string ended inside of specifier */
+        }
+#if LWPRINTF_CFG_WCET
+        prv_wcet_limit(&lwi->m, *fmt);
+#endif /* LWPRINTF_CFG_WCET */
+
+        conv_fn = NULL;
+#if LWPRINTF_CFG_SUPPORT_TYPE_ARRAY
+        /* Array flag selects array converter for every type, called the same way as table converters */
+        if (lwi->m.flags.array) {
+            conv_fn = prv_conv_array;
+        }
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ARRAY */
+#if LWPRINTF_CFG_ENABLE_CUSTOM_SPEC
+        /* Registered specifiers take precedence over built-in converters */
+        if (conv_fn == NULL && (custom_fn = prv_custom_spec_get(lwi, *fmt)) != NULL) {
+            LWPRINTF_CFG_TRACE_CONV_START(lwi->lwobj, *fmt);
+            custom_fn((lwprintf_spec_ctx_t*)lwi, *fmt, ap);
+            LWPRINTF_CFG_TRACE_CONV_END(lwi->lwobj, *fmt);
+            fmt = prv_spec_next(fmt);
+            continue;
+        }
+#endif /* LWPRINTF_CFG_ENABLE_CUSTOM_SPEC */
+
+        /* One indexed load selects converter, characters without converter are printed as they are */
+        if (conv_fn == NULL && *fmt >= CONV_FIRST && *fmt <= CONV_LAST) {
+            conv_fn = conv_table[*fmt - CONV_FIRST];
+        }
+        if (conv_fn != NULL) {
+            LWPRINTF_CFG_TRACE_CONV_START(lwi->lwobj, *fmt);
+            conv_fn(lwi, ap, *fmt);
+            LWPRINTF_CFG_TRACE_CONV_END(lwi->lwobj, *fmt);
+        } else {
+            lwi->out_fn(lwi, *fmt);
+        }
+        fmt = prv_spec_next(fmt);
+    }
+}
+
+#if LWPRINTF_CFG_STATS
+
+/**
+ * \brief           Count finished formatting call to statistics of the instance.
+ * Length measurement and internal formatting are not counted
+ *
+ * \param[in]       lwi: LwPRINTF internal instance
+ * \param[in]       is_cancelled: Set to `1` when formatting was cancelled
+ */
+static void
+prv_stats_format(lwprintf_int_t* lwi, uint8_t is_cancelled) {
+    lwprintf_stats_t* stats = &lwi->lwobj->stats;
+    size_t len = lwi->n_len;
+    uint8_t is_cut = is_cancelled; /* Buffers other than output cancel when they run out of memory */
+
+    if (lwi->is_stats_off || IS_MEASURE_MODE(lwi)) {
+        return;
+    }
+#if LWPRINTF_CFG_ENABLE_PACKED_ARGS
+    if (lwi->is_shared) {
+        return;
+    }
+#endif /* LWPRINTF_CFG_ENABLE_PACKED_ARGS */
+    ++stats->calls;
+    if (IS_PRINT_MODE(lwi)) {
+        if (is_cancelled) {
+            ++stats->cancelled;
+        }
+        is_cut = 0;
+    } else if (lwi->out_fn == prv_out_fn_write_buff && len > lwi->buff_max_len) {
+        len = lwi->buff_max_len;
+        is_cut = 1;
+    }
+#if LWPRINTF_CFG_ENABLE_STRBUF
+    if (lwi->sb != NULL && lwi->sb->is_full) {
+        is_cut = 1;
+    }
+#endif /* LWPRINTF_CFG_ENABLE_STRBUF */
+    stats->bytes += len;
+    if (is_cut) {
+        ++stats->truncated;
+    }
+}
+
+#endif /* LWPRINTF_CFG_STATS */
+
+/**
+ * \brief           Output final `NULL` character of formatting, and count the call to statistics
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ */
+static void
+prv_format_end(lwprintf_int_t* lwi) {
+#if LWPRINTF_CFG_STATS
+    uint8_t is_cancelled = lwi->is_print_cancelled;
+
+    lwi->out_fn(lwi, '\0');
+#if LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT
+    /* Character output may return `0` for `NULL` character, only block output sends staged text with it */
+    if (lwi->lwobj->out_block_fn != NULL) {
+        is_cancelled = lwi->is_print_cancelled;
+    }
+#endif /* LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT */
+    prv_stats_format(lwi, is_cancelled);
+#else
+    lwi->out_fn(lwi, '\0');
+#endif /* LWPRINTF_CFG_STATS */
+}
+
+#if LWPRINTF_CFG_FORMAT_CACHE_SIZE > 0
+
+/**
+ * \brief           Take parsed segments of format string from the cache of the instance
+ *
+ * Format string, that is not in the cache yet, is parsed once and replaces previous entry on its position.
+ * With OS protection, cache is used only for print operation, while mutex is held
+ *
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ */
+static void
+prv_fcache_get(lwprintf_int_t* lwi) {
+    lwprintf_t* lwobj = lwi->lwobj;
+    uintptr_t key = (uintptr_t)lwi->fmt;
+    size_t idx;
+
+    if (lwi->ops != NULL || lwi->fmt == NULL) {
+        return;
+    }
+#if LWPRINTF_CFG_ENABLE_PACKED_ARGS
+    if (lwi->is_shared) {
+        return;
+    }
+#endif /* LWPRINTF_CFG_ENABLE_PACKED_ARGS */
+#if LWPRINTF_CFG_OS && !LWPRINTF_CFG_OS_MANUAL_PROTECT
+    if (!IS_PRINT_MODE(lwi)) {
+        return;
+    }
+#endif /* LWPRINTF_CFG_OS && !LWPRINTF_CFG_OS_MANUAL_PROTECT */
+
+    /* Literals are placed next to each other, low bits are mixed with higher ones */
+    idx = (size_t)((key ^ (key >> 5)) % LWPRINTF_CFG_FORMAT_CACHE_SIZE);
+    if (lwobj->fcache_fmt[idx] != lwi->fmt) {
+        lwprintf_compiled_t cformat;
+
+        /* Format with too many segments is remembered as well, so that it is not compiled on every call */
+        lwprintf_compile(lwi->fmt, &cformat, lwobj->fcache_ops[idx], sizeof(lwobj->fcache_ops[idx]));
+        lwobj->fcache_cnt[idx] = cformat.ops != NULL ? cformat.ops_cnt : 0;
+        lwobj->fcache_fmt[idx] = lwi->fmt;
+    }
+    if (lwobj->fcache_cnt[idx] > 0) {
+        lwi->ops = (const compiled_op_t*)lwobj->fcache_ops[idx];
+        lwi->ops_cnt = lwobj->fcache_cnt[idx];
+    }
+}
+
+#endif /* LWPRINTF_CFG_FORMAT_CACHE_SIZE > 0 */
+
+/**
+ * \brief           Process format string and parse variable parameters
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in]       arg: Variable parameters list
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+prv_format(lwprintf_int_t* lwi, va_list arg) {
+    va_list ap;
+
+    LWPRINTF_CFG_TRACE_FORMAT_START(lwi->lwobj, lwi->fmt);
+#if LWPRINTF_CFG_OS && !LWPRINTF_CFG_OS_MANUAL_PROTECT
+    if (IS_PRINT_MODE(lwi) && !prv_mutex_wait(lwi->lwobj)) { /* OS protection only for print */
+        LWPRINTF_CFG_TRACE_FORMAT_END(lwi->lwobj, 0);
+        return 0;
+    }
+#endif /* LWPRINTF_CFG_OS && !LWPRINTF_CFG_OS_MANUAL_PROTECT */
+#if LWPRINTF_CFG_OS_YIELD_CHUNK > 0
+    if (IS_PRINT_MODE(lwi)) {
+        /* Record of other task is not finished yet, this one is stored and comes out after it */
+        if (prv_yield_defer(lwi, arg)) {
+            prv_mutex_release(lwi->lwobj);
+            LWPRINTF_CFG_TRACE_FORMAT_END(lwi->lwobj, 0);
+            return 0;
+        }
+        lwi->is_yield_on = !lwi->lwobj->is_emitting; /* Only outer record yields */
+        lwi->lwobj->is_emitting = 1;
+    }
+#endif /* LWPRINTF_CFG_OS_YIELD_CHUNK > 0 */
+#if LWPRINTF_CFG_FORMAT_CACHE_SIZE > 0
+    prv_fcache_get(lwi);
+#endif /* LWPRINTF_CFG_FORMAT_CACHE_SIZE > 0 */
+
+    va_copy(ap, arg); /* Converters get pointer to the list, that is portable only for local copy */
+    prv_format_run(lwi, &ap);
+    va_end(ap);
+    prv_format_end(lwi); /* Output last zero number */
+#if LWPRINTF_CFG_OS_YIELD_CHUNK > 0
+    if (lwi->is_yield_on) {
+        lwi->is_yield_on = 0;
+        lwi->lwobj->is_emitting = 0;
+    }
+#endif /* LWPRINTF_CFG_OS_YIELD_CHUNK > 0 */
+#if LWPRINTF_CFG_OS && !LWPRINTF_CFG_OS_MANUAL_PROTECT
+    if (IS_PRINT_MODE(lwi)) { /* Mutex only for print operation */
+        prv_mutex_release(lwi->lwobj);
+    }
+#endif /* LWPRINTF_CFG_OS && !LWPRINTF_CFG_OS_MANUAL_PROTECT */
+    LWPRINTF_CFG_TRACE_FORMAT_END(lwi->lwobj, lwi->n_len);
+    return 1;
+}
+
+#if LWPRINTF_CFG_OS_YIELD_CHUNK > 0
+
+/**
+ * \brief           Process format string for direct print operation, that may yield between chunks
+ *
+ * Records of other tasks, stored while this one yielded, are sent out right after it
+ *
+ * \param[in,out]   lwi: LwPRINTF internal instance, set up for print operation
+ * \param[in]       arg: Variable parameters list
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+prv_yield_format(lwprintf_int_t* lwi, va_list arg) {
+    uint8_t res = prv_format(lwi, arg);
+
+    /* Records from the ring buffer are already processed by the caller */
+    if (lwi->dargs == NULL && lwi->lwobj->dbuff_r != lwi->lwobj->dbuff_w) {
+        lwprintf_process_deferred_ex(lwi->lwobj);
+    }
+    return res;
+}
+
+#endif /* LWPRINTF_CFG_OS_YIELD_CHUNK > 0 */
+
+/**
+ * \brief           Process format string for direct print operation
+ *
+ * With \ref LWPRINTF_CFG_OS_STAGING_SIZE enabled, text is formatted to the stack
+ * without mutex, and mutex is held only while finished text is sent to the output.
+ * With \ref LWPRINTF_CFG_OS_ISR_DEFERRED enabled, message from interrupt is stored to deferred ring buffer
+ *
+ * \param[in,out]   lwi: LwPRINTF internal instance, set up for print operation
+ * \param[in]       arg: Variable parameters list
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+prv_format_print(lwprintf_int_t* lwi, va_list arg) {
+#if LWPRINTF_CFG_OS_ISR_DEFERRED
+    if (lwi->dargs == NULL) {
+        /* Mutex cannot be used from interrupt, message is stored instead. Compiled formats are dropped */
+        if (lwprintf_sys_is_isr()) {
+            if (lwi->fmt != NULL) {
+                lwprintf_vprintf_deferred_ex(lwi->lwobj, lwi->fmt, arg);
+            }
+            return 0;
+        }
+
+        /* Messages from interrupts come out first */
+        if (lwi->lwobj->dbuff_r != lwi->lwobj->dbuff_w) {
+            lwprintf_process_deferred_ex(lwi->lwobj);
+        }
+    }
+#endif /* LWPRINTF_CFG_OS_ISR_DEFERRED */
+#if LWPRINTF_CFG_OS && !LWPRINTF_CFG_OS_MANUAL_PROTECT && LWPRINTF_CFG_OS_STAGING_SIZE > 0
+    char staging[LWPRINTF_CFG_OS_STAGING_SIZE];
+    lwprintf_int_t fobj = {
+        .lwobj = lwi->lwobj,
+        .out_fn = prv_out_fn_write_buff,
+        .out_str_fn = prv_out_str_fn_write_buff,
+        .out_fill_fn = prv_out_fill_fn_write_buff,
+        .fmt = lwi->fmt,
+        .buff = staging,
+        .buff_max_len = sizeof(staging),
+    };
+    va_list arg_copy;
+
+#if LWPRINTF_CFG_ENABLE_COMPILED_FORMAT
+    fobj.ops = lwi->ops;
+    fobj.ops_cnt = lwi->ops_cnt;
+#endif /* LWPRINTF_CFG_ENABLE_COMPILED_FORMAT */
+#if PACKED_ARGS
+    fobj.dargs = lwi->dargs;
+#endif /* PACKED_ARGS */
+#if LWPRINTF_CFG_STATS
+    fobj.is_stats_off = 1; /* Print is counted when staged text is sent */
+#endif /* LWPRINTF_CFG_STATS */
+
+    /* Arguments are kept for second pass, if text does not fit to the staging buffer */
+    va_copy(arg_copy, arg);
+    prv_format(&fobj, arg_copy);
+    va_end(arg_copy);
+    if (fobj.n_len > fobj.buff_max_len) {
+#if LWPRINTF_CFG_OS_YIELD_CHUNK > 0
+        return prv_yield_format(lwi, arg);
+#else
+        return prv_format(lwi, arg);
+#endif /* LWPRINTF_CFG_OS_YIELD_CHUNK > 0 */
+    }
+
+    /* Only hand over finished text with mutex held */
+    if (!prv_mutex_wait(lwi->lwobj)) {
+        return 0;
+    }
+#if LWPRINTF_CFG_OS_YIELD_CHUNK > 0
+    if (prv_yield_defer(lwi, arg)) {
+        prv_mutex_release(lwi->lwobj);
+        return 0;
+    }
+#endif /* LWPRINTF_CFG_OS_YIELD_CHUNK > 0 */
+    prv_out_str_raw(lwi, staging, fobj.n_len);
+    prv_format_end(lwi);
+    prv_mutex_release(lwi->lwobj);
+    return 1;
+#elif LWPRINTF_CFG_OS_YIELD_CHUNK > 0
+    return prv_yield_format(lwi, arg);
+#else
+    return prv_format(lwi, arg);
+#endif /* LWPRINTF_CFG_OS && !LWPRINTF_CFG_OS_MANUAL_PROTECT && LWPRINTF_CFG_OS_STAGING_SIZE > 0 */
+}
+
+#if LWPRINTF_CFG_ENABLE_LOG_LEVEL
+
+/**
+ * \brief           Set level of the instance and all its modules to \ref LWPRINTF_CFG_LOG_LEVEL_MIN
+ * \param[in,out]   lwobj: LwPRINTF working instance
+ */
+static void
+prv_init_level(lwprintf_t* lwobj) {
+    lwobj->level = LWPRINTF_CFG_LOG_LEVEL_MIN;
+#if LWPRINTF_CFG_LOG_MODULE_COUNT > 0
+    memset(lwobj->module_levels, LWPRINTF_CFG_LOG_LEVEL_MIN, sizeof(lwobj->module_levels));
+#endif /* LWPRINTF_CFG_LOG_MODULE_COUNT > 0 */
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_LOG_LEVEL */
+
+#if LWPRINTF_CFG_STATS || LWPRINTF_CFG_OS_STATS
+
+/**
+ * \brief           Clear statistics of the instance, until \ref lwprintf_init_stats_ex sets timestamp function
+ * \param[in,out]   lwobj: LwPRINTF working instance
+ */
+static void
+prv_init_stats(lwprintf_t* lwobj) {
+    lwobj->stats_time_fn = NULL;
+    memset(&lwobj->stats, 0x00, sizeof(lwobj->stats));
+#if LWPRINTF_CFG_OS_STATS
+    lwobj->stats_hold_start = 0;
+    lwobj->stats_depth = 0;
+#endif /* LWPRINTF_CFG_OS_STATS */
+}
+
+#endif /* LWPRINTF_CFG_STATS || LWPRINTF_CFG_OS_STATS */
+
+/**
+ * \brief           Create system mutex for the instance
+ * \param[in,out]   lwobj: LwPRINTF working instance
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+prv_init_mutex(lwprintf_t* lwobj) {
+#if LWPRINTF_CFG_OS
+    /* Create system mutex, but only if user selected to ever use print mode */
+    if (IS_OUTPUT_SET(lwobj)
+        && (lwprintf_sys_mutex_isvalid(&lwobj->mutex) || !lwprintf_sys_mutex_create(&lwobj->mutex))) {
+        return 0;
+    }
+#else
+    LWPRINTF_UNUSED(lwobj);
+#endif /* LWPRINTF_CFG_OS */
+    return 1;
+}
+
+/**
+ * \brief           Initialize LwPRINTF instance
+ * \param[in,out]   lwobj: LwPRINTF working instance
+ * \param[in]       out_fn: Output function used for print operation.
+ *                      When set to `NULL`, direct print to stream functions won't work
+ *                      and will return error if called by the application.
+ *                      Also, system mutex for this specific instance won't be called
+ *                      as system mutex isn't needed. All formatting functions (with print being an exception)
+ *                      are thread safe. Library utilizes stack-based variables
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwprintf_init_ex(lwprintf_t* lwobj, lwprintf_output_fn out_fn) {
+    lwobj = LWPRINTF_GET_LWOBJ(lwobj);
+    lwobj->out_fn = out_fn;
+#if LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT
+    lwobj->out_block_fn = NULL;
+#endif /* LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT */
+#if LWPRINTF_CFG_ENABLE_TRY_PRINT
+    lwobj->dropped = 0;
+    lwobj->dropped_reported = 0;
+#endif /* LWPRINTF_CFG_ENABLE_TRY_PRINT */
+#if LWPRINTF_CFG_ENABLE_RATE_LIMIT
+    lwobj->limit_time_fn = NULL;
+#endif /* LWPRINTF_CFG_ENABLE_RATE_LIMIT */
+#if LWPRINTF_CFG_ENABLE_CUSTOM_SPEC
+    lwobj->specs_cnt = 0;
+#endif /* LWPRINTF_CFG_ENABLE_CUSTOM_SPEC */
+#if LWPRINTF_CFG_SUPPORT_THOUSANDS
+    lwobj->thousands_sep = '\0';
+#endif /* LWPRINTF_CFG_SUPPORT_THOUSANDS */
+#if LWPRINTF_CFG_SUPPORT_TYPE_ARRAY
+    lwobj->array_sep = NULL;
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ARRAY */
+#if LWPRINTF_CFG_ENABLE_LINE_PREFIX
+    lwobj->prefix_time_fn = NULL;
+#endif /* LWPRINTF_CFG_ENABLE_LINE_PREFIX */
+#if LWPRINTF_CFG_ENABLE_LOG_LEVEL
+    prv_init_level(lwobj);
+#endif /* LWPRINTF_CFG_ENABLE_LOG_LEVEL */
+#if LWPRINTF_CFG_STATS || LWPRINTF_CFG_OS_STATS
+    prv_init_stats(lwobj);
+#endif /* LWPRINTF_CFG_STATS || LWPRINTF_CFG_OS_STATS */
+#if LWPRINTF_CFG_FORMAT_CACHE_SIZE > 0
+    memset(lwobj->fcache_fmt, 0x00, sizeof(lwobj->fcache_fmt));
+#endif /* LWPRINTF_CFG_FORMAT_CACHE_SIZE > 0 */
+#if LWPRINTF_CFG_ENABLE_ASPRINTF
+    lwobj->pool = NULL;
+#endif /* LWPRINTF_CFG_ENABLE_ASPRINTF */
+#if LWPRINTF_CFG_OS_YIELD_CHUNK > 0
+    lwobj->is_emitting = 0;
+    lwobj->yield_busy = 0;
+#endif /* LWPRINTF_CFG_OS_YIELD_CHUNK > 0 */
+    return prv_init_mutex(lwobj);
+}
+
+#if LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT || __DOXYGEN__
+
+/**
+ * \brief           Initialize LwPRINTF instance with block output function.
+ *
+ * Formatted characters are collected in the staging buffer and sent to the output
+ * when buffer is full or when formatting of single print call ends.
+ *
+ * \note            Staging buffer is owned by the instance for its lifetime.
+ *                      It must not be shared with other instances
+ *
+ * \param[in,out]   lwobj: LwPRINTF working instance
+ * \param[in]       out_block_fn: Block output function used for print operation.
+ *                      When set to `NULL`, direct print to stream functions won't work
+ * \param[in]       buff: Staging buffer. Set to `NULL` to send every character directly
+ *                      to the output function
+ * \param[in]       buff_size: Size of staging buffer in units of bytes
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwprintf_init_block_ex(lwprintf_t* lwobj, lwprintf_output_block_fn out_block_fn, char* buff, size_t buff_size) {
+    lwobj = LWPRINTF_GET_LWOBJ(lwobj);
+    lwobj->out_fn = NULL;
+    lwobj->out_block_fn = out_block_fn;
+    lwobj->buff = buff;
+    lwobj->buff_size = buff != NULL ? buff_size : 0;
+    lwobj->buff_len = 0;
+    lwobj->batch = 0;
+#if LWPRINTF_CFG_ENABLE_BUFF_MODE
+    lwobj->buff_mode = LWPRINTF_BUFF_MODE_NONE;
+#endif /* LWPRINTF_CFG_ENABLE_BUFF_MODE */
+#if LWPRINTF_CFG_ENABLE_AUTO_FLUSH
+    lwobj->flush_time_fn = NULL;
+    lwobj->flush_stamped = 0;
+#endif /* LWPRINTF_CFG_ENABLE_AUTO_FLUSH */
+#if LWPRINTF_CFG_ENABLE_LOW_POWER
+    lwobj->lp_threshold = 0;
+#endif /* LWPRINTF_CFG_ENABLE_LOW_POWER */
+#if LWPRINTF_CFG_ENABLE_COALESCE
+    lwobj->coalesce = 0;
+    lwobj->rec_start = 0;
+    lwobj->rec_repeat = 0;
+#endif /* LWPRINTF_CFG_ENABLE_COALESCE */
+#if LWPRINTF_CFG_ENABLE_TRY_PRINT
+    lwobj->dropped = 0;
+    lwobj->dropped_reported = 0;
+#endif /* LWPRINTF_CFG_ENABLE_TRY_PRINT */
+#if LWPRINTF_CFG_ENABLE_RATE_LIMIT
+    lwobj->limit_time_fn = NULL;
+#endif /* LWPRINTF_CFG_ENABLE_RATE_LIMIT */
+#if LWPRINTF_CFG_ENABLE_CUSTOM_SPEC
+    lwobj->specs_cnt = 0;
+#endif /* LWPRINTF_CFG_ENABLE_CUSTOM_SPEC */
+#if LWPRINTF_CFG_SUPPORT_THOUSANDS
+    lwobj->thousands_sep = '\0';
+#endif /* LWPRINTF_CFG_SUPPORT_THOUSANDS */
+#if LWPRINTF_CFG_SUPPORT_TYPE_ARRAY
+    lwobj->array_sep = NULL;
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ARRAY */
+#if LWPRINTF_CFG_ENABLE_LINE_PREFIX
+    lwobj->prefix_time_fn = NULL;
+#endif /* LWPRINTF_CFG_ENABLE_LINE_PREFIX */
+#if LWPRINTF_CFG_ENABLE_LOG_LEVEL
+    prv_init_level(lwobj);
+#endif /* LWPRINTF_CFG_ENABLE_LOG_LEVEL */
+#if LWPRINTF_CFG_STATS || LWPRINTF_CFG_OS_STATS
+    prv_init_stats(lwobj);
+#endif /* LWPRINTF_CFG_STATS || LWPRINTF_CFG_OS_STATS */
+#if LWPRINTF_CFG_FORMAT_CACHE_SIZE > 0
+    memset(lwobj->fcache_fmt, 0x00, sizeof(lwobj->fcache_fmt));
+#endif /* LWPRINTF_CFG_FORMAT_CACHE_SIZE > 0 */
+#if LWPRINTF_CFG_ENABLE_ASPRINTF
+    lwobj->pool = NULL;
+#endif /* LWPRINTF_CFG_ENABLE_ASPRINTF */
+#if LWPRINTF_CFG_OS_YIELD_CHUNK > 0
+    lwobj->is_emitting = 0;
+    lwobj->yield_busy = 0;
+#endif /* LWPRINTF_CFG_OS_YIELD_CHUNK > 0 */
+    return prv_init_mutex(lwobj);
+}
+
+/**
+ * \brief           Start batch of print calls.
+ *
+ * Mutex is taken once for the complete batch, and text of all print calls is collected
+ * to the staging buffer, until \ref lwprintf_batch_end_ex sends it to the output in one call.
+ * Output is sent before the end only if staging buffer gets full.
+ *
+ * \note            With \ref LWPRINTF_CFG_OS enabled, mutex is taken again by every print call,
+ *                  hence it must be recursive
+ *
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       buff: Staging buffer for complete batch, used instead of staging buffer of the instance.
+ *                      Set to `NULL` to use staging buffer of the instance
+ * \param[in]       buff_size: Size of staging buffer in units of bytes
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwprintf_batch_begin_ex(lwprintf_t* const lwobj, char* buff, size_t buff_size) {
+    lwprintf_t* obj = LWPRINTF_GET_LWOBJ(lwobj);
+
+    if (obj->out_block_fn == NULL) {
+        return 0;
+    }
+#if LWPRINTF_CFG_OS
+    if (!prv_mutex_wait(obj)) {
+        return 0;
+    }
+#endif /* LWPRINTF_CFG_OS */
+
+    /* Batches cannot be nested */
+    if (obj->batch) {
+#if LWPRINTF_CFG_OS
+        prv_mutex_release(obj);
+#endif /* LWPRINTF_CFG_OS */
+        return 0;
+    }
+#if LWPRINTF_CFG_ENABLE_BUFF_MODE
+    /* Text kept by buffering mode is sent before staging buffer is replaced */
+    if (obj->buff_len > 0) {
+        lwprintf_int_t fobj = {
+            .lwobj = obj,
+            .buff = NULL,
+            .buff_max_len = 0,
+        };
+
+        prv_out_block_flush(&fobj);
+    }
+#endif /* LWPRINTF_CFG_ENABLE_BUFF_MODE */
+    obj->batch_prev_buff = obj->buff;
+    obj->batch_prev_buff_size = obj->buff_size;
+    if (buff != NULL) {
+        obj->buff = buff;
+        obj->buff_size = buff_size;
+    }
+    obj->buff_len = 0;
+#if LWPRINTF_CFG_ENABLE_COALESCE
+    obj->rec_start = 0;
+#endif /* LWPRINTF_CFG_ENABLE_COALESCE */
+    obj->batch = 1;
+    return 1;
+}
+
+/**
+ * \brief           Send collected text of the batch to the output and end it
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwprintf_batch_end_ex(lwprintf_t* const lwobj) {
+    lwprintf_int_t fobj = {
+        .lwobj = LWPRINTF_GET_LWOBJ(lwobj),
+        .buff = NULL,
+        .buff_max_len = 0,
+    };
+    lwprintf_t* obj = fobj.lwobj;
+    uint8_t res;
+
+    if (!obj->batch) {
+        return 0;
+    }
+    res = (uint8_t)prv_out_block_flush(&fobj);
+    obj->buff = obj->batch_prev_buff;
+    obj->buff_size = obj->batch_prev_buff_size;
+    obj->batch = 0;
+#if LWPRINTF_CFG_OS
+    prv_mutex_release(obj);
+#endif /* LWPRINTF_CFG_OS */
+    return res;
+}
+
+#if LWPRINTF_CFG_ENABLE_BUFF_MODE || __DOXYGEN__
+
+/**
+ * \brief           Set buffering mode of block output instance.
+ *
+ * Text, kept in staging buffer by previous mode, is sent to the output
+ * when mode is changed to \ref LWPRINTF_BUFF_MODE_NONE.
+ * Low power flush policy, when enabled, is disabled by the mode change
+ *
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       mode: Buffering mode
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwprintf_set_buff_mode_ex(lwprintf_t* const lwobj, lwprintf_buff_mode_t mode) {
+    lwprintf_int_t fobj = {
+        .lwobj = LWPRINTF_GET_LWOBJ(lwobj),
+        .buff = NULL,
+        .buff_max_len = 0,
+    };
+    lwprintf_t* obj = fobj.lwobj;
+    uint8_t res = 1;
+
+    if (obj->out_block_fn == NULL || mode > LWPRINTF_BUFF_MODE_FULL) {
+        return 0;
+    }
+#if LWPRINTF_CFG_OS
+    if (!prv_mutex_wait(obj)) {
+        return 0;
+    }
+#endif /* LWPRINTF_CFG_OS */
+    obj->buff_mode = (uint8_t)mode;
+#if LWPRINTF_CFG_ENABLE_LOW_POWER
+    obj->lp_threshold = 0;
+#endif /* LWPRINTF_CFG_ENABLE_LOW_POWER */
+    if (mode == LWPRINTF_BUFF_MODE_NONE && !obj->batch) {
+        res = (uint8_t)prv_out_block_flush(&fobj);
+    }
+#if LWPRINTF_CFG_OS
+    prv_mutex_release(obj);
+#endif /* LWPRINTF_CFG_OS */
+    return res;
+}
+
+/**
+ * \brief           Send text waiting in staging buffer to the output.
+ *
+ * Use it with \ref LWPRINTF_BUFF_MODE_LINE or \ref LWPRINTF_BUFF_MODE_FULL mode,
+ * when text must reach the output before staging buffer gets full
+ *
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwprintf_flush_ex(lwprintf_t* const lwobj) {
+    lwprintf_int_t fobj = {
+        .lwobj = LWPRINTF_GET_LWOBJ(lwobj),
+        .buff = NULL,
+        .buff_max_len = 0,
+    };
+    lwprintf_t* obj = fobj.lwobj;
+    uint8_t res;
+
+    if (obj->out_block_fn == NULL) {
+        return 0;
+    }
+#if LWPRINTF_CFG_OS
+    if (!prv_mutex_wait(obj)) {
+        return 0;
+    }
+#endif /* LWPRINTF_CFG_OS */
+    res = (uint8_t)prv_out_block_flush(&fobj);
+#if LWPRINTF_CFG_OS
+    prv_mutex_release(obj);
+#endif /* LWPRINTF_CFG_OS */
+    return res;
+}
+
+#if LWPRINTF_CFG_ENABLE_AUTO_FLUSH || __DOXYGEN__
+
+/**
+ * \brief           Set maximum age of text, kept in staging buffer by buffering mode.
+ *
+ * Age is checked by \ref lwprintf_auto_flush_ex, that must be called periodically by the application
+ *
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       time_fn: Timestamp function. Set to `NULL` to disable auto flush
+ * \param[in]       age: Maximum age of staged text, in units of timestamp function
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwprintf_set_auto_flush_ex(lwprintf_t* const lwobj, lwprintf_timestamp_fn time_fn, uint32_t age) {
+    lwprintf_t* obj = LWPRINTF_GET_LWOBJ(lwobj);
+
+    if (obj->out_block_fn == NULL) {
+        return 0;
+    }
+#if LWPRINTF_CFG_OS
+    if (!prv_mutex_wait(obj)) {
+        return 0;
+    }
+#endif /* LWPRINTF_CFG_OS */
+    obj->flush_time_fn = time_fn;
+    obj->flush_age = age;
+    obj->flush_stamped = 0;
+#if LWPRINTF_CFG_OS
+    prv_mutex_release(obj);
+#endif /* LWPRINTF_CFG_OS */
+    return 1;
+}
+
+/**
+ * \brief           Send text kept in staging buffer, when it is older than maximum age.
+ *
+ * Function is intended to be called periodically from timer or idle task.
+ * It never waits for the mutex, and returns at once when instance is used by other thread.
+ * Text is not sent during batch
+ *
+ * \note            When \ref LWPRINTF_CFG_OS is disabled, function must not interrupt print call
+ *                      of the same instance, for example call it from main loop, not from timer interrupt
+ *
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \return          `1` when text has been sent to the output, `0` otherwise
+ */
+uint8_t
+lwprintf_auto_flush_ex(lwprintf_t* const lwobj) {
+    lwprintf_int_t fobj = {
+        .lwobj = LWPRINTF_GET_LWOBJ(lwobj),
+        .buff = NULL,
+        .buff_max_len = 0,
+    };
+    lwprintf_t* obj = fobj.lwobj;
+    uint8_t res = 0;
+
+    if (obj->out_block_fn == NULL || obj->flush_time_fn == NULL) {
+        return 0;
+    }
+#if LWPRINTF_CFG_OS
+    if (!prv_mutex_trywait(obj)) {
+        return 0;
+    }
+#endif /* LWPRINTF_CFG_OS */
+    if (obj->buff_len > 0 && !obj->batch) {
+        const uint32_t now = obj->flush_time_fn();
+
+        /* Text left by print call, that has not stamped it, gets its age now */
+        if (!obj->flush_stamped) {
+            obj->flush_stamp = now;
+            obj->flush_stamped = 1;
+        }
+        if ((uint32_t)(now - obj->flush_stamp) >= obj->flush_age) {
+            res = (uint8_t)prv_out_block_flush(&fobj);
+        }
+    }
+#if LWPRINTF_CFG_OS
+    prv_mutex_release(obj);
+#endif /* LWPRINTF_CFG_OS */
+    return res;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_AUTO_FLUSH || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_LOW_POWER || __DOXYGEN__
+
+/**
+ * \brief           Set low power flush policy of block output instance.
+ *
+ * Text is kept in staging buffer and sent in single burst at the end of print call,
+ * when it reaches `threshold` size or message level, printed with \ref lwprintf_printf_level_ex,
+ * is at least `level`. Full staging buffer is always sent.
+ * Policy selects \ref LWPRINTF_BUFF_MODE_FULL mode, and it is disabled by \ref lwprintf_set_buff_mode_ex
+ *
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       threshold: Size of kept text, that is sent at the end of print call.
+ *                      Set to `0` to disable policy, send kept text and select \ref LWPRINTF_BUFF_MODE_NONE
+ * \param[in]       level: Minimum level of message, that is sent at the end of its print call
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwprintf_set_low_power_ex(lwprintf_t* const lwobj, size_t threshold, uint8_t level) {
+    lwprintf_int_t fobj = {
+        .lwobj = LWPRINTF_GET_LWOBJ(lwobj),
+        .buff = NULL,
+        .buff_max_len = 0,
+    };
+    lwprintf_t* obj = fobj.lwobj;
+    uint8_t res = 1;
+
+    if (obj->out_block_fn == NULL || obj->buff == NULL || obj->buff_size == 0) {
+        return 0;
+    }
+#if LWPRINTF_CFG_OS
+    if (!prv_mutex_wait(obj)) {
+        return 0;
+    }
+#endif /* LWPRINTF_CFG_OS */
+    obj->lp_threshold = threshold;
+    obj->lp_level = level;
+    obj->buff_mode = (uint8_t)(threshold > 0 ? LWPRINTF_BUFF_MODE_FULL : LWPRINTF_BUFF_MODE_NONE);
+    if (threshold == 0 && !obj->batch) {
+        res = (uint8_t)prv_out_block_flush(&fobj);
+    }
+#if LWPRINTF_CFG_OS
+    prv_mutex_release(obj);
+#endif /* LWPRINTF_CFG_OS */
+    return res;
+}
+
+/**
+ * \brief           Send text kept in staging buffer, before the system enters idle.
+ *
+ * Function is intended to be called from pre-sleep hook of tickless idle,
+ * so that output peripheral completes the burst before the system sleeps and is not woken up again for the kept text.
+ * It never waits for the mutex, and returns at once when instance is used by other thread.
+ * Text is not sent during batch
+ *
+ * \note            When \ref LWPRINTF_CFG_OS is disabled, function must not interrupt print call
+ *                      of the same instance, for example call it from main loop before entering sleep
+ *
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \return          `1` when text has been sent to the output, `0` otherwise
+ */
+uint8_t
+lwprintf_idle_flush_ex(lwprintf_t* const lwobj) {
+    lwprintf_int_t fobj = {
+        .lwobj = LWPRINTF_GET_LWOBJ(lwobj),
+        .buff = NULL,
+        .buff_max_len = 0,
+    };
+    lwprintf_t* obj = fobj.lwobj;
+    uint8_t res = 0;
+
+    if (obj->out_block_fn == NULL) {
+        return 0;
+    }
+#if LWPRINTF_CFG_OS
+    if (!prv_mutex_trywait(obj)) {
+        return 0;
+    }
+#endif /* LWPRINTF_CFG_OS */
+    if (obj->buff_len > 0 && !obj->batch) {
+        res = (uint8_t)prv_out_block_flush(&fobj);
+    }
+#if LWPRINTF_CFG_OS
+    prv_mutex_release(obj);
+#endif /* LWPRINTF_CFG_OS */
+    return res;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_LOW_POWER || __DOXYGEN__ */
+
+#endif /* LWPRINTF_CFG_ENABLE_BUFF_MODE || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_COALESCE || __DOXYGEN__
+
+/**
+ * \brief           Enable or disable coalescing of repeated records of block output instance.
+ *
+ * Record is the text of single print call. When it is the same as the previous record,
+ * it is removed from staging buffer and counted. Count is printed with \ref LWPRINTF_CFG_COALESCE_REPORT,
+ * before the next different record, or when timeout after the first repeat expires.
+ * Record, that does not fit to staging buffer, is never coalesced.
+ * Pending report is printed when coalescing is disabled
+ *
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       enable: Set to `1` to coalesce repeated records, `0` to print all of them
+ * \param[in]       time_fn: Timestamp function of report timeout. Set to `NULL` to report only when run ends
+ * \param[in]       timeout: Time after first repeat, when report is printed, in units of timestamp function
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwprintf_set_coalesce_ex(lwprintf_t* const lwobj, uint8_t enable, lwprintf_timestamp_fn time_fn, uint32_t timeout) {
+    lwprintf_int_t fobj = {
+        .lwobj = LWPRINTF_GET_LWOBJ(lwobj),
+        .buff = NULL,
+        .buff_max_len = 0,
+    };
+    lwprintf_t* obj = fobj.lwobj;
+    uint8_t res = 1;
+
+    if (obj->out_block_fn == NULL || obj->buff == NULL || obj->buff_size == 0) {
+        return 0;
+    }
+#if LWPRINTF_CFG_OS
+    if (!prv_mutex_wait(obj)) {
+        return 0;
+    }
+#endif /* LWPRINTF_CFG_OS */
+    if (obj->coalesce && !enable && obj->rec_repeat > 0) {
+        res = (uint8_t)prv_coalesce_report(&fobj, obj->buff_len);
+        obj->rec_start = obj->buff_len;
+        if (!IS_BLOCK_KEPT(obj) || IS_BLOCK_LINE_MODE(obj)) {
+            res = (uint8_t)prv_out_block_flush(&fobj) && res;
+        }
+    }
+    obj->coalesce = enable;
+    obj->coalesce_time_fn = time_fn;
+    obj->coalesce_timeout = timeout;
+    obj->rec_start = obj->buff_len;
+    obj->rec_split = 0;
+    obj->rec_len = 0;
+    obj->rec_repeat = 0;
+#if LWPRINTF_CFG_OS
+    prv_mutex_release(obj);
+#endif /* LWPRINTF_CFG_OS */
+    return res;
+}
+
+/**
+ * \brief           Print report of repeated records, when timeout after the first repeat expired.
+ *
+ * Function is intended to be called periodically from timer or idle task,
+ * so that report of the last run is printed also when no other record follows it
+ *
+ * \note            When \ref LWPRINTF_CFG_OS is disabled, function must not interrupt print call
+ *                      of the same instance, for example call it from main loop, not from timer interrupt
+ *
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \return          `1` when report has been printed, `0` otherwise
+ */
+uint8_t
+lwprintf_coalesce_process_ex(lwprintf_t* const lwobj) {
+    lwprintf_int_t fobj = {
+        .lwobj = LWPRINTF_GET_LWOBJ(lwobj),
+        .buff = NULL,
+        .buff_max_len = 0,
+    };
+    lwprintf_t* obj = fobj.lwobj;
+    uint8_t res = 0;
+
+    if (obj->out_block_fn == NULL || !obj->coalesce || obj->coalesce_time_fn == NULL) {
+        return 0;
+    }
+#if LWPRINTF_CFG_OS
+    if (!prv_mutex_wait(obj)) {
+        return 0;
+    }
+#endif /* LWPRINTF_CFG_OS */
+    if (obj->rec_repeat > 0
+        && (uint32_t)(obj->coalesce_time_fn() - obj->coalesce_stamp) >= obj->coalesce_timeout) {
+        res = (uint8_t)prv_coalesce_report(&fobj, obj->buff_len);
+        obj->rec_start = obj->buff_len; /* Report is not part of any record */
+        if (!IS_BLOCK_KEPT(obj) || IS_BLOCK_LINE_MODE(obj)) {
+            res = (uint8_t)prv_out_block_flush(&fobj) && res;
+        }
+    }
+#if LWPRINTF_CFG_OS
+    prv_mutex_release(obj);
+#endif /* LWPRINTF_CFG_OS */
+    return res;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_COALESCE || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_FANOUT || __DOXYGEN__
+
+/**
+ * \brief           Initialize LwPRINTF instance as fan-out instance.
+ *
+ * Text is formatted once, and every block of staging buffer is sent to all sinks of the instance,
+ * added with \ref lwprintf_add_sink_ex. Batch of print calls is supported the same way as for block output.
+ *
+ * \param[in,out]   lwobj: LwPRINTF working instance
+ * \param[in]       buff: Staging buffer. Set to `NULL` to send every character directly to the sinks
+ * \param[in]       buff_size: Size of staging buffer in units of bytes
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwprintf_init_fanout_ex(lwprintf_t* lwobj, char* buff, size_t buff_size) {
+    LWPRINTF_GET_LWOBJ(lwobj)->sinks_cnt = 0;
+    return lwprintf_init_block_ex(lwobj, prv_fanout_block_fn, buff, buff_size);
+}
+
+/**
+ * \brief           Add sink to fan-out instance.
+ *
+ * Sink receives messages with level at least `level`. Messages printed without level,
+ * with \ref lwprintf_printf_ex and other print functions, are sent to all sinks.
+ * Sink that returns less than `len` does not receive rest of the message, and its failure is counted
+ *
+ * \note            Add sinks during initialization, before instance is used by print calls
+ *
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       fn: Block output function of the sink
+ * \param[in]       level: Minimum level of messages sent to the sink
+ * \return          `1` on success, `0` if instance is not fan-out instance or has no free sink
+ */
+uint8_t
+lwprintf_add_sink_ex(lwprintf_t* const lwobj, lwprintf_output_block_fn fn, uint8_t level) {
+    lwprintf_t* obj = LWPRINTF_GET_LWOBJ(lwobj);
+
+    if (fn == NULL || obj->out_block_fn != prv_fanout_block_fn || obj->sinks_cnt >= LWPRINTF_ARRAYSIZE(obj->sinks)) {
+        return 0;
+    }
+    obj->sinks[obj->sinks_cnt].fn = fn;
+    obj->sinks[obj->sinks_cnt].level = level;
+    obj->sinks[obj->sinks_cnt].failures = 0;
+    ++obj->sinks_cnt;
+    return 1;
+}
+
+/**
+ * \brief           Get number of messages, that sink of fan-out instance failed to output
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       index: Sink index, in order of \ref lwprintf_add_sink_ex calls
+ * \return          Number of failed messages, `0` for invalid index
+ */
+uint32_t
+lwprintf_get_sink_failures_ex(lwprintf_t* const lwobj, size_t index) {
+    lwprintf_t* obj = LWPRINTF_GET_LWOBJ(lwobj);
+
+    return index < obj->sinks_cnt ? obj->sinks[index].failures : 0;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_FANOUT || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_FANOUT || LWPRINTF_CFG_ENABLE_LOW_POWER || __DOXYGEN__
+
+/**
+ * \brief           Print formatted data from variable argument list with level to the output.
+ *
+ * For fan-out instance, message is sent only to sinks with level lower or equal to the message level.
+ * During batch, level is ignored and text is sent to all sinks.
+ * With low power flush policy, message with priority level sends kept text at the end of print call
+ *
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       level: Level of the message
+ * \param[in]       format: C string that contains the text to be written to output
+ * \param[in]       arg: A value identifying a variable arguments list initialized with `va_start`.
+ *                      `va_list` is a special type defined in `<cstdarg>`.
+ * \return          The number of characters that would have been written,
+ *                      not counting the terminating null character.
+ */
+int
+lwprintf_vprintf_level_ex(lwprintf_t* const lwobj, uint8_t level, const char* format, va_list arg) {
+    lwprintf_int_t fobj = {
+        .lwobj = LWPRINTF_GET_LWOBJ(lwobj),
+        .out_fn = prv_out_fn_print,
+        .out_str_fn = prv_out_str_fn_print,
+        .out_fill_fn = prv_out_fill_fn_print,
+        .fmt = format,
+        .buff = NULL,
+        .buff_max_len = 0,
+    };
+    lwprintf_t* obj = fobj.lwobj;
+
+    if (!IS_OUTPUT_SET(obj)) {
+        return 0;
+    }
+#if LWPRINTF_CFG_ENABLE_FANOUT
+    if (obj->out_block_fn == prv_fanout_block_fn && !obj->batch) {
+        for (size_t i = 0; i < obj->sinks_cnt; ++i) {
+            if (level < obj->sinks[i].level) {
+                fobj.sinks_skip |= 1UL << i;
+            }
+        }
+    }
+#endif /* LWPRINTF_CFG_ENABLE_FANOUT */
+#if LWPRINTF_CFG_ENABLE_LOW_POWER
+    fobj.is_priority = level >= obj->lp_level;
+#endif /* LWPRINTF_CFG_ENABLE_LOW_POWER */
+    if (prv_format_print(&fobj, arg)) {
+        return (int)fobj.n_len;
+    }
+    return 0;
+}
+
+/**
+ * \brief           Print formatted data with level to the output
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       level: Level of the message
+ * \param[in]       format: C string that contains the text to be written to output
+ * \param[in]       ...: Optional arguments for format string
+ * \return          The number of characters that would have been written,
+ *                      not counting the terminating null character.
+ * \sa              lwprintf_vprintf_level_ex
+ */
+int
+lwprintf_printf_level_ex(lwprintf_t* const lwobj, uint8_t level, const char* format, ...) {
+    va_list valist;
+    int n_len;
+
+    va_start(valist, format);
+    n_len = lwprintf_vprintf_level_ex(lwobj, level, format, valist);
+    va_end(valist);
+
+    return n_len;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_FANOUT || LWPRINTF_CFG_ENABLE_LOW_POWER || __DOXYGEN__ */
+
+#endif /* LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT || __DOXYGEN__ */
+
+/**
+ * \brief           Print formatted data from variable argument list to the output
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       format: C string that contains the text to be written to output
+ * \param[in]       arg: A value identifying a variable arguments list initialized with `va_start`.
+ *                      `va_list` is a special type defined in `<cstdarg>`.
+ * \return          The number of characters that would have been written if `n` had been sufficiently large,
+ *                      not counting the terminating null character.
+ */
+#if LWPRINTF_CFG_ENABLE_TOKEN
+
+/**
+ * \brief           Append unsigned number to tokenized frame, `7` bits per byte, LSB first
+ * \param[in,out]   frame: Frame buffer
+ * \param[in,out]   len: Current length of frame
+ * \param[in]       val: Value to append
+ * \return          `1` on success, `0` if frame is full
+ */
+static uint8_t
+prv_token_varint(unsigned char* frame, size_t* len, uint_maxtype_t val) {
+    do {
+        if (*len >= LWPRINTF_CFG_TOKEN_FRAME_SIZE) {
+            return 0;
+        }
+        frame[(*len)++] = (unsigned char)((val & 0x7F) | (val > 0x7F ? 0x80 : 0x00));
+        val >>= 7;
+    } while (val > 0);
+    return 1;
+}
+
+/**
+ * \brief           Append signed number to tokenized frame, in zigzag encoding
+ * \param[in,out]   frame: Frame buffer
+ * \param[in,out]   len: Current length of frame
+ * \param[in]       val: Value to append
+ * \return          `1` on success, `0` if frame is full
+ */
+static uint8_t
+prv_token_svarint(unsigned char* frame, size_t* len, int_maxtype_t val) {
+    return prv_token_varint(frame, len, val < 0 ? ~((uint_maxtype_t)val << 1) : (uint_maxtype_t)val << 1);
+}
+
+/**
+ * \brief           Append raw bytes to tokenized frame
+ * \param[in,out]   frame: Frame buffer
+ * \param[in,out]   len: Current length of frame
+ * \param[in]       data: Data to append
+ * \param[in]       data_len: Length of data
+ * \return          `1` on success, `0` if frame is full
+ */
+static uint8_t
+prv_token_raw(unsigned char* frame, size_t* len, const void* data, size_t data_len) {
+    if (data_len > LWPRINTF_CFG_TOKEN_FRAME_SIZE - *len) {
+        return 0;
+    }
+    memcpy(&frame[*len], data, data_len);
+    *len += data_len;
+    return 1;
+}
+
+/**
+ * \brief           Encode arguments of tokenized frame, with the same specifier parser as formatting
+ *
+ * Integers are encoded as variable length numbers, signed ones in zigzag encoding,
+ * floating point numbers as \ref lwprintf_packed_float_t in little endian order,
+ * strings with terminating `NULL` character. Other arguments are skipped.
+ *
+ * \param[in,out]   frame: Frame buffer
+ * \param[in,out]   len: Current length of frame
+ * \param[in]       format: Format string
+ * \param[in]       arg: Pointer to variable argument list
+ * \return          `1` on success, `0` if frame is full
+ */
+static uint8_t
+prv_token_args(unsigned char* frame, size_t* len, const char* format, va_list* arg) {
+    const char* fmt = format;
+    format_spec_t m;
+    uint8_t star, ok = 1;
+
+    while (ok && *fmt != '\0') {
+        if (*fmt++ != '%') {
+            continue;
+        }
+        fmt = prv_parse_spec(&m, fmt, &star);
+        if (star & SPEC_STAR_WIDTH) {
+            ok = ok && prv_token_svarint(frame, len, va_arg(*arg, int));
+        }
+        if (star & SPEC_STAR_PRECISION) {
+            ok = ok && prv_token_svarint(frame, len, va_arg(*arg, int));
+        }
+        if (*fmt == '\0') {
+            break;
+        }
+#if LWPRINTF_CFG_SUPPORT_TYPE_ARRAY
+        if (m.flags.array) {
+            (void)va_arg(*arg, int);
+            (void)va_arg(*arg, const void*);
+            fmt = prv_spec_next(fmt);
+            continue;
+        }
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ARRAY */
+
+        /* Types must follow arguments read in prv_format function */
+        switch (*fmt) {
+            case 'c': ok = prv_token_varint(frame, len, (unsigned char)va_arg(*arg, int)); break;
+#if LWPRINTF_CFG_SUPPORT_TYPE_INT
+            case 'd':
+            case 'i':
+                if (m.flags.longlong == 0) {
+                    ok = prv_token_svarint(frame, len, va_arg(*arg, signed int));
+                } else if (m.flags.longlong == 1) {
+                    ok = prv_token_svarint(frame, len, va_arg(*arg, signed long int));
+#if LWPRINTF_CFG_SUPPORT_LONG_LONG
+                } else if (m.flags.longlong == 2) {
+                    ok = prv_token_svarint(frame, len, va_arg(*arg, signed long long int));
+#endif /* LWPRINTF_CFG_SUPPORT_LONG_LONG */
+                }
+                break;
+            case 'b':
+            case 'B':
+            case 'o':
+            case 'u':
+            case 'x':
+            case 'X':
+                if (m.flags.sz_t) {
+                    ok = prv_token_varint(frame, len, va_arg(*arg, size_t));
+                } else if (m.flags.umax_t) {
+                    ok = prv_token_varint(frame, len, va_arg(*arg, uintmax_t));
+                } else if (m.flags.longlong == 0 || *fmt == 'b' || *fmt == 'B') {
+                    ok = prv_token_varint(frame, len, va_arg(*arg, unsigned int));
+                } else if (m.flags.longlong == 1) {
+                    ok = prv_token_varint(frame, len, va_arg(*arg, unsigned long int));
+#if LWPRINTF_CFG_SUPPORT_LONG_LONG
+                } else if (m.flags.longlong == 2) {
+                    ok = prv_token_varint(frame, len, va_arg(*arg, unsigned long long int));
+#endif /* LWPRINTF_CFG_SUPPORT_LONG_LONG */
+                }
+                break;
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_INT */
+#if LWPRINTF_CFG_SUPPORT_TYPE_STRING
+            case 's': {
+                const char* s = va_arg(*arg, const char*);
+
+                s = s != NULL ? s : "(null)";
+                ok = prv_token_raw(frame, len, s, strlen(s) + 1);
+                break;
+            }
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_STRING */
+#if LWPRINTF_CFG_SUPPORT_TYPE_POINTER
+            case 'p': ok = prv_token_varint(frame, len, va_arg(*arg, uintptr_t)); break;
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_POINTER */
+#if LWPRINTF_CFG_SUPPORT_TYPE_FLOAT
+            case 'f':
+            case 'F':
+#if LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING */
+#if LWPRINTF_CFG_SUPPORT_TYPE_FLOAT_HEX
+            case 'a':
+            case 'A':
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FLOAT_HEX */
+#if SI_FLOAT
+            case 'y':
+#endif /* SI_FLOAT */
+            {
+                const lwprintf_packed_float_t v = (lwprintf_packed_float_t)va_arg(*arg, double);
+
+                ok = prv_token_raw(frame, len, &v, sizeof(v));
+                break;
+            }
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FLOAT */
+#if LWPRINTF_CFG_SUPPORT_TYPE_FIXED || LWPRINTF_CFG_SUPPORT_TYPE_SI
+#if LWPRINTF_CFG_SUPPORT_TYPE_FIXED
+            case 'q':
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FIXED */
+#if LWPRINTF_CFG_SUPPORT_TYPE_SI
+            case 'Y':
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_SI */
+                if (m.flags.longlong == 0) {
+                    ok = prv_token_svarint(frame, len, va_arg(*arg, signed int));
+                } else if (m.flags.longlong == 1) {
+                    ok = prv_token_svarint(frame, len, va_arg(*arg, signed long int));
+#if LWPRINTF_CFG_SUPPORT_LONG_LONG
+                } else if (m.flags.longlong == 2) {
+                    ok = prv_token_svarint(frame, len, va_arg(*arg, signed long long int));
+#endif /* LWPRINTF_CFG_SUPPORT_LONG_LONG */
+                }
+                break;
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FIXED || LWPRINTF_CFG_SUPPORT_TYPE_SI */
+            case 'n':
+#if LWPRINTF_CFG_SUPPORT_TYPE_STRING_ESCAPE
+            case 'J':
+            case 'C':
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_STRING_ESCAPE */
+#if LWPRINTF_CFG_SUPPORT_TYPE_BYTE_ARRAY
+            case 'k':
+            case 'K':
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_BYTE_ARRAY */
+#if LWPRINTF_CFG_SUPPORT_TYPE_BASE64
+            case 'r':
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_BASE64 */
+#if LWPRINTF_CFG_SUPPORT_TYPE_HEXDUMP
+            case 'H':
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_HEXDUMP */
+                (void)va_arg(*arg, const void*); /* Not encoded, decoder shows `?` */
+                break;
+            default: break;
+        }
+        fmt = prv_spec_next(fmt);
+    }
+    return ok;
+}
+
+/**
+ * \brief           Send tokenized frame instead of formatted text
+ *
+ * Frame is length of the rest of the frame as variable length number,
+ * `32-bit` address of format string in little endian order and encoded arguments.
+ * Terminating `NULL` character after the frame is an empty frame for the decoder.
+ *
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in]       arg: Variable parameters list
+ * \return          Length of the frame, `0` if it was dropped
+ */
+static int
+prv_token_print(lwprintf_int_t* lwi, va_list arg) {
+    unsigned char frame[LWPRINTF_CFG_TOKEN_FRAME_SIZE];
+    /* Upper bits of 64-bit address are not sent, format strings must be placed below 4 GB to keep tokens unique */
+    const uint32_t id = (uint32_t)(uintptr_t)lwi->fmt;
+    size_t len = 3, start;
+    va_list ap;
+    uint8_t ok;
+
+    /* Length is written in front of the payload, when payload is complete */
+    for (size_t i = 0; i < 4; ++i) {
+        frame[len++] = (unsigned char)(id >> (8 * i));
+    }
+    va_copy(ap, arg);
+    ok = prv_token_args(frame, &len, lwi->fmt, &ap);
+    va_end(ap);
+    if (!ok || len - 3 > 0x3FFF) {
+        return 0;
+    }
+    start = len - 3 > 0x7F ? 1 : 2;
+    frame[start] = (unsigned char)((len - 3) | (start == 1 ? 0x80 : 0x00));
+    if (start == 1) {
+        frame[2] = (unsigned char)((len - 3) >> 7);
+    }
+
+#if LWPRINTF_CFG_OS && !LWPRINTF_CFG_OS_MANUAL_PROTECT
+    if (!prv_mutex_wait(lwi->lwobj)) {
+        return 0;
+    }
+#endif /* LWPRINTF_CFG_OS && !LWPRINTF_CFG_OS_MANUAL_PROTECT */
+    prv_out_str_raw(lwi, (const char*)&frame[start], len - start);
+    prv_format_end(lwi);
+#if LWPRINTF_CFG_OS && !LWPRINTF_CFG_OS_MANUAL_PROTECT
+    prv_mutex_release(lwi->lwobj);
+#endif /* LWPRINTF_CFG_OS && !LWPRINTF_CFG_OS_MANUAL_PROTECT */
+    return lwi->is_print_cancelled ? 0 : (int)(len - start);
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_TOKEN */
+
+#if LWPRINTF_CFG_ENABLE_CBOR
+
+/* Major types of CBOR data items */
+#define CBOR_MAJOR_UINT  0
+#define CBOR_MAJOR_NINT  1
+#define CBOR_MAJOR_BYTES 2
+#define CBOR_MAJOR_TEXT  3
+#define CBOR_MAJOR_ARRAY 4
+#define CBOR_MAJOR_MAP   5
+#define CBOR_MAJOR_TAG   6
+
+#define CBOR_NULL      0xF6 /*!< Simple value `null`, for `NULL` pointer argument */
+#define CBOR_FLOAT32   0xFA /*!< Head of single precision float */
+#define CBOR_FLOAT64   0xFB /*!< Head of double precision float */
+#define CBOR_BIGFLOAT  5    /*!< Tag of `[exponent, mantissa]` array, value is `mantissa * 2^exponent` */
+
+/**
+ * \brief           Append raw bytes to CBOR frame
+ * \param[in,out]   frame: Frame buffer
+ * \param[in,out]   len: Current length of frame
+ * \param[in]       data: Data to append
+ * \param[in]       data_len: Length of data
+ * \return          `1` on success, `0` if frame is full
+ */
+static uint8_t
+prv_cbor_raw(unsigned char* frame, size_t* len, const void* data, size_t data_len) {
+    if (data_len > LWPRINTF_CFG_CBOR_FRAME_SIZE - *len) {
+        return 0;
+    }
+    memcpy(&frame[*len], data, data_len);
+    *len += data_len;
+    return 1;
+}
+
+/**
+ * \brief           Encode head of CBOR data item, with argument in the shortest form
+ * \param[out]      head: Head buffer, at least `9` bytes long
+ * \param[in]       major: Major type of data item
+ * \param[in]       val: Argument of data item, value, length or number of items
+ * \return          Length of head in units of bytes
+ */
+static size_t
+prv_cbor_head_enc(unsigned char* head, uint8_t major, uint_maxtype_t val) {
+    size_t bytes = 1;
+
+    if (val < 24) {
+        head[0] = (unsigned char)((major << 5) | (uint8_t)val);
+        return 1;
+    }
+    for (uint_maxtype_t rest = val >> 8; rest > 0; rest >>= 8) {
+        ++bytes;
+    }
+    bytes = bytes > 4 ? 8 : (bytes > 2 ? 4 : bytes); /* Argument has 1, 2, 4 or 8 bytes */
+    head[0] = (unsigned char)((major << 5) | (bytes == 1 ? 24 : (bytes == 2 ? 25 : (bytes == 4 ? 26 : 27))));
+    for (size_t i = 0; i < bytes; ++i) {
+        head[1 + i] = (unsigned char)(val >> (8 * (bytes - 1 - i))); /* Big endian */
+    }
+    return 1 + bytes;
+}
+
+/**
+ * \brief           Append head of CBOR data item to frame
+ * \param[in,out]   frame: Frame buffer
+ * \param[in,out]   len: Current length of frame
+ * \param[in]       major: Major type of data item
+ * \param[in]       val: Argument of data item
+ * \return          `1` on success, `0` if frame is full
+ */
+static uint8_t
+prv_cbor_head(unsigned char* frame, size_t* len, uint8_t major, uint_maxtype_t val) {
+    unsigned char head[9];
+
+    return prv_cbor_raw(frame, len, head, prv_cbor_head_enc(head, major, val));
+}
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_INT || LWPRINTF_CFG_SUPPORT_TYPE_FIXED || LWPRINTF_CFG_SUPPORT_TYPE_SI
+
+/**
+ * \brief           Append signed integer to CBOR frame
+ * \param[in,out]   frame: Frame buffer
+ * \param[in,out]   len: Current length of frame
+ * \param[in]       val: Value to append
+ * \return          `1` on success, `0` if frame is full
+ */
+static uint8_t
+prv_cbor_int(unsigned char* frame, size_t* len, int_maxtype_t val) {
+    /* Negative number `n` is encoded as `-1 - n` */
+    return val < 0 ? prv_cbor_head(frame, len, CBOR_MAJOR_NINT, ~(uint_maxtype_t)val)
+                   : prv_cbor_head(frame, len, CBOR_MAJOR_UINT, (uint_maxtype_t)val);
+}
+
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_INT || LWPRINTF_CFG_SUPPORT_TYPE_FIXED || LWPRINTF_CFG_SUPPORT_TYPE_SI */
+
+/**
+ * \brief           Append text or byte string to CBOR frame
+ * \param[in,out]   frame: Frame buffer
+ * \param[in,out]   len: Current length of frame
+ * \param[in]       major: \ref CBOR_MAJOR_TEXT or \ref CBOR_MAJOR_BYTES
+ * \param[in]       data: String data, `NULL` to append `null` value
+ * \param[in]       data_len: Length of string
+ * \return          `1` on success, `0` if frame is full
+ */
+static uint8_t
+prv_cbor_str(unsigned char* frame, size_t* len, uint8_t major, const void* data, size_t data_len) {
+    const unsigned char null_val = CBOR_NULL;
+
+    if (data == NULL) {
+        return prv_cbor_raw(frame, len, &null_val, 1);
+    }
+    return prv_cbor_head(frame, len, major, data_len) && prv_cbor_raw(frame, len, data, data_len);
+}
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_FLOAT
+
+/**
+ * \brief           Append floating point number to CBOR frame.
+ * Number is sent in single precision, when conversion does not lose any information
+ * \param[in,out]   frame: Frame buffer
+ * \param[in,out]   len: Current length of frame
+ * \param[in]       val: Value to append
+ * \return          `1` on success, `0` if frame is full
+ */
+static uint8_t
+prv_cbor_float(unsigned char* frame, size_t* len, double val) {
+    unsigned char buff[9];
+    size_t bytes;
+
+    if (val != val || val - val != 0 || (val >= -FLT_MAX && val <= FLT_MAX && (double)(float)val == val)) {
+        const float f = (float)val;
+        uint32_t bits;
+
+        memcpy(&bits, &f, sizeof(bits));
+        buff[0] = CBOR_FLOAT32;
+        bytes = 4;
+        for (size_t i = 0; i < bytes; ++i) {
+            buff[1 + i] = (unsigned char)(bits >> (8 * (bytes - 1 - i)));
+        }
+    } else {
+        uint64_t bits;
+
+        memcpy(&bits, &val, sizeof(bits));
+        buff[0] = CBOR_FLOAT64;
+        bytes = 8;
+        for (size_t i = 0; i < bytes; ++i) {
+            buff[1 + i] = (unsigned char)(bits >> (8 * (bytes - 1 - i)));
+        }
+    }
+    return prv_cbor_raw(frame, len, buff, 1 + bytes);
+}
+
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FLOAT */
+
+/**
+ * \brief           Append key of map entry, from literal text before the specifier.
+ *
+ * Separators before the name and assignment characters after it are not part of the key.
+ * When nothing is left, index of the entry is used as integer key
+ *
+ * \param[in,out]   frame: Frame buffer
+ * \param[in,out]   len: Current length of frame
+ * \param[in]       lit: Start of literal text
+ * \param[in]       end: End of literal text, pointing to `%` character
+ * \param[in]       idx: Index of the entry in the map
+ * \return          `1` on success, `0` if frame is full
+ */
+static uint8_t
+prv_cbor_key(unsigned char* frame, size_t* len, const char* lit, const char* end, size_t idx) {
+    while (lit < end && (*lit == ' ' || *lit == ',' || *lit == ';' || *lit == '\t' || *lit == '\r' || *lit == '\n')) {
+        ++lit;
+    }
+    while (end > lit && (end[-1] == ' ' || end[-1] == '=' || end[-1] == ':' || end[-1] == '\t')) {
+        --end;
+    }
+    if (lit == end) {
+        return prv_cbor_head(frame, len, CBOR_MAJOR_UINT, idx);
+    }
+    return prv_cbor_str(frame, len, CBOR_MAJOR_TEXT, lit, (size_t)(end - lit));
+}
+
+/**
+ * \brief           Encode entries of CBOR map, with the same specifier parser as formatting
+ *
+ * Integers are encoded as CBOR integers, floating point numbers as floats, strings and characters
+ * as text strings, byte array, hexdump and base64 input as byte strings. Fixed-point numbers
+ * are encoded as exact big float. Other arguments are skipped without map entry.
+ *
+ * \param[in,out]   frame: Frame buffer
+ * \param[in,out]   len: Current length of frame
+ * \param[in]       format: Format string
+ * \param[in]       arg: Pointer to variable argument list
+ * \param[out]      cnt: Number of map entries
+ * \return          `1` on success, `0` if frame is full
+ */
+static uint8_t
+prv_cbor_args(unsigned char* frame, size_t* len, const char* format, va_list* arg, size_t* cnt) {
+    const char *fmt = format, *lit = format;
+    format_spec_t m;
+    uint8_t star, ok = 1;
+
+    *cnt = 0;
+    while (ok && *fmt != '\0') {
+        const char* lit_end = fmt;
+        size_t entry_len = *len;
+        uint8_t has_value = 1;
+
+        if (*fmt++ != '%') {
+            continue;
+        }
+        fmt = prv_parse_spec(&m, fmt, &star);
+        if (star & SPEC_STAR_WIDTH) {
+            m.width = va_arg(*arg, int);
+        }
+        if (star & SPEC_STAR_PRECISION) {
+            m.precision = va_arg(*arg, int);
+        }
+        if (*fmt == '\0') {
+            break;
+        }
+#if LWPRINTF_CFG_SUPPORT_TYPE_ARRAY
+        if (m.flags.array) {
+            (void)va_arg(*arg, int);
+            (void)va_arg(*arg, const void*);
+            fmt = prv_spec_next(fmt);
+            lit = fmt;
+            continue;
+        }
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ARRAY */
+        ok = prv_cbor_key(frame, len, lit, lit_end, *cnt);
+
+        /* Types must follow arguments read in prv_format function */
+        switch (*fmt) {
+            case 'c': {
+                const char c = (char)va_arg(*arg, int);
+
+                ok = ok && prv_cbor_str(frame, len, CBOR_MAJOR_TEXT, &c, 1);
+                break;
+            }
+#if LWPRINTF_CFG_SUPPORT_TYPE_INT
+            case 'd':
+            case 'i':
+                if (m.flags.longlong == 0) {
+                    ok = ok && prv_cbor_int(frame, len, va_arg(*arg, signed int));
+                } else if (m.flags.longlong == 1) {
+                    ok = ok && prv_cbor_int(frame, len, va_arg(*arg, signed long int));
+#if LWPRINTF_CFG_SUPPORT_LONG_LONG
+                } else if (m.flags.longlong == 2) {
+                    ok = ok && prv_cbor_int(frame, len, va_arg(*arg, signed long long int));
+#endif /* LWPRINTF_CFG_SUPPORT_LONG_LONG */
+                }
+                break;
+            case 'b':
+            case 'B':
+            case 'o':
+            case 'u':
+            case 'x':
+            case 'X':
+                if (m.flags.sz_t) {
+                    ok = ok && prv_cbor_head(frame, len, CBOR_MAJOR_UINT, va_arg(*arg, size_t));
+                } else if (m.flags.umax_t) {
+                    ok = ok && prv_cbor_head(frame, len, CBOR_MAJOR_UINT, va_arg(*arg, uintmax_t));
+                } else if (m.flags.longlong == 0 || *fmt == 'b' || *fmt == 'B') {
+                    ok = ok && prv_cbor_head(frame, len, CBOR_MAJOR_UINT, va_arg(*arg, unsigned int));
+                } else if (m.flags.longlong == 1) {
+                    ok = ok && prv_cbor_head(frame, len, CBOR_MAJOR_UINT, va_arg(*arg, unsigned long int));
+#if LWPRINTF_CFG_SUPPORT_LONG_LONG
+                } else if (m.flags.longlong == 2) {
+                    ok = ok && prv_cbor_head(frame, len, CBOR_MAJOR_UINT, va_arg(*arg, unsigned long long int));
+#endif /* LWPRINTF_CFG_SUPPORT_LONG_LONG */
+                }
+                break;
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_INT */
+#if LWPRINTF_CFG_SUPPORT_TYPE_STRING || LWPRINTF_CFG_SUPPORT_TYPE_STRING_ESCAPE
+#if LWPRINTF_CFG_SUPPORT_TYPE_STRING
+            case 's':
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_STRING */
+#if LWPRINTF_CFG_SUPPORT_TYPE_STRING_ESCAPE
+            case 'J':
+            case 'C':
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_STRING_ESCAPE */
+            {
+                const char* s = va_arg(*arg, const char*);
+                size_t str_len;
+
+                /* Precision limits input characters, escaping is left to the decoder */
+                for (str_len = 0; s != NULL && s[str_len] != '\0'; ++str_len) {
+                    if (m.flags.precision && str_len >= (size_t)m.precision) {
+                        break;
+                    }
+                }
+                ok = ok && prv_cbor_str(frame, len, CBOR_MAJOR_TEXT, s, str_len);
+                break;
+            }
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_STRING || LWPRINTF_CFG_SUPPORT_TYPE_STRING_ESCAPE */
+#if LWPRINTF_CFG_SUPPORT_TYPE_POINTER
+            case 'p': ok = ok && prv_cbor_head(frame, len, CBOR_MAJOR_UINT, va_arg(*arg, uintptr_t)); break;
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_POINTER */
+#if LWPRINTF_CFG_SUPPORT_TYPE_FLOAT
+            case 'f':
+            case 'F':
+#if LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING */
+#if LWPRINTF_CFG_SUPPORT_TYPE_FLOAT_HEX
+            case 'a':
+            case 'A':
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FLOAT_HEX */
+#if SI_FLOAT
+            case 'y':
+#endif /* SI_FLOAT */
+                ok = ok && prv_cbor_float(frame, len, va_arg(*arg, double));
+                break;
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FLOAT */
+#if LWPRINTF_CFG_SUPPORT_TYPE_FIXED || LWPRINTF_CFG_SUPPORT_TYPE_SI
+#if LWPRINTF_CFG_SUPPORT_TYPE_FIXED
+            case 'q':
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FIXED */
+#if LWPRINTF_CFG_SUPPORT_TYPE_SI
+            case 'Y':
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_SI */
+            {
+                int_maxtype_t v = 0;
+
+                if (m.flags.longlong == 0) {
+                    v = va_arg(*arg, signed int);
+                } else if (m.flags.longlong == 1) {
+                    v = va_arg(*arg, signed long int);
+#if LWPRINTF_CFG_SUPPORT_LONG_LONG
+                } else if (m.flags.longlong == 2) {
+                    v = va_arg(*arg, signed long long int);
+#endif /* LWPRINTF_CFG_SUPPORT_LONG_LONG */
+                }
+
+                /* Fixed-point number is exact big float, with negative number of fractional bits as exponent */
+                if (*fmt == 'q' && m.qbits > 0) {
+                    ok = ok && prv_cbor_head(frame, len, CBOR_MAJOR_TAG, CBOR_BIGFLOAT)
+                         && prv_cbor_head(frame, len, CBOR_MAJOR_ARRAY, 2)
+                         && prv_cbor_int(frame, len, -(int_maxtype_t)m.qbits);
+                }
+                ok = ok && prv_cbor_int(frame, len, v);
+                break;
+            }
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FIXED || LWPRINTF_CFG_SUPPORT_TYPE_SI */
+#if LWPRINTF_CFG_SUPPORT_TYPE_BYTE_ARRAY || LWPRINTF_CFG_SUPPORT_TYPE_BASE64 || LWPRINTF_CFG_SUPPORT_TYPE_HEXDUMP
+#if LWPRINTF_CFG_SUPPORT_TYPE_BYTE_ARRAY
+            case 'k':
+            case 'K':
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_BYTE_ARRAY */
+#if LWPRINTF_CFG_SUPPORT_TYPE_BASE64
+            case 'r':
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_BASE64 */
+#if LWPRINTF_CFG_SUPPORT_TYPE_HEXDUMP
+            case 'H':
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_HEXDUMP */
+            {
+                const unsigned char* ptr = va_arg(*arg, const unsigned char*);
+
+                /* Width is length of input array, text encoding of bytes is left to the decoder */
+                ok = ok && prv_cbor_str(frame, len, CBOR_MAJOR_BYTES, ptr, m.width > 0 ? (size_t)m.width : 0);
+                break;
+            }
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_BYTE_ARRAY || LWPRINTF_CFG_SUPPORT_TYPE_BASE64 || ... */
+            case 'n':
+                (void)va_arg(*arg, int*);
+                has_value = 0;
+                break;
+            default: has_value = 0; break;
+        }
+
+        /* Key without value is removed, literal text of the next key starts after the specifier */
+        if (has_value) {
+            ++*cnt;
+        } else {
+            *len = entry_len;
+        }
+        fmt = prv_spec_next(fmt);
+        lit = fmt;
+    }
+    return ok;
+}
+
+/**
+ * \brief           Output function of CBOR mode.
+ * Map is self-delimiting, `NULL` character at the end of formatting is not sent to character output
+ * \param[in]       lwi: LwPRINTF internal instance
+ * \param[in]       chr: Character to send
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_cbor_out_fn(lwprintf_int_t* lwi, const char chr) {
+    if (chr == '\0' && lwi->lwobj->out_fn != NULL) {
+        return 1;
+    }
+    return prv_out_fn_send(lwi, chr);
+}
+
+/**
+ * \brief           Send CBOR map instead of formatted text
+ *
+ * Map has one entry for every argument, with key taken from literal text before its specifier.
+ * Consecutive maps form CBOR sequence, as defined in RFC 8742
+ *
+ * \param[in,out]   lwi: LwPRINTF internal instance
+ * \param[in]       arg: Variable parameters list
+ * \return          Length of the map, `0` if it was dropped
+ */
+static int
+prv_cbor_print(lwprintf_int_t* lwi, va_list arg) {
+    unsigned char frame[LWPRINTF_CFG_CBOR_FRAME_SIZE], head[9];
+    size_t len = 1, cnt, head_len;
+    va_list ap;
+    uint8_t ok;
+
+    /* Map head is written in front of the entries, when number of entries is known */
+    va_copy(ap, arg);
+    ok = prv_cbor_args(frame, &len, lwi->fmt, &ap, &cnt);
+    va_end(ap);
+    head_len = prv_cbor_head_enc(head, CBOR_MAJOR_MAP, cnt);
+    if (!ok || len - 1 + head_len > sizeof(frame)) {
+        return 0;
+    }
+    memmove(&frame[head_len], &frame[1], len - 1);
+    memcpy(frame, head, head_len);
+    len += head_len - 1;
+
+#if LWPRINTF_CFG_OS && !LWPRINTF_CFG_OS_MANUAL_PROTECT
+    if (!prv_mutex_wait(lwi->lwobj)) {
+        return 0;
+    }
+#endif /* LWPRINTF_CFG_OS && !LWPRINTF_CFG_OS_MANUAL_PROTECT */
+    prv_out_str_raw(lwi, (const char*)frame, len);
+    prv_format_end(lwi);
+#if LWPRINTF_CFG_OS && !LWPRINTF_CFG_OS_MANUAL_PROTECT
+    prv_mutex_release(lwi->lwobj);
+#endif /* LWPRINTF_CFG_OS && !LWPRINTF_CFG_OS_MANUAL_PROTECT */
+    return lwi->is_print_cancelled ? 0 : (int)len;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_CBOR */
+
+int
+lwprintf_vprintf_ex(lwprintf_t* const lwobj, const char* format, va_list arg) {
+    lwprintf_int_t fobj = {
+        .lwobj = LWPRINTF_GET_LWOBJ(lwobj),
+        .out_fn = prv_out_fn_print,
+        .out_str_fn = prv_out_str_fn_print,
+        .out_fill_fn = prv_out_fill_fn_print,
+        .fmt = format,
+        .buff = NULL,
+        .buff_max_len = 0,
+    };
+    /* For direct print, output function must be set by user */
+    if (!IS_OUTPUT_SET(fobj.lwobj)) {
+        return 0;
+    }
+#if LWPRINTF_CFG_ENABLE_TOKEN
+    if (fobj.lwobj->token_mode && format != NULL) {
+        fobj.out_fn = prv_out_fn_send; /* Frames are binary, line prefix is not applied */
+        fobj.out_str_fn = prv_out_str_fn_send;
+        return prv_token_print(&fobj, arg);
+    }
+#endif /* LWPRINTF_CFG_ENABLE_TOKEN */
+#if LWPRINTF_CFG_ENABLE_CBOR
+    if (fobj.lwobj->cbor_mode && format != NULL) {
+        fobj.out_fn = prv_cbor_out_fn; /* Map is binary, line prefix is not applied */
+        fobj.out_str_fn = prv_out_str_fn_send;
+        return prv_cbor_print(&fobj, arg);
+    }
+#endif /* LWPRINTF_CFG_ENABLE_CBOR */
+    if (prv_format_print(&fobj, arg)) {
+        return (int)fobj.n_len;
+    }
+    return 0;
+}
+
+/**
+ * \brief           Print formatted data to the output
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       format: C string that contains the text to be written to output
+ * \param[in]       ...: Optional arguments for format string
+ * \return          The number of characters that would have been written if `n` had been sufficiently large,
+ *                      not counting the terminating null character.
+ */
+int
+lwprintf_printf_ex(lwprintf_t* const lwobj, const char* format, ...) {
+    va_list valist;
+    int n_len;
+
+    va_start(valist, format);
+    n_len = lwprintf_vprintf_ex(lwobj, format, valist);
+    va_end(valist);
+
+    return n_len;
+}
+
+#if LWPRINTF_CFG_ENABLE_TOKEN || __DOXYGEN__
+
+/**
+ * \brief           Turn tokenized output mode of the instance on or off
+ *
+ * In tokenized mode, \ref lwprintf_printf_ex and \ref lwprintf_vprintf_ex do not format the text.
+ * They send binary frame with address of format string and encoded arguments,
+ * and return length of the frame. Format strings must be part of the firmware image,
+ * from which `tools/lwprintf_detokenize.py` reconstructs the text.
+ *
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       enable: Set to `1` to send tokenized frames, `0` to send formatted text
+ */
+void
+lwprintf_set_token_mode_ex(lwprintf_t* const lwobj, uint8_t enable) {
+    LWPRINTF_GET_LWOBJ(lwobj)->token_mode = enable ? 1 : 0;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_TOKEN || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_CBOR || __DOXYGEN__
+
+/**
+ * \brief           Turn CBOR output mode of the instance on or off
+ *
+ * In CBOR mode, \ref lwprintf_printf_ex and \ref lwprintf_vprintf_ex do not format the text.
+ * They send one CBOR map per call, with literal text before every specifier as the key
+ * and its argument as the value, and return length of the map.
+ * Tokenized mode has precedence, when both modes are turned on.
+ *
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       enable: Set to `1` to send CBOR maps, `0` to send formatted text
+ */
+void
+lwprintf_set_cbor_mode_ex(lwprintf_t* const lwobj, uint8_t enable) {
+    LWPRINTF_GET_LWOBJ(lwobj)->cbor_mode = enable ? 1 : 0;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_CBOR || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_DEADLINE || __DOXYGEN__
+
+/**
+ * \brief           Print formatted data from variable argument list to the output, within time budget.
+ *
+ * Time is measured from the start of the call, including the wait for the mutex.
+ * Before every character or string is passed to the output, elapsed time is checked.
+ * When budget has run out, output stops, \ref LWPRINTF_CFG_DEADLINE_MARK is printed and rest of the text is lost.
+ * Absolute deadline is passed as difference between the deadline and current time.
+ *
+ * \note            Output function call, that has already started, is not interrupted.
+ *                      Time of the mark and of the staging buffer flush is not limited
+ *
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       time_fn: Timestamp function, it is called before every output
+ * \param[in]       budget: Time budget in units of timestamp function
+ * \param[in]       format: C string that contains the text to be written to output
+ * \param[in]       arg: A value identifying a variable arguments list initialized with `va_start`.
+ *                      `va_list` is a special type defined in `<cstdarg>`.
+ * \return          The number of characters written, not counting the mark and the terminating null character
+ */
+int
+lwprintf_vprintf_deadline_ex(lwprintf_t* const lwobj, lwprintf_timestamp_fn time_fn, uint32_t budget,
+                             const char* format, va_list arg) {
+    lwprintf_int_t fobj = {
+        .lwobj = LWPRINTF_GET_LWOBJ(lwobj),
+        .out_fn = prv_out_fn_print,
+        .out_str_fn = prv_out_str_fn_print,
+        .out_fill_fn = prv_out_fill_fn_print,
+        .fmt = format,
+        .buff = NULL,
+        .buff_max_len = 0,
+        .deadline_time_fn = time_fn,
+        .deadline_budget = budget,
+    };
+    /* For direct print, output function must be set by user */
+    if (!IS_OUTPUT_SET(fobj.lwobj) || time_fn == NULL) {
+        return 0;
+    }
+    fobj.deadline_start = time_fn();
+    if (prv_format_print(&fobj, arg)) {
+        return (int)fobj.n_len;
+    }
+    return 0;
+}
+
+/**
+ * \brief           Print formatted data to the output, within time budget
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       time_fn: Timestamp function, it is called before every output
+ * \param[in]       budget: Time budget in units of timestamp function
+ * \param[in]       format: C string that contains the text to be written to output
+ * \param[in]       ...: Optional arguments for format string
+ * \return          The number of characters written, not counting the mark and the terminating null character
+ * \sa              lwprintf_vprintf_deadline_ex
+ */
+int
+lwprintf_printf_deadline_ex(lwprintf_t* const lwobj, lwprintf_timestamp_fn time_fn, uint32_t budget,
+                            const char* format, ...) {
+    va_list valist;
+    int n_len;
+
+    va_start(valist, format);
+    n_len = lwprintf_vprintf_deadline_ex(lwobj, time_fn, budget, format, valist);
+    va_end(valist);
+
+    return n_len;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_DEADLINE || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_TRY_PRINT || __DOXYGEN__
+
+/**
+ * \brief           Print formatted data to the output, and check that output accepted all of it
+ * \param[in,out]   obj: LwPRINTF instance
+ * \param[out]      n_len: Number of written characters, set on success only
+ * \param[in]       format: C string that contains the text to be written to output
+ * \param[in]       arg: Variable parameters list
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+prv_try_vprintf(lwprintf_t* obj, int* n_len, const char* format, va_list arg) {
+    lwprintf_int_t fobj = {
+        .lwobj = obj,
+        .out_fn = prv_out_fn_print,
+        .out_str_fn = prv_out_str_fn_print,
+        .out_fill_fn = prv_out_fill_fn_print,
+        .fmt = format,
+        .buff = NULL,
+        .buff_max_len = 0,
+    };
+    if (!prv_format_print(&fobj, arg) || fobj.is_print_cancelled) {
+        return 0;
+    }
+    *n_len = (int)fobj.n_len;
+    return 1;
+}
+
+/**
+ * \brief           Print formatted data to the output, and check that output accepted all of it
+ * \param[in,out]   obj: LwPRINTF instance
+ * \param[out]      n_len: Number of written characters, set on success only
+ * \param[in]       format: C string that contains the text to be written to output
+ * \param[in]       ...: Optional arguments for format string
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+prv_try_printf(lwprintf_t* obj, int* n_len, const char* format, ...) {
+    va_list valist;
+    uint8_t res;
+
+    va_start(valist, format);
+    res = prv_try_vprintf(obj, n_len, format, valist);
+    va_end(valist);
+    return res;
+}
+
+/**
+ * \brief           Print formatted data from variable argument list to the output, without waiting.
+ *
+ * Message is dropped, when mutex of the instance is held by other thread,
+ * or when output function does not accept the text.
+ * Number of dropped messages is printed as `[N dropped]` before the text of the next successful call.
+ *
+ * \note            Output function signals full sink by returning `0`, or block output function
+ *                      by returning less than requested length. Text that is already sent stays in the output,
+ *                      complete message is rejected at once only with block output and large enough staging buffer
+ * \note            Counter of dropped messages is modified without the mutex.
+ *                      It is exact, when only one thread at a time calls non-blocking functions of the instance
+ *
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       format: C string that contains the text to be written to output
+ * \param[in]       arg: A value identifying a variable arguments list initialized with `va_start`.
+ *                      `va_list` is a special type defined in `<cstdarg>`.
+ * \return          The number of characters written, not counting the report and the terminating null character,
+ *                      or \ref LWPRINTF_TRY_BUSY if message has been dropped
+ */
+int
+lwprintf_try_vprintf_ex(lwprintf_t* const lwobj, const char* format, va_list arg) {
+    lwprintf_t* obj = LWPRINTF_GET_LWOBJ(lwobj);
+    uint32_t dropped;
+    int n_len = 0;
+
+    /* For direct print, output function must be set by user */
+    if (!IS_OUTPUT_SET(obj)) {
+        return 0;
+    }
+#if LWPRINTF_CFG_OS_ISR_DEFERRED
+    /* Interrupt does not use the mutex, message is stored to deferred ring buffer */
+    if (lwprintf_sys_is_isr()) {
+        if (lwprintf_vprintf_deferred_ex(obj, format, arg)) {
+            return 0;
+        }
+        ++obj->dropped;
+        return LWPRINTF_TRY_BUSY;
+    }
+#endif /* LWPRINTF_CFG_OS_ISR_DEFERRED */
+#if LWPRINTF_CFG_OS
+    /* Print functions take the mutex again, it is recursive */
+    if (!prv_mutex_trywait(obj)) {
+        ++obj->dropped;
+        return LWPRINTF_TRY_BUSY;
+    }
+#endif /* LWPRINTF_CFG_OS */
+
+    /* Report stays pending, when output does not accept it */
+    dropped = obj->dropped - obj->dropped_reported;
+    if (dropped > 0 && prv_try_printf(obj, &n_len, "[%lu dropped] ", (unsigned long)dropped)) {
+        obj->dropped_reported += dropped;
+        dropped = 0;
+    }
+    if (dropped > 0 || !prv_try_vprintf(obj, &n_len, format, arg)) {
+        ++obj->dropped;
+        n_len = LWPRINTF_TRY_BUSY;
+    }
+#if LWPRINTF_CFG_OS
+    prv_mutex_release(obj);
+#endif /* LWPRINTF_CFG_OS */
+    return n_len;
+}
+
+/**
+ * \brief           Print formatted data to the output, without waiting
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       format: C string that contains the text to be written to output
+ * \param[in]       ...: Optional arguments for format string
+ * \return          The number of characters written, not counting the report and the terminating null character,
+ *                      or \ref LWPRINTF_TRY_BUSY if message has been dropped
+ * \sa              lwprintf_try_vprintf_ex
+ */
+int
+lwprintf_try_printf_ex(lwprintf_t* const lwobj, const char* format, ...) {
+    va_list valist;
+    int n_len;
+
+    va_start(valist, format);
+    n_len = lwprintf_try_vprintf_ex(lwobj, format, valist);
+    va_end(valist);
+
+    return n_len;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_TRY_PRINT || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_RATE_LIMIT || __DOXYGEN__
+
+/**
+ * \brief           Set timestamp function of rate limit, used by \ref lwprintf_printf_limited_ex
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       time_fn: Timestamp function. Set to `NULL` to print all messages
+ */
+void
+lwprintf_set_limit_time_ex(lwprintf_t* const lwobj, lwprintf_timestamp_fn time_fn) {
+    LWPRINTF_GET_LWOBJ(lwobj)->limit_time_fn = time_fn;
+}
+
+/**
+ * \brief           Check if message of the call site is within its rate limit.
+ *
+ * Limit is token bucket of `burst` messages, refilled with one message every `period / burst` time,
+ * kept as theoretical arrival time of the next message only.
+ * Message, that is over the limit, is counted to the call site state.
+ *
+ * \note            State of the call site is modified without the mutex.
+ *                      It is exact, when only one thread at a time prints from the call site
+ *
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in,out]   limit: Rate limit state of the call site
+ * \param[in]       burst: Number of messages printed at once, after quiet time
+ * \param[in]       period: Time of `burst` messages, in units of timestamp function
+ * \return          `1` if message shall be printed, `0` otherwise
+ */
+uint8_t
+lwprintf_limit_check_ex(lwprintf_t* const lwobj, lwprintf_limit_t* limit, uint32_t burst, uint32_t period) {
+    lwprintf_t* obj = LWPRINTF_GET_LWOBJ(lwobj);
+    uint32_t now, interval;
+
+    if (obj->limit_time_fn == NULL) {
+        return 1;
+    }
+    if (burst == 0) {
+        ++limit->suppressed;
+        return 0;
+    }
+    now = obj->limit_time_fn();
+    interval = period / burst;
+    if (!limit->is_started) {
+        limit->tat = now;
+        limit->is_started = 1;
+    }
+
+    /* Bucket is full, when arrival time is in the past. Every message moves it one interval forward */
+    if ((int32_t)(limit->tat - now) > (int32_t)(period - interval)) {
+        ++limit->suppressed;
+        return 0;
+    }
+    limit->tat = ((int32_t)(limit->tat - now) > 0 ? limit->tat : now) + interval;
+    return 1;
+}
+
+/**
+ * \brief           Print formatted data from variable argument list to the output,
+ *                  after the number of messages, suppressed by the call site
+ *
+ * Number of suppressed messages is printed as `[suppressed N messages] ` before the text, with mutex held once
+ *
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in,out]   limit: Rate limit state of the call site
+ * \param[in]       format: C string that contains the text to be written to output
+ * \param[in]       arg: A value identifying a variable arguments list initialized with `va_start`.
+ *                      `va_list` is a special type defined in `<cstdarg>`.
+ * \return          The number of characters written, not counting the report and the terminating null character
+ */
+int
+lwprintf_limit_vprintf_ex(lwprintf_t* const lwobj, lwprintf_limit_t* limit, const char* format, va_list arg) {
+    lwprintf_t* obj = LWPRINTF_GET_LWOBJ(lwobj);
+    int n_len;
+#if LWPRINTF_CFG_OS
+    uint8_t is_locked = 1;
+
+#if LWPRINTF_CFG_OS_ISR_DEFERRED
+    is_locked = !lwprintf_sys_is_isr(); /* Interrupt stores both messages to deferred ring buffer */
+#endif                                  /* LWPRINTF_CFG_OS_ISR_DEFERRED */
+    /* Print functions take the mutex again, it is recursive */
+    if (is_locked && !prv_mutex_wait(obj)) {
+        return 0;
+    }
+#endif /* LWPRINTF_CFG_OS */
+
+    if (limit->suppressed > 0) {
+        lwprintf_printf_ex(obj, "[suppressed %lu messages] ", (unsigned long)limit->suppressed);
+        limit->suppressed = 0;
+    }
+    n_len = lwprintf_vprintf_ex(obj, format, arg);
+#if LWPRINTF_CFG_OS
+    if (is_locked) {
+        prv_mutex_release(obj);
+    }
+#endif /* LWPRINTF_CFG_OS */
+    return n_len;
+}
+
+/**
+ * \brief           Print formatted data to the output, after the number of messages, suppressed by the call site
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in,out]   limit: Rate limit state of the call site
+ * \param[in]       format: C string that contains the text to be written to output
+ * \param[in]       ...: Optional arguments for format string
+ * \return          The number of characters written, not counting the report and the terminating null character
+ * \sa              lwprintf_limit_vprintf_ex
+ */
+int
+lwprintf_limit_printf_ex(lwprintf_t* const lwobj, lwprintf_limit_t* limit, const char* format, ...) {
+    va_list valist;
+    int n_len;
+
+    va_start(valist, format);
+    n_len = lwprintf_limit_vprintf_ex(lwobj, limit, format, valist);
+    va_end(valist);
+
+    return n_len;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_RATE_LIMIT || __DOXYGEN__ */
+
+/**
+ * \brief           Write formatted data from variable argument list to sized buffer
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       s_out: Pointer to a buffer where the resulting C-string is stored.
+ *                      The buffer should have a size of at least `n` characters
+ * \param[in]       n_maxlen: Maximum number of bytes to be used in the buffer.
+ *                      The generated string has a length of at most `n - 1`,
+ *                      leaving space for the additional terminating null character
+ * \param[in]       format: C string that contains a format string that follows the same specifications as format in printf
+ * \param[in]       arg: A value identifying a variable arguments list initialized with `va_start`.
+ *                      `va_list` is a special type defined in `<cstdarg>`.
+ * \return          The number of characters that would have been written if `n` had been sufficiently large,
+ *                      not counting the terminating null character.
+ */
+int
+lwprintf_vsnprintf_ex(lwprintf_t* const lwobj, char* s_out, size_t n_maxlen, const char* format, va_list arg) {
+    lwprintf_int_t fobj = {
+        .lwobj = LWPRINTF_GET_LWOBJ(lwobj),
+        .out_fn = prv_out_fn_write_buff,
+        .out_str_fn = prv_out_str_fn_write_buff,
+        .out_fill_fn = prv_out_fill_fn_write_buff,
+        .fmt = format,
+        .buff = s_out,
+        .buff_max_len = (s_out != NULL && n_maxlen > 0) ? (n_maxlen - 1) : 0,
+    };
+    if (fobj.buff_max_len == 0) {
+        prv_set_measure_mode(&fobj); /* Nothing can be written, only length is calculated */
+    }
+    if (!prv_format(&fobj, arg)) {
+        fobj.n_len = 0;
+    }
+
+    /* Terminate string only once, at the end of written or truncated output */
+    if (s_out != NULL && n_maxlen > 0) {
+        s_out[fobj.n_len < fobj.buff_max_len ? fobj.n_len : fobj.buff_max_len] = '\0';
+    }
+    return (int)fobj.n_len;
+}
+
+/**
+ * \brief           Write formatted data from variable argument list to sized buffer
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       s_out: Pointer to a buffer where the resulting C-string is stored.
+ *                      The buffer should have a size of at least `n` characters
+ * \param[in]       n_maxlen: Maximum number of bytes to be used in the buffer.
+ *                      The generated string has a length of at most `n - 1`,
+ *                      leaving space for the additional terminating null character
+ * \param[in]       format: C string that contains a format string that follows the same specifications as format in printf
+ * \param[in]       ...: Optional arguments for format string
+ * \return          The number of characters that would have been written if `n` had been sufficiently large,
+ *                      not counting the terminating null character.
+ */
+int
+lwprintf_snprintf_ex(lwprintf_t* const lwobj, char* s_out, size_t n_maxlen, const char* format, ...) {
+    va_list valist;
+    int len;
+
+    va_start(valist, format);
+    len = lwprintf_vsnprintf_ex(lwobj, s_out, n_maxlen, format, valist);
+    va_end(valist);
+
+    return len;
+}
+
+/**
+ * \brief           Calculate length of formatted data from variable argument list, without writing it.
+ *
+ * Lengths are calculated per specifier, characters are not generated.
+ * Result is the same as of \ref lwprintf_vsnprintf_ex with `NULL` buffer, that uses this mode too.
+ *
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       format: C string that contains a format string that follows the same specifications as format in printf
+ * \param[in]       arg: A value identifying a variable arguments list initialized with `va_start`.
+ *                      `va_list` is a special type defined in `<cstdarg>`.
+ * \return          The number of characters that would have been written, not counting the terminating null character.
+ */
+int
+lwprintf_vmeasure_ex(lwprintf_t* const lwobj, const char* format, va_list arg) {
+    return lwprintf_vsnprintf_ex(lwobj, NULL, 0, format, arg);
+}
+
+/**
+ * \brief           Calculate length of formatted data, without writing it
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       format: C string that contains a format string that follows the same specifications as format in printf
+ * \param[in]       ...: Optional arguments for format string
+ * \return          The number of characters that would have been written, not counting the terminating null character.
+ * \sa              lwprintf_vmeasure_ex
+ */
+int
+lwprintf_measure_ex(lwprintf_t* const lwobj, const char* format, ...) {
+    va_list valist;
+    int len;
+
+    va_start(valist, format);
+    len = lwprintf_vmeasure_ex(lwobj, format, valist);
+    va_end(valist);
+
+    return len;
+}
+
+#if LWPRINTF_CFG_ENABLE_SCANF || __DOXYGEN__
+
+/* White space character, as `isspace` in C locale */
+#define SCAN_IS_SPACE(x) ((x) == ' ' || ((x) >= '\t' && (x) <= '\r'))
+
+/**
+ * \brief           Length modifier of parsed argument
+ */
+typedef enum {
+    SCAN_LEN_NONE = 0x00, /*!< No modifier, `int`, `unsigned int` or `float` */
+    SCAN_LEN_HH,          /*!< `hh` modifier, `char` */
+    SCAN_LEN_H,           /*!< `h` modifier, `short` */
+    SCAN_LEN_L,           /*!< `l` modifier, `long` or `double` */
+    SCAN_LEN_LL,          /*!< `ll` modifier, `long long` */
+    SCAN_LEN_J,           /*!< `j` modifier, `intmax_t` */
+    SCAN_LEN_Z,           /*!< `z` modifier, `size_t` */
+    SCAN_LEN_T,           /*!< `t` modifier, `ptrdiff_t` */
+    SCAN_LEN_LD,          /*!< `L` modifier, `long double` */
+} scan_len_t;
+
+#if LWPRINTF_CFG_SCANF_SUPPORT_TYPE_INT
+
+/**
+ * \brief           Get value of digit character
+ * \param[in]       chr: Character to check
+ * \param[in]       base: Number base
+ * \return          Digit value, or `base` when character is not a digit of the base
+ */
+static unsigned
+prv_scan_digit(char chr, unsigned base) {
+    unsigned d;
+
+    if (CHARISNUM(chr)) {
+        d = (unsigned)CHARTONUM(chr);
+    } else if ((chr | 0x20) >= 'a' && (chr | 0x20) <= 'z') {
+        d = (unsigned)((chr | 0x20) - 'a' + 10);
+    } else {
+        return base;
+    }
+    return d < base ? d : base;
+}
+
+/**
+ * \brief           Parse integer number with optional sign and `0x` prefix
+ * \param[in,out]   str: Pointer to input string, moved after the number on success
+ * \param[in]       width: Maximum number of characters to read
+ * \param[in]       base: Number base. Set to `0` to select it from prefix, as `%i` does
+ * \param[out]      val: Parsed value, `-` sign negates it in unsigned arithmetic, as `strtoul` does
+ * \return          `1` when at least one digit has been parsed, `0` otherwise
+ */
+static uint8_t
+prv_scan_int(const char** str, size_t width, unsigned base, uint_maxtype_t* val) {
+    const char* s = *str;
+    uint_maxtype_t v = 0;
+    uint8_t is_negative = 0, has_digits = 0;
+    unsigned d;
+
+    if (width > 0 && (*s == '-' || *s == '+')) {
+        is_negative = *s == '-';
+        ++s;
+        --width;
+    }
+
+    /* Prefix is skipped only when hexadecimal digit follows, otherwise `0` is the number */
+    if ((base == 0 || base == 16) && width > 2 && s[0] == '0' && (s[1] | 0x20) == 'x'
+        && prv_scan_digit(s[2], 16) < 16) {
+        s += 2;
+        width -= 2;
+        base = 16;
+    } else if (base == 0) {
+        base = *s == '0' ? 8 : 10;
+    }
+    for (; width > 0 && (d = prv_scan_digit(*s, base)) < base; ++s, --width) {
+        v = v * base + d;
+        has_digits = 1;
+    }
+    if (!has_digits) {
+        return 0;
+    }
+    *val = is_negative ? (uint_maxtype_t)0 - v : v;
+    *str = s;
+    return 1;
+}
+
+/**
+ * \brief           Store integer to the argument of selected length.
+ * Signed and unsigned types of the same size share the representation
+ * \param[out]      ptr: Pointer to the argument
+ * \param[in]       len: Length modifier
+ * \param[in]       val: Value to store
+ */
+static void
+prv_scan_store_int(void* ptr, scan_len_t len, uint_maxtype_t val) {
+    switch (len) {
+        case SCAN_LEN_HH: *(unsigned char*)ptr = (unsigned char)val; break;
+        case SCAN_LEN_H: *(unsigned short*)ptr = (unsigned short)val; break;
+        case SCAN_LEN_L: *(unsigned long*)ptr = (unsigned long)val; break;
+#if LWPRINTF_CFG_SUPPORT_LONG_LONG
+        case SCAN_LEN_LL: *(unsigned long long*)ptr = (unsigned long long)val; break;
+        case SCAN_LEN_J: *(uintmax_t*)ptr = (uintmax_t)val; break;
+#endif /* LWPRINTF_CFG_SUPPORT_LONG_LONG */
+        case SCAN_LEN_Z: *(size_t*)ptr = (size_t)val; break;
+        case SCAN_LEN_T: *(ptrdiff_t*)ptr = (ptrdiff_t)val; break;
+        default: *(unsigned int*)ptr = (unsigned int)val; break;
+    }
+}
+
+#endif /* LWPRINTF_CFG_SCANF_SUPPORT_TYPE_INT */
+
+#if LWPRINTF_CFG_SCANF_SUPPORT_TYPE_FLOAT
+
+/* Significant digits of the mantissa, more digits only change the exponent */
+#define SCAN_FLOAT_DIGITS ((int)LWPRINTF_ARRAYSIZE(powers_of_10) - 1)
+
+/**
+ * \brief           Scale number by power of 10, with tables of the formatter
+ * \param[in]       val: Number to scale
+ * \param[in]       exp: Decimal exponent
+ * \return          Scaled number
+ */
+static float_type_t
+prv_scan_scale(float_type_t val, int exp) {
+    const uint8_t is_negative = exp < 0;
+
+    exp = is_negative ? -exp : exp;
+    while (exp > 0 && val != 0 && val <= FLOAT_TYPE_MAX) {
+#if FLOAT_IEEE754
+        /* 10^x = pwr10_hi[x / 16] * pwr10_lo[x % 16], factors are applied one by one not to overflow */
+        const int k = exp < 16 * (int)LWPRINTF_ARRAYSIZE(pwr10_hi) ? exp : 16 * (int)LWPRINTF_ARRAYSIZE(pwr10_hi) - 1;
+
+        if (is_negative) {
+            val = val / pwr10_lo[k % 16] / pwr10_hi[k / 16];
+        } else {
+            val = val * pwr10_lo[k % 16] * pwr10_hi[k / 16];
+        }
+#else  /* FLOAT_IEEE754 */
+        const int k = exp < SCAN_FLOAT_DIGITS ? exp : SCAN_FLOAT_DIGITS;
+
+        if (is_negative) {
+            val /= (float_type_t)powers_of_10[k];
+        } else {
+            val *= (float_type_t)powers_of_10[k];
+        }
+#endif /* !FLOAT_IEEE754 */
+        exp -= k;
+    }
+    return val;
+}
+
+/**
+ * \brief           Parse floating-point number in decimal notation, with optional exponent
+ * \param[in,out]   str: Pointer to input string, moved after the number on success
+ * \param[in]       width: Maximum number of characters to read
+ * \param[out]      val: Parsed value
+ * \return          `1` when at least one digit has been parsed, `0` otherwise
+ */
+static uint8_t
+prv_scan_float(const char** str, size_t width, float_type_t* val) {
+    const char* s = *str;
+    float_long_t mant = 0;
+    int exp = 0, digits = 0;
+    uint8_t is_negative = 0, has_digits = 0;
+
+    if (width > 0 && (*s == '-' || *s == '+')) {
+        is_negative = *s == '-';
+        ++s;
+        --width;
+    }
+    for (; width > 0 && CHARISNUM(*s); ++s, --width) {
+        has_digits = 1;
+        if (digits < SCAN_FLOAT_DIGITS) {
+            mant = mant * 10 + CHARTONUM(*s);
+            digits += mant > 0;
+        } else {
+            ++exp;
+        }
+    }
+    if (width > 0 && *s == '.') {
+        for (++s, --width; width > 0 && CHARISNUM(*s); ++s, --width) {
+            has_digits = 1;
+            if (digits < SCAN_FLOAT_DIGITS) {
+                mant = mant * 10 + CHARTONUM(*s);
+                digits += mant > 0;
+                --exp;
+            }
+        }
+    }
+    if (!has_digits) {
+        return 0;
+    }
+
+    /* Exponent is part of the number only when digit follows */
+    if (width > 1 && (*s | 0x20) == 'e') {
+        const char* e = s + 1;
+        uint8_t is_exp_negative = 0;
+        int e_val = 0;
+
+        --width;
+        if (width > 1 && (*e == '-' || *e == '+')) {
+            is_exp_negative = *e == '-';
+            ++e;
+            --width;
+        }
+        if (CHARISNUM(*e)) {
+            for (; width > 0 && CHARISNUM(*e); ++e, --width) {
+                e_val = e_val < 10000 ? e_val * 10 + CHARTONUM(*e) : e_val;
+            }
+            exp += is_exp_negative ? -e_val : e_val;
+            s = e;
+        }
+    }
+    *val = prv_scan_scale((float_type_t)mant, exp);
+    *val = is_negative ? -*val : *val;
+    *str = s;
+    return 1;
+}
+
+#endif /* LWPRINTF_CFG_SCANF_SUPPORT_TYPE_FLOAT */
+
+#if LWPRINTF_CFG_SCANF_SUPPORT_TYPE_SCANSET
+
+/**
+ * \brief           Check if character belongs to the set of `%[` specifier
+ * \param[in]       set: First character of the set, after optional `^`
+ * \param[in]       set_end: Closing `]` of the set
+ * \param[in]       chr: Character to check
+ * \return          `1` if character is in the set, `0` otherwise
+ */
+static uint8_t
+prv_scan_in_set(const char* set, const char* set_end, char chr) {
+    for (const char* p = set; p < set_end; ++p) {
+        /* Dash between two characters is range, at the start or end of the set it is regular character */
+        if (p[1] == '-' && p + 2 < set_end) {
+            if ((unsigned char)chr >= (unsigned char)p[0] && (unsigned char)chr <= (unsigned char)p[2]) {
+                return 1;
+            }
+            p += 2;
+        } else if (*p == chr) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+#endif /* LWPRINTF_CFG_SCANF_SUPPORT_TYPE_SCANSET */
+
+/**
+ * \brief           Read formatted data from string, from variable argument list of pointers.
+ *
+ * Function is a subset of C `sscanf`, with the same format string syntax:
+ * white space in format skips any white space of the input, `*` suppresses assignment,
+ * width limits the number of characters, and length modifiers `hh, h, l, ll, j, z, t, L` select argument type.
+ * Modifiers `ll` and `j` fail the conversion, when \ref LWPRINTF_CFG_SUPPORT_LONG_LONG is disabled.
+ *
+ * - `%d, %i, %u, %o, %x` parse integer numbers, `%n` stores number of characters read so far
+ * - `%f, %e, %g` parse floating-point numbers in decimal notation
+ * - `%s` parses word, `%c` parses characters without terminating null character,
+ *     `%[` parses characters from the set
+ *
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       str: Input string
+ * \param[in]       format: C string that contains format string, that follows specifications of `sscanf`
+ * \param[in]       arg: A value identifying a variable arguments list initialized with `va_start`.
+ *                      `va_list` is a special type defined in `<cstdarg>`.
+ * \return          Number of assigned arguments,
+ *                      or `-1` when input ends before the first conversion
+ */
+int
+lwprintf_vsscanf_ex(lwprintf_t* const lwobj, const char* str, const char* format, va_list arg) {
+    const char* s = str;
+    const char* fmt = format;
+    int assigned = 0;
+    uint8_t is_converted = 0;
+
+    LWPRINTF_UNUSED(lwobj);
+    while (*fmt != '\0') {
+        uint8_t is_suppressed = 0, is_ok = 0;
+        scan_len_t len = SCAN_LEN_NONE;
+        size_t width = 0;
+        void* ptr = NULL;
+        char spec;
+
+        /* White space of format matches any amount of white space, including none */
+        if (SCAN_IS_SPACE(*fmt)) {
+            for (; SCAN_IS_SPACE(*fmt); ++fmt) {}
+            for (; SCAN_IS_SPACE(*s); ++s) {}
+            continue;
+        }
+        if (*fmt != '%' || fmt[1] == '%') {
+            if (*fmt == '%') {
+                for (++fmt; SCAN_IS_SPACE(*s); ++s) {}
+            }
+            if (*s != *fmt) {
+                return *s == '\0' && !is_converted ? -1 : assigned;
+            }
+            ++s;
+            ++fmt;
+            continue;
+        }
+
+        /* Specifier: %[*][width][length]type */
+        if (*++fmt == '*') {
+            is_suppressed = 1;
+            ++fmt;
+        }
+        for (; CHARISNUM(*fmt); ++fmt) {
+            width = width * 10 + (size_t)CHARTONUM(*fmt);
+        }
+        switch (*fmt) {
+            case 'h':
+                len = fmt[1] == 'h' ? SCAN_LEN_HH : SCAN_LEN_H;
+                fmt += len == SCAN_LEN_HH ? 2 : 1;
+                break;
+            case 'l':
+                len = fmt[1] == 'l' ? SCAN_LEN_LL : SCAN_LEN_L;
+                fmt += len == SCAN_LEN_LL ? 2 : 1;
+                break;
+            case 'j': len = SCAN_LEN_J; ++fmt; break;
+            case 'z': len = SCAN_LEN_Z; ++fmt; break;
+            case 't': len = SCAN_LEN_T; ++fmt; break;
+            case 'L': len = SCAN_LEN_LD; ++fmt; break;
+            default: break;
+        }
+#if !LWPRINTF_CFG_SUPPORT_LONG_LONG
+        /* Argument of `long long` size cannot be stored, conversion fails */
+        if (len == SCAN_LEN_LL || len == SCAN_LEN_J) {
+            break;
+        }
+#endif /* !LWPRINTF_CFG_SUPPORT_LONG_LONG */
+        spec = *fmt++;
+        if (spec != 'c' && spec != '[' && spec != 'n') {
+            for (; SCAN_IS_SPACE(*s); ++s) {}
+        }
+        if (*s == '\0' && spec != 'n') {
+            return is_converted ? assigned : -1;
+        }
+        if (!is_suppressed) {
+            ptr = va_arg(arg, void*);
+        }
+        switch (spec) {
+#if LWPRINTF_CFG_SCANF_SUPPORT_TYPE_INT
+            case 'd':
+            case 'i':
+            case 'u':
+            case 'o':
+            case 'x':
+            case 'X': {
+                const unsigned base = spec == 'i' ? 0 : (spec == 'o' ? 8 : ((spec | 0x20) == 'x' ? 16 : 10));
+                uint_maxtype_t val;
+
+                is_ok = prv_scan_int(&s, width > 0 ? width : SIZE_MAX, base, &val);
+                if (is_ok && ptr != NULL) {
+                    prv_scan_store_int(ptr, len, val);
+                }
+                break;
+            }
+            case 'n':
+                if (ptr != NULL) {
+                    prv_scan_store_int(ptr, len, (uint_maxtype_t)(s - str));
+                }
+                continue;
+#endif /* LWPRINTF_CFG_SCANF_SUPPORT_TYPE_INT */
+#if LWPRINTF_CFG_SCANF_SUPPORT_TYPE_FLOAT
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G': {
+                float_type_t val;
+
+                is_ok = prv_scan_float(&s, width > 0 ? width : SIZE_MAX, &val);
+                if (is_ok && ptr != NULL) {
+                    if (len == SCAN_LEN_L) {
+                        *(double*)ptr = (double)val;
+                    } else if (len == SCAN_LEN_LD) {
+                        *(long double*)ptr = (long double)val;
+                    } else {
+                        *(float*)ptr = (float)val;
+                    }
+                }
+                break;
+            }
+#endif /* LWPRINTF_CFG_SCANF_SUPPORT_TYPE_FLOAT */
+#if LWPRINTF_CFG_SCANF_SUPPORT_TYPE_STRING
+            case 'c': {
+                size_t n = 0;
+
+                /* All characters must be available, they are not terminated */
+                width = width > 0 ? width : 1;
+                for (; n < width && s[n] != '\0'; ++n) {}
+                is_ok = n == width;
+                if (is_ok) {
+                    if (ptr != NULL) {
+                        memcpy(ptr, s, n);
+                    }
+                    s += n;
+                }
+                break;
+            }
+            case 's': {
+                char* out = ptr;
+
+                width = width > 0 ? width : SIZE_MAX;
+                for (; width > 0 && *s != '\0' && !SCAN_IS_SPACE(*s); ++s, --width) {
+                    if (out != NULL) {
+                        *out++ = *s;
+                    }
+                }
+                if (out != NULL) {
+                    *out = '\0';
+                }
+                is_ok = 1;
+                break;
+            }
+#endif /* LWPRINTF_CFG_SCANF_SUPPORT_TYPE_STRING */
+#if LWPRINTF_CFG_SCANF_SUPPORT_TYPE_SCANSET
+            case '[': {
+                const uint8_t is_negated = *fmt == '^';
+                const char* set = fmt + is_negated;
+                const char* set_end;
+                char* out = ptr;
+                const char* start = s;
+
+                /* Closing bracket as the first character belongs to the set */
+                set_end = set + (*set == ']');
+                for (; *set_end != '\0' && *set_end != ']'; ++set_end) {}
+                if (*set_end == '\0') {
+                    return assigned;
+                }
+                fmt = set_end + 1;
+                width = width > 0 ? width : SIZE_MAX;
+                for (; width > 0 && *s != '\0' && prv_scan_in_set(set, set_end, *s) != is_negated; ++s, --width) {
+                    if (out != NULL) {
+                        *out++ = *s;
+                    }
+                }
+                is_ok = s > start;
+                if (is_ok && out != NULL) {
+                    *out = '\0';
+                }
+                break;
+            }
+#endif /* LWPRINTF_CFG_SCANF_SUPPORT_TYPE_SCANSET */
+            default: break;
+        }
+        if (!is_ok) {
+            break;
+        }
+        is_converted = 1;
+        assigned += ptr != NULL;
+    }
+    return assigned;
+}
+
+/**
+ * \brief           Read formatted data from string
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       str: Input string
+ * \param[in]       format: C string that contains format string, that follows specifications of `sscanf`
+ * \param[in]       ...: Pointers to arguments, that receive parsed values
+ * \return          Number of assigned arguments,
+ *                      or `-1` when input ends before the first conversion
+ * \sa              lwprintf_vsscanf_ex
+ */
+int
+lwprintf_sscanf_ex(lwprintf_t* const lwobj, const char* str, const char* format, ...) {
+    va_list valist;
+    int n;
+
+    va_start(valist, format);
+    n = lwprintf_vsscanf_ex(lwobj, str, format, valist);
+    va_end(valist);
+
+    return n;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_SCANF || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_IOV || __DOXYGEN__
+
+/**
+ * \brief           Format data from variable argument list to array of segments, without copy of strings.
+ *
+ * Literal text points to the format string, `%s` points to the string argument,
+ * and only converted numbers and padding are written to the scratch buffer.
+ * Adjacent data are merged to one segment. Segments are not `NULL` terminated.
+ *
+ * \note            Format string and string arguments must stay valid until segments are sent
+ *
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[out]      iov: Array of segments to fill
+ * \param[in,out]   iov_cnt: Input is number of segments in the array, output is number of used segments
+ * \param[in]       arena: Scratch buffer for converted numbers. Can be `NULL` if `arena_size` is `0`
+ * \param[in]       arena_size: Size of scratch buffer in units of bytes
+ * \param[in]       format: C string that contains a format string that follows the same specifications as format in printf
+ * \param[in]       arg: A value identifying a variable arguments list initialized with `va_start`.
+ *                      `va_list` is a special type defined in `<cstdarg>`.
+ * \return          `1` on success, `0` if segments or scratch buffer are too small
+ */
+uint8_t
+lwprintf_vformat_iov_ex(lwprintf_t* const lwobj, lwprintf_iov_t* iov, size_t* iov_cnt, char* arena, size_t arena_size,
+                        const char* format, va_list arg) {
+    iov_state_t st = {
+        .iov = iov,
+        .iov_max = iov_cnt != NULL ? *iov_cnt : 0,
+        .arena = arena,
+        .arena_size = arena != NULL ? arena_size : 0,
+    };
+    lwprintf_int_t fobj = {
+        .lwobj = LWPRINTF_GET_LWOBJ(lwobj),
+        .out_fn = prv_out_fn_iov,
+        .out_str_fn = prv_out_str_fn_iov,
+        .out_fill_fn = prv_out_fill_fn_iov,
+        .fmt = format,
+        .buff = NULL,
+        .buff_max_len = 0,
+        .iov = &st,
+    };
+    uint8_t res;
+
+    if (iov == NULL || iov_cnt == NULL) {
+        return 0;
+    }
+    res = prv_format(&fobj, arg) && !fobj.is_print_cancelled;
+    *iov_cnt = st.iov_cnt;
+    return res;
+}
+
+/**
+ * \brief           Format data to array of segments, without copy of strings
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[out]      iov: Array of segments to fill
+ * \param[in,out]   iov_cnt: Input is number of segments in the array, output is number of used segments
+ * \param[in]       arena: Scratch buffer for converted numbers. Can be `NULL` if `arena_size` is `0`
+ * \param[in]       arena_size: Size of scratch buffer in units of bytes
+ * \param[in]       format: C string that contains a format string that follows the same specifications as format in printf
+ * \param[in]       ...: Optional arguments for format string
+ * \return          `1` on success, `0` if segments or scratch buffer are too small
+ * \sa              lwprintf_vformat_iov_ex
+ */
+uint8_t
+lwprintf_format_iov_ex(lwprintf_t* const lwobj, lwprintf_iov_t* iov, size_t* iov_cnt, char* arena, size_t arena_size,
+                       const char* format, ...) {
+    va_list valist;
+    uint8_t res;
+
+    va_start(valist, format);
+    res = lwprintf_vformat_iov_ex(lwobj, iov, iov_cnt, arena, arena_size, format, valist);
+    va_end(valist);
+
+    return res;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_IOV || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_STRBUF || __DOXYGEN__
+
+/**
+ * \brief           Initialize string builder with chunks taken from user arena
+ * \param[out]      sb: String builder to initialize
+ * \param[in]       arena: Arena memory, aligned to pointer size. It must stay valid while string builder is used
+ * \param[in]       arena_size: Size of arena in units of bytes
+ * \param[in]       chunk_size: Data size of every chunk in units of bytes. Last chunk may be smaller
+ */
+void
+lwprintf_strbuf_init(lwprintf_strbuf_t* sb, void* arena, size_t arena_size, size_t chunk_size) {
+    memset(sb, 0x00, sizeof(*sb));
+    sb->arena = arena;
+    sb->arena_size = arena != NULL ? arena_size : 0;
+    sb->chunk_size = chunk_size;
+}
+
+/**
+ * \brief           Initialize string builder with chunks taken from user allocator, such as memory pool
+ * \param[out]      sb: String builder to initialize
+ * \param[in]       alloc_fn: Chunk allocator, called with size of chunk header and `chunk_size` bytes of data
+ * \param[in]       free_fn: Chunk release function, called on \ref lwprintf_strbuf_reset. Can be `NULL`
+ * \param[in]       arg: User argument for allocator and release function
+ * \param[in]       chunk_size: Data size of every chunk in units of bytes
+ */
+void
+lwprintf_strbuf_init_alloc(lwprintf_strbuf_t* sb, lwprintf_strbuf_alloc_fn alloc_fn, lwprintf_strbuf_free_fn free_fn,
+                           void* arg, size_t chunk_size) {
+    memset(sb, 0x00, sizeof(*sb));
+    sb->alloc_fn = alloc_fn;
+    sb->free_fn = free_fn;
+    sb->arg = arg;
+    sb->chunk_size = chunk_size;
+}
+
+/**
+ * \brief           Clear text of string builder and release all its chunks
+ * \param[in,out]   sb: String builder
+ */
+void
+lwprintf_strbuf_reset(lwprintf_strbuf_t* sb) {
+    if (sb->alloc_fn != NULL && sb->free_fn != NULL) {
+        for (lwprintf_strbuf_chunk_t *chunk = sb->first, *next; chunk != NULL; chunk = next) {
+            next = chunk->next;
+            sb->free_fn(chunk, sb->arg);
+        }
+    }
+    sb->first = NULL;
+    sb->last = NULL;
+    sb->len = 0;
+    sb->arena_pos = 0;
+    sb->is_full = 0;
+}
+
+/**
+ * \brief           Append formatted data from variable argument list to string builder.
+ *
+ * When memory runs out, text is truncated and `is_full` member is set.
+ * All further append calls are then dropped, until \ref lwprintf_strbuf_reset is called.
+ *
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in,out]   sb: String builder
+ * \param[in]       format: C string that contains a format string that follows the same specifications as format in printf
+ * \param[in]       arg: A value identifying a variable arguments list initialized with `va_start`.
+ *                      `va_list` is a special type defined in `<cstdarg>`.
+ * \return          The number of characters that would have been appended if memory had been sufficient
+ */
+int
+lwprintf_strbuf_vappend_ex(lwprintf_t* const lwobj, lwprintf_strbuf_t* sb, const char* format, va_list arg) {
+    lwprintf_int_t fobj = {
+        .lwobj = LWPRINTF_GET_LWOBJ(lwobj),
+        .out_fn = prv_out_fn_strbuf,
+        .out_str_fn = prv_out_str_fn_strbuf,
+        .out_fill_fn = prv_out_fill_fn_strbuf,
+        .fmt = format,
+        .buff = NULL,
+        .buff_max_len = 0,
+        .sb = sb,
+    };
+
+    if (sb == NULL || !prv_format(&fobj, arg)) {
+        return 0;
+    }
+    return (int)fobj.n_len;
+}
+
+/**
+ * \brief           Append formatted data to string builder
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in,out]   sb: String builder
+ * \param[in]       format: C string that contains a format string that follows the same specifications as format in printf
+ * \param[in]       ...: Optional arguments for format string
+ * \return          The number of characters that would have been appended if memory had been sufficient
+ * \sa              lwprintf_strbuf_vappend_ex
+ */
+int
+lwprintf_strbuf_append_ex(lwprintf_t* const lwobj, lwprintf_strbuf_t* sb, const char* format, ...) {
+    va_list valist;
+    int n_len;
+
+    va_start(valist, format);
+    n_len = lwprintf_strbuf_vappend_ex(lwobj, sb, format, valist);
+    va_end(valist);
+
+    return n_len;
+}
+
+/**
+ * \brief           Copy text of string builder to contiguous buffer
+ * \param[in]       sb: String builder
+ * \param[in]       s_out: Pointer to a buffer where the resulting C-string is stored. Can be `NULL` to get length only
+ * \param[in]       n_maxlen: Maximum number of bytes to be used in the buffer, including terminating null character
+ * \return          Length of text in string builder, not counting the terminating null character
+ */
+size_t
+lwprintf_strbuf_flatten(const lwprintf_strbuf_t* sb, char* s_out, size_t n_maxlen) {
+    size_t pos = 0;
+
+    if (s_out != NULL && n_maxlen > 0) {
+        for (const lwprintf_strbuf_chunk_t* chunk = sb->first; chunk != NULL && pos < n_maxlen - 1;
+             chunk = chunk->next) {
+            size_t cnt = chunk->len < n_maxlen - 1 - pos ? chunk->len : n_maxlen - 1 - pos;
+
+            memcpy(&s_out[pos], chunk->data, cnt);
+            pos += cnt;
+        }
+        s_out[pos] = '\0';
+    }
+    return sb->len;
+}
+
+/**
+ * \brief           Iterate over chunks of string builder, to send text without copy.
+ *
+ * \code{.c}
+ * const lwprintf_strbuf_chunk_t* it = NULL;
+ * const char* data;
+ * size_t len;
+ *
+ * while ((data = lwprintf_strbuf_iterate(&sb, &it, &len)) != NULL) {
+ *     uart_send(data, len);
+ * }
+ * \endcode
+ *
+ * \param[in]       sb: String builder
+ * \param[in,out]   it: Iterator. Set it to `NULL` before the first call
+ * \param[out]      len: Length of returned chunk data
+ * \return          Data of next chunk, `NULL` when there are no more chunks
+ */
+const char*
+lwprintf_strbuf_iterate(const lwprintf_strbuf_t* sb, const lwprintf_strbuf_chunk_t** it, size_t* len) {
+    const lwprintf_strbuf_chunk_t* chunk = *it == NULL ? sb->first : (*it)->next;
+
+    *it = chunk;
+    if (chunk == NULL) {
+        return NULL;
+    }
+    *len = chunk->len;
+    return chunk->data;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_STRBUF || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_ASPRINTF || __DOXYGEN__
+
+/**
+ * \brief           Set memory pool of the instance, used by allocating print functions
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       pool: Memory pool, that must stay valid while it is set. Set to `NULL` to remove it
+ */
+void
+lwprintf_set_pool_ex(lwprintf_t* const lwobj, const lwprintf_pool_t* pool) {
+    LWPRINTF_GET_LWOBJ(lwobj)->pool = pool;
+}
+
+/**
+ * \brief           Write formatted data from variable argument list to memory block of exact size,
+ *                  taken from memory pool of the instance.
+ *
+ * When pool can resize blocks in place, text is written directly to the block, that grows
+ * by \ref LWPRINTF_CFG_ASPRINTF_CHUNK_SIZE bytes and is shrunk to exact size at the end.
+ * Otherwise, or when block cannot grow anymore, length is measured first,
+ * and text is formatted to the block of exact size.
+ *
+ * \note            Pool functions are called without mutex, they must be thread-safe if pool is shared
+ *
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[out]      s_out: Pointer to store address of allocated C-string to. It is set to `NULL` on failure
+ * \param[in]       format: C string that contains a format string that follows the same specifications as format in printf
+ * \param[in]       arg: A value identifying a variable arguments list initialized with `va_start`.
+ *                      `va_list` is a special type defined in `<cstdarg>`.
+ * \return          Length of text, not counting the terminating null character, `-1` on failure
+ */
+int
+lwprintf_vasprintf_ex(lwprintf_t* const lwobj, char** s_out, const char* format, va_list arg) {
+    lwprintf_t* obj = LWPRINTF_GET_LWOBJ(lwobj);
+    const lwprintf_pool_t* pool = obj->pool;
+    char* buff;
+    va_list ap;
+    int len;
+
+    if (s_out == NULL) {
+        return -1;
+    }
+    *s_out = NULL;
+    if (pool == NULL || pool->alloc_fn == NULL || format == NULL) {
+        return -1;
+    }
+
+    /* Text goes directly to the block, without measure pass */
+    if (pool->resize_fn != NULL) {
+        asprintf_state_t as = {
+            .pool = pool,
+            .size = LWPRINTF_CFG_ASPRINTF_CHUNK_SIZE,
+        };
+        lwprintf_int_t fobj = {
+            .lwobj = obj,
+            .out_fn = prv_out_fn_asprintf,
+            .out_str_fn = prv_out_str_fn_asprintf,
+            .out_fill_fn = prv_out_fill_fn_asprintf,
+            .fmt = format,
+            .buff = NULL,
+            .buff_max_len = 0,
+            .as = &as,
+        };
+
+        if ((as.buff = pool->alloc_fn(as.size, pool->arg)) == NULL) {
+            return -1;
+        }
+        va_copy(ap, arg);
+        prv_format(&fobj, ap);
+        va_end(ap);
+        if (!as.is_full) {
+            as.buff[fobj.n_len] = '\0';
+            pool->resize_fn(as.buff, fobj.n_len + 1, pool->arg); /* Unused part goes back to the pool */
+            *s_out = as.buff;
+            return (int)fobj.n_len;
+        }
+        if (pool->free_fn != NULL) {
+            pool->free_fn(as.buff, pool->arg);
+        }
+    }
+
+    /* Measure, then format to block of exact size */
+    va_copy(ap, arg);
+    len = lwprintf_vsnprintf_ex(obj, NULL, 0, format, ap);
+    va_end(ap);
+    if ((buff = pool->alloc_fn((size_t)len + 1, pool->arg)) == NULL) {
+        return -1;
+    }
+    lwprintf_vsnprintf_ex(obj, buff, (size_t)len + 1, format, arg);
+    *s_out = buff;
+    return len;
+}
+
+/**
+ * \brief           Write formatted data to memory block of exact size, taken from memory pool of the instance
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[out]      s_out: Pointer to store address of allocated C-string to. It is set to `NULL` on failure
+ * \param[in]       format: C string that contains a format string that follows the same specifications as format in printf
+ * \param[in]       ...: Optional arguments for format string
+ * \return          Length of text, not counting the terminating null character, `-1` on failure
+ * \sa              lwprintf_vasprintf_ex
+ */
+int
+lwprintf_asprintf_ex(lwprintf_t* const lwobj, char** s_out, const char* format, ...) {
+    va_list valist;
+    int len;
+
+    va_start(valist, format);
+    len = lwprintf_vasprintf_ex(lwobj, s_out, format, valist);
+    va_end(valist);
+
+    return len;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_ASPRINTF || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_RESUMABLE || __DOXYGEN__
+
+/**
+ * \brief           Start resumable formatting, that is output by \ref lwprintf_format_continue.
+ *
+ * Arguments are used until formatting is done, function that started `arg` with `va_start`
+ * must not return before that, and formatting must be ended with \ref lwprintf_format_end when it is stopped earlier
+ *
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[out]      ctx: Resumable formatting state
+ * \param[in]       format: C string that contains a format string that follows the same specifications as format in printf
+ * \param[in]       arg: A value identifying a variable arguments list initialized with `va_start`.
+ *                      `va_list` is a special type defined in `<cstdarg>`.
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwprintf_vformat_start_ex(lwprintf_t* const lwobj, lwprintf_resume_t* ctx, const char* format, va_list arg) {
+    if (ctx == NULL || format == NULL) {
+        return 0;
+    }
+    ctx->lwobj = LWPRINTF_GET_LWOBJ(lwobj);
+    ctx->fmt = format;
+    ctx->part_pos = 0;
+    ctx->pos = 0;
+    ctx->is_done = 0;
+    va_copy(ctx->arg, arg);
+    return 1;
+}
+
+/**
+ * \brief           Output next chunk of resumable formatting.
+ *
+ * Text continues where the previous call stopped. Only the part of format string, that was cut
+ * at the end of the previous chunk, is formatted again and its already output characters are skipped.
+ * Buffer is not `NULL` terminated
+ *
+ * \param[in,out]   ctx: Resumable formatting state, started with \ref lwprintf_vformat_start_ex
+ * \param[out]      buff: Buffer for the chunk
+ * \param[in]       buff_size: Size of buffer in units of bytes
+ * \return          Number of characters written to the buffer, `0` when whole text is output
+ */
+size_t
+lwprintf_format_continue(lwprintf_resume_t* ctx, char* buff, size_t buff_size) {
+    size_t pos;
+    va_list ap;
+
+    if (ctx == NULL || ctx->is_done || buff == NULL || buff_size == 0) {
+        return 0;
+    }
+
+    {
+        lwprintf_int_t fobj = {
+            .lwobj = ctx->lwobj,
+            .out_fn = prv_out_fn_resume,
+            .out_str_fn = prv_out_str_fn_resume,
+            .out_fill_fn = prv_out_fill_fn_resume,
+            .fmt = ctx->fmt,
+            .buff = buff,
+            .buff_max_len = buff_size,
+            .n_len = ctx->part_pos,
+            .rs = ctx,
+        };
+
+        LWPRINTF_CFG_TRACE_FORMAT_START(ctx->lwobj, ctx->fmt);
+        va_copy(ap, ctx->arg);
+        prv_format_run(&fobj, &ap);
+        va_end(ap);
+
+        pos = ctx->pos;
+        if (fobj.is_print_cancelled) {
+            ctx->pos += buff_size;
+
+            /* Literal text continues at the exact character, only specifiers are formatted again */
+            if (*ctx->fmt != '%') {
+                ctx->fmt += ctx->pos - ctx->part_pos;
+                ctx->part_pos = ctx->pos;
+            }
+        } else {
+            ctx->pos = fobj.n_len;
+            lwprintf_format_end(ctx);
+        }
+    }
+    LWPRINTF_CFG_TRACE_FORMAT_END(ctx->lwobj, ctx->pos - pos);
+    return ctx->pos - pos;
+}
+
+/**
+ * \brief           End resumable formatting and release its arguments.
+ *
+ * It is called by \ref lwprintf_format_continue when whole text is output,
+ * application calls it only when formatting is stopped earlier
+ *
+ * \param[in,out]   ctx: Resumable formatting state
+ */
+void
+lwprintf_format_end(lwprintf_resume_t* ctx) {
+    if (ctx != NULL && !ctx->is_done) {
+        va_end(ctx->arg);
+        ctx->is_done = 1;
+    }
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_RESUMABLE || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_CUSTOM_SPEC || __DOXYGEN__
+
+/**
+ * \brief           Register custom specifier handler for the instance.
+ * Registered specifier is used by all print and buffer functions of the instance,
+ * and it takes precedence over built-in specifier with the same character.
+ *
+ * \note            Register specifiers during initialization, before instance is used by print calls.
+ *                      Custom specifiers are not supported by deferred print functions
+ *
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       spec: Specifier character. Length modifiers `h`, `l`, `z` and `j` are not allowed
+ * \param[in]       fn: Handler function. Set to `NULL` to remove the specifier
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwprintf_register_specifier_ex(lwprintf_t* const lwobj, char spec, lwprintf_spec_fn fn) {
+    lwprintf_t* obj = LWPRINTF_GET_LWOBJ(lwobj);
+    size_t i;
+
+    if (!((spec >= 'A' && spec <= 'Z') || (spec >= 'a' && spec <= 'z')) || spec == 'h' || spec == 'l' || spec == 'z'
+        || spec == 'j'
+#if LWPRINTF_CFG_SUPPORT_TYPE_ARRAY
+        || spec == 'v'
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ARRAY */
+    ) {
+        return 0;
+    }
+    for (i = 0; i < obj->specs_cnt && obj->specs[i].spec != spec; ++i) {}
+    if (fn == NULL) {
+        if (i < obj->specs_cnt) {
+            obj->specs[i] = obj->specs[--obj->specs_cnt]; /* Move last entry to the free place */
+        }
+        return 1;
+    }
+    if (i == obj->specs_cnt) {
+        if (obj->specs_cnt >= LWPRINTF_ARRAYSIZE(obj->specs)) {
+            return 0;
+        }
+        obj->specs[i].spec = spec;
+        ++obj->specs_cnt;
+    }
+    obj->specs[i].fn = fn;
+    return 1;
+}
+
+/**
+ * \brief           Write string from custom specifier handler to the output.
+ * Width and flags of the custom specifier are applied to the string
+ * \param[in]       ctx: Output context, received by the handler
+ * \param[in]       str: String to write, it may be temporary
+ * \param[in]       len: Number of characters to write
+ */
+void
+lwprintf_spec_write(lwprintf_spec_ctx_t* ctx, const char* str, size_t len) {
+    lwprintf_int_t* lwi = (lwprintf_int_t*)ctx;
+
+    prv_out_str_before(lwi, len);
+    prv_out_str_raw(lwi, str, len);
+    prv_out_str_after(lwi, len);
+}
+
+/**
+ * \brief           Write part of the text from custom specifier handler to the output, without width and flags.
+ *
+ * Handler, that outputs text in multiple parts, applies width itself,
+ * with values from \ref lwprintf_spec_get_info
+ *
+ * \param[in]       ctx: Output context, received by the handler
+ * \param[in]       str: String to write, it may be temporary
+ * \param[in]       len: Number of characters to write
+ */
+void
+lwprintf_spec_write_raw(lwprintf_spec_ctx_t* ctx, const char* str, size_t len) {
+    prv_out_str_raw((lwprintf_int_t*)ctx, str, len);
+}
+
+/**
+ * \brief           Get width, precision and flags of running custom specifier
+ * \param[in]       ctx: Output context, received by the handler
+ * \param[out]      info: Output variable to save specifier info
+ */
+void
+lwprintf_spec_get_info(const lwprintf_spec_ctx_t* ctx, lwprintf_spec_info_t* info) {
+    const lwprintf_int_t* lwi = (const lwprintf_int_t*)ctx;
+
+    info->width = lwi->m.width;
+    info->precision = lwi->m.flags.precision ? lwi->m.precision : -1;
+    info->left = lwi->m.flags.left_align;
+    info->zero = lwi->m.flags.zero;
+    info->plus = lwi->m.flags.plus;
+    info->space = lwi->m.flags.space;
+    info->alt = lwi->m.flags.alt;
+}
+
+/**
+ * \brief           Format data from variable argument list in custom specifier handler, directly to the output.
+ *
+ * Width and flags of the custom specifier are applied to complete formatted text.
+ * Length for width is calculated first, only when width is set
+ *
+ * \param[in]       ctx: Output context, received by the handler
+ * \param[in]       format: C string that contains a format string that follows the same specifications as format in printf
+ * \param[in]       arg: A value identifying a variable arguments list initialized with `va_start`.
+ *                      `va_list` is a special type defined in `<cstdarg>`.
+ * \return          The number of characters that would have been written
+ */
+int
+lwprintf_spec_vprintf(lwprintf_spec_ctx_t* ctx, const char* format, va_list arg) {
+    lwprintf_int_t* lwi = (lwprintf_int_t*)ctx;
+    const char* fmt = lwi->fmt;
+    format_spec_t m;
+    size_t start = lwi->n_len, len = 0;
+    va_list ap;
+#if LWPRINTF_CFG_ENABLE_COMPILED_FORMAT
+    const compiled_op_t* ops = lwi->ops;
+#endif /* LWPRINTF_CFG_ENABLE_COMPILED_FORMAT */
+#if LWPRINTF_CFG_ENABLE_RESUMABLE
+    lwprintf_resume_t* rs = lwi->rs;
+#endif /* LWPRINTF_CFG_ENABLE_RESUMABLE */
+
+    lwi->fmt = format;
+#if LWPRINTF_CFG_ENABLE_COMPILED_FORMAT
+    lwi->ops = NULL;
+#endif /* LWPRINTF_CFG_ENABLE_COMPILED_FORMAT */
+#if LWPRINTF_CFG_ENABLE_RESUMABLE
+    lwi->rs = NULL; /* Nested parts are formatted again with the handler */
+#endif /* LWPRINTF_CFG_ENABLE_RESUMABLE */
+
+    /* Length is needed only for padding */
+    if (lwi->m.width > 0) {
+        lwprintf_int_t meas = *lwi;
+
+        prv_set_measure_mode(&meas);
+        meas.n_len = 0;
+#if LWPRINTF_CFG_ENABLE_IOV
+        meas.iov = NULL;
+#endif /* LWPRINTF_CFG_ENABLE_IOV */
+#if LWPRINTF_CFG_ENABLE_RESUMABLE
+        meas.rs = NULL;
+#endif /* LWPRINTF_CFG_ENABLE_RESUMABLE */
+        va_copy(ap, arg);
+        prv_format_run(&meas, &ap);
+        va_end(ap);
+        len = meas.n_len;
+    }
+
+    prv_out_str_before(lwi, len);
+    m = lwi->m; /* Nested format resets specifier state */
+    va_copy(ap, arg);
+    prv_format_run(lwi, &ap);
+    va_end(ap);
+    lwi->m = m;
+    prv_out_str_after(lwi, len);
+
+    lwi->fmt = fmt;
+#if LWPRINTF_CFG_ENABLE_COMPILED_FORMAT
+    lwi->ops = ops;
+#endif /* LWPRINTF_CFG_ENABLE_COMPILED_FORMAT */
+#if LWPRINTF_CFG_ENABLE_RESUMABLE
+    lwi->rs = rs;
+#endif /* LWPRINTF_CFG_ENABLE_RESUMABLE */
+    return (int)(lwi->n_len - start);
+}
+
+/**
+ * \brief           Format data in custom specifier handler, directly to the output
+ * \param[in]       ctx: Output context, received by the handler
+ * \param[in]       format: C string that contains a format string that follows the same specifications as format in printf
+ * \param[in]       ...: Optional arguments for format string
+ * \return          The number of characters that would have been written
+ * \sa              lwprintf_spec_vprintf
+ */
+int
+lwprintf_spec_printf(lwprintf_spec_ctx_t* ctx, const char* format, ...) {
+    va_list valist;
+    int n_len;
+
+    va_start(valist, format);
+    n_len = lwprintf_spec_vprintf(ctx, format, valist);
+    va_end(valist);
+
+    return n_len;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_CUSTOM_SPEC || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_SUPPORT_THOUSANDS || __DOXYGEN__
+
+/**
+ * \brief           Set thousands separator character of the instance.
+ *
+ * Separator is inserted between groups of 3 integer digits, when `'` flag is used
+ * with decimal integer, floating-point or fixed-point specifier.
+ * Width of the specifier includes separators
+ *
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       sep: Separator character. Set to `'\0'` to use default `,` character
+ */
+void
+lwprintf_set_thousands_sep_ex(lwprintf_t* const lwobj, char sep) {
+    LWPRINTF_GET_LWOBJ(lwobj)->thousands_sep = sep;
+}
+
+#endif /* LWPRINTF_CFG_SUPPORT_THOUSANDS || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_SUPPORT_TYPE_ARRAY || __DOXYGEN__
+
+/**
+ * \brief           Set separator string between elements of array printed with `v` flag.
+ * \note            String is not copied and must stay valid while instance is used
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       sep: Separator string. Set to `NULL` to use default `", "` string
+ */
+void
+lwprintf_set_array_sep_ex(lwprintf_t* const lwobj, const char* sep) {
+    LWPRINTF_GET_LWOBJ(lwobj)->array_sep = sep;
+}
+
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ARRAY || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_LINE_PREFIX || __DOXYGEN__
+
+/**
+ * \brief           Set timestamp and tag prefix, written at the start of every line of direct print output.
+ *
+ * Prefix has format `[      1234.567] [tag] `, or `[      1234.567] ` without tag.
+ * Time function is called at the start of every line, and only digits that changed since previous line
+ * are rendered to the prefix kept in the instance. Prefix is not counted to the length, returned by print functions
+ *
+ * \note            Next character printed by the instance starts new line
+ *
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       time_fn: Time function. Set to `NULL` to disable prefix
+ * \param[in]       tag: Tag of every line. Set to `NULL` for prefix with timestamp only.
+ *                      It is copied to the instance and may have up to \ref LWPRINTF_CFG_LINE_PREFIX_TAG_LEN characters
+ * \return          `1` on success, `0` if tag is too long
+ */
+uint8_t
+lwprintf_set_line_prefix_ex(lwprintf_t* const lwobj, lwprintf_prefix_time_fn time_fn, const char* tag) {
+    lwprintf_t* obj = LWPRINTF_GET_LWOBJ(lwobj);
+    const size_t tag_len = tag != NULL ? prv_strnlen(tag, LWPRINTF_CFG_LINE_PREFIX_TAG_LEN + 1) : 0;
+    size_t len = 16;
+
+    if (tag_len > LWPRINTF_CFG_LINE_PREFIX_TAG_LEN) {
+        return 0;
+    }
+
+    /* Fixed characters are rendered once, digits are rendered with the first line */
+    memcpy(obj->prefix, "[          .000]", len);
+    if (tag_len > 0) {
+        obj->prefix[len++] = ' ';
+        obj->prefix[len++] = '[';
+        memcpy(&obj->prefix[len], tag, tag_len);
+        len += tag_len;
+        obj->prefix[len++] = ']';
+    }
+    obj->prefix[len++] = ' ';
+    obj->prefix_len = (uint8_t)len;
+    obj->prefix_valid = 0;
+    obj->line_start = 1;
+    obj->prefix_time_fn = time_fn;
+    return 1;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_LINE_PREFIX || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_LOG_LEVEL || __DOXYGEN__
+
+/**
+ * \brief           Set minimum level of messages, printed by \ref lwprintf_log_ex
+ *
+ * Level is read by the macro before arguments are evaluated, messages with lower level cost one compare.
+ * Level lower than \ref LWPRINTF_CFG_LOG_LEVEL_MIN has no effect on messages below compile time minimum
+ *
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       level: Minimum level, use \ref LWPRINTF_LEVEL_NONE to disable all messages
+ */
+void
+lwprintf_set_level_ex(lwprintf_t* const lwobj, uint8_t level) {
+    LWPRINTF_GET_LWOBJ(lwobj)->level = level;
+}
+
+#if LWPRINTF_CFG_LOG_MODULE_COUNT > 0 || __DOXYGEN__
+
+/**
+ * \brief           Set minimum level of messages for the module, printed by \ref lwprintf_log_module_ex
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       module: Module index, lower than \ref LWPRINTF_CFG_LOG_MODULE_COUNT
+ * \param[in]       level: Minimum level, use \ref LWPRINTF_LEVEL_NONE to disable all messages
+ * \return          `1` on success, `0` if module index is out of range
+ */
+uint8_t
+lwprintf_set_module_level_ex(lwprintf_t* const lwobj, size_t module, uint8_t level) {
+    if (module >= LWPRINTF_CFG_LOG_MODULE_COUNT) {
+        return 0;
+    }
+    LWPRINTF_GET_LWOBJ(lwobj)->module_levels[module] = level;
+    return 1;
+}
+
+#endif /* LWPRINTF_CFG_LOG_MODULE_COUNT > 0 || __DOXYGEN__ */
+
+#endif /* LWPRINTF_CFG_ENABLE_LOG_LEVEL || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_COMPILED_FORMAT || __DOXYGEN__
+
+/**
+ * \brief           Parse format string once, to be later used with `*_compiled_ex` functions
+ *
+ * Format string is split into literal segments and parsed specifiers.
+ * Required storage size is always written to `out->size`,
+ * hence application can call function with `storage` set to `NULL` to query it first.
+ *
+ * \note            Format string must stay valid as long as compiled format is used,
+ *                  literal segments point to it
+ *
+ * \param[in]       format: C string that contains a format string that follows the same specifications as format in printf
+ * \param[out]      out: Compiled format to fill
+ * \param[in]       storage: Memory for parsed segments, aligned to pointer size. Can be set to `NULL`
+ * \param[in]       size: Size of `storage` in units of bytes
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwprintf_compile(const char* format, lwprintf_compiled_t* out, void* storage, size_t size) {
+    compiled_op_t* ops = storage;
+    const size_t max_cnt = storage != NULL ? (size / sizeof(*ops)) : 0;
+    const char* fmt = format;
+    size_t cnt = 0;
+
+    if (out == NULL || format == NULL) {
+        return 0;
+    }
+    while (*fmt != '\0') {
+        if (*fmt != '%' || fmt[1] == '%') {
+            const char* fmt_start = fmt;
+
+            /* Literal text up to next specifier. Escaped "%%" becomes single character segment */
+            if (*fmt == '%') {
+                fmt_start = ++fmt;
+                ++fmt;
+            } else {
+                for (; *fmt != '\0' && *fmt != '%'; ++fmt) {}
+            }
+            if (cnt < max_cnt) {
+                ops[cnt].str = fmt_start;
+                ops[cnt].len = (size_t)(fmt - fmt_start);
+            }
+        } else {
+            compiled_op_t op;
+
+            fmt = prv_parse_spec(&op.m, fmt + 1, &op.star);
+            if (*fmt == '\0') {
+                break; /* Format string ended inside of specifier */
+            }
+            op.str = fmt;
+            op.len = 0;
+            fmt = prv_spec_next(fmt);
+            if (cnt < max_cnt) {
+                ops[cnt] = op;
+            }
+        }
+        ++cnt;
+    }
+
+    /* Compiled format cannot be used when segments did not fit into storage */
+    out->ops = cnt <= max_cnt ? ops : NULL;
+    out->ops_cnt = cnt;
+    out->size = cnt * sizeof(*ops);
+    return out->ops != NULL;
+}
+
+/**
+ * \brief           Print formatted data from variable argument list to the output with precompiled format
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       cformat: Precompiled format, created with \ref lwprintf_compile
+ * \param[in]       arg: A value identifying a variable arguments list initialized with `va_start`.
+ *                      `va_list` is a special type defined in `<cstdarg>`.
+ * \return          The number of characters that would have been written,
+ *                      not counting the terminating null character.
+ */
+int
+lwprintf_vprintf_compiled_ex(lwprintf_t* const lwobj, const lwprintf_compiled_t* cformat, va_list arg) {
+    lwprintf_int_t fobj = {
+        .lwobj = LWPRINTF_GET_LWOBJ(lwobj),
+        .out_fn = prv_out_fn_print,
+        .out_str_fn = prv_out_str_fn_print,
+        .out_fill_fn = prv_out_fill_fn_print,
+        .buff = NULL,
+        .buff_max_len = 0,
+    };
+    /* For direct print, output function must be set by user */
+    if (cformat == NULL || cformat->ops == NULL || !IS_OUTPUT_SET(fobj.lwobj)) {
+        return 0;
+    }
+    fobj.ops = cformat->ops;
+    fobj.ops_cnt = cformat->ops_cnt;
+    if (prv_format_print(&fobj, arg)) {
+        return (int)fobj.n_len;
+    }
+    return 0;
+}
+
+/**
+ * \brief           Print formatted data to the output with precompiled format
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       cformat: Precompiled format, created with \ref lwprintf_compile
+ * \param[in]       ...: Optional arguments for format string
+ * \return          The number of characters that would have been written,
+ *                      not counting the terminating null character.
+ */
+int
+lwprintf_printf_compiled_ex(lwprintf_t* const lwobj, const lwprintf_compiled_t* cformat, ...) {
+    va_list valist;
+    int n_len;
+
+    va_start(valist, cformat);
+    n_len = lwprintf_vprintf_compiled_ex(lwobj, cformat, valist);
+    va_end(valist);
+
+    return n_len;
+}
+
+/**
+ * \brief           Write formatted data from variable argument list to sized buffer with precompiled format
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       s_out: Pointer to a buffer where the resulting C-string is stored.
+ *                      The buffer should have a size of at least `n` characters
+ * \param[in]       n_maxlen: Maximum number of bytes to be used in the buffer.
+ *                      The generated string has a length of at most `n - 1`,
+ *                      leaving space for the additional terminating null character
+ * \param[in]       cformat: Precompiled format, created with \ref lwprintf_compile
+ * \param[in]       arg: A value identifying a variable arguments list initialized with `va_start`.
+ *                      `va_list` is a special type defined in `<cstdarg>`.
+ * \return          The number of characters that would have been written if `n` had been sufficiently large,
+ *                      not counting the terminating null character.
+ */
+int
+lwprintf_vsnprintf_compiled_ex(lwprintf_t* const lwobj, char* s_out, size_t n_maxlen,
+                               const lwprintf_compiled_t* cformat, va_list arg) {
+    lwprintf_int_t fobj = {
+        .lwobj = LWPRINTF_GET_LWOBJ(lwobj),
+        .out_fn = prv_out_fn_write_buff,
+        .out_str_fn = prv_out_str_fn_write_buff,
+        .out_fill_fn = prv_out_fill_fn_write_buff,
+        .buff = s_out,
+        .buff_max_len = (s_out != NULL && n_maxlen > 0) ? (n_maxlen - 1) : 0,
+    };
+    if (fobj.buff_max_len == 0) {
+        prv_set_measure_mode(&fobj); /* Nothing can be written, only length is calculated */
+    }
+    if (cformat != NULL && cformat->ops != NULL) {
+        fobj.ops = cformat->ops;
+        fobj.ops_cnt = cformat->ops_cnt;
+        if (!prv_format(&fobj, arg)) {
+            fobj.n_len = 0;
+        }
+    }
+
+    /* Terminate string only once, at the end of written or truncated output */
+    if (s_out != NULL && n_maxlen > 0) {
+        s_out[fobj.n_len < fobj.buff_max_len ? fobj.n_len : fobj.buff_max_len] = '\0';
+    }
+    return (int)fobj.n_len;
+}
+
+/**
+ * \brief           Write formatted data to sized buffer with precompiled format
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       s_out: Pointer to a buffer where the resulting C-string is stored.
+ *                      The buffer should have a size of at least `n` characters
+ * \param[in]       n_maxlen: Maximum number of bytes to be used in the buffer.
+ *                      The generated string has a length of at most `n - 1`,
+ *                      leaving space for the additional terminating null character
+ * \param[in]       cformat: Precompiled format, created with \ref lwprintf_compile
+ * \param[in]       ...: Optional arguments for format string
+ * \return          The number of characters that would have been written if `n` had been sufficiently large,
+ *                      not counting the terminating null character.
+ */
+int
+lwprintf_snprintf_compiled_ex(lwprintf_t* const lwobj, char* s_out, size_t n_maxlen,
+                              const lwprintf_compiled_t* cformat, ...) {
+    va_list valist;
+    int len;
+
+    va_start(valist, cformat);
+    len = lwprintf_vsnprintf_compiled_ex(lwobj, s_out, n_maxlen, cformat, valist);
+    va_end(valist);
+
+    return len;
+}
+
+#if LWPRINTF_CFG_FORMAT_CACHE_SIZE > 0 || __DOXYGEN__
+
+/**
+ * \brief           Remove all entries from parsed format cache of the instance
+ *
+ * Cache compares only addresses of format strings.
+ * Call it before memory of format string, that has already been printed, is reused for another format string
+ *
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ */
+void
+lwprintf_format_cache_clear_ex(lwprintf_t* const lwobj) {
+    lwprintf_t* obj = LWPRINTF_GET_LWOBJ(lwobj);
+#if LWPRINTF_CFG_OS && !LWPRINTF_CFG_OS_MANUAL_PROTECT
+    uint8_t locked = 0;
+
+    /* Mutex is created only for instances with output function */
+    if (IS_OUTPUT_SET(obj)) {
+        if (!prv_mutex_wait(obj)) {
+            return;
+        }
+        locked = 1;
+    }
+#endif /* LWPRINTF_CFG_OS && !LWPRINTF_CFG_OS_MANUAL_PROTECT */
+    memset(obj->fcache_fmt, 0x00, sizeof(obj->fcache_fmt));
+#if LWPRINTF_CFG_OS && !LWPRINTF_CFG_OS_MANUAL_PROTECT
+    if (locked) {
+        prv_mutex_release(obj);
+    }
+#endif /* LWPRINTF_CFG_OS && !LWPRINTF_CFG_OS_MANUAL_PROTECT */
+}
+
+#endif /* LWPRINTF_CFG_FORMAT_CACHE_SIZE > 0 || __DOXYGEN__ */
+
+#endif /* LWPRINTF_CFG_ENABLE_COMPILED_FORMAT || __DOXYGEN__ */
+
+#if PACKED_ARGS
+
+/**
+ * \brief           Process format string with arguments from memory buffer, with normal formatting path
+ * \param[in,out]   lwi: LwPRINTF internal instance, with captured or packed arguments set
+ * \param[in]       ...: Unused, only to create empty variable argument list
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+prv_format_packed(lwprintf_int_t* lwi, ...) {
+    va_list valist;
+    uint8_t res;
+
+    va_start(valist, lwi);
+    res = IS_PRINT_MODE(lwi) ? prv_format_print(lwi, valist) : prv_format(lwi, valist);
+    va_end(valist);
+    return res;
+}
+
+#endif /* PACKED_ARGS */
+
+#if LWPRINTF_CFG_ENABLE_PACKED_ARGS || __DOXYGEN__
+
+/**
+ * \brief           Write formatted data with packed arguments to sized buffer
+ * \param[in,out]   lwi: LwPRINTF internal instance, set up for buffer output
+ * \param[in]       n_maxlen: Maximum number of bytes to be used in the buffer
+ * \return          The number of characters that would have been written if buffer had been sufficiently large
+ */
+static int
+prv_snprintf_packed(lwprintf_int_t* lwi, size_t n_maxlen) {
+    if (lwi->buff_max_len == 0) {
+        prv_set_measure_mode(lwi); /* Nothing can be written, only length is calculated */
+    }
+    if (!prv_format_packed(lwi)) {
+        lwi->n_len = 0;
+    }
+    if (lwi->buff != NULL && n_maxlen > 0) {
+        lwi->buff[lwi->n_len < lwi->buff_max_len ? lwi->n_len : lwi->buff_max_len] = '\0';
+    }
+    return (int)lwi->n_len;
+}
+
+/**
+ * \brief           Print formatted data to the output, with arguments from packed buffer.
+ *
+ * Arguments are stored in the buffer in the order of the format string, each aligned to its size.
+ * Their types are types after default argument promotion, except `%f`, `%e` and `%g` arguments,
+ * that are stored as \ref lwprintf_packed_float_t. Buffer is aligned to the largest argument type.
+ *
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       format: C string that contains the text to be written to output
+ * \param[in]       args: Packed arguments buffer
+ * \return          The number of characters that would have been written,
+ *                      not counting the terminating null character.
+ */
+int
+lwprintf_printf_packed_ex(lwprintf_t* const lwobj, const char* format, const void* args) {
+    lwprintf_int_t fobj = {
+        .lwobj = LWPRINTF_GET_LWOBJ(lwobj),
+        .out_fn = prv_out_fn_print,
+        .out_str_fn = prv_out_str_fn_print,
+        .out_fill_fn = prv_out_fill_fn_print,
+        .fmt = format,
+        .buff = NULL,
+        .buff_max_len = 0,
+        .dargs = args,
+    };
+    /* For direct print, output function must be set by user */
+    if (!IS_OUTPUT_SET(fobj.lwobj) || args == NULL) {
+        return 0;
+    }
+    if (prv_format_packed(&fobj)) {
+        return (int)fobj.n_len;
+    }
+    return 0;
+}
+
+/**
+ * \brief           Write formatted data to sized buffer, with arguments from packed buffer
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       s_out: Pointer to a buffer where the resulting C-string is stored.
+ *                      The buffer should have a size of at least `n` characters
+ * \param[in]       n_maxlen: Maximum number of bytes to be used in the buffer.
+ *                      The generated string has a length of at most `n - 1`,
+ *                      leaving space for the additional terminating null character
+ * \param[in]       format: C string that contains a format string that follows the same specifications as format in printf
+ * \param[in]       args: Packed arguments buffer, as described in \ref lwprintf_printf_packed_ex
+ * \return          The number of characters that would have been written if `n` had been sufficiently large,
+ *                      not counting the terminating null character.
+ */
+int
+lwprintf_snprintf_packed_ex(lwprintf_t* const lwobj, char* s_out, size_t n_maxlen, const char* format,
+                            const void* args) {
+    lwprintf_int_t fobj = {
+        .lwobj = LWPRINTF_GET_LWOBJ(lwobj),
+        .out_fn = prv_out_fn_write_buff,
+        .out_str_fn = prv_out_str_fn_write_buff,
+        .out_fill_fn = prv_out_fill_fn_write_buff,
+        .fmt = format,
+        .buff = s_out,
+        .buff_max_len = (s_out != NULL && n_maxlen > 0) ? (n_maxlen - 1) : 0,
+        .dargs = args,
+    };
+    if (args == NULL) {
+        return 0;
+    }
+    return prv_snprintf_packed(&fobj, n_maxlen);
+}
+
+/**
+ * \brief           Write formatted data to sized buffer, with arguments from packed buffer,
+ *                  without terminating null character
+ *
+ * All `n` bytes of the buffer are used for text, and byte after the text is never touched.
+ * It is used to place text of many print calls next to each other in the same buffer.
+ * Format cache and statistics of the instance are not used, so that many threads can call it
+ * with the same instance at the same time.
+ *
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       s_out: Pointer to a buffer where the resulting text is stored
+ * \param[in]       n_maxlen: Maximum number of bytes to be used in the buffer
+ * \param[in]       format: C string that contains a format string that follows the same specifications as format in printf
+ * \param[in]       args: Packed arguments buffer, as described in \ref lwprintf_printf_packed_ex
+ * \return          The number of characters that would have been written if `n` had been sufficiently large
+ */
+int
+lwprintf_write_packed_ex(lwprintf_t* const lwobj, char* s_out, size_t n_maxlen, const char* format,
+                         const void* args) {
+    lwprintf_int_t fobj = {
+        .lwobj = LWPRINTF_GET_LWOBJ(lwobj),
+        .out_fn = prv_out_fn_write_buff,
+        .out_str_fn = prv_out_str_fn_write_buff,
+        .out_fill_fn = prv_out_fill_fn_write_buff,
+        .fmt = format,
+        .buff = s_out,
+        .buff_max_len = s_out != NULL ? n_maxlen : 0,
+        .dargs = args,
+        .is_shared = 1,
+    };
+    if (args == NULL) {
+        return 0;
+    }
+    return prv_snprintf_packed(&fobj, 0); /* No room for terminating null character */
+}
+
+#if LWPRINTF_CFG_ENABLE_COMPILED_FORMAT || __DOXYGEN__
+
+/**
+ * \brief           Print formatted data to the output with precompiled format, with arguments from packed buffer
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       cformat: Precompiled format, created with \ref lwprintf_compile
+ * \param[in]       args: Packed arguments buffer, as described in \ref lwprintf_printf_packed_ex
+ * \return          The number of characters that would have been written,
+ *                      not counting the terminating null character.
+ */
+int
+lwprintf_printf_compiled_packed_ex(lwprintf_t* const lwobj, const lwprintf_compiled_t* cformat, const void* args) {
+    lwprintf_int_t fobj = {
+        .lwobj = LWPRINTF_GET_LWOBJ(lwobj),
+        .out_fn = prv_out_fn_print,
+        .out_str_fn = prv_out_str_fn_print,
+        .out_fill_fn = prv_out_fill_fn_print,
+        .buff = NULL,
+        .buff_max_len = 0,
+        .dargs = args,
+    };
+    /* For direct print, output function must be set by user */
+    if (!IS_OUTPUT_SET(fobj.lwobj) || cformat == NULL || cformat->ops == NULL || args == NULL) {
+        return 0;
+    }
+    fobj.ops = cformat->ops;
+    fobj.ops_cnt = cformat->ops_cnt;
+    if (prv_format_packed(&fobj)) {
+        return (int)fobj.n_len;
+    }
+    return 0;
+}
+
+/**
+ * \brief           Write formatted data to sized buffer with precompiled format, with arguments from packed buffer
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       s_out: Pointer to a buffer where the resulting C-string is stored.
+ *                      The buffer should have a size of at least `n` characters
+ * \param[in]       n_maxlen: Maximum number of bytes to be used in the buffer.
+ *                      The generated string has a length of at most `n - 1`,
+ *                      leaving space for the additional terminating null character
+ * \param[in]       cformat: Precompiled format, created with \ref lwprintf_compile
+ * \param[in]       args: Packed arguments buffer, as described in \ref lwprintf_printf_packed_ex
+ * \return          The number of characters that would have been written if `n` had been sufficiently large,
+ *                      not counting the terminating null character.
+ */
+int
+lwprintf_snprintf_compiled_packed_ex(lwprintf_t* const lwobj, char* s_out, size_t n_maxlen,
+                                     const lwprintf_compiled_t* cformat, const void* args) {
+    lwprintf_int_t fobj = {
+        .lwobj = LWPRINTF_GET_LWOBJ(lwobj),
+        .out_fn = prv_out_fn_write_buff,
+        .out_str_fn = prv_out_str_fn_write_buff,
+        .out_fill_fn = prv_out_fill_fn_write_buff,
+        .buff = s_out,
+        .buff_max_len = (s_out != NULL && n_maxlen > 0) ? (n_maxlen - 1) : 0,
+        .dargs = args,
+    };
+    if (cformat == NULL || cformat->ops == NULL || args == NULL) {
+        return 0;
+    }
+    fobj.ops = cformat->ops;
+    fobj.ops_cnt = cformat->ops_cnt;
+    return prv_snprintf_packed(&fobj, n_maxlen);
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_COMPILED_FORMAT || __DOXYGEN__ */
+
+#endif /* LWPRINTF_CFG_ENABLE_PACKED_ARGS || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_DEFERRED || __DOXYGEN__
 
-        /* Output relevant zeros first, string to print is opposite way */
-#if LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING
-        if (def_type == 'g') {
-            /* TODO: This is to be checked */
-            for (x = 0; x < (lwi->m.precision - i) && dblnum.digits_cnt_decimal_part_useful > 0;
-                 ++x, --dblnum.digits_cnt_decimal_part_useful) {
-                lwi->out_fn(lwi, '0');
-            }
-        } else
-#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING */
-        {
-            for (x = i; x < lwi->m.precision; ++x) {
-                lwi->out_fn(lwi, '0');
-            }
-        }
+/**
+ * \brief           Capture single argument of deferred message to the local buffer, converted to stored type
+ * \param[in]       args: Local arguments buffer
+ * \param[in,out]   args_len: Current length of arguments in the buffer
+ * \param[in]       arg: Variable argument list
+ * \param[in]       type: Argument type, after default argument promotion
+ * \param[in]       stype: Type of argument in the buffer
+ */
+#define DEFERRED_CAPTURE_AS(args, args_len, arg, type, stype)                                                          \
+    do {                                                                                                               \
+        const stype v = (stype)va_arg((arg), type);                                                                    \
+        (args_len) = DEFERRED_ALIGN_UP((args_len), sizeof(stype));                                                     \
+        if ((args_len) + sizeof(stype) > sizeof(args)) {                                                               \
+            return 0;                                                                                                  \
+        }                                                                                                              \
+        memcpy(&((unsigned char*)(args))[(args_len)], &v, sizeof(v));                                                 \
+        (args_len) += sizeof(stype);                                                                                   \
+    } while (0)
 
-        /* Now print string itself */
-        for (; i > 0; --i) {
-            lwi->out_fn(lwi, str[i - 1]);
-#if LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING
-            if (def_type == 'g' && --dblnum.digits_cnt_decimal_part_useful == 0) {
-                break;
-            }
-#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING */
-        }
+/**
+ * \brief           Capture single argument of deferred message to the local buffer
+ * \param[in]       args: Local arguments buffer
+ * \param[in,out]   args_len: Current length of arguments in the buffer
+ * \param[in]       arg: Variable argument list
+ * \param[in]       type: Argument type, after default argument promotion
+ */
+#define DEFERRED_CAPTURE(args, args_len, arg, type) DEFERRED_CAPTURE_AS(args, args_len, arg, type, type)
 
-        /* Print ending zeros if selected precision is bigger than maximum supported */
-        if (def_type != 'g') {
-            for (; x < chosen_precision; ++x) {
-                lwi->out_fn(lwi, '0');
-            }
-        }
-    }
+/**
+ * \brief           Set ring buffer for deferred messages of LwPRINTF instance
+ *
+ * Instance must be initialized with \ref lwprintf_init_ex or \ref lwprintf_init_block_ex before,
+ * as stored messages are formatted to its output function.
+ *
+ * \note            Deferred print functions do not use mutex, so they can be called from interrupts.
+ *                  Buffer is single producer, single consumer. When messages are stored from multiple contexts,
+ *                  application must not let them interrupt each other (for example by disabling interrupts)
+ *
+ * \param[in,out]   lwobj: LwPRINTF working instance. Set to `NULL` to use default instance
+ * \param[in]       buff: Ring buffer memory. Set to `NULL` to disable deferred mode
+ * \param[in]       buff_size: Size of ring buffer in units of bytes
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwprintf_init_deferred_ex(lwprintf_t* lwobj, void* buff, size_t buff_size) {
+    size_t offset = 0;
 
-#if LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING
-    /* Engineering mode output, add exponent part */
-    if (lwi->m.type == 'e') {
-        lwi->out_fn(lwi, lwi->m.flags.uc ? 'E' : 'e');
-        lwi->out_fn(lwi, exp_cnt >= 0 ? '+' : '-');
-        if (exp_cnt < 0) {
-            exp_cnt = -exp_cnt;
-        }
-        if (exp_cnt >= 100) {
-            lwi->out_fn(lwi, (char)'0' + (char)(exp_cnt / 100));
-            exp_cnt /= 100;
-        }
-        lwi->out_fn(lwi, (char)'0' + (char)(exp_cnt / 10));
-        lwi->out_fn(lwi, (char)'0' + (char)(exp_cnt % 10));
+    lwobj = LWPRINTF_GET_LWOBJ(lwobj);
+    lwobj->dbuff = NULL;
+    lwobj->dbuff_size = 0;
+    lwobj->dbuff_r = 0;
+    lwobj->dbuff_w = 0;
+    if (buff == NULL) {
+        return 1;
     }
-#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING */
-    prv_out_str_after(lwi, digits_cnt);
 
+    /* Messages are aligned to the largest argument type */
+    if ((uintptr_t)buff % sizeof(deferred_align_t) != 0) {
+        offset = sizeof(deferred_align_t) - (size_t)((uintptr_t)buff % sizeof(deferred_align_t));
+    }
+    if (buff_size < offset + 2 * DEFERRED_HDR_SIZE) {
+        return 0;
+    }
+    buff_size -= offset;
+    lwobj->dbuff = (unsigned char*)buff + offset;
+    lwobj->dbuff_size = buff_size - buff_size % sizeof(deferred_align_t);
     return 1;
 }
 
-#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FLOAT */
-
 /**
- * \brief           Process format string and parse variable parameters
- * \param[in,out]   lwi: LwPRINTF internal instance
- * \param[in]       arg: Variable parameters list
- * \return          `1` on success, `0` otherwise
+ * \brief           Store formatted message from variable argument list to ring buffer, for later processing
+ *
+ * Only format pointer and raw argument values are stored, output is generated
+ * later by \ref lwprintf_process_deferred_ex function.
+ *
+ * \note            Format string, strings and other pointers passed as arguments
+ *                  must stay valid until the message is processed
+ *
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       format: C string that contains the text to be written to output
+ * \param[in]       arg: A value identifying a variable arguments list initialized with `va_start`.
+ *                      `va_list` is a special type defined in `<cstdarg>`.
+ * \return          `1` if message is stored, `0` if there is no space in the buffer or arguments are too long
  */
-static uint8_t
-prv_format(lwprintf_int_t* lwi, va_list arg) {
-    uint8_t detected = 0;
-    const char* fmt = lwi->fmt;
+uint8_t
+lwprintf_vprintf_deferred_ex(lwprintf_t* const lwobj, const char* format, va_list arg) {
+    lwprintf_t* obj = LWPRINTF_GET_LWOBJ(lwobj);
+    deferred_align_t args[DEFERRED_ARGS_CNT];
+    deferred_hdr_t* hdr;
+    format_spec_t m;
+    const char* fmt = format;
+    size_t args_len = 0, len, pos, r, w;
+    uint8_t star;
 
-#if LWPRINTF_CFG_OS && !LWPRINTF_CFG_OS_MANUAL_PROTECT
-    if (IS_PRINT_MODE(lwi) &&                                /* OS protection only for print */
-        (!lwprintf_sys_mutex_isvalid(&lwi->lwobj->mutex)     /* Invalid mutex handle */
-         || !lwprintf_sys_mutex_wait(&lwi->lwobj->mutex))) { /* Cannot acquire mutex */
+    if (obj->dbuff == NULL || format == NULL) {
         return 0;
     }
-#endif /* LWPRINTF_CFG_OS && !LWPRINTF_CFG_OS_MANUAL_PROTECT */
-
-    while (fmt != NULL && *fmt != '\0') {
-        /* Check if we should stop processing */
-        if (lwi->is_print_cancelled) {
-            break;
-        }
 
-        /* Detect beginning */
-        if (*fmt != '%') {
-            lwi->out_fn(lwi, *fmt); /* Output character */
-            ++fmt;
+    /* Quick scan of specifiers, only to get type of every argument */
+    while (*fmt != '\0') {
+        if (*fmt++ != '%') {
             continue;
         }
-        ++fmt;
-        memset(&lwi->m, 0x00, sizeof(lwi->m)); /* Reset structure */
-
-        /* Parse format */
-        /* %[flags][width][.precision][length]type */
-        /* Go to https://docs.majerle.eu for more info about supported features */
-
-        /* Check [flags] */
-        /* It can have multiple flags in any order */
-        detected = 1;
-        do {
-            switch (*fmt) {
-                case '-': lwi->m.flags.left_align = 1; break;
-                case '+': lwi->m.flags.plus = 1; break;
-                case ' ': lwi->m.flags.space = 1; break;
-                case '0': lwi->m.flags.zero = 1; break;
-                case '\'': lwi->m.flags.thousands = 1; break;
-                case '#': lwi->m.flags.alt = 1; break;
-                default: detected = 0; break;
-            }
-            if (detected) {
-                ++fmt;
-            }
-        } while (detected);
-
-        /* Check [width] */
-        lwi->m.width = 0;
-        if (CHARISNUM(*fmt)) { /* Fixed width check */
-            /* If number is negative, it has been captured from previous step (left align) */
-            lwi->m.width = prv_parse_num(&fmt); /* Number from string directly */
-        } else if (*fmt == '*') {               /* Or variable check */
-            const int w = (int)va_arg(arg, int);
-            if (w < 0) {
-                lwi->m.flags.left_align = 1; /* Negative width means left aligned */
-                lwi->m.width = -w;
-            } else {
-                lwi->m.width = w;
-            }
-            ++fmt;
+        fmt = prv_parse_spec(&m, fmt, &star);
+        if (star & SPEC_STAR_WIDTH) {
+            DEFERRED_CAPTURE(args, args_len, arg, int);
         }
-
-        /* Check [.precision] */
-        lwi->m.precision = 0;
-        if (*fmt == '.') { /* Precision flag is detected */
-            lwi->m.flags.precision = 1;
-            if (*++fmt == '*') { /* Variable check */
-                const int pr = (int)va_arg(arg, int);
-                lwi->m.precision = pr > 0 ? pr : 0;
-                ++fmt;
-            } else if (CHARISNUM(*fmt)) { /* Directly in the string */
-                lwi->m.precision = prv_parse_num(&fmt);
-            }
+        if (star & SPEC_STAR_PRECISION) {
+            DEFERRED_CAPTURE(args, args_len, arg, int);
         }
-
-        /* Check [length] */
-        detected = 1;
-        switch (*fmt) {
-            case 'h':
-                lwi->m.flags.char_short = 1;     /* Single h detected */
-                if (*++fmt == 'h') {             /* Does it follow by another h? */
-                    lwi->m.flags.char_short = 2; /* Second h detected */
-                    ++fmt;
-                }
-                break;
-            case 'l':
-                lwi->m.flags.longlong = 1;     /* Single l detected */
-                if (*++fmt == 'l') {           /* Does it follow by another l? */
-                    lwi->m.flags.longlong = 2; /* Second l detected */
-                    ++fmt;
-                }
-                break;
-            case 'L': break;
-            case 'z':
-                lwi->m.flags.sz_t = 1; /* Size T flag */
-                ++fmt;
-                break;
-            case 'j':
-                lwi->m.flags.umax_t = 1; /* uintmax_t flag */
-                ++fmt;
-                break;
-            case 't': break;
-            default: detected = 0;
+        if (*fmt == '\0') {
+            break;
         }
-
-        /* Check type */
-        lwi->m.type = *fmt + (char)((*fmt >= 'A' && *fmt <= 'Z') ? 0x20 : 0x00);
-        if (*fmt >= 'A' && *fmt <= 'Z') {
-            lwi->m.flags.uc = 1;
+#if LWPRINTF_CFG_SUPPORT_TYPE_ARRAY
+        if (m.flags.array) {
+            DEFERRED_CAPTURE(args, args_len, arg, int);
+            DEFERRED_CAPTURE(args, args_len, arg, const void*);
+            fmt = prv_spec_next(fmt);
+            continue;
         }
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_ARRAY */
+
+        /* Types must follow arguments read in prv_format function */
         switch (*fmt) {
+#if LWPRINTF_CFG_SUPPORT_TYPE_FLOAT_HEX
             case 'a':
-            case 'A':
-                /* Double in hexadecimal notation */
-                (void)va_arg(arg, double);      /* Read argument to ignore it and move to next one */
-                prv_out_str_raw(lwi, "NaN", 3); /* Print string */
-                break;
-            case 'c': lwi->out_fn(lwi, (char)va_arg(arg, int)); break;
+            case 'A': DEFERRED_CAPTURE(args, args_len, arg, double); break;
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FLOAT_HEX */
+            case 'c': DEFERRED_CAPTURE(args, args_len, arg, int); break;
 #if LWPRINTF_CFG_SUPPORT_TYPE_INT
             case 'd':
-            case 'i': {
-                /* Check for different length parameters */
-                lwi->m.base = 10;
-                if (lwi->m.flags.longlong == 0) {
-                    prv_longest_signed_int_to_str(lwi, (int_maxtype_t)va_arg(arg, signed int));
-                } else if (lwi->m.flags.longlong == 1) {
-                    prv_longest_signed_int_to_str(lwi, (int_maxtype_t)va_arg(arg, signed long int));
+            case 'i':
+                if (m.flags.longlong == 0) {
+                    DEFERRED_CAPTURE(args, args_len, arg, signed int);
+                } else if (m.flags.longlong == 1) {
+                    DEFERRED_CAPTURE(args, args_len, arg, signed long int);
 #if LWPRINTF_CFG_SUPPORT_LONG_LONG
-                } else if (lwi->m.flags.longlong == 2) {
-                    prv_longest_signed_int_to_str(lwi, (int_maxtype_t)va_arg(arg, signed long long int));
+                } else if (m.flags.longlong == 2) {
+                    DEFERRED_CAPTURE(args, args_len, arg, signed long long int);
 #endif /* LWPRINTF_CFG_SUPPORT_LONG_LONG */
                 }
                 break;
-            }
             case 'b':
             case 'B':
             case 'o':
             case 'u':
             case 'x':
             case 'X':
-                if (*fmt == 'b' || *fmt == 'B') {
-                    lwi->m.base = 2;
-                } else if (*fmt == 'o') {
-                    lwi->m.base = 8;
-                } else if (*fmt == 'u') {
-                    lwi->m.base = 10;
-                } else if (*fmt == 'x' || *fmt == 'X') {
-                    lwi->m.base = 16;
-                }
-                lwi->m.flags.space = 0; /* Space flag has no meaning here */
-
-                /* Check for different length parameters */
-                if (0) {
-
-                } else if (lwi->m.flags.sz_t) {
-                    prv_longest_unsigned_int_to_str(lwi, (uint_maxtype_t)va_arg(arg, size_t));
-                } else if (lwi->m.flags.umax_t) {
-                    prv_longest_unsigned_int_to_str(lwi, (uint_maxtype_t)va_arg(arg, uintmax_t));
-                } else if (lwi->m.flags.longlong == 0 || lwi->m.base == 2) {
-                    uint_maxtype_t v = va_arg(arg, unsigned int);
-                    switch (lwi->m.flags.char_short) {
-                        case 2: v = (uint_maxtype_t)((unsigned char)v); break;
-                        case 1: v = (uint_maxtype_t)((unsigned short int)v); break;
-                        default: v = (uint_maxtype_t)((unsigned int)v); break;
-                    }
-                    prv_longest_unsigned_int_to_str(lwi, v);
-                } else if (lwi->m.flags.longlong == 1) {
-                    prv_longest_unsigned_int_to_str(lwi, (uint_maxtype_t)va_arg(arg, unsigned long int));
+                if (m.flags.sz_t) {
+                    DEFERRED_CAPTURE(args, args_len, arg, size_t);
+                } else if (m.flags.umax_t) {
+                    DEFERRED_CAPTURE(args, args_len, arg, uintmax_t);
+                } else if (m.flags.longlong == 0 || *fmt == 'b' || *fmt == 'B') {
+                    DEFERRED_CAPTURE(args, args_len, arg, unsigned int);
+                } else if (m.flags.longlong == 1) {
+                    DEFERRED_CAPTURE(args, args_len, arg, unsigned long int);
 #if LWPRINTF_CFG_SUPPORT_LONG_LONG
-                } else if (lwi->m.flags.longlong == 2) {
-                    prv_longest_unsigned_int_to_str(lwi, (uint_maxtype_t)va_arg(arg, unsigned long long int));
+                } else if (m.flags.longlong == 2) {
+                    DEFERRED_CAPTURE(args, args_len, arg, unsigned long long int);
 #endif /* LWPRINTF_CFG_SUPPORT_LONG_LONG */
                 }
                 break;
 #endif /* LWPRINTF_CFG_SUPPORT_TYPE_INT */
 #if LWPRINTF_CFG_SUPPORT_TYPE_STRING
-            case 's': {
-                const char* b = va_arg(arg, const char*);
-                if (b == NULL) {
-                    b = "(null)";
-                }
-
-                /* Output string up to maximum buffer. If user provides lower buffer size, write will not write to it
-                    but it will still calculate "would be" length */
-                prv_out_str(lwi, b, prv_strnlen(b, lwi->m.flags.precision ? (size_t)lwi->m.precision : (SIZE_MAX)));
-                break;
-            }
+            case 's': DEFERRED_CAPTURE(args, args_len, arg, const char*); break;
 #endif /* LWPRINTF_CFG_SUPPORT_TYPE_STRING */
+#if LWPRINTF_CFG_SUPPORT_TYPE_STRING_ESCAPE
+            case 'J':
+            case 'C': DEFERRED_CAPTURE(args, args_len, arg, const char*); break;
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_STRING_ESCAPE */
 #if LWPRINTF_CFG_SUPPORT_TYPE_POINTER
-            case 'p': {
-                lwi->m.base = 16;      /* Go to hex format */
-                lwi->m.flags.uc = 0;   /* Uppercase characters */
-                lwi->m.flags.zero = 1; /* Zero padding */
-                lwi->m.width =
-                    sizeof(uintptr_t) * 2; /* Number is in hex format and byte is represented with 2 letters */
-
-                prv_longest_unsigned_int_to_str(lwi, (uint_maxtype_t)va_arg(arg, uintptr_t));
-                break;
-            }
+            case 'p': DEFERRED_CAPTURE(args, args_len, arg, uintptr_t); break;
 #endif /* LWPRINTF_CFG_SUPPORT_TYPE_POINTER */
 #if LWPRINTF_CFG_SUPPORT_TYPE_FLOAT
             case 'f':
@@ -955,208 +9388,633 @@ prv_format(lwprintf_int_t* lwi, va_list arg) {
             case 'g':
             case 'G':
 #endif /* LWPRINTF_CFG_SUPPORT_TYPE_ENGINEERING */
-                /* Double number in different format. Final output depends on type of format */
-                prv_double_to_str(lwi, (double)va_arg(arg, double));
+#if SI_FLOAT
+            case 'y':
+#endif /* SI_FLOAT */
+                DEFERRED_CAPTURE_AS(args, args_len, arg, double, lwprintf_packed_float_t);
                 break;
 #endif /* LWPRINTF_CFG_SUPPORT_TYPE_FLOAT */
-            case 'n': {
-                int* ptr = (void*)va_arg(arg, int*);
-                *ptr = (int)lwi->n_len; /* Write current length */
+            case 'n': DEFERRED_CAPTURE(args, args_len, arg, int*); break;
+#if LWPRINTF_CFG_SUPPORT_TYPE_BYTE_ARRAY
+            case 'k':
+            case 'K': DEFERRED_CAPTURE(args, args_len, arg, unsigned char*); break;
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_BYTE_ARRAY */
+#if LWPRINTF_CFG_SUPPORT_TYPE_BASE64
+            case 'r': DEFERRED_CAPTURE(args, args_len, arg, unsigned char*); break;
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_BASE64 */
+#if LWPRINTF_CFG_SUPPORT_TYPE_HEXDUMP
+            case 'H': DEFERRED_CAPTURE(args, args_len, arg, unsigned char*); break;
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_HEXDUMP */
+#if LWPRINTF_CFG_SUPPORT_TYPE_FIXED || LWPRINTF_CFG_SUPPORT_TYPE_SI
+#if LWPRINTF_CFG_SUPPORT_TYPE_FIXED
+            case 'q':
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FIXED */
+#if LWPRINTF_CFG_SUPPORT_TYPE_SI
+            case 'Y':
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_SI */
+                if (m.flags.longlong == 0) {
+                    DEFERRED_CAPTURE(args, args_len, arg, signed int);
+                } else if (m.flags.longlong == 1) {
+                    DEFERRED_CAPTURE(args, args_len, arg, signed long int);
+#if LWPRINTF_CFG_SUPPORT_LONG_LONG
+                } else if (m.flags.longlong == 2) {
+                    DEFERRED_CAPTURE(args, args_len, arg, signed long long int);
+#endif /* LWPRINTF_CFG_SUPPORT_LONG_LONG */
+                }
+                break;
+#endif /* LWPRINTF_CFG_SUPPORT_TYPE_FIXED || LWPRINTF_CFG_SUPPORT_TYPE_SI */
+            default: break;
+        }
+        fmt = prv_spec_next(fmt);
+    }
+
+    /* Find contiguous space in ring buffer, write position never catches up read position when full */
+    len = DEFERRED_ALIGN_UP(DEFERRED_HDR_SIZE + args_len, sizeof(deferred_align_t));
+    r = obj->dbuff_r;
+    w = obj->dbuff_w;
+    if (w >= r) {
+        if (len < obj->dbuff_size - w || (len == obj->dbuff_size - w && r > 0)) {
+            pos = w;
+        } else if (len < r) {
+            ((deferred_hdr_t*)(void*)&obj->dbuff[w])->len = 0; /* Not enough space at the end, wrap */
+            pos = 0;
+        } else {
+            return 0;
+        }
+    } else if (len < r - w) {
+        pos = w;
+    } else {
+        return 0;
+    }
+
+    /* Write message before it is published with write position */
+    hdr = (void*)&obj->dbuff[pos];
+    hdr->len = len;
+    hdr->fmt = format;
+    memcpy(&obj->dbuff[pos + DEFERRED_HDR_SIZE], args, args_len);
+    pos += len;
+    obj->dbuff_w = pos == obj->dbuff_size ? 0 : pos;
+    return 1;
+}
+
+/**
+ * \brief           Store formatted message to ring buffer, for later processing
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       format: C string that contains the text to be written to output
+ * \param[in]       ...: Optional arguments for format string
+ * \return          `1` if message is stored, `0` if there is no space in the buffer or arguments are too long
+ */
+uint8_t
+lwprintf_printf_deferred_ex(lwprintf_t* const lwobj, const char* format, ...) {
+    va_list valist;
+    uint8_t res;
+
+    va_start(valist, format);
+    res = lwprintf_vprintf_deferred_ex(lwobj, format, valist);
+    va_end(valist);
+
+    return res;
+}
+
+/**
+ * \brief           Format all stored deferred messages to the output of LwPRINTF instance
+ *
+ * Function is meant to be called from low priority task or idle hook.
+ * Messages are formatted with the same path as \ref lwprintf_printf_ex
+ *
+ * \note            With \ref LWPRINTF_CFG_OS enabled, instance mutex is held until all messages are processed.
+ *                  Mutex is taken again by every message, hence it must be recursive
+ *
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \return          Number of processed messages
+ */
+size_t
+lwprintf_process_deferred_ex(lwprintf_t* const lwobj) {
+    lwprintf_t* obj = LWPRINTF_GET_LWOBJ(lwobj);
+    size_t r, cnt = 0;
+#if LWPRINTF_CFG_OS_YIELD_CHUNK > 0
+    uint8_t is_emitting;
+#endif /* LWPRINTF_CFG_OS_YIELD_CHUNK > 0 */
+
+    /* For direct print, output function must be set by user */
+    if (obj->dbuff == NULL || !IS_OUTPUT_SET(obj)) {
+        return 0;
+    }
+#if LWPRINTF_CFG_OS && !LWPRINTF_CFG_OS_MANUAL_PROTECT
+    /* Ring buffer has single consumer, while messages may be processed from multiple tasks */
+    if (!prv_mutex_wait(obj)) {
+        return 0;
+    }
+#endif /* LWPRINTF_CFG_OS && !LWPRINTF_CFG_OS_MANUAL_PROTECT */
+#if LWPRINTF_CFG_OS_YIELD_CHUNK > 0
+    /* Stored records come out only after yielding record is finished */
+    if (obj->yield_busy) {
+        prv_mutex_release(obj);
+        return 0;
+    }
+    is_emitting = obj->is_emitting;
+    obj->is_emitting = 1; /* Mutex is held for all records, there is no point to yield */
+#endif /* LWPRINTF_CFG_OS_YIELD_CHUNK > 0 */
+    r = obj->dbuff_r;
+    while (r != obj->dbuff_w) {
+        const deferred_hdr_t* hdr = (const void*)&obj->dbuff[r];
+
+        if (hdr->len == 0) {
+            r = 0; /* Wrap marker */
+        } else {
+            lwprintf_int_t fobj = {
+                .lwobj = obj,
+                .out_fn = prv_out_fn_print,
+                .out_str_fn = prv_out_str_fn_print,
+                .out_fill_fn = prv_out_fill_fn_print,
+                .fmt = hdr->fmt,
+                .buff = NULL,
+                .buff_max_len = 0,
+                .dargs = &obj->dbuff[r + DEFERRED_HDR_SIZE],
+            };
+            prv_format_packed(&fobj);
+            r += hdr->len;
+            r = r == obj->dbuff_size ? 0 : r;
+            ++cnt;
+        }
+        obj->dbuff_r = r; /* Release memory only after message is processed */
+    }
+#if LWPRINTF_CFG_OS_YIELD_CHUNK > 0
+    obj->is_emitting = is_emitting;
+#endif /* LWPRINTF_CFG_OS_YIELD_CHUNK > 0 */
+#if LWPRINTF_CFG_OS && !LWPRINTF_CFG_OS_MANUAL_PROTECT
+    prv_mutex_release(obj);
+#endif /* LWPRINTF_CFG_OS && !LWPRINTF_CFG_OS_MANUAL_PROTECT */
+    return cnt;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_DEFERRED || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_ENABLE_ASYNC || __DOXYGEN__
+
+/**
+ * \brief           Format message to selected position of output queue
+ * \param[in,out]   obj: LwPRINTF instance
+ * \param[in]       prio: Priority lane of the queue
+ * \param[in]       pos: Message position in the queue
+ * \param[in]       max_len: Maximum message length, including header
+ * \param[in]       format: C string that contains the text to be written to output
+ * \param[in]       arg: Variable parameters list
+ * \return          Full length of formatted text, even if it does not fit
+ */
+static size_t
+prv_async_format(lwprintf_t* obj, uint8_t prio, size_t pos, size_t max_len, const char* format, va_list arg) {
+    lwprintf_int_t fobj = {
+        .lwobj = obj,
+        .out_fn = prv_out_fn_write_buff,
+        .out_str_fn = prv_out_str_fn_write_buff,
+        .out_fill_fn = prv_out_fill_fn_write_buff,
+        .fmt = format,
+        .buff = max_len > ASYNC_HDR_SIZE ? (char*)&obj->abuff[prio][pos + ASYNC_HDR_SIZE] : NULL,
+        .buff_max_len = max_len > ASYNC_HDR_SIZE ? max_len - ASYNC_HDR_SIZE : 0,
+    };
+
+    prv_format(&fobj, arg);
+    return fobj.n_len;
+}
+
+/**
+ * \brief           Set output queue of priority lane
+ * \param[in,out]   obj: LwPRINTF instance
+ * \param[in]       prio: Priority lane of the queue
+ * \param[in]       buff: Queue memory. Set to `NULL` to disable the lane
+ * \param[in]       buff_size: Size of queue in units of bytes
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+prv_async_init(lwprintf_t* obj, uint8_t prio, void* buff, size_t buff_size) {
+    size_t offset = 0;
+
+    obj->abuff[prio] = NULL;
+    obj->abuff_size[prio] = 0;
+    obj->abuff_r[prio] = 0;
+    obj->abuff_w[prio] = 0;
+#if LWPRINTF_CFG_ASYNC_PRIO_COUNT > 1
+    obj->aprio_busy = 0;
+#endif /* LWPRINTF_CFG_ASYNC_PRIO_COUNT > 1 */
+    if (buff == NULL) {
+        return 1;
+    }
+
+    /* Headers are aligned to pointer size */
+    if ((uintptr_t)buff % sizeof(async_align_t) != 0) {
+        offset = sizeof(async_align_t) - (size_t)((uintptr_t)buff % sizeof(async_align_t));
+    }
+    if (buff_size < offset + 2 * ASYNC_HDR_SIZE) {
+        return 0;
+    }
+#if LWPRINTF_CFG_OS && !LWPRINTF_CFG_OS_MANUAL_PROTECT
+    /* Producers have own mutex, they shall not wait for the output */
+    if (!lwprintf_sys_mutex_isvalid(&obj->amutex) && !lwprintf_sys_mutex_create(&obj->amutex)) {
+        return 0;
+    }
+#endif /* LWPRINTF_CFG_OS && !LWPRINTF_CFG_OS_MANUAL_PROTECT */
+    buff_size -= offset;
+    obj->abuff[prio] = (unsigned char*)buff + offset;
+    obj->abuff_size[prio] = buff_size - buff_size % sizeof(async_align_t);
+    return 1;
+}
+
+/**
+ * \brief           Format message to output queue of priority lane
+ * \param[in,out]   obj: LwPRINTF instance
+ * \param[in]       prio: Priority lane of the queue
+ * \param[in]       done_fn: Completion callback. Set to `NULL` if not used
+ * \param[in]       done_arg: Completion callback argument, or pointer to `uint8_t` flag when callback is `NULL`
+ * \param[in]       format: C string that contains the text to be written to output
+ * \param[in]       arg: Variable parameters list
+ * \return          `1` if message is queued, `0` if there is no space in the queue
+ */
+static uint8_t
+prv_async_vprintf(lwprintf_t* obj, uint8_t prio, lwprintf_async_done_fn done_fn, void* done_arg, const char* format,
+                  va_list arg) {
+    async_hdr_t* hdr;
+    size_t r, w, pos, max_len, text_len, len;
+    va_list arg_copy;
+    uint8_t res = 0;
+
+    if (obj->abuff[prio] == NULL || format == NULL) {
+        return 0;
+    }
+#if LWPRINTF_CFG_OS && !LWPRINTF_CFG_OS_MANUAL_PROTECT
+    if (!lwprintf_sys_mutex_isvalid(&obj->amutex) || !lwprintf_sys_mutex_wait(&obj->amutex)) {
+        return 0;
+    }
+#endif /* LWPRINTF_CFG_OS && !LWPRINTF_CFG_OS_MANUAL_PROTECT */
+
+    /* Format to contiguous space at write position, that never catches up read position */
+    r = obj->abuff_r[prio];
+    w = obj->abuff_w[prio];
+    pos = w;
+    if (w >= r) {
+        max_len = obj->abuff_size[prio] - w - (r == 0 ? sizeof(async_align_t) : 0);
+    } else {
+        max_len = r - w - sizeof(async_align_t);
+    }
+
+    /* Arguments are kept for second pass at the beginning of the queue, if message does not fit */
+    va_copy(arg_copy, arg);
+    text_len = prv_async_format(obj, prio, pos, max_len, format, arg);
+    len = ASYNC_ALIGN_UP(ASYNC_HDR_SIZE + text_len);
+    if (len > max_len && w >= r && r > sizeof(async_align_t) && len <= r - sizeof(async_align_t)) {
+        pos = 0;
+        max_len = r - sizeof(async_align_t);
+        prv_async_format(obj, prio, pos, max_len, format, arg_copy);
+        ((async_hdr_t*)(void*)&obj->abuff[prio][w])->len = 0; /* Not enough space at the end, wrap */
+    } else if (len > max_len && w == r && w != 0) {
+        /* Empty queue restarts from the beginning, once the sink passes wrap marker */
+        ((async_hdr_t*)(void*)&obj->abuff[prio][w])->len = 0;
+        obj->abuff_w[prio] = 0;
+    }
+    va_end(arg_copy);
+
+    /* Write header before message is published with write position */
+    if (len <= max_len) {
+        hdr = (void*)&obj->abuff[prio][pos];
+        hdr->len = len;
+        hdr->text_len = text_len;
+        hdr->done_fn = done_fn;
+        hdr->done_arg = done_arg;
+        pos += len;
+        obj->abuff_w[prio] = pos == obj->abuff_size[prio] ? 0 : pos;
+        res = 1;
+    }
+#if LWPRINTF_CFG_OS && !LWPRINTF_CFG_OS_MANUAL_PROTECT
+    lwprintf_sys_mutex_release(&obj->amutex);
+#endif /* LWPRINTF_CFG_OS && !LWPRINTF_CFG_OS_MANUAL_PROTECT */
+    return res;
+}
+
+/**
+ * \brief           Get priority lane, that sink takes the message from
+ *
+ * Message handed to the sink stays selected until it is released,
+ * otherwise oldest message of the highest non-empty lane is selected
+ *
+ * \param[in,out]   obj: LwPRINTF instance
+ * \return          Priority lane of the queue
+ */
+static uint8_t
+prv_async_lane(lwprintf_t* obj) {
+#if LWPRINTF_CFG_ASYNC_PRIO_COUNT > 1
+    uint8_t prio;
+
+    if (obj->aprio_busy) {
+        return obj->aprio_cur;
+    }
+    for (prio = LWPRINTF_CFG_ASYNC_PRIO_COUNT - 1; prio > 0; --prio) {
+        if (obj->abuff[prio] != NULL && obj->abuff_r[prio] != obj->abuff_w[prio]) {
+            break;
+        }
+    }
+    return prio;
+#else
+    LWPRINTF_UNUSED(obj);
+    return 0;
+#endif /* LWPRINTF_CFG_ASYNC_PRIO_COUNT > 1 */
+}
+
+/**
+ * \brief           Set output queue for asynchronous messages of LwPRINTF instance
+ *
+ * Messages are formatted to the queue by asynchronous print functions,
+ * and handed over to the sink in original order.
+ *
+ * \note            Queue has single consumer. Messages can be taken either by the sink,
+ *                  with \ref lwprintf_async_get_block_ex and \ref lwprintf_async_release_block_ex,
+ *                  or with \ref lwprintf_process_async_ex, but never from multiple contexts at the same time
+ *
+ * \note            With \ref LWPRINTF_CFG_ASYNC_PRIO_COUNT greater than `1`, function sets queue of lane `0`
+ *
+ * \param[in,out]   lwobj: LwPRINTF working instance. Set to `NULL` to use default instance
+ * \param[in]       buff: Queue memory. Set to `NULL` to disable asynchronous mode
+ * \param[in]       buff_size: Size of queue in units of bytes
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwprintf_init_async_ex(lwprintf_t* lwobj, void* buff, size_t buff_size) {
+    return prv_async_init(LWPRINTF_GET_LWOBJ(lwobj), 0, buff, buff_size);
+}
 
-                break;
-            }
-            case '%': lwi->out_fn(lwi, '%'); break;
-#if LWPRINTF_CFG_SUPPORT_TYPE_BYTE_ARRAY
-            /*
-             * This is to print unsigned-char formatted pointer in hex string
-             *
-             * char arr[] = {0, 1, 2, 3, 255};
-             * "%5K" would produce 00010203FF
-             */
-            case 'k':
-            case 'K': {
-                unsigned char* ptr =
-                    (void*)va_arg(arg, unsigned char*); /* Get input parameter as unsigned char pointer */
-                int len = lwi->m.width, full_width;
-                uint8_t is_space = lwi->m.flags.space == 1;
-
-                if (ptr == NULL || len == 0) {
-                    break;
-                }
+/**
+ * \brief           Get maximum length of message text, that fits to the output queue
+ *
+ * Longer message is never queued. Shorter message is queued when there is enough contiguous space.
+ * When it does not fit to the empty queue, because of position of previous messages,
+ * it fits after the sink takes next block with \ref lwprintf_async_get_block_ex
+ *
+ * \note            With \ref LWPRINTF_CFG_ASYNC_PRIO_COUNT greater than `1`, function checks queue of lane `0`
+ *
+ * \param[in]       lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \return          Maximum text length, or `0` if queue is not set
+ */
+size_t
+lwprintf_async_max_len_ex(const lwprintf_t* lwobj) {
+    const lwprintf_t* obj = LWPRINTF_GET_LWOBJ(lwobj);
 
-                lwi->m.flags.zero = 1;  /* Prepend with zeros if necessary */
-                lwi->m.width = 0;       /* No width parameter */
-                lwi->m.base = 16;       /* Hex format */
-                lwi->m.flags.space = 0; /* Delete any flag for space */
+    if (obj->abuff[0] == NULL) {
+        return 0;
+    }
+    return obj->abuff_size[0] - sizeof(async_align_t) - ASYNC_HDR_SIZE;
+}
 
-                /* Full width of digits to print */
-                full_width = len * (2 + (int)is_space);
-                if (is_space && full_width > 0) {
-                    --full_width; /* Remove space after last number */
-                }
+/**
+ * \brief           Format data from variable argument list to output queue, without waiting for the output
+ *
+ * Text is formatted immediately, therefore arguments do not need to stay valid after the call.
+ * When message is released by the sink, `done_fn` is called with `done_arg` as parameter.
+ * If `done_fn` is `NULL` and `done_arg` is not, `done_arg` is treated as pointer to `uint8_t` flag,
+ * set to `1` on completion.
+ *
+ * \note            Completion is notified from the context that releases the message,
+ *                  that may be an interrupt of the sink
+ *
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       done_fn: Completion callback. Set to `NULL` if not used
+ * \param[in]       done_arg: Completion callback argument, or pointer to `uint8_t` flag when callback is `NULL`
+ * \param[in]       format: C string that contains the text to be written to output
+ * \param[in]       arg: A value identifying a variable arguments list initialized with `va_start`.
+ *                      `va_list` is a special type defined in `<cstdarg>`.
+ * \return          `1` if message is queued, `0` if there is no space in the queue
+ */
+uint8_t
+lwprintf_vprintf_async_ex(lwprintf_t* const lwobj, lwprintf_async_done_fn done_fn, void* done_arg,
+                          const char* format, va_list arg) {
+    return prv_async_vprintf(LWPRINTF_GET_LWOBJ(lwobj), 0, done_fn, done_arg, format, arg);
+}
 
-                /* Output byte by byte w/o hex prefix */
-                prv_out_str_before(lwi, full_width);
-                for (int i = 0; i < len; ++i, ++ptr) {
-                    uint8_t d;
+/**
+ * \brief           Format data to output queue, without waiting for the output
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       done_fn: Completion callback. Set to `NULL` if not used
+ * \param[in]       done_arg: Completion callback argument, or pointer to `uint8_t` flag when callback is `NULL`
+ * \param[in]       format: C string that contains the text to be written to output
+ * \param[in]       ...: Optional arguments for format string
+ * \return          `1` if message is queued, `0` if there is no space in the queue
+ */
+uint8_t
+lwprintf_printf_async_ex(lwprintf_t* const lwobj, lwprintf_async_done_fn done_fn, void* done_arg,
+                         const char* format, ...) {
+    va_list valist;
+    uint8_t res;
 
-                    d = (*ptr >> 0x04) & 0x0F; /* Print MSB */
-                    lwi->out_fn(lwi, (char)(d) + (char)(d >= 10 ? ((lwi->m.flags.uc ? 'A' : 'a') - 10) : '0'));
-                    d = *ptr & 0x0F; /* Print LSB */
-                    lwi->out_fn(lwi, (char)(d) + (char)(d >= 10 ? ((lwi->m.flags.uc ? 'A' : 'a') - 10) : '0'));
+    va_start(valist, format);
+    res = lwprintf_vprintf_async_ex(lwobj, done_fn, done_arg, format, valist);
+    va_end(valist);
 
-                    if (is_space && i < (len - 1)) {
-                        lwi->out_fn(lwi, ' '); /* Generate space between numbers */
-                    }
-                }
-                prv_out_str_after(lwi, full_width);
-                break;
-            }
-#endif /* LWPRINTF_CFG_SUPPORT_TYPE_BYTE_ARRAY */
-            default: lwi->out_fn(lwi, *fmt);
-        }
-        ++fmt;
-    }
-    lwi->out_fn(lwi, '\0'); /* Output last zero number */
-#if LWPRINTF_CFG_OS && !LWPRINTF_CFG_OS_MANUAL_PROTECT
-    if (IS_PRINT_MODE(lwi)) { /* Mutex only for print operation */
-        lwprintf_sys_mutex_release(&lwi->lwobj->mutex);
-    }
-#endif /* LWPRINTF_CFG_OS && !LWPRINTF_CFG_OS_MANUAL_PROTECT */
-    return 1;
+    return res;
 }
 
+#if LWPRINTF_CFG_ASYNC_PRIO_COUNT > 1 || __DOXYGEN__
+
 /**
- * \brief           Initialize LwPRINTF instance
- * \param[in,out]   lwobj: LwPRINTF working instance
- * \param[in]       out_fn: Output function used for print operation.
- *                      When set to `NULL`, direct print to stream functions won't work
- *                      and will return error if called by the application.
- *                      Also, system mutex for this specific instance won't be called
- *                      as system mutex isn't needed. All formatting functions (with print being an exception)
- *                      are thread safe. Library utilizes stack-based variables
+ * \brief           Set output queue of asynchronous messages with selected priority
+ *
+ * Every priority lane has own memory, full lane drops only its own messages.
+ * Lane with higher index has higher priority.
+ *
+ * \param[in,out]   lwobj: LwPRINTF working instance. Set to `NULL` to use default instance
+ * \param[in]       prio: Priority lane, from `0` to \ref LWPRINTF_CFG_ASYNC_PRIO_COUNT - `1`
+ * \param[in]       buff: Queue memory. Set to `NULL` to disable the lane
+ * \param[in]       buff_size: Size of queue in units of bytes
  * \return          `1` on success, `0` otherwise
  */
 uint8_t
-lwprintf_init_ex(lwprintf_t* lwobj, lwprintf_output_fn out_fn) {
-    LWPRINTF_GET_LWOBJ(lwobj)->out_fn = out_fn;
-
-#if LWPRINTF_CFG_OS
-    /* Create system mutex, but only if user selected to ever use print mode */
-    if (out_fn != NULL
-        && (lwprintf_sys_mutex_isvalid(&LWPRINTF_GET_LWOBJ(lwobj)->mutex)
-            || !lwprintf_sys_mutex_create(&LWPRINTF_GET_LWOBJ(lwobj)->mutex))) {
+lwprintf_init_async_prio_ex(lwprintf_t* lwobj, uint8_t prio, void* buff, size_t buff_size) {
+    if (prio >= LWPRINTF_CFG_ASYNC_PRIO_COUNT) {
         return 0;
     }
-#endif /* LWPRINTF_CFG_OS */
-    return 1;
+    return prv_async_init(LWPRINTF_GET_LWOBJ(lwobj), prio, buff, buff_size);
 }
 
 /**
- * \brief           Print formatted data from variable argument list to the output
+ * \brief           Format data from variable argument list to output queue with selected priority
+ *
+ * Message is sent ahead of all queued messages with lower priority,
+ * but never in the middle of message already handed to the sink.
+ *
  * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       prio: Priority lane, from `0` to \ref LWPRINTF_CFG_ASYNC_PRIO_COUNT - `1`
+ * \param[in]       done_fn: Completion callback. Set to `NULL` if not used
+ * \param[in]       done_arg: Completion callback argument, or pointer to `uint8_t` flag when callback is `NULL`
  * \param[in]       format: C string that contains the text to be written to output
  * \param[in]       arg: A value identifying a variable arguments list initialized with `va_start`.
  *                      `va_list` is a special type defined in `<cstdarg>`.
- * \return          The number of characters that would have been written if `n` had been sufficiently large,
- *                      not counting the terminating null character.
+ * \return          `1` if message is queued, `0` if there is no space in the lane
  */
-int
-lwprintf_vprintf_ex(lwprintf_t* const lwobj, const char* format, va_list arg) {
-    lwprintf_int_t fobj = {
-        .lwobj = LWPRINTF_GET_LWOBJ(lwobj),
-        .out_fn = prv_out_fn_print,
-        .fmt = format,
-        .buff = NULL,
-        .buff_size = 0,
-    };
-    /* For direct print, output function must be set by user */
-    if (fobj.lwobj->out_fn == NULL) {
+uint8_t
+lwprintf_vprintf_async_prio_ex(lwprintf_t* const lwobj, uint8_t prio, lwprintf_async_done_fn done_fn, void* done_arg,
+                               const char* format, va_list arg) {
+    if (prio >= LWPRINTF_CFG_ASYNC_PRIO_COUNT) {
         return 0;
     }
-    if (prv_format(&fobj, arg)) {
-        return (int)fobj.n_len;
-    }
-    return 0;
+    return prv_async_vprintf(LWPRINTF_GET_LWOBJ(lwobj), prio, done_fn, done_arg, format, arg);
 }
 
 /**
- * \brief           Print formatted data to the output
+ * \brief           Format data to output queue with selected priority
  * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       prio: Priority lane, from `0` to \ref LWPRINTF_CFG_ASYNC_PRIO_COUNT - `1`
+ * \param[in]       done_fn: Completion callback. Set to `NULL` if not used
+ * \param[in]       done_arg: Completion callback argument, or pointer to `uint8_t` flag when callback is `NULL`
  * \param[in]       format: C string that contains the text to be written to output
  * \param[in]       ...: Optional arguments for format string
- * \return          The number of characters that would have been written if `n` had been sufficiently large,
- *                      not counting the terminating null character.
+ * \return          `1` if message is queued, `0` if there is no space in the lane
  */
-int
-lwprintf_printf_ex(lwprintf_t* const lwobj, const char* format, ...) {
+uint8_t
+lwprintf_printf_async_prio_ex(lwprintf_t* const lwobj, uint8_t prio, lwprintf_async_done_fn done_fn, void* done_arg,
+                              const char* format, ...) {
     va_list valist;
-    int n_len;
+    uint8_t res;
 
     va_start(valist, format);
-    n_len = lwprintf_vprintf_ex(lwobj, format, valist);
+    res = lwprintf_vprintf_async_prio_ex(lwobj, prio, done_fn, done_arg, format, valist);
     va_end(valist);
 
-    return n_len;
+    return res;
 }
 
+#endif /* LWPRINTF_CFG_ASYNC_PRIO_COUNT > 1 || __DOXYGEN__ */
+
 /**
- * \brief           Write formatted data from variable argument list to sized buffer
+ * \brief           Get text of oldest queued message
+ *
+ * Text stays valid and is returned again until message is released with \ref lwprintf_async_release_block_ex.
+ * Empty messages are released by this function.
+ * With \ref LWPRINTF_CFG_ASYNC_PRIO_COUNT greater than `1`, oldest message of the highest non-empty lane is returned
+ *
  * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
- * \param[in]       s_out: Pointer to a buffer where the resulting C-string is stored.
- *                      The buffer should have a size of at least `n` characters
- * \param[in]       n_maxlen: Maximum number of bytes to be used in the buffer.
- *                      The generated string has a length of at most `n - 1`,
- *                      leaving space for the additional terminating null character
- * \param[in]       format: C string that contains a format string that follows the same specifications as format in printf
- * \param[in]       arg: A value identifying a variable arguments list initialized with `va_start`.
- *                      `va_list` is a special type defined in `<cstdarg>`.
- * \return          The number of characters that would have been written if `n` had been sufficiently large,
- *                      not counting the terminating null character.
+ * \param[out]      data: Pointer to output variable to save pointer to message text. It is not `NULL` terminated
+ * \return          Length of message text, or `0` if queue is empty
  */
-int
-lwprintf_vsnprintf_ex(lwprintf_t* const lwobj, char* s_out, size_t n_maxlen, const char* format, va_list arg) {
-    lwprintf_int_t fobj = {
-        .lwobj = LWPRINTF_GET_LWOBJ(lwobj),
-        .out_fn = prv_out_fn_write_buff,
-        .fmt = format,
-        .buff = s_out,
-        .buff_size = n_maxlen,
-    };
-    if (s_out != NULL && n_maxlen > 0) {
-        *s_out = '\0';
+size_t
+lwprintf_async_get_block_ex(lwprintf_t* const lwobj, const char** data) {
+    lwprintf_t* obj = LWPRINTF_GET_LWOBJ(lwobj);
+    uint8_t prio;
+
+    if (data == NULL) {
+        return 0;
     }
-    if (prv_format(&fobj, arg)) {
-        return (int)fobj.n_len;
+    for (prio = prv_async_lane(obj); obj->abuff[prio] != NULL && obj->abuff_r[prio] != obj->abuff_w[prio];
+         prio = prv_async_lane(obj)) {
+        const async_hdr_t* hdr = (const void*)&obj->abuff[prio][obj->abuff_r[prio]];
+
+        if (hdr->len == 0) {
+            obj->abuff_r[prio] = 0; /* Wrap marker */
+        } else if (hdr->text_len == 0) {
+            lwprintf_async_release_block_ex(obj);
+        } else {
+#if LWPRINTF_CFG_ASYNC_PRIO_COUNT > 1
+            obj->aprio_cur = prio; /* Lane does not change until message is released */
+            obj->aprio_busy = 1;
+#endif /* LWPRINTF_CFG_ASYNC_PRIO_COUNT > 1 */
+            *data = (const char*)&obj->abuff[prio][obj->abuff_r[prio] + ASYNC_HDR_SIZE];
+            return hdr->text_len;
+        }
     }
     return 0;
 }
 
 /**
- * \brief           Write formatted data from variable argument list to sized buffer
+ * \brief           Release oldest queued message and notify its completion
+ *
+ * Function shall be called by the sink, when text of the message is fully sent.
+ * It may be called from interrupt context.
+ *
  * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
- * \param[in]       s_out: Pointer to a buffer where the resulting C-string is stored.
- *                      The buffer should have a size of at least `n` characters
- * \param[in]       n_maxlen: Maximum number of bytes to be used in the buffer.
- *                      The generated string has a length of at most `n - 1`,
- *                      leaving space for the additional terminating null character
- * \param[in]       format: C string that contains a format string that follows the same specifications as format in printf
- * \param[in]       ...: Optional arguments for format string
- * \return          The number of characters that would have been written if `n` had been sufficiently large,
- *                      not counting the terminating null character.
+ * \return          `1` if message is released, `0` if queue is empty
  */
-int
-lwprintf_snprintf_ex(lwprintf_t* const lwobj, char* s_out, size_t n_maxlen, const char* format, ...) {
-    va_list valist;
-    int len;
+uint8_t
+lwprintf_async_release_block_ex(lwprintf_t* const lwobj) {
+    lwprintf_t* obj = LWPRINTF_GET_LWOBJ(lwobj);
+    const async_hdr_t* hdr;
+    lwprintf_async_done_fn done_fn;
+    void* done_arg;
+    size_t r;
+    uint8_t prio = prv_async_lane(obj);
 
-    va_start(valist, format);
-    len = lwprintf_vsnprintf_ex(lwobj, s_out, n_maxlen, format, valist);
-    va_end(valist);
+#if LWPRINTF_CFG_ASYNC_PRIO_COUNT > 1
+    obj->aprio_busy = 0;
+#endif /* LWPRINTF_CFG_ASYNC_PRIO_COUNT > 1 */
+    if (obj->abuff[prio] == NULL) {
+        return 0;
+    }
+    r = obj->abuff_r[prio];
+    if (r != obj->abuff_w[prio] && ((const async_hdr_t*)(const void*)&obj->abuff[prio][r])->len == 0) {
+        r = 0; /* Wrap marker */
+    }
+    if (r == obj->abuff_w[prio]) {
+        obj->abuff_r[prio] = r;
+        return 0;
+    }
+    hdr = (const void*)&obj->abuff[prio][r];
+    done_fn = hdr->done_fn;
+    done_arg = hdr->done_arg;
+    r += hdr->len;
+    /* Release memory before notification, so it can be reused */
+    obj->abuff_r[prio] = r == obj->abuff_size[prio] ? 0 : r;
 
-    return len;
+    if (done_fn != NULL) {
+        done_fn(obj, done_arg);
+    } else if (done_arg != NULL) {
+        *(volatile uint8_t*)done_arg = 1;
+    }
+    return 1;
+}
+
+/**
+ * \brief           Send all queued messages to the output of LwPRINTF instance
+ *
+ * Function is meant for sinks without own transfer handling, called from low priority task or idle hook.
+ * Every message is sent as single print call and completed after its output function returns
+ *
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \return          Number of sent messages
+ */
+size_t
+lwprintf_process_async_ex(lwprintf_t* const lwobj) {
+    lwprintf_t* obj = LWPRINTF_GET_LWOBJ(lwobj);
+    const char* data;
+    size_t len, cnt = 0;
+
+    /* For direct print, output function must be set by user */
+    if (!IS_OUTPUT_SET(obj)) {
+        return 0;
+    }
+    while ((len = lwprintf_async_get_block_ex(obj, &data)) > 0) {
+        lwprintf_int_t fobj = {
+            .lwobj = obj,
+            .out_fn = prv_out_fn_print,
+            .out_str_fn = prv_out_str_fn_print,
+            .out_fill_fn = prv_out_fill_fn_print,
+            .buff = NULL,
+            .buff_max_len = 0,
+        };
+
+#if LWPRINTF_CFG_OS && !LWPRINTF_CFG_OS_MANUAL_PROTECT
+        /* Output is shared with direct print functions */
+        if (!prv_mutex_wait(obj)) {
+            break;
+        }
+#endif /* LWPRINTF_CFG_OS && !LWPRINTF_CFG_OS_MANUAL_PROTECT */
+        prv_out_str_raw(&fobj, data, len);
+        fobj.out_fn(&fobj, '\0');
+#if LWPRINTF_CFG_OS && !LWPRINTF_CFG_OS_MANUAL_PROTECT
+        prv_mutex_release(obj);
+#endif /* LWPRINTF_CFG_OS && !LWPRINTF_CFG_OS_MANUAL_PROTECT */
+        lwprintf_async_release_block_ex(obj);
+        ++cnt;
+    }
+    return cnt;
 }
 
+#endif /* LWPRINTF_CFG_ENABLE_ASYNC || __DOXYGEN__ */
+
 #if LWPRINTF_CFG_OS_MANUAL_PROTECT || __DOXYGEN__
 
 /**
@@ -1167,7 +10025,7 @@ lwprintf_snprintf_ex(lwprintf_t* const lwobj, char* s_out, size_t n_maxlen, cons
 uint8_t
 lwprintf_protect_ex(lwprintf_t* const lwobj) {
     lwprintf_t* obj = LWPRINTF_GET_LWOBJ(lwobj);
-    return obj->out_fn != NULL && lwprintf_sys_mutex_isvalid(&obj->mutex) && lwprintf_sys_mutex_wait(&obj->mutex);
+    return IS_OUTPUT_SET(obj) && prv_mutex_wait(obj);
 }
 
 /**
@@ -1178,7 +10036,140 @@ lwprintf_protect_ex(lwprintf_t* const lwobj) {
 uint8_t
 lwprintf_unprotect_ex(lwprintf_t* const lwobj) {
     lwprintf_t* obj = LWPRINTF_GET_LWOBJ(lwobj);
-    return obj->out_fn != NULL && lwprintf_sys_mutex_release(&obj->mutex);
+    return IS_OUTPUT_SET(obj) && prv_mutex_release(obj);
 }
 
 #endif /* LWPRINTF_CFG_OS_MANUAL_PROTECT || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_OS_THREAD_DEFAULT || __DOXYGEN__
+
+/**
+ * \brief           Bind default instance to the calling thread
+ *
+ * All functions of the thread, called with `NULL` instance, use bound instance instead of the global one.
+ * Existing calls of functions without `_ex` suffix keep their code, but each thread may have own output
+ * and mutex, so threads do not wait for each other.
+ *
+ * \note            Instance must be initialized and stay valid, until binding is removed.
+ *                  Binding shall be removed before thread ends
+ *
+ * \param[in]       lwobj: Instance of the thread. Set to `NULL` to use global default instance again
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwprintf_set_thread_default(lwprintf_t* lwobj) {
+    return lwprintf_sys_thread_default_set(lwobj);
+}
+
+/**
+ * \brief           Get default instance of the calling thread
+ * \return          Instance bound to the thread, or global default instance if none is bound
+ */
+lwprintf_t*
+lwprintf_get_default(void) {
+    lwprintf_t* lwobj = lwprintf_sys_thread_default_get();
+
+    return lwobj != NULL ? lwobj : &lwprintf_default;
+}
+
+#endif /* LWPRINTF_CFG_OS_THREAD_DEFAULT || __DOXYGEN__ */
+
+#if LWPRINTF_CFG_STATS || LWPRINTF_CFG_OS_STATS || __DOXYGEN__
+
+/**
+ * \brief           Protect statistics of the instance with its mutex, when mutex exists
+ * \param[in,out]   obj: LwPRINTF instance
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+prv_stats_lock(lwprintf_t* obj) {
+#if LWPRINTF_CFG_OS
+    return !lwprintf_sys_mutex_isvalid(&obj->mutex) || lwprintf_sys_mutex_wait(&obj->mutex);
+#else
+    LWPRINTF_UNUSED(obj);
+    return 1;
+#endif /* LWPRINTF_CFG_OS */
+}
+
+/**
+ * \brief           Release statistics of the instance, locked with \ref prv_stats_lock
+ * \param[in,out]   obj: LwPRINTF instance
+ */
+static void
+prv_stats_unlock(lwprintf_t* obj) {
+#if LWPRINTF_CFG_OS
+    if (lwprintf_sys_mutex_isvalid(&obj->mutex)) {
+        lwprintf_sys_mutex_release(&obj->mutex);
+    }
+#else
+    LWPRINTF_UNUSED(obj);
+#endif /* LWPRINTF_CFG_OS */
+}
+
+/**
+ * \brief           Reset statistics of LwPRINTF instance and set timestamp function
+ *
+ * Timestamp function is called twice for every mutex acquisition, once for every release,
+ * and twice for every output function call, hence it shall be fast, for example reading hardware cycle counter
+ *
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       time_fn: Timestamp function. Set to `NULL` to only count events
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwprintf_init_stats_ex(lwprintf_t* lwobj, lwprintf_timestamp_fn time_fn) {
+    lwobj = LWPRINTF_GET_LWOBJ(lwobj);
+    if (!prv_stats_lock(lwobj)) {
+        return 0;
+    }
+    lwobj->stats_time_fn = time_fn;
+    memset(&lwobj->stats, 0x00, sizeof(lwobj->stats));
+    prv_stats_unlock(lwobj);
+    return 1;
+}
+
+/**
+ * \brief           Reset statistics of LwPRINTF instance, timestamp function is kept
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwprintf_reset_stats_ex(lwprintf_t* const lwobj) {
+    lwprintf_t* obj = LWPRINTF_GET_LWOBJ(lwobj);
+
+    if (!prv_stats_lock(obj)) {
+        return 0;
+    }
+    memset(&obj->stats, 0x00, sizeof(obj->stats));
+    prv_stats_unlock(obj);
+    return 1;
+}
+
+/**
+ * \brief           Get statistics of LwPRINTF instance
+ *
+ * Mutex statistics show time spent waiting to print, and help to decide when instance shall be split,
+ * or when output shall be buffered. Output statistics show how much is printed,
+ * and whether time is spent in formatting or in the output function.
+ *
+ * \note            Statistics are updated with mutex held. Contended acquisitions are detected
+ *                  without system support, so their number is approximate.
+ *                  Buffer functions of shared instance are not protected and their counts may be approximate too
+ *
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[out]      stats: Output variable to save statistics
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwprintf_get_stats_ex(lwprintf_t* const lwobj, lwprintf_stats_t* stats) {
+    lwprintf_t* obj = LWPRINTF_GET_LWOBJ(lwobj);
+
+    if (stats == NULL || !prv_stats_lock(obj)) {
+        return 0;
+    }
+    *stats = obj->stats;
+    prv_stats_unlock(obj);
+    return 1;
+}
+
+#endif /* LWPRINTF_CFG_STATS || LWPRINTF_CFG_OS_STATS || __DOXYGEN__ */
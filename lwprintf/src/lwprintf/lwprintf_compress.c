@@ -0,0 +1,243 @@
+/**
+ * \file            lwprintf_compress.c
+ * \brief           Streaming LZSS compression of the output
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwPRINTF - Lightweight stdio manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v1.0.6
+ */
+#include <string.h>
+#include "lwprintf/lwprintf_compress.h"
+
+#if LWPRINTF_CFG_ENABLE_COMPRESS || __DOXYGEN__
+
+#if !LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT
+#error "LWPRINTF_CFG_ENABLE_COMPRESS requires LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT"
+#endif /* !LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT */
+#if (LWPRINTF_CFG_COMPRESS_HASH_SIZE & (LWPRINTF_CFG_COMPRESS_HASH_SIZE - 1)) != 0
+#error "LWPRINTF_CFG_COMPRESS_HASH_SIZE must be power of 2"
+#endif /* (LWPRINTF_CFG_COMPRESS_HASH_SIZE & (LWPRINTF_CFG_COMPRESS_HASH_SIZE - 1)) != 0 */
+
+/*
+ * Compressed stream is sequence of groups.
+ * Group starts with flags byte, followed by up to `8` items, described by flags from LSB on.
+ * Flag `0` is literal byte, flag `1` is `2` bytes reference in big endian order,
+ * with distance in upper `11` bits and match length minus `3` in lower `5` bits.
+ *
+ * Reference with distance `0` ends the group early, when output is flushed.
+ * Its length field set to `31` also clears the history of the decoder.
+ */
+#define CMP_MIN_LEN    3
+#define CMP_MAX_LEN    (CMP_MIN_LEN + 31)
+#define CMP_MAX_DIST   0x7FFU
+#define CMP_LEN_RESET  31U
+
+/**
+ * \brief           Hash of `3` bytes
+ * \param[in]       d: Pointer to first byte
+ */
+#define CMP_HASH(d)                                                                                                    \
+    ((((uint32_t)(d)[0] << 8) ^ ((uint32_t)(d)[1] << 4) ^ (uint32_t)(d)[2]) & (LWPRINTF_CFG_COMPRESS_HASH_SIZE - 1))
+
+/**
+ * \brief           Send current group to the output function
+ * \param[in,out]   cmp: Compression object
+ */
+static void
+prv_cmp_send_group(lwprintf_compress_t* cmp) {
+    for (size_t i = 0; i < cmp->group_len && !cmp->failed; ++i) {
+        /* Output function returns `ch` on success, returned `0` is failure only for non-zero byte */
+        if (cmp->out_fn(cmp->group[i], &cmp->lw) == 0 && cmp->group[i] != 0) {
+            cmp->failed = 1;
+        }
+    }
+    cmp->out_cnt += cmp->group_len;
+    cmp->group_len = 0;
+    cmp->group_items = 0;
+}
+
+/**
+ * \brief           Add item to current group and send the group, when it is full
+ * \param[in,out]   cmp: Compression object
+ * \param[in]       ref: Set to `1` for reference, `0` for literal
+ * \param[in]       val: Literal byte or reference value
+ */
+static void
+prv_cmp_add_item(lwprintf_compress_t* cmp, uint8_t ref, uint32_t val) {
+    if (cmp->group_items == 0) {
+        cmp->group[0] = 0;
+        cmp->group_len = 1;
+    }
+    if (ref) {
+        cmp->group[0] |= (unsigned char)(1U << cmp->group_items);
+        cmp->group[cmp->group_len++] = (unsigned char)(val >> 8);
+    }
+    cmp->group[cmp->group_len++] = (unsigned char)val;
+    if (++cmp->group_items == 8) {
+        prv_cmp_send_group(cmp);
+    }
+}
+
+/**
+ * \brief           Get byte of the history or of the current data
+ * \param[in]       cmp: Compression object
+ * \param[in]       data: Current data, that starts at history position
+ * \param[in]       p: Absolute position of the byte
+ * \return          Byte value
+ */
+static unsigned char
+prv_cmp_byte(const lwprintf_compress_t* cmp, const unsigned char* data, uint32_t p) {
+    return p < cmp->pos ? cmp->window[p & (cmp->window_size - 1)] : data[p - cmp->pos];
+}
+
+/**
+ * \brief           Block output function of compression instance
+ * \param[in]       data: Data to print
+ * \param[in]       len: Number of characters to print
+ * \param[in]       lwobj: Instance of compression object
+ * \return          `len` on success, `0` when output function failed
+ */
+static int
+prv_cmp_out_block(const char* data, size_t len, lwprintf_t* lwobj) {
+    return (int)lwprintf_compress_write(lwobj->arg, data, len);
+}
+
+/**
+ * \brief           Initialize compression object
+ * \param[out]      cmp: Compression object
+ * \param[in]       out_fn: Output function, that gets compressed bytes. Byte with value `0` is regular data.
+ *                      Function returns `ch` on success and `0` on failure, that can be detected for non-zero bytes only
+ * \param[in]       window: History window memory. Larger window finds more repeated text
+ * \param[in]       window_size: Size of history window, power of `2` from `256` to `2048` bytes
+ * \param[in]       staging: Staging buffer of the instance. Compressed output is flushed,
+ *                      when staging buffer is full or when print call ends
+ * \param[in]       staging_size: Size of staging buffer in units of bytes
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwprintf_compress_init(lwprintf_compress_t* cmp, lwprintf_output_fn out_fn, void* window, size_t window_size,
+                       char* staging, size_t staging_size) {
+    if (cmp == NULL || out_fn == NULL || window == NULL || window_size < 256 || window_size > 2048
+        || (window_size & (window_size - 1)) != 0 || staging == NULL || staging_size == 0) {
+        return 0;
+    }
+    memset(cmp, 0x00, sizeof(*cmp));
+    cmp->out_fn = out_fn;
+    cmp->window = window;
+    cmp->window_size = (uint32_t)window_size;
+    if (!lwprintf_init_block_ex(&cmp->lw, prv_cmp_out_block, staging, staging_size)) {
+        return 0;
+    }
+    cmp->lw.arg = cmp;
+    return 1;
+}
+
+/**
+ * \brief           Get instance, that prints compressed text
+ * \param[in]       cmp: Compression object
+ * \return          Instance handle
+ */
+lwprintf_t*
+lwprintf_compress_get_instance(lwprintf_compress_t* cmp) {
+    return &cmp->lw;
+}
+
+/**
+ * \brief           Compress data and flush it to the output function
+ *
+ * Matches are found with single hash lookup, that costs constant time per byte.
+ * History is kept between calls, so repeated text of earlier calls is compressed too.
+ *
+ * \param[in,out]   cmp: Compression object
+ * \param[in]       data: Data to compress
+ * \param[in]       len: Number of bytes to compress
+ * \return          `len` on success, `0` when output function failed
+ */
+size_t
+lwprintf_compress_write(lwprintf_compress_t* cmp, const char* data, size_t len) {
+    const unsigned char* d = (const void*)data;
+    uint32_t max_dist = cmp->window_size < CMP_MAX_DIST ? cmp->window_size : CMP_MAX_DIST;
+
+    cmp->failed = 0;
+    for (size_t i = 0; i < len;) {
+        size_t match_len = 0, max_len = len - i < CMP_MAX_LEN ? len - i : CMP_MAX_LEN;
+        uint32_t dist = 0;
+
+        /* Candidate is the last position with the same hash, it must be inside the window */
+        if (max_len >= CMP_MIN_LEN) {
+            dist = (uint16_t)((uint16_t)cmp->pos - cmp->head[CMP_HASH(&d[i])]);
+            if (dist > 0 && dist <= max_dist && dist <= cmp->pos) {
+                while (match_len < max_len
+                       && prv_cmp_byte(cmp, &d[i], cmp->pos - dist + (uint32_t)match_len) == d[i + match_len]) {
+                    ++match_len;
+                }
+            }
+        }
+        if (match_len >= CMP_MIN_LEN) {
+            prv_cmp_add_item(cmp, 1, (dist << 5) | (uint32_t)(match_len - CMP_MIN_LEN));
+        } else {
+            match_len = 1;
+            prv_cmp_add_item(cmp, 0, d[i]);
+        }
+
+        /* Move consumed bytes to the history */
+        for (size_t end = i + match_len; i < end; ++i) {
+            if (len - i >= CMP_MIN_LEN) {
+                cmp->head[CMP_HASH(&d[i])] = (uint16_t)cmp->pos;
+            }
+            cmp->window[cmp->pos & (cmp->window_size - 1)] = d[i];
+            ++cmp->pos;
+        }
+    }
+    cmp->in_cnt += (uint32_t)len;
+
+    /* Unfinished group is closed, so that receiver can decode all the text */
+    if (cmp->group_items > 0) {
+        prv_cmp_add_item(cmp, 1, 0);
+        prv_cmp_send_group(cmp);
+    }
+    return cmp->failed ? 0 : len;
+}
+
+/**
+ * \brief           Clear history of the compressor and of the decoder
+ *
+ * Use it when receiver connects to the link later, so that it can decode the following text.
+ *
+ * \param[in,out]   cmp: Compression object
+ */
+void
+lwprintf_compress_reset(lwprintf_compress_t* cmp) {
+    cmp->failed = 0;
+    prv_cmp_add_item(cmp, 1, CMP_LEN_RESET);
+    prv_cmp_send_group(cmp);
+    cmp->pos = 0;
+    memset(cmp->head, 0x00, sizeof(cmp->head));
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_COMPRESS || __DOXYGEN__ */
@@ -0,0 +1,265 @@
+/**
+ * \file            lwprintf_crashlog.c
+ * \brief           Persistent crash log in no-init RAM
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwPRINTF - Lightweight stdio manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v1.0.6
+ */
+#include <string.h>
+#include "lwprintf/lwprintf_crashlog.h"
+
+#if LWPRINTF_CFG_ENABLE_CRASHLOG || __DOXYGEN__
+
+#if !LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT
+#error "LWPRINTF_CFG_ENABLE_CRASHLOG requires LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT"
+#endif /* !LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT */
+
+/* Magic value of valid header, "LWCL" */
+#define CRASHLOG_MAGIC 0x4C57434CUL
+
+/**
+ * \brief           Calculate CRC-32 of the header, without its CRC field
+ * \param[in]       hdr: Log header
+ * \return          CRC-32 value
+ */
+static uint32_t
+prv_crashlog_crc(const lwprintf_crashlog_hdr_t* hdr) {
+    const unsigned char* d = (const void*)hdr;
+    uint32_t crc = 0xFFFFFFFFUL;
+
+    for (size_t i = 0; i < offsetof(lwprintf_crashlog_hdr_t, crc); ++i) {
+        crc ^= d[i];
+        for (size_t b = 0; b < 8; ++b) {
+            crc = (crc >> 1) ^ (0xEDB88320UL & (0UL - (crc & 1UL)));
+        }
+    }
+    return ~crc;
+}
+
+/**
+ * \brief           Check if header in no-init memory belongs to valid log of the same size
+ * \param[in]       hdr: Log header
+ * \param[in]       size: Expected size of data area
+ * \return          `1` if header is valid, `0` otherwise
+ */
+static uint8_t
+prv_crashlog_is_valid(const lwprintf_crashlog_hdr_t* hdr, size_t size) {
+    return hdr->magic == CRASHLOG_MAGIC && hdr->size == size && hdr->pos < size && hdr->len <= size
+           && hdr->crc == prv_crashlog_crc(hdr);
+}
+
+/**
+ * \brief           Block output function of crash log instance
+ * \param[in]       data: Data to print
+ * \param[in]       len: Number of characters to print
+ * \param[in]       lwobj: Instance of the log
+ * \return          `len` value, log never refuses data
+ */
+static int
+prv_crashlog_out_block(const char* data, size_t len, lwprintf_t* lwobj) {
+    return (int)lwprintf_crashlog_write(lwobj->arg, data, len);
+}
+
+/**
+ * \brief           Initialize crash log and restore its content after warm reset
+ *
+ * Memory shall be placed to the section, that is not cleared by startup code, such as `.noinit`.
+ * When header in memory is valid, content is kept and new text is appended to it.
+ * Otherwise log starts empty.
+ *
+ * \param[out]      log: Crash log object
+ * \param[in]       mem: No-init memory of the log, aligned to `uint32_t`
+ * \param[in]       mem_size: Size of memory in units of bytes, including the header
+ * \param[in]       staging: Staging buffer of the instance. Set to `NULL` to write every character directly
+ * \param[in]       staging_size: Size of staging buffer in units of bytes
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwprintf_crashlog_init(lwprintf_crashlog_t* log, void* mem, size_t mem_size, char* staging, size_t staging_size) {
+    lwprintf_crashlog_hdr_t* hdr = mem;
+    size_t size;
+
+    if (log == NULL || mem == NULL || (uintptr_t)mem % sizeof(uint32_t) != 0
+        || mem_size <= sizeof(lwprintf_crashlog_hdr_t)) {
+        return 0;
+    }
+    size = mem_size - sizeof(lwprintf_crashlog_hdr_t);
+    memset(log, 0x00, sizeof(*log));
+    log->hdr = hdr;
+    log->data = (char*)mem + sizeof(lwprintf_crashlog_hdr_t);
+    if (prv_crashlog_is_valid(hdr, size)) {
+        log->restored = hdr->len;
+        ++hdr->resets;
+    } else {
+        memset(hdr, 0x00, sizeof(*hdr));
+        hdr->magic = CRASHLOG_MAGIC;
+        hdr->size = (uint32_t)size;
+    }
+    hdr->crc = prv_crashlog_crc(hdr);
+    if (!lwprintf_init_block_ex(&log->lw, prv_crashlog_out_block, staging, staging_size)) {
+        return 0;
+    }
+    log->lw.arg = log;
+    return 1;
+}
+
+/**
+ * \brief           Get instance, that prints to the crash log
+ * \param[in]       log: Crash log object
+ * \return          Instance handle
+ */
+lwprintf_t*
+lwprintf_crashlog_get_instance(lwprintf_crashlog_t* log) {
+    return &log->lw;
+}
+
+/**
+ * \brief           Write data to the crash log, oldest data is overwritten when log is full
+ *
+ * Bytes, that are about to be overwritten, are removed from the log before the copy,
+ * so reset in the middle of the write never leaves partially overwritten text in the log.
+ * Function can be used directly as part of block output function of other instance, such as fan-out sink.
+ *
+ * \param[in,out]   log: Crash log object
+ * \param[in]       data: Data to write
+ * \param[in]       len: Number of bytes to write
+ * \return          `len` value
+ */
+size_t
+lwprintf_crashlog_write(lwprintf_crashlog_t* log, const char* data, size_t len) {
+    lwprintf_crashlog_hdr_t* hdr = log->hdr;
+
+    for (size_t i = 0, seg; i < len; i += seg) {
+        seg = len - i;
+        if (seg > hdr->size - hdr->pos) {
+            seg = hdr->size - hdr->pos;
+        }
+        if (log->spill_fn != NULL && seg > log->page_size - hdr->pos % log->page_size) {
+            seg = log->page_size - hdr->pos % log->page_size;
+        }
+
+        /* Drop oldest bytes first, then copy new ones and publish them */
+        if (hdr->len + seg > hdr->size) {
+            hdr->len = hdr->size - (uint32_t)seg;
+            hdr->crc = prv_crashlog_crc(hdr);
+        }
+        memcpy(&log->data[hdr->pos], &data[i], seg);
+        hdr->pos = (hdr->pos + (uint32_t)seg) % hdr->size;
+        hdr->len += (uint32_t)seg;
+        hdr->crc = prv_crashlog_crc(hdr);
+
+        /* Page is full, store it to the next flash page */
+        if (log->spill_fn != NULL && hdr->pos % log->page_size == 0) {
+            uint32_t start = (hdr->pos > 0 ? hdr->pos : hdr->size) - log->page_size;
+
+            log->spill_fn(hdr->spill_seq % log->page_cnt, hdr->spill_seq, &log->data[start], log->page_size,
+                          log->spill_arg);
+            ++hdr->spill_seq;
+            hdr->crc = prv_crashlog_crc(hdr);
+        }
+    }
+    return len;
+}
+
+/**
+ * \brief           Read content of the log, from the oldest byte on
+ * \param[in]       log: Crash log object
+ * \param[in]       offset: Offset from the oldest byte in the log
+ * \param[out]      buff: Buffer to copy data to
+ * \param[in]       buff_size: Size of the buffer in units of bytes
+ * \return          Number of bytes copied to the buffer, `0` at the end of the log
+ */
+size_t
+lwprintf_crashlog_read(const lwprintf_crashlog_t* log, size_t offset, char* buff, size_t buff_size) {
+    const lwprintf_crashlog_hdr_t* hdr = log->hdr;
+    size_t start, cnt, first;
+
+    if (offset >= hdr->len) {
+        return 0;
+    }
+    cnt = hdr->len - offset < buff_size ? hdr->len - offset : buff_size;
+    start = (hdr->pos + hdr->size - hdr->len + offset) % hdr->size;
+    first = hdr->size - start < cnt ? hdr->size - start : cnt;
+    memcpy(buff, &log->data[start], first);
+    memcpy(&buff[first], log->data, cnt - first);
+    return cnt;
+}
+
+/**
+ * \brief           Get number of bytes in the log
+ * \param[in]       log: Crash log object
+ * \return          Number of bytes, available with \ref lwprintf_crashlog_read
+ */
+size_t
+lwprintf_crashlog_get_len(const lwprintf_crashlog_t* log) {
+    return log->hdr->len;
+}
+
+/**
+ * \brief           Remove all data from the log, typically after it was read at boot
+ *
+ * Reset counter and spill sequence number are kept.
+ *
+ * \param[in,out]   log: Crash log object
+ */
+void
+lwprintf_crashlog_clear(lwprintf_crashlog_t* log) {
+    log->hdr->pos = 0;
+    log->hdr->len = 0;
+    log->hdr->crc = prv_crashlog_crc(log->hdr);
+    log->restored = 0;
+}
+
+/**
+ * \brief           Set function, that spills every full page of the log to flash
+ *
+ * Pages are written in round-robin order over `page_cnt` flash pages, so that wear is spread evenly.
+ * Sequence number is kept in no-init memory, and continues after warm reset.
+ *
+ * \param[in,out]   log: Crash log object
+ * \param[in]       fn: Spill function. Set to `NULL` to disable spilling
+ * \param[in]       arg: User argument, passed to spill function
+ * \param[in]       page_size: Size of one page. Data area of the log must be its multiple
+ * \param[in]       page_cnt: Number of flash pages, used in rotation
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwprintf_crashlog_set_spill(lwprintf_crashlog_t* log, lwprintf_crashlog_spill_fn fn, void* arg, size_t page_size,
+                            size_t page_cnt) {
+    if (fn != NULL && (page_size == 0 || page_cnt == 0 || log->hdr->size % page_size != 0)) {
+        return 0;
+    }
+    log->spill_fn = fn;
+    log->spill_arg = arg;
+    log->page_size = (uint32_t)page_size;
+    log->page_cnt = (uint32_t)page_cnt;
+    return 1;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_CRASHLOG || __DOXYGEN__ */
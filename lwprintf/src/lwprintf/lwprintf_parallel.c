@@ -0,0 +1,182 @@
+/**
+ * \file            lwprintf_parallel.c
+ * \brief           Parallel formatting of many print jobs
+ */
+
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwPRINTF - Lightweight stdio manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v1.0.6
+ */
+#include "lwprintf/lwprintf_parallel.h"
+
+#if LWPRINTF_CFG_ENABLE_PARALLEL || __DOXYGEN__
+
+#if !LWPRINTF_CFG_ENABLE_PACKED_ARGS
+#error "LWPRINTF_CFG_ENABLE_PARALLEL requires LWPRINTF_CFG_ENABLE_PACKED_ARGS"
+#endif /* !LWPRINTF_CFG_ENABLE_PACKED_ARGS */
+
+#define BATCH_STATE_MEASURE 0 /*!< Lengths of jobs are measured */
+#define BATCH_STATE_FORMAT  1 /*!< Offsets are known, text of jobs is written */
+#define BATCH_STATE_FULL    2 /*!< Text of all jobs does not fit to the arena */
+
+/**
+ * \brief           Calculate offsets from measured lengths, called by the thread that measured the last job
+ * \param[in,out]   fb: Batch object
+ */
+static void
+prv_batch_offsets(lwprintf_format_batch_t* fb) {
+    for (size_t i = 0; i < fb->jobs_cnt; ++i) {
+        fb->offsets[i + 1] += fb->offsets[i];
+    }
+    if (fb->offsets[fb->jobs_cnt] < fb->arena_size) {
+        fb->arena[fb->offsets[fb->jobs_cnt]] = '\0';
+        atomic_store_explicit(&fb->state, BATCH_STATE_FORMAT, memory_order_release);
+    } else {
+        atomic_store_explicit(&fb->state, BATCH_STATE_FULL, memory_order_release);
+    }
+}
+
+/**
+ * \brief           Take jobs from the batch until there is nothing left
+ *
+ * Every thread claims next job with single atomic increment, so that fast threads take more jobs.
+ *
+ * \param[in,out]   fb: Batch object
+ */
+static void
+prv_batch_run(lwprintf_format_batch_t* fb) {
+    size_t i;
+    unsigned int state;
+
+    /* Measure pass, only length of the job is stored */
+    while ((i = atomic_fetch_add_explicit(&fb->measure_next, 1, memory_order_relaxed)) < fb->jobs_cnt) {
+        int len = lwprintf_write_packed_ex(fb->lwobj, NULL, 0, fb->jobs[i].format, fb->jobs[i].args);
+
+        fb->offsets[i + 1] = len > 0 ? (size_t)len : 0;
+        if (atomic_fetch_add_explicit(&fb->measure_done, 1, memory_order_acq_rel) == fb->jobs_cnt - 1) {
+            prv_batch_offsets(fb);
+        }
+    }
+
+    /* Wait for jobs, that are still measured by other threads */
+    while ((state = atomic_load_explicit(&fb->state, memory_order_acquire)) == BATCH_STATE_MEASURE) {}
+
+    /* Format pass, every job writes exactly its length to its own offset */
+    if (state == BATCH_STATE_FORMAT) {
+        while ((i = atomic_fetch_add_explicit(&fb->format_next, 1, memory_order_relaxed)) < fb->jobs_cnt) {
+            lwprintf_write_packed_ex(fb->lwobj, &fb->arena[fb->offsets[i]], fb->offsets[i + 1] - fb->offsets[i],
+                                     fb->jobs[i].format, fb->jobs[i].args);
+        }
+    }
+}
+
+/**
+ * \brief           Initialize batch object
+ * \param[out]      fb: Batch object
+ * \param[in]       lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       jobs: Array of jobs
+ * \param[in]       jobs_cnt: Number of jobs
+ * \param[out]      offsets: Array of `jobs_cnt + 1` entries. After the batch, text of job `i`
+ *                      starts at `offsets[i]`, and `offsets[jobs_cnt]` is total length of the text
+ * \param[out]      arena: Output buffer for text of all jobs, followed by terminating null character
+ * \param[in]       arena_size: Size of output buffer in units of bytes
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwprintf_format_batch_init(lwprintf_format_batch_t* fb, lwprintf_t* lwobj, const lwprintf_job_t* jobs,
+                           size_t jobs_cnt, size_t* offsets, char* arena, size_t arena_size) {
+    if (fb == NULL || (jobs == NULL && jobs_cnt > 0) || offsets == NULL || arena == NULL) {
+        return 0;
+    }
+    fb->lwobj = lwobj;
+    fb->jobs = jobs;
+    fb->jobs_cnt = jobs_cnt;
+    fb->offsets = offsets;
+    fb->arena = arena;
+    fb->arena_size = arena_size;
+    offsets[0] = 0;
+    atomic_init(&fb->measure_next, 0);
+    atomic_init(&fb->measure_done, 0);
+    atomic_init(&fb->format_next, 0);
+    atomic_init(&fb->active, 0);
+    atomic_init(&fb->state, BATCH_STATE_MEASURE);
+    if (jobs_cnt == 0) {
+        prv_batch_offsets(fb);
+    }
+    return 1;
+}
+
+/**
+ * \brief           Format jobs of the batch on the calling thread
+ * \note            Function shall be called exactly once for every call of post function,
+ *                  from the thread of the worker pool
+ * \param[in,out]   fb: Batch object
+ */
+void
+lwprintf_format_batch_work(lwprintf_format_batch_t* fb) {
+    prv_batch_run(fb);
+    atomic_fetch_sub_explicit(&fb->active, 1, memory_order_release);
+}
+
+/**
+ * \brief           Format all jobs of the batch, split across worker pool and the calling thread
+ *
+ * Length of every job is measured in parallel first, and offsets of jobs are calculated from lengths.
+ * Text of every job is then written in parallel to its own offset, so that arena holds text of all jobs
+ * in order of jobs, followed by terminating null character.
+ *
+ * \note            Instance is shared by all threads, its format cache and statistics are not used
+ *
+ * \param[in,out]   fb: Batch object, initialized with \ref lwprintf_format_batch_init
+ * \param[in]       post_fn: Function to post one call of \ref lwprintf_format_batch_work to worker pool.
+ *                      Set to `NULL` to format all jobs on the calling thread
+ * \param[in]       arg: User argument for post function
+ * \param[in]       workers: Number of calls of post function
+ * \return          `1` on success, `0` if text does not fit to the arena.
+ *                      Offsets are valid in both cases, and `offsets[jobs_cnt] + 1` is required arena size
+ */
+uint8_t
+lwprintf_format_batch(lwprintf_format_batch_t* fb, lwprintf_format_batch_post_fn post_fn, void* arg,
+                      size_t workers) {
+    if (fb == NULL) {
+        return 0;
+    }
+    if (post_fn != NULL) {
+        atomic_store_explicit(&fb->active, workers, memory_order_relaxed);
+        for (size_t i = 0; i < workers; ++i) {
+            post_fn(fb, arg);
+        }
+    }
+    prv_batch_run(fb);
+
+    /* Batch object must stay valid, until every posted call returns */
+    while (atomic_load_explicit(&fb->active, memory_order_acquire) > 0) {}
+    return atomic_load_explicit(&fb->state, memory_order_relaxed) == BATCH_STATE_FORMAT;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_PARALLEL || __DOXYGEN__ */
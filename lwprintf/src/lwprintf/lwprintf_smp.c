@@ -0,0 +1,242 @@
+/**
+ * \file            lwprintf_smp.c
+ * \brief           Per-core instances with timestamp ordered merge
+ */
+
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwPRINTF - Lightweight stdio manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v1.0.6
+ */
+#include <string.h>
+#include "lwprintf/lwprintf_smp.h"
+
+#if LWPRINTF_CFG_ENABLE_SMP || __DOXYGEN__
+
+#if !LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT || !LWPRINTF_CFG_SUPPORT_TYPE_STRING
+#error "LWPRINTF_CFG_ENABLE_SMP requires LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT and LWPRINTF_CFG_SUPPORT_TYPE_STRING"
+#endif /* !LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT || !LWPRINTF_CFG_SUPPORT_TYPE_STRING */
+
+/**
+ * \brief           Header of record in the ring buffer, followed by text.
+ * Length is the first member, wrap marker fits to the last aligned word of the buffer
+ */
+typedef struct {
+    uint32_t len; /*!< Length of text. `0` means wrap to buffer beginning */
+    uint32_t ts;  /*!< Global timestamp, when record was written */
+} smp_hdr_t;
+
+/**
+ * \brief           Round up length to the alignment of records
+ * \param[in]       x: Length or position to round up
+ */
+#define SMP_ALIGN_UP(x) (((x) + sizeof(uint32_t) - 1) & ~(sizeof(uint32_t) - 1))
+
+/**
+ * \brief           Block output function of per-core instance, writing one timestamped record
+ * \param[in]       data: Data to print
+ * \param[in]       len: Number of characters to print
+ * \param[in]       lwobj: Instance of the core
+ * \return          `len` on success, `0` if ring buffer is full
+ */
+static int
+prv_smp_out_block(const char* data, size_t len, lwprintf_t* lwobj) {
+    lwprintf_smp_channel_t* ch = lwobj->arg;
+    size_t r, w, pos, rec_len = SMP_ALIGN_UP(sizeof(smp_hdr_t) + len);
+    smp_hdr_t* hdr;
+
+    /* Find contiguous space, write position never catches up read position */
+    r = atomic_load_explicit(&ch->r, memory_order_acquire);
+    w = atomic_load_explicit(&ch->w, memory_order_relaxed);
+    if (w >= r) {
+        if (rec_len < ch->size - w || (rec_len == ch->size - w && r > 0)) {
+            pos = w;
+        } else if (rec_len < r) {
+            ((smp_hdr_t*)(void*)&ch->buff[w])->len = 0; /* Not enough space at the end, wrap */
+            pos = 0;
+        } else {
+            ++ch->dropped;
+            return 0;
+        }
+    } else if (rec_len < r - w) {
+        pos = w;
+    } else {
+        ++ch->dropped;
+        return 0;
+    }
+
+    /* Timestamp is taken just before record is published */
+    hdr = (void*)&ch->buff[pos];
+    hdr->len = (uint32_t)len;
+    memcpy(&ch->buff[pos + sizeof(smp_hdr_t)], data, len);
+    hdr->ts = ch->smp->time_fn();
+    pos += rec_len;
+    atomic_store_explicit(&ch->w, pos == ch->size ? 0 : pos, memory_order_release);
+    return (int)len;
+}
+
+/**
+ * \brief           Get oldest record of per-core instance
+ * \param[in,out]   ch: Instance of the core
+ * \return          Record header, or `NULL` if ring buffer is empty
+ */
+static const smp_hdr_t*
+prv_smp_peek(lwprintf_smp_channel_t* ch) {
+    size_t r = atomic_load_explicit(&ch->r, memory_order_relaxed);
+
+    while (r != atomic_load_explicit(&ch->w, memory_order_acquire)) {
+        const smp_hdr_t* hdr = (const void*)&ch->buff[r];
+
+        if (hdr->len > 0) {
+            return hdr;
+        }
+        r = 0; /* Wrap marker */
+        atomic_store_explicit(&ch->r, r, memory_order_release);
+    }
+    return NULL;
+}
+
+/**
+ * \brief           Initialize merge object
+ * \param[out]      smp: Merge object
+ * \param[in]       channels: Array of per-core instances, initialized later with \ref lwprintf_smp_channel_init
+ * \param[in]       channels_cnt: Number of per-core instances
+ * \param[in]       out: Final instance, that gets merged output
+ * \param[in]       time_fn: Global timestamp function, giving the same time on all cores
+ * \param[in]       window: Time to wait for records of other cores, before record is sent.
+ *                      It must be longer than the time between timestamp and publish of any record
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwprintf_smp_init(lwprintf_smp_t* smp, lwprintf_smp_channel_t* channels, size_t channels_cnt, lwprintf_t* out,
+                  lwprintf_smp_time_fn time_fn, uint32_t window) {
+    if (smp == NULL || channels == NULL || channels_cnt == 0 || out == NULL || time_fn == NULL) {
+        return 0;
+    }
+    memset(channels, 0x00, sizeof(*channels) * channels_cnt);
+    smp->channels = channels;
+    smp->channels_cnt = channels_cnt;
+    smp->out = out;
+    smp->time_fn = time_fn;
+    smp->window = window;
+    return 1;
+}
+
+/**
+ * \brief           Initialize instance of single core
+ *
+ * Text of every print call is collected in the staging buffer,
+ * and written to the ring buffer as one record, when print call ends or staging buffer is full.
+ *
+ * \param[in,out]   smp: Merge object
+ * \param[in]       idx: Index of the core
+ * \param[in]       buff: Ring buffer memory, aligned to `uint32_t`
+ * \param[in]       buff_size: Size of ring buffer in units of bytes
+ * \param[in]       staging: Staging buffer of the instance. It sets maximum record length
+ * \param[in]       staging_size: Size of staging buffer in units of bytes
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwprintf_smp_channel_init(lwprintf_smp_t* smp, size_t idx, void* buff, size_t buff_size, char* staging,
+                          size_t staging_size) {
+    lwprintf_smp_channel_t* ch;
+
+    if (smp == NULL || idx >= smp->channels_cnt || buff == NULL || (uintptr_t)buff % sizeof(uint32_t) != 0
+        || buff_size < 2 * sizeof(smp_hdr_t)) {
+        return 0;
+    }
+    ch = &smp->channels[idx];
+    ch->buff = buff;
+    ch->size = buff_size - buff_size % sizeof(uint32_t);
+    atomic_init(&ch->r, 0);
+    atomic_init(&ch->w, 0);
+    ch->dropped = 0;
+    ch->smp = smp;
+    if (!lwprintf_init_block_ex(&ch->lw, prv_smp_out_block, staging, staging_size)) {
+        return 0;
+    }
+    ch->lw.arg = ch;
+    return 1;
+}
+
+/**
+ * \brief           Get instance of single core, used for print operations
+ * \param[in]       smp: Merge object
+ * \param[in]       idx: Index of the core
+ * \return          Instance handle, or `NULL` if index is invalid
+ */
+lwprintf_t*
+lwprintf_smp_get_instance(lwprintf_smp_t* smp, size_t idx) {
+    return smp != NULL && idx < smp->channels_cnt ? &smp->channels[idx].lw : NULL;
+}
+
+/**
+ * \brief           Send records of all cores in time order to the final instance
+ *
+ * Oldest record is sent, when every core has some record waiting,
+ * or when it is older than merge window, as later records of other cores cannot be older anymore.
+ *
+ * \note            Function shall be called periodically from single merge task
+ *
+ * \param[in,out]   smp: Merge object
+ * \return          Number of sent records
+ */
+size_t
+lwprintf_smp_process(lwprintf_smp_t* smp) {
+    size_t cnt = 0;
+
+    while (1) {
+        lwprintf_smp_channel_t* best_ch = NULL;
+        const smp_hdr_t* best = NULL;
+        uint8_t all = 1;
+        uint32_t now = smp->time_fn();
+        size_t r;
+
+        for (size_t i = 0; i < smp->channels_cnt; ++i) {
+            const smp_hdr_t* hdr;
+
+            if (smp->channels[i].smp == NULL || (hdr = prv_smp_peek(&smp->channels[i])) == NULL) {
+                all = 0;
+            } else if (best == NULL || (int32_t)(hdr->ts - best->ts) < 0) {
+                best = hdr;
+                best_ch = &smp->channels[i];
+            }
+        }
+        if (best == NULL || (!all && (uint32_t)(now - best->ts) < smp->window)) {
+            break;
+        }
+
+        /* Send record as one print call and release it */
+        lwprintf_printf_ex(smp->out, "%.*s", (int)best->len, (const char*)best + sizeof(smp_hdr_t));
+        r = (size_t)((const unsigned char*)best - best_ch->buff) + SMP_ALIGN_UP(sizeof(smp_hdr_t) + best->len);
+        atomic_store_explicit(&best_ch->r, r == best_ch->size ? 0 : r, memory_order_release);
+        ++cnt;
+    }
+    return cnt;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_SMP || __DOXYGEN__ */
@@ -0,0 +1,110 @@
+/**
+ * \file            lwprintf_sink_itm.c
+ * \brief           Block output sink for Cortex-M ITM stimulus port
+ */
+
+
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwPRINTF - Lightweight stdio manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v1.0.6
+ */
+#include "system/lwprintf_sink_itm.h"
+
+#if !__DOXYGEN__
+
+/* ITM registers, stimulus port accepts 8-, 16- and 32-bit writes with the same number of bytes on SWO */
+#define ITM_STIM_U32   (*(volatile uint32_t*)(LWPRINTF_ITM_BASE + 4UL * LWPRINTF_ITM_PORT))
+#define ITM_STIM_U16   (*(volatile uint16_t*)(LWPRINTF_ITM_BASE + 4UL * LWPRINTF_ITM_PORT))
+#define ITM_STIM_U8    (*(volatile uint8_t*)(LWPRINTF_ITM_BASE + 4UL * LWPRINTF_ITM_PORT))
+#define ITM_TER        (*(volatile uint32_t*)(LWPRINTF_ITM_BASE + 0xE00UL))
+#define ITM_TCR        (*(volatile uint32_t*)(LWPRINTF_ITM_BASE + 0xE80UL))
+#define ITM_TCR_ITMENA 0x00000001UL
+
+#endif /* !__DOXYGEN__ */
+
+/**
+ * \brief           Wait until stimulus port can accept next write
+ */
+static void
+prv_itm_wait_ready(void) {
+    while ((ITM_STIM_U32 & 0x01UL) == 0) {}
+}
+
+/**
+ * \brief           Check if ITM and its stimulus port are enabled, usually by the debugger
+ * \return          `1` if enabled, `0` otherwise
+ */
+uint8_t
+lwprintf_itm_is_enabled(void) {
+    return (ITM_TCR & ITM_TCR_ITMENA) != 0 && (ITM_TER & (1UL << LWPRINTF_ITM_PORT)) != 0;
+}
+
+/**
+ * \brief           Block output function, that sends text to ITM stimulus port.
+ *
+ * Text is packed to 32-bit words, FIFO readiness is checked once for every 4 characters.
+ * Remaining 1 to 3 characters are sent with 16- and 8-bit writes.
+ * When ITM or stimulus port is not enabled, text is dropped and print continues
+ *
+ * \note            Function waits for FIFO, when SWO output is slower than the print.
+ *                      Use staging buffer of block output instance to call it with long blocks
+ *
+ * \param[in]       data: Pointer to characters to print. It is not `NULL` terminated
+ * \param[in]       len: Number of characters to print
+ * \param[in]       lwobj: LwPRINTF instance
+ * \return          `len`
+ */
+int
+lwprintf_itm_block_fn(const char* data, size_t len, lwprintf_t* lwobj) {
+    const unsigned char* d = (const unsigned char*)data;
+    size_t i = 0;
+
+    LWPRINTF_UNUSED(lwobj);
+    if (!lwprintf_itm_is_enabled()) {
+        return (int)len;
+    }
+
+    /* First character goes to the lowest byte, it is the first one on SWO */
+    for (; len - i >= 4; i += 4) {
+        const uint32_t word = (uint32_t)d[i] | ((uint32_t)d[i + 1] << 8) | ((uint32_t)d[i + 2] << 16)
+                              | ((uint32_t)d[i + 3] << 24);
+
+        prv_itm_wait_ready();
+        ITM_STIM_U32 = word;
+    }
+    if (len - i >= 2) {
+        prv_itm_wait_ready();
+        ITM_STIM_U16 = (uint16_t)((uint16_t)d[i] | ((uint16_t)d[i + 1] << 8));
+        i += 2;
+    }
+    if (i < len) {
+        prv_itm_wait_ready();
+        ITM_STIM_U8 = d[i];
+    }
+    return (int)len;
+}
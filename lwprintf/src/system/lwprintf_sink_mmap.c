@@ -0,0 +1,284 @@
+/**
+ * \file            lwprintf_sink_mmap.c
+ * \brief           Block output sink for memory-mapped log file, used as ring buffer on Linux hosts
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwPRINTF - Lightweight stdio manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v1.0.6
+ */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE /* fdatasync and posix_fallocate functions */
+#endif              /* _GNU_SOURCE */
+#include <fcntl.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include "system/lwprintf_sink_mmap.h"
+
+/**
+ * \brief           Sink of \ref lwprintf_mmap_block_fn
+ */
+lwprintf_mmap_t lwprintf_mmap = {.fd = -1};
+
+/**
+ * \brief           Get monotonic time
+ * \return          Time in units of milliseconds
+ */
+static uint64_t
+prv_mmap_time(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000U + (uint64_t)ts.tv_nsec / 1000000U;
+}
+
+/**
+ * \brief           Synchronize part of ring data, from page of the first byte
+ * \param[in]       mm: Sink
+ * \param[in]       start: Position of the first byte in ring data
+ * \param[in]       end: Position after the last byte in ring data, larger than `start`
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+prv_mmap_msync(lwprintf_mmap_t* mm, size_t start, size_t end) {
+    const size_t page = mm->hdr->data_offset;
+
+    /* Ring data starts at page boundary, mapping address must be page aligned for msync */
+    start -= start % page;
+    return msync(&mm->data[start], end - start, MS_SYNC) == 0;
+}
+
+/**
+ * \brief           Open log file and map it to memory.
+ *
+ * File with valid header of the same size is continued after the last written byte,
+ * otherwise it is resized, its blocks are allocated and new empty ring is created.
+ * Blocks are allocated in advance, so that write to the mapping does not fail on full disk
+ *
+ * \note            Existing file of different size is truncated to zero length first,
+ *                      its previous contents are lost, also when it is not a log file of this sink
+ * \note            Synchronization policy is reset to \ref LWPRINTF_MMAP_SYNC_NONE,
+ *                      set it with \ref lwprintf_mmap_set_sync after the file is open
+ *
+ * \param[in,out]   mm: Sink to open. Zero-initialized or closed sink, open sink is closed first
+ * \param[in]       path: Path to the file
+ * \param[in]       size: Size of ring data in units of bytes. File is one page larger for the header
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwprintf_mmap_open(lwprintf_mmap_t* mm, const char* path, size_t size) {
+    const long page = sysconf(_SC_PAGESIZE);
+    lwprintf_mmap_hdr_t* hdr;
+    struct stat st;
+    void* map;
+    int fd;
+
+    if (mm == NULL || path == NULL || size == 0 || page <= 0 || size > SIZE_MAX - (size_t)page) {
+        return 0;
+    }
+    lwprintf_mmap_close(mm);
+    fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return 0;
+    }
+    if (fstat(fd, &st) != 0
+        || ((size_t)st.st_size != size + (size_t)page
+            && (ftruncate(fd, 0) != 0 || posix_fallocate(fd, 0, (off_t)(size + (size_t)page)) != 0))) {
+        close(fd);
+        return 0;
+    }
+    map = mmap(NULL, size + (size_t)page, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        close(fd);
+        return 0;
+    }
+    hdr = map;
+
+    /* Header of other layout or size is replaced, ID is written last to mark complete header */
+    if (memcmp(hdr->magic, "LWPRLOG", 8) != 0 || hdr->version != LWPRINTF_MMAP_VERSION
+        || hdr->data_offset != (uint32_t)page || hdr->data_size != (uint64_t)size) {
+        memset(hdr, 0x00, sizeof(*hdr));
+        hdr->version = LWPRINTF_MMAP_VERSION;
+        hdr->data_offset = (uint32_t)page;
+        hdr->data_size = (uint64_t)size;
+        atomic_thread_fence(memory_order_release);
+        memcpy(hdr->magic, "LWPRLOG", 8);
+    }
+    memset(mm, 0x00, sizeof(*mm));
+    mm->hdr = hdr;
+    mm->data = (char*)map + page;
+    mm->map_size = size + (size_t)page;
+    mm->fd = fd;
+    mm->sync_wr = hdr->wr;
+    mm->sync_time = prv_mmap_time();
+    return 1;
+}
+
+/**
+ * \brief           Set synchronization policy of written text.
+ *
+ * Write synchronizes, when `bytes` were written since previous synchronization,
+ * or when `interval_ms` has passed since previous one. Set both to `0` to synchronize
+ * only with \ref lwprintf_mmap_sync, for example from separate thread, so that print never waits for the storage
+ *
+ * \param[in,out]   mm: Sink
+ * \param[in]       mode: Synchronization type
+ * \param[in]       bytes: Number of bytes between synchronizations. Set to `0` to disable
+ * \param[in]       interval_ms: Time between synchronizations in units of milliseconds. Set to `0` to disable
+ */
+void
+lwprintf_mmap_set_sync(lwprintf_mmap_t* mm, lwprintf_mmap_sync_t mode, size_t bytes, uint32_t interval_ms) {
+    mm->sync_mode = mode;
+    mm->sync_bytes = bytes;
+    mm->sync_interval_ms = interval_ms;
+}
+
+/**
+ * \brief           Write data to ring of the file.
+ *
+ * Data is copied with at most two `memcpy` calls, without system call,
+ * and write offset in the header is updated after the data.
+ * When ring is full, the oldest text is overwritten.
+ * Data is synchronized to the storage according to the policy of \ref lwprintf_mmap_set_sync
+ *
+ * \note            Function is not thread-safe. Every sink must be written by single instance,
+ *                      that serializes its output with the mutex
+ *
+ * \param[in,out]   mm: Sink
+ * \param[in]       data: Data to write
+ * \param[in]       len: Number of bytes to write
+ * \return          `len` on success, `0` when file is not open
+ */
+size_t
+lwprintf_mmap_write(lwprintf_mmap_t* mm, const char* data, size_t len) {
+    size_t size, pos, first, copy_len = len;
+    uint64_t wr, unsynced;
+
+    if (mm->hdr == NULL) {
+        return 0;
+    }
+    size = (size_t)mm->hdr->data_size;
+    wr = mm->hdr->wr;
+
+    /* Only the end of data larger than the ring remains in the file */
+    if (copy_len > size) {
+        wr += copy_len - size;
+        data += copy_len - size;
+        copy_len = size;
+    }
+    pos = (size_t)(wr % size);
+    first = copy_len < size - pos ? copy_len : size - pos;
+    memcpy(&mm->data[pos], data, first);
+    memcpy(mm->data, &data[first], copy_len - first);
+    atomic_thread_fence(memory_order_release);
+    mm->hdr->wr = wr + copy_len;
+
+    /* Time is only read when there is data to synchronize */
+    unsynced = mm->hdr->wr - mm->sync_wr;
+    if (mm->sync_mode != LWPRINTF_MMAP_SYNC_NONE
+        && ((mm->sync_bytes > 0 && unsynced >= mm->sync_bytes)
+            || (mm->sync_interval_ms > 0 && prv_mmap_time() - mm->sync_time >= mm->sync_interval_ms))) {
+        lwprintf_mmap_sync(mm);
+    }
+    return len;
+}
+
+/**
+ * \brief           Synchronize text, written since previous synchronization, to the storage.
+ * Ring data is synchronized before the header, so that write offset never covers text that is not stored
+ * \param[in,out]   mm: Sink
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwprintf_mmap_sync(lwprintf_mmap_t* mm) {
+    size_t size, start, end;
+    uint64_t wr;
+    uint8_t res = 1;
+
+    if (mm->hdr == NULL) {
+        return 0;
+    }
+    size = (size_t)mm->hdr->data_size;
+    wr = mm->hdr->wr;
+    if (mm->sync_mode == LWPRINTF_MMAP_SYNC_FDATASYNC) {
+        res = fdatasync(mm->fd) == 0;
+    } else if (wr != mm->sync_wr) {
+        start = (size_t)(mm->sync_wr % size);
+        end = (size_t)(wr % size);
+        if (wr - mm->sync_wr >= size) {
+            res = prv_mmap_msync(mm, 0, size);
+        } else if (start < end) {
+            res = prv_mmap_msync(mm, start, end);
+        } else {
+            res = prv_mmap_msync(mm, start, size);
+            res = (end == 0 || prv_mmap_msync(mm, 0, end)) && res;
+        }
+        res = res && msync(mm->hdr, sizeof(*mm->hdr), MS_SYNC) == 0;
+    }
+    if (res) {
+        mm->sync_wr = wr;
+    }
+    mm->sync_time = prv_mmap_time();
+    return res;
+}
+
+/**
+ * \brief           Synchronize written text, unmap and close the file
+ * \param[in,out]   mm: Sink
+ */
+void
+lwprintf_mmap_close(lwprintf_mmap_t* mm) {
+    if (mm->hdr == NULL) {
+        return;
+    }
+    if (mm->sync_mode != LWPRINTF_MMAP_SYNC_NONE) {
+        lwprintf_mmap_sync(mm);
+    }
+    munmap(mm->hdr, mm->map_size);
+    close(mm->fd);
+    mm->hdr = NULL;
+    mm->data = NULL;
+    mm->fd = -1;
+}
+
+/**
+ * \brief           Block output function, that writes text to \ref lwprintf_mmap sink.
+ * Output costs only copy to the page cache, the file keeps the text when process crashes
+ * \param[in]       data: Pointer to characters to print. It is not `NULL` terminated
+ * \param[in]       len: Number of characters to print
+ * \param[in]       lwobj: LwPRINTF instance
+ * \return          Number of written characters
+ */
+int
+lwprintf_mmap_block_fn(const char* data, size_t len, lwprintf_t* lwobj) {
+    LWPRINTF_UNUSED(lwobj);
+    return (int)lwprintf_mmap_write(&lwprintf_mmap, data, len);
+}
@@ -0,0 +1,197 @@
+/**
+ * \file            lwprintf_sink_rtt.c
+ * \brief           Block output sink for ring buffer in RAM, read by debug probe with SEGGER RTT layout
+ */
+
+
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwPRINTF - Lightweight stdio manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v1.0.6
+ */
+#include <stdatomic.h>
+#include <string.h>
+#include "system/lwprintf_sink_rtt.h"
+
+/**
+ * \brief           Control block, found by the probe in RAM
+ */
+lwprintf_rtt_cb_t lwprintf_rtt;
+
+/**
+ * \brief           Get number of bytes, that can be written to the ring buffer.
+ * One byte is always free, equal offsets mean empty buffer
+ * \param[in]       buf: Up buffer
+ * \return          Number of free bytes
+ */
+static unsigned
+prv_rtt_free(const lwprintf_rtt_buffer_t* buf) {
+    const unsigned rd = buf->rd;
+    const unsigned wr = buf->wr;
+
+    return rd > wr ? rd - wr - 1 : buf->size - (wr - rd) - 1;
+}
+
+/**
+ * \brief           Copy data to the ring buffer with at most two block copies, and publish it to the probe
+ * \param[in,out]   buf: Up buffer
+ * \param[in]       data: Data to copy
+ * \param[in]       len: Number of bytes to copy, not larger than free space
+ */
+static void
+prv_rtt_copy(lwprintf_rtt_buffer_t* buf, const char* data, unsigned len) {
+    unsigned wr = buf->wr;
+    const unsigned first = len < buf->size - wr ? len : buf->size - wr;
+
+    memcpy(&buf->buff[wr], data, first);
+    memcpy(buf->buff, &data[first], len - first);
+    wr += len;
+    if (wr >= buf->size) {
+        wr -= buf->size;
+    }
+    LWPRINTF_RTT_BARRIER();
+    buf->wr = wr;
+}
+
+/**
+ * \brief           Initialize control block.
+ * ID string is written last, so that the probe does not find incomplete control block
+ */
+void
+lwprintf_rtt_init(void) {
+    lwprintf_rtt_cb_t* cb = &lwprintf_rtt;
+
+    memset(cb, 0x00, sizeof(*cb));
+    cb->max_up = LWPRINTF_RTT_UP_CNT;
+    cb->max_down = LWPRINTF_RTT_DOWN_CNT;
+    LWPRINTF_RTT_BARRIER();
+
+    /* Copy of complete ID string must not remain in RAM, for example on the stack */
+    memcpy(&cb->id[7], "RTT", 4);
+    LWPRINTF_RTT_BARRIER();
+    memcpy(cb->id, "SEGGER", 6);
+    LWPRINTF_RTT_BARRIER();
+    cb->id[6] = ' ';
+}
+
+/**
+ * \brief           Configure up buffer of control block.
+ *
+ * \note            Configure buffer before it is used for output
+ *
+ * \param[in]       index: Up buffer index, lower than \ref LWPRINTF_RTT_UP_CNT
+ * \param[in]       name: Name of the buffer, shown by the probe software. Can be `NULL`
+ * \param[in]       buff: Ring buffer memory
+ * \param[in]       size: Size of ring buffer in units of bytes, at least `2`
+ * \param[in]       mode: Operating mode, when buffer has no space for complete text
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwprintf_rtt_config_up(size_t index, const char* name, char* buff, size_t size, lwprintf_rtt_mode_t mode) {
+    lwprintf_rtt_buffer_t* buf;
+
+    if (index >= LWPRINTF_RTT_UP_CNT || buff == NULL || size < 2 || mode > LWPRINTF_RTT_MODE_BLOCK) {
+        return 0;
+    }
+    buf = &lwprintf_rtt.up[index];
+    buf->size = 0;
+    LWPRINTF_RTT_BARRIER();
+    buf->name = name;
+    buf->buff = buff;
+    buf->wr = 0;
+    buf->rd = 0;
+    buf->flags = (unsigned)mode;
+    LWPRINTF_RTT_BARRIER();
+    buf->size = (unsigned)size;
+    return 1;
+}
+
+/**
+ * \brief           Write data to up buffer.
+ *
+ * When buffer has no space for complete data, \ref LWPRINTF_RTT_MODE_SKIP writes nothing,
+ * \ref LWPRINTF_RTT_MODE_TRIM writes the part that fits,
+ * and \ref LWPRINTF_RTT_MODE_BLOCK waits until the probe reads the buffer
+ *
+ * \note            Function is not thread-safe. Every up buffer must be written by single instance,
+ *                      that serializes its output with the mutex
+ *
+ * \param[in]       index: Up buffer index
+ * \param[in]       data: Data to write
+ * \param[in]       len: Number of bytes to write
+ * \return          Number of written bytes
+ */
+size_t
+lwprintf_rtt_write(size_t index, const char* data, size_t len) {
+    lwprintf_rtt_buffer_t* buf;
+    size_t written = 0;
+    unsigned avail;
+
+    if (index >= LWPRINTF_RTT_UP_CNT || lwprintf_rtt.up[index].size == 0) {
+        return 0;
+    }
+    buf = &lwprintf_rtt.up[index];
+    switch (buf->flags) {
+        case LWPRINTF_RTT_MODE_SKIP:
+            if (prv_rtt_free(buf) >= len) {
+                prv_rtt_copy(buf, data, (unsigned)len);
+                written = len;
+            }
+            break;
+        case LWPRINTF_RTT_MODE_TRIM:
+            avail = prv_rtt_free(buf);
+            written = avail < len ? avail : len;
+            prv_rtt_copy(buf, data, (unsigned)written);
+            break;
+        default:
+            while (written < len) {
+                avail = prv_rtt_free(buf);
+                avail = avail < len - written ? avail : (unsigned)(len - written);
+                prv_rtt_copy(buf, &data[written], avail);
+                written += avail;
+            }
+            break;
+    }
+    return written;
+}
+
+/**
+ * \brief           Block output function, that writes text to up buffer `0`.
+ *
+ * Output costs only copy to RAM. When buffer has no space and is not in \ref LWPRINTF_RTT_MODE_BLOCK mode,
+ * function returns less than `len`, and rest of the message is not sent
+ *
+ * \param[in]       data: Pointer to characters to print. It is not `NULL` terminated
+ * \param[in]       len: Number of characters to print
+ * \param[in]       lwobj: LwPRINTF instance
+ * \return          Number of written characters
+ */
+int
+lwprintf_rtt_block_fn(const char* data, size_t len, lwprintf_t* lwobj) {
+    LWPRINTF_UNUSED(lwobj);
+    return (int)lwprintf_rtt_write(0, data, len);
+}
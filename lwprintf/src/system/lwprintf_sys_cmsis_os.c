@@ -61,4 +61,84 @@ lwprintf_sys_mutex_release(LWPRINTF_CFG_OS_MUTEX_HANDLE* m) {
     return osMutexRelease(*m) == osOK;
 }
 
+#if LWPRINTF_CFG_ENABLE_TRY_PRINT || LWPRINTF_CFG_ENABLE_AUTO_FLUSH || LWPRINTF_CFG_ENABLE_LOW_POWER
+
+uint8_t
+lwprintf_sys_mutex_trywait(LWPRINTF_CFG_OS_MUTEX_HANDLE* m) {
+    return osMutexAcquire(*m, 0) == osOK;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_TRY_PRINT || LWPRINTF_CFG_ENABLE_AUTO_FLUSH || LWPRINTF_CFG_ENABLE_LOW_POWER */
+
+#if LWPRINTF_CFG_OS_ISR_DEFERRED
+
+/* Core register access for Cortex-M */
+#include "cmsis_compiler.h"
+
+uint8_t
+lwprintf_sys_is_isr(void) {
+    return __get_IPSR() != 0;
+}
+
+#endif /* LWPRINTF_CFG_OS_ISR_DEFERRED */
+
+#if LWPRINTF_CFG_OS_YIELD_CHUNK > 0
+
+void
+lwprintf_sys_yield(void) {
+    osThreadYield();
+}
+
+#endif /* LWPRINTF_CFG_OS_YIELD_CHUNK > 0 */
+
+#if LWPRINTF_CFG_OS_THREAD_DEFAULT
+
+#ifndef LWPRINTF_SYS_THREAD_SLOTS
+#define LWPRINTF_SYS_THREAD_SLOTS 8
+#endif /* LWPRINTF_SYS_THREAD_SLOTS */
+
+/* CMSIS-RTOS2 has no thread-local storage, instances are kept in table of thread IDs */
+static osThreadId_t volatile thread_ids[LWPRINTF_SYS_THREAD_SLOTS];
+static lwprintf_t* thread_defaults[LWPRINTF_SYS_THREAD_SLOTS];
+
+lwprintf_t*
+lwprintf_sys_thread_default_get(void) {
+    osThreadId_t id = osThreadGetId();
+
+    /* Slot of the thread is modified only by the thread itself */
+    for (size_t i = 0; i < LWPRINTF_SYS_THREAD_SLOTS; ++i) {
+        if (thread_ids[i] == id) {
+            return thread_defaults[i];
+        }
+    }
+    return NULL;
+}
+
+uint8_t
+lwprintf_sys_thread_default_set(lwprintf_t* lwobj) {
+    osThreadId_t id = osThreadGetId();
+    size_t i, idx = LWPRINTF_SYS_THREAD_SLOTS;
+    uint8_t res = 0;
+    int32_t lock;
+
+    lock = osKernelLock(); /* Free slot is searched by single thread at a time */
+    for (i = 0; i < LWPRINTF_SYS_THREAD_SLOTS; ++i) {
+        if (thread_ids[i] == id) {
+            idx = i;
+            break;
+        } else if (thread_ids[i] == NULL && idx == LWPRINTF_SYS_THREAD_SLOTS) {
+            idx = i;
+        }
+    }
+    if (idx < LWPRINTF_SYS_THREAD_SLOTS) {
+        thread_defaults[idx] = lwobj; /* Instance is written before slot is assigned to the thread */
+        thread_ids[idx] = lwobj != NULL ? id : NULL;
+        res = 1;
+    }
+    osKernelRestoreLock(lock);
+    return res;
+}
+
+#endif /* LWPRINTF_CFG_OS_THREAD_DEFAULT */
+
 #endif /* LWPRINTF_CFG_OS && !__DOXYGEN__ */
@@ -0,0 +1,282 @@
+/**
+ * \file            lwprintf_sys_mpsc.c
+ * \brief           Lock-free ring buffer output, used instead of operating system mutex
+ */
+
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwPRINTF - Lightweight stdio manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v1.0.6
+ */
+#include <string.h>
+#include "system/lwprintf_mpsc.h"
+#include "system/lwprintf_sys.h"
+
+#if LWPRINTF_CFG_OS && !__DOXYGEN__
+
+/*
+ * To use this module, options must be defined as
+ *
+ * #define LWPRINTF_CFG_OS                  1
+ * #define LWPRINTF_CFG_OS_MUTEX_HANDLE     uint8_t
+ * #define LWPRINTF_CFG_OS_STAGING_SIZE     128
+ * #define LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT 1
+ *
+ * Text is formatted to the staging buffer without lock,
+ * and finished text is written to the ring buffer as single record.
+ * Text longer than staging buffer may be split to multiple records.
+ */
+#if !LWPRINTF_CFG_ENABLE_BLOCK_OUTPUT || LWPRINTF_CFG_OS_STAGING_SIZE == 0 || LWPRINTF_CFG_OS_MANUAL_PROTECT
+#error "Lock-free output requires block output and staging buffer, without manual protection"
+#endif
+
+/* Records start with header, aligned to its size */
+#define MPSC_HDR_SIZE  sizeof(size_t)
+#define MPSC_ALIGN(x)  (((x) + MPSC_HDR_SIZE - 1) & ~(MPSC_HDR_SIZE - 1))
+#define MPSC_HDR(rb, pos) ((atomic_size_t*)(void*)&(rb)->buff[(pos) & ((rb)->size - 1)])
+
+/*
+ * Header value is `0` until record is committed,
+ * then it is `(len << 1) | 1` for text or `(size << 1)` for padding to the end of buffer
+ */
+#define MPSC_HDR_TEXT(len)  (((len) << 1) | 1)
+#define MPSC_HDR_PAD(size)  ((size) << 1)
+
+/* Mutual exclusion is not needed, records are reserved with atomic operations */
+uint8_t
+lwprintf_sys_mutex_create(LWPRINTF_CFG_OS_MUTEX_HANDLE* m) {
+    *m = 1;
+    return 1;
+}
+
+uint8_t
+lwprintf_sys_mutex_isvalid(LWPRINTF_CFG_OS_MUTEX_HANDLE* m) {
+    return *m != 0;
+}
+
+uint8_t
+lwprintf_sys_mutex_wait(LWPRINTF_CFG_OS_MUTEX_HANDLE* m) {
+    LWPRINTF_UNUSED(m);
+    return 1;
+}
+
+uint8_t
+lwprintf_sys_mutex_release(LWPRINTF_CFG_OS_MUTEX_HANDLE* m) {
+    LWPRINTF_UNUSED(m);
+    return 1;
+}
+
+#if LWPRINTF_CFG_ENABLE_TRY_PRINT || LWPRINTF_CFG_ENABLE_AUTO_FLUSH || LWPRINTF_CFG_ENABLE_LOW_POWER
+
+uint8_t
+lwprintf_sys_mutex_trywait(LWPRINTF_CFG_OS_MUTEX_HANDLE* m) {
+    LWPRINTF_UNUSED(m);
+    return 1;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_TRY_PRINT || LWPRINTF_CFG_ENABLE_AUTO_FLUSH || LWPRINTF_CFG_ENABLE_LOW_POWER */
+
+#if LWPRINTF_CFG_OS_ISR_DEFERRED
+
+uint8_t
+lwprintf_sys_is_isr(void) {
+    return 0; /* Lock-free output is safe from interrupt context too */
+}
+
+#endif /* LWPRINTF_CFG_OS_ISR_DEFERRED */
+
+#if LWPRINTF_CFG_OS_YIELD_CHUNK > 0
+
+void
+lwprintf_sys_yield(void) {
+    /* Other writers never wait, there is nothing to yield to */
+}
+
+#endif /* LWPRINTF_CFG_OS_YIELD_CHUNK > 0 */
+
+#if LWPRINTF_CFG_OS_THREAD_DEFAULT
+
+/* Instance of every thread, `NULL` when thread uses the global default instance */
+static _Thread_local lwprintf_t* thread_default;
+
+lwprintf_t*
+lwprintf_sys_thread_default_get(void) {
+    return thread_default;
+}
+
+uint8_t
+lwprintf_sys_thread_default_set(lwprintf_t* lwobj) {
+    thread_default = lwobj;
+    return 1;
+}
+
+#endif /* LWPRINTF_CFG_OS_THREAD_DEFAULT */
+
+#endif /* LWPRINTF_CFG_OS && !__DOXYGEN__ */
+
+/* Ring buffer of default instance, which is not accessible outside of the library */
+static lwprintf_mpsc_t* mpsc_default;
+
+/**
+ * \brief           Initialize lock-free ring buffer
+ * \param[out]      rb: Ring buffer to initialize
+ * \param[in]       buff: Ring buffer memory, aligned to `size_t`.
+ *                      Only largest power of `2` part of it is used
+ * \param[in]       size: Size of ring buffer memory in units of bytes
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwprintf_mpsc_init(lwprintf_mpsc_t* rb, void* buff, size_t size) {
+    size_t pow2 = MPSC_HDR_SIZE * 2;
+
+    if (rb == NULL || buff == NULL || size < pow2 || ((uintptr_t)buff & (MPSC_HDR_SIZE - 1)) != 0) {
+        return 0;
+    }
+    while (pow2 <= size / 2) {
+        pow2 *= 2;
+    }
+
+    /* Zero memory means no committed record */
+    memset(buff, 0x00, pow2);
+    rb->buff = buff;
+    rb->size = pow2;
+    rb->block_len = 0;
+    atomic_init(&rb->head, 0);
+    atomic_init(&rb->tail, 0);
+    return 1;
+}
+
+/**
+ * \brief           Set lock-free ring buffer as output of LwPRINTF instance
+ *
+ * Instance is initialized with \ref lwprintf_mpsc_out_block function, ring buffer is set as its argument
+ *
+ * \param[in,out]   lwobj: LwPRINTF instance. Set to `NULL` to use default instance
+ * \param[in]       rb: Initialized ring buffer
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwprintf_mpsc_attach(lwprintf_t* lwobj, lwprintf_mpsc_t* rb) {
+    if (!lwprintf_init_block_ex(lwobj, lwprintf_mpsc_out_block, NULL, 0)) {
+        return 0;
+    }
+    if (lwobj != NULL) {
+        lwprintf_set_arg(lwobj, rb);
+    } else {
+        mpsc_default = rb;
+    }
+    return 1;
+}
+
+/**
+ * \brief           Block output function, writing data as single record to the ring buffer
+ *
+ * It can be called from multiple threads or cores at the same time, without lock.
+ * Record is dropped when there is not enough space in the buffer
+ *
+ * \param[in]       data: Data to write
+ * \param[in]       len: Number of bytes to write
+ * \param[in]       lwobj: LwPRINTF instance, with ring buffer as argument
+ * \return          `len` on success, `0` otherwise
+ */
+int
+lwprintf_mpsc_out_block(const char* data, size_t len, lwprintf_t* lwobj) {
+    lwprintf_mpsc_t* rb = lwprintf_get_arg(lwobj) != NULL ? lwprintf_get_arg(lwobj) : mpsc_default;
+    const size_t rec = MPSC_ALIGN(MPSC_HDR_SIZE + len);
+    size_t head, pad, pos;
+
+    if (rb == NULL || rec > rb->size) {
+        return 0;
+    }
+
+    /* Reserve contiguous space, with padding when record does not fit to the end of buffer */
+    head = atomic_load_explicit(&rb->head, memory_order_relaxed);
+    do {
+        pos = head & (rb->size - 1);
+        pad = pos + rec > rb->size ? rb->size - pos : 0;
+        if (head + pad + rec - atomic_load_explicit(&rb->tail, memory_order_acquire) > rb->size) {
+            return 0;
+        }
+    } while (!atomic_compare_exchange_weak_explicit(&rb->head, &head, head + pad + rec, memory_order_relaxed,
+                                                    memory_order_relaxed));
+
+    /* Write data directly to reserved space and commit it */
+    if (pad > 0) {
+        atomic_store_explicit(MPSC_HDR(rb, head), MPSC_HDR_PAD(pad), memory_order_release);
+        head += pad;
+    }
+    memcpy(&rb->buff[(head & (rb->size - 1)) + MPSC_HDR_SIZE], data, len);
+    atomic_store_explicit(MPSC_HDR(rb, head), MPSC_HDR_TEXT(len), memory_order_release);
+    return (int)len;
+}
+
+/**
+ * \brief           Get next committed record from the ring buffer.
+ *
+ * Function is called by single drain task only.
+ * Record stays in the buffer until \ref lwprintf_mpsc_release_block is called,
+ * hence it can be sent to the hardware with DMA directly from the buffer
+ *
+ * \param[in,out]   rb: Ring buffer
+ * \param[out]      data: Pointer to record data
+ * \return          Record length in units of bytes, `0` if there is no committed record
+ */
+size_t
+lwprintf_mpsc_get_block(lwprintf_mpsc_t* rb, const char** data) {
+    size_t tail = atomic_load_explicit(&rb->tail, memory_order_relaxed);
+    size_t hdr;
+
+    while ((hdr = atomic_load_explicit(MPSC_HDR(rb, tail), memory_order_acquire)) != 0) {
+        if (hdr & 1) {
+            *data = (const char*)&rb->buff[(tail & (rb->size - 1)) + MPSC_HDR_SIZE];
+            rb->block_len = MPSC_ALIGN(MPSC_HDR_SIZE + (hdr >> 1));
+            return hdr >> 1;
+        }
+
+        /* Skip padding at the end of buffer */
+        rb->block_len = hdr >> 1;
+        lwprintf_mpsc_release_block(rb);
+        tail = atomic_load_explicit(&rb->tail, memory_order_relaxed);
+    }
+    return 0;
+}
+
+/**
+ * \brief           Release record, returned by \ref lwprintf_mpsc_get_block, after it has been sent
+ * \param[in,out]   rb: Ring buffer
+ */
+void
+lwprintf_mpsc_release_block(lwprintf_mpsc_t* rb) {
+    size_t tail = atomic_load_explicit(&rb->tail, memory_order_relaxed);
+
+    /* Clear released memory, any word of it may become header of the next record */
+    for (size_t i = 0; i < rb->block_len; i += MPSC_HDR_SIZE) {
+        atomic_store_explicit(MPSC_HDR(rb, tail + i), 0, memory_order_relaxed);
+    }
+    atomic_store_explicit(&rb->tail, tail + rb->block_len, memory_order_release);
+    rb->block_len = 0;
+}
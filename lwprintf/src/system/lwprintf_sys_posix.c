@@ -0,0 +1,234 @@
+/**
+ * \file            lwprintf_sys_posix.c
+ * \brief           System functions for POSIX
+ */
+
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwPRINTF - Lightweight stdio manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v1.0.6
+ */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE /* Recursive pthread mutex and syscall function */
+#endif              /* _GNU_SOURCE */
+#include "system/lwprintf_sys.h"
+
+#if LWPRINTF_CFG_OS && !__DOXYGEN__
+
+/*
+ * To use this module, options must be defined as
+ *
+ * #include "system/lwprintf_sys_posix.h"
+ * #define LWPRINTF_CFG_OS_MUTEX_HANDLE     lwprintf_sys_posix_mutex_t
+ */
+
+#include <sched.h>
+#include "system/lwprintf_sys_posix.h"
+
+#if LWPRINTF_SYS_POSIX_FUTEX
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/**
+ * \brief           Get kernel ID of current thread, read from the kernel only once per thread
+ * \return          Thread ID
+ */
+static long
+prv_thread_id(void) {
+    static _Thread_local long tid;
+
+    if (tid == 0) {
+        tid = (long)syscall(SYS_gettid);
+    }
+    return tid;
+}
+
+uint8_t
+lwprintf_sys_mutex_create(LWPRINTF_CFG_OS_MUTEX_HANDLE* m) {
+    atomic_init(&m->state, 0);
+    atomic_init(&m->owner, 0);
+    m->depth = 0;
+    m->valid = 1;
+    return 1;
+}
+
+uint8_t
+lwprintf_sys_mutex_isvalid(LWPRINTF_CFG_OS_MUTEX_HANDLE* m) {
+    return m->valid;
+}
+
+uint8_t
+lwprintf_sys_mutex_wait(LWPRINTF_CFG_OS_MUTEX_HANDLE* m) {
+    long tid = prv_thread_id();
+    int c = 1;
+
+    if (atomic_load_explicit(&m->owner, memory_order_relaxed) == tid) {
+        ++m->depth;
+        return 1;
+    }
+
+    /* Critical section is short, owner likely releases it before thread would be put to sleep */
+    for (size_t i = 0; i < LWPRINTF_SYS_POSIX_SPIN_COUNT; ++i) {
+        c = 0;
+        if (atomic_load_explicit(&m->state, memory_order_relaxed) == 0
+            && atomic_compare_exchange_strong_explicit(&m->state, &c, 1, memory_order_acquire,
+                                                       memory_order_relaxed)) {
+            break;
+        }
+        c = 1;
+    }
+
+    /* Mark lock as contended and sleep, until owner wakes up one waiting thread */
+    if (c != 0) {
+        c = atomic_exchange_explicit(&m->state, 2, memory_order_acquire);
+        while (c != 0) {
+            syscall(SYS_futex, (int*)&m->state, FUTEX_WAIT_PRIVATE, 2, NULL, NULL, 0);
+            c = atomic_exchange_explicit(&m->state, 2, memory_order_acquire);
+        }
+    }
+    atomic_store_explicit(&m->owner, tid, memory_order_relaxed);
+    m->depth = 1;
+    return 1;
+}
+
+#if LWPRINTF_CFG_ENABLE_TRY_PRINT || LWPRINTF_CFG_ENABLE_AUTO_FLUSH || LWPRINTF_CFG_ENABLE_LOW_POWER
+
+uint8_t
+lwprintf_sys_mutex_trywait(LWPRINTF_CFG_OS_MUTEX_HANDLE* m) {
+    long tid = prv_thread_id();
+    int c = 0;
+
+    if (atomic_load_explicit(&m->owner, memory_order_relaxed) == tid) {
+        ++m->depth;
+        return 1;
+    }
+    if (!atomic_compare_exchange_strong_explicit(&m->state, &c, 1, memory_order_acquire, memory_order_relaxed)) {
+        return 0;
+    }
+    atomic_store_explicit(&m->owner, tid, memory_order_relaxed);
+    m->depth = 1;
+    return 1;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_TRY_PRINT || LWPRINTF_CFG_ENABLE_AUTO_FLUSH || LWPRINTF_CFG_ENABLE_LOW_POWER */
+
+uint8_t
+lwprintf_sys_mutex_release(LWPRINTF_CFG_OS_MUTEX_HANDLE* m) {
+    if (--m->depth > 0) {
+        return 1;
+    }
+    atomic_store_explicit(&m->owner, 0, memory_order_relaxed);
+
+    /* Kernel is entered only when other threads are waiting */
+    if (atomic_exchange_explicit(&m->state, 0, memory_order_release) == 2) {
+        syscall(SYS_futex, (int*)&m->state, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+    }
+    return 1;
+}
+
+#else
+
+uint8_t
+lwprintf_sys_mutex_create(LWPRINTF_CFG_OS_MUTEX_HANDLE* m) {
+    pthread_mutexattr_t attr;
+    uint8_t res;
+
+    /* Recursive, as deferred messages are processed with mutex already taken */
+    if (pthread_mutexattr_init(&attr) != 0) {
+        return 0;
+    }
+    res = pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE) == 0 && pthread_mutex_init(&m->mutex, &attr) == 0;
+    pthread_mutexattr_destroy(&attr);
+    m->valid = res;
+    return res;
+}
+
+uint8_t
+lwprintf_sys_mutex_isvalid(LWPRINTF_CFG_OS_MUTEX_HANDLE* m) {
+    return m->valid;
+}
+
+uint8_t
+lwprintf_sys_mutex_wait(LWPRINTF_CFG_OS_MUTEX_HANDLE* m) {
+    return pthread_mutex_lock(&m->mutex) == 0;
+}
+
+#if LWPRINTF_CFG_ENABLE_TRY_PRINT || LWPRINTF_CFG_ENABLE_AUTO_FLUSH || LWPRINTF_CFG_ENABLE_LOW_POWER
+
+uint8_t
+lwprintf_sys_mutex_trywait(LWPRINTF_CFG_OS_MUTEX_HANDLE* m) {
+    return pthread_mutex_trylock(&m->mutex) == 0;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_TRY_PRINT || LWPRINTF_CFG_ENABLE_AUTO_FLUSH || LWPRINTF_CFG_ENABLE_LOW_POWER */
+
+uint8_t
+lwprintf_sys_mutex_release(LWPRINTF_CFG_OS_MUTEX_HANDLE* m) {
+    return pthread_mutex_unlock(&m->mutex) == 0;
+}
+
+#endif /* LWPRINTF_SYS_POSIX_FUTEX */
+
+#if LWPRINTF_CFG_OS_ISR_DEFERRED
+
+uint8_t
+lwprintf_sys_is_isr(void) {
+    return 0; /* Application never runs in interrupt context */
+}
+
+#endif /* LWPRINTF_CFG_OS_ISR_DEFERRED */
+
+#if LWPRINTF_CFG_OS_YIELD_CHUNK > 0
+
+void
+lwprintf_sys_yield(void) {
+    sched_yield();
+}
+
+#endif /* LWPRINTF_CFG_OS_YIELD_CHUNK > 0 */
+
+#if LWPRINTF_CFG_OS_THREAD_DEFAULT
+
+/* Instance of every thread, `NULL` when thread uses the global default instance */
+static _Thread_local lwprintf_t* thread_default;
+
+lwprintf_t*
+lwprintf_sys_thread_default_get(void) {
+    return thread_default;
+}
+
+uint8_t
+lwprintf_sys_thread_default_set(lwprintf_t* lwobj) {
+    thread_default = lwobj;
+    return 1;
+}
+
+#endif /* LWPRINTF_CFG_OS_THREAD_DEFAULT */
+
+#endif /* LWPRINTF_CFG_OS && !__DOXYGEN__ */
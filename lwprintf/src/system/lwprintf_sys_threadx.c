@@ -66,4 +66,85 @@ lwprintf_sys_mutex_release(LWPRINTF_CFG_OS_MUTEX_HANDLE* m) {
     return tx_mutex_put(m) == TX_SUCCESS;
 }
 
+#if LWPRINTF_CFG_ENABLE_TRY_PRINT || LWPRINTF_CFG_ENABLE_AUTO_FLUSH || LWPRINTF_CFG_ENABLE_LOW_POWER
+
+uint8_t
+lwprintf_sys_mutex_trywait(LWPRINTF_CFG_OS_MUTEX_HANDLE* m) {
+    return tx_mutex_get(m, TX_NO_WAIT) == TX_SUCCESS;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_TRY_PRINT || LWPRINTF_CFG_ENABLE_AUTO_FLUSH || LWPRINTF_CFG_ENABLE_LOW_POWER */
+
+#if LWPRINTF_CFG_OS_ISR_DEFERRED
+
+#include "tx_initialize.h"
+#include "tx_thread.h"
+
+uint8_t
+lwprintf_sys_is_isr(void) {
+    /* System state is non-zero in interrupt, but also during initialization */
+    return TX_THREAD_GET_SYSTEM_STATE() != 0 && TX_THREAD_GET_SYSTEM_STATE() < TX_INITIALIZE_IN_PROGRESS;
+}
+
+#endif /* LWPRINTF_CFG_OS_ISR_DEFERRED */
+
+#if LWPRINTF_CFG_OS_YIELD_CHUNK > 0
+
+void
+lwprintf_sys_yield(void) {
+    tx_thread_relinquish();
+}
+
+#endif /* LWPRINTF_CFG_OS_YIELD_CHUNK > 0 */
+
+#if LWPRINTF_CFG_OS_THREAD_DEFAULT
+
+#ifndef LWPRINTF_SYS_THREAD_SLOTS
+#define LWPRINTF_SYS_THREAD_SLOTS 8
+#endif /* LWPRINTF_SYS_THREAD_SLOTS */
+
+/* ThreadX has no thread-local storage, instances are kept in table of thread IDs */
+static TX_THREAD* volatile thread_ids[LWPRINTF_SYS_THREAD_SLOTS];
+static lwprintf_t* thread_defaults[LWPRINTF_SYS_THREAD_SLOTS];
+
+lwprintf_t*
+lwprintf_sys_thread_default_get(void) {
+    TX_THREAD* id = tx_thread_identify();
+
+    /* Slot of the thread is modified only by the thread itself */
+    for (size_t i = 0; i < LWPRINTF_SYS_THREAD_SLOTS; ++i) {
+        if (thread_ids[i] == id) {
+            return thread_defaults[i];
+        }
+    }
+    return NULL;
+}
+
+uint8_t
+lwprintf_sys_thread_default_set(lwprintf_t* lwobj) {
+    TX_THREAD* id = tx_thread_identify();
+    size_t i, idx = LWPRINTF_SYS_THREAD_SLOTS;
+    uint8_t res = 0;
+    UINT old;
+
+    old = tx_interrupt_control(TX_INT_DISABLE); /* Free slot is searched by single thread at a time */
+    for (i = 0; i < LWPRINTF_SYS_THREAD_SLOTS; ++i) {
+        if (thread_ids[i] == id) {
+            idx = i;
+            break;
+        } else if (thread_ids[i] == NULL && idx == LWPRINTF_SYS_THREAD_SLOTS) {
+            idx = i;
+        }
+    }
+    if (idx < LWPRINTF_SYS_THREAD_SLOTS) {
+        thread_defaults[idx] = lwobj; /* Instance is written before slot is assigned to the thread */
+        thread_ids[idx] = lwobj != NULL ? id : NULL;
+        res = 1;
+    }
+    tx_interrupt_control(old);
+    return res;
+}
+
+#endif /* LWPRINTF_CFG_OS_THREAD_DEFAULT */
+
 #endif /* LWPRINTF_CFG_OS && !__DOXYGEN__ */
@@ -64,4 +64,49 @@ lwprintf_sys_mutex_release(LWPRINTF_CFG_OS_MUTEX_HANDLE* m) {
     return 1;
 }
 
+#if LWPRINTF_CFG_ENABLE_TRY_PRINT || LWPRINTF_CFG_ENABLE_AUTO_FLUSH || LWPRINTF_CFG_ENABLE_LOW_POWER
+
+uint8_t
+lwprintf_sys_mutex_trywait(LWPRINTF_CFG_OS_MUTEX_HANDLE* m) {
+    return WaitForSingleObject(*m, 0) == WAIT_OBJECT_0;
+}
+
+#endif /* LWPRINTF_CFG_ENABLE_TRY_PRINT || LWPRINTF_CFG_ENABLE_AUTO_FLUSH || LWPRINTF_CFG_ENABLE_LOW_POWER */
+
+#if LWPRINTF_CFG_OS_ISR_DEFERRED
+
+uint8_t
+lwprintf_sys_is_isr(void) {
+    return 0; /* Application never runs in interrupt context */
+}
+
+#endif /* LWPRINTF_CFG_OS_ISR_DEFERRED */
+
+#if LWPRINTF_CFG_OS_YIELD_CHUNK > 0
+
+void
+lwprintf_sys_yield(void) {
+    SwitchToThread();
+}
+
+#endif /* LWPRINTF_CFG_OS_YIELD_CHUNK > 0 */
+
+#if LWPRINTF_CFG_OS_THREAD_DEFAULT
+
+/* Instance of every thread, `NULL` when thread uses the global default instance */
+static __declspec(thread) lwprintf_t* thread_default;
+
+lwprintf_t*
+lwprintf_sys_thread_default_get(void) {
+    return thread_default;
+}
+
+uint8_t
+lwprintf_sys_thread_default_set(lwprintf_t* lwobj) {
+    thread_default = lwobj;
+    return 1;
+}
+
+#endif /* LWPRINTF_CFG_OS_THREAD_DEFAULT */
+
 #endif /* LWPRINTF_CFG_OS && !__DOXYGEN__ */
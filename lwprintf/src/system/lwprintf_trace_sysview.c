@@ -0,0 +1,59 @@
+/**
+ * \file            lwprintf_trace_sysview.c
+ * \brief           Trace hooks binding for SEGGER SystemView
+ */
+
+
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwPRINTF - Lightweight stdio manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v1.0.6
+ */
+#include "system/lwprintf_trace_sysview.h"
+
+#if !__DOXYGEN__
+
+/*
+ * Module description lists events in order of LWPRINTF_SYSVIEW_EVT_* values.
+ * Specifier of conversion is shown as its ASCII code
+ */
+SEGGER_SYSVIEW_MODULE lwprintf_sysview_module = {
+    .sModule = "M=LwPRINTF, 0 Format obj=%p, 1 MutexWait obj=%p, 2 MutexRelease obj=%p, "
+               "3 Conv spec=%u, 4 Output len=%u",
+    .NumEvents = LWPRINTF_SYSVIEW_EVT_CNT,
+};
+
+/**
+ * \brief           Register LwPRINTF module to SystemView.
+ * Events are recorded only after this call, as event offset is assigned at registration
+ */
+void
+lwprintf_sysview_init(void) {
+    SEGGER_SYSVIEW_RegisterModule(&lwprintf_sysview_module);
+}
+
+#endif /* !__DOXYGEN__ */
@@ -0,0 +1,87 @@
+#!/usr/bin/env python3
+"""
+Decoder of LwPRINTF compressed output, created by lwprintf_compress.c module.
+
+Stream is sequence of groups. Group starts with flags byte, followed by up to 8 items,
+described by flags from LSB on. Flag 0 is literal byte, flag 1 is 2 bytes reference in big endian order,
+with distance in upper 11 bits and match length minus 3 in lower 5 bits.
+Reference with distance 0 ends the group early. Its length field set to 31 also clears the history.
+
+Usage:
+    lwprintf_decompress.py [input]     Decode file, or standard input, to standard output
+"""
+
+import argparse
+import sys
+
+HISTORY_SIZE = 2048
+
+
+class Decoder:
+    """Streaming decoder, that accepts compressed bytes in chunks of any size"""
+
+    def __init__(self):
+        self.pending = bytearray()
+        self.history = bytearray()
+
+    def feed(self, data):
+        """Decode next chunk of compressed stream, return decoded bytes"""
+        self.pending += data
+        out = bytearray()
+        while self.pending:
+            group = self._decode_group(self.pending)
+            if group is None:
+                break
+            used, text = group
+            del self.pending[:used]
+            out += text
+        return bytes(out)
+
+    def _decode_group(self, data):
+        """Decode one group, return tuple of used length and text, or None when group is not complete"""
+        flags, i, text = data[0], 1, bytearray()
+        history = bytearray(self.history)
+        for bit in range(8):
+            if not flags & (1 << bit):
+                if i >= len(data):
+                    return None
+                history.append(data[i])
+                text.append(data[i])
+                i += 1
+                continue
+            if i + 1 >= len(data):
+                return None
+            val = (data[i] << 8) | data[i + 1]
+            i += 2
+            dist, length = val >> 5, (val & 0x1F) + 3
+            if dist == 0:
+                if length == 0x1F + 3:
+                    history.clear()
+                break
+            if dist > len(history):
+                raise ValueError("Reference outside of history, stream is not synchronized")
+            for _ in range(length):
+                history.append(history[-dist])
+                text.append(history[-1])
+        self.history = history[-HISTORY_SIZE:]
+        return i, text
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode LwPRINTF compressed output")
+    parser.add_argument("input", nargs="?", help="Compressed input file, standard input if not set")
+    args = parser.parse_args()
+
+    decoder = Decoder()
+    stream = open(args.input, "rb") if args.input else sys.stdin.buffer
+    with stream:
+        while True:
+            chunk = stream.read1(4096) if hasattr(stream, "read1") else stream.read(4096)
+            if not chunk:
+                break
+            sys.stdout.buffer.write(decoder.feed(chunk))
+            sys.stdout.buffer.flush()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,293 @@
+#!/usr/bin/env python3
+"""
+Decoder of LwPRINTF tokenized output, created with tokenized mode of the instance.
+
+Every frame is length of the rest of the frame as variable length number (7 bits per byte, LSB first),
+32-bit address of format string in little endian order, and encoded arguments:
+
+* Integer and character arguments, width and precision given with `*`, as variable length numbers,
+  signed ones in zigzag encoding
+* Floating point arguments as float or double in little endian order, depending on library options
+* Strings with terminating NULL character
+
+Frame with length 0 is empty and skipped. Format strings are read from the firmware ELF file.
+
+Usage:
+    lwprintf_detokenize.py firmware.elf [input] [--float32] [--pointer-size 4] [--thousands-sep ,]
+"""
+
+import argparse
+import decimal
+import math
+import re
+import struct
+import sys
+
+SPEC_RE = re.compile(rb"%([-+ 0#']*)(\*|\d+)?(?:\.(\*|\d*))?(hh|h|ll|l|L|z|j|t)?(q\d*|[a-zA-Z%])")
+
+FIXED_MAX_PRECISION = 20  # Decimals calculated by the library for `%q`, more are printed as `0`
+
+
+class Elf:
+    """Minimal ELF reader, that gives access to allocated sections by address"""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            data = f.read()
+        if data[:4] != b"\x7fELF":
+            raise ValueError("Not an ELF file")
+        is64, end = data[4] == 2, "<" if data[5] == 1 else ">"
+        if is64:
+            shoff, = struct.unpack_from(end + "Q", data, 0x28)
+            shentsize, shnum = struct.unpack_from(end + "HH", data, 0x3A)
+        else:
+            shoff, = struct.unpack_from(end + "I", data, 0x20)
+            shentsize, shnum = struct.unpack_from(end + "HH", data, 0x2E)
+        self.sections = []
+        for i in range(shnum):
+            off = shoff + i * shentsize
+            if is64:
+                _, sh_type, flags, addr, offset, size = struct.unpack_from(end + "IIQQQQ", data, off)
+            else:
+                _, sh_type, flags, addr, offset, size = struct.unpack_from(end + "IIIIII", data, off)
+            if sh_type == 1 and flags & 0x2:  # SHT_PROGBITS with SHF_ALLOC
+                self.sections.append((addr & 0xFFFFFFFF, data[offset:offset + size]))
+
+    def string(self, addr):
+        """Get NULL terminated string at the address, or None if address is not in the image"""
+        for start, content in self.sections:
+            if start <= addr < start + len(content):
+                off = addr - start
+                return content[off:content.index(b"\0", off)]
+        return None
+
+
+class Reader:
+    """Reader of arguments in frame payload, with options of the firmware"""
+
+    def __init__(self, data, float32, pointer_size=4, thousands_sep=","):
+        self.data, self.pos, self.float32 = data, 0, float32
+        self.pointer_size, self.thousands_sep = pointer_size, thousands_sep
+
+    def varint(self):
+        val, shift = 0, 0
+        while True:
+            b = self.data[self.pos]
+            self.pos += 1
+            val |= (b & 0x7F) << shift
+            shift += 7
+            if not b & 0x80:
+                return val
+
+    def svarint(self):
+        val = self.varint()
+        return (val >> 1) ^ -(val & 1)
+
+    def float(self):
+        fmt, size = ("<f", 4) if self.float32 else ("<d", 8)
+        val, = struct.unpack_from(fmt, self.data, self.pos)
+        self.pos += size
+        return val
+
+    def string(self):
+        end = self.data.index(b"\0", self.pos)
+        val = self.data[self.pos:end]
+        self.pos = end + 1
+        return val
+
+
+def si(val, prec):
+    """Number with SI prefix, as printed by `%y` and `%Y`"""
+    if val == 0 or val != val or abs(val) == float("inf"):
+        return "%g" % val
+    mant, exp = ("%.*e" % (prec - 1, val)).split("e")
+    val, exp = float(mant + "e" + exp), int(exp)
+    exp3 = min(max(exp // 3 * 3, -24), 24)
+    text = "%.*f" % (min(max(prec - 1 - exp + exp3, 0), prec), val / 10.0 ** exp3)
+    text = text.rstrip("0").rstrip(".") if "." in text else text
+    return text + ("" if exp3 == 0 else "yzafpn\u00b5m kMGTPEZY"[exp3 // 3 + 8])
+
+
+def pad(sign, body, flags, width):
+    """Apply sign and width, zeros of `0` flag go between sign or `0x` prefix and digits"""
+    width = int(width or 0)
+    fill = max(width - len(sign) - len(body), 0)
+    if "-" in flags:
+        return sign + body + " " * fill
+    if "0" in flags and body[:1].isdigit():
+        prefix = body[:2] if body[:2].lower() == "0x" else ""
+        return sign + prefix + "0" * fill + body[len(prefix):]
+    return " " * fill + sign + body
+
+
+def split_sign(text, flags):
+    """Split formatted number to sign and magnitude, with sign of `+` and space flags"""
+    if text[:1] in "+- ":
+        return text[:1], text[1:]
+    return "+" if "+" in flags else (" " if " " in flags else ""), text
+
+
+def group(text, sep):
+    """Insert thousands separators to integer digits at the start of the text"""
+    digits = len(text) - len(text.lstrip("0123456789"))
+    head, tail = text[:digits], text[digits:]
+    parts = [head[max(i - 3, 0):i] for i in range(len(head), 0, -3)]
+    return sep.join(reversed(parts)) + tail
+
+
+def fixed(raw, bits, prec, flags):
+    """Fixed-point number of `%q`, decimals are rounded half up from the exact value"""
+    calc = min(prec, FIXED_MAX_PRECISION)
+    ctx = decimal.Context(prec=200, rounding=decimal.ROUND_HALF_UP)
+    val = ctx.divide(decimal.Decimal(abs(raw)), decimal.Decimal(2 ** bits))
+    text = "{:f}".format(val.quantize(decimal.Decimal(1).scaleb(-calc), context=ctx)) + "0" * (prec - calc)
+    return ("-" if raw < 0 else "") + text + ("." if prec == 0 and "#" in flags else "")
+
+
+def hexfloat(val, prec, flags, upper):
+    """Hexadecimal float of `%a`, the same as C library prints `double`"""
+    if val != val or math.isinf(val):
+        text = "nan" if val != val else ("-inf" if val < 0 else "inf")
+        return text.upper() if upper else text
+    sign = "-" if math.copysign(1.0, val) < 0 else ""
+    val = abs(val)
+    if val == 0:
+        lead, mant, exp = 0, 0, 0
+    elif val < sys.float_info.min:
+        lead, mant, exp = 0, int(math.ldexp(val, 1074)), -1022
+    else:
+        m, e = math.frexp(val)
+        lead, mant, exp = 1, int(math.ldexp(m * 2 - 1, 52)), e - 1
+    if prec is None:
+        digits = ("%013x" % mant).rstrip("0")
+    elif prec < 13:
+        # Round half to even to `prec` digits, leading digit may become `2` as in the C library
+        shift = 4 * (13 - prec)
+        q, r = divmod((lead << 52) | mant, 1 << shift)
+        if r > 1 << (shift - 1) or (r == 1 << (shift - 1) and q & 1):
+            q += 1
+        lead, digits = q >> (4 * prec), ("%0*x" % (prec, q & ((1 << (4 * prec)) - 1))) if prec > 0 else ""
+    else:
+        digits = "%013x" % mant + "0" * (prec - 13)
+    text = "%s0x%d%s%sp%+d" % (sign, lead, "." if digits or "#" in flags else "", digits, exp)
+    return text.upper() if upper else text
+
+
+def render(fmt, args):
+    """Format text from format string and frame arguments"""
+    out = bytearray()
+    pos = 0
+    for m in SPEC_RE.finditer(fmt):
+        out += fmt[pos:m.start()]
+        pos = m.end()
+        flags, width, prec, _, conv = m.groups()
+        conv, bits = conv[:1].decode(), conv[1:]
+        if conv == "%":
+            out += b"%"
+            continue
+        if width == b"*":
+            width = str(args.svarint()).encode()
+        if prec == b"*":
+            prec = str(args.svarint()).encode()
+        flags = flags.decode()
+        is_grouped = "'" in flags
+        spec = "%" + flags.replace("'", "") + (width or b"").decode()
+        if prec is not None:
+            spec += "." + prec.decode()
+        if is_grouped and conv in "diufF":
+            # Separators are counted in the width, precision of integers is not used with grouping
+            val = args.svarint() if conv in "di" else (args.varint() if conv == "u" else args.float())
+            nprec = "" if conv in "diu" or prec is None else "." + (prec.decode() or "0")
+            sign, body = split_sign(("%" + flags.replace("'", "").replace("0", "").replace("-", "") + nprec
+                                     + ("d" if conv in "diu" else conv)) % val, flags)
+            out += pad(sign, group(body, args.thousands_sep), flags, width).encode()
+        elif conv in "di":
+            out += (spec + "d").encode() % args.svarint()
+        elif conv == "q":
+            raw = args.svarint()
+            if int(bits or 0) > 63:
+                out += b"q"
+                continue
+            body = fixed(raw, int(bits or 0), int(prec or 6) if prec is not None else 6, flags)
+            sign, body = split_sign(body, flags)
+            out += pad(sign, group(body, args.thousands_sep) if is_grouped else body, flags, width).encode()
+        elif conv in "yY":
+            val = args.float() if conv == "y" else args.svarint()
+            out += (spec.split(".")[0] + "s").encode() % si(val, max(int(prec or 6), 1)).encode()
+        elif conv in "uoxX":
+            out += (spec + conv).encode() % args.varint()
+        elif conv in "bB":
+            out += (spec + "s").encode() % format(args.varint(), "b").encode()
+        elif conv == "p":
+            # Library prints all digits of the pointer without prefix, width is not used
+            out += b"%0*x" % (2 * args.pointer_size, args.varint())
+        elif conv == "c":
+            out += (spec + "c").encode() % args.varint()
+        elif conv in "aA":
+            sign, body = split_sign(hexfloat(args.float(), None if prec is None else int(prec or 0), flags,
+                                             conv == "A"), flags)
+            out += pad(sign, body, flags, width).encode()
+        elif conv in "fFeEgG":
+            out += (spec + conv).encode() % args.float()
+        elif conv == "s":
+            out += (spec + "s").encode() % args.string()
+        elif conv != "n":
+            out += b"?"
+    return bytes(out + fmt[pos:])
+
+
+def decode(elf, data, float32, pointer_size=4, thousands_sep=","):
+    """Decode complete frames from the data, return tuple of decoded text and number of used bytes"""
+    out, pos = bytearray(), 0
+    while pos < len(data):
+        length, shift, hdr = 0, 0, pos
+        while hdr < len(data):
+            length |= (data[hdr] & 0x7F) << shift
+            shift += 7
+            hdr += 1
+            if not data[hdr - 1] & 0x80:
+                break
+        else:
+            break
+        if hdr + length > len(data):
+            break
+        frame, pos = data[hdr:hdr + length], hdr + length
+        if length < 4:
+            continue
+        addr, = struct.unpack_from("<I", frame, 0)
+        fmt = elf.string(addr)
+        if fmt is None:
+            out += b"<unknown format 0x%08x>\n" % addr
+            continue
+        try:
+            out += render(fmt, Reader(frame[4:], float32, pointer_size, thousands_sep))
+        except (IndexError, ValueError, struct.error):
+            out += b"<corrupted frame of \"" + fmt + b"\">\n"
+    return bytes(out), pos
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode LwPRINTF tokenized output")
+    parser.add_argument("elf", help="Firmware ELF file with format strings")
+    parser.add_argument("input", nargs="?", help="Tokenized input file, standard input if not set")
+    parser.add_argument("--float32", action="store_true", help="Firmware uses LWPRINTF_CFG_SUPPORT_TYPE_FLOAT_SINGLE")
+    parser.add_argument("--pointer-size", type=int, default=4, help="Size of pointer of the firmware, in bytes")
+    parser.add_argument("--thousands-sep", default=",", help="Separator set with lwprintf_set_thousands_sep_ex")
+    args = parser.parse_args()
+
+    elf = Elf(args.elf)
+    stream = open(args.input, "rb") if args.input else sys.stdin.buffer
+    pending = b""
+    with stream:
+        while True:
+            chunk = stream.read1(4096) if hasattr(stream, "read1") else stream.read(4096)
+            if not chunk:
+                break
+            text, used = decode(elf, pending + chunk, args.float32, args.pointer_size, args.thousands_sep)
+            pending = (pending + chunk)[used:]
+            sys.stdout.buffer.write(text)
+            sys.stdout.buffer.flush()
+
+
+if __name__ == "__main__":
+    main()